@@ -0,0 +1,86 @@
+// bench_calo_trigger_algorithm.cxx
+// Benchmark of the calorimeter trigger algorithm (calo_trigger_algorithm::process)
+
+// Standard libraries :
+#include <iostream>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/calo_ctw_data.h>
+#include <snemo/digitization/calo_trigger_algorithm.h>
+
+// Benchmarks :
+#include "bench_utils.h"
+
+int main(int argc_, char ** argv_)
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    bench::runner runner("bench_calo_trigger_algorithm", argc_, argv_);
+
+    // Calorimeter multiplicities and pile-up windows (clockticks 25 ns) :
+    const std::vector<std::size_t> calo_multiplicities = {1, 2, 10, 100};
+    const std::vector<uint32_t> windows_25 = {1, 40, 400};
+    const std::size_t number_of_events = 16;
+
+    for (std::size_t imult = 0; imult < calo_multiplicities.size(); imult++)
+      {
+	for (std::size_t iwindow = 0; iwindow < windows_25.size(); iwindow++)
+	  {
+	    std::vector<snemo::digitization::calo_ctw_data> events(number_of_events);
+	    std::size_t number_of_ticks = 0;
+	    for (std::size_t ievent = 0; ievent < number_of_events; ievent++)
+	      {
+		snemo::digitization::counter_rng prng(314159, 0, ievent, snemo::digitization::counter_rng::STREAM_CALO);
+		bench::generate_calo_ctw_data(prng, calo_multiplicities[imult], 200, windows_25[iwindow], events[ievent]);
+		number_of_ticks += events[ievent].get_clocktick_range() + 1;
+	      }
+
+	    snemo::digitization::calo_trigger_algorithm my_calo_algo;
+	    my_calo_algo.set_circular_buffer_depth(4);
+	    my_calo_algo.set_total_multiplicity_threshold(1);
+	    my_calo_algo.initialize_simple();
+
+	    const std::string parameters = "calo=" + std::to_string(calo_multiplicities[imult]) + ",window_25ns=" + std::to_string(windows_25[iwindow]);
+	    std::vector<snemo::digitization::trigger_structures::calo_summary_record> calo_records;
+	    std::size_t ievent = 0;
+	    runner.run("calo_trigger_algorithm_process", parameters, "event", 1,
+		       [&]() {
+			 calo_records.clear();
+			 my_calo_algo.process(events[ievent++ % number_of_events], calo_records);
+		       });
+	    runner.run("calo_trigger_algorithm_process", parameters, "tick", number_of_ticks,
+		       [&]() {
+			 for (std::size_t i = 0; i < number_of_events; i++)
+			   {
+			     calo_records.clear();
+			     my_calo_algo.process(events[i], calo_records);
+			   }
+		       });
+	  }
+      }
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
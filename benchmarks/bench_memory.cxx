@@ -0,0 +1,68 @@
+// bench_memory.cxx
+// Benchmark of the tracker trigger memories lookups (memory<>::fetch)
+
+// Standard libraries :
+#include <iostream>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/tracker_trigger_mem_maker.h>
+
+// Benchmarks :
+#include "bench_utils.h"
+
+/// Time the fetch of a memory on random addresses
+template <class Memory>
+void bench_fetch(bench::runner & runner_, const std::string & name_, const std::string & filename_)
+{
+  Memory a_memory;
+  a_memory.load_from_file(filename_);
+  snemo::digitization::counter_rng prng(314159, 0, 0);
+  std::vector<typename Memory::address_type> addresses;
+  for (std::size_t i = 0; i < 4096; i++) addresses.push_back(typename Memory::address_type(prng.next()));
+  volatile unsigned long sink = 0;
+  runner_.run("memory_fetch", name_ + ",addresses=" + std::to_string(a_memory.get_number_of_addresses()), "fetch", addresses.size(),
+	      [&]() {
+		unsigned long value = 0;
+		for (std::size_t i = 0; i < addresses.size(); i++) value += a_memory.fetch(addresses[i]).to_ulong();
+		sink = sink + value;
+	      });
+  return;
+}
+
+int main(int argc_, char ** argv_)
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    bench::runner runner("bench_memory", argc_, argv_);
+
+    bench_fetch<snemo::digitization::tracker_trigger_mem_maker::mem1_type>(runner, "mem1", bench::get_tracker_memory_filename(1));
+    bench_fetch<snemo::digitization::tracker_trigger_mem_maker::mem2_type>(runner, "mem2", bench::get_tracker_memory_filename(2));
+    bench_fetch<snemo::digitization::tracker_trigger_mem_maker::mem3_type>(runner, "mem3", bench::get_tracker_memory_filename(3));
+    bench_fetch<snemo::digitization::tracker_trigger_mem_maker::mem4_type>(runner, "mem4", bench::get_tracker_memory_filename(4));
+    bench_fetch<snemo::digitization::tracker_trigger_mem_maker::mem5_type>(runner, "mem5", bench::get_tracker_memory_filename(5));
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
@@ -0,0 +1,211 @@
+// bench_sd_to_ctw.cxx
+// Benchmark of the simulated data to crate trigger words algorithms
+
+// Standard libraries :
+#include <iostream>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+// - Bayeux/geomtools:
+#include <geomtools/manager.h>
+// - Bayeux/mctools:
+#include <mctools/simulated_data.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/clock_utils.h>
+#include <snemo/digitization/electronic_mapping.h>
+#include <snemo/digitization/mapping.h>
+
+#include <snemo/digitization/sd_to_calo_signal_algo.h>
+#include <snemo/digitization/signal_to_calo_tp_algo.h>
+#include <snemo/digitization/calo_tp_to_ctw_algo.h>
+
+#include <snemo/digitization/sd_to_geiger_signal_algo.h>
+#include <snemo/digitization/signal_to_geiger_tp_algo.h>
+#include <snemo/digitization/geiger_tp_to_ctw_algo.h>
+
+// Benchmarks :
+#include "bench_utils.h"
+
+/// Generate a simulated data with Geiger and main wall calorimeter step hits spread over a pile-up window
+void generate_simulated_data(snemo::digitization::counter_rng & prng_,
+			     const geomtools::manager & manager_,
+			     std::size_t number_of_geiger_hits_,
+			     std::size_t number_of_calo_hits_,
+			     double window_,
+			     mctools::simulated_data & sd_)
+{
+  using namespace snemo::digitization;
+  const geomtools::mapping & the_mapping = manager_.get_mapping();
+  sd_.add_step_hits("gg", number_of_geiger_hits_);
+  for (std::size_t ihit = 0; ihit < number_of_geiger_hits_; ihit++)
+    {
+      mctools::base_step_hit & geiger_hit = sd_.add_step_hit("gg");
+      const geomtools::geom_id geiger_gid(mapping::GEIGER_CATEGORY_TYPE,
+					  mapping::DEMONSTRATOR_MODULE_NUMBER,
+					  static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_SIDES),
+					  static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_LAYERS),
+					  static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_GEIGER_ROWS));
+      // The avalanche hits the anode wire, the ionization is up to 2 cm away :
+      const geomtools::vector_3d & anode_position = the_mapping.get_geom_info(geiger_gid).get_world_placement().get_translation();
+      const geomtools::vector_3d ionization_position = anode_position + geomtools::vector_3d(prng_.flat(-1.0, 1.0) * CLHEP::cm,
+											    prng_.flat(-1.0, 1.0) * CLHEP::cm,
+											    0.0);
+      geiger_hit.set_hit_id(ihit);
+      geiger_hit.set_geom_id(geiger_gid);
+      geiger_hit.set_position_start(ionization_position);
+      geiger_hit.set_position_stop(anode_position);
+      geiger_hit.set_time_start(prng_.flat(0.0, window_));
+    }
+
+  sd_.add_step_hits("calo", number_of_calo_hits_);
+  for (std::size_t ihit = 0; ihit < number_of_calo_hits_; ihit++)
+    {
+      mctools::base_step_hit & calo_hit = sd_.add_step_hit("calo");
+      const geomtools::geom_id calo_gid(mapping::CALO_MAIN_WALL_CATEGORY_TYPE,
+					mapping::DEMONSTRATOR_MODULE_NUMBER,
+					static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_SIDES),
+					static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_MAIN_CALO_COLUMNS),
+					static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_MAIN_CALO_ROWS));
+      const double time = prng_.flat(0.0, window_);
+      calo_hit.set_hit_id(ihit);
+      calo_hit.set_geom_id(calo_gid);
+      calo_hit.set_time_start(time);
+      calo_hit.set_time_stop(time + 1 * CLHEP::ns);
+      calo_hit.set_energy_deposit(prng_.flat(0.2, 2.0) * CLHEP::MeV);
+    }
+  return;
+}
+
+int main(int argc_, char ** argv_)
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    bench::runner runner("bench_sd_to_ctw", argc_, argv_);
+
+    geomtools::manager my_manager;
+    snemo::digitization::electronic_mapping my_e_mapping;
+    bench::initialize_geometry(my_manager, my_e_mapping);
+
+    snemo::digitization::clock_utils my_clock_manager;
+    my_clock_manager.initialize();
+    my_clock_manager.compute_clockticks_ref(314159, 0, 0);
+
+    // Initialization of the algorithms :
+    snemo::digitization::sd_to_geiger_signal_algo sd_2_geiger_signal(my_manager);
+    sd_2_geiger_signal.initialize();
+    snemo::digitization::sd_to_calo_signal_algo sd_2_calo_signal(my_manager);
+    sd_2_calo_signal.initialize();
+
+    snemo::digitization::signal_to_geiger_tp_algo signal_2_geiger_tp;
+    signal_2_geiger_tp.initialize(my_e_mapping);
+    signal_2_geiger_tp.set_clocktick_reference(my_clock_manager.get_clocktick_800_ref());
+    signal_2_geiger_tp.set_clocktick_shift(my_clock_manager.get_shift_800());
+    snemo::digitization::signal_to_calo_tp_algo signal_2_calo_tp;
+    signal_2_calo_tp.initialize(my_e_mapping);
+    signal_2_calo_tp.set_clocktick_reference(my_clock_manager.get_clocktick_25_ref());
+    signal_2_calo_tp.set_clocktick_shift(my_clock_manager.get_shift_25());
+
+    snemo::digitization::geiger_tp_to_ctw_algo geiger_tp_2_ctw;
+    geiger_tp_2_ctw.initialize();
+    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw;
+    calo_tp_2_ctw.set_all_crates();
+    calo_tp_2_ctw.initialize();
+
+    // Pile-up windows :
+    const std::vector<double> windows = {100 * CLHEP::ns, 10 * CLHEP::microsecond};
+    const std::size_t number_of_events = 8;
+    const std::size_t calo_multiplicity = 2;
+
+    for (std::size_t imult = 0; imult < bench::get_geiger_multiplicities().size(); imult++)
+      {
+	const std::size_t multiplicity = bench::get_geiger_multiplicities()[imult];
+	for (std::size_t iwindow = 0; iwindow < windows.size(); iwindow++)
+	  {
+	    // Inputs of each stage are prepared out of the timed loops :
+	    std::vector<mctools::simulated_data> events(number_of_events);
+	    std::vector<snemo::digitization::signal_data> signals(number_of_events);
+	    std::vector<snemo::digitization::geiger_tp_data> geiger_tps(number_of_events);
+	    std::vector<snemo::digitization::calo_tp_data> calo_tps(number_of_events);
+	    for (std::size_t ievent = 0; ievent < number_of_events; ievent++)
+	      {
+		snemo::digitization::counter_rng prng(314159, 0, ievent, snemo::digitization::counter_rng::STREAM_USER);
+		generate_simulated_data(prng, my_manager, multiplicity, calo_multiplicity, windows[iwindow], events[ievent]);
+		sd_2_geiger_signal.process(events[ievent], signals[ievent]);
+		sd_2_calo_signal.process(events[ievent], signals[ievent]);
+		signal_2_geiger_tp.process(signals[ievent], geiger_tps[ievent]);
+		signal_2_calo_tp.process(signals[ievent], calo_tps[ievent]);
+	      }
+
+	    const std::string parameters = "geiger=" + std::to_string(multiplicity)
+	      + ",calo=" + std::to_string(calo_multiplicity)
+	      + ",window_ns=" + std::to_string(static_cast<int>(windows[iwindow] / CLHEP::ns));
+	    std::size_t ievent = 0;
+
+	    runner.run("sd_to_signal", parameters, "event", 1,
+		       [&]() {
+			 const std::size_t index = ievent++ % number_of_events;
+			 snemo::digitization::signal_data signal_data;
+			 sd_2_geiger_signal.process(events[index], signal_data);
+			 sd_2_calo_signal.process(events[index], signal_data);
+		       });
+
+	    runner.run("signal_to_tp", parameters, "event", 1,
+		       [&]() {
+			 const std::size_t index = ievent++ % number_of_events;
+			 snemo::digitization::geiger_tp_data geiger_tp_data;
+			 snemo::digitization::calo_tp_data calo_tp_data;
+			 signal_2_geiger_tp.process(signals[index], geiger_tp_data);
+			 signal_2_calo_tp.process(signals[index], calo_tp_data);
+		       });
+
+	    runner.run("tp_to_ctw", parameters, "event", 1,
+		       [&]() {
+			 const std::size_t index = ievent++ % number_of_events;
+			 snemo::digitization::geiger_ctw_data geiger_ctw_data;
+			 snemo::digitization::calo_ctw_data calo_ctw_data;
+			 geiger_tp_2_ctw.process(geiger_tps[index], geiger_ctw_data);
+			 calo_tp_2_ctw.process(calo_tps[index], calo_ctw_data);
+		       });
+
+	    runner.run("sd_to_ctw", parameters, "event", 1,
+		       [&]() {
+			 const std::size_t index = ievent++ % number_of_events;
+			 snemo::digitization::signal_data signal_data;
+			 sd_2_geiger_signal.process(events[index], signal_data);
+			 sd_2_calo_signal.process(events[index], signal_data);
+			 snemo::digitization::geiger_tp_data geiger_tp_data;
+			 snemo::digitization::calo_tp_data calo_tp_data;
+			 signal_2_geiger_tp.process(signal_data, geiger_tp_data);
+			 signal_2_calo_tp.process(signal_data, calo_tp_data);
+			 snemo::digitization::geiger_ctw_data geiger_ctw_data;
+			 snemo::digitization::calo_ctw_data calo_ctw_data;
+			 geiger_tp_2_ctw.process(geiger_tp_data, geiger_ctw_data);
+			 calo_tp_2_ctw.process(calo_tp_data, calo_ctw_data);
+		       });
+	  }
+      }
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
@@ -0,0 +1,93 @@
+// bench_tracker_trigger_algorithm.cxx
+// Benchmark of the tracker trigger algorithm (tracker_trigger_algorithm::process per clocktick)
+
+// Standard libraries :
+#include <iostream>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+// - Bayeux/geomtools:
+#include <geomtools/manager.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/electronic_mapping.h>
+#include <snemo/digitization/geiger_ctw_data.h>
+#include <snemo/digitization/tracker_trigger_algorithm.h>
+
+// Benchmarks :
+#include "bench_utils.h"
+
+int main(int argc_, char ** argv_)
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    bench::runner runner("bench_tracker_trigger_algorithm", argc_, argv_);
+
+    geomtools::manager my_manager;
+    snemo::digitization::electronic_mapping my_e_mapping;
+    bench::initialize_geometry(my_manager, my_e_mapping);
+
+    snemo::digitization::tracker_trigger_algorithm my_tracker_algo;
+    my_tracker_algo.set_electronic_mapping(my_e_mapping);
+    my_tracker_algo.fill_mem1_all(bench::get_tracker_memory_filename(1));
+    my_tracker_algo.fill_mem2_all(bench::get_tracker_memory_filename(2));
+    my_tracker_algo.fill_mem3_all(bench::get_tracker_memory_filename(3));
+    my_tracker_algo.fill_mem4_all(bench::get_tracker_memory_filename(4));
+    my_tracker_algo.fill_mem5_all(bench::get_tracker_memory_filename(5));
+    my_tracker_algo.initialize();
+
+    // Pile-up windows (clockticks 800 ns) :
+    const std::vector<uint32_t> windows_800 = {1, 10};
+    const std::size_t number_of_events = 16;
+
+    for (std::size_t imult = 0; imult < bench::get_geiger_multiplicities().size(); imult++)
+      {
+	const std::size_t multiplicity = bench::get_geiger_multiplicities()[imult];
+	for (std::size_t iwindow = 0; iwindow < windows_800.size(); iwindow++)
+	  {
+	    // The CTW lists per clocktick are prepared out of the timed loop :
+	    std::vector<snemo::digitization::geiger_ctw_data> events(number_of_events);
+	    std::vector<snemo::digitization::geiger_ctw_data::geiger_ctw_collection_type> ctw_lists_per_clocktick;
+	    for (std::size_t ievent = 0; ievent < number_of_events; ievent++)
+	      {
+		snemo::digitization::counter_rng prng(314159, 0, ievent, snemo::digitization::counter_rng::STREAM_GEIGER);
+		bench::generate_geiger_ctw_data(prng, multiplicity, 10, windows_800[iwindow], events[ievent]);
+		for (uint32_t ict800 = events[ievent].get_clocktick_min(); ict800 <= events[ievent].get_clocktick_max(); ict800++)
+		  {
+		    ctw_lists_per_clocktick.push_back(snemo::digitization::geiger_ctw_data::geiger_ctw_collection_type());
+		    events[ievent].get_list_of_geiger_ctw_per_clocktick(ict800, ctw_lists_per_clocktick.back());
+		  }
+	      }
+
+	    const std::string parameters = "geiger=" + std::to_string(multiplicity) + ",window_800ns=" + std::to_string(windows_800[iwindow]);
+	    std::size_t itick = 0;
+	    runner.run("tracker_trigger_algorithm_process", parameters, "tick", 1,
+		       [&]() {
+			 snemo::digitization::trigger_structures::tracker_record a_tracker_record;
+			 my_tracker_algo.process(ctw_lists_per_clocktick[itick++ % ctw_lists_per_clocktick.size()], a_tracker_record);
+		       });
+	  }
+      }
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
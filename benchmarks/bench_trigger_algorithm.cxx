@@ -0,0 +1,172 @@
+// bench_trigger_algorithm.cxx
+// Benchmark of the full trigger algorithm (trigger_algorithm::process per event)
+
+// Standard libraries :
+#include <iostream>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+#include <datatools/multi_properties.h>
+// - Bayeux/geomtools:
+#include <geomtools/manager.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/clock_utils.h>
+#include <snemo/digitization/electronic_mapping.h>
+#include <snemo/digitization/calo_ctw_data.h>
+#include <snemo/digitization/geiger_ctw_data.h>
+#include <snemo/digitization/trigger_algorithm.h>
+#include <snemo/digitization/ctw_generator.h>
+
+// Benchmarks :
+#include "bench_utils.h"
+
+/// Build the default trigger configuration (as in the devel trigger program)
+void build_trigger_config(datatools::multi_properties & trigger_config_)
+{
+  trigger_config_.add("general", "trigger_component");
+  datatools::properties & general_config = trigger_config_.grab("general").grab_properties();
+  general_config.store("coincidence_calorimeter_gate_size", 5);
+  general_config.store("L2_decision_coincidence_gate_size", 5);
+  general_config.store("previous_event_buffer_depth", 10);
+  general_config.store("activate_any_coincidences", true);
+
+  trigger_config_.add("calorimeter", "trigger_component");
+  datatools::properties & calo_config = trigger_config_.grab("calorimeter").grab_properties();
+  calo_config.store("circular_buffer_depth", 4);
+  calo_config.store("total_multiplicity_threshold", 1);
+  calo_config.store_with_explicit_unit("low_threshold_value", 30 * 1e-3 * CLHEP::volt);
+  calo_config.store_with_explicit_unit("high_threshold_value", 50 * 1e-3 * CLHEP::volt);
+  calo_config.store("inhibit_both_side", false);
+  calo_config.store("inhibit_single_side", false);
+
+  trigger_config_.add("tracker", "trigger_component");
+  datatools::properties & tracker_config = trigger_config_.grab("tracker").grab_properties();
+  tracker_config.store("mem1_file", bench::get_tracker_memory_filename(1));
+  tracker_config.store("mem2_file", bench::get_tracker_memory_filename(2));
+  tracker_config.store("mem3_file", bench::get_tracker_memory_filename(3));
+  tracker_config.store("mem4_file", bench::get_tracker_memory_filename(4));
+  tracker_config.store("mem5_file", bench::get_tracker_memory_filename(5));
+
+  trigger_config_.add("coincidence", "trigger_component");
+  return;
+}
+
+int main(int argc_, char ** argv_)
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    bench::runner runner("bench_trigger_algorithm", argc_, argv_);
+
+    geomtools::manager my_manager;
+    snemo::digitization::electronic_mapping my_e_mapping;
+    bench::initialize_geometry(my_manager, my_e_mapping);
+
+    snemo::digitization::clock_utils my_clock_manager;
+    my_clock_manager.initialize();
+    my_clock_manager.compute_clockticks_ref(314159, 0, 0);
+
+    datatools::multi_properties trigger_config("name", "type", "Trigger parameters multi section configuration");
+    build_trigger_config(trigger_config);
+
+    snemo::digitization::trigger_algorithm my_trigger_algo;
+    my_trigger_algo.set_electronic_mapping(my_e_mapping);
+    my_trigger_algo.set_clock_manager(my_clock_manager);
+    my_trigger_algo.initialize(trigger_config);
+
+    // Pile-up windows (clockticks 800 ns, the calorimeter hits are spread over the same duration) :
+    const std::vector<uint32_t> windows_800 = {1, 10};
+    const std::size_t number_of_events = 16;
+    const std::size_t calo_multiplicity = 2;
+
+    for (std::size_t imult = 0; imult < bench::get_geiger_multiplicities().size(); imult++)
+      {
+	const std::size_t multiplicity = bench::get_geiger_multiplicities()[imult];
+	for (std::size_t iwindow = 0; iwindow < windows_800.size(); iwindow++)
+	  {
+	    std::vector<snemo::digitization::calo_ctw_data> calo_events(number_of_events);
+	    std::vector<snemo::digitization::geiger_ctw_data> geiger_events(number_of_events);
+	    for (std::size_t ievent = 0; ievent < number_of_events; ievent++)
+	      {
+		snemo::digitization::counter_rng prng(314159, 0, ievent, snemo::digitization::counter_rng::STREAM_CALO);
+		bench::generate_calo_ctw_data(prng, calo_multiplicity, 320, 32 * windows_800[iwindow], calo_events[ievent]);
+		prng.set_stream(314159, 0, ievent, snemo::digitization::counter_rng::STREAM_GEIGER);
+		bench::generate_geiger_ctw_data(prng, multiplicity, 10, windows_800[iwindow], geiger_events[ievent]);
+	      }
+
+	    const std::string parameters = "geiger=" + std::to_string(multiplicity)
+	      + ",calo=" + std::to_string(calo_multiplicity)
+	      + ",window_800ns=" + std::to_string(windows_800[iwindow]);
+	    std::size_t ievent = 0;
+	    runner.run("trigger_algorithm_process", parameters, "event", 1,
+		       [&]() {
+			 const std::size_t index = ievent++ % number_of_events;
+			 my_trigger_algo.process(calo_events[index], geiger_events[index]);
+			 my_trigger_algo.reset_data();
+		       });
+	  }
+      }
+
+    // Physics like events from the synthetic CTW generator (two tracks, delayed alpha, Geiger noise) :
+    const std::vector<double> noise_rates = {0.0, 10.0, 100.0};
+    for (std::size_t inoise = 0; inoise < noise_rates.size(); inoise++)
+      {
+	snemo::digitization::ctw_generator my_generator;
+	my_generator.set_seed(314159);
+	my_generator.set_number_of_tracks(2);
+	my_generator.set_delayed_alpha_probability(0.5);
+	my_generator.set_geiger_noise_rate(noise_rates[inoise] * CLHEP::hertz);
+	my_generator.set_calo_multiplicity(calo_multiplicity);
+	my_generator.initialize_simple();
+
+	std::vector<snemo::digitization::calo_ctw_data> calo_events(number_of_events);
+	std::vector<snemo::digitization::geiger_ctw_data> geiger_events(number_of_events);
+	for (std::size_t ievent = 0; ievent < number_of_events; ievent++)
+	  {
+	    my_generator.generate(ievent, calo_events[ievent], geiger_events[ievent]);
+	  }
+
+	const std::string parameters = "tracks=2,alpha=0.5,calo=" + std::to_string(calo_multiplicity)
+	  + ",noise_hz=" + std::to_string(static_cast<int>(noise_rates[inoise]));
+	std::size_t ievent = 0;
+	runner.run("trigger_algorithm_process_generated", parameters, "event", 1,
+		   [&]() {
+		     const std::size_t index = ievent++ % number_of_events;
+		     my_trigger_algo.process(calo_events[index], geiger_events[index]);
+		     my_trigger_algo.reset_data();
+		   });
+
+	std::size_t igenerated = 0;
+	snemo::digitization::calo_ctw_data calo_ctws;
+	snemo::digitization::geiger_ctw_data geiger_ctws;
+	runner.run("ctw_generator_generate", parameters, "event", 1,
+		   [&]() {
+		     calo_ctws.reset_ctws();
+		     geiger_ctws.reset_ctws();
+		     my_generator.generate(igenerated++, calo_ctws, geiger_ctws);
+		   });
+      }
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
@@ -0,0 +1,287 @@
+// bench_utils.cc
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+// Ourselves:
+#include "bench_utils.h"
+
+// Standard library :
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <map>
+#include <sstream>
+#include <utility>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+#include <datatools/utils.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+#include <geomtools/manager.h>
+
+// This project :
+#include <snemo/digitization/mapping.h>
+#include <snemo/digitization/ID_convertor.h>
+#include <snemo/digitization/calo_tp.h>
+#include <snemo/digitization/geiger_ctw_data.h>
+#include <snemo/digitization/calo_ctw_data.h>
+#include <snemo/digitization/signal_data.h>
+#include <snemo/digitization/electronic_mapping.h>
+
+namespace {
+
+  std::atomic<std::size_t> number_of_allocations(0);
+
+} // end of anonymous namespace
+
+// Counting replacements of the global allocation functions :
+void * operator new(std::size_t size_)
+{
+  number_of_allocations.fetch_add(1, std::memory_order_relaxed);
+  void * pointer = std::malloc(size_ == 0 ? 1 : size_);
+  if (pointer == 0) throw std::bad_alloc();
+  return pointer;
+}
+
+void * operator new[](std::size_t size_)
+{
+  return operator new(size_);
+}
+
+void operator delete(void * pointer_) noexcept
+{
+  std::free(pointer_);
+}
+
+void operator delete[](void * pointer_) noexcept
+{
+  std::free(pointer_);
+}
+
+void operator delete(void * pointer_, std::size_t) noexcept
+{
+  std::free(pointer_);
+}
+
+void operator delete[](void * pointer_, std::size_t) noexcept
+{
+  std::free(pointer_);
+}
+
+namespace bench {
+
+  std::size_t get_number_of_allocations()
+  {
+    return number_of_allocations.load(std::memory_order_relaxed);
+  }
+
+  runner::runner(const std::string & program_name_, int argc_, char ** argv_)
+  {
+    _program_name_ = program_name_;
+    _min_time_ns_ = 0.5e9;
+    for (int iarg = 1; iarg < argc_; iarg++)
+      {
+	const std::string arg = argv_[iarg];
+	DT_THROW_IF(iarg + 1 >= argc_, std::logic_error, "Missing value for option '" << arg << "' ! ");
+	if (arg == "--min-time") _min_time_ns_ = std::atof(argv_[++iarg]) * 1e9;
+	else if (arg == "--output") _output_filename_ = argv_[++iarg];
+	else DT_THROW(std::logic_error, "Unknown option '" << arg << "' (--min-time <seconds>, --output <file>) ! ");
+      }
+    return;
+  }
+
+  runner::~runner()
+  {
+    std::ofstream file;
+    if (!_output_filename_.empty()) file.open(_output_filename_.c_str());
+    const std::string header = "program,benchmark,parameters,unit,iterations,ns_per_unit,units_per_second,allocations_per_unit";
+    std::cout << header << std::endl;
+    if (file) file << header << std::endl;
+    for (std::size_t i = 0; i < _results_.size(); i++)
+      {
+	const result & a_result = _results_[i];
+	std::ostringstream line;
+	line << _program_name_ << ',' << a_result.benchmark << ",\"" << a_result.parameters << "\","
+	     << a_result.unit << ',' << a_result.iterations << ',' << a_result.ns_per_unit << ','
+	     << a_result.units_per_second << ',' << a_result.allocations_per_unit;
+	std::cout << line.str() << std::endl;
+	if (file) file << line.str() << std::endl;
+      }
+    return;
+  }
+
+  result runner::_add_result(const std::string & benchmark_,
+				     const std::string & parameters_,
+				     const std::string & unit_,
+				     std::size_t units_,
+				     double elapsed_ns_,
+				     std::size_t allocations_)
+  {
+    result a_result;
+    a_result.benchmark = benchmark_;
+    a_result.parameters = parameters_;
+    a_result.unit = unit_;
+    a_result.iterations = units_;
+    a_result.ns_per_unit = elapsed_ns_ / units_;
+    a_result.units_per_second = units_ * 1e9 / elapsed_ns_;
+    a_result.allocations_per_unit = static_cast<double>(allocations_) / units_;
+    _results_.push_back(a_result);
+    std::clog << benchmark_ << " [" << parameters_ << "] : " << a_result.ns_per_unit << " ns/" << unit_
+	      << ", " << a_result.allocations_per_unit << " allocations/" << unit_ << std::endl;
+    return _results_.back();
+  }
+
+  void generate_geiger_ctw_data(snemo::digitization::counter_rng & prng_,
+				std::size_t number_of_hits_,
+				uint32_t first_clocktick_800_,
+				uint32_t window_800_,
+				snemo::digitization::geiger_ctw_data & geiger_ctw_data_)
+  {
+    using namespace snemo::digitization;
+    // One CTW per (clocktick, crate) :
+    std::map<std::pair<uint32_t, uint32_t>, geiger_ctw *> ctws;
+    for (std::size_t ihit = 0; ihit < number_of_hits_; ihit++)
+      {
+	const uint32_t clocktick_800 = first_clocktick_800_ + static_cast<uint32_t>(prng_.uniform() * window_800_);
+	unsigned int crate = 0;
+	unsigned int board = 0;
+	unsigned int channel = 0;
+	ID_convertor::convert_geiger_cell_to_channel(static_cast<unsigned int>(prng_.uniform() * mapping::NUMBER_OF_SIDES),
+						     static_cast<unsigned int>(prng_.uniform() * mapping::NUMBER_OF_LAYERS),
+						     static_cast<unsigned int>(prng_.uniform() * mapping::NUMBER_OF_GEIGER_ROWS),
+						     crate, board, channel);
+	const unsigned int block = (board > mapping::CONTROL_BOARD_ID ? board - 1 : board);
+	geiger_ctw * & a_ctw = ctws[std::make_pair(clocktick_800, crate)];
+	if (a_ctw == 0)
+	  {
+	    a_ctw = &geiger_ctw_data_.add();
+	    geomtools::geom_id ctw_gid(mapping::TRACKER_CONTROL_BOARD_TYPE, mapping::GEIGER_RACK_ID, crate, mapping::CONTROL_BOARD_ID);
+	    a_ctw->set_header(ctws.size() - 1, ctw_gid, clocktick_800);
+	    a_ctw->set_full_hardware_status(std::bitset<geiger::tp::THWS_SIZE>(std::string("01111")));
+	    a_ctw->set_full_crate_id(std::bitset<geiger::tp::CRATE_ID_WORD_SIZE>(crate));
+	  }
+	// FEB word with the board address :
+	std::bitset<geiger::tp::FULL_SIZE> feb_word;
+	a_ctw->get_100_bits_in_ctw_word(block, feb_word);
+	feb_word.set(channel);
+	for (unsigned int ibit = 0; ibit < geiger::tp::BOARD_ID_WORD_SIZE; ibit++) feb_word.set(geiger::tp::BOARD_ID_BIT0 + ibit, (board >> ibit) & 1);
+	a_ctw->set_100_bits_in_ctw_word(block, feb_word);
+      }
+    return;
+  }
+
+  void generate_calo_ctw_data(snemo::digitization::counter_rng & prng_,
+			      std::size_t number_of_hits_,
+			      uint32_t first_clocktick_25_,
+			      uint32_t window_25_,
+			      snemo::digitization::calo_ctw_data & calo_ctw_data_)
+  {
+    using namespace snemo::digitization;
+    // One CTW per (clocktick, main wall crate) with its high threshold multiplicity :
+    std::map<std::pair<uint32_t, uint32_t>, std::pair<calo_ctw *, unsigned int> > ctws;
+    for (std::size_t ihit = 0; ihit < number_of_hits_; ihit++)
+      {
+	const uint32_t clocktick_25 = first_clocktick_25_ + static_cast<uint32_t>(prng_.uniform() * window_25_);
+	const uint32_t side = static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_SIDES);
+	const uint32_t column = static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_MAIN_CALO_COLUMNS);
+	const uint32_t crate = (side == 0 ? mapping::MAIN_CALO_SIDE_0_CRATE : mapping::MAIN_CALO_SIDE_1_CRATE);
+	std::pair<calo_ctw *, unsigned int> & a_ctw = ctws[std::make_pair(clocktick_25, crate)];
+	if (a_ctw.first == 0)
+	  {
+	    a_ctw.first = &calo_ctw_data_.add();
+	    geomtools::geom_id ctw_gid(mapping::CALORIMETER_CONTROL_BOARD_TYPE, mapping::CALO_RACK_ID, crate, mapping::CONTROL_BOARD_ID);
+	    a_ctw.first->set_header(ctws.size() - 1, ctw_gid, clocktick_25);
+	  }
+	// The 2 bits multiplicity saturates at 3 :
+	if (a_ctw.second < 3) a_ctw.second++;
+	a_ctw.first->set_htm_main_wall(a_ctw.second);
+	a_ctw.first->set_zoning_bit(calo::ctw::W_ZW_BIT0 + column / 2, true);
+      }
+    return;
+  }
+
+  void generate_signal_data(snemo::digitization::counter_rng & prng_,
+			    std::size_t number_of_geiger_hits_,
+			    std::size_t number_of_calo_hits_,
+			    double window_,
+			    snemo::digitization::signal_data & signal_data_)
+  {
+    using namespace snemo::digitization;
+    for (std::size_t ihit = 0; ihit < number_of_geiger_hits_; ihit++)
+      {
+	geiger_signal & a_geiger_signal = signal_data_.add_geiger_signal();
+	geomtools::geom_id geiger_gid(mapping::GEIGER_CATEGORY_TYPE,
+				      mapping::DEMONSTRATOR_MODULE_NUMBER,
+				      static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_SIDES),
+				      static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_LAYERS),
+				      static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_GEIGER_ROWS));
+	a_geiger_signal.set_header(ihit, geiger_gid);
+	a_geiger_signal.set_data(prng_.flat(0.0, window_));
+      }
+    for (std::size_t ihit = 0; ihit < number_of_calo_hits_; ihit++)
+      {
+	calo_signal & a_calo_signal = signal_data_.add_calo_signal();
+	geomtools::geom_id calo_gid(mapping::CALO_MAIN_WALL_CATEGORY_TYPE,
+				    mapping::DEMONSTRATOR_MODULE_NUMBER,
+				    static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_SIDES),
+				    static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_MAIN_CALO_COLUMNS),
+				    static_cast<uint32_t>(prng_.uniform() * mapping::NUMBER_OF_MAIN_CALO_ROWS));
+	a_calo_signal.set_header(ihit, calo_gid);
+	// Above the high threshold :
+	a_calo_signal.set_data(prng_.flat(0.0, window_), prng_.flat(calo_tp::HIGH_THRESHOLD, 10 * calo_tp::HIGH_THRESHOLD));
+      }
+    return;
+  }
+
+  void initialize_geometry(geomtools::manager & manager_,
+			   snemo::digitization::electronic_mapping & e_mapping_)
+  {
+    using namespace snemo::digitization;
+    std::string manager_config_file = "@falaise:config/snemo/demonstrator/geometry/4.0/manager.conf";
+    datatools::fetch_path_with_env(manager_config_file);
+    datatools::properties manager_config;
+    datatools::properties::read_config(manager_config_file, manager_config);
+    manager_config.update("build_mapping", true);
+    if (manager_config.has_key("mapping.excluded_categories"))
+      {
+	manager_config.erase("mapping.excluded_categories");
+      }
+    manager_.initialize(manager_config);
+
+    e_mapping_.set_geo_manager(manager_);
+    e_mapping_.set_module_number(mapping::DEMONSTRATOR_MODULE_NUMBER);
+    e_mapping_.add_preconstructed_type(mapping::GEIGER_CATEGORY_TYPE);
+    e_mapping_.add_preconstructed_type(mapping::CALO_MAIN_WALL_CATEGORY_TYPE);
+    e_mapping_.initialize();
+    return;
+  }
+
+  std::string get_tracker_memory_filename(unsigned int memory_number_)
+  {
+    DT_THROW_IF(memory_number_ < 1 || memory_number_ > 5, std::range_error, "Invalid tracker memory number " << memory_number_ << " ! ");
+    std::string filename = "${FALAISE_DIGITIZATION_TESTING_DIR}/config/trigger/tracker/mem" + std::to_string(memory_number_) + ".conf";
+    datatools::fetch_path_with_env(filename);
+    return filename;
+  }
+
+  const std::vector<std::size_t> & get_geiger_multiplicities()
+  {
+    static const std::vector<std::size_t> multiplicities = {1, 10, 100, 1000};
+    return multiplicities;
+  }
+
+} // end of namespace bench
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
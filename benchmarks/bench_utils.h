@@ -0,0 +1,154 @@
+// bench_utils.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+//
+// Support for the trigger pipeline benchmark programs : timing loop, allocation
+// counting (the global operator new is replaced in bench_utils.cc), machine
+// readable report (CSV) and synthetic event generators at controlled multiplicity.
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_BENCHMARKS_BENCH_UTILS_H
+#define FALAISE_DIGITIZATION_PLUGIN_BENCHMARKS_BENCH_UTILS_H
+
+// Standard library :
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+// Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+
+// This project :
+#include <snemo/digitization/counter_rng.h>
+
+namespace geomtools {
+  class manager;
+}
+
+namespace snemo {
+  namespace digitization {
+    class geiger_ctw_data;
+    class calo_ctw_data;
+    class signal_data;
+    class electronic_mapping;
+  }
+}
+
+namespace bench {
+
+  /// Return the number of dynamic allocations since the start of the program
+  std::size_t get_number_of_allocations();
+
+  /// \brief Result of a benchmark
+  struct result
+  {
+    std::string benchmark;            //!< Name of the benchmark
+    std::string parameters;           //!< Parameters (multiplicity, window...)
+    std::string unit;                 //!< Unit of work (tick, event, fetch...)
+    std::size_t iterations;           //!< Number of timed units of work
+    double ns_per_unit;               //!< Mean time per unit of work
+    double units_per_second;          //!< Throughput
+    double allocations_per_unit;      //!< Mean number of dynamic allocations per unit of work
+  };
+
+  /// \brief Timing loop and report of a benchmark program
+  ///
+  /// Command line options : --min-time <seconds> (default 0.5) and --output <file>
+  /// (CSV report, default : standard output only).
+  class runner
+  {
+  public :
+
+    /// Constructor
+    runner(const std::string & program_name_, int argc_, char ** argv_);
+
+    /// Destructor (write the report)
+    ~runner();
+
+    /// Time a function doing 'units_per_call_' units of work per call
+    template <class Function>
+    result run(const std::string & benchmark_,
+		       const std::string & parameters_,
+		       const std::string & unit_,
+		       std::size_t units_per_call_,
+		       Function function_)
+    {
+      typedef std::chrono::steady_clock clock_type;
+      function_(); // Warm up
+      std::size_t number_of_calls = 1;
+      double elapsed_ns = 0.0;
+      std::size_t allocations = 0;
+      while (true)
+	{
+	  const std::size_t allocations_start = get_number_of_allocations();
+	  const clock_type::time_point start = clock_type::now();
+	  for (std::size_t icall = 0; icall < number_of_calls; icall++) function_();
+	  elapsed_ns = std::chrono::duration<double, std::nano>(clock_type::now() - start).count();
+	  allocations = get_number_of_allocations() - allocations_start;
+	  if (elapsed_ns >= _min_time_ns_) break;
+	  number_of_calls *= 2;
+	}
+      return _add_result(benchmark_, parameters_, unit_, number_of_calls * units_per_call_, elapsed_ns, allocations);
+    }
+
+  private :
+
+    result _add_result(const std::string & benchmark_,
+			       const std::string & parameters_,
+			       const std::string & unit_,
+			       std::size_t units_,
+			       double elapsed_ns_,
+			       std::size_t allocations_);
+
+    std::string _program_name_;     //!< Name of the benchmark program
+    double _min_time_ns_;           //!< Minimum timed duration per benchmark
+    std::string _output_filename_;  //!< CSV report file
+    std::vector<result> _results_;  //!< Results
+
+  };
+
+  /// Generate Geiger CTWs with 'number_of_hits_' random hit cells (three wires mode cabling)
+  /// spread over a pile-up window of 'window_800_' clockticks 800 ns
+  void generate_geiger_ctw_data(snemo::digitization::counter_rng & prng_,
+				std::size_t number_of_hits_,
+				uint32_t first_clocktick_800_,
+				uint32_t window_800_,
+				snemo::digitization::geiger_ctw_data & geiger_ctw_data_);
+
+  /// Generate main wall calorimeter CTWs with 'number_of_hits_' high threshold hits
+  /// spread over a pile-up window of 'window_25_' clockticks 25 ns
+  void generate_calo_ctw_data(snemo::digitization::counter_rng & prng_,
+			      std::size_t number_of_hits_,
+			      uint32_t first_clocktick_25_,
+			      uint32_t window_25_,
+			      snemo::digitization::calo_ctw_data & calo_ctw_data_);
+
+  /// Generate Geiger and main wall calorimeter signals spread over a pile-up window (time unit)
+  void generate_signal_data(snemo::digitization::counter_rng & prng_,
+			    std::size_t number_of_geiger_hits_,
+			    std::size_t number_of_calo_hits_,
+			    double window_,
+			    snemo::digitization::signal_data & signal_data_);
+
+  /// Initialize the demonstrator geometry (with mapping) and its electronic mapping
+  void initialize_geometry(geomtools::manager & manager_,
+			   snemo::digitization::electronic_mapping & e_mapping_);
+
+  /// Return the path of a tracker trigger memory file (1 to 5) of the testing configuration
+  std::string get_tracker_memory_filename(unsigned int memory_number_);
+
+  /// Multiplicities of the synthetic events
+  const std::vector<std::size_t> & get_geiger_multiplicities();
+
+} // end of namespace bench
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_BENCHMARKS_BENCH_UTILS_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
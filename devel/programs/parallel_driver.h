@@ -0,0 +1,314 @@
+// parallel_driver.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+//
+// Work splitting helpers for the devel trigger programs : the input file list is
+// split in contiguous blocks, one per worker process forked from the initialized
+// program. Each worker runs its own reader and trigger pipeline in its own output
+// directory, then the parent merges counters and output files in worker order,
+// so that merged outputs follow the event order of a serial run. Records are
+// identified by the index of their file in the full input list and their index in
+// the file, which do not depend on the work splitting (per event random streams).
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_DEVEL_PARALLEL_DRIVER_H
+#define FALAISE_DIGITIZATION_PLUGIN_DEVEL_PARALLEL_DRIVER_H
+
+// Standard library :
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include <memory>
+#include <cstdlib>
+// - POSIX :
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+// Third party:
+// - Boost :
+#include <boost/filesystem/operations.hpp>
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/things.h>
+// - Bayeux/dpp:
+#include <dpp/input_module.h>
+#include <dpp/output_module.h>
+
+namespace parallel_driver {
+
+  /// Split a file list in contiguous blocks (at most one block per file)
+  inline std::vector<std::vector<std::string> > split_file_list(const std::vector<std::string> & filenames_,
+								  std::size_t number_of_workers_)
+  {
+    DT_THROW_IF(number_of_workers_ == 0, std::range_error, "Invalid null number of workers ! ");
+    std::size_t number_of_blocks = number_of_workers_;
+    if (number_of_blocks > filenames_.size()) number_of_blocks = filenames_.size();
+    std::vector<std::vector<std::string> > blocks(number_of_blocks);
+    std::size_t ifile = 0;
+    for (std::size_t iblock = 0; iblock < number_of_blocks; iblock++)
+      {
+	// The first blocks take the remaining files :
+	const std::size_t block_size = filenames_.size() / number_of_blocks + (iblock < filenames_.size() % number_of_blocks ? 1 : 0);
+	for (std::size_t i = 0; i < block_size; i++, ifile++) blocks[iblock].push_back(filenames_[ifile]);
+      }
+    return blocks;
+  }
+
+  /// Return the index of the first file of a block in the full file list
+  inline std::size_t get_first_file_index(const std::vector<std::vector<std::string> > & blocks_,
+					  std::size_t block_)
+  {
+    std::size_t first_file_index = 0;
+    for (std::size_t iblock = 0; iblock < block_; iblock++) first_file_index += blocks_[iblock].size();
+    return first_file_index;
+  }
+
+  /// Return (and create) the output path of a worker
+  inline std::string make_worker_output_path(const std::string & output_path_, std::size_t worker_)
+  {
+    const std::string worker_path = output_path_ + "/worker_" + std::to_string(worker_) + "/";
+    boost::filesystem::create_directories(worker_path);
+    return worker_path;
+  }
+
+  /// Fork worker processes from the initialized program. Return the worker index
+  /// in each worker, or the number of workers in the parent once all of them are
+  /// finished (success_ is set to false if any of them failed).
+  inline std::size_t fork_workers(std::size_t number_of_workers_, bool & success_)
+  {
+    std::vector<pid_t> pids;
+    std::clog.flush();
+    std::cout.flush();
+    for (std::size_t iworker = 0; iworker < number_of_workers_; iworker++)
+      {
+	const pid_t pid = fork();
+	DT_THROW_IF(pid < 0, std::runtime_error, "Cannot fork worker #" << iworker << " ! ");
+	if (pid == 0) return iworker;
+	pids.push_back(pid);
+      }
+
+    success_ = true;
+    for (std::size_t iworker = 0; iworker < pids.size(); iworker++)
+      {
+	int status = 0;
+	waitpid(pids[iworker], &status, 0);
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+	  {
+	    std::cerr << "ERROR : Worker #" << iworker << " failed !" << std::endl;
+	    success_ = false;
+	  }
+      }
+    return number_of_workers_;
+  }
+
+  /// \brief Ordered list of named counters, stored as 'name : value' lines
+  class counters
+  {
+  public :
+
+    /// Add a value to a counter (created at the end of the list if needed)
+    void add(const std::string & name_, std::size_t value_)
+    {
+      for (std::size_t i = 0; i < _counters_.size(); i++)
+	{
+	  if (_counters_[i].first == name_)
+	    {
+	      _counters_[i].second += value_;
+	      return;
+	    }
+	}
+      _counters_.push_back(std::make_pair(name_, value_));
+      return;
+    }
+
+    /// Merge the counters of another list
+    void merge(const counters & other_)
+    {
+      for (std::size_t i = 0; i < other_._counters_.size(); i++) add(other_._counters_[i].first, other_._counters_[i].second);
+      return;
+    }
+
+    /// Print the counters
+    void print(std::ostream & out_) const
+    {
+      for (std::size_t i = 0; i < _counters_.size(); i++) out_ << _counters_[i].first << " : " << _counters_[i].second << std::endl;
+      return;
+    }
+
+    /// Store the counters in a file
+    void store(const std::string & filename_) const
+    {
+      std::ofstream file(filename_.c_str());
+      DT_THROW_IF(!file, std::runtime_error, "Cannot open counters file '" << filename_ << "' ! ");
+      print(file);
+      return;
+    }
+
+    /// Load and add the counters of a file
+    void load(const std::string & filename_)
+    {
+      std::ifstream file(filename_.c_str());
+      DT_THROW_IF(!file, std::runtime_error, "Cannot open counters file '" << filename_ << "' ! ");
+      std::string line;
+      while (std::getline(file, line))
+	{
+	  const std::size_t separator = line.rfind(" : ");
+	  if (separator == std::string::npos) continue;
+	  add(line.substr(0, separator), std::stoull(line.substr(separator + 3)));
+	}
+      return;
+    }
+
+  private :
+
+    std::vector<std::pair<std::string, std::size_t> > _counters_; //!< Named counters
+
+  };
+
+  /// \brief Reader of a list of data files, one file after the other
+  ///
+  /// Each record is identified by the index of its file in the full input list
+  /// and by its index in this file.
+  class file_list_reader
+  {
+  public :
+
+    /// Default constructor
+    file_list_reader()
+    {
+      _first_file_index_ = 0;
+      _max_records_per_file_ = 0;
+      _next_file_ = 0;
+      _file_index_ = 0;
+      _record_index_ = 0;
+      _number_of_records_in_file_ = 0;
+      return;
+    }
+
+    /// Initialize with a list of files, the index of its first file in the full input list and
+    /// the maximum number of records per file (0 for all)
+    void initialize(const std::vector<std::string> & filenames_,
+		    std::size_t first_file_index_,
+		    std::size_t max_records_per_file_)
+    {
+      _filenames_ = filenames_;
+      _first_file_index_ = first_file_index_;
+      _max_records_per_file_ = max_records_per_file_;
+      _next_file_ = 0;
+      _open_next_file_();
+      return;
+    }
+
+    /// Check if all the records are read
+    bool is_terminated() const
+    {
+      return !_reader_ || _reader_->is_terminated();
+    }
+
+    /// Read the next record
+    void process(datatools::things & record_)
+    {
+      DT_THROW_IF(is_terminated(), std::logic_error, "No more records to read ! ");
+      _file_index_ = _first_file_index_ + _next_file_ - 1;
+      _record_index_ = _number_of_records_in_file_++;
+      _reader_->process(record_);
+      if (_reader_->is_terminated()) _open_next_file_();
+      return;
+    }
+
+    /// Return the index (in the full input list) of the file of the last read record
+    std::size_t get_file_index() const
+    {
+      return _file_index_;
+    }
+
+    /// Return the index of the last read record in its file
+    std::size_t get_record_index() const
+    {
+      return _record_index_;
+    }
+
+  private :
+
+    /// Open the next file with records to read
+    void _open_next_file_()
+    {
+      if (_reader_) _reader_->reset();
+      _reader_.reset();
+      while (_next_file_ < _filenames_.size())
+	{
+	  datatools::properties reader_config;
+	  reader_config.store("files.mode", "single");
+	  reader_config.store("files.single.filename", _filenames_[_next_file_]);
+	  if (_max_records_per_file_ > 0) reader_config.store("max_record_per_file", static_cast<int>(_max_records_per_file_));
+	  _next_file_++;
+	  _number_of_records_in_file_ = 0;
+	  _reader_.reset(new dpp::input_module);
+	  _reader_->initialize_standalone(reader_config);
+	  if (!_reader_->is_terminated()) break;
+	  _reader_->reset();
+	  _reader_.reset();
+	}
+      return;
+    }
+
+    std::vector<std::string> _filenames_;          //!< Files to read
+    std::size_t _first_file_index_;                //!< Index of the first file in the full input list
+    std::size_t _max_records_per_file_;            //!< Maximum number of records per file
+    std::size_t _next_file_;                       //!< Next file to open
+    std::size_t _file_index_;                      //!< File index of the last read record
+    std::size_t _record_index_;                    //!< Index in its file of the last read record
+    std::size_t _number_of_records_in_file_;       //!< Number of records read in the current file
+    std::unique_ptr<dpp::input_module> _reader_;   //!< Reader of the current file
+
+  };
+
+  /// Concatenate data files (in the given order) in a single output file
+  inline void merge_data_files(const std::vector<std::string> & input_filenames_,
+			       const std::string & output_filename_)
+  {
+    std::vector<std::string> existing_filenames;
+    for (std::size_t i = 0; i < input_filenames_.size(); i++)
+      {
+	if (boost::filesystem::exists(input_filenames_[i])) existing_filenames.push_back(input_filenames_[i]);
+      }
+
+    dpp::output_module writer;
+    datatools::properties writer_config;
+    writer_config.store("files.mode", "single");
+    writer_config.store("files.single.filename", output_filename_);
+    writer.initialize_standalone(writer_config);
+
+    if (!existing_filenames.empty())
+      {
+	dpp::input_module reader;
+	datatools::properties reader_config;
+	reader_config.store("files.mode", "list");
+	reader_config.store("files.list.filenames", existing_filenames);
+	reader.initialize_standalone(reader_config);
+	datatools::things ER;
+	while (!reader.is_terminated())
+	  {
+	    reader.process(ER);
+	    writer.process(ER);
+	    ER.clear();
+	  }
+	reader.reset();
+      }
+    writer.reset();
+    return;
+  }
+
+} // end of namespace parallel_driver
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_DEVEL_PARALLEL_DRIVER_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -27,6 +27,12 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/program_options.hpp>
 
+// This project :
+#include <snemo/digitization/counter_rng.h>
+
+// Devel :
+#include "parallel_driver.h"
+
 int main( int  argc_ , char **argv_  )
 {
   falaise::initialize(argc_, argv_);
@@ -129,8 +135,8 @@ int main( int  argc_ , char **argv_  )
 
     std::clog << "Program to modify 'Simulated Data' and add Geiger hits depending of the mode : self trigger, neighbourg trigger or again trigger for a given cell' !" << std::endl;
     int32_t seed = 314159;
-    mygsl::rng random_generator;
-    random_generator.initialize(seed);
+    // Per event random streams :
+    snemo::digitization::counter_rng random_generator;
 
     // Configure the geometry manager :
     std::string manager_config_file;
@@ -172,17 +178,9 @@ int main( int  argc_ , char **argv_  )
     modif_sd_config.store ("files.incremental.stop", 1000);
     modif_sd_writer.initialize_standalone(modif_sd_config);
     
-    // Event reader :
-    dpp::input_module reader;
-    datatools::properties reader_config;
-    reader_config.store("logging.priority", "debug");
-    reader_config.store("files.mode", "list");
-    reader_config.store("files.list.filenames", input_filenames);
-    reader_config.store("max_record_total", max_record_total);
-    reader_config.store("max_record_per_file", static_cast<int>(max_events));
-    reader_config.tree_dump(std::clog, "Input module configuration parameters: ");
-    reader.initialize_standalone(reader_config);
-    reader.tree_dump(std::clog, "Simulated data reader module");
+    // Event reader (events are identified by their input file and their index in this file) :
+    parallel_driver::file_list_reader reader;
+    reader.initialize(input_filenames, 0, max_events);
 
     int psd_count = 0; // Event counter
 
@@ -199,6 +197,7 @@ int main( int  argc_ , char **argv_  )
     while (!reader.is_terminated())
       {
     	reader.process(ER);
+    	random_generator.set_stream(seed, reader.get_file_index(), reader.get_record_index(), snemo::digitization::counter_rng::STREAM_GEIGER);
     	DT_LOG_WARNING(logging, "Event #" << psd_count);
 	// A plain `mctools::simulated_data' object is stored here :
 	if (ER.has(SD_bank_label) && ER.is_a<mctools::simulated_data>(SD_bank_label))
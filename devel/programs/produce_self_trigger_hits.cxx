@@ -41,6 +41,7 @@
 
 // This project
 #include <snemo/digitization/signal_data.h>
+#include <snemo/digitization/signal_archive.h>
 
 
 
@@ -64,6 +65,7 @@ int main( int  argc_ , char **argv_  )
     bool is_display = false;
     std::string output_path = "";
     std::string config_file = "";
+    bool with_signal_archive = false;
 
     // Parse options:
     namespace po = boost::program_options;
@@ -77,6 +79,8 @@ int main( int  argc_ , char **argv_  )
       ("config,c",
        po::value<std::string>(& config_file),
        "set the config file to produce self trigger events")
+      ("signal-archive,a",
+       "also store the events in an indexed signal archive (random access, memory mapped reading)")
       ; // end of options description
 
     // Describe command line arguments :
@@ -97,6 +101,10 @@ int main( int  argc_ , char **argv_  )
       is_display = true;
     }
 
+    if (vm.count("signal-archive")) {
+      with_signal_archive = true;
+    }
+
     // Set the default output path :
     if (output_path.empty()) output_path = "/tmp/";
     DT_LOG_INFORMATION(logging, "Output path : " + output_path);
@@ -138,6 +146,14 @@ int main( int  argc_ , char **argv_  )
     datatools::data_writer serializer(output_filename,
                                       datatools::using_multiple_archives);
 
+    // Indexed signal archive :
+    snemo::digitization::signal_archive_writer archive_writer;
+    if (with_signal_archive) {
+      std::string output_archive_filename = output_path + '/' + "self_trigger_hits.sigarc";
+      DT_LOG_INFORMATION(logging, "Signal archive output file :" + output_archive_filename);
+      archive_writer.open(output_archive_filename);
+    }
+
     //serializer.initialize_standalone(writer_config);
     //serializer.tree_dump(std::clog, "Self Trigger hits writer module");
 
@@ -398,6 +414,7 @@ int main( int  argc_ , char **argv_  )
 	    // 	      << " Number of geiger in event : " << number_of_geiger_in_event << std::endl;
 
 	    serializer.store(event_signals);
+	    if (archive_writer.is_open()) archive_writer.write(event_signals);
 
 	    event_counter++;
 	  }
@@ -408,6 +425,8 @@ int main( int  argc_ , char **argv_  )
 
     std::clog << "Number of events = " << collection_of_events.size() << " event counter " << event_counter << std::endl;
 
+    if (archive_writer.is_open()) archive_writer.close();
+
 
     std::ofstream ftmp;
     ftmp.open(output_path + "produce_self_trigger_hits_output.dat");
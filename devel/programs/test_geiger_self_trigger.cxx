@@ -38,6 +38,10 @@
 #include <snemo/digitization/geiger_tp_to_ctw_algo.h>
 
 #include <snemo/digitization/trigger_algorithm.h>
+#include <snemo/digitization/counter_rng.h>
+
+// Devel :
+#include "parallel_driver.h"
 
 int main( int  argc_ , char **argv_  )
 {
@@ -136,8 +140,8 @@ int main( int  argc_ , char **argv_  )
 
     std::clog << "Test program for class ' !" << std::endl;
     int32_t seed = 314159;
-    mygsl::rng random_generator;
-    random_generator.initialize(seed);
+    // Per event random streams :
+    snemo::digitization::counter_rng random_generator;
 
     // Configure the geometry manager :
     std::string manager_config_file;
@@ -164,17 +168,9 @@ int main( int  argc_ , char **argv_  )
     std::clog << "max_record total = " << max_record_total << std::endl;
     std::clog << "max_events       = " << max_events << std::endl;
 
-    // Event reader :
-    dpp::input_module reader;
-    datatools::properties reader_config;
-    reader_config.store("logging.priority", "debug");
-    reader_config.store("files.mode", "list");
-    reader_config.store("files.list.filenames", input_filenames);
-    reader_config.store("max_record_total", max_record_total);
-    reader_config.store("max_record_per_file", static_cast<int>(max_events));
-    reader_config.tree_dump(std::clog, "Input module configuration parameters: ");
-    reader.initialize_standalone(reader_config);
-    reader.tree_dump(std::clog, "Simulated data reader module");
+    // Event reader (events are identified by their input file and their index in this file) :
+    parallel_driver::file_list_reader reader;
+    reader.initialize(input_filenames, 0, max_events);
 
     // Electronic mapping :
     snemo::digitization::electronic_mapping my_e_mapping;
@@ -202,16 +198,10 @@ int main( int  argc_ , char **argv_  )
     snemo::digitization::signal_to_geiger_tp_algo signal_2_geiger_tp;
     signal_2_geiger_tp.initialize(my_e_mapping);
 
-    // Initializing calo_tp to calo_ctw algorithms for each crate :
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_0;
-    calo_tp_2_ctw_0.set_crate_number(snemo::digitization::mapping::MAIN_CALO_SIDE_0_CRATE);
-    calo_tp_2_ctw_0.initialize();
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_1;
-    calo_tp_2_ctw_1.set_crate_number(snemo::digitization::mapping::MAIN_CALO_SIDE_1_CRATE);
-    calo_tp_2_ctw_1.initialize();
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_2;
-    calo_tp_2_ctw_2.set_crate_number(snemo::digitization::mapping::XWALL_GVETO_CALO_CRATE);
-    calo_tp_2_ctw_2.initialize();
+    // Initializing calo_tp to calo_ctw algorithm for all crates :
+    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw;
+    calo_tp_2_ctw.set_all_crates();
+    calo_tp_2_ctw.initialize();
 
     // Initializing geiger_tp to geiger_ctw :
     snemo::digitization::geiger_tp_to_ctw_algo geiger_tp_2_ctw;
@@ -258,6 +248,7 @@ int main( int  argc_ , char **argv_  )
     while (!reader.is_terminated())
       {
     	reader.process(ER);
+    	random_generator.set_stream(seed, reader.get_file_index(), reader.get_record_index(), snemo::digitization::counter_rng::STREAM_GEIGER);
     	DT_LOG_WARNING(logging, "Event #" << psd_count);
 	// A plain `mctools::simulated_data' object is stored here :
 	if (ER.has(SD_bank_label) && ER.is_a<mctools::simulated_data>(SD_bank_label))
@@ -40,6 +40,13 @@
 
 #include <snemo/digitization/trigger_algorithm.h>
 
+// Devel :
+#include "parallel_driver.h"
+
+/// Merge the trigger decision trees of the workers (in worker order, event IDs are shifted as in a serial run)
+void merge_trigger_decision_trees(const std::vector<std::string> & input_filenames_,
+				  const std::string & output_filename_);
+
 int main( int  argc_ , char **argv_  )
 {
   falaise::initialize(argc_, argv_);
@@ -53,6 +60,7 @@ int main( int  argc_ , char **argv_  )
   std::string trigger_config_filename = "";
   std::string output_path = "";
   std::size_t max_events = 0;
+  std::size_t number_of_jobs = 1;
 
   try {
     // Parse options:
@@ -73,6 +81,9 @@ int main( int  argc_ , char **argv_  )
       ("event_number,n",
        po::value<std::size_t>(& max_events)->default_value(10),
        "set the maximum number of events")
+      ("jobs,j",
+       po::value<std::size_t>(& number_of_jobs)->default_value(1),
+       "set the number of worker processes (input files are split in contiguous blocks)")
       ; // end of options description
 
     // Describe command line arguments :
@@ -118,8 +129,6 @@ int main( int  argc_ , char **argv_  )
     if (is_display) debug = true;
 
     int32_t seed = 314159;
-    mygsl::rng random_generator;
-    random_generator.initialize(seed);
 
     std::string manager_config_file;
     manager_config_file = "@falaise:config/snemo/demonstrator/geometry/4.0/manager.conf";
@@ -142,99 +151,10 @@ int main( int  argc_ , char **argv_  )
     // Trigger Decision Data "TDD" bank label :
     std::string TDD_bank_label = "TDD";
 
-    // Number of events :
-    int max_record_total = static_cast<int>(max_events) * static_cast<int>(input_filenames.size());
-    std::clog << "max_record total = " << max_record_total << std::endl;
-    std::clog << "max_events       = " << max_events << std::endl;
-
-    // Event reader :
-    dpp::input_module reader;
-    datatools::properties reader_config;
-    reader_config.store("logging.priority", "debug");
-    // reader_config.store ("files.mode", "single");
-    // reader_config.store_path("files.single.filename", input_filename);
-    reader_config.store("files.mode", "list");
-    reader_config.store("files.list.filenames", input_filenames);
-    reader_config.store("max_record_total", max_record_total);
-    reader_config.store("max_record_per_file", static_cast<int>(max_events));
-    reader_config.tree_dump(std::clog, "Input module configuration parameters: ");
-    reader.initialize_standalone(reader_config);
-    if (debug) reader.tree_dump(std::clog, "Simulated data reader module");
-
     datatools::fetch_path_with_env(output_path);
     if (output_path.empty()) output_path = "/tmp/";
     DT_LOG_INFORMATION(logging, "Output path : " + output_path);
 
-    // Name of SD output files (FT : Fake Trigger & RT: Real Trigger) :
-    std::string SD_prompt_real_trigger_no   = output_path + "prompt_DT_no" + ".brio";
-    std::string SD_prompt_real_trigger_yes  = output_path + "prompt_DT_yes" + ".brio";
-    std::string SD_delayed_real_trigger_no  = output_path + "delayed_DT_no" + ".brio";
-    std::string SD_delayed_real_trigger_yes = output_path + "delayed_DT_yes" + ".brio";
-
-    // Event writer :
-    dpp::output_module writer_1;
-    datatools::properties writer_config_1;
-    writer_config_1.store ("logging.priority", "debug");
-    writer_config_1.store ("files.mode", "single");
-    writer_config_1.store ("files.single.filename", SD_prompt_real_trigger_no);
-    writer_1.initialize_standalone(writer_config_1);
-
-    // Event writer :
-    dpp::output_module writer_2;
-    datatools::properties writer_config_2;
-    writer_config_2.store ("logging.priority", "debug");
-    writer_config_2.store ("files.mode", "single");
-    writer_config_2.store ("files.single.filename", SD_prompt_real_trigger_yes);
-    writer_2.initialize_standalone(writer_config_2);
-
-    // Event writer :
-    dpp::output_module writer_3;
-    datatools::properties writer_config_3;
-    writer_config_3.store ("logging.priority", "debug");
-    writer_config_3.store ("files.mode", "single");
-    writer_config_3.store ("files.single.filename", SD_delayed_real_trigger_no);
-    writer_3.initialize_standalone(writer_config_3);
-
-    // Event writer :
-    dpp::output_module writer_4;
-    datatools::properties writer_config_4;
-    writer_config_4.store ("logging.priority", "debug");
-    writer_config_4.store ("files.mode", "single");
-    writer_config_4.store ("files.single.filename", SD_delayed_real_trigger_yes);
-    writer_4.initialize_standalone(writer_config_4);
-
-    // Event record :
-    datatools::things ER;
-
-    // Output ROOT file :
-    std::string root_filename = output_path + "trigger_validation.root";
-    datatools::fetch_path_with_env(root_filename);
-    TFile* root_file = new TFile(root_filename.c_str(), "RECREATE");
-
-    TTree* trigger_decision_tree = new TTree("TriggerDecision", "Trigger decision histograms");
-
-    // Variables definitions :
-    Int_t event_id    = 0;
-    Bool_t raw_trigger_prompt_decision = false;
-    Bool_t raw_trigger_delayed_decision = false;
-    Int_t total_number_of_calo = 0;
-    Int_t total_number_of_main_calo = 0;
-    Int_t total_number_of_gveto = 0;
-    Int_t total_number_of_gg_cells = 0;
-    Int_t total_number_of_prompt_gg_cells = 0;
-    Int_t total_number_of_delayed_gg_cells = 0;
-
-    // Branch definitions :
-    trigger_decision_tree->Branch("event_id", &event_id, "evend_id/I");
-    trigger_decision_tree->Branch("raw_trigger_prompt_decision", &raw_trigger_prompt_decision, "raw_trigger_prompt_decision/O");
-    trigger_decision_tree->Branch("raw_trigger_delayed_decision", &raw_trigger_delayed_decision, "raw_trigger_delayed_decision/O");
-    trigger_decision_tree->Branch("total_number_of_calo", &total_number_of_calo, "total_number_of_calo/I");
-    trigger_decision_tree->Branch("total_number_of_main_calo", &total_number_of_main_calo, "total_number_of_main_calo/I");
-    trigger_decision_tree->Branch("total_number_of_gveto", &total_number_of_gveto, "total_number_of_gveto/I");
-    trigger_decision_tree->Branch("total_number_of_gg_cells", &total_number_of_gg_cells, "total_number_of_gg_cells/I");
-    trigger_decision_tree->Branch("total_number_of_prompt_gg_cells", &total_number_of_prompt_gg_cells, "total_number_of_prompt_gg_cells/I");
-    trigger_decision_tree->Branch("total_number_of_delayed_gg_cells", &total_number_of_delayed_gg_cells, "total_number_of_delayed_gg_cells/I");
-
     // Electronic mapping :
     snemo::digitization::electronic_mapping my_e_mapping;
     my_e_mapping.set_geo_manager(my_manager);
@@ -261,16 +181,10 @@ int main( int  argc_ , char **argv_  )
     snemo::digitization::signal_to_geiger_tp_algo signal_2_geiger_tp;
     signal_2_geiger_tp.initialize(my_e_mapping);
 
-    // Initializing calo tp to calo ctw algorithms for each crate :
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_0;
-    calo_tp_2_ctw_0.set_crate_number(snemo::digitization::mapping::MAIN_CALO_SIDE_0_CRATE);
-    calo_tp_2_ctw_0.initialize();
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_1;
-    calo_tp_2_ctw_1.set_crate_number(snemo::digitization::mapping::MAIN_CALO_SIDE_1_CRATE);
-    calo_tp_2_ctw_1.initialize();
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_2;
-    calo_tp_2_ctw_2.set_crate_number(snemo::digitization::mapping::XWALL_GVETO_CALO_CRATE);
-    calo_tp_2_ctw_2.initialize();
+    // Initializing calo tp to calo ctw algorithm for all crates :
+    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw;
+    calo_tp_2_ctw.set_all_crates();
+    calo_tp_2_ctw.initialize();
 
     // Initializing geiger tp to geiger ctw :
     snemo::digitization::geiger_tp_to_ctw_algo geiger_tp_2_ctw;
@@ -417,6 +331,128 @@ int main( int  argc_ , char **argv_  )
     trigger_display_config.store("coinc_1600ns", coinc_1600ns);
     my_trigger_display.initialize(trigger_display_config);
 
+    // Output files :
+    const std::vector<std::string> output_data_filenames = {"prompt_DT_no.brio",
+							    "prompt_DT_yes.brio",
+							    "delayed_DT_no.brio",
+							    "delayed_DT_yes.brio"};
+    const std::string output_root_filename = "trigger_validation.root";
+
+    // Work splitting, each worker process handles a contiguous block of input files :
+    const std::vector<std::vector<std::string> > file_blocks = parallel_driver::split_file_list(input_filenames, number_of_jobs);
+    std::size_t first_file_index = 0;
+    if (file_blocks.size() > 1) {
+      std::vector<std::string> worker_output_paths;
+      for (std::size_t iworker = 0; iworker < file_blocks.size(); iworker++) {
+	worker_output_paths.push_back(parallel_driver::make_worker_output_path(output_path, iworker));
+      }
+      bool workers_success = false;
+      const std::size_t worker = parallel_driver::fork_workers(file_blocks.size(), workers_success);
+      if (worker < file_blocks.size()) {
+	// Worker : run the pipeline on its block of files
+	input_filenames = file_blocks[worker];
+	first_file_index = parallel_driver::get_first_file_index(file_blocks, worker);
+	output_path = worker_output_paths[worker];
+	DT_LOG_INFORMATION(logging, "Worker #" << worker << " output path : " << output_path);
+      } else {
+	// Parent : merge the worker outputs in worker order
+	DT_THROW_IF(!workers_success, std::runtime_error, "At least one worker failed !");
+	std::vector<std::string> worker_root_filenames;
+	for (std::size_t iworker = 0; iworker < worker_output_paths.size(); iworker++) {
+	  worker_root_filenames.push_back(worker_output_paths[iworker] + output_root_filename);
+	}
+	merge_trigger_decision_trees(worker_root_filenames, output_path + output_root_filename);
+	for (std::size_t ifile = 0; ifile < output_data_filenames.size(); ifile++) {
+	  std::vector<std::string> worker_data_filenames;
+	  for (std::size_t iworker = 0; iworker < worker_output_paths.size(); iworker++) {
+	    worker_data_filenames.push_back(worker_output_paths[iworker] + output_data_filenames[ifile]);
+	  }
+	  parallel_driver::merge_data_files(worker_data_filenames, output_path + output_data_filenames[ifile]);
+	}
+
+	std::clog << "The end." << std::endl;
+	falaise::terminate();
+	return error_code;
+      }
+    }
+
+    // Number of events :
+    std::clog << "max_events       = " << max_events << std::endl;
+
+    // Event reader (events are identified by their input file and their index in this file) :
+    parallel_driver::file_list_reader reader;
+    reader.initialize(input_filenames, first_file_index, max_events);
+
+    // Name of SD output files (FT : Fake Trigger & RT: Real Trigger) :
+    std::string SD_prompt_real_trigger_no   = output_path + output_data_filenames[0];
+    std::string SD_prompt_real_trigger_yes  = output_path + output_data_filenames[1];
+    std::string SD_delayed_real_trigger_no  = output_path + output_data_filenames[2];
+    std::string SD_delayed_real_trigger_yes = output_path + output_data_filenames[3];
+
+    // Event writer :
+    dpp::output_module writer_1;
+    datatools::properties writer_config_1;
+    writer_config_1.store ("logging.priority", "debug");
+    writer_config_1.store ("files.mode", "single");
+    writer_config_1.store ("files.single.filename", SD_prompt_real_trigger_no);
+    writer_1.initialize_standalone(writer_config_1);
+
+    // Event writer :
+    dpp::output_module writer_2;
+    datatools::properties writer_config_2;
+    writer_config_2.store ("logging.priority", "debug");
+    writer_config_2.store ("files.mode", "single");
+    writer_config_2.store ("files.single.filename", SD_prompt_real_trigger_yes);
+    writer_2.initialize_standalone(writer_config_2);
+
+    // Event writer :
+    dpp::output_module writer_3;
+    datatools::properties writer_config_3;
+    writer_config_3.store ("logging.priority", "debug");
+    writer_config_3.store ("files.mode", "single");
+    writer_config_3.store ("files.single.filename", SD_delayed_real_trigger_no);
+    writer_3.initialize_standalone(writer_config_3);
+
+    // Event writer :
+    dpp::output_module writer_4;
+    datatools::properties writer_config_4;
+    writer_config_4.store ("logging.priority", "debug");
+    writer_config_4.store ("files.mode", "single");
+    writer_config_4.store ("files.single.filename", SD_delayed_real_trigger_yes);
+    writer_4.initialize_standalone(writer_config_4);
+
+    // Event record :
+    datatools::things ER;
+
+    // Output ROOT file :
+    std::string root_filename = output_path + output_root_filename;
+    datatools::fetch_path_with_env(root_filename);
+    TFile* root_file = new TFile(root_filename.c_str(), "RECREATE");
+
+    TTree* trigger_decision_tree = new TTree("TriggerDecision", "Trigger decision histograms");
+
+    // Variables definitions :
+    Int_t event_id    = 0;
+    Bool_t raw_trigger_prompt_decision = false;
+    Bool_t raw_trigger_delayed_decision = false;
+    Int_t total_number_of_calo = 0;
+    Int_t total_number_of_main_calo = 0;
+    Int_t total_number_of_gveto = 0;
+    Int_t total_number_of_gg_cells = 0;
+    Int_t total_number_of_prompt_gg_cells = 0;
+    Int_t total_number_of_delayed_gg_cells = 0;
+
+    // Branch definitions :
+    trigger_decision_tree->Branch("event_id", &event_id, "evend_id/I");
+    trigger_decision_tree->Branch("raw_trigger_prompt_decision", &raw_trigger_prompt_decision, "raw_trigger_prompt_decision/O");
+    trigger_decision_tree->Branch("raw_trigger_delayed_decision", &raw_trigger_delayed_decision, "raw_trigger_delayed_decision/O");
+    trigger_decision_tree->Branch("total_number_of_calo", &total_number_of_calo, "total_number_of_calo/I");
+    trigger_decision_tree->Branch("total_number_of_main_calo", &total_number_of_main_calo, "total_number_of_main_calo/I");
+    trigger_decision_tree->Branch("total_number_of_gveto", &total_number_of_gveto, "total_number_of_gveto/I");
+    trigger_decision_tree->Branch("total_number_of_gg_cells", &total_number_of_gg_cells, "total_number_of_gg_cells/I");
+    trigger_decision_tree->Branch("total_number_of_prompt_gg_cells", &total_number_of_prompt_gg_cells, "total_number_of_prompt_gg_cells/I");
+    trigger_decision_tree->Branch("total_number_of_delayed_gg_cells", &total_number_of_delayed_gg_cells, "total_number_of_delayed_gg_cells/I");
+
     // Internal counters
     int psd_count = 0;         // Event counter
 
@@ -439,7 +475,8 @@ int main( int  argc_ , char **argv_  )
 	    // Access to the "SD" bank with a stored `mctools::simulated_data' :
 	    const mctools::simulated_data & SD = ER.get<mctools::simulated_data>(SD_bank_label);
 
-	    my_clock_manager.compute_clockticks_ref(random_generator);
+	    // Per event clock phase, independent of the other events :
+	    my_clock_manager.compute_clockticks_ref(seed, reader.get_file_index(), reader.get_record_index());
 	    int32_t clocktick_25_reference  = my_clock_manager.get_clocktick_25_ref();
 	    double  clocktick_25_shift      = my_clock_manager.get_shift_25();
 	    int32_t clocktick_800_reference = my_clock_manager.get_clocktick_800_ref();
@@ -483,9 +520,7 @@ int main( int  argc_ , char **argv_  )
 		    if (debug) my_calo_tp_data.tree_dump(std::clog, "Calorimeter TP(s) data : ", "INFO : ");
 
 		    // Calo TP to geiger CTW process :
-		    calo_tp_2_ctw_0.process(my_calo_tp_data, my_calo_ctw_data);
-		    calo_tp_2_ctw_1.process(my_calo_tp_data, my_calo_ctw_data);
-		    calo_tp_2_ctw_2.process(my_calo_tp_data, my_calo_ctw_data);
+		    calo_tp_2_ctw.process(my_calo_tp_data, my_calo_ctw_data);
 		    if (debug) my_calo_ctw_data.tree_dump(std::clog, "Calorimeter CTW(s) data : ", "INFO : ");
 		  } // end of if has calo signal
 
@@ -577,6 +612,12 @@ int main( int  argc_ , char **argv_  )
     root_file->Write();
     root_file->Close();
 
+    // Flush the output files before a worker exits :
+    writer_1.reset();
+    writer_2.reset();
+    writer_3.reset();
+    writer_4.reset();
+
     std::clog << "The end." << std::endl;
   }
 
@@ -593,3 +634,40 @@ int main( int  argc_ , char **argv_  )
   falaise::terminate();
   return error_code;
 }
+
+void merge_trigger_decision_trees(const std::vector<std::string> & input_filenames_,
+				  const std::string & output_filename_)
+{
+  TFile * output_file = new TFile(output_filename_.c_str(), "RECREATE");
+  TTree * output_tree = 0;
+  Int_t event_id_offset = 0;
+  for (std::size_t ifile = 0; ifile < input_filenames_.size(); ifile++)
+    {
+      TFile * input_file = TFile::Open(input_filenames_[ifile].c_str(), "READ");
+      DT_THROW_IF(input_file == 0 || input_file->IsZombie(), std::runtime_error, "Cannot open ROOT file '" << input_filenames_[ifile] << "' ! ");
+      TTree * input_tree = static_cast<TTree *>(input_file->Get("TriggerDecision"));
+      DT_THROW_IF(input_tree == 0, std::runtime_error, "No trigger decision tree in ROOT file '" << input_filenames_[ifile] << "' ! ");
+      Int_t event_id = 0;
+      input_tree->SetBranchAddress("event_id", &event_id);
+      output_file->cd();
+      // Same branches, the event ID branch is set to the shifted value before each fill :
+      if (output_tree == 0) output_tree = input_tree->CloneTree(0);
+      else input_tree->CopyAddresses(output_tree);
+      const Long64_t number_of_entries = input_tree->GetEntries();
+      for (Long64_t ientry = 0; ientry < number_of_entries; ientry++)
+	{
+	  input_tree->GetEntry(ientry);
+	  event_id += event_id_offset;
+	  output_tree->Fill();
+	}
+      event_id_offset += number_of_entries;
+      input_tree->ResetBranchAddresses();
+      input_file->Close();
+      delete input_file;
+    }
+  output_file->cd();
+  if (output_tree != 0) output_tree->Write();
+  output_file->Close();
+  delete output_file;
+  return;
+}
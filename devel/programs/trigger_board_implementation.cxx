@@ -38,6 +38,9 @@
 
 #include <snemo/digitization/trigger_algorithm.h>
 
+// Devel :
+#include "parallel_driver.h"
+
 int main( int  argc_ , char **argv_  )
 {
   falaise::initialize(argc_, argv_);
@@ -47,6 +50,7 @@ int main( int  argc_ , char **argv_  )
   try {
     // Parsing arguments
     bool is_display      = false;
+    bool is_fifo_binary  = false;
 
     std::vector<std::string> input_filenames;
     std::string trigger_config_filename = "";
@@ -59,6 +63,7 @@ int main( int  argc_ , char **argv_  )
     opts.add_options()
       ("help,h", "produce help message")
       ("display,d", "display mode")
+      ("fifo-binary,b", "write the CTW FIFO dumps in binary form")
       ("input,i",
        po::value<std::vector<std::string> >(& input_filenames)->multitoken(),
        "set a list of input files")
@@ -92,6 +97,10 @@ int main( int  argc_ , char **argv_  )
       is_display = true;
     }
 
+    if (vm.count("fifo-binary")) {
+      is_fifo_binary = true;
+    }
+
     std::clog << "Program for trigger board implementation at LAL !" << std::endl;
 
     std::size_t file_counter = 0;
@@ -116,8 +125,6 @@ int main( int  argc_ , char **argv_  )
 
     std::clog << "Test program for class ' !" << std::endl;
     int32_t seed = 314159;
-    mygsl::rng random_generator;
-    random_generator.initialize(seed);
 
     std::string manager_config_file;
 
@@ -144,15 +151,9 @@ int main( int  argc_ , char **argv_  )
     std::clog << "max_record total = " << max_record_total << std::endl;
     std::clog << "max_events       = " << max_events << std::endl;
 
-    // Event reader :
-    dpp::input_module reader;
-    datatools::properties reader_config;
-    reader_config.store("logging.priority", "debug");
-    reader_config.store("files.mode", "list");
-    reader_config.store("files.list.filenames", input_filenames);
-    reader_config.store("max_record_total", max_record_total);
-    reader_config.store("max_record_per_file", static_cast<int>(max_events));
-    reader.initialize_standalone(reader_config);
+    // Event reader (events are identified by their input file and their index in this file) :
+    parallel_driver::file_list_reader reader;
+    reader.initialize(input_filenames, 0, max_events);
 
     datatools::fetch_path_with_env(output_path);
     if (output_path.empty()) output_path = "/tmp/";
@@ -184,16 +185,10 @@ int main( int  argc_ , char **argv_  )
     snemo::digitization::signal_to_geiger_tp_algo signal_2_geiger_tp;
     signal_2_geiger_tp.initialize(my_e_mapping);
 
-    // Initializing calo tp to calo ctw algorithms for each crate :
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_0;
-    calo_tp_2_ctw_0.set_crate_number(snemo::digitization::mapping::MAIN_CALO_SIDE_0_CRATE);
-    calo_tp_2_ctw_0.initialize();
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_1;
-    calo_tp_2_ctw_1.set_crate_number(snemo::digitization::mapping::MAIN_CALO_SIDE_1_CRATE);
-    calo_tp_2_ctw_1.initialize();
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_2;
-    calo_tp_2_ctw_2.set_crate_number(snemo::digitization::mapping::XWALL_GVETO_CALO_CRATE);
-    calo_tp_2_ctw_2.initialize();
+    // Initializing calo tp to calo ctw algorithm for all crates :
+    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw;
+    calo_tp_2_ctw.set_all_crates();
+    calo_tp_2_ctw.initialize();
 
     // Initializing geiger tp to geiger ctw :
     snemo::digitization::geiger_tp_to_ctw_algo geiger_tp_2_ctw;
@@ -334,6 +329,7 @@ int main( int  argc_ , char **argv_  )
     trigger_display_config.store("calo_1600ns", calo_1600ns);
     trigger_display_config.store("tracker_1600ns", tracker_1600ns);
     trigger_display_config.store("coinc_1600ns", coinc_1600ns);
+    trigger_display_config.store("fifo_binary", is_fifo_binary);
     my_trigger_display.initialize(trigger_display_config);
 
     // Creation and initialization of trigger algorithm :
@@ -352,18 +348,20 @@ int main( int  argc_ , char **argv_  )
     std::string output_calo_ctw_0_filename = output_path + "output_calo_ctw_0.data";
     std::string output_calo_ctw_1_filename = output_path + "output_calo_ctw_1.data";
     std::string output_calo_ctw_2_filename = output_path + "output_calo_ctw_2.data";
+    // Binary FIFO dumps can be printed with the trigger_fifo_print program :
+    const std::ios_base::openmode fifo_mode = is_fifo_binary ? std::ios_base::out | std::ios_base::binary : std::ios_base::out;
     std::ofstream of_calo_ctw[3];
-    of_calo_ctw[0].open(output_calo_ctw_0_filename);
-    of_calo_ctw[1].open(output_calo_ctw_1_filename);
-    of_calo_ctw[2].open(output_calo_ctw_2_filename);
+    of_calo_ctw[0].open(output_calo_ctw_0_filename, fifo_mode);
+    of_calo_ctw[1].open(output_calo_ctw_1_filename, fifo_mode);
+    of_calo_ctw[2].open(output_calo_ctw_2_filename, fifo_mode);
 
     std::string output_gg_ctw_0_filename = output_path + "output_gg_ctw_0.data";
     std::string output_gg_ctw_1_filename = output_path + "output_gg_ctw_1.data";
     std::string output_gg_ctw_2_filename = output_path + "output_gg_ctw_2.data";
     std::ofstream of_gg_ctw[3];
-    of_gg_ctw[0].open(output_gg_ctw_0_filename);
-    of_gg_ctw[1].open(output_gg_ctw_1_filename);
-    of_gg_ctw[2].open(output_gg_ctw_2_filename);
+    of_gg_ctw[0].open(output_gg_ctw_0_filename, fifo_mode);
+    of_gg_ctw[1].open(output_gg_ctw_1_filename, fifo_mode);
+    of_gg_ctw[2].open(output_gg_ctw_2_filename, fifo_mode);
 
     while (!reader.is_terminated())
       {
@@ -384,7 +382,7 @@ int main( int  argc_ , char **argv_  )
 	    // Access to the "SD" bank with a stored `mctools::simulated_data' :
 	    const mctools::simulated_data & SD = ER.get<mctools::simulated_data>(SD_bank_label);
 
-	    my_clock_manager.compute_clockticks_ref(random_generator);
+	    my_clock_manager.compute_clockticks_ref(seed, reader.get_file_index(), reader.get_record_index());
 	    int32_t clocktick_25_reference  = my_clock_manager.get_clocktick_25_ref();
 	    double  clocktick_25_shift      = my_clock_manager.get_shift_25();
 	    int32_t clocktick_800_reference = my_clock_manager.get_clocktick_800_ref();
@@ -419,9 +417,7 @@ int main( int  argc_ , char **argv_  )
 		    signal_2_calo_tp.process(signal_data, my_calo_tp_data);
 
 		    // Calo TP to geiger CTW process :
-		    calo_tp_2_ctw_0.process(my_calo_tp_data, my_calo_ctw_data);
-		    calo_tp_2_ctw_1.process(my_calo_tp_data, my_calo_ctw_data);
-		    calo_tp_2_ctw_2.process(my_calo_tp_data, my_calo_ctw_data);
+		    calo_tp_2_ctw.process(my_calo_tp_data, my_calo_ctw_data);
 		  } // end of if has calo signal
 
 		snemo::digitization::geiger_tp_data my_geiger_tp_data;
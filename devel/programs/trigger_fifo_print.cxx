@@ -0,0 +1,87 @@
+// trigger_fifo_print.cxx
+// Standard libraries :
+#include <iostream>
+#include <fstream>
+#include <string>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// Boost :
+#include <boost/program_options.hpp>
+
+// This project :
+#include <snemo/digitization/trigger_display_manager.h>
+
+int main( int  argc_ , char **argv_  )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::string input_filename = "";
+    std::string output_filename = "";
+
+    // Parse options:
+    namespace po = boost::program_options;
+    po::options_description opts("Allowed options");
+    opts.add_options()
+      ("help,h", "produce help message")
+      ("input,i",
+       po::value<std::string>(& input_filename),
+       "set the binary CTW FIFO dump file")
+      ("output,o",
+       po::value<std::string>(& output_filename),
+       "set the text CTW FIFO dump file (standard output by default)")
+      ; // end of options description
+
+    // Describe command line arguments :
+    po::variables_map vm;
+    po::store(po::command_line_parser(argc_, argv_)
+              .options(opts)
+              .run(), vm);
+    po::notify(vm);
+
+    // Use command line arguments :
+    if (vm.count("help")) {
+      std::cout << "Usage : " << std::endl;
+      std::cout << opts << std::endl;
+      return(error_code);
+    }
+
+    DT_THROW_IF(input_filename.empty(), std::logic_error, "Missing binary CTW FIFO dump file ! ");
+    datatools::fetch_path_with_env(input_filename);
+    std::ifstream fifo_file(input_filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    DT_THROW_IF(!fifo_file, std::runtime_error, "Cannot open the binary CTW FIFO dump file '" << input_filename << "' ! ");
+
+    if (output_filename.empty())
+      {
+	snemo::digitization::trigger_display_manager::print_binary_fifo(fifo_file, std::cout);
+      }
+    else
+      {
+	datatools::fetch_path_with_env(output_filename);
+	std::ofstream text_file(output_filename.c_str());
+	DT_THROW_IF(!text_file, std::runtime_error, "Cannot open the text CTW FIFO dump file '" << output_filename << "' ! ");
+	snemo::digitization::trigger_display_manager::print_binary_fifo(fifo_file, text_file);
+      }
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
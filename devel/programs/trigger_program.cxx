@@ -37,6 +37,10 @@
 #include <snemo/digitization/geiger_tp_to_ctw_algo.h>
 
 #include <snemo/digitization/trigger_algorithm.h>
+#include <snemo/digitization/instrumentation.h>
+
+// Devel :
+#include "parallel_driver.h"
 
 int main( int  argc_ , char **argv_  )
 {
@@ -52,6 +56,7 @@ int main( int  argc_ , char **argv_  )
     std::string trigger_config_filename = "";
     std::string output_path = "";
     std::size_t max_events = 0;
+    std::size_t number_of_jobs = 1;
 
     // Parse options:
     namespace po = boost::program_options;
@@ -72,6 +77,9 @@ int main( int  argc_ , char **argv_  )
       ("event_number,n",
        po::value<std::size_t>(& max_events)->default_value(10),
        "set the maximum number of events")
+      ("jobs,j",
+       po::value<std::size_t>(& number_of_jobs)->default_value(1),
+       "set the number of worker processes (input files are split in contiguous blocks)")
       ; // end of options description
 
     // Describe command line arguments :
@@ -133,8 +141,6 @@ int main( int  argc_ , char **argv_  )
 
     std::clog << "Test program for class ' !" << std::endl;
     int32_t seed = 314159;
-    mygsl::rng random_generator;
-    random_generator.initialize(seed);
 
     // Configure the geometry manager :
     std::string manager_config_file;
@@ -156,23 +162,6 @@ int main( int  argc_ , char **argv_  )
     // Event record :
     datatools::things ER;
 
-    // Number of events :
-    int max_record_total = static_cast<int>(max_events) * static_cast<int>(input_filenames.size());
-    std::clog << "max_record total = " << max_record_total << std::endl;
-    std::clog << "max_events       = " << max_events << std::endl;
-
-    // Event reader :
-    dpp::input_module reader;
-    datatools::properties reader_config;
-    reader_config.store("logging.priority", "debug");
-    reader_config.store("files.mode", "list");
-    reader_config.store("files.list.filenames", input_filenames);
-    reader_config.store("max_record_total", max_record_total);
-    reader_config.store("max_record_per_file", static_cast<int>(max_events));
-    reader_config.tree_dump(std::clog, "Input module configuration parameters: ");
-    reader.initialize_standalone(reader_config);
-    reader.tree_dump(std::clog, "Simulated data reader module");
-
     // Electronic mapping :
     snemo::digitization::electronic_mapping my_e_mapping;
     my_e_mapping.set_geo_manager(my_manager);
@@ -199,16 +188,10 @@ int main( int  argc_ , char **argv_  )
     snemo::digitization::signal_to_geiger_tp_algo signal_2_geiger_tp;
     signal_2_geiger_tp.initialize(my_e_mapping);
 
-    // Initializing calo_tp to calo_ctw algorithms for each crate :
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_0;
-    calo_tp_2_ctw_0.set_crate_number(snemo::digitization::mapping::MAIN_CALO_SIDE_0_CRATE);
-    calo_tp_2_ctw_0.initialize();
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_1;
-    calo_tp_2_ctw_1.set_crate_number(snemo::digitization::mapping::MAIN_CALO_SIDE_1_CRATE);
-    calo_tp_2_ctw_1.initialize();
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_2;
-    calo_tp_2_ctw_2.set_crate_number(snemo::digitization::mapping::XWALL_GVETO_CALO_CRATE);
-    calo_tp_2_ctw_2.initialize();
+    // Initializing calo_tp to calo_ctw algorithm for all crates :
+    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw;
+    calo_tp_2_ctw.set_all_crates();
+    calo_tp_2_ctw.initialize();
 
     // Initializing geiger_tp to geiger_ctw :
     snemo::digitization::geiger_tp_to_ctw_algo geiger_tp_2_ctw;
@@ -346,11 +329,68 @@ int main( int  argc_ , char **argv_  )
 
     // trigger_config.tree_dump(std::clog, "My trigger config : ");
 
+    // Output files :
+    const std::vector<std::string> output_data_filenames = {"fake_trigger_SD.brio",
+							    "ft_no_rt_SD.brio",
+							    "caraco_trigger_SD.brio",
+							    "alpha_trigger_SD.brio"};
+    const std::string output_stat_filename = "output_trigger.stat";
+
+    // Work splitting, each worker process handles a contiguous block of input files :
+    const std::vector<std::vector<std::string> > file_blocks = parallel_driver::split_file_list(input_filenames, number_of_jobs);
+    std::size_t first_file_index = 0;
+    if (file_blocks.size() > 1) {
+      std::vector<std::string> worker_output_paths;
+      for (std::size_t iworker = 0; iworker < file_blocks.size(); iworker++) {
+	worker_output_paths.push_back(parallel_driver::make_worker_output_path(output_path, iworker));
+      }
+      bool workers_success = false;
+      const std::size_t worker = parallel_driver::fork_workers(file_blocks.size(), workers_success);
+      if (worker < file_blocks.size()) {
+	// Worker : run the pipeline on its block of files
+	input_filenames = file_blocks[worker];
+	first_file_index = parallel_driver::get_first_file_index(file_blocks, worker);
+	output_path = worker_output_paths[worker];
+	DT_LOG_INFORMATION(logging, "Worker #" << worker << " output path : " << output_path);
+      } else {
+	// Parent : merge the worker outputs in worker order
+	DT_THROW_IF(!workers_success, std::runtime_error, "At least one worker failed !");
+	parallel_driver::counters merged_counters;
+	for (std::size_t iworker = 0; iworker < worker_output_paths.size(); iworker++) {
+	  merged_counters.load(worker_output_paths[iworker] + output_stat_filename);
+	}
+	for (std::size_t ifile = 0; ifile < output_data_filenames.size(); ifile++) {
+	  std::vector<std::string> worker_data_filenames;
+	  for (std::size_t iworker = 0; iworker < worker_output_paths.size(); iworker++) {
+	    worker_data_filenames.push_back(worker_output_paths[iworker] + output_data_filenames[ifile]);
+	  }
+	  parallel_driver::merge_data_files(worker_data_filenames, output_path + output_data_filenames[ifile]);
+	}
+	std::ofstream statstream;
+	statstream.open(output_path + '/' + output_stat_filename);
+	statstream << "Welcome on trigger statistic file" << std::endl << std::endl;
+	merged_counters.print(statstream);
+	statstream << "The end." << std::endl;
+	statstream.close();
+
+	std::clog << "The end." << std::endl;
+	falaise::terminate();
+	return error_code;
+      }
+    }
+
+    // Number of events :
+    std::clog << "max_events       = " << max_events << std::endl;
+
+    // Event reader (events are identified by their input file and their index in this file) :
+    parallel_driver::file_list_reader reader;
+    reader.initialize(input_filenames, first_file_index, max_events);
+
     int psd_count = 0; // Event counter
 
     // Trigger output writers :
     // Fake trigger writer
-    std::string fake_trigger_filename = output_path + "fake_trigger_SD.brio";
+    std::string fake_trigger_filename = output_path + output_data_filenames[0];
     dpp::output_module ft_writer;
     datatools::properties ft_config;
     ft_config.store ("logging.priority", "debug");
@@ -359,7 +399,7 @@ int main( int  argc_ , char **argv_  )
     ft_writer.initialize_standalone (ft_config);
 
     // No real trigger but FT writer
-    std::string ft_no_rt_filename = output_path + "ft_no_rt_SD.brio"; // rt : real trigger
+    std::string ft_no_rt_filename = output_path + output_data_filenames[1]; // rt : real trigger
     dpp::output_module ft_no_rt_writer;
     datatools::properties ft_no_rt_config;
     ft_no_rt_config.store ("logging.priority", "debug");
@@ -368,7 +408,7 @@ int main( int  argc_ , char **argv_  )
     ft_no_rt_writer.initialize_standalone (ft_no_rt_config);
 
     // Caraco trigger writer
-    std::string caraco_trigger_filename = output_path + "caraco_trigger_SD.brio";
+    std::string caraco_trigger_filename = output_path + output_data_filenames[2];
     dpp::output_module caraco_writer;
     datatools::properties caraco_config;
     caraco_config.store ("logging.priority", "debug");
@@ -377,7 +417,7 @@ int main( int  argc_ , char **argv_  )
     caraco_writer.initialize_standalone (caraco_config);
 
     // Real trigger writer
-    std::string alpha_trigger_filename = output_path + "alpha_trigger_SD.brio";
+    std::string alpha_trigger_filename = output_path + output_data_filenames[3];
     dpp::output_module alpha_writer;
     datatools::properties alpha_config;
     alpha_config.store ("logging.priority", "debug");
@@ -406,7 +446,8 @@ int main( int  argc_ , char **argv_  )
 	    // Access to the "SD" bank with a stored `mctools::simulated_data' :
 	    const mctools::simulated_data & SD = ER.get<mctools::simulated_data>(SD_bank_label);
 
-	    my_clock_manager.compute_clockticks_ref(random_generator);
+	    // Per event clock phase, independent of the other events :
+	    my_clock_manager.compute_clockticks_ref(seed, reader.get_file_index(), reader.get_record_index());
 	    int32_t clocktick_25_reference  = my_clock_manager.get_clocktick_25_ref();
 	    double  clocktick_25_shift      = my_clock_manager.get_shift_25();
 	    int32_t clocktick_800_reference = my_clock_manager.get_clocktick_800_ref();
@@ -497,9 +538,7 @@ int main( int  argc_ , char **argv_  )
 		    signal_2_calo_tp.process(signal_data, my_calo_tp_data);
 
 		    // Calo TP to geiger CTW process :
-		    calo_tp_2_ctw_0.process(my_calo_tp_data, my_calo_ctw_data);
-		    calo_tp_2_ctw_1.process(my_calo_tp_data, my_calo_ctw_data);
-		    calo_tp_2_ctw_2.process(my_calo_tp_data, my_calo_ctw_data);
+		    calo_tp_2_ctw.process(my_calo_tp_data, my_calo_ctw_data);
 
 		    if (logging == datatools::logger::PRIO_TRACE) {
 		      my_calo_tp_data.tree_dump(std::clog, "Calorimeter TP(s) data : ", "INFO : ");
@@ -643,21 +682,35 @@ int main( int  argc_ , char **argv_  )
 
     // Display some stats
 
-    std::string output_stat_filename = output_path + '/' + "output_trigger.stat";
+    parallel_driver::counters trigger_counters;
+    trigger_counters.add("Total number of events", total_number_of_events);
+    trigger_counters.add("Total number of fake trigger events", total_number_of_fake_trigger_events);
+    trigger_counters.add("Total number of fake trigger delayed events", total_number_of_fake_delayed_trigger_events);
+    trigger_counters.add("Total number of fake trigger no real trigger events", total_number_of_fake_trigger_no_real_trigger_events);
+    trigger_counters.add("Total number of real trigger events", total_number_of_real_trigger_events);
+    trigger_counters.add("Total number of caraco trigger events", total_number_of_caraco_trigger_events);
+    trigger_counters.add("Total number of delayed trigger events", total_number_of_delayed_trigger_events);
+    trigger_counters.add("Total number of ape trigger events", total_number_of_ape_trigger_events);
+    trigger_counters.add("Total number of dave trigger events", total_number_of_dave_trigger_events);
+
     std::ofstream statstream;
-    statstream.open(output_stat_filename);
+    statstream.open(output_path + '/' + output_stat_filename);
     statstream << "Welcome on trigger statistic file" << std::endl << std::endl;
-
-    statstream << "Total number of events : " << total_number_of_events << std::endl;
-    statstream << "Total number of fake trigger events : " << total_number_of_fake_trigger_events << std::endl;
-    statstream << "Total number of fake trigger delayed events : " << total_number_of_fake_delayed_trigger_events << std::endl;
-    statstream << "Total number of fake trigger no real trigger events : " << total_number_of_fake_trigger_no_real_trigger_events << std::endl;
-    statstream << "Total number of real trigger events : " << total_number_of_real_trigger_events << std::endl;
-    statstream << "Total number of caraco trigger events : " << total_number_of_caraco_trigger_events << std::endl;
-    statstream << "Total number of delayed trigger events : " << total_number_of_delayed_trigger_events << std::endl;
-    statstream << "Total number of ape trigger events : " << total_number_of_ape_trigger_events << std::endl;
-    statstream << "Total number of dave trigger events : " << total_number_of_dave_trigger_events << std::endl;
+    trigger_counters.print(statstream);
     statstream << "The end." << std::endl;
+    statstream.close();
+
+    // Stage timings and counters of the digitization and trigger algorithms :
+    if (snemo::digitization::instrumentation::is_enabled()) {
+      snemo::digitization::instrumentation::registry::instance().store_report(output_path + "/output_instrumentation.json");
+      if (logging >= datatools::logger::PRIO_INFORMATION) snemo::digitization::instrumentation::registry::instance().print_text(std::clog);
+    }
+
+    // Flush the output files before a worker exits :
+    ft_writer.reset();
+    ft_no_rt_writer.reset();
+    caraco_writer.reset();
+    alpha_writer.reset();
 
     std::clog << "The end." << std::endl;
   }
@@ -34,6 +34,7 @@
 
 #include <snemo/digitization/sd_to_geiger_signal_algo.h>
 #include <snemo/digitization/signal_to_geiger_tp_algo.h>
+#include <snemo/digitization/signal_archive.h>
 #include <snemo/digitization/geiger_tp_to_ctw_algo.h>
 
 #include <snemo/digitization/trigger_algorithm.h>
@@ -47,6 +48,9 @@ int main( int  argc_ , char **argv_  )
   try {
     bool is_display = false;
     std::string input_filename;
+    std::string input_archive_filename;
+    std::size_t first_event = 0;
+    std::size_t last_event = 0;
     std::string trigger_config_filename = "";
     std::string output_path = "";
     // std::size_t max_events = 0;
@@ -60,6 +64,15 @@ int main( int  argc_ , char **argv_  )
       ("input,i",
        po::value<std::string>(& input_filename),
        "set an input file")
+      ("signal-archive,a",
+       po::value<std::string>(& input_archive_filename),
+       "set an input indexed signal archive (used instead of the input file)")
+      ("first-event",
+       po::value<std::size_t>(& first_event)->default_value(0),
+       "set the first event to process in the signal archive")
+      ("last-event",
+       po::value<std::size_t>(& last_event)->default_value(0),
+       "set the event after the last one to process in the signal archive (0 : up to the end)")
       ("output-path,o",
        po::value<std::string>(& output_path),
        "set the output path where produced files are created")
@@ -92,7 +105,7 @@ int main( int  argc_ , char **argv_  )
 
     DT_LOG_INFORMATION(logging, "Trigger program with an input of signal data only !");
 
-    if (input_filename.empty()) {
+    if (input_filename.empty() && input_archive_filename.empty()) {
       DT_LOG_WARNING(logging, "No input file(s) !");
       input_filename = "${FALAISE_DIGITIZATION_TESTING_DIR}/data/calo_tracker_self_trigger_default.data.bz2";
       datatools::fetch_path_with_env(input_filename);
@@ -104,8 +117,6 @@ int main( int  argc_ , char **argv_  )
     datatools::fetch_path_with_env(output_path);
 
     int32_t seed = 314158;
-    mygsl::rng random_generator;
-    random_generator.initialize(seed);
 
     std::string manager_config_file;
     manager_config_file = "@falaise:config/snemo/demonstrator/geometry/4.0/manager.conf";
@@ -121,8 +132,23 @@ int main( int  argc_ , char **argv_  )
       }
     my_manager.initialize(manager_config);
 
-    DT_LOG_INFORMATION(logging, "Deserialization input file :" + input_filename);
-    datatools::data_reader deserializer(input_filename, datatools::using_multiple_archives);
+    datatools::data_reader deserializer;
+    snemo::digitization::signal_archive_reader archive_reader;
+    if (!input_archive_filename.empty()) {
+      datatools::fetch_path_with_env(input_archive_filename);
+      DT_LOG_INFORMATION(logging, "Signal archive input file :" + input_archive_filename);
+      archive_reader.open(input_archive_filename);
+      // Range of events, disjoint ranges can be processed by parallel jobs :
+      if (last_event == 0 || last_event > archive_reader.get_number_of_events()) last_event = archive_reader.get_number_of_events();
+      DT_THROW_IF(first_event > last_event, std::range_error, "Invalid range of events [" << first_event << ";" << last_event << "[ ! ");
+      DT_LOG_INFORMATION(logging, "Events range : [" + std::to_string(first_event) + ";" + std::to_string(last_event) + "[");
+    }
+    else {
+      DT_LOG_INFORMATION(logging, "Deserialization input file :" + input_filename);
+      deserializer.init(input_filename, datatools::using_multiple_archives);
+    }
+    std::size_t archive_event_index = first_event;
+    snemo::digitization::signal_columns signal_columns;
 
     std::string output_stat_filename = output_path + '/' + "output_trigger.stat";
     DT_LOG_INFORMATION(logging, "Trigger statistics output file :" + output_stat_filename);
@@ -173,16 +199,10 @@ int main( int  argc_ , char **argv_  )
     snemo::digitization::signal_to_geiger_tp_algo signal_2_geiger_tp;
     signal_2_geiger_tp.initialize(my_e_mapping);
 
-    // Initializing calo_tp to calo_ctw algorithms for each crate :
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_0;
-    calo_tp_2_ctw_0.set_crate_number(snemo::digitization::mapping::MAIN_CALO_SIDE_0_CRATE);
-    calo_tp_2_ctw_0.initialize();
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_1;
-    calo_tp_2_ctw_1.set_crate_number(snemo::digitization::mapping::MAIN_CALO_SIDE_1_CRATE);
-    calo_tp_2_ctw_1.initialize();
-    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw_2;
-    calo_tp_2_ctw_2.set_crate_number(snemo::digitization::mapping::XWALL_GVETO_CALO_CRATE);
-    calo_tp_2_ctw_2.initialize();
+    // Initializing calo_tp to calo_ctw algorithm for all crates :
+    snemo::digitization::calo_tp_to_ctw_algo calo_tp_2_ctw;
+    calo_tp_2_ctw.set_all_crates();
+    calo_tp_2_ctw.initialize();
 
     // Initializing geiger_tp to geiger_ctw :
     snemo::digitization::geiger_tp_to_ctw_algo geiger_tp_2_ctw;
@@ -206,49 +226,61 @@ int main( int  argc_ , char **argv_  )
 
     std::size_t number_of_events_deserialized = 0;
 
-    while (deserializer.has_record_tag()) {
+    while (archive_reader.is_open() ? archive_event_index < last_event : deserializer.has_record_tag()) {
       //DT_LOG_DEBUG(logging, "Entering has record tag...");
       if (number_of_events_deserialized % 10000 == 0) {
 	DT_LOG_INFORMATION(logging, "Trigger event : " + std::to_string(number_of_events_deserialized));
 	detstream << "Trigger event : " << number_of_events_deserialized << std::endl;
       }
 
-      my_clock_manager.compute_clockticks_ref(random_generator);
+      // Per event clock phase (the event ID is its index in the input), independent of the other events :
+      const std::size_t event_id = archive_reader.is_open() ? archive_event_index : number_of_events_deserialized;
+      my_clock_manager.compute_clockticks_ref(seed, 0, event_id);
       int32_t clocktick_25_reference  = my_clock_manager.get_clocktick_25_ref();
       double  clocktick_25_shift      = my_clock_manager.get_shift_25();
       int32_t clocktick_800_reference = my_clock_manager.get_clocktick_800_ref();
       double  clocktick_800_shift     = my_clock_manager.get_shift_800();
 
       snemo::digitization::signal_data signal_data;
+      bool has_event = false;
 
-      if (deserializer.record_tag_is(snemo::digitization::signal_data::SERIAL_TAG)) {
+      if (archive_reader.is_open()) {
+	archive_reader.load(archive_event_index, signal_columns);
+	archive_event_index++;
+	has_event = true;
+      }
+      else if (deserializer.record_tag_is(snemo::digitization::signal_data::SERIAL_TAG)) {
 	deserializer.load(signal_data);
+	has_event = true;
+      }
+
+      if (has_event) {
 
 	// signal_data.tree_dump(std::clog, "*** Signal Data ***", "INFO : ");
 
 	snemo::digitization::calo_tp_data my_calo_tp_data;
 	snemo::digitization::calo_ctw_data my_calo_ctw_data;
-	if (signal_data.has_calo_signals())
+	if (signal_data.has_calo_signals() || signal_columns.has_calo_signals())
 	  {
 	    signal_2_calo_tp.set_clocktick_reference(clocktick_25_reference);
 	    signal_2_calo_tp.set_clocktick_shift(clocktick_25_shift);
 
-	    signal_2_calo_tp.process(signal_data, my_calo_tp_data);
+	    if (archive_reader.is_open()) signal_2_calo_tp.process(signal_columns, my_calo_tp_data);
+	    else signal_2_calo_tp.process(signal_data, my_calo_tp_data);
 
-	    calo_tp_2_ctw_0.process(my_calo_tp_data, my_calo_ctw_data);
-	    calo_tp_2_ctw_1.process(my_calo_tp_data, my_calo_ctw_data);
-	    calo_tp_2_ctw_2.process(my_calo_tp_data, my_calo_ctw_data);
+	    calo_tp_2_ctw.process(my_calo_tp_data, my_calo_ctw_data);
 
 	  } // end of if has calo signal
 
 	snemo::digitization::geiger_tp_data my_geiger_tp_data;
 	snemo::digitization::geiger_ctw_data my_geiger_ctw_data;
-	if (signal_data.has_geiger_signals())
+	if (signal_data.has_geiger_signals() || signal_columns.has_geiger_signals())
 	  {
 	    signal_2_geiger_tp.set_clocktick_reference(clocktick_800_reference);
 	    signal_2_geiger_tp.set_clocktick_shift(clocktick_800_shift);
 
-	    signal_2_geiger_tp.process(signal_data, my_geiger_tp_data);
+	    if (archive_reader.is_open()) signal_2_geiger_tp.process(signal_columns, my_geiger_tp_data);
+	    else signal_2_geiger_tp.process(signal_data, my_geiger_tp_data);
 
 	    geiger_tp_2_ctw.process(my_geiger_tp_data, my_geiger_ctw_data);
 	  } // end of if has geiger signal
@@ -393,6 +425,7 @@ int main( int  argc_ , char **argv_  )
     detstream.close();
 
     deserializer.reset();
+    if (archive_reader.is_open()) archive_reader.close();
     std::clog << "The end." << std::endl;
   }
 
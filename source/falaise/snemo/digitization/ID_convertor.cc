@@ -116,6 +116,76 @@ namespace snemo {
       return;
     }
 
+    void ID_convertor::convert_geiger_cell_to_channel(unsigned int side_,
+						      unsigned int layer_,
+						      unsigned int row_,
+						      unsigned int & crate_id_,
+						      unsigned int & board_id_,
+						      unsigned int & channel_id_)
+    {
+      unsigned int shift = 0;
+      unsigned int row_shift = 0;
+
+      if (row_ <= mapping::BOARD_ID_SHIFT_CRATE_0_LIMIT)
+	{
+	  crate_id_ = 0;
+	}
+
+      if (row_ > mapping::BOARD_ID_SHIFT_CRATE_0_LIMIT && row_ <= mapping::THREE_WIRES_CRATE_0_LIMIT)
+	{
+	  crate_id_ = 0;
+	  row_shift = mapping::NO_FEB_NUMBER_10_SHIFT;
+	}
+
+      if (row_ > mapping::THREE_WIRES_CRATE_0_LIMIT && row_  <= mapping::THREE_WIRES_LONELY_ROW )
+	{
+	  crate_id_ = 1;
+	  shift = mapping::THREE_WIRES_CRATE_1_BEGINNING;
+	}
+
+      if (row_ > mapping::THREE_WIRES_LONELY_ROW && row_  <= mapping::THREE_WIRES_CRATE_1_LIMIT )
+	{
+	  crate_id_ = 1;
+	  shift = mapping::THREE_WIRES_CRATE_1_BEGINNING;
+	  shift -= 1; // in order to take into account the lonely row at the middle
+	  row_shift = mapping::NO_FEB_NUMBER_10_SHIFT;
+	}
+
+      if (row_ > mapping::THREE_WIRES_CRATE_1_LIMIT && row_ <= mapping::BOARD_ID_SHIFT_CRATE_2_LIMIT)
+	{
+	  crate_id_ = 2;
+	  shift = mapping::THREE_WIRES_CRATE_2_BEGINNING;
+	}
+
+      if (row_ > mapping::BOARD_ID_SHIFT_CRATE_2_LIMIT)
+	{
+	  crate_id_ = 2;
+	  shift = mapping::THREE_WIRES_CRATE_2_BEGINNING;
+	  row_shift = mapping::NO_FEB_NUMBER_10_SHIFT;
+	}
+
+      board_id_ = (row_ + row_shift -shift) / 2;
+
+      if (row_ < mapping::THREE_WIRES_LONELY_ROW)
+	{
+	  shift = 2 * side_ + (row_ % 2);
+	  channel_id_ = mapping::GEIGER_LAYERS_SIZE * shift + layer_;
+	}
+
+      else if (row_ == mapping::THREE_WIRES_LONELY_ROW)
+	{
+	  shift = 2 * side_;
+	  channel_id_ = mapping::GEIGER_LAYERS_SIZE * shift + layer_;
+	}
+
+      else if (row_ > mapping::THREE_WIRES_LONELY_ROW)
+	{
+	  shift = 2 * side_ + (1 - (row_ % 2));
+	  channel_id_ = mapping::GEIGER_LAYERS_SIZE * shift + layer_;
+	}
+      return;
+    }
+
     geomtools::geom_id ID_convertor::convert_GID_to_EID(const geomtools::geom_id & geom_id_) const
     {
       DT_THROW_IF(!geom_id_.is_valid (), std::logic_error,
@@ -137,66 +207,7 @@ namespace snemo {
 	  unsigned int side_index = _gg_locator_->extract_side(geom_id_);
 	  unsigned int layer_index = _gg_locator_->extract_layer(geom_id_);
 	  unsigned int row_index = _gg_locator_->extract_row(geom_id_);
-	  unsigned int shift = 0;
-	  unsigned int row_shift = 0;
-	
-	  if (row_index <= mapping::BOARD_ID_SHIFT_CRATE_0_LIMIT)
-	    {
-	      crate_id = 0;
-	    }
-	
-	  if (row_index > mapping::BOARD_ID_SHIFT_CRATE_0_LIMIT && row_index <= mapping::THREE_WIRES_CRATE_0_LIMIT)
-	    {
-	      crate_id = 0;
-	      row_shift = mapping::NO_FEB_NUMBER_10_SHIFT;
-	    }
-
-	  if (row_index > mapping::THREE_WIRES_CRATE_0_LIMIT && row_index  <= mapping::THREE_WIRES_LONELY_ROW )
-	    {
-	      crate_id = 1; 
-	      shift = mapping::THREE_WIRES_CRATE_1_BEGINNING;
-	    }
-
-	  if (row_index > mapping::THREE_WIRES_LONELY_ROW && row_index  <= mapping::THREE_WIRES_CRATE_1_LIMIT )
-	    {
-	      crate_id = 1; 
-	      shift = mapping::THREE_WIRES_CRATE_1_BEGINNING;
-	      shift -= 1; // in order to take into account the lonely row at the middle
-	      row_shift = mapping::NO_FEB_NUMBER_10_SHIFT;
-	    }
-
-	  if (row_index > mapping::THREE_WIRES_CRATE_1_LIMIT && row_index <= mapping::BOARD_ID_SHIFT_CRATE_2_LIMIT)
-	    {
-	      crate_id = 2;
-	      shift = mapping::THREE_WIRES_CRATE_2_BEGINNING;	  
-	    }
-
-	  if (row_index > mapping::BOARD_ID_SHIFT_CRATE_2_LIMIT)
-	    {
-	      crate_id = 2;
-	      shift = mapping::THREE_WIRES_CRATE_2_BEGINNING;
-	      row_shift = mapping::NO_FEB_NUMBER_10_SHIFT;
-	    }
-
-	  board_id = (row_index + row_shift -shift) / 2;
-
-	  if (row_index < mapping::THREE_WIRES_LONELY_ROW)
-	    {
-	      shift = 2 * side_index + (row_index % 2);
-	      channel_id = mapping::GEIGER_LAYERS_SIZE * shift + layer_index;
-	    }
-
-	  else if (row_index == mapping::THREE_WIRES_LONELY_ROW)
-	    {
-	      shift = 2 * side_index;
-	      channel_id = mapping::GEIGER_LAYERS_SIZE * shift + layer_index;
-	    }
-
-	  else if (row_index > mapping::THREE_WIRES_LONELY_ROW)
-	    {
-	      shift = 2 * side_index + (1 - (row_index % 2));
-	      channel_id = mapping::GEIGER_LAYERS_SIZE * shift + layer_index;
-	    }
+	  convert_geiger_cell_to_channel(side_index, layer_index, row_index, crate_id, board_id, channel_id);
 	} // End of Geiger Category type
 
       if( geom_id_.get_type() == mapping::CALO_MAIN_WALL_CATEGORY_TYPE )
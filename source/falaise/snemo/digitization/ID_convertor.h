@@ -65,6 +65,13 @@ namespace snemo {
       void set_logging(datatools::logger::priority);
       datatools::logger::priority get_logging() const;
       geomtools::geom_id convert_GID_to_EID(const geomtools::geom_id & geom_id_) const;
+      /// Compute the crate, board and channel of a drift cell in the three wires tracker mode
+      static void convert_geiger_cell_to_channel(unsigned int side_,
+						 unsigned int layer_,
+						 unsigned int row_,
+						 unsigned int & crate_id_,
+						 unsigned int & board_id_,
+						 unsigned int & channel_id_);
       void set_geo_manager(const geomtools::manager & mgr_);
       void set_module_number(int);
       /*
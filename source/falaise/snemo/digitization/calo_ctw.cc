@@ -24,6 +24,7 @@ namespace snemo {
       _layout_ = calo::ctw::LAYOUT_UNDEFINED;
       _clocktick_25ns_ = clock_utils::INVALID_CLOCKTICK;
       _ctw_ = 0x0;
+      _trigger_contribution_valid_ = false;
       return;
     }
 
@@ -54,6 +55,7 @@ namespace snemo {
 	{
 	  _layout_ = calo::ctw::LAYOUT_UNDEFINED;
 	}
+      _update_trigger_contribution_();
       return;
     }
 
@@ -119,6 +121,7 @@ namespace snemo {
 	  break;
 	}
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -172,6 +175,7 @@ namespace snemo {
 	  break;
 	}
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -226,6 +230,7 @@ namespace snemo {
 	  break;
 	}
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -279,6 +284,7 @@ namespace snemo {
 	  break;
 	}
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -333,6 +339,7 @@ namespace snemo {
 	    }
 	}
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -365,6 +372,7 @@ namespace snemo {
 	    }
 	}
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -375,6 +383,7 @@ namespace snemo {
 
       _ctw_.set(bit_pos_,value_);
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -398,6 +407,7 @@ namespace snemo {
       DT_THROW_IF(_layout_ == calo::ctw::LAYOUT_UNDEFINED || _layout_ == calo::ctw::LAYOUT_XWALL_GVETO, std::logic_error, "Layout value [" << _layout_ << "] is not valid ! ");
       _ctw_.set(calo::ctw::LTO_MAIN_WALL_BIT, value_);
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -413,6 +423,7 @@ namespace snemo {
       DT_THROW_IF(_layout_ == calo::ctw::LAYOUT_UNDEFINED || _layout_ == calo::ctw::LAYOUT_MAIN_WALL, std::logic_error, "Layout value [" << _layout_ << "] is not valid ! ");
       _ctw_.set(calo::ctw::LTO_XWALL_SIDE0_BIT, value_);
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -427,6 +438,7 @@ namespace snemo {
       DT_THROW_IF(_layout_ == calo::ctw::LAYOUT_UNDEFINED || _layout_ == calo::ctw::LAYOUT_MAIN_WALL, std::logic_error, "Layout value [" << _layout_ << "] is not valid ! ");
       _ctw_.set(calo::ctw::LTO_XWALL_SIDE1_BIT, value_);
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -441,6 +453,7 @@ namespace snemo {
       DT_THROW_IF(_layout_ == calo::ctw::LAYOUT_UNDEFINED || _layout_ == calo::ctw::LAYOUT_MAIN_WALL, std::logic_error, "Layout value [" << _layout_ << "] is not valid ! ");
       _ctw_.set(calo::ctw::LTO_GVETO_BIT, value_);
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -453,6 +466,7 @@ namespace snemo {
     {
       _ctw_.set(calo::ctw::XT_PC_BIT,value_);
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -488,6 +502,7 @@ namespace snemo {
 	    }
 	}
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -519,6 +534,7 @@ namespace snemo {
 	    }
 	}
       _store |= STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -526,6 +542,7 @@ namespace snemo {
     {
       _ctw_ = 0x0;
       _store &= ~STORE_CTW;
+      _update_trigger_contribution_();
       return;
     }
 
@@ -541,6 +558,65 @@ namespace snemo {
       reset_clocktick_25ns();
       _layout_ = calo::ctw::LAYOUT_UNDEFINED;
       geomtools::base_hit::reset();
+      _update_trigger_contribution_();
+      return;
+    }
+
+    void calo_ctw::set_geom_id(const geomtools::geom_id & geom_id_)
+    {
+      geomtools::base_hit::set_geom_id(geom_id_);
+      _update_trigger_contribution_();
+      return;
+    }
+
+    geomtools::geom_id & calo_ctw::grab_geom_id()
+    {
+      _trigger_contribution_valid_ = false;
+      return geomtools::base_hit::grab_geom_id();
+    }
+
+    void calo_ctw::_update_trigger_contribution_()
+    {
+      _trigger_contribution_valid_ = false;
+      if (_layout_ == calo::ctw::LAYOUT_UNDEFINED) return;
+      if (get_geom_id().get(mapping::CRATE_INDEX) > mapping::XWALL_GVETO_CALO_CRATE) return;
+      _decode_trigger_contribution_(_trigger_contribution_);
+      _trigger_contribution_valid_ = true;
+      return;
+    }
+
+    void calo_ctw::_decode_trigger_contribution_(trigger_contribution & a_contribution) const
+    {
+      const uint32_t crate_index = get_geom_id().get(mapping::CRATE_INDEX);
+      DT_THROW_IF(crate_index > mapping::XWALL_GVETO_CALO_CRATE, std::logic_error, "Crate index '"<< crate_index << "' is not defined, check your value ! ");
+      const unsigned long word = _ctw_.to_ulong();
+      a_contribution.multiplicity[0] = 0;
+      a_contribution.multiplicity[1] = 0;
+      a_contribution.gveto_multiplicity = 0;
+      a_contribution.zoning_word[0] = 0;
+      a_contribution.zoning_word[1] = 0;
+      a_contribution.flags = 0;
+      if (is_main_wall())
+	{
+	  a_contribution.multiplicity[crate_index] = (word >> calo::ctw::HTM_MAIN_WALL_BIT0) & 0x3;
+	  a_contribution.zoning_word[crate_index] = (word >> calo::ctw::W_ZW_BIT0) & ((1 << calo::ctw::MAIN_ZONING_BITSET_SIZE) - 1);
+	  if ((word >> calo::ctw::LTO_MAIN_WALL_BIT) & 0x1) a_contribution.flags |= (crate_index == mapping::MAIN_CALO_SIDE_0_CRATE ? trigger_contribution::FLAG_LTO_SIDE_0 : trigger_contribution::FLAG_LTO_SIDE_1);
+	}
+      else
+	{
+	  // Xwall zoning word : bits 0 and 1 are the first and last zones of side 0, bits 2 and 3 the ones of side 1
+	  a_contribution.multiplicity[0] = (word >> calo::ctw::HTM_XWALL_SIDE0_BIT0) & 0x3;
+	  a_contribution.multiplicity[1] = (word >> calo::ctw::HTM_XWALL_SIDE1_BIT0) & 0x3;
+	  a_contribution.gveto_multiplicity = (word >> calo::ctw::HTM_GVETO_BIT0) & 0x3;
+	  const unsigned long xwall_zoning_word = (word >> calo::ctw::X_ZW_BIT0) & ((1 << calo::ctw::XWALL_ZONING_BITSET_SIZE) - 1);
+	  const unsigned int last_zone = calo::ctw::MAIN_ZONING_BITSET_SIZE - 1;
+	  a_contribution.zoning_word[0] = (xwall_zoning_word & 0x1) | (((xwall_zoning_word >> 1) & 0x1) << last_zone);
+	  a_contribution.zoning_word[1] = ((xwall_zoning_word >> 2) & 0x1) | (((xwall_zoning_word >> 3) & 0x1) << last_zone);
+	  a_contribution.flags |= trigger_contribution::FLAG_GVETO;
+	  if ((word >> calo::ctw::LTO_XWALL_SIDE0_BIT) & 0x1) a_contribution.flags |= trigger_contribution::FLAG_LTO_SIDE_0;
+	  if ((word >> calo::ctw::LTO_XWALL_SIDE1_BIT) & 0x1) a_contribution.flags |= trigger_contribution::FLAG_LTO_SIDE_1;
+	  if ((word >> calo::ctw::LTO_GVETO_BIT) & 0x1) a_contribution.flags |= trigger_contribution::FLAG_LTO_GVETO;
+	}
       return;
     }
 
@@ -46,6 +46,27 @@ namespace snemo {
 				TW_CONTROL   = datatools::bit_mask::bit14 | datatools::bit_mask::bit15 | datatools::bit_mask::bit16 | datatools::bit_mask::bit17 //!< Control bits (4 bits)
 			};
  
+			/// \brief Contribution of the CTW to the calorimeter trigger record of its clocktick
+			///
+			/// Plain data decoded from the trigger word by the modifiers of the CTW : the
+			/// calorimeter trigger merges the contributions of a clocktick with integer
+			/// additions and ORs.
+			struct trigger_contribution
+			{
+				/// Flags of a contribution
+				enum flag_type {
+					FLAG_LTO_SIDE_0 = datatools::bit_mask::bit00, //!< LTO of side 0 (main wall or xwall)
+					FLAG_LTO_SIDE_1 = datatools::bit_mask::bit01, //!< LTO of side 1 (main wall or xwall)
+					FLAG_LTO_GVETO  = datatools::bit_mask::bit02, //!< LTO of the gamma veto
+					FLAG_GVETO      = datatools::bit_mask::bit03  //!< Gamma veto multiplicity of the clocktick is replaced (xwall and gamma veto crate)
+				};
+
+				uint8_t multiplicity[mapping::NUMBER_OF_SIDES]; //!< HTM added to the total multiplicity of each side
+				uint8_t gveto_multiplicity;                     //!< HTM of the gamma veto
+				uint16_t zoning_word[mapping::NUMBER_OF_SIDES]; //!< Calorimeter trigger zones of each side (bit i : zone i)
+				uint8_t flags;                                  //!< Flags
+			};
+
       /// Default constructor
       calo_ctw();
 
@@ -57,6 +78,12 @@ namespace snemo {
 											const geomtools::geom_id & electronic_id_,	 
 											uint32_t clocktick_25ns_);
 
+			/// Set the electronic ID and decode the trigger contribution again
+			void set_geom_id(const geomtools::geom_id & geom_id_);
+
+			/// Return a mutable electronic ID (the trigger contribution is decoded at each access until the next modification of the CTW)
+			geomtools::geom_id & grab_geom_id();
+
 			/// Check if the ctw is main wall
 			bool is_main_wall() const;
 			
@@ -171,6 +198,20 @@ namespace snemo {
 			/// Reset the calorimeter crate TW bitset
 			void reset_tw_bitset();
 
+			/// Return the contribution of the CTW to the calorimeter trigger
+			///
+			/// The contribution is decoded by the modifiers of the CTW : a const access
+			/// never writes the CTW, so concurrent readers are safe. A CTW modified
+			/// through grab_geom_id() is decoded at each access until its next
+			/// modification.
+			trigger_contribution get_trigger_contribution() const
+			{
+				if (_trigger_contribution_valid_) return _trigger_contribution_;
+				trigger_contribution a_contribution;
+				_decode_trigger_contribution_(a_contribution);
+				return a_contribution;
+			}
+
       /// Return the internal state of validity of the calo crate TW is valid
       bool is_valid() const;
 
@@ -189,6 +230,15 @@ namespace snemo {
 			uint32_t _clocktick_25ns_; //!< The timestamp of the trigger primitive in main clock units (40 MHz)
 			std::bitset<calo::ctw::FULL_BITSET_SIZE> _ctw_;    //!< The crate trigger word
 
+			/// Decode the contribution of the CTW to the calorimeter trigger
+			void _decode_trigger_contribution_(trigger_contribution & contribution_) const;
+
+			/// Decode the trigger contribution again if the CTW has a valid layout
+			void _update_trigger_contribution_();
+
+			trigger_contribution _trigger_contribution_; //!< Decoded contribution to the calorimeter trigger (not stored)
+			bool _trigger_contribution_valid_;           //!< Validity of the decoded contribution
+
       DATATOOLS_SERIALIZATION_DECLARATION()
 
     };
@@ -197,6 +247,10 @@ namespace snemo {
 
 } // end of namespace snemo
 
+#include <boost/serialization/version.hpp>
+// Version 1 : trigger word bitset stored as packed 64 bits words
+BOOST_CLASS_VERSION(snemo::digitization::calo_ctw, 1)
+
 #endif /* FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_CALO_CTW_H */
 
 /* 
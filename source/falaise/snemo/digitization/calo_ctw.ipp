@@ -13,6 +13,8 @@
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/bitset.hpp>
+// - This project:
+#include <snemo/digitization/packed_bitset.h>
 // - Bayeux/geomtools
 #include <geomtools/base_hit.ipp>
 	 
@@ -22,7 +24,7 @@ namespace snemo {
 
     template<class Archive>
     void calo_ctw::serialize (Archive            & ar,
-															const unsigned int /* version_ */)
+															const unsigned int version_)
     {
       // inherit from the 'base_hit' mother class:
       ar & boost::serialization::make_nvp ("geomtools__base_hit",
@@ -35,8 +37,18 @@ namespace snemo {
 		
       if (_store & STORE_CTW)
 				{
-					ar & boost::serialization::make_nvp ("TP", _ctw_);
+					if (version_ < 1)
+					  {
+					    // Old archives : bitset stored as a string of 0/1
+					    ar & boost::serialization::make_nvp ("TP", _ctw_);
+					  }
+					else
+					  {
+					    packed_bitset<calo::ctw::FULL_BITSET_SIZE>::serialize(ar, "TP_mask", "TP_words", _ctw_);
+					  }
 				}
+      // The trigger contribution is decoded again after a load :
+      _update_trigger_contribution_();
 
       return;
     }
@@ -101,18 +101,14 @@ namespace snemo {
     void calo_ctw_data::reset_ctws()
     {
       _calo_ctws_.clear();
+      _calo_ctws_pool_.recycle();
       return ;
     }
 
     calo_ctw & calo_ctw_data::add()
     {
-      {
-				calo_ctw_handle_type dummy;
-				_calo_ctws_.push_back(dummy);
-      }
-      calo_ctw_handle_type & last = _calo_ctws_.back();
-      last.reset(new calo_ctw);
-      return last.grab();
+      _calo_ctws_.push_back(_calo_ctws_pool_.acquire());
+      return _calo_ctws_.back().grab();
     }
 
     const calo_ctw_data::calo_ctw_collection_type & calo_ctw_data::get_calo_ctws() const
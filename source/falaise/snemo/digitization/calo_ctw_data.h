@@ -17,6 +17,7 @@
 
 // This project :
 #include <snemo/digitization/calo_ctw.h>
+#include <snemo/digitization/handle_pool.h>
 #include <snemo/digitization/calo_ctw_constants.h>
 
 namespace snemo {
@@ -85,6 +86,7 @@ namespace snemo {
 			
     private : 
       calo_ctw_collection_type _calo_ctws_; //!< Collection of calorimeters crate trigger
+      handle_pool<calo_ctw> _calo_ctws_pool_; //!< Pool of recycled crate trigger words (not serialized)
 
       DATATOOLS_SERIALIZATION_DECLARATION()
 
@@ -160,6 +160,10 @@ namespace snemo {
 
 } // end of namespace snemo
 
+#include <boost/serialization/version.hpp>
+// Version 1 : trigger word bitset stored as packed 64 bits words
+BOOST_CLASS_VERSION(snemo::digitization::calo_tp, 1)
+
 #endif /* FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_CALO_TP_H */
 
 /* 
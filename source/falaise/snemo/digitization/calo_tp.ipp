@@ -13,6 +13,8 @@
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/bitset.hpp>
+// - This project:
+#include <snemo/digitization/packed_bitset.h>
 // - Bayeux/geomtools
 #include <geomtools/base_hit.ipp>
 
@@ -22,7 +24,7 @@ namespace snemo {
 
 		template<class Archive>
 		void calo_tp::serialize (Archive & ar,
-														 const unsigned int /* version_ */)
+														 const unsigned int version_)
 		{
 			// inherit from the 'base_hit' mother class:
 			ar & boost::serialization::make_nvp ("geomtools__base_hit",
@@ -39,7 +41,15 @@ namespace snemo {
 
 			if (_store & STORE_TP)
 				{
-					ar & boost::serialization::make_nvp ("TP", _tp_);
+					if (version_ < 1)
+					  {
+					    // Old archives : bitset stored as a string of 0/1
+					    ar & boost::serialization::make_nvp ("TP", _tp_);
+					  }
+					else
+					  {
+					    packed_bitset<FULL_SIZE>::serialize(ar, "TP_mask", "TP_words", _tp_);
+					  }
 				}
 
 			return;
@@ -131,18 +131,14 @@ namespace snemo {
     void calo_tp_data::reset_tps()
     {
       _calo_tps_.clear();
+      _calo_tps_pool_.recycle();
       return ;
     }
 		
     calo_tp & calo_tp_data::add()
     {
-      {
-				calo_tp_handle_type dummy;
-				_calo_tps_.push_back(dummy);
-      }
-      calo_tp_handle_type & last = _calo_tps_.back();
-      last.reset(new calo_tp);
-      return last.grab();
+      _calo_tps_.push_back(_calo_tps_pool_.acquire());
+      return _calo_tps_.back().grab();
     }
 
     const calo_tp_data::calo_tp_collection_type & calo_tp_data::get_calo_tps() const
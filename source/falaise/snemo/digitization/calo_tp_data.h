@@ -17,6 +17,7 @@
 
 // This project :
 #include <snemo/digitization/calo_tp.h>
+#include <snemo/digitization/handle_pool.h>
 
 namespace snemo {
   
@@ -88,6 +89,7 @@ namespace snemo {
     private : 
 
 			calo_tp_collection_type _calo_tps_; //!< Collection of calorimeters tracker primitive
+			handle_pool<calo_tp> _calo_tps_pool_; //!< Pool of recycled trigger primitives (not serialized)
 
       DATATOOLS_SERIALIZATION_DECLARATION()
 
@@ -2,13 +2,79 @@
 // Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
 // Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
 
+// Standard library :
+#include <algorithm>
+
 // Ourselves:
 #include <snemo/digitization/calo_tp_to_ctw_algo.h>
+#include <snemo/digitization/instrumentation.h>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/exception.h>
 
+namespace {
+
+  typedef snemo::digitization::calo_tp_to_ctw_algo algo_type;
+
+  /// Number of board IDs in a crate (20 FEBs and the control board)
+  const unsigned int NUMBER_OF_BOARD_IDS = 21;
+
+  /// Board routing for a main wall crate (side is given by the crate number)
+  /// Boards [0;9] feed zones [0;4], boards [11;20] feed zones [5;9] (the control board is board 10)
+  constexpr algo_type::board_routing MAIN_WALL_BOARD_ROUTING[NUMBER_OF_BOARD_IDS] = {
+    {algo_type::ROUTING_MAIN_WALL, 0, 0}, {algo_type::ROUTING_MAIN_WALL, 0, 0},
+    {algo_type::ROUTING_MAIN_WALL, 0, 1}, {algo_type::ROUTING_MAIN_WALL, 0, 1},
+    {algo_type::ROUTING_MAIN_WALL, 0, 2}, {algo_type::ROUTING_MAIN_WALL, 0, 2},
+    {algo_type::ROUTING_MAIN_WALL, 0, 3}, {algo_type::ROUTING_MAIN_WALL, 0, 3},
+    {algo_type::ROUTING_MAIN_WALL, 0, 4}, {algo_type::ROUTING_MAIN_WALL, 0, 4},
+    {algo_type::ROUTING_MAIN_WALL, 0, 4},
+    {algo_type::ROUTING_MAIN_WALL, 0, 5}, {algo_type::ROUTING_MAIN_WALL, 0, 5},
+    {algo_type::ROUTING_MAIN_WALL, 0, 6}, {algo_type::ROUTING_MAIN_WALL, 0, 6},
+    {algo_type::ROUTING_MAIN_WALL, 0, 7}, {algo_type::ROUTING_MAIN_WALL, 0, 7},
+    {algo_type::ROUTING_MAIN_WALL, 0, 8}, {algo_type::ROUTING_MAIN_WALL, 0, 8},
+    {algo_type::ROUTING_MAIN_WALL, 0, 9}, {algo_type::ROUTING_MAIN_WALL, 0, 9}
+  };
+
+  /// Board routing for the xwall gveto crate
+  constexpr algo_type::board_routing XWALL_GVETO_BOARD_ROUTING[NUMBER_OF_BOARD_IDS] = {
+    {algo_type::ROUTING_NONE,  0, 0}, // 0
+    {algo_type::ROUTING_NONE,  0, 0}, // 1
+    {algo_type::ROUTING_NONE,  0, 0}, // 2
+    {algo_type::ROUTING_NONE,  0, 0}, // 3
+    {algo_type::ROUTING_GVETO, 0, 0}, // 4
+    {algo_type::ROUTING_GVETO, 0, 0}, // 5
+    {algo_type::ROUTING_XWALL, 0, 0}, // 6
+    {algo_type::ROUTING_XWALL, 0, 0}, // 7
+    {algo_type::ROUTING_XWALL, 0, 1}, // 8
+    {algo_type::ROUTING_XWALL, 0, 1}, // 9
+    {algo_type::ROUTING_NONE,  0, 0}, // 10 (control board)
+    {algo_type::ROUTING_XWALL, 1, 3}, // 11
+    {algo_type::ROUTING_XWALL, 1, 3}, // 12
+    {algo_type::ROUTING_XWALL, 1, 2}, // 13
+    {algo_type::ROUTING_XWALL, 1, 2}, // 14
+    {algo_type::ROUTING_GVETO, 1, 0}, // 15
+    {algo_type::ROUTING_GVETO, 1, 0}, // 16
+    {algo_type::ROUTING_NONE,  0, 0}, // 17
+    {algo_type::ROUTING_NONE,  0, 0}, // 18
+    {algo_type::ROUTING_NONE,  0, 0}, // 19
+    {algo_type::ROUTING_NONE,  0, 0}  // 20
+  };
+
+  constexpr algo_type::board_routing NO_BOARD_ROUTING = {algo_type::ROUTING_NONE, 0, 0};
+
+  /// Routing of the board of a calo TP in the layout of the given CTW
+  const algo_type::board_routing & ctw_board_routing(const snemo::digitization::calo_tp & calo_tp_,
+						     const snemo::digitization::calo_ctw & calo_ctw_)
+  {
+    const unsigned int board_id = calo_tp_.get_geom_id().get(snemo::digitization::mapping::BOARD_INDEX);
+    if (board_id >= NUMBER_OF_BOARD_IDS) return NO_BOARD_ROUTING;
+    if (calo_ctw_.is_main_wall()) return MAIN_WALL_BOARD_ROUTING[board_id];
+    return XWALL_GVETO_BOARD_ROUTING[board_id];
+  }
+
+}
+
 namespace snemo {
   
   namespace digitization {
@@ -38,7 +104,7 @@ namespace snemo {
     void calo_tp_to_ctw_algo::initialize()
     {
       DT_THROW_IF(is_initialized(), std::logic_error, "Calo tp to ctw algo is already initialized ! ");
-      DT_THROW_IF(_crate_number_ == -1, std::logic_error, "Crate number is not defined ! ");
+      DT_THROW_IF(_crate_number_ == -1 && _mode_ != MODE_ALL_CRATES, std::logic_error, "Crate number is not defined ! ");
       if (_crate_number_ == 0 || _crate_number_ == 1) _set_mode(MODE_MAIN_WALL);
       if (_crate_number_ == 2) _set_mode(MODE_XWALL_GVETO);
       _initialized_ = true;
@@ -87,148 +153,90 @@ namespace snemo {
       else return false;
     }
 
-    void calo_tp_to_ctw_algo::set_ctw_htm(const calo_tp & my_calo_tp_, calo_ctw & my_ctw_)
+    void calo_tp_to_ctw_algo::set_all_crates()
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Calo tp to ctw algo is already initialized, all crates mode can't be set ! ");
+      _crate_number_ = -1;
+      _set_mode(MODE_ALL_CRATES);
+      return;
+    }
+
+    bool calo_tp_to_ctw_algo::is_all_crates() const
     {
-      if (my_ctw_.is_main_wall()) // Mode == Main Wall
+      return _mode_ == MODE_ALL_CRATES;
+    }
+
+    calo_tp_to_ctw_algo::board_routing calo_tp_to_ctw_algo::get_board_routing(unsigned int crate_number_, unsigned int board_id_)
+    {
+      if (board_id_ >= NUMBER_OF_BOARD_IDS) return NO_BOARD_ROUTING;
+      if (crate_number_ == mapping::MAIN_CALO_SIDE_0_CRATE || crate_number_ == mapping::MAIN_CALO_SIDE_1_CRATE)
 	{
-	  if (my_ctw_.is_htm_main_wall())
-	    {
-	      unsigned int ctw_multiplicity = my_ctw_.get_htm_main_wall_info();
-	      my_ctw_.set_htm_main_wall(ctw_multiplicity + my_calo_tp_.get_htm());
-	    }
-	  else
-	    {
-	      my_ctw_.set_htm_main_wall(my_calo_tp_.get_htm());
-	    }	  
+	  board_routing routing = MAIN_WALL_BOARD_ROUTING[board_id_];
+	  routing.side = crate_number_;
+	  return routing;
 	}
-      
-      if (!my_ctw_.is_main_wall()) // Mode == XWall Gveto
+      if (crate_number_ == mapping::XWALL_GVETO_CALO_CRATE) return XWALL_GVETO_BOARD_ROUTING[board_id_];
+      return NO_BOARD_ROUTING;
+    }
+
+    void calo_tp_to_ctw_algo::set_ctw_htm(const calo_tp & my_calo_tp_, calo_ctw & my_ctw_)
+    {
+      const board_routing & routing = ctw_board_routing(my_calo_tp_, my_ctw_);
+      switch (routing.wall)
 	{
-	  unsigned int board_id = my_calo_tp_.get_geom_id().get(mapping::BOARD_INDEX);
-	  if (board_id == 4 || board_id == 5 || board_id == 15 || board_id == 16) 
-	    { // Filling gamma veto multiplicity
-	      if (my_ctw_.is_htm_gveto())
-		{
-		  unsigned int ctw_multiplicity = my_ctw_.get_htm_gveto_info();
-		  my_ctw_.set_htm_gveto(ctw_multiplicity + my_calo_tp_.get_htm());
-		}
-	      else
-		{
-		  my_ctw_.set_htm_gveto(my_calo_tp_.get_htm());
-		}
-	    } // end of gamma veto board
-	  
-	  if (board_id == 6 || board_id == 7 || board_id == 8 || board_id == 9)
-	    { // Filling xwall side 0 multiplicity
-	      if (my_ctw_.is_htm_xwall_side_0())
-		{
-		  unsigned int ctw_multiplicity = my_ctw_.get_htm_xwall_side_0_info();
-		  my_ctw_.set_htm_xwall_side_0(ctw_multiplicity + my_calo_tp_.get_htm());
-		}
-	      else
-		{
-		  my_ctw_.set_htm_xwall_side_0(my_calo_tp_.get_htm());
-		}
-	    } // end of wall side 0 board
-	      
-	  if (board_id == 11 || board_id == 12 || board_id == 13 || board_id == 14)
-	    { // Filling xwall side 1 multiplicity
-	      if (my_ctw_.is_htm_xwall_side_1())
-		{
-		  unsigned int ctw_multiplicity = my_ctw_.get_htm_xwall_side_1_info();
-		  my_ctw_.set_htm_xwall_side_1(ctw_multiplicity + my_calo_tp_.get_htm());
-		}
-	      else
-		{
-		  my_ctw_.set_htm_xwall_side_1(my_calo_tp_.get_htm());
-		}
-	    }
+	case ROUTING_MAIN_WALL :
+	  my_ctw_.set_htm_main_wall(my_ctw_.get_htm_main_wall_info() + my_calo_tp_.get_htm());
+	  break;
+	case ROUTING_GVETO :
+	  my_ctw_.set_htm_gveto(my_ctw_.get_htm_gveto_info() + my_calo_tp_.get_htm());
+	  break;
+	case ROUTING_XWALL :
+	  if (routing.side == 0) my_ctw_.set_htm_xwall_side_0(my_ctw_.get_htm_xwall_side_0_info() + my_calo_tp_.get_htm());
+	  else my_ctw_.set_htm_xwall_side_1(my_ctw_.get_htm_xwall_side_1_info() + my_calo_tp_.get_htm());
+	  break;
+	default :
+	  break;
 	}
       return;
     }
     
     void calo_tp_to_ctw_algo::set_ctw_zone_bit_htm(const calo_tp & my_calo_tp_, calo_ctw & my_ctw_)
     {
-      unsigned int activated_zone_id = 0;
-
-      if (my_ctw_.is_main_wall()) // Mode == Main Wall
+      if (!my_calo_tp_.is_htm()) return;
+      const board_routing & routing = ctw_board_routing(my_calo_tp_, my_ctw_);
+      switch (routing.wall)
 	{
-	  if (my_calo_tp_.is_htm())
-	    {
-	      if (my_calo_tp_.get_geom_id().get(mapping::BOARD_INDEX) > 9)
-		{
-		  activated_zone_id = (my_calo_tp_.get_geom_id().get(mapping::BOARD_INDEX) + BOARD_SHIFT_INDEX) / 2;
-		}
-	      else
-		{
-		  activated_zone_id = my_calo_tp_.get_geom_id().get(mapping::BOARD_INDEX) / 2;
-		}
-	      my_ctw_.set_zoning_bit(calo::ctw::W_ZW_BIT0 + activated_zone_id, true);
-	    }
+	case ROUTING_MAIN_WALL :
+	  my_ctw_.set_zoning_bit(calo::ctw::W_ZW_BIT0 + routing.zone, true);
+	  break;
+	case ROUTING_XWALL :
+	  my_ctw_.set_zoning_bit(calo::ctw::ZONING_XWALL_BIT0 + routing.zone, true);
+	  break;
+	default :
+	  break;
 	}
-
-      if (!my_ctw_.is_main_wall()) // Mode == XWall Gveto
-	{
-	  if (my_calo_tp_.is_htm())
-	    {
-	      unsigned int board_id = my_calo_tp_.get_geom_id().get(mapping::BOARD_INDEX);
-	      if (board_id == 4 || board_id == 5 || board_id == 15 || board_id == 16)
-		{
-		}
-	      else
-		{
-		  if (board_id == 6 || board_id == 7)
-		    {
-		      activated_zone_id = 0;
-		    }	 
-		  else if (board_id == 8 || board_id == 9)
-		    {
-		      activated_zone_id = 1;
-		    }
-	  	  
-		  else if (board_id == 11 || board_id == 12)
-		    {
-		      activated_zone_id = 3;
-		    }
-		  
-		  else if (board_id == 13 || board_id == 14)
-		    {
-		      activated_zone_id = 2;
-		    }
-		  my_ctw_.set_zoning_bit(calo::ctw::ZONING_XWALL_BIT0 + activated_zone_id, true);
-		} // end of else
-	    } // end of if is htm
-	} // end of if is main wall
-      
       return ;
     }
     
     void calo_tp_to_ctw_algo::set_ctw_lto(const calo_tp & my_calo_tp_, calo_ctw & my_ctw_)
     {    
-      if (my_ctw_.is_main_wall()) // Mode == Main Wall
+      if (!my_calo_tp_.is_lto()) return;
+      const board_routing & routing = ctw_board_routing(my_calo_tp_, my_ctw_);
+      switch (routing.wall)
 	{
-	  if (my_calo_tp_.is_lto()) my_ctw_.set_lto_main_wall_bit(true);
+	case ROUTING_MAIN_WALL :
+	  my_ctw_.set_lto_main_wall_bit(true);
+	  break;
+	case ROUTING_GVETO :
+	  my_ctw_.set_lto_gveto_bit(true);
+	  break;
+	case ROUTING_XWALL :
+	  if (routing.side == 0) my_ctw_.set_lto_xwall_side_0_bit(true);
+	  else my_ctw_.set_lto_xwall_side_1_bit(true);
+	  break;
+	default :
+	  break;
 	}
-
-      if (!my_ctw_.is_main_wall()) // Mode == XWall Gveto
-	{
-	  unsigned int board_id = my_calo_tp_.get_geom_id().get(mapping::BOARD_INDEX);
-	  if (board_id == 4 || board_id == 5 || board_id == 15 || board_id == 16) 
-	    { // Filling gamma veto multiplicity
-	      if (my_calo_tp_.is_lto()) my_ctw_.set_lto_gveto_bit(true);
-	    }
-		  
-	  if (board_id == 6 || board_id == 7 || board_id == 8 || board_id == 9)
-	    { // Filling xwall side 0 multiplicity
-	      if (my_calo_tp_.is_lto()) my_ctw_.set_lto_xwall_side_0_bit(true);
-	    }
-	  
-	  if (board_id == 11 || board_id == 12 || board_id == 13 || board_id == 14)
-	    { // Filling xwall side 1 multiplicity
-	      if (my_calo_tp_.is_lto()) my_ctw_.set_lto_xwall_side_1_bit(true);
-	    }
-	}
-      
       return;
     }
 
@@ -306,36 +314,50 @@ namespace snemo {
     { 
       DT_THROW_IF(!is_initialized(), std::logic_error, "Calo tp to ctw algo is not initialized, it can't process ! ");
       DT_THROW_IF(_mode_ == MODE_UNDEFINED, std::logic_error, "Mode type is not defined, check your crate number ! ");
+      _process(calo_tp_data_, calo_ctw_data_);
+      return;
+    }
+
+    void calo_tp_to_ctw_algo::_process(const calo_tp_data & calo_tp_data_, calo_ctw_data & calo_ctw_data_)
+    {
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_CALO_TP_TO_CTW);
+      const calo_tp_data::calo_tp_collection_type & calo_tps = calo_tp_data_.get_calo_tps();
+      DT_THROW_IF(calo_tps.size() > 0xFFFFFF, std::range_error, "Too many calo TPs [" << calo_tps.size() << "] ! ");
 
-      for (uint32_t i = calo_tp_data_.get_clocktick_min(); i <= calo_tp_data_.get_clocktick_max(); i++)
+      // Each TP gets a 64 bits sorting key : crate (8 bits) | clocktick (32 bits) | TP index (24 bits).
+      // Sorting the keys gives, crate after crate, one group of TPs per clocktick, which is the
+      // order obtained by processing the crates one by one.
+      std::vector<uint64_t> sorting_keys;
+      sorting_keys.reserve(calo_tps.size());
+      for (std::size_t i = 0; i < calo_tps.size(); i++)
 	{
-	  //std::clog << "Actual CT = " << i << std::endl;
-	  if (_mode_ == MODE_MAIN_WALL)
-	    {
-	      std::vector<datatools::handle<calo_tp> > tp_list_per_clocktick_per_crate;
-	      calo_tp_data_.get_list_of_tp_per_clocktick_per_crate(i, _crate_number_, tp_list_per_clocktick_per_crate);
-	      
-	      if (!tp_list_per_clocktick_per_crate.empty())
-		{
-		  calo_ctw & a_ctw_ = calo_ctw_data_.add();
-		  _process_for_a_ctw_for_a_clocktick_for_main_wall(tp_list_per_clocktick_per_crate, a_ctw_);
-		  // a_ctw_.tree_dump(std::clog, "a_calo_ctw : ", "INFO : ");
-		}
-	    }
-	  
-	  if (_mode_ == MODE_XWALL_GVETO)
+	  const calo_tp & a_calo_tp = calo_tps[i].get();
+	  const uint32_t crate = a_calo_tp.get_geom_id().get(mapping::CRATE_INDEX);
+	  if (crate > mapping::XWALL_GVETO_CALO_CRATE) continue;
+	  if (_mode_ != MODE_ALL_CRATES && (int) crate != _crate_number_) continue;
+	  const uint64_t key = (static_cast<uint64_t>(crate) << 56)
+	    | (static_cast<uint64_t>(a_calo_tp.get_clocktick_25ns()) << 24)
+	    | static_cast<uint64_t>(i & 0xFFFFFF);
+	  sorting_keys.push_back(key);
+	}
+      std::sort(sorting_keys.begin(), sorting_keys.end());
+
+      const uint64_t group_mask = ~static_cast<uint64_t>(0xFFFFFF);
+      calo_ctw * current_ctw = 0;
+      uint64_t current_group = 0;
+      for (std::size_t i = 0; i < sorting_keys.size(); i++)
+	{
+	  const uint64_t group = sorting_keys[i] & group_mask;
+	  if (current_ctw == 0 || group != current_group)
 	    {
-	      std::vector<datatools::handle<calo_tp> > tp_list_per_clocktick_per_crate;
-	      calo_tp_data_.get_list_of_tp_per_clocktick_per_crate(i, _crate_number_, tp_list_per_clocktick_per_crate);
-	      
-	      if (!tp_list_per_clocktick_per_crate.empty())
-		{
-		  calo_ctw & a_ctw_ = calo_ctw_data_.add();
-		  _process_for_a_ctw_for_a_clocktick_for_xwall_gveto(tp_list_per_clocktick_per_crate, a_ctw_);
-		  // a_ctw_.tree_dump(std::clog, "a_calo_ctw : ", "INFO : ");
-		}
+	      current_ctw = & calo_ctw_data_.add();
+	      current_group = group;
 	    }
+	  const calo_tp & a_calo_tp = calo_tps[sorting_keys[i] & 0xFFFFFF].get();
+	  if ((sorting_keys[i] >> 56) == mapping::XWALL_GVETO_CALO_CRATE) _fill_a_xwall_gveto_ctw(a_calo_tp, *current_ctw);
+	  else _fill_a_main_wall_ctw(a_calo_tp, *current_ctw);
 	}
+
       return;
     }
     
@@ -29,7 +29,24 @@ namespace snemo {
 			enum mode_type {
 				MODE_UNDEFINED   = -1,
 				MODE_MAIN_WALL   =  0,
-				MODE_XWALL_GVETO =  1							
+				MODE_XWALL_GVETO =  1,
+				MODE_ALL_CRATES  =  2 //!< Main wall and xwall gveto crates processed in one pass
+			};
+
+			/// Calorimeter wall fed by a front-end board
+			enum routing_wall_type {
+				ROUTING_NONE      = 0,
+				ROUTING_MAIN_WALL = 1,
+				ROUTING_XWALL     = 2,
+				ROUTING_GVETO     = 3
+			};
+
+			/// Routing of a front-end board to a wall, a side and a trigger zone of the crate trigger word
+			struct board_routing
+			{
+				uint8_t wall; //!< Wall fed by the board (see routing_wall_type)
+				uint8_t side; //!< Side of the wall
+				uint8_t zone; //!< Zone bit in the zoning word of the CTW (main wall or xwall zoning word)
 			};
 			
 			/// Shift for board index because there is 10FEB/1CB/10FEB in one crate
@@ -64,6 +81,15 @@ namespace snemo {
 
 			/// Check if ctw is xwall gveto
 			bool is_xwall_gveto() const;
+
+			/// Set the algorithm to build the CTWs of all calorimeter crates in one pass (instead of a crate number)
+			void set_all_crates();
+
+			/// Check if the algorithm builds the CTWs of all calorimeter crates
+			bool is_all_crates() const;
+
+			/// Return the routing of a front-end board for a given calorimeter crate
+			static board_routing get_board_routing(unsigned int crate_number_, unsigned int board_id_);
 		
 			/// Set the ctw high threshold multiplicity for a given clocktick
 			void set_ctw_htm(const calo_tp & my_calo_tp_, calo_ctw & my_ctw_);
@@ -94,6 +120,9 @@ namespace snemo {
 			/// Process for a ctw for a clocktick for xwall gveto wall
 			void _process_for_a_ctw_for_a_clocktick_for_xwall_gveto(const std::vector<datatools::handle<calo_tp> > & my_list_of_calo_tp_,  calo_ctw & a_calo_ctw_);
 
+			/// Single pass process : calo tp are grouped by (crate, clocktick) and one ctw is built per group
+			void _process(const calo_tp_data & tp_data_,  calo_ctw_data & ctw_data_);
+
     private :
       
 			// Management :
@@ -7,6 +7,7 @@
 #include <snemo/digitization/calo_ctw.h>
 #include <snemo/digitization/trigger_info.h>
 #include <snemo/digitization/mapping.h>
+#include <snemo/digitization/instrumentation.h>
 
 namespace snemo {
 
@@ -274,113 +275,30 @@ namespace snemo {
 
     void calo_trigger_algorithm::_build_calo_record_per_clocktick(const calo_ctw & my_calo_ctw_)
     {
-      uint32_t crate_index = my_calo_ctw_.get_geom_id().get(mapping::CRATE_INDEX);
-      DT_THROW_IF(crate_index > mapping::XWALL_GVETO_CALO_CRATE, std::logic_error, "Crate index '"<< crate_index << "' is not defined, check your value ! ");
+      // The CTW is decoded once, its contribution is merged with integer additions and ORs :
+      const calo_ctw::trigger_contribution & a_contribution = my_calo_ctw_.get_trigger_contribution();
       _calo_record_per_clocktick_.clocktick_25ns = my_calo_ctw_.get_clocktick_25ns();
 
-      // Fill structure if crate is number 2
-      if (!my_calo_ctw_.is_main_wall())
+      // Fill total HTM (saturated at 3 once reached, 2 bits wide otherwise) :
+      if (a_contribution.multiplicity[SIDE_0_INDEX] != 0 && _calo_record_per_clocktick_.total_multiplicity_side_0.to_ulong() != 3)
 	{
-	  unsigned int multiplicity_side_0 = my_calo_ctw_.get_htm_xwall_side_0_info();
-	  unsigned int multiplicity_side_1 = my_calo_ctw_.get_htm_xwall_side_1_info();
-
-	  // Fill total HTM :
-	  // -- Fill xwall side 0 multipliciy
-	  if (multiplicity_side_0 != 0)
-	    {
-	      if (_calo_record_per_clocktick_.total_multiplicity_side_0 == 3) {}
-	      else _calo_record_per_clocktick_.total_multiplicity_side_0 = _calo_record_per_clocktick_.total_multiplicity_side_0.to_ulong() + multiplicity_side_0;
-	    }
-
-	  // -- Fill xwall side 1 multiplicity
-	  if (multiplicity_side_1 != 0)
-	    {
-	      if (_calo_record_per_clocktick_.total_multiplicity_side_1 == 3) {}
-	      else _calo_record_per_clocktick_.total_multiplicity_side_1 = _calo_record_per_clocktick_.total_multiplicity_side_1.to_ulong() + multiplicity_side_1;
-	    }
-
-	  // -- Fill gamma veto multiplicity
-	  if (my_calo_ctw_.get_htm_gveto_info() != 0)
-	    {
-	      _calo_record_per_clocktick_.total_multiplicity_gveto = my_calo_ctw_.get_htm_gveto_info();
-	    }
-
-	  else _calo_record_per_clocktick_.total_multiplicity_gveto = 0;
-
-	  // -- Fill xwall zone corresponding of xwall zoning word :
-	  std::bitset<calo::ctw::XWALL_ZONING_BITSET_SIZE> xwall_zoning_bitset;
-	  my_calo_ctw_.get_xwall_zoning_word(xwall_zoning_bitset);
-
-	  for (unsigned int izone = calo::ctw::ZONING_XWALL_BIT0; izone < (calo::ctw::ZONING_XWALL_BIT0 + mapping::NUMBER_OF_XWALL_CALO_TRIGGER_ZONES); izone++)
-	    {
-	      switch (izone)
-		{
-		case calo::ctw::ZONING_XWALL_BIT0 :
-		  if (xwall_zoning_bitset.test(izone - calo::ctw::ZONING_XWALL_BIT0) == true)
-		    {
-		      _calo_record_per_clocktick_.zoning_word[SIDE_0_INDEX].set(ZONE_0_INDEX, true);
-		    }
-		  break;
-		case calo::ctw::ZONING_XWALL_BIT1 :
-		  if (xwall_zoning_bitset.test(izone - calo::ctw::ZONING_XWALL_BIT0) == true)
-		    {
-		      _calo_record_per_clocktick_.zoning_word[SIDE_0_INDEX].set(ZONE_9_INDEX, true);
-		    }
-		  break;
-		case calo::ctw::ZONING_XWALL_BIT2 :
-		  if (xwall_zoning_bitset.test(izone - calo::ctw::ZONING_XWALL_BIT0) == true)
-		    {
-		      _calo_record_per_clocktick_.zoning_word[SIDE_1_INDEX].set(ZONE_0_INDEX, true);
-		    }
-		  break;
-		case calo::ctw::ZONING_XWALL_BIT3 :
-		  if (xwall_zoning_bitset.test(izone - calo::ctw::ZONING_XWALL_BIT0) == true)
-		    {
-		      _calo_record_per_clocktick_.zoning_word[SIDE_1_INDEX].set(ZONE_9_INDEX, true);
-		    }
-		  break;
-		default :
-		  break;
-		}
-	    }
-
-	  // Fill LTO boolean for each side of xwall and gamma veto
-	  if (my_calo_ctw_.is_lto_xwall_side_0()) _calo_record_per_clocktick_.LTO_side_0 = true;
-	  if (my_calo_ctw_.is_lto_xwall_side_1()) _calo_record_per_clocktick_.LTO_side_1 = true;
-	  if (my_calo_ctw_.is_lto_gveto()) _calo_record_per_clocktick_.LTO_gveto = true;
+	  _calo_record_per_clocktick_.total_multiplicity_side_0 = _calo_record_per_clocktick_.total_multiplicity_side_0.to_ulong() + a_contribution.multiplicity[SIDE_0_INDEX];
 	}
-
-      // Fill structure if crate is number 0 or 1
-      else
+      if (a_contribution.multiplicity[SIDE_1_INDEX] != 0 && _calo_record_per_clocktick_.total_multiplicity_side_1.to_ulong() != 3)
 	{
-	  // Fill total HTM :
-	  unsigned int main_multiplicity = my_calo_ctw_.get_htm_main_wall_info();
-
-	  if (crate_index == mapping::MAIN_CALO_SIDE_0_CRATE && main_multiplicity != 0)
-	    {
-	      if (_calo_record_per_clocktick_.total_multiplicity_side_0 == 3) {}
-	      else _calo_record_per_clocktick_.total_multiplicity_side_0 = _calo_record_per_clocktick_.total_multiplicity_side_0.to_ulong() + main_multiplicity;
-	    }
-
-	  if (crate_index == mapping::MAIN_CALO_SIDE_1_CRATE && main_multiplicity != 0)
-	    {
-	      if (_calo_record_per_clocktick_.total_multiplicity_side_1 == 3) {}
-	      else _calo_record_per_clocktick_.total_multiplicity_side_1 = _calo_record_per_clocktick_.total_multiplicity_side_1.to_ulong() + main_multiplicity;
-	    }
+	  _calo_record_per_clocktick_.total_multiplicity_side_1 = _calo_record_per_clocktick_.total_multiplicity_side_1.to_ulong() + a_contribution.multiplicity[SIDE_1_INDEX];
+	}
+      // The gamma veto multiplicity is the one of the last xwall / gamma veto CTW :
+      if (a_contribution.flags & calo_ctw::trigger_contribution::FLAG_GVETO) _calo_record_per_clocktick_.total_multiplicity_gveto = a_contribution.gveto_multiplicity;
 
-	  // Fill zone main wall bitset :
-	  std::bitset<calo::ctw::MAIN_ZONING_BITSET_SIZE> main_zoning_bitset;
-	  my_calo_ctw_.get_main_zoning_word(main_zoning_bitset);
+      // Fill zoning words :
+      _calo_record_per_clocktick_.zoning_word[SIDE_0_INDEX] |= std::bitset<trigger_info::NZONES>(a_contribution.zoning_word[SIDE_0_INDEX]);
+      _calo_record_per_clocktick_.zoning_word[SIDE_1_INDEX] |= std::bitset<trigger_info::NZONES>(a_contribution.zoning_word[SIDE_1_INDEX]);
 
-	  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
-	    {
-	      if (main_zoning_bitset.test(izone) == true) _calo_record_per_clocktick_.zoning_word[crate_index].set(izone,true);
-	    }
-
-	  // Fill LTO boolean for each side
-	  if (crate_index == mapping::MAIN_CALO_SIDE_0_CRATE && my_calo_ctw_.is_lto_main_wall()) _calo_record_per_clocktick_.LTO_side_0 = true;
-	  if (crate_index == mapping::MAIN_CALO_SIDE_1_CRATE && my_calo_ctw_.is_lto_main_wall()) _calo_record_per_clocktick_.LTO_side_1 = true;
-	}
+      // Fill LTO booleans :
+      if (a_contribution.flags & calo_ctw::trigger_contribution::FLAG_LTO_SIDE_0) _calo_record_per_clocktick_.LTO_side_0 = true;
+      if (a_contribution.flags & calo_ctw::trigger_contribution::FLAG_LTO_SIDE_1) _calo_record_per_clocktick_.LTO_side_1 = true;
+      if (a_contribution.flags & calo_ctw::trigger_contribution::FLAG_LTO_GVETO) _calo_record_per_clocktick_.LTO_gveto = true;
 
       return;
     }
@@ -490,40 +408,75 @@ namespace snemo {
       return;
     }
 
-    void calo_trigger_algorithm::_process(const calo_ctw_data & calo_ctw_data_,
-						    std::vector<trigger_structures::calo_summary_record> & calo_records_)
+    void calo_trigger_algorithm::start_stream()
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Calo trigger algorithm is not initialized, it can't start a stream ! ");
+      _start_process();
+      return;
+    }
+
+    void calo_trigger_algorithm::process_clocktick(const uint32_t clocktick_25ns_,
+						   const std::vector<datatools::handle<calo_ctw> > & ctw_list_per_clocktick_,
+						   std::vector<trigger_structures::calo_summary_record> & calo_records_)
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Calo trigger algorithm is not initialized, it can't process ! ");
+      DT_THROW_IF(!_gate_circular_buffer_, std::logic_error, "Calo trigger algorithm stream is not started ! ");
+      FLDIGI_INSTRUMENT_COUNT(COUNTER_CALO_CLOCKTICKS_25NS, 1);
+      FLDIGI_INSTRUMENT_COUNT(COUNTER_CALO_CTWS_DECODED, ctw_list_per_clocktick_.size());
+      _process_clocktick(clocktick_25ns_, ctw_list_per_clocktick_, calo_records_);
+      return;
+    }
+
+    void calo_trigger_algorithm::_start_process()
     {
       _calo_record_per_clocktick_.reset();
       _calo_level_1_finale_decision_.reset();
       _gate_circular_buffer_.reset(new buffer_type(_circular_buffer_depth_));
       _calo_finale_decision_ = false;
+      return;
+    }
+
+    void calo_trigger_algorithm::_process_clocktick(const uint32_t clocktick_25ns_,
+						    const std::vector<datatools::handle<calo_ctw> > & ctw_list_per_clocktick_,
+						    std::vector<trigger_structures::calo_summary_record> & calo_records_)
+    {
+      if (ctw_list_per_clocktick_.size() == 0) _calo_record_per_clocktick_.clocktick_25ns = clocktick_25ns_;
+      else
+	{
+	  for (unsigned int isize = 0; isize < ctw_list_per_clocktick_.size(); isize++)
+	    {
+	      _build_calo_record_per_clocktick(ctw_list_per_clocktick_[isize].get());
+	    } // end of isize
+	}
+      _gate_circular_buffer_->push_back(_calo_record_per_clocktick_);
+
+      // Fill calo summary record for each clocktick (based on previous calo records) :
+      trigger_structures::calo_summary_record my_calo_summary_record;
+      my_calo_summary_record.clocktick_25ns = clocktick_25ns_;
+      _build_calo_record_summary_structure(my_calo_summary_record);
+      _compute_calo_finale_decision(my_calo_summary_record);
+      if (_calo_level_1_finale_decision_.calo_finale_decision) _calo_finale_decision_ = true;
+
+      if(!_calo_level_1_finale_decision_.is_empty()) calo_records_.push_back(_calo_level_1_finale_decision_);
+      _calo_record_per_clocktick_.reset();
+      return;
+    }
+
+    void calo_trigger_algorithm::_process(const calo_ctw_data & calo_ctw_data_,
+						    std::vector<trigger_structures::calo_summary_record> & calo_records_)
+    {
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_CALO_TRIGGER);
+      _start_process();
 
       if (calo_ctw_data_.get_calo_ctws().size() != 0)
 	{
+	  FLDIGI_INSTRUMENT_COUNT(COUNTER_CALO_CLOCKTICKS_25NS, calo_ctw_data_.get_clocktick_max() + _circular_buffer_depth_ - calo_ctw_data_.get_clocktick_min());
+	  FLDIGI_INSTRUMENT_COUNT(COUNTER_CALO_CTWS_DECODED, calo_ctw_data_.get_calo_ctws().size());
 	  for (uint32_t iclocktick = calo_ctw_data_.get_clocktick_min(); iclocktick <= calo_ctw_data_.get_clocktick_max() + _circular_buffer_depth_ - 1 ; iclocktick++)
 	    {
 	      std::vector<datatools::handle<calo_ctw> > ctw_list_per_clocktick;
 	      calo_ctw_data_.get_list_of_calo_ctw_per_clocktick(iclocktick, ctw_list_per_clocktick);
-
-	      if (ctw_list_per_clocktick.size() == 0) _calo_record_per_clocktick_.clocktick_25ns = iclocktick;
-	      else
-		{
-		  for (unsigned int isize = 0; isize < ctw_list_per_clocktick.size(); isize++)
-		    {
-		      _build_calo_record_per_clocktick(ctw_list_per_clocktick[isize].get());
-		    } // end of isize
-		}
-	      _gate_circular_buffer_->push_back(_calo_record_per_clocktick_);
-
-	      // Fill calo summary record for each clocktick (based on previous calo records) :
-	      trigger_structures::calo_summary_record my_calo_summary_record;
-	      my_calo_summary_record.clocktick_25ns = iclocktick;
-	      _build_calo_record_summary_structure(my_calo_summary_record);
-	      _compute_calo_finale_decision(my_calo_summary_record);
-	      if (_calo_level_1_finale_decision_.calo_finale_decision) _calo_finale_decision_ = true;
-
-	      if(!_calo_level_1_finale_decision_.is_empty()) calo_records_.push_back(_calo_level_1_finale_decision_);
-	      _calo_record_per_clocktick_.reset();
+	      _process_clocktick(iclocktick, ctw_list_per_clocktick, calo_records_);
 	    } // end of iclocktick
 	}
       return;
@@ -148,6 +148,14 @@ namespace snemo {
       void process(const calo_ctw_data & calo_ctw_data_,
 									 std::vector<trigger_structures::calo_summary_record> & calo_records_);
 
+			/// Start a continuous time process (the gate circular buffer is emptied)
+			void start_stream();
+
+			/// Process a clocktick 25 ns of a continuous time process (clockticks must increase between calls)
+			void process_clocktick(const uint32_t clocktick_25ns_,
+														 const std::vector<datatools::handle<calo_ctw> > & ctw_list_per_clocktick_,
+														 std::vector<trigger_structures::calo_summary_record> & calo_records_);
+
 		protected :
 
 			/// Build the trigger record structure for a clocktick
@@ -159,6 +167,14 @@ namespace snemo {
 			/// Compute the trigger finale decision
 			void _compute_calo_finale_decision(trigger_structures::calo_summary_record & my_calo_summary_record_);
 
+			/// Reset the working data before a process
+			void _start_process();
+
+			/// Process a clocktick 25 ns
+			void _process_clocktick(const uint32_t clocktick_25ns_,
+															const std::vector<datatools::handle<calo_ctw> > & ctw_list_per_clocktick_,
+															std::vector<trigger_structures::calo_summary_record> & calo_records_);
+
 			/// Protected general process
 			void _process(const calo_ctw_data & calo_ctw_data_,
 										std::vector<trigger_structures::calo_summary_record> & calo_records_);
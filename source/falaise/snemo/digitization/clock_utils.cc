@@ -32,6 +32,9 @@ namespace snemo {
     const uint32_t clock_utils::TRACKER_CB_TO_TB_SHIFT_CLOCKTICK_NUMBER;
     const uint32_t clock_utils::TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS;
     const uint32_t clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK;
+    const uint32_t clock_utils::NUMBER_OF_25_CLOCK_IN_1600;
+    const uint32_t clock_utils::NUMBER_OF_800_CLOCK_IN_1600;
+    const uint32_t clock_utils::FIXED_POINT_TIME_FRACTION_BITS;
 
     clock_utils::clock_utils()
     {
@@ -104,16 +107,14 @@ namespace snemo {
     void clock_utils::compute_clocktick_25ns_to_1600ns(const uint32_t clocktick_25ns_,
 						       uint32_t & clocktick_1600ns_) const
     {
-      clocktick_1600ns_ = (clocktick_25ns_ * MAIN_CLOCKTICK) / TRIGGER_CLOCKTICK;
-      clocktick_1600ns_ = clocktick_1600ns_ + TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS;
+      clocktick_1600ns_ = clocktick_25ns_to_1600ns(clocktick_25ns_);
       return;
     }  
 
     void clock_utils::compute_clocktick_800ns_to_1600ns(const uint32_t clocktick_800ns_,
 							uint32_t & clocktick_1600ns_) const
     {
-      clocktick_1600ns_ = (clocktick_800ns_ * TRACKER_CLOCKTICK) / TRIGGER_CLOCKTICK;
-      clocktick_1600ns_ = clocktick_1600ns_ + TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS;
+      clocktick_1600ns_ = clocktick_800ns_to_1600ns(clocktick_800ns_);
       return;
     }
 
@@ -121,19 +122,47 @@ namespace snemo {
     {
       DT_THROW_IF(!is_initialized(), std::logic_error, "Clock utils is not initialized ! ");
       _randomize_shift(prng_);
-      _clocktick_25_ref_ = _shift_1600_ / MAIN_CLOCKTICK;
-      _shift_25_ = fmod(_shift_1600_, MAIN_CLOCKTICK);      
-      _clocktick_800_ref_ = _shift_1600_ / TRACKER_CLOCKTICK;
-      _shift_800_ = fmod(_shift_1600_, TRACKER_CLOCKTICK);
+      _compute_clockticks_ref_from_shift();
       return;
     }
-    
+
+    void clock_utils::compute_clockticks_ref(counter_rng & prng_)
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Clock utils is not initialized ! ");
+      _randomize_shift(prng_);
+      _compute_clockticks_ref_from_shift();
+      return;
+    }
+
+    void clock_utils::compute_clockticks_ref(uint64_t seed_, uint64_t run_, uint64_t event_)
+    {
+      counter_rng prng(seed_, run_, event_, counter_rng::STREAM_CLOCK);
+      compute_clockticks_ref(prng);
+      return;
+    }
+
     void clock_utils::_randomize_shift(mygsl::rng & prng_)
     {
       DT_THROW_IF(!is_initialized(), std::logic_error, "Clock utils is not initialized ! ");
       _shift_1600_ = prng_.flat(0.0, TRIGGER_CLOCKTICK);
       return;
-    }		
+    }
+
+    void clock_utils::_randomize_shift(counter_rng & prng_)
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Clock utils is not initialized ! ");
+      _shift_1600_ = prng_.flat(0.0, TRIGGER_CLOCKTICK);
+      return;
+    }
+
+    void clock_utils::_compute_clockticks_ref_from_shift()
+    {
+      _clocktick_25_ref_ = time_to_clocktick(_shift_1600_, MAIN_CLOCKTICK);
+      _shift_25_ = time_phase_in_clocktick(_shift_1600_, MAIN_CLOCKTICK);
+      _clocktick_800_ref_ = time_to_clocktick(_shift_1600_, TRACKER_CLOCKTICK);
+      _shift_800_ = time_phase_in_clocktick(_shift_1600_, TRACKER_CLOCKTICK);
+      return;
+    }
     
     void clock_utils::tree_dump (std::ostream & out_,
 				 const std::string & title_,
@@ -7,6 +7,8 @@
 
 // Standard Library :
 #include <math.h>
+#include <cmath>
+#include <cstddef>
 #include <limits>
 
 // - Bayeux/datatools:
@@ -19,6 +21,9 @@
 // - Boost:
 #include <boost/cstdint.hpp>
 
+// This project :
+#include <snemo/digitization/counter_rng.h>
+
 namespace snemo {
 
 	namespace digitization {
@@ -48,6 +53,116 @@ namespace snemo {
 
 			static const uint32_t PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK = 625; //!< Number of CT 1600 a previous event record "live" 625 * 1600 = 1 ms
 
+			static const uint32_t NUMBER_OF_25_CLOCK_IN_1600 = 64;  //!< Number of 25 time clock in 1600
+			static const uint32_t NUMBER_OF_800_CLOCK_IN_1600 = 2;  //!< Number of 800 time clock in 1600
+			static const uint32_t FIXED_POINT_TIME_FRACTION_BITS = 16; //!< Number of fractional bits of a fixed point time (unit : 2^-16 ns)
+
+			/// \name Clock domain conversions
+			///
+			/// Integer conversions between the 25, 800 and 1600 ns clock domains
+			/// shared by all the digitization stages. They are exact for 32 and
+			/// 64 bits clockticks (no intermediate product in nanoseconds). The
+			/// clocktick 1600 ns includes the trigger computing shift.
+			//@{
+
+			/// Convert a clocktick 25 ns into a clocktick 1600 ns
+			template <typename Clocktick>
+			static Clocktick clocktick_25ns_to_1600ns(const Clocktick clocktick_25ns_)
+			{
+				return clocktick_25ns_ / NUMBER_OF_25_CLOCK_IN_1600 + TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS;
+			}
+
+			/// Convert a clocktick 800 ns into a clocktick 1600 ns
+			template <typename Clocktick>
+			static Clocktick clocktick_800ns_to_1600ns(const Clocktick clocktick_800ns_)
+			{
+				return clocktick_800ns_ / NUMBER_OF_800_CLOCK_IN_1600 + TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS;
+			}
+
+			/// Return the first clocktick 25 ns converted into a clocktick 1600 ns (>= trigger computing shift)
+			template <typename Clocktick>
+			static Clocktick first_clocktick_25ns_of_1600ns(const Clocktick clocktick_1600ns_)
+			{
+				return (clocktick_1600ns_ - TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS) * NUMBER_OF_25_CLOCK_IN_1600;
+			}
+
+			/// Return the last clocktick 25 ns converted into a clocktick 1600 ns (>= trigger computing shift)
+			template <typename Clocktick>
+			static Clocktick last_clocktick_25ns_of_1600ns(const Clocktick clocktick_1600ns_)
+			{
+				return first_clocktick_25ns_of_1600ns(clocktick_1600ns_) + NUMBER_OF_25_CLOCK_IN_1600 - 1;
+			}
+
+			/// Return the first clocktick 800 ns converted into a clocktick 1600 ns (>= trigger computing shift)
+			template <typename Clocktick>
+			static Clocktick first_clocktick_800ns_of_1600ns(const Clocktick clocktick_1600ns_)
+			{
+				return (clocktick_1600ns_ - TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS) * NUMBER_OF_800_CLOCK_IN_1600;
+			}
+
+			/// Return the last clocktick 800 ns converted into a clocktick 1600 ns (>= trigger computing shift)
+			template <typename Clocktick>
+			static Clocktick last_clocktick_800ns_of_1600ns(const Clocktick clocktick_1600ns_)
+			{
+				return first_clocktick_800ns_of_1600ns(clocktick_1600ns_) + NUMBER_OF_800_CLOCK_IN_1600 - 1;
+			}
+
+			/// Convert an array of clockticks 25 ns into clockticks 1600 ns (the arrays may be the same)
+			template <typename Clocktick>
+			static void clockticks_25ns_to_1600ns(const Clocktick * clockticks_25ns_,
+																						std::size_t number_of_clockticks_,
+																						Clocktick * clockticks_1600ns_)
+			{
+				for (std::size_t i = 0; i < number_of_clockticks_; i++)
+					{
+						clockticks_1600ns_[i] = clocktick_25ns_to_1600ns(clockticks_25ns_[i]);
+					}
+				return;
+			}
+
+			/// Convert an array of clockticks 800 ns into clockticks 1600 ns (the arrays may be the same)
+			template <typename Clocktick>
+			static void clockticks_800ns_to_1600ns(const Clocktick * clockticks_800ns_,
+																						 std::size_t number_of_clockticks_,
+																						 Clocktick * clockticks_1600ns_)
+			{
+				for (std::size_t i = 0; i < number_of_clockticks_; i++)
+					{
+						clockticks_1600ns_[i] = clocktick_800ns_to_1600ns(clockticks_800ns_[i]);
+					}
+				return;
+			}
+
+			/// Convert a time (ns) into a fixed point time (2^-16 ns, rounded down)
+			static int64_t time_to_fixed_point(const double time_)
+			{
+				return static_cast<int64_t>(std::floor(std::ldexp(time_, FIXED_POINT_TIME_FRACTION_BITS)));
+			}
+
+			/// Convert a fixed point time (2^-16 ns) into a time (ns)
+			static double fixed_point_to_time(const int64_t fixed_point_time_)
+			{
+				return std::ldexp(static_cast<double>(fixed_point_time_), -static_cast<int>(FIXED_POINT_TIME_FRACTION_BITS));
+			}
+
+			/// Return the clocktick of a period (ns) containing a time (ns), floor(time / period)
+			static int64_t time_to_clocktick(const double time_, const uint32_t period_)
+			{
+				const int64_t fixed_point_time = time_to_fixed_point(time_);
+				const int64_t fixed_point_period = static_cast<int64_t>(period_) << FIXED_POINT_TIME_FRACTION_BITS;
+				if (fixed_point_time >= 0) return fixed_point_time / fixed_point_period;
+				return -((fixed_point_period - 1 - fixed_point_time) / fixed_point_period);
+			}
+
+			/// Return the phase (ns) of a time (ns) in the clocktick of a period (ns) containing it
+			static double time_phase_in_clocktick(const double time_, const uint32_t period_)
+			{
+				const int64_t fixed_point_period = static_cast<int64_t>(period_) << FIXED_POINT_TIME_FRACTION_BITS;
+				return fixed_point_to_time(time_to_fixed_point(time_) - time_to_clocktick(time_, period_) * fixed_point_period);
+			}
+
+			//@}
+
 			/// Default constructor
 			clock_utils();
 
@@ -97,10 +212,22 @@ namespace snemo {
 			/// Compute clockticks reference
 			void compute_clockticks_ref(mygsl::rng & prng_);
 
+			/// Compute clockticks reference from a per event random stream (independent of the other events)
+			void compute_clockticks_ref(counter_rng & prng_);
+
+			/// Compute clockticks reference for an event identified by (seed, run, event)
+			void compute_clockticks_ref(uint64_t seed_, uint64_t run_, uint64_t event_);
+
 		protected :
 			/// Clocktick shift uniform randomize for 25 and 800ns clockticks
 			void _randomize_shift(mygsl::rng & prng_);
 
+			/// Clocktick shift uniform randomize from a per event random stream
+			void _randomize_shift(counter_rng & prng_);
+
+			/// Compute 25 and 800ns clockticks references and shifts from the 1600ns shift
+			void _compute_clockticks_ref_from_shift();
+
 		private :
 
 			bool    _initialized_;        //!< Initialization flag
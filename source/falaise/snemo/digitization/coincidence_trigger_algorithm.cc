@@ -6,6 +6,7 @@
 #include <snemo/digitization/coincidence_trigger_algorithm.h>
 #include <snemo/digitization/clock_utils.h>
 #include <snemo/digitization/mapping.h>
+#include <snemo/digitization/instrumentation.h>
 
 namespace snemo {
 
@@ -69,61 +70,41 @@ namespace snemo {
       return _coincidence_decision_;
     }
 
-    void coincidence_trigger_algorithm::_process_calo_tracker_coincidence(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> a_pair_for_a_clocktick_,
+    void coincidence_trigger_algorithm::_process_calo_tracker_coincidence(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> & a_pair_for_a_clocktick_,
 										    trigger_structures::coincidence_event_record & a_coincidence_record_,
 										    trigger_structures::L2_decision & a_L2_decision_record_)
 
     {
-      trigger_structures::coincidence_calo_record a_calo_record = a_pair_for_a_clocktick_.first;
-      trigger_structures::tracker_record a_tracker_record = a_pair_for_a_clocktick_.second;
+      const trigger_structures::coincidence_calo_record & a_calo_record = a_pair_for_a_clocktick_.first;
+      const trigger_structures::tracker_record & a_tracker_record = a_pair_for_a_clocktick_.second;
 
       DT_THROW_IF(a_calo_record.clocktick_1600ns != a_tracker_record.clocktick_1600ns, std::logic_error, "Calo tracker coincidence can't process, clockticks of a calo record [" << a_calo_record.clocktick_1600ns << "] and a tracker record [" << a_tracker_record.clocktick_1600ns << "] are not the same ! ");
 
-      for (unsigned int iside = 0; iside < mapping::NUMBER_OF_SIDES; iside++)
+      // All the zones of a side are matched at once on the packed zone masks :
+      // - a middle pattern matches the calorimeter in the same zone,
+      // - a right (left) pattern matches the calorimeter in the same zone or in the next (previous) zone.
+      bool caraco = false;
+      for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
       	{
-      	  for (unsigned int izone = 0; izone < mapping::NUMBER_OF_TRIGGER_ZONES; izone++)
-      	    {
-      	      std::bitset<3> hpattern_for_a_zone = 0x0;
-
-      	      int right = 0;
-      	      int mid   = 1;
-      	      int left  = 2;
-
-      	      hpattern_for_a_zone[right] = a_tracker_record.finale_data_per_zone[iside][izone][right+2];
-      	      hpattern_for_a_zone[mid]   = a_tracker_record.finale_data_per_zone[iside][izone][mid+2];
-      	      hpattern_for_a_zone[left]  = a_tracker_record.finale_data_per_zone[iside][izone][left+2];
-      	      if (hpattern_for_a_zone.any())
-      		{
-      		  if (hpattern_for_a_zone.test(mid) && a_calo_record.calo_zoning_word[iside].test(izone) != 0)
-      		    {
-      		      a_coincidence_record_.coincidence_zoning_word[iside].set(izone, true);
-      		      a_coincidence_record_.decision = true;
-      		      a_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::CARACO;
-      		      _coincidence_decision_ = trigger_structures::L2_trigger_mode::CARACO;
-      		    }
-
-      		  if ((hpattern_for_a_zone.test(right) && a_calo_record.calo_zoning_word[iside].test(izone) != 0) ||
-      		      (izone+1 < 10 && hpattern_for_a_zone.test(right) && a_calo_record.calo_zoning_word[iside].test(izone+1) != 0))
-      		    {
-      		      a_coincidence_record_.coincidence_zoning_word[iside].set(izone, true);
-      		      a_coincidence_record_.decision = true;
-      		      a_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::CARACO;
-      		      _coincidence_decision_ = trigger_structures::L2_trigger_mode::CARACO;
-      		    }
-
-      		  if ((hpattern_for_a_zone.test(left) && a_calo_record.calo_zoning_word[iside].test(izone) != 0) ||
-      		      ((int)(izone-1) > -1 && hpattern_for_a_zone.test(left) && a_calo_record.calo_zoning_word[iside].test(izone-1) != 0))
-      		    {
-      		      a_coincidence_record_.coincidence_zoning_word[iside].set(izone, true);
-      		      a_coincidence_record_.decision = true;
-      		      a_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::CARACO;
-      		      _coincidence_decision_ = trigger_structures::L2_trigger_mode::CARACO;
-      		    }
-
-      		} // end of hpattern.any()
-      	    } // end of izone
+	  const zone_mask_type & calo_zones = a_calo_record.calo_zoning_word[iside];
+	  const zone_mask_type * tracker_zones = a_tracker_record.zone_masks[iside];
+	  const zone_mask_type coincidence_zones = (tracker_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_MIDDLE] & calo_zones)
+	    | (tracker_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_RIGHT] & (calo_zones | (calo_zones >> 1)))
+	    | (tracker_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_LEFT] & (calo_zones | (calo_zones << 1)));
+	  if (coincidence_zones.any())
+	    {
+	      a_coincidence_record_.coincidence_zoning_word[iside] |= coincidence_zones;
+	      caraco = true;
+	    }
       	} // end of iside
 
+      if (caraco)
+	{
+	  a_coincidence_record_.decision = true;
+	  a_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::CARACO;
+	  _coincidence_decision_ = trigger_structures::L2_trigger_mode::CARACO;
+	}
+
       if ((a_coincidence_record_.decision = true) && _coincidence_decision_ == trigger_structures::L2_trigger_mode::CARACO)
       	{
 	  a_coincidence_record_.clocktick_1600ns = a_calo_record.clocktick_1600ns;
@@ -159,97 +140,48 @@ namespace snemo {
       return;
     }
 
-    void coincidence_trigger_algorithm::_process_delayed_coincidence(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> a_pair_for_a_clocktick_,
+    void coincidence_trigger_algorithm::_process_delayed_coincidence(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> & a_pair_for_a_clocktick_,
 									       trigger_structures::coincidence_event_record & a_delayed_coincidence_record_,
 									       trigger_structures::L2_decision & a_L2_decision_record_,
 									       const trigger_structures::previous_event_record & a_previous_event_record_)
     {
-      trigger_structures::tracker_record a_tracker_record = a_pair_for_a_clocktick_.second;
+      const trigger_structures::tracker_record & a_tracker_record = a_pair_for_a_clocktick_.second;
+      const zone_mask_type (& previous_zones)[trigger_info::DATA_FULL_BITSET_SIZE] = a_previous_event_record_.tracker_zone_masks[0];
+      const zone_mask_type (& previous_zones_other_side)[trigger_info::DATA_FULL_BITSET_SIZE] = a_previous_event_record_.tracker_zone_masks[1];
+      // A right pattern in the last zone has no next zone and never matches :
+      const zone_mask_type not_last_zone = zone_mask_type().set().reset(trigger_info::NZONES - 1);
+
+      // APE trigger (Tracker previous / Tracker delayed coincidence), previous event patterns of both sides :
+      const zone_mask_type previous_right  = previous_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_RIGHT]
+	| previous_zones_other_side[trigger_structures::tracker_record::FINALE_DATA_BIT_RIGHT];
+      const zone_mask_type previous_middle = previous_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_MIDDLE]
+	| previous_zones_other_side[trigger_structures::tracker_record::FINALE_DATA_BIT_MIDDLE];
+      const zone_mask_type previous_left   = previous_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_LEFT]
+	| previous_zones_other_side[trigger_structures::tracker_record::FINALE_DATA_BIT_LEFT];
+      // - a delayed left pattern matches a previous left or middle pattern in the same zone or a previous right pattern in the previous zone,
+      // - a delayed middle pattern matches any previous pattern in the same zone,
+      // - a delayed right pattern matches a previous middle or right pattern in the same zone or a previous left pattern in the next zone.
+      const zone_mask_type ape_left_zones   = previous_left | previous_middle | (previous_right << 1);
+      const zone_mask_type ape_middle_zones = previous_left | previous_middle | previous_right;
+      const zone_mask_type ape_right_zones  = (previous_middle | previous_right | (previous_left >> 1)) & not_last_zone;
 
       for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
 	{
-	  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
+	  const zone_mask_type * delayed_zones = a_tracker_record.zone_masks[iside];
+	  const zone_mask_type ape_zones = (delayed_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_LEFT] & ape_left_zones)
+	    | (delayed_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_MIDDLE] & ape_middle_zones)
+	    | (delayed_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_RIGHT] & ape_right_zones);
+	  if (ape_zones.any())
 	    {
-	      std::bitset<3> delayed_hpattern_per_zone = 0x0;
-
-	      int right = 0;
-	      int mid   = 1;
-	      int left  = 2;
-
-	      delayed_hpattern_per_zone[right] = a_tracker_record.finale_data_per_zone[iside][izone][right+2];
-	      delayed_hpattern_per_zone[mid]   = a_tracker_record.finale_data_per_zone[iside][izone][mid+2];
-	      delayed_hpattern_per_zone[left]  = a_tracker_record.finale_data_per_zone[iside][izone][left+2];
-
-	      // APE trigger (Tracker previous / Tracker delayed coincidence)
-	      if (delayed_hpattern_per_zone.any())
+	      for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
 		{
-		  if (delayed_hpattern_per_zone.test(left) && izone == 0 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(left+2)
-									     || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(mid+2)
-									     || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(left+2)
-									     || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(mid+2)))
-		    {
-		      a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
-		      a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
-		      a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::APE;
-		      a_delayed_coincidence_record_.decision = true;
-		      _coincidence_decision_ = trigger_structures::L2_trigger_mode::APE;
-		    }
-
-		  if (delayed_hpattern_per_zone.test(left) && (int)(izone-1) > -1 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone-1].test(right+2)
-									       || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(left+2)
-									       || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(mid+2)
-									       || a_previous_event_record_.tracker_finale_data_per_zone[1][izone-1].test(right+2)
-									       || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(left+2)
-									       || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(mid+2)))
-		    {
-		      a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
-		      a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
-		      a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::APE;
-		      a_delayed_coincidence_record_.decision = true;
-		      _coincidence_decision_ = trigger_structures::L2_trigger_mode::APE;
-		    }
-
-		  if (delayed_hpattern_per_zone.test(mid) && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(left+2)
-							      || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(mid+2)
-							      || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(right+2)
-							      || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(left+2)
-							      || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(mid+2)
-							      || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(right+2)))
-		    {
-		      a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
-		      a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
-		      a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::APE;
-		      a_delayed_coincidence_record_.decision = true;
-		      _coincidence_decision_ = trigger_structures::L2_trigger_mode::APE;
-		    }
-
-		  if (delayed_hpattern_per_zone.test(right) && izone == 10 &&(a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(mid+2)
-									      || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(right+2)
-									      || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(mid+2)
-									      || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(right+2)))
-		    {
-		      a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
-		      a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
-		      a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::APE;
-		      a_delayed_coincidence_record_.decision = true;
-		      _coincidence_decision_ = trigger_structures::L2_trigger_mode::APE;
-		    }
-
-		  if (delayed_hpattern_per_zone.test(right) && izone + 1 < 10 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(mid+2)
-										  || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(right+2)
-										  || a_previous_event_record_.tracker_finale_data_per_zone[0][izone+1].test(left+2)
-										  || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(mid+2)
-										  || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(right+2)
-										  || a_previous_event_record_.tracker_finale_data_per_zone[1][izone+1].test(left+2)))
-		    {
-		      a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
-		      a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
-		      a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::APE;
-		      a_delayed_coincidence_record_.decision = true;
-		      _coincidence_decision_ = trigger_structures::L2_trigger_mode::APE;
-		    }
+		  if (ape_zones.test(izone)) a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
 		}
-	    } // end of izone
+	      a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
+	      a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::APE;
+	      a_delayed_coincidence_record_.decision = true;
+	      _coincidence_decision_ = trigger_structures::L2_trigger_mode::APE;
+	    }
 	} // end of iside
 
       if (a_delayed_coincidence_record_.decision && _coincidence_decision_ == trigger_structures::L2_trigger_mode::APE)
@@ -268,75 +200,32 @@ namespace snemo {
       // Delayed Alpha Veto Event (DAVE) trigger
       else
 	{
+	  // Previous event near source patterns of both sides :
+	  const zone_mask_type previous_near_source_right = previous_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_NSZ_RIGHT]
+	    | previous_zones_other_side[trigger_structures::tracker_record::FINALE_DATA_BIT_NSZ_RIGHT];
+	  const zone_mask_type previous_near_source_left  = previous_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_NSZ_LEFT]
+	    | previous_zones_other_side[trigger_structures::tracker_record::FINALE_DATA_BIT_NSZ_LEFT];
+	  // - a delayed near source left (right) matches any previous near source pattern in the same zone
+	  //   or a previous near source right (left) in the previous (next) zone.
+	  const zone_mask_type dave_left_zones  = previous_near_source_left | previous_near_source_right | (previous_near_source_right << 1);
+	  const zone_mask_type dave_right_zones = (previous_near_source_left | previous_near_source_right | (previous_near_source_left >> 1)) & not_last_zone;
+
 	  for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
 	    {
-	      for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
+	      const zone_mask_type * delayed_zones = a_tracker_record.zone_masks[iside];
+	      const zone_mask_type dave_zones = (delayed_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_NSZ_LEFT] & dave_left_zones)
+		| (delayed_zones[trigger_structures::tracker_record::FINALE_DATA_BIT_NSZ_RIGHT] & dave_right_zones);
+	      if (dave_zones.any())
 		{
-		  std::bitset<2> delayed_near_source_per_zone = 0x0;
-		  int near_source_right = 0;
-		  int near_source_left  = 1;
-		  delayed_near_source_per_zone[near_source_right] = a_tracker_record.finale_data_per_zone[iside][izone][near_source_right + 5];
-		  delayed_near_source_per_zone[near_source_left]  = a_tracker_record.finale_data_per_zone[iside][izone][near_source_left + 5];
-
-		  if (delayed_near_source_per_zone.any())
+		  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
 		    {
-		      if (delayed_near_source_per_zone.test(near_source_left) && izone == 0 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_left+5)
-												|| a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_right+5)
-												|| a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_left+5)
-												|| a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_right+5)))
-			{
-			  a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
-			  a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
-			  a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::DAVE;
-			  a_delayed_coincidence_record_.decision = true;
-			  _coincidence_decision_ = trigger_structures::L2_trigger_mode::DAVE;
-			}
-
-
-		      if (delayed_near_source_per_zone.test(near_source_left) && (int) (izone-1) > -1 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone-1].test(near_source_right+5)
-												    || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_left+5)
-												    || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_right+5)
-												    || a_previous_event_record_.tracker_finale_data_per_zone[1][izone-1].test(near_source_right+5)
-												    || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_left+5)
-												    || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_right+5)))
-
-			{
-			  a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
-			  a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
-			  a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::DAVE;
-			  a_delayed_coincidence_record_.decision = true;
-			  _coincidence_decision_ = trigger_structures::L2_trigger_mode::DAVE;
-			}
-
-
-		      if (delayed_near_source_per_zone.test(near_source_right) && izone == 10 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_left+5)
-												  || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_right+5)
-												  || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_left+5)
-												  || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_right+5)))
-			{
-			  a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
-			  a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
-			  a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::DAVE;
-			  a_delayed_coincidence_record_.decision = true;
-			  _coincidence_decision_ = trigger_structures::L2_trigger_mode::DAVE;
-			}
-
-		      if (delayed_near_source_per_zone.test(near_source_right) && izone + 1 < 10 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_left+5)
-												     || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_right+5)
-												     || a_previous_event_record_.tracker_finale_data_per_zone[0][izone+1].test(near_source_left+5)
-												     || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_left+5)
-												     || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_right+5)
-												     || a_previous_event_record_.tracker_finale_data_per_zone[1][izone+1].test(near_source_left+5)))
-			{
-			  a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
-			  a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
-			  a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::DAVE;
-			  a_delayed_coincidence_record_.decision = true;
-			  _coincidence_decision_ = trigger_structures::L2_trigger_mode::DAVE;
-			}
-		    } // enf of if delayed any
-
-		} // end of izone
+		      if (dave_zones.test(izone)) a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
+		    }
+		  a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
+		  a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::DAVE;
+		  a_delayed_coincidence_record_.decision = true;
+		  _coincidence_decision_ = trigger_structures::L2_trigger_mode::DAVE;
+		}
 	    } // end of iside
 
 	  if (a_delayed_coincidence_record_.decision && _coincidence_decision_ == trigger_structures::L2_trigger_mode::DAVE)
@@ -356,7 +245,7 @@ namespace snemo {
       return;
     }
 
-    void coincidence_trigger_algorithm::process(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> pair_for_a_clocktick_,
+    void coincidence_trigger_algorithm::process(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> & pair_for_a_clocktick_,
 							  trigger_structures::coincidence_event_record & a_coincidence_record_,
 							  trigger_structures::L2_decision & a_L2_decision_record_,
 							  const boost::scoped_ptr<boost::circular_buffer<trigger_structures::previous_event_record> > & previous_event_records_)
@@ -369,11 +258,12 @@ namespace snemo {
       return;
     }
 
-    void coincidence_trigger_algorithm::_process(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> pair_for_a_clocktick_,
+    void coincidence_trigger_algorithm::_process(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> & pair_for_a_clocktick_,
 							   trigger_structures::coincidence_event_record & a_coincidence_record_,
 							   trigger_structures::L2_decision & a_L2_decision_record_,
 							   const boost::scoped_ptr<boost::circular_buffer<trigger_structures::previous_event_record> > & previous_event_records_)
     {
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_COINCIDENCE_TRIGGER);
       reset_data();
       // Process CARACO :
       _process_calo_tracker_coincidence(pair_for_a_clocktick_,
@@ -381,12 +271,13 @@ namespace snemo {
 					a_L2_decision_record_);
       if (previous_event_records_->size() != 0)
 	{
+	  FLDIGI_INSTRUMENT_COUNT(COUNTER_PREVIOUS_EVENTS_PROBED, previous_event_records_->size());
 	  auto it_circ = previous_event_records_->begin();
 	  unsigned int previous_event_counter = 0;
 	  for (; it_circ != previous_event_records_->end(); it_circ++)
 	    {
 	      // If no CARACO or already previous associated event, search for an APE or DAVE delayed coincidence in the PER:
-	      const trigger_structures::previous_event_record a_previous_event_record = *it_circ;
+	      const trigger_structures::previous_event_record & a_previous_event_record = *it_circ;
 	      if (a_previous_event_record.counter_1600ns <= clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK
 		  && a_previous_event_record.counter_1600ns > 0
 		  && !a_L2_decision_record_.L2_decision_bool)
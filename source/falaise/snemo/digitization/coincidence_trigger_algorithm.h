@@ -39,6 +39,9 @@ namespace snemo {
       static const uint32_t SIZE_OF_RESERVED_COINCIDENCE_CALO_RECORDS = 5;
       static const uint32_t SIZE_OF_L2_COINCIDENCE_DECISION_GATE = 5;
 
+      /// Zones of a side, one bit per zone
+      typedef trigger_structures::zoning_word_type zone_mask_type;
+
       /// Default constructor
       coincidence_trigger_algorithm();
 
@@ -64,26 +67,26 @@ namespace snemo {
       bool get_coincidence_decision() const;
 
       /// General process
-      void process(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> pair_for_a_clocktick_,
+      void process(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> & pair_for_a_clocktick_,
 		   trigger_structures::coincidence_event_record & a_coincidence_record_,
 		   trigger_structures::L2_decision & a_L2_decision_record_,
 		   const boost::scoped_ptr<boost::circular_buffer<trigger_structures::previous_event_record> > & previous_event_records_);
 
     protected :
 
-      /// CAlo tRAcker COincidence (CARACO) process for spatial coincidence between calorimeter and tracker each 1600ns
-      void _process_calo_tracker_coincidence(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> a_pair_for_a_clocktick_,
+      /// CAlo tRAcker COincidence (CARACO) process for spatial coincidence between calorimeter and tracker each 1600ns (word-parallel on the tracker zone masks)
+      void _process_calo_tracker_coincidence(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> & a_pair_for_a_clocktick_,
 					     trigger_structures::coincidence_event_record & a_coincidence_record_,
 					     trigger_structures::L2_decision & a_L2_decision_record_);
 
-      /// Alpha delayed Pattern Event (APE) process for delayed
-      void _process_delayed_coincidence(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> a_pair_for_a_clocktick_,
+      /// Alpha delayed Pattern Event (APE) and Delayed Alpha Veto Event (DAVE) process for delayed coincidence with a previous event (word-parallel on the zone masks)
+      void _process_delayed_coincidence(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> & a_pair_for_a_clocktick_,
 					trigger_structures::coincidence_event_record & a_delayed_coincidence_record_,
 					trigger_structures::L2_decision & a_L2_decision_record_,
 					const trigger_structures::previous_event_record & a_previous_event_record_);
 
       /// Process pair record for a clocktick
-      void _process(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> pair_for_a_clocktick_,
+      void _process(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> & pair_for_a_clocktick_,
 		    trigger_structures::coincidence_event_record & a_coincidence_record_,
 		    trigger_structures::L2_decision & a_L2_decision_record_,
 		    const boost::scoped_ptr<boost::circular_buffer<trigger_structures::previous_event_record> > & previous_event_records_);
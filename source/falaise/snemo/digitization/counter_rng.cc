@@ -0,0 +1,93 @@
+// snemo/digitization/counter_rng.cc
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+// Ourselves:
+#include <snemo/digitization/counter_rng.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+    namespace {
+
+      // Weyl sequence increment of SplitMix64 (golden ratio) :
+      const uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    } // end of anonymous namespace
+
+    counter_rng::counter_rng()
+    {
+      set_stream(0, 0, 0, STREAM_CLOCK);
+      return;
+    }
+
+    counter_rng::counter_rng(uint64_t seed_, uint64_t run_, uint64_t event_, uint32_t stream_)
+    {
+      set_stream(seed_, run_, event_, stream_);
+      return;
+    }
+
+    void counter_rng::set_stream(uint64_t seed_, uint64_t run_, uint64_t event_, uint32_t stream_)
+    {
+      // Each field is chained through the hash so that nearby keys give unrelated streams :
+      uint64_t key = mix(seed_ + GOLDEN_GAMMA);
+      key = mix(key ^ (run_ + GOLDEN_GAMMA));
+      key = mix(key ^ (event_ + GOLDEN_GAMMA));
+      key = mix(key ^ (static_cast<uint64_t>(stream_) + GOLDEN_GAMMA));
+      _key_ = key;
+      _counter_ = 0;
+      return;
+    }
+
+    uint64_t counter_rng::get_key() const
+    {
+      return _key_;
+    }
+
+    uint64_t counter_rng::get_counter() const
+    {
+      return _counter_;
+    }
+
+    void counter_rng::set_counter(uint64_t counter_)
+    {
+      _counter_ = counter_;
+      return;
+    }
+
+    uint64_t counter_rng::next()
+    {
+      _counter_++;
+      return mix(_key_ + _counter_ * GOLDEN_GAMMA);
+    }
+
+    double counter_rng::uniform()
+    {
+      // 53 most significant bits, exactly representable in a double :
+      return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    double counter_rng::flat(double min_, double max_)
+    {
+      return min_ + (max_ - min_) * uniform();
+    }
+
+    uint64_t counter_rng::mix(uint64_t word_)
+    {
+      word_ = (word_ ^ (word_ >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      word_ = (word_ ^ (word_ >> 27)) * 0x94D049BB133111EBULL;
+      return word_ ^ (word_ >> 31);
+    }
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
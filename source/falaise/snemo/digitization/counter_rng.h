@@ -0,0 +1,84 @@
+// snemo/digitization/counter_rng.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_COUNTER_RNG_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_COUNTER_RNG_H
+
+// Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+
+namespace snemo {
+
+  namespace digitization {
+
+		/// \brief Counter based pseudo random number stream.
+		///
+		/// A stream is identified by a key (seed, run, event, stream ID) and the
+		/// n-th number of a stream is a hash of the key and of n : random numbers
+		/// of an event do not depend on the previous events, so that skipped,
+		/// reordered or parallel processed events get the same numbers as in a
+		/// serial run.
+		class counter_rng
+		{
+		public :
+
+			/// Identifiers of the streams of an event
+			enum stream_id {
+				STREAM_CLOCK    = 0, //!< Clockticks references
+				STREAM_GEIGER   = 1, //!< Geiger cells randomizations
+				STREAM_CALO     = 2, //!< Calorimeter randomizations
+				STREAM_USER     = 16 //!< First free stream ID
+			};
+
+			/// Default constructor
+			counter_rng();
+
+			/// Constructor with a stream key
+			counter_rng(uint64_t seed_, uint64_t run_, uint64_t event_, uint32_t stream_ = STREAM_CLOCK);
+
+			/// Set the stream key and rewind the stream
+			void set_stream(uint64_t seed_, uint64_t run_, uint64_t event_, uint32_t stream_ = STREAM_CLOCK);
+
+			/// Return the stream key
+			uint64_t get_key() const;
+
+			/// Return the index of the next number in the stream
+			uint64_t get_counter() const;
+
+			/// Set the index of the next number in the stream
+			void set_counter(uint64_t counter_);
+
+			/// Return the next 64 bits number of the stream
+			uint64_t next();
+
+			/// Return the next number of the stream uniformly distributed in [0;1[
+			double uniform();
+
+			/// Return the next number of the stream uniformly distributed in [min;max[
+			double flat(double min_, double max_);
+
+			/// Hash a 64 bits word (SplitMix64 finalizer)
+			static uint64_t mix(uint64_t word_);
+
+		private :
+
+			uint64_t _key_;     //!< Stream key
+			uint64_t _counter_; //!< Index of the next number in the stream
+
+		};
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_COUNTER_RNG_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,450 @@
+// snemo/digitization/ctw_generator.cc
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+// Ourselves:
+#include <snemo/digitization/ctw_generator.h>
+
+// Standard library :
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+
+// This project :
+#include <snemo/digitization/mapping.h>
+#include <snemo/digitization/clock_utils.h>
+#include <snemo/digitization/ID_convertor.h>
+#include <snemo/digitization/calo_ctw_data.h>
+#include <snemo/digitization/geiger_ctw_data.h>
+#include <snemo/digitization/geiger_tp_constants.h>
+#include <snemo/digitization/calo_ctw_constants.h>
+
+namespace {
+
+  /// Number of Geiger cells of the tracker
+  const unsigned int NUMBER_OF_GEIGER_CELLS = snemo::digitization::mapping::NUMBER_OF_SIDES
+    * snemo::digitization::mapping::NUMBER_OF_LAYERS
+    * snemo::digitization::mapping::NUMBER_OF_GEIGER_ROWS;
+
+  /// Return a random integer in [0;n_[
+  unsigned int random_index(snemo::digitization::counter_rng & prng_, unsigned int n_)
+  {
+    return static_cast<unsigned int>(prng_.uniform() * n_);
+  }
+
+  /// Return a Poisson distributed number (normal approximation for large means)
+  unsigned int random_poisson(snemo::digitization::counter_rng & prng_, double mean_)
+  {
+    if (mean_ <= 0.0) return 0;
+    if (mean_ < 30.0)
+      {
+	const double limit = std::exp(-mean_);
+	unsigned int number = 0;
+	double product = prng_.uniform();
+	while (product > limit)
+	  {
+	    number++;
+	    product *= prng_.uniform();
+	  }
+	return number;
+      }
+    // Box-Muller :
+    const double gauss = std::sqrt(-2.0 * std::log(1.0 - prng_.uniform())) * std::cos(2.0 * M_PI * prng_.uniform());
+    const double number = std::floor(mean_ + std::sqrt(mean_) * gauss + 0.5);
+    return number < 0.0 ? 0 : static_cast<unsigned int>(number);
+  }
+
+}
+
+namespace snemo {
+
+  namespace digitization {
+
+    ctw_generator::ctw_generator()
+    {
+      _initialized_ = false;
+      _seed_ = 0;
+      _number_of_tracks_ = 1;
+      _track_min_layers_ = 3;
+      _delayed_alpha_probability_ = 0.0;
+      _alpha_mean_delay_ = 237 * CLHEP::microsecond; // Po-214 mean life
+      _geiger_noise_rate_ = 0.0;
+      _noise_window_ = clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK * clock_utils::TRIGGER_CLOCKTICK * CLHEP::nanosecond;
+      _calo_multiplicity_ = 1;
+      _prompt_clocktick_800_ = 100;
+      _number_of_calo_hits_ = 0;
+      return;
+    }
+
+    ctw_generator::~ctw_generator()
+    {
+      if (is_initialized())
+	{
+	  reset();
+	}
+      return;
+    }
+
+    void ctw_generator::set_seed(uint64_t seed_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "CTW generator is locked ! ");
+      _seed_ = seed_;
+      return;
+    }
+
+    void ctw_generator::set_number_of_tracks(unsigned int number_of_tracks_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "CTW generator is locked ! ");
+      _number_of_tracks_ = number_of_tracks_;
+      return;
+    }
+
+    void ctw_generator::set_track_min_layers(unsigned int track_min_layers_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "CTW generator is locked ! ");
+      DT_THROW_IF(track_min_layers_ == 0 || track_min_layers_ > mapping::NUMBER_OF_LAYERS, std::range_error,
+		  "Invalid minimum number of layers [" << track_min_layers_ << "] ! ");
+      _track_min_layers_ = track_min_layers_;
+      return;
+    }
+
+    void ctw_generator::set_delayed_alpha_probability(double probability_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "CTW generator is locked ! ");
+      DT_THROW_IF(probability_ < 0.0 || probability_ > 1.0, std::range_error, "Invalid alpha probability [" << probability_ << "] ! ");
+      _delayed_alpha_probability_ = probability_;
+      return;
+    }
+
+    void ctw_generator::set_alpha_mean_delay(double mean_delay_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "CTW generator is locked ! ");
+      DT_THROW_IF(mean_delay_ <= 0.0, std::range_error, "Invalid alpha mean delay ! ");
+      _alpha_mean_delay_ = mean_delay_;
+      return;
+    }
+
+    void ctw_generator::set_geiger_noise_rate(double rate_per_cell_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "CTW generator is locked ! ");
+      DT_THROW_IF(rate_per_cell_ < 0.0, std::range_error, "Invalid negative noise rate ! ");
+      _geiger_noise_rate_ = rate_per_cell_;
+      return;
+    }
+
+    void ctw_generator::set_noise_window(double noise_window_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "CTW generator is locked ! ");
+      DT_THROW_IF(noise_window_ < 0.0, std::range_error, "Invalid negative noise window ! ");
+      _noise_window_ = noise_window_;
+      return;
+    }
+
+    void ctw_generator::set_calo_multiplicity(unsigned int calo_multiplicity_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "CTW generator is locked ! ");
+      _calo_multiplicity_ = calo_multiplicity_;
+      return;
+    }
+
+    void ctw_generator::set_prompt_clocktick_800(uint32_t prompt_clocktick_800_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "CTW generator is locked ! ");
+      _prompt_clocktick_800_ = prompt_clocktick_800_;
+      return;
+    }
+
+    void ctw_generator::initialize(const datatools::properties & config_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "CTW generator is already initialized ! ");
+
+      if (config_.has_key("seed")) {
+	const int seed = config_.fetch_integer("seed");
+	DT_THROW_IF(seed < 0, std::domain_error, "Invalid negative seed !");
+	set_seed(seed);
+      }
+
+      if (config_.has_key("number_of_tracks")) {
+	const int number_of_tracks = config_.fetch_integer("number_of_tracks");
+	DT_THROW_IF(number_of_tracks < 0, std::domain_error, "Invalid negative number of tracks !");
+	set_number_of_tracks(number_of_tracks);
+      }
+
+      if (config_.has_key("track_min_layers")) {
+	const int track_min_layers = config_.fetch_integer("track_min_layers");
+	DT_THROW_IF(track_min_layers <= 0, std::domain_error, "Invalid negative minimum number of layers !");
+	set_track_min_layers(track_min_layers);
+      }
+
+      if (config_.has_key("delayed_alpha_probability")) {
+	set_delayed_alpha_probability(config_.fetch_real("delayed_alpha_probability"));
+      }
+
+      if (config_.has_key("alpha_mean_delay")) {
+	double alpha_mean_delay = config_.fetch_real("alpha_mean_delay");
+	if (!config_.has_explicit_unit("alpha_mean_delay")) alpha_mean_delay *= CLHEP::microsecond;
+	set_alpha_mean_delay(alpha_mean_delay);
+      }
+
+      if (config_.has_key("geiger_noise_rate")) {
+	double geiger_noise_rate = config_.fetch_real("geiger_noise_rate");
+	if (!config_.has_explicit_unit("geiger_noise_rate")) geiger_noise_rate *= CLHEP::hertz;
+	set_geiger_noise_rate(geiger_noise_rate);
+      }
+
+      if (config_.has_key("noise_window")) {
+	double noise_window = config_.fetch_real("noise_window");
+	if (!config_.has_explicit_unit("noise_window")) noise_window *= CLHEP::microsecond;
+	set_noise_window(noise_window);
+      }
+
+      if (config_.has_key("calo_multiplicity")) {
+	const int calo_multiplicity = config_.fetch_integer("calo_multiplicity");
+	DT_THROW_IF(calo_multiplicity < 0, std::domain_error, "Invalid negative calorimeter multiplicity !");
+	set_calo_multiplicity(calo_multiplicity);
+      }
+
+      if (config_.has_key("prompt_clocktick_800")) {
+	const int prompt_clocktick_800 = config_.fetch_integer("prompt_clocktick_800");
+	DT_THROW_IF(prompt_clocktick_800 < 0, std::domain_error, "Invalid negative prompt clocktick !");
+	set_prompt_clocktick_800(prompt_clocktick_800);
+      }
+
+      _initialized_ = true;
+      return;
+    }
+
+    void ctw_generator::initialize_simple()
+    {
+      datatools::properties dummy_config;
+      initialize(dummy_config);
+      return;
+    }
+
+    bool ctw_generator::is_initialized() const
+    {
+      return _initialized_;
+    }
+
+    void ctw_generator::reset()
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "CTW generator is not initialized, it can't be reset ! ");
+      _initialized_ = false;
+      _geiger_keys_.clear();
+      _calo_keys_.clear();
+      _number_of_calo_hits_ = 0;
+      return;
+    }
+
+    void ctw_generator::generate(uint64_t event_id_,
+				 calo_ctw_data & calo_ctw_data_,
+				 geiger_ctw_data & geiger_ctw_data_)
+    {
+      counter_rng prng(_seed_, 0, event_id_, counter_rng::STREAM_USER);
+      generate(prng, calo_ctw_data_, geiger_ctw_data_);
+      return;
+    }
+
+    void ctw_generator::generate(counter_rng & prng_,
+				 calo_ctw_data & calo_ctw_data_,
+				 geiger_ctw_data & geiger_ctw_data_)
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "CTW generator is not initialized ! ");
+      _geiger_keys_.clear();
+      _calo_keys_.clear();
+      _number_of_calo_hits_ = 0;
+
+      // Prompt tracks, the first ones end on the calorimeter :
+      unsigned int first_side = random_index(prng_, mapping::NUMBER_OF_SIDES);
+      unsigned int first_vertex_row = random_index(prng_, mapping::NUMBER_OF_GEIGER_ROWS);
+      for (unsigned int itrack = 0; itrack < _number_of_tracks_; itrack++)
+	{
+	  unsigned int side = 0;
+	  unsigned int vertex_row = 0;
+	  _add_track(prng_, side, vertex_row, _number_of_calo_hits_ < _calo_multiplicity_);
+	  if (itrack == 0)
+	    {
+	      first_side = side;
+	      first_vertex_row = vertex_row;
+	    }
+	}
+
+      // Isolated calorimeter hits :
+      while (_number_of_calo_hits_ < _calo_multiplicity_)
+	{
+	  const unsigned int side = random_index(prng_, mapping::NUMBER_OF_SIDES);
+	  const unsigned int column = random_index(prng_, mapping::NUMBER_OF_MAIN_CALO_COLUMNS);
+	  _add_calo_hit(side, column, _prompt_clocktick_800_ * clock_utils::NUMBER_OF_25_CLOCK_IN_800
+			+ random_index(prng_, clock_utils::NUMBER_OF_25_CLOCK_IN_800));
+	}
+
+      // Delayed alpha : 1 to 3 cells near the source foil, around the vertex of the first track :
+      if (_delayed_alpha_probability_ > 0.0 && prng_.uniform() < _delayed_alpha_probability_)
+	{
+	  const double delay = -_alpha_mean_delay_ * std::log(1.0 - prng_.uniform());
+	  const uint32_t alpha_clocktick_800 = _prompt_clocktick_800_ + static_cast<uint32_t>(clock_utils::time_to_clocktick(delay / CLHEP::nanosecond, clock_utils::TRACKER_CLOCKTICK));
+	  const unsigned int number_of_layers = 1 + random_index(prng_, 3);
+	  for (unsigned int ilayer = 0; ilayer < number_of_layers; ilayer++)
+	    {
+	      const int row = static_cast<int>(first_vertex_row) + static_cast<int>(random_index(prng_, 3)) - 1;
+	      if (row < 0 || row >= static_cast<int>(mapping::NUMBER_OF_GEIGER_ROWS)) continue;
+	      _add_geiger_cell(first_side, ilayer, row, alpha_clocktick_800);
+	    }
+	}
+
+      // Geiger noise over the noise window :
+      const unsigned int number_of_noisy_cells = random_poisson(prng_, _geiger_noise_rate_ * _noise_window_ * NUMBER_OF_GEIGER_CELLS);
+      const double noise_window_800 = _noise_window_ / (clock_utils::TRACKER_CLOCKTICK * CLHEP::nanosecond);
+      for (unsigned int inoise = 0; inoise < number_of_noisy_cells; inoise++)
+	{
+	  const unsigned int side = random_index(prng_, mapping::NUMBER_OF_SIDES);
+	  const unsigned int layer = random_index(prng_, mapping::NUMBER_OF_LAYERS);
+	  const unsigned int row = random_index(prng_, mapping::NUMBER_OF_GEIGER_ROWS);
+	  _add_geiger_cell(side, layer, row, _prompt_clocktick_800_ + static_cast<uint32_t>(prng_.uniform() * noise_window_800));
+	}
+
+      _build_ctws(calo_ctw_data_, geiger_ctw_data_);
+      return;
+    }
+
+    void ctw_generator::_add_track(counter_rng & prng_, unsigned int & side_, unsigned int & vertex_row_, bool with_calo_)
+    {
+      side_ = random_index(prng_, mapping::NUMBER_OF_SIDES);
+      vertex_row_ = random_index(prng_, mapping::NUMBER_OF_GEIGER_ROWS);
+      // Straight track in the (layer, row) plane :
+      const double slope = prng_.flat(-1.5, 1.5);
+      unsigned int number_of_layers = mapping::NUMBER_OF_LAYERS;
+      if (!with_calo_) number_of_layers = _track_min_layers_ + random_index(prng_, mapping::NUMBER_OF_LAYERS - _track_min_layers_ + 1);
+      int last_row = vertex_row_;
+      unsigned int crossed_layers = 0;
+      for (unsigned int ilayer = 0; ilayer < number_of_layers; ilayer++)
+	{
+	  const int row = static_cast<int>(std::floor(vertex_row_ + slope * (ilayer + 0.5) + 0.5));
+	  if (row < 0 || row >= static_cast<int>(mapping::NUMBER_OF_GEIGER_ROWS)) break;
+	  // The drift time may push the avalanche to the next clocktick :
+	  const uint32_t clocktick_800 = _prompt_clocktick_800_ + (prng_.uniform() < 0.25 ? 1 : 0);
+	  _add_geiger_cell(side_, ilayer, row, clocktick_800);
+	  last_row = row;
+	  crossed_layers++;
+	}
+
+      if (with_calo_ && crossed_layers == mapping::NUMBER_OF_LAYERS)
+	{
+	  // Columns facing the last row :
+	  const unsigned int column = static_cast<unsigned int>(last_row) * mapping::NUMBER_OF_MAIN_CALO_COLUMNS / mapping::NUMBER_OF_GEIGER_ROWS;
+	  _add_calo_hit(side_, column, _prompt_clocktick_800_ * clock_utils::NUMBER_OF_25_CLOCK_IN_800
+			+ random_index(prng_, clock_utils::NUMBER_OF_25_CLOCK_IN_800));
+	}
+      return;
+    }
+
+    void ctw_generator::_add_geiger_cell(unsigned int side_, unsigned int layer_, unsigned int row_, uint32_t clocktick_800_)
+    {
+      unsigned int crate_id = 0;
+      unsigned int board_id = 0;
+      unsigned int channel_id = 0;
+      ID_convertor::convert_geiger_cell_to_channel(side_, layer_, row_, crate_id, board_id, channel_id);
+      unsigned int block_index = board_id;
+      if (block_index > mapping::CONTROL_BOARD_ID) block_index -= 1;
+      // The cell is active during several clockticks :
+      for (uint32_t ict = 0; ict < clock_utils::ACTIVATED_GEIGER_CELLS_NUMBER; ict++)
+	{
+	  const uint64_t key = (static_cast<uint64_t>(clocktick_800_ + ict) << 32)
+	    | (static_cast<uint64_t>(crate_id) << 24)
+	    | (static_cast<uint64_t>(block_index) << 16)
+	    | static_cast<uint64_t>(channel_id);
+	  _geiger_keys_.push_back(key);
+	}
+      return;
+    }
+
+    void ctw_generator::_add_calo_hit(unsigned int side_, unsigned int column_, uint32_t clocktick_25_)
+    {
+      const unsigned int crate_id = (side_ == 0 ? mapping::MAIN_CALO_SIDE_0_CRATE : mapping::MAIN_CALO_SIDE_1_CRATE);
+      const uint64_t key = (static_cast<uint64_t>(clocktick_25_) << 32)
+	| (static_cast<uint64_t>(crate_id) << 24)
+	| static_cast<uint64_t>(column_ / 2);
+      _calo_keys_.push_back(key);
+      _number_of_calo_hits_++;
+      return;
+    }
+
+    void ctw_generator::_build_ctws(calo_ctw_data & calo_ctw_data_,
+				    geiger_ctw_data & geiger_ctw_data_)
+    {
+      // Sorting the keys groups the hits by (clocktick, crate) :
+      std::sort(_calo_keys_.begin(), _calo_keys_.end());
+      std::sort(_geiger_keys_.begin(), _geiger_keys_.end());
+
+      int32_t calo_hit_id = 0;
+      for (std::size_t ikey = 0; ikey < _calo_keys_.size();)
+	{
+	  const uint64_t group = _calo_keys_[ikey] >> 24;
+	  const uint32_t clocktick_25 = static_cast<uint32_t>(group >> 8);
+	  const uint32_t crate_id = static_cast<uint32_t>(group & 0xFF);
+	  calo_ctw & a_calo_ctw = calo_ctw_data_.add();
+	  geomtools::geom_id ctw_gid(mapping::CALORIMETER_CONTROL_BOARD_TYPE, mapping::CALO_RACK_ID, crate_id, mapping::CONTROL_BOARD_ID);
+	  a_calo_ctw.set_header(calo_hit_id++, ctw_gid, clocktick_25);
+	  unsigned int multiplicity = 0;
+	  for (; ikey < _calo_keys_.size() && (_calo_keys_[ikey] >> 24) == group; ikey++)
+	    {
+	      // The 2 bits multiplicity saturates at 3 :
+	      if (multiplicity < 3) multiplicity++;
+	      a_calo_ctw.set_zoning_bit(calo::ctw::W_ZW_BIT0 + (_calo_keys_[ikey] & 0xFFFF), true);
+	    }
+	  a_calo_ctw.set_htm_main_wall(multiplicity);
+	}
+
+      // Hardware status of the FEBs : row mode, side mode and trigger mode
+      const std::bitset<geiger::tp::THWS_SIZE> hardware_status(mapping::NUMBER_OF_CONNECTED_ROWS
+							       | (mapping::SIDE_MODE ? 1 << (geiger::tp::TSM_BIT - geiger::tp::THWS_BEGIN) : 0)
+							       | (mapping::THREE_WIRES_TRACKER_MODE ? 1 << (geiger::tp::TTM_BIT - geiger::tp::THWS_BEGIN) : 0));
+      int32_t geiger_hit_id = 0;
+      for (std::size_t ikey = 0; ikey < _geiger_keys_.size();)
+	{
+	  const uint64_t group = _geiger_keys_[ikey] >> 24;
+	  const uint32_t clocktick_800 = static_cast<uint32_t>(group >> 8);
+	  const uint32_t crate_id = static_cast<uint32_t>(group & 0xFF);
+	  geiger_ctw & a_geiger_ctw = geiger_ctw_data_.add();
+	  geomtools::geom_id ctw_gid(mapping::TRACKER_CONTROL_BOARD_TYPE, mapping::GEIGER_RACK_ID, crate_id, mapping::CONTROL_BOARD_ID);
+	  a_geiger_ctw.set_header(geiger_hit_id++, ctw_gid, clocktick_800);
+	  while (ikey < _geiger_keys_.size() && (_geiger_keys_[ikey] >> 24) == group)
+	    {
+	      // One 100 bits FEB word per block :
+	      const unsigned int block_index = (_geiger_keys_[ikey] >> 16) & 0xFF;
+	      const unsigned int board_id = (block_index >= mapping::CONTROL_BOARD_ID ? block_index + 1 : block_index);
+	      std::bitset<geiger::tp::FULL_SIZE> feb_word;
+	      for (; ikey < _geiger_keys_.size() && (_geiger_keys_[ikey] >> 16) == ((group << 8) | block_index); ikey++)
+		{
+		  feb_word.set(_geiger_keys_[ikey] & 0xFFFF);
+		}
+	      for (unsigned int ibit = 0; ibit < geiger::tp::THWS_SIZE; ibit++) feb_word.set(geiger::tp::THWS_BEGIN + ibit, hardware_status.test(ibit));
+	      for (unsigned int ibit = 0; ibit < geiger::tp::BOARD_ID_WORD_SIZE; ibit++) feb_word.set(geiger::tp::BOARD_ID_BIT0 + ibit, (board_id >> ibit) & 1);
+	      for (unsigned int ibit = 0; ibit < geiger::tp::CRATE_ID_WORD_SIZE; ibit++) feb_word.set(geiger::tp::CRATE_ID_BIT0 + ibit, (crate_id >> ibit) & 1);
+	      a_geiger_ctw.set_100_bits_in_ctw_word(block_index, feb_word);
+	    }
+	  a_geiger_ctw.set_full_hardware_status(hardware_status);
+	  a_geiger_ctw.set_full_crate_id(std::bitset<geiger::tp::CRATE_ID_WORD_SIZE>(crate_id));
+	}
+      return;
+    }
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
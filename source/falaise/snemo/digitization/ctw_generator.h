@@ -0,0 +1,151 @@
+// snemo/digitization/ctw_generator.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_CTW_GENERATOR_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_CTW_GENERATOR_H
+
+// Standard library :
+#include <vector>
+
+// Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+
+// This project :
+#include <snemo/digitization/counter_rng.h>
+
+namespace datatools {
+  class properties;
+}
+
+namespace snemo {
+
+  namespace digitization {
+
+		class calo_ctw_data;
+		class geiger_ctw_data;
+
+		/// \brief Synthetic crate trigger words generator.
+		///
+		/// Produces calorimeter and Geiger CTWs directly from parametric patterns,
+		/// without geometry nor simulated data :
+		///  - prompt tracks from the source foil crossing the tracker layers of one
+		///    side, each one optionally ending on a main wall calorimeter hit,
+		///  - delayed alphas (short tracks near the vertex of the first track,
+		///    exponentially delayed),
+		///  - Geiger noise at a given rate per cell over the noise window,
+		///  - additional isolated calorimeter hits up to the calorimeter multiplicity.
+		///
+		/// Geiger cells are converted to (crate, board, channel) with the three wires
+		/// mode cabling of the ID convertor and stay active during
+		/// clock_utils::ACTIVATED_GEIGER_CELLS_NUMBER clockticks 800 ns. Calorimeter
+		/// hits are above the high threshold. Random numbers come from a counter based
+		/// stream keyed by (seed, event ID) : events can be generated in any order.
+		class ctw_generator
+		{
+		public :
+
+			/// Default constructor
+			ctw_generator();
+
+			/// Destructor
+			virtual ~ctw_generator();
+
+			/// Set the seed of the random streams
+			void set_seed(uint64_t seed_);
+
+			/// Set the number of prompt tracks per event
+			void set_number_of_tracks(unsigned int number_of_tracks_);
+
+			/// Set the minimum number of crossed layers of a prompt track
+			void set_track_min_layers(unsigned int track_min_layers_);
+
+			/// Set the probability of a delayed alpha per event
+			void set_delayed_alpha_probability(double probability_);
+
+			/// Set the mean delay of the alphas
+			void set_alpha_mean_delay(double mean_delay_);
+
+			/// Set the Geiger noise rate per cell
+			void set_geiger_noise_rate(double rate_per_cell_);
+
+			/// Set the duration of the noise window (starting at the prompt clocktick)
+			void set_noise_window(double noise_window_);
+
+			/// Set the number of calorimeter hits per event
+			void set_calo_multiplicity(unsigned int calo_multiplicity_);
+
+			/// Set the prompt clocktick 800 ns of the events
+			void set_prompt_clocktick_800(uint32_t prompt_clocktick_800_);
+
+			/// Initialize from a set of properties (unset parameters keep their values)
+			void initialize(const datatools::properties & config_);
+
+			/// Initialize with the current parameters
+			void initialize_simple();
+
+			/// Check if the generator is initialized
+			bool is_initialized() const;
+
+			/// Reset the generator
+			void reset();
+
+			/// Generate the CTWs of an event (appended to the CTW data)
+			void generate(uint64_t event_id_,
+										calo_ctw_data & calo_ctw_data_,
+										geiger_ctw_data & geiger_ctw_data_);
+
+			/// Generate the CTWs of an event from a random stream (appended to the CTW data)
+			void generate(counter_rng & prng_,
+										calo_ctw_data & calo_ctw_data_,
+										geiger_ctw_data & geiger_ctw_data_);
+
+		protected :
+
+			/// Add a Geiger cell hit, active from a clocktick 800 ns
+			void _add_geiger_cell(unsigned int side_, unsigned int layer_, unsigned int row_, uint32_t clocktick_800_);
+
+			/// Add a main wall calorimeter hit at a clocktick 25 ns
+			void _add_calo_hit(unsigned int side_, unsigned int column_, uint32_t clocktick_25_);
+
+			/// Add a prompt track, return its vertex row and its side
+			void _add_track(counter_rng & prng_, unsigned int & side_, unsigned int & vertex_row_, bool with_calo_);
+
+			/// Build the CTWs from the collected hits
+			void _build_ctws(calo_ctw_data & calo_ctw_data_,
+											 geiger_ctw_data & geiger_ctw_data_);
+
+		private :
+
+			bool _initialized_;                 //!< Initialization flag
+			uint64_t _seed_;                    //!< Seed of the random streams
+			unsigned int _number_of_tracks_;    //!< Number of prompt tracks per event
+			unsigned int _track_min_layers_;    //!< Minimum number of crossed layers of a prompt track
+			double _delayed_alpha_probability_; //!< Probability of a delayed alpha per event
+			double _alpha_mean_delay_;          //!< Mean delay of the alphas
+			double _geiger_noise_rate_;         //!< Geiger noise rate per cell
+			double _noise_window_;              //!< Duration of the noise window
+			unsigned int _calo_multiplicity_;   //!< Number of calorimeter hits per event
+			uint32_t _prompt_clocktick_800_;    //!< Prompt clocktick 800 ns
+
+			// Working data (kept between events to avoid reallocations) :
+			std::vector<uint64_t> _geiger_keys_; //!< Geiger hits keys : clocktick | crate | block | channel
+			std::vector<uint64_t> _calo_keys_;   //!< Calorimeter hits keys : clocktick | crate | zone
+			unsigned int _number_of_calo_hits_;  //!< Number of calorimeter hits of the current event
+
+		};
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_CTW_GENERATOR_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -9,6 +9,7 @@
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/service_manager.h>
+#include <datatools/utils.h>
 
 // This project (Falaise):
 //#include <falaise/snemo/processing/services.h>
@@ -16,6 +17,7 @@
 
 // This plugin (digitization_module) :
 #include <falaise/snemo/digitization/digitization_driver.h>
+#include <falaise/snemo/digitization/instrumentation.h>
 
 namespace snemo {
 
@@ -62,6 +64,7 @@ namespace snemo {
     {
       _SSD_label_ = snemo::datamodel::data_info::default_simulated_signal_data_label();
       _SDD_label_ = snemo::datamodel::data_info::default_simulated_digitized_data_label();
+      _instrumentation_report_.clear();
       _driver_->reset();
       return;
     }
@@ -85,6 +88,11 @@ namespace snemo {
         _SDD_label_ = setup_.fetch_string("SDD_label");
       }
 
+      if (setup_.has_key("instrumentation_report")) {
+        _instrumentation_report_ = setup_.fetch_string("instrumentation_report");
+        datatools::fetch_path_with_env(_instrumentation_report_);
+      }
+
       // Driver :
       _driver_->initialize(setup_);
 
@@ -99,6 +107,18 @@ namespace snemo {
                   "Module '" << get_name() << "' is not initialized !");
 
       _set_initialized(false);
+
+      // Dump the stage timings and counters accumulated by all threads :
+      if (snemo::digitization::instrumentation::is_enabled()) {
+        snemo::digitization::instrumentation::registry & the_registry = snemo::digitization::instrumentation::registry::instance();
+        if (!_instrumentation_report_.empty()) {
+          the_registry.store_report(_instrumentation_report_);
+        } else if (get_logging_priority() >= datatools::logger::PRIO_NOTICE) {
+          the_registry.print_text(std::clog);
+        }
+        the_registry.reset();
+      }
+
       if (_driver_.get() != 0) {
         if (_driver_->is_initialized()) {
           _driver_->reset();
@@ -144,6 +164,7 @@ namespace snemo {
                                        snemo::datamodel::sim_digi_data & SDD_)
     {
       DT_LOG_TRACE(get_logging_priority(), "Entering...");
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_EVENT);
 
       _driver_->process_digitization_algorithms(SSD_, SDD_);
 
@@ -208,6 +229,29 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::digitization::digitization_module, ocd_)
       ;
   }
 
+  {
+    // Description of the 'instrumentation_report' configuration property :
+    datatools::configuration_property_description & cpd
+      = ocd_.add_property_info();
+    cpd.set_name_pattern("instrumentation_report")
+      .set_terse_description("The file where the instrumentation report is stored at reset")
+      .set_traits(datatools::TYPE_STRING)
+      .set_path(true)
+      .set_mandatory(false)
+      .set_long_description("Only used when the plugin is built with the  \n"
+                            "instrumentation (FalaiseDigitizationPlugin_ENABLE_INSTRUMENTATION). \n"
+                            "Stage timings, counters and latency histograms are \n"
+                            "stored in JSON if the file extension is '.json', in \n"
+                            "text otherwise. Without file, the text report is \n"
+                            "printed at notice logging priority. \n")
+      .add_example("Store a JSON report::                 \n"
+                   "                                      \n"
+                   "  instrumentation_report : string as path = \"digi_timings.json\" \n"
+                   "                                      \n"
+                   )
+      ;
+  }
+
   ocd_.set_validation_support(true);
   ocd_.lock();
 
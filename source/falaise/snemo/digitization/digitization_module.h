@@ -101,6 +101,7 @@ namespace snemo {
 
       std::string _SSD_label_; //!< The label of the simulated data bank
       std::string _SDD_label_; //!< The label of the simulated digitized data bank (output)
+      std::string _instrumentation_report_; //!< The instrumentation report file (JSON if '.json', text otherwise)
 
       const geomtools::manager * _geometry_manager_;  //!< The SuperNEMO geometry manager
 
@@ -13,6 +13,58 @@
 #include <snemo/digitization/geiger_tp.h>
 #include <snemo/digitization/clock_utils.h>
 
+namespace {
+
+  typedef std::bitset<snemo::digitization::geiger_ctw::CTW_BITSET_FULL_SIZE> ctw_bitset_type;
+
+  /// Copy a N bits word (N <= 128) at a bit offset in the CTW with 64 bits word operations
+  template <std::size_t N>
+  void insert_block(ctw_bitset_type & ctw_, unsigned int offset_, const std::bitset<N> & block_)
+  {
+    static_assert(N <= 128, "Block size must not exceed 128 bits");
+    const std::bitset<N> low_64_mask(~0ULL);
+    ctw_bitset_type widened;
+    for (int chunk = (N - 1) / 64; chunk >= 0; chunk--)
+      {
+	widened <<= 64;
+	widened |= ctw_bitset_type(((block_ >> (chunk * 64)) & low_64_mask).to_ullong());
+      }
+    const ctw_bitset_type block_mask = (~ctw_bitset_type()) >> (ctw_bitset_type().size() - N);
+    ctw_ &= ~(block_mask << offset_);
+    ctw_ |= widened << offset_;
+    return;
+  }
+
+  /// Extract a N bits word (N <= 128) at a bit offset in the CTW with 64 bits word operations
+  template <std::size_t N>
+  void extract_block(const ctw_bitset_type & ctw_, unsigned int offset_, std::bitset<N> & block_)
+  {
+    static_assert(N <= 128, "Block size must not exceed 128 bits");
+    const ctw_bitset_type low_64_mask(~0ULL);
+    const ctw_bitset_type shifted = ctw_ >> offset_;
+    block_.reset();
+    for (int chunk = (N - 1) / 64; chunk >= 0; chunk--)
+      {
+	block_ <<= 64;
+	block_ |= std::bitset<N>(((shifted >> (chunk * 64)) & low_64_mask).to_ullong());
+      }
+    return;
+  }
+
+  /// Build the mask of the trigger primitive bits (55 first bits) of each of the 19 FEB blocks
+  ctw_bitset_type build_trigger_primitive_mask()
+  {
+    ctw_bitset_type mask;
+    const ctw_bitset_type tp_mask = (~ctw_bitset_type()) >> (mask.size() - snemo::digitization::geiger::tp::TP_SIZE);
+    for (unsigned int i = 0; i < snemo::digitization::mapping::NUMBER_OF_FEBS_BY_CRATE; i++)
+      {
+	mask |= tp_mask << (i * snemo::digitization::geiger::tp::FULL_SIZE);
+      }
+    return mask;
+  }
+
+}
+
 namespace snemo {
 
   namespace digitization {
@@ -75,88 +127,38 @@ namespace snemo {
 
     void geiger_ctw::get_100_bits_in_ctw_word(unsigned int block_index_, std::bitset<geiger::tp::FULL_SIZE> & my_bitset_) const
     {
-      DT_THROW_IF(block_index_ > mapping::NUMBER_OF_FEBS_BY_CRATE, std::logic_error, "Block index out of range (should be [0;19])  ! ");
-      for (unsigned int i = 0; i < my_bitset_.size(); i++)
-	{
-	  if (_gg_ctw_.test(i + block_index_ * my_bitset_.size()) == true)
-	    {
-	      my_bitset_.set(i, true);
-	    }
-	  else
-	    {
-	      my_bitset_.set(i, false);
-	    }
-	}
+      DT_THROW_IF(block_index_ >= mapping::NUMBER_OF_FEBS_BY_CRATE, std::logic_error, "Block index out of range (should be [0;18])  ! ");
+      extract_block(_gg_ctw_, block_index_ * geiger::tp::FULL_SIZE, my_bitset_);
       return;
     }
 
     void geiger_ctw::set_100_bits_in_ctw_word(unsigned int block_index_, const std::bitset<geiger::tp::FULL_SIZE> & my_bitset_)
     {
-      DT_THROW_IF(block_index_ > mapping::NUMBER_OF_FEBS_BY_CRATE, std::logic_error, "Block index out of range (should be [0;19])  ! ");
-      for (unsigned int i = 0; i < my_bitset_.size(); i++)
-	{
-	  if (my_bitset_.test(i) == true)
-	    {
-	      _gg_ctw_.set(i + block_index_ * my_bitset_.size(), true);
-	    }
-	  else
-	    {
-	      _gg_ctw_.set(i + block_index_ * my_bitset_.size(), false);
-	    }
-	}
+      DT_THROW_IF(block_index_ >= mapping::NUMBER_OF_FEBS_BY_CRATE, std::logic_error, "Block index out of range (should be [0;18])  ! ");
+      insert_block(_gg_ctw_, block_index_ * geiger::tp::FULL_SIZE, my_bitset_);
       _store |= STORE_GG_CTW;
       return;
     }
 
     void geiger_ctw::get_55_bits_in_ctw_word(unsigned int block_index_, std::bitset<geiger::tp::TP_SIZE> & my_bitset_) const
     {
-      DT_THROW_IF(block_index_ > mapping::NUMBER_OF_FEBS_BY_CRATE, std::logic_error, "Block index out of range (should be [0;19])  ! ");
-      for (unsigned int i = 0; i < my_bitset_.size(); i++)
-	{
-	  if (_gg_ctw_.test(i + block_index_ * geiger::tp::FULL_SIZE) == true)
-	    {
-	      my_bitset_.set(i, true);
-	    }
-	  else
-	    {
-	      my_bitset_.set(i, false);
-	    }
-	}
+      DT_THROW_IF(block_index_ >= mapping::NUMBER_OF_FEBS_BY_CRATE, std::logic_error, "Block index out of range (should be [0;18])  ! ");
+      extract_block(_gg_ctw_, block_index_ * geiger::tp::FULL_SIZE, my_bitset_);
       return;
     }
 
     void geiger_ctw::set_55_bits_in_ctw_word(unsigned int block_index_, const std::bitset<geiger::tp::TP_SIZE> & my_bitset_)
     {
-      DT_THROW_IF(block_index_ > mapping::NUMBER_OF_FEBS_BY_CRATE, std::logic_error, "Block index out of range (should be [0;19])  ! ");
-      for (unsigned int i = 0; i < my_bitset_.size(); i++)
-	{
-	  if (my_bitset_.test(i) == true)
-	    {
-	      _gg_ctw_.set(i + block_index_ * 100, true);
-	    }
-	  else
-	    {
-	      _gg_ctw_.set(i + block_index_ * 100, false);
-	    }
-	}
+      DT_THROW_IF(block_index_ >= mapping::NUMBER_OF_FEBS_BY_CRATE, std::logic_error, "Block index out of range (should be [0;18])  ! ");
+      insert_block(_gg_ctw_, block_index_ * geiger::tp::FULL_SIZE, my_bitset_);
       _store |= STORE_GG_CTW;
       return;
     }
 
     void geiger_ctw::get_36_bits_in_ctw_word(unsigned int block_index_, std::bitset<geiger::tp::TP_THREE_WIRES_SIZE> & my_bitset_) const
     {
-      DT_THROW_IF(block_index_ > mapping::NUMBER_OF_FEBS_BY_CRATE, std::logic_error, "Block index out of range (should be [0;19])  ! ");
-      for (unsigned int i = 0; i < my_bitset_.size(); i++)
-	{
-	  if (_gg_ctw_.test(i + block_index_ * geiger::tp::FULL_SIZE) == true)
-	    {
-	      my_bitset_.set(i, true);
-	    }
-	  else
-	    {
-	      my_bitset_.set(i, false);
-	    }
-	}
+      DT_THROW_IF(block_index_ >= mapping::NUMBER_OF_FEBS_BY_CRATE, std::logic_error, "Block index out of range (should be [0;18])  ! ");
+      extract_block(_gg_ctw_, block_index_ * geiger::tp::FULL_SIZE, my_bitset_);
       return;
     }
 
@@ -212,15 +214,8 @@ namespace snemo {
 
     bool geiger_ctw::has_trigger_primitive_values() const
     {
-      bool has_value = false;
-      for (int i = 0; i < 19; i++)
-	{
-	  for (int j = 0; j < 55; j++)
-	    {
-	      if (_gg_ctw_.test(i * 100 + j) == true) has_value = true;
-	    }
-	}
-      return has_value;
+      static const ctw_bitset_type tp_mask = build_trigger_primitive_mask();
+      return (_gg_ctw_ & tp_mask).any();
     }
 
     void geiger_ctw::reset_tw_bitset()
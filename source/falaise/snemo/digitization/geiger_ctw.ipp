@@ -13,6 +13,8 @@
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/bitset.hpp>
+// - This project:
+#include <snemo/digitization/packed_bitset.h>
 // - Bayeux/geomtools
 #include <geomtools/base_hit.ipp>
 	 
@@ -22,7 +24,7 @@ namespace snemo {
 
     template<class Archive>
     void geiger_ctw::serialize (Archive            & ar,
-																const unsigned int  /*version*/)
+																const unsigned int version_)
     {
       // inherit from the 'base_hit' mother class:
       ar & boost::serialization::make_nvp ("geomtools__base_hit",
@@ -35,7 +37,15 @@ namespace snemo {
 		
       if (_store & STORE_GG_CTW)
 	{
-	  ar & boost::serialization::make_nvp ("CTW", _gg_ctw_);
+	  if (version_ < 1)
+	    {
+	      // Old archives : bitset stored as a string of 0/1
+	      ar & boost::serialization::make_nvp ("CTW", _gg_ctw_);
+	    }
+	  else
+	    {
+	      packed_bitset<CTW_BITSET_FULL_SIZE>::serialize(ar, "CTW_mask", "CTW_words", _gg_ctw_);
+	    }
 	}
 
       return;
@@ -99,18 +99,14 @@ namespace snemo {
     void geiger_ctw_data::reset_ctws()
     {
       _geiger_ctws_.clear();
+      _geiger_ctws_pool_.recycle();
       return ;
     }
 		
     geiger_ctw & geiger_ctw_data::add()
     {
-      {
-				geiger_ctw_handle_type dummy;
-				_geiger_ctws_.push_back(dummy);
-      }
-      geiger_ctw_handle_type & last = _geiger_ctws_.back();
-      last.reset(new geiger_ctw);
-      return last.grab();
+      _geiger_ctws_.push_back(_geiger_ctws_pool_.acquire());
+      return _geiger_ctws_.back().grab();
     }
 
     const geiger_ctw_data::geiger_ctw_collection_type & geiger_ctw_data::get_geiger_ctws() const
@@ -17,6 +17,7 @@
 
 // This project :
 #include <snemo/digitization/geiger_ctw.h>
+#include <snemo/digitization/handle_pool.h>
 
 namespace snemo {
 
@@ -88,6 +89,7 @@ namespace snemo {
     private :
 
       geiger_ctw_collection_type _geiger_ctws_; //!< Collection of geigers crate trigger words
+      handle_pool<geiger_ctw> _geiger_ctws_pool_; //!< Pool of recycled crate trigger words (not serialized)
 
       DATATOOLS_SERIALIZATION_DECLARATION()
 
@@ -128,18 +128,14 @@ namespace snemo {
     void geiger_tp_data::reset_tps()
     {
       _geiger_tps_.clear();
+      _geiger_tps_pool_.recycle();
       return ;
     }
 		
     geiger_tp & geiger_tp_data::add()
     {
-      {
-				geiger_tp_handle_type dummy;
-				_geiger_tps_.push_back(dummy);
-      }
-      geiger_tp_handle_type & last = _geiger_tps_.back();
-      last.reset(new geiger_tp);
-      return last.grab();
+      _geiger_tps_.push_back(_geiger_tps_pool_.acquire());
+      return _geiger_tps_.back().grab();
     }
 
     const geiger_tp_data::geiger_tp_collection_type & geiger_tp_data::get_geiger_tps() const
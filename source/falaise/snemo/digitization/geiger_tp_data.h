@@ -18,6 +18,7 @@
 
 // This project :
 #include <snemo/digitization/geiger_tp.h>
+#include <snemo/digitization/handle_pool.h>
 
 namespace snemo {
   
@@ -92,6 +93,7 @@ namespace snemo {
 		private : 
 
 			geiger_tp_collection_type _geiger_tps_; //!< Collection of geigers tracker primitive
+			handle_pool<geiger_tp> _geiger_tps_pool_; //!< Pool of recycled trigger primitives (not serialized)
 
 			DATATOOLS_SERIALIZATION_DECLARATION()
 
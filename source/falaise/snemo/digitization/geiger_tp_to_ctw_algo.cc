@@ -2,9 +2,13 @@
 // Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
 // Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
 
+// Standard library :
+#include <algorithm>
+
 // Ourselves:
 #include <snemo/digitization/geiger_tp_to_ctw_algo.h>
 #include <snemo/digitization/clock_utils.h>
+#include <snemo/digitization/instrumentation.h>
 
 namespace snemo {
   
@@ -53,7 +57,7 @@ namespace snemo {
       return board_id_;   
     }    
 
-    void geiger_tp_to_ctw_algo::_fill_a_geiger_ctw(const geiger_tp & my_geiger_tp_, geiger_ctw & a_geiger_ctw_)
+    void geiger_tp_to_ctw_algo::_fill_a_geiger_ctw(const geiger_tp & my_geiger_tp_, geiger_ctw & a_geiger_ctw_) const
     {  
       geomtools::geom_id temporary_feb_id;
       temporary_feb_id.set_type(my_geiger_tp_.get_geom_id().get_type());
@@ -77,7 +81,7 @@ namespace snemo {
       return;    
     }
     
-    void geiger_tp_to_ctw_algo::_process_for_a_ctw_for_a_clocktick(const std::vector<datatools::handle<geiger_tp> > & my_list_of_geiger_tp_,  geiger_ctw & a_geiger_ctw_) 
+    void geiger_tp_to_ctw_algo::_process_for_a_ctw_for_a_clocktick(const std::vector<datatools::handle<geiger_tp> > & my_list_of_geiger_tp_,  geiger_ctw & a_geiger_ctw_) const
     {       
       for(unsigned int i = 0; i < my_list_of_geiger_tp_.size(); i++)
 	{
@@ -90,20 +94,56 @@ namespace snemo {
     void geiger_tp_to_ctw_algo::process(const geiger_tp_data & geiger_tp_data_,  geiger_ctw_data & geiger_ctw_data_)
     { 
       DT_THROW_IF(!is_initialized(), std::logic_error, "Geiger tp to ctw algo is not initialized, it can't process ! ");
-      for(uint32_t i = geiger_tp_data_.get_clocktick_min(); i <= geiger_tp_data_.get_clocktick_max(); i++)
-      	{
-      	  for(unsigned int j = 0 ; j <= mapping::NUMBER_OF_CRATES ; j++) 
-      	    { 
-      	      std::vector<datatools::handle<geiger_tp> > geiger_tp_list_per_clocktick_per_crate;
-      	      geiger_tp_data_.get_list_of_gg_tp_per_clocktick_per_crate(i, j, geiger_tp_list_per_clocktick_per_crate);
-      	      if(!geiger_tp_list_per_clocktick_per_crate.empty())
-      		{
-      		  geiger_ctw & a_geiger_ctw_ = geiger_ctw_data_.add();
-      		  _process_for_a_ctw_for_a_clocktick(geiger_tp_list_per_clocktick_per_crate, a_geiger_ctw_);
-		  // a_geiger_ctw_.tree_dump(std::clog, "a_geiger_ctw : ", "INFO : ");
-      		}
-      	    }
-      	}
+      _process(geiger_tp_data_, false, 0, geiger_ctw_data_);
+      return;
+    }
+
+    void geiger_tp_to_ctw_algo::process_crate(const geiger_tp_data & geiger_tp_data_, unsigned int crate_number_, geiger_ctw_data & geiger_ctw_data_) const
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Geiger tp to ctw algo is not initialized, it can't process ! ");
+      DT_THROW_IF(crate_number_ > mapping::NUMBER_OF_CRATES, std::range_error, "Unsupported crate number [" << crate_number_ << "] ! ");
+      _process(geiger_tp_data_, true, crate_number_, geiger_ctw_data_);
+      return;
+    }
+
+    void geiger_tp_to_ctw_algo::_process(const geiger_tp_data & geiger_tp_data_, bool single_crate_, unsigned int crate_number_, geiger_ctw_data & geiger_ctw_data_) const
+    {
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_GEIGER_TP_TO_CTW);
+      const geiger_tp_data::geiger_tp_collection_type & geiger_tps = geiger_tp_data_.get_geiger_tps();
+      DT_THROW_IF(geiger_tps.size() > 0xFFFFFF, std::range_error, "Too many geiger TPs [" << geiger_tps.size() << "] ! ");
+
+      // Each TP gets a 64 bits sorting key : clocktick (32 bits) | crate (8 bits) | TP index (24 bits).
+      // Sorting the keys groups the TPs by (clocktick, crate) in the same order as a clocktick
+      // then crate sweep, and keeps the TP order inside a group.
+      std::vector<uint64_t> sorting_keys;
+      sorting_keys.reserve(geiger_tps.size());
+      for (std::size_t i = 0; i < geiger_tps.size(); i++)
+	{
+	  const geiger_tp & a_geiger_tp = geiger_tps[i].get();
+	  const uint32_t crate = a_geiger_tp.get_geom_id().get(mapping::CRATE_INDEX);
+	  if (crate > mapping::NUMBER_OF_CRATES) continue;
+	  if (single_crate_ && crate != crate_number_) continue;
+	  const uint64_t key = (static_cast<uint64_t>(a_geiger_tp.get_clocktick_800ns()) << 32)
+	    | (static_cast<uint64_t>(crate) << 24)
+	    | static_cast<uint64_t>(i & 0xFFFFFF);
+	  sorting_keys.push_back(key);
+	}
+      std::sort(sorting_keys.begin(), sorting_keys.end());
+
+      const uint64_t group_mask = ~static_cast<uint64_t>(0xFFFFFF);
+      geiger_ctw * current_ctw = 0;
+      uint64_t current_group = 0;
+      for (std::size_t i = 0; i < sorting_keys.size(); i++)
+	{
+	  const uint64_t group = sorting_keys[i] & group_mask;
+	  if (current_ctw == 0 || group != current_group)
+	    {
+	      current_ctw = & geiger_ctw_data_.add();
+	      current_group = group;
+	    }
+	  const std::size_t tp_index = sorting_keys[i] & 0xFFFFFF;
+	  _fill_a_geiger_ctw(geiger_tps[tp_index].get(), *current_ctw);
+	}
 
       return;
     }
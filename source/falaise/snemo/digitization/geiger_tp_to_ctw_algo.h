@@ -48,13 +48,20 @@ namespace snemo {
       /// General process to fill a ctw data object from a list of geiger tp
       void process(const geiger_tp_data & tp_data_,  geiger_ctw_data & ctw_data_);
 
+      /// Process only the geiger tp of one crate. It does not modify the algorithm, so
+      /// different crates can be processed concurrently, each one in its own ctw data object
+      void process_crate(const geiger_tp_data & tp_data_, unsigned int crate_number_, geiger_ctw_data & ctw_data_) const;
+
     protected :
 
       /// Fill a geiger ctw from a geiger tp
-      void _fill_a_geiger_ctw(const geiger_tp & my_geiger_tp_, geiger_ctw & a_geiger_ctw_);
+      void _fill_a_geiger_ctw(const geiger_tp & my_geiger_tp_, geiger_ctw & a_geiger_ctw_) const;
       
       /// Process to fill a ctw from a list of geiger tp for a clocktick
-      void _process_for_a_ctw_for_a_clocktick(const std::vector<datatools::handle<geiger_tp> > & my_list_of_geiger_tp_,  geiger_ctw & a_geiger_ctw_);
+      void _process_for_a_ctw_for_a_clocktick(const std::vector<datatools::handle<geiger_tp> > & my_list_of_geiger_tp_,  geiger_ctw & a_geiger_ctw_) const;
+
+      /// Single pass process : geiger tp are grouped by (clocktick, crate) and one ctw is built per group
+      void _process(const geiger_tp_data & tp_data_, bool single_crate_, unsigned int crate_number_, geiger_ctw_data & ctw_data_) const;
 			
     private :
       
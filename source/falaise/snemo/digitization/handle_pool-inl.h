@@ -0,0 +1,101 @@
+// snemo/digitization/handle_pool-inl.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_HANDLE_POOL_INL_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_HANDLE_POOL_INL_H
+
+// Third party :
+// - Boost :
+#include <boost/make_shared.hpp>
+
+namespace snemo {
+
+  namespace digitization {
+
+		template <typename T>
+		handle_pool<T>::handle_pool()
+		{
+			_next_ = 0;
+		}
+
+		template <typename T>
+		handle_pool<T>::handle_pool(const handle_pool & /* other_ */)
+		{
+			_next_ = 0;
+		}
+
+		template <typename T>
+		handle_pool<T> & handle_pool<T>::operator=(const handle_pool & /* other_ */)
+		{
+			recycle();
+			return *this;
+		}
+
+		template <typename T>
+		handle_pool<T>::~handle_pool()
+		{
+			clear();
+		}
+
+		template <typename T>
+		typename handle_pool<T>::handle_type handle_pool<T>::acquire()
+		{
+			if (_next_ == _objects_.size())
+				{
+					_objects_.push_back(boost::make_shared<T>());
+				}
+			else
+				{
+					boost::shared_ptr<T> & an_object = _objects_[_next_];
+					if (an_object.unique())
+						{
+							// Nobody else refers to it, back to the default state :
+							*an_object = T();
+						}
+					else
+						{
+							an_object = boost::make_shared<T>();
+						}
+				}
+			return handle_type(_objects_[_next_++]);
+		}
+
+		template <typename T>
+		void handle_pool<T>::recycle()
+		{
+			_next_ = 0;
+		}
+
+		template <typename T>
+		void handle_pool<T>::clear()
+		{
+			_objects_.clear();
+			_next_ = 0;
+		}
+
+		template <typename T>
+		std::size_t handle_pool<T>::get_capacity() const
+		{
+			return _objects_.size();
+		}
+
+		template <typename T>
+		std::size_t handle_pool<T>::get_number_of_acquired() const
+		{
+			return _next_;
+		}
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_HANDLE_POOL_INL_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,81 @@
+// snemo/digitization/handle_pool.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_HANDLE_POOL_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_HANDLE_POOL_H
+
+// Standard library :
+#include <vector>
+
+// Third party:
+// - Boost :
+#include <boost/shared_ptr.hpp>
+// - Bayeux/datatools :
+#include <bayeux/datatools/handle.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+		template <typename T>
+
+		/// \brief Pool of objects handed out as handles and recycled from one event to the next.
+		///
+		/// Objects (and their shared count) are allocated once and reused after recycle().
+		/// An object still referenced outside the pool is never reused : a fresh one takes its slot.
+		class handle_pool
+		{
+		public :
+
+			typedef datatools::handle<T> handle_type;
+
+			/// Default constructor
+			handle_pool();
+
+			/// Copy constructor (the pooled objects are not shared with the copy)
+			handle_pool(const handle_pool & other_);
+
+			/// Assignment (the pooled objects are kept)
+			handle_pool & operator=(const handle_pool & other_);
+
+			/// Destructor
+			~handle_pool();
+
+			/// Return a handle on a default state object
+			handle_type acquire();
+
+			/// Make all the pooled objects available again
+			void recycle();
+
+			/// Release the memory of all the pooled objects
+			void clear();
+
+			/// Return the number of pooled objects
+			std::size_t get_capacity() const;
+
+			/// Return the number of objects acquired since the last recycle
+			std::size_t get_number_of_acquired() const;
+
+		private :
+
+			std::vector<boost::shared_ptr<T> > _objects_; //!< Pooled objects
+			std::size_t _next_; //!< Index of the next available pooled object
+
+		};
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#include <snemo/digitization/handle_pool-inl.h>
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_HANDLE_POOL_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
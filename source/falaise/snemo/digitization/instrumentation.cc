@@ -0,0 +1,324 @@
+// snemo/digitization/instrumentation.cc
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+// Ourselves:
+#include <snemo/digitization/instrumentation.h>
+
+// Standard library :
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+namespace {
+
+  const char * STAGE_LABELS[snemo::digitization::instrumentation::NUMBER_OF_STAGES] = {
+    "event",
+    "sd_to_geiger_signal",
+    "sd_to_calo_signal",
+    "signal_to_geiger_tp",
+    "signal_to_calo_tp",
+    "geiger_tp_to_ctw",
+    "calo_tp_to_ctw",
+    "trigger",
+    "calo_trigger",
+    "tracker_trigger",
+    "coincidence_trigger"
+  };
+
+  const char * COUNTER_LABELS[snemo::digitization::instrumentation::NUMBER_OF_COUNTERS] = {
+    "calo_clockticks_25ns",
+    "trigger_clockticks_1600ns",
+    "lut_fetches",
+    "calo_ctws_decoded",
+    "geiger_ctws_decoded",
+    "previous_events_probed",
+    "tracker_cache_hits",
+    "tracker_cache_misses"
+  };
+
+}
+
+namespace snemo {
+
+  namespace digitization {
+
+    namespace instrumentation {
+
+      const char * stage_label(stage_type stage_)
+      {
+	DT_THROW_IF(stage_ < 0 || stage_ >= NUMBER_OF_STAGES, std::range_error, "Invalid stage " << stage_ << " ! ");
+	return STAGE_LABELS[stage_];
+      }
+
+      const char * counter_label(counter_type counter_)
+      {
+	DT_THROW_IF(counter_ < 0 || counter_ >= NUMBER_OF_COUNTERS, std::range_error, "Invalid counter " << counter_ << " ! ");
+	return COUNTER_LABELS[counter_];
+      }
+
+      bool is_enabled()
+      {
+#ifdef FALAISE_DIGITIZATION_WITH_INSTRUMENTATION
+	return true;
+#else
+	return false;
+#endif
+      }
+
+      stage_statistics::stage_statistics()
+      {
+	reset();
+	return;
+      }
+
+      void stage_statistics::merge(const stage_statistics & other_)
+      {
+	add_value(number_of_calls, other_.number_of_calls.load(std::memory_order_relaxed));
+	add_value(total_ticks, other_.total_ticks.load(std::memory_order_relaxed));
+	const uint64_t other_min_ticks = other_.min_ticks.load(std::memory_order_relaxed);
+	const uint64_t other_max_ticks = other_.max_ticks.load(std::memory_order_relaxed);
+	if (other_min_ticks < min_ticks.load(std::memory_order_relaxed)) min_ticks.store(other_min_ticks, std::memory_order_relaxed);
+	if (other_max_ticks > max_ticks.load(std::memory_order_relaxed)) max_ticks.store(other_max_ticks, std::memory_order_relaxed);
+	for (unsigned int ibin = 0; ibin < NUMBER_OF_BINS; ibin++) add_value(histogram[ibin], other_.histogram[ibin].load(std::memory_order_relaxed));
+	return;
+      }
+
+      void stage_statistics::reset()
+      {
+	number_of_calls.store(0, std::memory_order_relaxed);
+	total_ticks.store(0, std::memory_order_relaxed);
+	min_ticks.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+	max_ticks.store(0, std::memory_order_relaxed);
+	for (unsigned int ibin = 0; ibin < NUMBER_OF_BINS; ibin++) histogram[ibin].store(0, std::memory_order_relaxed);
+	return;
+      }
+
+      thread_statistics::thread_statistics()
+      {
+	reset();
+	return;
+      }
+
+      void thread_statistics::merge(const thread_statistics & other_)
+      {
+	for (unsigned int istage = 0; istage < NUMBER_OF_STAGES; istage++) stages[istage].merge(other_.stages[istage]);
+	for (unsigned int icounter = 0; icounter < NUMBER_OF_COUNTERS; icounter++) add_value(counters[icounter], other_.counters[icounter].load(std::memory_order_relaxed));
+	return;
+      }
+
+      void thread_statistics::reset()
+      {
+	for (unsigned int istage = 0; istage < NUMBER_OF_STAGES; istage++) stages[istage].reset();
+	for (unsigned int icounter = 0; icounter < NUMBER_OF_COUNTERS; icounter++) counters[icounter].store(0, std::memory_order_relaxed);
+	return;
+      }
+
+      registry & registry::instance()
+      {
+	static registry the_registry;
+	return the_registry;
+      }
+
+      registry::registry()
+      {
+	_start_ticks_ = read_ticks();
+	_start_time_ = std::chrono::steady_clock::now();
+	return;
+      }
+
+      thread_statistics & registry::_register_thread_()
+      {
+	std::lock_guard<std::mutex> lock(_mutex_);
+	_threads_.push_back(std::unique_ptr<thread_statistics>(new thread_statistics));
+	return *_threads_.back();
+      }
+
+      std::size_t registry::get_number_of_threads() const
+      {
+	std::lock_guard<std::mutex> lock(_mutex_);
+	return _threads_.size();
+      }
+
+      void registry::merge(thread_statistics & total_) const
+      {
+	std::lock_guard<std::mutex> lock(_mutex_);
+	for (std::size_t ithread = 0; ithread < _threads_.size(); ithread++) total_.merge(*_threads_[ithread]);
+	return;
+      }
+
+      double registry::get_ticks_per_nanosecond() const
+      {
+	const double elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start_time_).count();
+	const double elapsed_ticks = read_ticks() - _start_ticks_;
+	if (elapsed_ns <= 0.0 || elapsed_ticks <= 0.0) return 1.0;
+	return elapsed_ticks / elapsed_ns;
+      }
+
+      void registry::print_text(std::ostream & out_) const
+      {
+	thread_statistics total;
+	merge(total);
+	const double ticks_per_us = get_ticks_per_nanosecond() * 1000.0;
+	const std::ios::fmtflags saved_flags = out_.flags();
+	const std::streamsize saved_precision = out_.precision();
+
+	out_ << "Digitization instrumentation (" << get_number_of_threads() << " thread(s), "
+	     << std::setprecision(4) << ticks_per_us / 1000.0 << " ticks/ns) :" << std::endl;
+	out_ << std::left << std::setw(22) << "Stage" << std::right
+	     << std::setw(12) << "Calls"
+	     << std::setw(14) << "Total [ms]"
+	     << std::setw(12) << "Mean [us]"
+	     << std::setw(12) << "Min [us]"
+	     << std::setw(12) << "Max [us]" << std::endl;
+	out_ << std::fixed << std::setprecision(3);
+	for (unsigned int istage = 0; istage < NUMBER_OF_STAGES; istage++)
+	  {
+	    const stage_statistics & a_stage = total.stages[istage];
+	    if (a_stage.number_of_calls == 0) continue;
+	    out_ << std::left << std::setw(22) << STAGE_LABELS[istage] << std::right
+		 << std::setw(12) << a_stage.number_of_calls
+		 << std::setw(14) << a_stage.total_ticks / ticks_per_us / 1000.0
+		 << std::setw(12) << a_stage.total_ticks / ticks_per_us / a_stage.number_of_calls
+		 << std::setw(12) << a_stage.min_ticks / ticks_per_us
+		 << std::setw(12) << a_stage.max_ticks / ticks_per_us << std::endl;
+	  }
+
+	out_ << "Counters :" << std::endl;
+	for (unsigned int icounter = 0; icounter < NUMBER_OF_COUNTERS; icounter++)
+	  {
+	    out_ << "  " << std::left << std::setw(28) << COUNTER_LABELS[icounter] << std::right << " : " << total.counters[icounter] << std::endl;
+	  }
+
+	out_ << "Latency histograms [us] :" << std::endl;
+	for (unsigned int istage = 0; istage < NUMBER_OF_STAGES; istage++)
+	  {
+	    const stage_statistics & a_stage = total.stages[istage];
+	    if (a_stage.number_of_calls == 0) continue;
+	    out_ << "  " << STAGE_LABELS[istage] << " :" << std::endl;
+	    for (unsigned int ibin = 0; ibin < stage_statistics::NUMBER_OF_BINS; ibin++)
+	      {
+		if (a_stage.histogram[ibin] == 0) continue;
+		const double low = (ibin == 0 ? 0.0 : std::ldexp(1.0, ibin)) / ticks_per_us;
+		const double high = std::ldexp(1.0, ibin + 1) / ticks_per_us;
+		out_ << "    [" << std::setw(12) << low << ";" << std::setw(12) << high << "[ : " << a_stage.histogram[ibin] << std::endl;
+	      }
+	  }
+	out_.flags(saved_flags);
+	out_.precision(saved_precision);
+	return;
+      }
+
+      void registry::print_json(std::ostream & out_) const
+      {
+	thread_statistics total;
+	merge(total);
+	const double ticks_per_ns = get_ticks_per_nanosecond();
+	const std::ios::fmtflags saved_flags = out_.flags();
+	const std::streamsize saved_precision = out_.precision();
+
+	out_ << std::fixed << std::setprecision(1);
+	out_ << "{\n";
+	out_ << "  \"enabled\": " << (is_enabled() ? "true" : "false") << ",\n";
+	out_ << "  \"threads\": " << get_number_of_threads() << ",\n";
+	out_ << "  \"ticks_per_ns\": " << std::setprecision(4) << ticks_per_ns << std::setprecision(1) << ",\n";
+	out_ << "  \"stages\": {";
+	bool first_stage = true;
+	for (unsigned int istage = 0; istage < NUMBER_OF_STAGES; istage++)
+	  {
+	    const stage_statistics & a_stage = total.stages[istage];
+	    if (a_stage.number_of_calls == 0) continue;
+	    out_ << (first_stage ? "\n" : ",\n");
+	    first_stage = false;
+	    out_ << "    \"" << STAGE_LABELS[istage] << "\": {"
+		 << "\"calls\": " << a_stage.number_of_calls
+		 << ", \"total_ns\": " << a_stage.total_ticks / ticks_per_ns
+		 << ", \"min_ns\": " << a_stage.min_ticks / ticks_per_ns
+		 << ", \"max_ns\": " << a_stage.max_ticks / ticks_per_ns
+		 << ", \"histogram\": [";
+	    bool first_bin = true;
+	    for (unsigned int ibin = 0; ibin < stage_statistics::NUMBER_OF_BINS; ibin++)
+	      {
+		if (a_stage.histogram[ibin] == 0) continue;
+		if (!first_bin) out_ << ", ";
+		first_bin = false;
+		const double low = (ibin == 0 ? 0.0 : std::ldexp(1.0, ibin)) / ticks_per_ns;
+		out_ << "{\"low_ns\": " << low << ", \"count\": " << a_stage.histogram[ibin] << "}";
+	      }
+	    out_ << "]}";
+	  }
+	out_ << (first_stage ? "},\n" : "\n  },\n");
+	out_ << "  \"counters\": {";
+	for (unsigned int icounter = 0; icounter < NUMBER_OF_COUNTERS; icounter++)
+	  {
+	    out_ << (icounter == 0 ? "\n" : ",\n") << "    \"" << COUNTER_LABELS[icounter] << "\": " << total.counters[icounter];
+	  }
+	out_ << "\n  },\n";
+
+	// Per thread totals :
+	out_ << "  \"per_thread\": [";
+	{
+	  std::lock_guard<std::mutex> lock(_mutex_);
+	  for (std::size_t ithread = 0; ithread < _threads_.size(); ithread++)
+	    {
+	      const thread_statistics & a_thread = *_threads_[ithread];
+	      out_ << (ithread == 0 ? "\n" : ",\n") << "    {\"stages\": {";
+	      bool first_thread_stage = true;
+	      for (unsigned int istage = 0; istage < NUMBER_OF_STAGES; istage++)
+		{
+		  if (a_thread.stages[istage].number_of_calls == 0) continue;
+		  if (!first_thread_stage) out_ << ", ";
+		  first_thread_stage = false;
+		  out_ << "\"" << STAGE_LABELS[istage] << "\": {\"calls\": " << a_thread.stages[istage].number_of_calls
+		       << ", \"total_ns\": " << a_thread.stages[istage].total_ticks / ticks_per_ns << "}";
+		}
+	      out_ << "}, \"counters\": {";
+	      for (unsigned int icounter = 0; icounter < NUMBER_OF_COUNTERS; icounter++)
+		{
+		  if (icounter != 0) out_ << ", ";
+		  out_ << "\"" << COUNTER_LABELS[icounter] << "\": " << a_thread.counters[icounter];
+		}
+	      out_ << "}}";
+	    }
+	  out_ << (_threads_.empty() ? "]\n" : "\n  ]\n");
+	}
+	out_ << "}" << std::endl;
+	out_.flags(saved_flags);
+	out_.precision(saved_precision);
+	return;
+      }
+
+      void registry::store_report(const std::string & filename_) const
+      {
+	std::ofstream report(filename_.c_str());
+	DT_THROW_IF(!report, std::runtime_error, "Cannot open instrumentation report file '" << filename_ << "' ! ");
+	const std::string json_extension = ".json";
+	if (filename_.size() >= json_extension.size()
+	    && filename_.compare(filename_.size() - json_extension.size(), json_extension.size(), json_extension) == 0)
+	  {
+	    print_json(report);
+	  }
+	else
+	  {
+	    print_text(report);
+	  }
+	return;
+      }
+
+      void registry::reset()
+      {
+	std::lock_guard<std::mutex> lock(_mutex_);
+	for (std::size_t ithread = 0; ithread < _threads_.size(); ithread++) _threads_[ithread]->reset();
+	return;
+      }
+
+    } // end of namespace instrumentation
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
@@ -0,0 +1,275 @@
+// snemo/digitization/instrumentation.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_INSTRUMENTATION_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_INSTRUMENTATION_H
+
+// Standard library :
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <iostream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+
+/// Hot path instrumentation of the digitization and trigger stages.
+///
+/// Stage timers and counters are only compiled when the library is built with
+/// FALAISE_DIGITIZATION_WITH_INSTRUMENTATION (CMake option
+/// FalaiseDigitizationPlugin_ENABLE_INSTRUMENTATION), otherwise the
+/// FLDIGI_INSTRUMENT_* macros expand to nothing. Statistics are accumulated
+/// per thread without locking in relaxed atomics, so that the report can merge
+/// or reset them while the workers run.
+#ifdef FALAISE_DIGITIZATION_WITH_INSTRUMENTATION
+#define FLDIGI_INSTRUMENT_CONCAT_(A, B) A##B
+#define FLDIGI_INSTRUMENT_CONCAT(A, B) FLDIGI_INSTRUMENT_CONCAT_(A, B)
+/// Time the enclosing scope as a stage
+#define FLDIGI_INSTRUMENT_SCOPE(Stage)					\
+  ::snemo::digitization::instrumentation::scoped_timer			\
+  FLDIGI_INSTRUMENT_CONCAT(fldigi_instrument_timer_, __LINE__)(::snemo::digitization::instrumentation::Stage)
+/// Add a value to a counter
+#define FLDIGI_INSTRUMENT_COUNT(Counter, Value)				\
+  ::snemo::digitization::instrumentation::count(::snemo::digitization::instrumentation::Counter, (Value))
+#else
+#define FLDIGI_INSTRUMENT_SCOPE(Stage)
+#define FLDIGI_INSTRUMENT_COUNT(Counter, Value)
+#endif
+
+namespace snemo {
+
+  namespace digitization {
+
+		namespace instrumentation {
+
+			/// Instrumented stages
+			enum stage_type {
+				STAGE_EVENT                  = 0,  //!< Full digitization of an event
+				STAGE_SD_TO_GEIGER_SIGNAL    = 1,  //!< Simulated data to Geiger signals
+				STAGE_SD_TO_CALO_SIGNAL      = 2,  //!< Simulated data to calorimeter signals
+				STAGE_SIGNAL_TO_GEIGER_TP    = 3,  //!< Geiger signals to trigger primitives
+				STAGE_SIGNAL_TO_CALO_TP      = 4,  //!< Calorimeter signals to trigger primitives
+				STAGE_GEIGER_TP_TO_CTW       = 5,  //!< Geiger trigger primitives to crate trigger words
+				STAGE_CALO_TP_TO_CTW         = 6,  //!< Calorimeter trigger primitives to crate trigger words
+				STAGE_TRIGGER                = 7,  //!< Full trigger algorithm of an event
+				STAGE_CALO_TRIGGER           = 8,  //!< Calorimeter trigger algorithm of an event
+				STAGE_TRACKER_TRIGGER        = 9,  //!< Tracker trigger algorithm of a clocktick 1600 ns
+				STAGE_COINCIDENCE_TRIGGER    = 10, //!< Coincidence trigger algorithm of a clocktick 1600 ns
+				NUMBER_OF_STAGES             = 11
+			};
+
+			/// Instrumented counters
+			enum counter_type {
+				COUNTER_CALO_CLOCKTICKS_25NS      = 0, //!< Clockticks 25 ns processed by the calorimeter trigger
+				COUNTER_TRIGGER_CLOCKTICKS_1600NS = 1, //!< Clockticks 1600 ns processed by the trigger loop
+				COUNTER_LUT_FETCHES               = 2, //!< Tracker trigger memories (LUT) fetches : 2 per sliding zone (mem1, mem2) and 1 per zone in the dense zone LUT (mem3 and mem4 or mem5 in the zone by zone reference)
+				COUNTER_CALO_CTWS_DECODED         = 3, //!< Calorimeter CTWs decoded
+				COUNTER_GEIGER_CTWS_DECODED       = 4, //!< Geiger CTWs decoded
+				COUNTER_PREVIOUS_EVENTS_PROBED    = 5, //!< Previous event records probed for delayed coincidences
+				COUNTER_TRACKER_CACHE_HITS        = 6, //!< Tracker records found in the tracker record cache
+				COUNTER_TRACKER_CACHE_MISSES      = 7, //!< Tracker records computed (not in the tracker record cache)
+				NUMBER_OF_COUNTERS                = 8
+			};
+
+			/// Return the label of a stage
+			const char * stage_label(stage_type stage_);
+
+			/// Return the label of a counter
+			const char * counter_label(counter_type counter_);
+
+			/// Check if the instrumentation is compiled in
+			bool is_enabled();
+
+			/// Statistic value written by its owner thread only and read (or reset) by any thread
+			typedef std::atomic<uint64_t> statistic_value;
+
+			/// Add a value to a statistic of the calling thread (relaxed load and store, no locked instruction)
+			inline void add_value(statistic_value & statistic_, uint64_t value_)
+			{
+				statistic_.store(statistic_.load(std::memory_order_relaxed) + value_, std::memory_order_relaxed);
+				return;
+			}
+
+			/// Read the time stamp counter (steady clock nanoseconds on other architectures)
+			inline uint64_t read_ticks()
+			{
+#if defined(__x86_64__) || defined(__i386__)
+				return __rdtsc();
+#else
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+			}
+
+			/// \brief Timing statistics of a stage with a log2 histogram of the durations
+			struct stage_statistics
+			{
+				static const unsigned int NUMBER_OF_BINS = 64;
+
+				/// Default constructor
+				stage_statistics();
+
+				/// Add a duration (ticks)
+				void add(uint64_t ticks_)
+				{
+					add_value(number_of_calls, 1);
+					add_value(total_ticks, ticks_);
+					if (ticks_ < min_ticks.load(std::memory_order_relaxed)) min_ticks.store(ticks_, std::memory_order_relaxed);
+					if (ticks_ > max_ticks.load(std::memory_order_relaxed)) max_ticks.store(ticks_, std::memory_order_relaxed);
+					add_value(histogram[bin_index(ticks_)], 1);
+					return;
+				}
+
+				/// Merge the statistics of another stage (each value is read atomically, the
+				/// stage as a whole is a consistent snapshot only if its thread is idle)
+				void merge(const stage_statistics & other_);
+
+				/// Reset the statistics (a duration recorded concurrently by the owner thread may survive the reset)
+				void reset();
+
+				/// Return the histogram bin of a duration : bin i holds [2^i, 2^(i+1)[ ticks
+				static unsigned int bin_index(uint64_t ticks_)
+				{
+#if defined(__GNUC__)
+					return 63 - __builtin_clzll(ticks_ | 1);
+#else
+					unsigned int index = 0;
+					while (ticks_ >>= 1) index++;
+					return index;
+#endif
+				}
+
+				statistic_value number_of_calls;            //!< Number of timed calls
+				statistic_value total_ticks;                //!< Total duration
+				statistic_value min_ticks;                  //!< Minimum duration
+				statistic_value max_ticks;                  //!< Maximum duration
+				statistic_value histogram[NUMBER_OF_BINS];  //!< Log2 histogram of the durations
+			};
+
+			/// \brief Statistics of all stages and counters for a thread
+			struct thread_statistics
+			{
+				/// Default constructor
+				thread_statistics();
+
+				/// Merge the statistics of another thread
+				void merge(const thread_statistics & other_);
+
+				/// Reset the statistics
+				void reset();
+
+				stage_statistics stages[NUMBER_OF_STAGES];    //!< Stage timings
+				statistic_value counters[NUMBER_OF_COUNTERS]; //!< Counters
+			};
+
+			/// \brief Process wide registry of the per thread statistics
+			class registry
+			{
+			public :
+
+				/// Return the registry
+				static registry & instance();
+
+				/// Return the statistics of the calling thread (registered at first use)
+				thread_statistics & grab_thread_statistics()
+				{
+					static thread_local thread_statistics * local_statistics = 0;
+					if (local_statistics == 0) local_statistics = &_register_thread_();
+					return *local_statistics;
+				}
+
+				/// Return the number of registered threads
+				std::size_t get_number_of_threads() const;
+
+				/// Merge the statistics of all threads (exact once the workers are joined or idle)
+				void merge(thread_statistics & total_) const;
+
+				/// Return the number of ticks per nanosecond (calibrated against the steady clock)
+				double get_ticks_per_nanosecond() const;
+
+				/// Print a text report
+				void print_text(std::ostream & out_) const;
+
+				/// Print a JSON report
+				void print_json(std::ostream & out_) const;
+
+				/// Store the report in a file (JSON if the file extension is '.json', text otherwise)
+				void store_report(const std::string & filename_) const;
+
+				/// Reset the statistics of all threads (exact once the workers are joined or idle)
+				void reset();
+
+			private :
+
+				/// Constructor
+				registry();
+
+				/// Register the statistics of a new thread
+				thread_statistics & _register_thread_();
+
+				mutable std::mutex _mutex_;                                    //!< Protection of the thread list
+				std::vector<std::unique_ptr<thread_statistics> > _threads_;   //!< Per thread statistics
+				uint64_t _start_ticks_;                                        //!< Calibration start (ticks)
+				std::chrono::steady_clock::time_point _start_time_;            //!< Calibration start (time)
+
+			};
+
+			/// \brief Scoped timer of a stage
+			class scoped_timer
+			{
+			public :
+
+				/// Constructor : start the timer
+				explicit scoped_timer(stage_type stage_)
+					: _statistics_(registry::instance().grab_thread_statistics().stages[stage_])
+				{
+					_start_ticks_ = read_ticks();
+					return;
+				}
+
+				/// Destructor : record the duration
+				~scoped_timer()
+				{
+					_statistics_.add(read_ticks() - _start_ticks_);
+					return;
+				}
+
+				scoped_timer(const scoped_timer &) = delete;
+				scoped_timer & operator=(const scoped_timer &) = delete;
+
+			private :
+
+				stage_statistics & _statistics_; //!< Statistics of the timed stage
+				uint64_t _start_ticks_;          //!< Start of the timed scope
+
+			};
+
+			/// Add a value to a counter of the calling thread
+			inline void count(counter_type counter_, uint64_t value_)
+			{
+				add_value(registry::instance().grab_thread_statistics().counters[counter_], value_);
+				return;
+			}
+
+		} // end of namespace instrumentation
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_INSTRUMENTATION_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -59,29 +59,24 @@ namespace snemo {
 
 		template<unsigned int AddressSize, unsigned int DataSize>
 		void memory<AddressSize, DataSize>::fetch(const std::bitset<AddressSize> & address_bitset_,
-																							std::bitset<DataSize> & data_bitset_)
+																							std::bitset<DataSize> & data_bitset_) const
 		{
-			if (_memory_.find(address_bitset_) == _memory_.end())
-				{
-					data_bitset_ =  _default_data_;
-				}
-			else
-				{
-					data_bitset_ = _memory_[address_bitset_];
-				}
+			data_bitset_ = fetch(address_bitset_);
 			return;
 		}
 
 		template<unsigned int AddressSize, unsigned int DataSize>
-		const std::bitset<DataSize> & memory<AddressSize, DataSize>::fetch(const std::bitset<AddressSize> & address_bitset_)
+		const std::bitset<DataSize> & memory<AddressSize, DataSize>::fetch(const std::bitset<AddressSize> & address_bitset_) const
 		{
-			if (_memory_.find(address_bitset_) == _memory_.end())
+			// Read only lookup, the memory can be shared between threads :
+			typename memory_dict_type::const_iterator found = _memory_.find(address_bitset_);
+			if (found == _memory_.end())
 				{
 					return _default_data_;
 				}
 			else
 				{
-					return _memory_[address_bitset_];
+					return found->second;
 				}
 		}
 
@@ -48,10 +48,10 @@ namespace snemo {
 
 			/// Fetch the data bitset corresponding to an address bitset
 			void fetch(const std::bitset<AddressSize> & address_bitset_,
-								 std::bitset<DataSize> & data_bitset_);
+								 std::bitset<DataSize> & data_bitset_) const;
 
 			/// Return the data bitset corresponding to an address bitset
-			const std::bitset<DataSize> & fetch(const std::bitset<AddressSize> & address_bitset_);
+			const std::bitset<DataSize> & fetch(const std::bitset<AddressSize> & address_bitset_) const;
 
 			/// Display the key and value of the memory map
 			void memory_map_display();
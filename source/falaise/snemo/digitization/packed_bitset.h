@@ -0,0 +1,145 @@
+// snemo/digitization/packed_bitset.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_PACKED_BITSET_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_PACKED_BITSET_H
+
+// Standard library :
+#include <bitset>
+#include <vector>
+
+// Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+// - Bayeux/datatools :
+#include <datatools/exception.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+		/// \brief Sparse packing of a bitset in 64 bits words.
+		///
+		/// A bitset is stored as a mask of its non null words followed by the non null
+		/// words only (a single word when the bitset fits in 64 bits).
+		template <std::size_t Size>
+		struct packed_bitset
+		{
+			/// Number of 64 bits words needed to store the bitset
+			static const std::size_t NUMBER_OF_WORDS = (Size + 63) / 64;
+
+			static_assert(NUMBER_OF_WORDS <= 32, "Bitset is too large for a 32 bits words mask !");
+
+			/// Pack a bitset into a non null words mask and the non null words
+			static void pack(const std::bitset<Size> & bitset_,
+											 uint32_t & words_mask_,
+											 std::vector<uint64_t> & words_);
+
+			/// Unpack a non null words mask and the non null words into a bitset
+			static void unpack(uint32_t words_mask_,
+												 const std::vector<uint64_t> & words_,
+												 std::bitset<Size> & bitset_);
+
+			/// Serialize a bitset in its packed form
+			template <class Archive>
+			static void serialize(Archive & ar_,
+														const char * mask_name_,
+														const char * words_name_,
+														std::bitset<Size> & bitset_);
+		};
+
+		template <std::size_t Size>
+		const std::size_t packed_bitset<Size>::NUMBER_OF_WORDS;
+
+		template <std::size_t Size>
+		void packed_bitset<Size>::pack(const std::bitset<Size> & bitset_,
+																	 uint32_t & words_mask_,
+																	 std::vector<uint64_t> & words_)
+		{
+			static const std::bitset<Size> low_word_mask(~0ULL);
+			words_mask_ = 0;
+			words_.clear();
+			std::bitset<Size> remaining = bitset_;
+			for (std::size_t i = 0; i < NUMBER_OF_WORDS && remaining.any(); i++)
+				{
+					const uint64_t word = (remaining & low_word_mask).to_ullong();
+					if (word != 0)
+						{
+							words_mask_ |= (0x1u << i);
+							words_.push_back(word);
+						}
+					remaining >>= 64;
+				}
+			return;
+		}
+
+		template <std::size_t Size>
+		void packed_bitset<Size>::unpack(uint32_t words_mask_,
+																		 const std::vector<uint64_t> & words_,
+																		 std::bitset<Size> & bitset_)
+		{
+			bitset_.reset();
+			std::size_t word_index = words_.size();
+			for (std::size_t i = NUMBER_OF_WORDS; i-- > 0;)
+				{
+					bitset_ <<= 64;
+					if (words_mask_ & (0x1u << i))
+						{
+							DT_THROW_IF(word_index == 0, std::logic_error, "Missing words for the packed bitset mask " << words_mask_ << " ! ");
+							word_index--;
+							bitset_ |= std::bitset<Size>(static_cast<unsigned long long>(words_[word_index]));
+						}
+				}
+			return;
+		}
+
+		template <std::size_t Size>
+		template <class Archive>
+		void packed_bitset<Size>::serialize(Archive & ar_,
+																				const char * mask_name_,
+																				const char * words_name_,
+																				std::bitset<Size> & bitset_)
+		{
+			uint32_t words_mask = 0;
+			std::vector<uint64_t> words;
+			if (! Archive::is_loading::value)
+				{
+					pack(bitset_, words_mask, words);
+				}
+
+			if (NUMBER_OF_WORDS == 1)
+				{
+					uint64_t word = words.empty() ? 0 : words.front();
+					ar_ & boost::serialization::make_nvp(words_name_, word);
+					words_mask = (word != 0) ? 0x1 : 0x0;
+					words.assign(1, word);
+				}
+			else
+				{
+					ar_ & boost::serialization::make_nvp(mask_name_, words_mask);
+					ar_ & boost::serialization::make_nvp(words_name_, words);
+				}
+
+			if (Archive::is_loading::value)
+				{
+					unpack(words_mask, words, bitset_);
+				}
+			return;
+		}
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_PACKED_BITSET_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
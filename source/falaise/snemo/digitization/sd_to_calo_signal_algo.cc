@@ -7,6 +7,7 @@
 #include <datatools/clhep_units.h>
 // Ourselves:
 #include <snemo/digitization/sd_to_calo_signal_algo.h>
+#include <snemo/digitization/instrumentation.h>
 
 namespace snemo {
 
@@ -124,6 +125,7 @@ namespace snemo {
     int sd_to_calo_signal_algo::_process(const mctools::simulated_data & sd_,
 					 signal_data & signal_data)
     {
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_SD_TO_CALO_SIGNAL);
       DT_THROW_IF(!is_initialized(), std::logic_error, "SD to calo signal algorithm is not initialized ! ");
       int32_t calo_signal_hit_id = 0;
       std::string calo_type = "calo";
@@ -9,6 +9,7 @@
 #include <bayeux/geomtools/geom_id.h>
 // Ourselves:
 #include <snemo/digitization/sd_to_geiger_signal_algo.h>
+#include <snemo/digitization/instrumentation.h>
 
 namespace snemo {
 
@@ -100,6 +101,7 @@ namespace snemo {
     int sd_to_geiger_signal_algo::_process(const mctools::simulated_data & sd_,
 					   signal_data & signal_data)
     {
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_SD_TO_GEIGER_SIGNAL);
       DT_THROW_IF(!is_initialized(), std::logic_error, "SD to geiger signal algorithm is not initialized ! ");
       int error_code = EXIT_SUCCESS;
       datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
@@ -0,0 +1,313 @@
+// snemo/digitization/signal_archive.cc
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+// Ourselves:
+#include <snemo/digitization/signal_archive.h>
+
+// Standard library :
+#include <cstring>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project :
+#include <snemo/digitization/signal_data.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+    namespace {
+
+      std::size_t aligned_size(std::size_t size_)
+      {
+	const std::size_t alignment = signal_archive_format::ALIGNMENT;
+	return (size_ + alignment - 1) / alignment * alignment;
+      }
+
+      template <typename T>
+      void write_column(std::ofstream & file_, const std::vector<T> & column_, uint64_t & position_)
+      {
+	static const char padding[signal_archive_format::ALIGNMENT] = {0};
+	const std::size_t size = column_.size() * sizeof(T);
+	if (size > 0) file_.write(reinterpret_cast<const char *>(&column_[0]), size);
+	file_.write(padding, aligned_size(size) - size);
+	position_ += aligned_size(size);
+	return;
+      }
+
+      template <typename T>
+      void write_value(std::ofstream & file_, T value_, uint64_t & position_)
+      {
+	file_.write(reinterpret_cast<const char *>(&value_), sizeof(T));
+	position_ += sizeof(T);
+	return;
+      }
+
+      template <typename T>
+      T read_value(const char * data_)
+      {
+	T value;
+	std::memcpy(&value, data_, sizeof(T));
+	return value;
+      }
+
+    } // end of anonymous namespace
+
+    const std::size_t signal_archive_format::MAGIC_SIZE;
+    const uint32_t signal_archive_format::FORMAT_VERSION;
+    const std::size_t signal_archive_format::HEADER_SIZE;
+    const std::size_t signal_archive_format::TRAILER_SIZE;
+    const std::size_t signal_archive_format::ALIGNMENT;
+
+    const char * signal_archive_format::magic()
+    {
+      return "SNSIGARC";
+    }
+
+    std::size_t signal_archive_format::get_event_size(std::size_t number_of_geiger_signals_,
+						      std::size_t number_of_calo_signals_)
+    {
+      return 2 * sizeof(uint32_t)
+	+ aligned_size(number_of_geiger_signals_ * sizeof(int32_t))
+	+ number_of_geiger_signals_ * (sizeof(uint64_t) + sizeof(double))
+	+ aligned_size(number_of_calo_signals_ * sizeof(int32_t))
+	+ number_of_calo_signals_ * (sizeof(uint64_t) + 2 * sizeof(double));
+    }
+
+    signal_archive_event_view::signal_archive_event_view()
+    {
+      reset();
+      return;
+    }
+
+    void signal_archive_event_view::reset()
+    {
+      number_of_geiger_signals = 0;
+      geiger_hit_ids = 0;
+      geiger_packed_gids = 0;
+      geiger_anode_avalanche_times = 0;
+      number_of_calo_signals = 0;
+      calo_hit_ids = 0;
+      calo_packed_gids = 0;
+      calo_signal_times = 0;
+      calo_amplitudes = 0;
+      return;
+    }
+
+    signal_archive_writer::signal_archive_writer()
+    {
+      _position_ = 0;
+      return;
+    }
+
+    signal_archive_writer::~signal_archive_writer()
+    {
+      if (is_open()) close();
+      return;
+    }
+
+    void signal_archive_writer::open(const std::string & filename_)
+    {
+      DT_THROW_IF(is_open(), std::logic_error, "Writer is already open with file '" << _filename_ << "' ! ");
+      _file_.open(filename_.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      DT_THROW_IF(!_file_, std::runtime_error, "Cannot open file '" << filename_ << "' ! ");
+      _filename_ = filename_;
+      _position_ = 0;
+      _event_offsets_.clear();
+      _file_.write(signal_archive_format::magic(), signal_archive_format::MAGIC_SIZE);
+      _position_ += signal_archive_format::MAGIC_SIZE;
+      write_value<uint32_t>(_file_, signal_archive_format::FORMAT_VERSION, _position_);
+      write_value<uint32_t>(_file_, 0, _position_);
+      return;
+    }
+
+    bool signal_archive_writer::is_open() const
+    {
+      return _file_.is_open();
+    }
+
+    void signal_archive_writer::write(const signal_columns & signals_)
+    {
+      DT_THROW_IF(!is_open(), std::logic_error, "Writer is not open ! ");
+      _event_offsets_.push_back(_position_);
+      write_value<uint32_t>(_file_, signals_.get_number_of_geiger_signals(), _position_);
+      write_value<uint32_t>(_file_, signals_.get_number_of_calo_signals(), _position_);
+      write_column(_file_, signals_.get_geiger_hit_ids(), _position_);
+      write_column(_file_, signals_.get_geiger_packed_gids(), _position_);
+      write_column(_file_, signals_.get_geiger_anode_avalanche_times(), _position_);
+      write_column(_file_, signals_.get_calo_hit_ids(), _position_);
+      write_column(_file_, signals_.get_calo_packed_gids(), _position_);
+      write_column(_file_, signals_.get_calo_signal_times(), _position_);
+      write_column(_file_, signals_.get_calo_amplitudes(), _position_);
+      DT_THROW_IF(!_file_, std::runtime_error, "Write error on file '" << _filename_ << "' ! ");
+      return;
+    }
+
+    void signal_archive_writer::write(const signal_data & signals_)
+    {
+      _columns_buffer_.reset();
+      _columns_buffer_.import_signal_data(signals_);
+      write(_columns_buffer_);
+      return;
+    }
+
+    std::size_t signal_archive_writer::get_number_of_events() const
+    {
+      return _event_offsets_.size();
+    }
+
+    void signal_archive_writer::close()
+    {
+      DT_THROW_IF(!is_open(), std::logic_error, "Writer is not open ! ");
+      const uint64_t index_offset = _position_;
+      write_column(_file_, _event_offsets_, _position_);
+      write_value<uint64_t>(_file_, index_offset, _position_);
+      write_value<uint64_t>(_file_, _event_offsets_.size(), _position_);
+      _file_.write(signal_archive_format::magic(), signal_archive_format::MAGIC_SIZE);
+      DT_THROW_IF(!_file_, std::runtime_error, "Write error on file '" << _filename_ << "' ! ");
+      _file_.close();
+      _filename_.clear();
+      _position_ = 0;
+      _event_offsets_.clear();
+      _columns_buffer_.reset();
+      return;
+    }
+
+    signal_archive_reader::signal_archive_reader()
+    {
+      _index_offset_ = 0;
+      _number_of_events_ = 0;
+      return;
+    }
+
+    signal_archive_reader::~signal_archive_reader()
+    {
+      if (is_open()) close();
+      return;
+    }
+
+    void signal_archive_reader::open(const std::string & filename_)
+    {
+      DT_THROW_IF(is_open(), std::logic_error, "Reader is already open with file '" << _filename_ << "' ! ");
+      _file_.open(filename_);
+      DT_THROW_IF(!_file_.is_open(), std::runtime_error, "Cannot map file '" << filename_ << "' ! ");
+      const char * data = _file_.data();
+      const std::size_t size = _file_.size();
+      bool valid = size >= signal_archive_format::HEADER_SIZE + signal_archive_format::TRAILER_SIZE
+	&& std::memcmp(data, signal_archive_format::magic(), signal_archive_format::MAGIC_SIZE) == 0
+	&& read_value<uint32_t>(data + signal_archive_format::MAGIC_SIZE) == signal_archive_format::FORMAT_VERSION
+	&& std::memcmp(data + size - signal_archive_format::MAGIC_SIZE, signal_archive_format::magic(), signal_archive_format::MAGIC_SIZE) == 0;
+      if (valid)
+	{
+	  const char * trailer = data + size - signal_archive_format::TRAILER_SIZE;
+	  _index_offset_ = read_value<uint64_t>(trailer);
+	  _number_of_events_ = read_value<uint64_t>(trailer + sizeof(uint64_t));
+	  valid = _index_offset_ % signal_archive_format::ALIGNMENT == 0
+	    && _index_offset_ + _number_of_events_ * sizeof(uint64_t) + signal_archive_format::TRAILER_SIZE == size;
+	}
+      if (!valid)
+	{
+	  _file_.close();
+	  _index_offset_ = 0;
+	  _number_of_events_ = 0;
+	  DT_THROW_IF(true, std::logic_error, "File '" << filename_ << "' is not a supported signal archive ! ");
+	}
+      _filename_ = filename_;
+      return;
+    }
+
+    bool signal_archive_reader::is_open() const
+    {
+      return _file_.is_open();
+    }
+
+    void signal_archive_reader::close()
+    {
+      DT_THROW_IF(!is_open(), std::logic_error, "Reader is not open ! ");
+      _file_.close();
+      _filename_.clear();
+      _index_offset_ = 0;
+      _number_of_events_ = 0;
+      return;
+    }
+
+    std::size_t signal_archive_reader::get_number_of_events() const
+    {
+      return _number_of_events_;
+    }
+
+    void signal_archive_reader::get_event_view(std::size_t event_index_, signal_archive_event_view & view_) const
+    {
+      DT_THROW_IF(!is_open(), std::logic_error, "Reader is not open ! ");
+      DT_THROW_IF(event_index_ >= _number_of_events_, std::range_error, "Event #" << event_index_ << " is out of range [0;" << _number_of_events_ << "[ ! ");
+      const char * data = _file_.data();
+      const uint64_t offset = read_value<uint64_t>(data + _index_offset_ + event_index_ * sizeof(uint64_t));
+      DT_THROW_IF(offset < signal_archive_format::HEADER_SIZE || offset % signal_archive_format::ALIGNMENT != 0
+		  || offset + 2 * sizeof(uint32_t) > _index_offset_,
+		  std::logic_error, "Invalid offset for event #" << event_index_ << " in file '" << _filename_ << "' ! ");
+      const char * event = data + offset;
+      const std::size_t number_of_geiger_signals = read_value<uint32_t>(event);
+      const std::size_t number_of_calo_signals = read_value<uint32_t>(event + sizeof(uint32_t));
+      DT_THROW_IF(offset + signal_archive_format::get_event_size(number_of_geiger_signals, number_of_calo_signals) > _index_offset_,
+		  std::logic_error, "Truncated event #" << event_index_ << " in file '" << _filename_ << "' ! ");
+
+      // Columns are aligned in the mapped memory, they are pointed in place :
+      const char * column = event + 2 * sizeof(uint32_t);
+      view_.number_of_geiger_signals = number_of_geiger_signals;
+      view_.geiger_hit_ids = reinterpret_cast<const int32_t *>(column);
+      column += aligned_size(number_of_geiger_signals * sizeof(int32_t));
+      view_.geiger_packed_gids = reinterpret_cast<const uint64_t *>(column);
+      column += number_of_geiger_signals * sizeof(uint64_t);
+      view_.geiger_anode_avalanche_times = reinterpret_cast<const double *>(column);
+      column += number_of_geiger_signals * sizeof(double);
+      view_.number_of_calo_signals = number_of_calo_signals;
+      view_.calo_hit_ids = reinterpret_cast<const int32_t *>(column);
+      column += aligned_size(number_of_calo_signals * sizeof(int32_t));
+      view_.calo_packed_gids = reinterpret_cast<const uint64_t *>(column);
+      column += number_of_calo_signals * sizeof(uint64_t);
+      view_.calo_signal_times = reinterpret_cast<const double *>(column);
+      column += number_of_calo_signals * sizeof(double);
+      view_.calo_amplitudes = reinterpret_cast<const double *>(column);
+      return;
+    }
+
+    void signal_archive_reader::load(std::size_t event_index_, signal_columns & signals_) const
+    {
+      signal_archive_event_view view;
+      get_event_view(event_index_, view);
+      signals_.reset();
+      signals_.append_geiger_signals(view.number_of_geiger_signals,
+				     view.geiger_hit_ids,
+				     view.geiger_packed_gids,
+				     view.geiger_anode_avalanche_times);
+      signals_.append_calo_signals(view.number_of_calo_signals,
+				   view.calo_hit_ids,
+				   view.calo_packed_gids,
+				   view.calo_signal_times,
+				   view.calo_amplitudes);
+      return;
+    }
+
+    void signal_archive_reader::load(std::size_t event_index_, signal_data & signals_) const
+    {
+      signal_columns columns;
+      load(event_index_, columns);
+      signals_.reset();
+      columns.export_signal_data(signals_);
+      return;
+    }
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
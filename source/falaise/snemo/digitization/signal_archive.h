@@ -0,0 +1,175 @@
+// snemo/digitization/signal_archive.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_SIGNAL_ARCHIVE_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_SIGNAL_ARCHIVE_H
+
+// Standard library :
+#include <string>
+#include <vector>
+#include <fstream>
+
+// Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+// This project :
+#include <snemo/digitization/signal_columns.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+		class signal_data;
+
+		/// \brief Layout of the indexed signal archive files.
+		///
+		/// header   : magic (8 bytes), version (uint32), reserved (uint32)
+		/// events   : for each event, number of geiger and calo signals (2 x uint32)
+		///            followed by the signal columns (hit IDs, packed geom IDs, times,
+		///            amplitudes), each column starting on a 8 bytes boundary
+		/// index    : offset of each event (uint64)
+		/// trailer  : offset of the index (uint64), number of events (uint64), magic (8 bytes)
+		///
+		/// Values are stored in native (little endian) byte order so that a mapped
+		/// file can be read in place.
+		struct signal_archive_format
+		{
+			/// File magic word
+			static const char * magic();
+
+			/// Size of the file magic word
+			static const std::size_t MAGIC_SIZE = 8;
+
+			/// Version of the file format
+			static const uint32_t FORMAT_VERSION = 1;
+
+			/// Size of the file header
+			static const std::size_t HEADER_SIZE = 16;
+
+			/// Size of the file trailer
+			static const std::size_t TRAILER_SIZE = 24;
+
+			/// Alignment of the events and of their columns
+			static const std::size_t ALIGNMENT = 8;
+
+			/// Return the size of an event block
+			static std::size_t get_event_size(std::size_t number_of_geiger_signals_,
+																				std::size_t number_of_calo_signals_);
+		};
+
+		/// \brief Zero copy view on the signal columns of an archived event
+		struct signal_archive_event_view
+		{
+			signal_archive_event_view();
+			void reset();
+
+			std::size_t number_of_geiger_signals;
+			const int32_t  * geiger_hit_ids;
+			const uint64_t * geiger_packed_gids;
+			const double   * geiger_anode_avalanche_times;
+			std::size_t number_of_calo_signals;
+			const int32_t  * calo_hit_ids;
+			const uint64_t * calo_packed_gids;
+			const double   * calo_signal_times;
+			const double   * calo_amplitudes;
+		};
+
+		/// \brief Writer of indexed signal archives
+		class signal_archive_writer
+		{
+		public :
+
+			/// Default constructor
+			signal_archive_writer();
+
+			/// Destructor (close the file)
+			virtual ~signal_archive_writer();
+
+			/// Open a file
+			void open(const std::string & filename_);
+
+			/// Check if a file is open
+			bool is_open() const;
+
+			/// Write the signals of an event
+			void write(const signal_columns & signals_);
+
+			/// Write the signals of an event (auxiliaries are not kept)
+			void write(const signal_data & signals_);
+
+			/// Return the number of written events
+			std::size_t get_number_of_events() const;
+
+			/// Write the index and close the file
+			void close();
+
+		private :
+
+			std::string _filename_;             //!< Name of the current file
+			std::ofstream _file_;               //!< Output file
+			uint64_t _position_;                //!< Current position in the file
+			std::vector<uint64_t> _event_offsets_; //!< Offset of each written event
+			signal_columns _columns_buffer_;    //!< Working columns for write from a signal data
+
+		};
+
+		/// \brief Memory mapped random access reader of indexed signal archives
+		///
+		/// Once open, the reader is only read through const methods on the mapped
+		/// memory : it can be shared by threads working on disjoint event ranges.
+		class signal_archive_reader
+		{
+		public :
+
+			/// Default constructor
+			signal_archive_reader();
+
+			/// Destructor (close the file)
+			virtual ~signal_archive_reader();
+
+			/// Open and map a file
+			void open(const std::string & filename_);
+
+			/// Check if a file is open
+			bool is_open() const;
+
+			/// Unmap and close the file
+			void close();
+
+			/// Return the number of events
+			std::size_t get_number_of_events() const;
+
+			/// Get a zero copy view on the signals of an event (valid while the file is open)
+			void get_event_view(std::size_t event_index_, signal_archive_event_view & view_) const;
+
+			/// Load the signals of an event in signal columns
+			void load(std::size_t event_index_, signal_columns & signals_) const;
+
+			/// Load the signals of an event in a signal data (auxiliaries are left empty)
+			void load(std::size_t event_index_, signal_data & signals_) const;
+
+		private :
+
+			std::string _filename_;         //!< Name of the current file
+			boost::iostreams::mapped_file_source _file_; //!< Mapped input file
+			uint64_t _index_offset_;        //!< Offset of the event index
+			std::size_t _number_of_events_; //!< Number of events
+
+		};
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_SIGNAL_ARCHIVE_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,299 @@
+// snemo/digitization/signal_columns.cc
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+// Ourselves:
+#include <snemo/digitization/signal_columns.h>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/i_tree_dump.h>
+
+// This project :
+#include <snemo/digitization/signal_data.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+    namespace {
+      // Reserved packed address values for the special geom ID addresses :
+      const uint64_t PACKED_ANY_ADDRESS     = 0xFE;
+      const uint64_t PACKED_INVALID_ADDRESS = 0xFF;
+    }
+
+    const unsigned int signal_columns::PACKED_GID_MAX_DEPTH;
+    const uint32_t signal_columns::PACKED_GID_MAX_TYPE;
+    const uint32_t signal_columns::PACKED_GID_MAX_ADDRESS;
+
+    signal_columns::signal_columns()
+    {
+      return;
+    }
+
+    signal_columns::~signal_columns()
+    {
+      reset();
+      return;
+    }
+
+    uint64_t signal_columns::pack_gid(const geomtools::geom_id & gid_)
+    {
+      DT_THROW_IF(gid_.get_type() > PACKED_GID_MAX_TYPE, std::logic_error, "Geom ID type " << gid_.get_type() << " can't be packed ! ");
+      DT_THROW_IF(gid_.get_depth() > PACKED_GID_MAX_DEPTH, std::logic_error, "Geom ID depth " << gid_.get_depth() << " can't be packed ! ");
+      uint64_t packed = 0;
+      packed |= static_cast<uint64_t>(gid_.get_type()) << 48;
+      packed |= static_cast<uint64_t>(gid_.get_depth()) << 40;
+      for (unsigned int i = 0; i < gid_.get_depth(); i++)
+	{
+	  const uint32_t address = gid_.get(i);
+	  uint64_t packed_address = 0;
+	  if (address == geomtools::geom_id::ANY_ADDRESS) packed_address = PACKED_ANY_ADDRESS;
+	  else if (address == geomtools::geom_id::INVALID_ADDRESS) packed_address = PACKED_INVALID_ADDRESS;
+	  else
+	    {
+	      DT_THROW_IF(address > PACKED_GID_MAX_ADDRESS, std::logic_error, "Geom ID address " << address << " can't be packed ! ");
+	      packed_address = address;
+	    }
+	  packed |= packed_address << (8 * (PACKED_GID_MAX_DEPTH - 1 - i));
+	}
+      return packed;
+    }
+
+    void signal_columns::unpack_gid(uint64_t packed_gid_, geomtools::geom_id & gid_)
+    {
+      gid_.reset();
+      const unsigned int depth = (packed_gid_ >> 40) & 0xFF;
+      DT_THROW_IF(depth > PACKED_GID_MAX_DEPTH, std::logic_error, "Invalid packed geom ID depth " << depth << " ! ");
+      gid_.set_type((packed_gid_ >> 48) & 0xFFFF);
+      gid_.set_depth(depth);
+      for (unsigned int i = 0; i < depth; i++)
+	{
+	  const uint64_t packed_address = (packed_gid_ >> (8 * (PACKED_GID_MAX_DEPTH - 1 - i))) & 0xFF;
+	  if (packed_address == PACKED_ANY_ADDRESS) gid_.set_any(i);
+	  else if (packed_address == PACKED_INVALID_ADDRESS) gid_.set(i, geomtools::geom_id::INVALID_ADDRESS);
+	  else gid_.set(i, packed_address);
+	}
+      return;
+    }
+
+    void signal_columns::reserve_geiger_signals(std::size_t number_of_signals_)
+    {
+      _geiger_hit_ids_.reserve(number_of_signals_);
+      _geiger_packed_gids_.reserve(number_of_signals_);
+      _geiger_anode_avalanche_times_.reserve(number_of_signals_);
+      return;
+    }
+
+    void signal_columns::reserve_calo_signals(std::size_t number_of_signals_)
+    {
+      _calo_hit_ids_.reserve(number_of_signals_);
+      _calo_packed_gids_.reserve(number_of_signals_);
+      _calo_signal_times_.reserve(number_of_signals_);
+      _calo_amplitudes_.reserve(number_of_signals_);
+      return;
+    }
+
+    void signal_columns::add_geiger_signal(int32_t hit_id_,
+					   const geomtools::geom_id & gid_,
+					   double anode_avalanche_time_)
+    {
+      const uint64_t packed_gid = pack_gid(gid_);
+      _geiger_hit_ids_.push_back(hit_id_);
+      _geiger_packed_gids_.push_back(packed_gid);
+      _geiger_anode_avalanche_times_.push_back(anode_avalanche_time_);
+      return;
+    }
+
+    void signal_columns::add_calo_signal(int32_t hit_id_,
+					 const geomtools::geom_id & gid_,
+					 double signal_time_,
+					 double amplitude_)
+    {
+      const uint64_t packed_gid = pack_gid(gid_);
+      _calo_hit_ids_.push_back(hit_id_);
+      _calo_packed_gids_.push_back(packed_gid);
+      _calo_signal_times_.push_back(signal_time_);
+      _calo_amplitudes_.push_back(amplitude_);
+      return;
+    }
+
+    void signal_columns::append_geiger_signals(std::size_t number_of_signals_,
+					       const int32_t * hit_ids_,
+					       const uint64_t * packed_gids_,
+					       const double * anode_avalanche_times_)
+    {
+      if (number_of_signals_ == 0) return;
+      _geiger_hit_ids_.insert(_geiger_hit_ids_.end(), hit_ids_, hit_ids_ + number_of_signals_);
+      _geiger_packed_gids_.insert(_geiger_packed_gids_.end(), packed_gids_, packed_gids_ + number_of_signals_);
+      _geiger_anode_avalanche_times_.insert(_geiger_anode_avalanche_times_.end(), anode_avalanche_times_, anode_avalanche_times_ + number_of_signals_);
+      return;
+    }
+
+    void signal_columns::append_calo_signals(std::size_t number_of_signals_,
+					     const int32_t * hit_ids_,
+					     const uint64_t * packed_gids_,
+					     const double * signal_times_,
+					     const double * amplitudes_)
+    {
+      if (number_of_signals_ == 0) return;
+      _calo_hit_ids_.insert(_calo_hit_ids_.end(), hit_ids_, hit_ids_ + number_of_signals_);
+      _calo_packed_gids_.insert(_calo_packed_gids_.end(), packed_gids_, packed_gids_ + number_of_signals_);
+      _calo_signal_times_.insert(_calo_signal_times_.end(), signal_times_, signal_times_ + number_of_signals_);
+      _calo_amplitudes_.insert(_calo_amplitudes_.end(), amplitudes_, amplitudes_ + number_of_signals_);
+      return;
+    }
+
+    std::size_t signal_columns::get_number_of_geiger_signals() const
+    {
+      return _geiger_hit_ids_.size();
+    }
+
+    std::size_t signal_columns::get_number_of_calo_signals() const
+    {
+      return _calo_hit_ids_.size();
+    }
+
+    bool signal_columns::has_geiger_signals() const
+    {
+      return !_geiger_hit_ids_.empty();
+    }
+
+    bool signal_columns::has_calo_signals() const
+    {
+      return !_calo_hit_ids_.empty();
+    }
+
+    const std::vector<int32_t> & signal_columns::get_geiger_hit_ids() const
+    {
+      return _geiger_hit_ids_;
+    }
+
+    const std::vector<uint64_t> & signal_columns::get_geiger_packed_gids() const
+    {
+      return _geiger_packed_gids_;
+    }
+
+    const std::vector<double> & signal_columns::get_geiger_anode_avalanche_times() const
+    {
+      return _geiger_anode_avalanche_times_;
+    }
+
+    const std::vector<int32_t> & signal_columns::get_calo_hit_ids() const
+    {
+      return _calo_hit_ids_;
+    }
+
+    const std::vector<uint64_t> & signal_columns::get_calo_packed_gids() const
+    {
+      return _calo_packed_gids_;
+    }
+
+    const std::vector<double> & signal_columns::get_calo_signal_times() const
+    {
+      return _calo_signal_times_;
+    }
+
+    const std::vector<double> & signal_columns::get_calo_amplitudes() const
+    {
+      return _calo_amplitudes_;
+    }
+
+    void signal_columns::import_signal_data(const signal_data & signal_data_)
+    {
+      const signal_data::geiger_signal_collection_type & geiger_signals = signal_data_.get_geiger_signals();
+      reserve_geiger_signals(get_number_of_geiger_signals() + geiger_signals.size());
+      for (std::size_t i = 0; i < geiger_signals.size(); i++)
+	{
+	  const geiger_signal & a_geiger_signal = geiger_signals[i].get();
+	  add_geiger_signal(a_geiger_signal.get_hit_id(),
+			    a_geiger_signal.get_geom_id(),
+			    a_geiger_signal.get_anode_avalanche_time());
+	}
+
+      const signal_data::calo_signal_collection_type & calo_signals = signal_data_.get_calo_signals();
+      reserve_calo_signals(get_number_of_calo_signals() + calo_signals.size());
+      for (std::size_t i = 0; i < calo_signals.size(); i++)
+	{
+	  const calo_signal & a_calo_signal = calo_signals[i].get();
+	  add_calo_signal(a_calo_signal.get_hit_id(),
+			  a_calo_signal.get_geom_id(),
+			  a_calo_signal.get_signal_time(),
+			  a_calo_signal.get_amplitude());
+	}
+      return;
+    }
+
+    void signal_columns::export_signal_data(signal_data & signal_data_) const
+    {
+      geomtools::geom_id gid;
+      for (std::size_t i = 0; i < get_number_of_geiger_signals(); i++)
+	{
+	  unpack_gid(_geiger_packed_gids_[i], gid);
+	  geiger_signal & a_geiger_signal = signal_data_.add_geiger_signal();
+	  a_geiger_signal.set_header(_geiger_hit_ids_[i], gid);
+	  a_geiger_signal.set_data(_geiger_anode_avalanche_times_[i]);
+	}
+
+      for (std::size_t i = 0; i < get_number_of_calo_signals(); i++)
+	{
+	  unpack_gid(_calo_packed_gids_[i], gid);
+	  calo_signal & a_calo_signal = signal_data_.add_calo_signal();
+	  a_calo_signal.set_header(_calo_hit_ids_[i], gid);
+	  a_calo_signal.set_data(_calo_signal_times_[i], _calo_amplitudes_[i]);
+	}
+      return;
+    }
+
+    void signal_columns::reset_geiger_signals()
+    {
+      _geiger_hit_ids_.clear();
+      _geiger_packed_gids_.clear();
+      _geiger_anode_avalanche_times_.clear();
+      return;
+    }
+
+    void signal_columns::reset_calo_signals()
+    {
+      _calo_hit_ids_.clear();
+      _calo_packed_gids_.clear();
+      _calo_signal_times_.clear();
+      _calo_amplitudes_.clear();
+      return;
+    }
+
+    void signal_columns::reset()
+    {
+      reset_geiger_signals();
+      reset_calo_signals();
+      return;
+    }
+
+    void signal_columns::tree_dump(std::ostream & out_,
+				   const std::string & title_,
+				   const std::string & indent_,
+				   bool inherit_) const
+    {
+      out_ << indent_ << title_ << std::endl;
+
+      out_ << indent_ << datatools::i_tree_dumpable::tag
+	   << "Geiger signals : " << get_number_of_geiger_signals() << std::endl;
+
+      out_ << indent_ << datatools::i_tree_dumpable::inherit_tag(inherit_)
+	   << "Calo signals : " << get_number_of_calo_signals() << std::endl;
+
+      return;
+    }
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
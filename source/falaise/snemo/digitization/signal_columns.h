@@ -0,0 +1,164 @@
+// snemo/digitization/signal_columns.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_SIGNAL_COLUMNS_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_SIGNAL_COLUMNS_H
+
+// Standard library :
+#include <vector>
+#include <iostream>
+#include <string>
+
+// Third party:
+// - Bayeux/geomtools :
+#include <bayeux/geomtools/geom_id.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+		class signal_data;
+
+    /// \brief Event batched structure of arrays of signals (geiger and calorimeter).
+		///
+		/// Each signal attribute is stored in its own contiguous column, geometric IDs
+		/// are packed in a 64 bits word. The auxiliaries of the signals are not kept.
+		/// Adapters are provided from and to the handle based signal data.
+    class signal_columns
+    {
+    public :
+
+			/// Maximum depth of a packed geometric ID
+			static const unsigned int PACKED_GID_MAX_DEPTH = 5;
+
+			/// Maximum packable value of a geometric ID type
+			static const uint32_t PACKED_GID_MAX_TYPE = 0xFFFF;
+
+			/// Maximum packable value of a regular geometric ID address
+			static const uint32_t PACKED_GID_MAX_ADDRESS = 0xFD;
+
+      /// Default constructor
+      signal_columns();
+
+      /// Destructor
+      virtual ~signal_columns();
+
+			/// Pack a geometric ID in a 64 bits word (type 16 bits, depth 8 bits, 5 addresses of 8 bits)
+			static uint64_t pack_gid(const geomtools::geom_id & gid_);
+
+			/// Unpack a 64 bits word into a geometric ID
+			static void unpack_gid(uint64_t packed_gid_, geomtools::geom_id & gid_);
+
+			/// Reserve memory for a number of geiger signals
+			void reserve_geiger_signals(std::size_t number_of_signals_);
+
+			/// Reserve memory for a number of calorimeter signals
+			void reserve_calo_signals(std::size_t number_of_signals_);
+
+			/// Add a geiger signal at the end of the geiger columns
+			void add_geiger_signal(int32_t hit_id_,
+														 const geomtools::geom_id & gid_,
+														 double anode_avalanche_time_);
+
+			/// Add a calorimeter signal at the end of the calorimeter columns
+			void add_calo_signal(int32_t hit_id_,
+													 const geomtools::geom_id & gid_,
+													 double signal_time_,
+													 double amplitude_);
+
+			/// Append a block of geiger signals given as columns (packed geometric IDs)
+			void append_geiger_signals(std::size_t number_of_signals_,
+																 const int32_t * hit_ids_,
+																 const uint64_t * packed_gids_,
+																 const double * anode_avalanche_times_);
+
+			/// Append a block of calorimeter signals given as columns (packed geometric IDs)
+			void append_calo_signals(std::size_t number_of_signals_,
+															 const int32_t * hit_ids_,
+															 const uint64_t * packed_gids_,
+															 const double * signal_times_,
+															 const double * amplitudes_);
+
+			/// Return the number of geiger signals
+			std::size_t get_number_of_geiger_signals() const;
+
+			/// Return the number of calorimeter signals
+			std::size_t get_number_of_calo_signals() const;
+
+			/// Check if there are geiger signals
+			bool has_geiger_signals() const;
+
+			/// Check if there are calorimeter signals
+			bool has_calo_signals() const;
+
+			/// Return the column of geiger signal hit IDs
+			const std::vector<int32_t> & get_geiger_hit_ids() const;
+
+			/// Return the column of geiger signal packed geometric IDs
+			const std::vector<uint64_t> & get_geiger_packed_gids() const;
+
+			/// Return the column of geiger signal anode avalanche times
+			const std::vector<double> & get_geiger_anode_avalanche_times() const;
+
+			/// Return the column of calorimeter signal hit IDs
+			const std::vector<int32_t> & get_calo_hit_ids() const;
+
+			/// Return the column of calorimeter signal packed geometric IDs
+			const std::vector<uint64_t> & get_calo_packed_gids() const;
+
+			/// Return the column of calorimeter signal times
+			const std::vector<double> & get_calo_signal_times() const;
+
+			/// Return the column of calorimeter signal amplitudes
+			const std::vector<double> & get_calo_amplitudes() const;
+
+			/// Append all signals of a signal data
+			void import_signal_data(const signal_data & signal_data_);
+
+			/// Append all signals to a signal data (auxiliaries are left empty)
+			void export_signal_data(signal_data & signal_data_) const;
+
+			/// Reset the geiger columns
+			void reset_geiger_signals();
+
+			/// Reset the calorimeter columns
+			void reset_calo_signals();
+
+			/// Reset all columns (the memory is kept for the next event)
+      void reset();
+
+      /// Smart print
+      void tree_dump(std::ostream      & a_out    = std::clog,
+										 const std::string & a_title  = "",
+										 const std::string & a_indent = "",
+										 bool a_inherit               = false) const;
+
+    private :
+
+			// Geiger columns :
+			std::vector<int32_t>  _geiger_hit_ids_;                //!< Geiger signal hit IDs
+			std::vector<uint64_t> _geiger_packed_gids_;            //!< Geiger signal packed geometric IDs
+			std::vector<double>   _geiger_anode_avalanche_times_;  //!< Geiger signal anode avalanche times
+
+			// Calorimeter columns :
+			std::vector<int32_t>  _calo_hit_ids_;     //!< Calorimeter signal hit IDs
+			std::vector<uint64_t> _calo_packed_gids_; //!< Calorimeter signal packed geometric IDs
+			std::vector<double>   _calo_signal_times_; //!< Calorimeter signal times
+			std::vector<double>   _calo_amplitudes_;   //!< Calorimeter signal amplitudes
+
+    };
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif /* FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_SIGNAL_COLUMNS_H */
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -34,35 +34,27 @@ namespace snemo {
     void signal_data::reset_geiger_signals()
     {
       _geiger_signals_.clear();
+      _geiger_signals_pool_.recycle();
       return ;
     }
 
     void signal_data::reset_calo_signals()
     {
       _calo_signals_.clear();
+      _calo_signals_pool_.recycle();
       return ;
     }
 
 		geiger_signal & signal_data::add_geiger_signal()
     {
-      {
-				geiger_signal_handle_type dummy;
-				_geiger_signals_.push_back(dummy);
-      }
-      geiger_signal_handle_type & last = _geiger_signals_.back();
-      last.reset(new geiger_signal);
-      return last.grab();
+      _geiger_signals_.push_back(_geiger_signals_pool_.acquire());
+      return _geiger_signals_.back().grab();
     }
 
     calo_signal & signal_data::add_calo_signal()
     {
-      {
-				calo_signal_handle_type dummy;
-				_calo_signals_.push_back(dummy);
-      }
-      calo_signal_handle_type & last = _calo_signals_.back();
-      last.reset(new calo_signal);
-      return last.grab();
+      _calo_signals_.push_back(_calo_signals_pool_.acquire());
+      return _calo_signals_.back().grab();
     }
 
     const signal_data::geiger_signal_collection_type & signal_data::get_geiger_signals() const
@@ -19,6 +19,7 @@
 // This project :
 #include <snemo/digitization/geiger_signal.h>
 #include <snemo/digitization/calo_signal.h>
+#include <snemo/digitization/handle_pool.h>
 
 namespace snemo {
 
@@ -125,6 +126,8 @@ namespace snemo {
 
       geiger_signal_collection_type _geiger_signals_; //!< Collection of geigers tracker primitive
       calo_signal_collection_type _calo_signals_;     //!< Collection of calos tracker primitive
+      handle_pool<geiger_signal> _geiger_signals_pool_; //!< Pool of recycled geiger signals (not serialized)
+      handle_pool<calo_signal> _calo_signals_pool_;     //!< Pool of recycled calo signals (not serialized)
 
       DATATOOLS_SERIALIZATION_DECLARATION()
 
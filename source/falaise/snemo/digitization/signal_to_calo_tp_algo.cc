@@ -4,6 +4,7 @@
 
 // This project :
 #include <snemo/digitization/clock_utils.h>
+#include <snemo/digitization/instrumentation.h>
 
 // Ourselves:
 #include <snemo/digitization/signal_to_calo_tp_algo.h>
@@ -73,85 +74,131 @@ namespace snemo {
       return;
     }
 
+    void signal_to_calo_tp_algo::process(const signal_columns & signal_columns_,
+					 calo_tp_data & my_calo_tp_data_)
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "SD to calo TP algorithm is not initialized ! ");
+      _process(signal_columns_, my_calo_tp_data_);
+      return;
+    }
+
     void signal_to_calo_tp_algo::_process(const signal_data & signal_data_,
 					  calo_tp_data & my_calo_tp_data_)
     {
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_SIGNAL_TO_CALO_TP);
       DT_THROW_IF(!is_initialized(), std::logic_error, "SD to calo TP algorithm is not initialized ! ");
 
       std::size_t number_of_hits = signal_data_.get_calo_signals().size();
 
       for (std::size_t i = 0; i < number_of_hits; i++)
 	{
-	  const calo_signal & a_calo_signal  = signal_data_.get_calo_signals()[i].get();
-	  const geomtools::geom_id & geom_id = a_calo_signal.get_geom_id();
-	  const double calo_hit_amplitude    = a_calo_signal.get_amplitude();
+	  const calo_signal & a_calo_signal = signal_data_.get_calo_signals()[i].get();
+	  _process_calo_signal(a_calo_signal.get_hit_id(),
+			       a_calo_signal.get_geom_id(),
+			       a_calo_signal.get_signal_time(),
+			       a_calo_signal.get_amplitude(),
+			       my_calo_tp_data_);
+	}
+      return;
+    }
 
-	  if (calo_hit_amplitude >= calo_tp::LOW_THRESHOLD)
+    void signal_to_calo_tp_algo::_process(const signal_columns & signal_columns_,
+					  calo_tp_data & my_calo_tp_data_)
+    {
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_SIGNAL_TO_CALO_TP);
+      DT_THROW_IF(!is_initialized(), std::logic_error, "SD to calo TP algorithm is not initialized ! ");
+
+      const std::vector<int32_t> & hit_ids      = signal_columns_.get_calo_hit_ids();
+      const std::vector<uint64_t> & packed_gids = signal_columns_.get_calo_packed_gids();
+      const std::vector<double> & signal_times  = signal_columns_.get_calo_signal_times();
+      const std::vector<double> & amplitudes    = signal_columns_.get_calo_amplitudes();
+      geomtools::geom_id geom_id;
+
+      for (std::size_t i = 0; i < signal_columns_.get_number_of_calo_signals(); i++)
+	{
+	  // Skip under threshold signals before unpacking their geom ID :
+	  if (amplitudes[i] < calo_tp::LOW_THRESHOLD) continue;
+	  signal_columns::unpack_gid(packed_gids[i], geom_id);
+	  _process_calo_signal(hit_ids[i],
+			       geom_id,
+			       signal_times[i],
+			       amplitudes[i],
+			       my_calo_tp_data_);
+	}
+      return;
+    }
+
+    void signal_to_calo_tp_algo::_process_calo_signal(int32_t hit_id_,
+						      const geomtools::geom_id & geom_id_,
+						      double signal_time_,
+						      double amplitude_,
+						      calo_tp_data & my_calo_tp_data_)
+    {
+      const double calo_hit_amplitude = amplitude_;
+
+      if (calo_hit_amplitude >= calo_tp::LOW_THRESHOLD)
+	{
+	  geomtools::geom_id temporary_electronic_id;
+	  _electronic_mapping_->convert_GID_to_EID(mapping::THREE_WIRES_TRACKER_MODE,
+						   geom_id_,
+						   temporary_electronic_id);
+	  uint32_t electronic_type = temporary_electronic_id.get_type();
+	  geomtools::geom_id electronic_id;
+	  electronic_id.set_depth(mapping::BOARD_DEPTH);
+	  electronic_id.set_type(electronic_type);
+	  temporary_electronic_id.extract_to(electronic_id);
+
+	  // These bits have to be checked
+	  bool calo_xt_bit    = 0;
+	  bool calo_spare_bit = 0;
+
+	  bool existing = false;
+	  unsigned int existing_index = 0;
+
+	  uint32_t a_calo_signal_clocktick = _clocktick_ref_ + clock_utils::CALO_FEB_SHIFT_CLOCKTICK_NUMBER;
+
+	  // Compute calo signal CT25
+	  if (signal_time_ > 25) // nanseconds
 	    {
-	      geomtools::geom_id temporary_electronic_id;
-	      _electronic_mapping_->convert_GID_to_EID(mapping::THREE_WIRES_TRACKER_MODE,
-						       geom_id,
-						       temporary_electronic_id);
-	      uint32_t electronic_type = temporary_electronic_id.get_type();
-	      geomtools::geom_id electronic_id;
-	      electronic_id.set_depth(mapping::BOARD_DEPTH);
-	      electronic_id.set_type(electronic_type);
-	      temporary_electronic_id.extract_to(electronic_id);
-
-	      // These bits have to be checked
-	      bool calo_xt_bit    = 0;
-	      bool calo_spare_bit = 0;
-
-	      bool existing = false;
-	      unsigned int existing_index = 0;
-
-	      uint32_t a_calo_signal_clocktick = _clocktick_ref_ + clock_utils::CALO_FEB_SHIFT_CLOCKTICK_NUMBER;
-
-	      // Compute calo signal CT25
-	      if (a_calo_signal.get_signal_time() > 25) // nanseconds
-		{
-		  a_calo_signal_clocktick += static_cast<uint32_t>(a_calo_signal.get_signal_time()) / 25;
-		}
+	      a_calo_signal_clocktick += static_cast<uint32_t>(clock_utils::time_to_clocktick(signal_time_, clock_utils::MAIN_CLOCKTICK));
+	    }
 
-	      for (unsigned int j = 0; j < my_calo_tp_data_.get_calo_tps().size(); j++)
-	      	{
-	      	  if (my_calo_tp_data_.get_calo_tps()[j].get().get_geom_id() == electronic_id
-	      	      && my_calo_tp_data_.get_calo_tps()[j].get().get_clocktick_25ns() == a_calo_signal_clocktick )
-	      	    {
-	      	      existing = true;
-	      	      existing_index = j;
-	      	    }
-	      	}
-
-	      if (existing == false)
+	  for (unsigned int j = 0; j < my_calo_tp_data_.get_calo_tps().size(); j++)
+	    {
+	      if (my_calo_tp_data_.get_calo_tps()[j].get().get_geom_id() == electronic_id
+		  && my_calo_tp_data_.get_calo_tps()[j].get().get_clocktick_25ns() == a_calo_signal_clocktick )
 		{
-		  // Create new calo TP
-		  snemo::digitization::calo_tp & calo_tp = my_calo_tp_data_.add();
-		  calo_tp.set_header(a_calo_signal.get_hit_id(),
-				     electronic_id,
-				     a_calo_signal_clocktick);
-		  calo_tp.set_data(calo_hit_amplitude,
-				   calo_xt_bit,
-				   calo_spare_bit);
-		  // calo_tp.tree_dump(std::clog, "Calo TP first creation : ", "INFO : ");
+		  existing = true;
+		  existing_index = j;
 		}
+	    }
 
-	      else
-		{
-		  // Update existing calo TP
-		  snemo::digitization::calo_tp & existing_calo_tp = my_calo_tp_data_.grab_calo_tps()[existing_index].grab();
-		  existing_calo_tp.update_data(calo_hit_amplitude,
-					       calo_xt_bit,
-					       calo_spare_bit);
-		  // existing_calo_tp.tree_dump(std::clog, "Calo TP Update : ", "INFO : ");
-		}
+	  if (existing == false)
+	    {
+	      // Create new calo TP
+	      snemo::digitization::calo_tp & calo_tp = my_calo_tp_data_.add();
+	      calo_tp.set_header(hit_id_,
+				 electronic_id,
+				 a_calo_signal_clocktick);
+	      calo_tp.set_data(calo_hit_amplitude,
+			       calo_xt_bit,
+			       calo_spare_bit);
+	      // calo_tp.tree_dump(std::clog, "Calo TP first creation : ", "INFO : ");
+	    }
+
+	  else
+	    {
+	      // Update existing calo TP
+	      snemo::digitization::calo_tp & existing_calo_tp = my_calo_tp_data_.grab_calo_tps()[existing_index].grab();
+	      existing_calo_tp.update_data(calo_hit_amplitude,
+					   calo_xt_bit,
+					   calo_spare_bit);
+	      // existing_calo_tp.tree_dump(std::clog, "Calo TP Update : ", "INFO : ");
 	    }
 	}
       return;
     }
 
-
-
   } // end of namespace digitization
 
 } // end of namespace snemo
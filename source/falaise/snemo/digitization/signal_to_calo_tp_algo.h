@@ -19,6 +19,7 @@
 // This project :
 #include <snemo/digitization/calo_tp_data.h>
 #include <snemo/digitization/signal_data.h>
+#include <snemo/digitization/signal_columns.h>
 #include <snemo/digitization/electronic_mapping.h>
 #include <snemo/digitization/clock_utils.h>
 
@@ -56,6 +57,10 @@ namespace snemo {
 			void process(const signal_data & signal_data_,
 									 calo_tp_data & my_calo_tp_data_);
 
+      /// Process to fill a calo tp data object from columnar signals
+			void process(const signal_columns & signal_columns_,
+									 calo_tp_data & my_calo_tp_data_);
+
     protected:
       
 			// unsigned int _existing_same_electronic_id(const geomtools::geom_id & electronic_id_,
@@ -65,6 +70,17 @@ namespace snemo {
 			void _process(const signal_data & signal_data_,
 										calo_tp_data & my_calo_tp_data_);
 
+			///  Process to fill a calo tp data object from columnar signals
+			void _process(const signal_columns & signal_columns_,
+										calo_tp_data & my_calo_tp_data_);
+
+			/// Create or update the calo tp of one calorimeter signal
+			void _process_calo_signal(int32_t hit_id_,
+																const geomtools::geom_id & geom_id_,
+																double signal_time_,
+																double amplitude_,
+																calo_tp_data & my_calo_tp_data_);
+
     private :
       
       bool _initialized_; //!< Initialization flag
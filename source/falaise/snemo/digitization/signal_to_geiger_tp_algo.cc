@@ -7,6 +7,7 @@
 
 // This project :
 #include <snemo/digitization/clock_utils.h>
+#include <snemo/digitization/instrumentation.h>
 
 // Ourselves:
 #include <snemo/digitization/signal_to_geiger_tp_algo.h>
@@ -23,23 +24,50 @@ namespace snemo {
 
     void signal_to_geiger_tp_algo::signal_to_tp_working_data::reset()
     {
-      signal_ref = 0;
-      feb_id.reset();
+      signal_index  = 0;
+      packed_eid    = 0;
       clocktick_800 = clock_utils::INVALID_CLOCKTICK;
-      shift_800     = clock_utils::INVALID_CLOCKTICK; 
     }
 
     bool signal_to_geiger_tp_algo::signal_to_tp_working_data::operator<(const signal_to_tp_working_data & other_) const
     {
       return this-> clocktick_800 < other_.clocktick_800;
     }
-    
+
+    uint32_t signal_to_geiger_tp_algo::signal_to_tp_working_data::pack_eid(const geomtools::geom_id & electronic_id_)
+    {
+      uint32_t packed = 0;
+      packed |= (electronic_id_.get(mapping::RACK_INDEX)    & 0xFF) << 24;
+      packed |= (electronic_id_.get(mapping::CRATE_INDEX)   & 0xFF) << 16;
+      packed |= (electronic_id_.get(mapping::BOARD_INDEX)   & 0xFF) << 8;
+      packed |= (electronic_id_.get(mapping::CHANNEL_INDEX) & 0xFF);
+      return packed;
+    }
+
+    void signal_to_geiger_tp_algo::signal_to_tp_working_data::unpack_eid(uint32_t packed_eid_, geomtools::geom_id & electronic_id_)
+    {
+      electronic_id_.reset();
+      electronic_id_.set_type(mapping::FEB_CATEGORY_TYPE);
+      electronic_id_.set_depth(mapping::CHANNEL_DEPTH);
+      electronic_id_.set(mapping::RACK_INDEX,    (packed_eid_ >> 24) & 0xFF);
+      electronic_id_.set(mapping::CRATE_INDEX,   (packed_eid_ >> 16) & 0xFF);
+      electronic_id_.set(mapping::BOARD_INDEX,   (packed_eid_ >> 8)  & 0xFF);
+      electronic_id_.set(mapping::CHANNEL_INDEX, packed_eid_ & 0xFF);
+      return;
+    }
+
+    uint32_t signal_to_geiger_tp_algo::signal_to_tp_working_data::get_channel() const
+    {
+      return packed_eid & 0xFF;
+    }
+
     signal_to_geiger_tp_algo::signal_to_geiger_tp_algo()
     {
       _initialized_   = false;
       _electronic_mapping_  = 0;
       _clocktick_ref_ = clock_utils::INVALID_CLOCKTICK;
       datatools::invalidate(_clocktick_shift_);
+      _propagate_auxiliaries_ = false;
       return;
     }
 
@@ -53,9 +81,23 @@ namespace snemo {
     }
 
     void signal_to_geiger_tp_algo::initialize(electronic_mapping & my_electronic_mapping_)
+    {
+      datatools::properties dummy_config;
+      initialize(my_electronic_mapping_, dummy_config);
+      return;
+    }
+
+    void signal_to_geiger_tp_algo::initialize(electronic_mapping & my_electronic_mapping_,
+					      const datatools::properties & config_)
     {
       DT_THROW_IF(is_initialized(), std::logic_error, "SD to geiger tp algorithm is already initialized ! ");
       _electronic_mapping_ = & my_electronic_mapping_;
+
+      if (config_.has_key("propagate_auxiliaries")) {
+	bool propagate_auxiliaries = config_.fetch_boolean("propagate_auxiliaries");
+	set_propagate_auxiliaries(propagate_auxiliaries);
+      }
+
       for (unsigned int i = 0; i < geiger::tp::TP_SIZE; i++)
 	{
 	  _activated_bits_[i] = 0;
@@ -75,6 +117,7 @@ namespace snemo {
       _initialized_ = false;
       _electronic_mapping_ = 0;
       _clocktick_ref_ = clock_utils::INVALID_CLOCKTICK;
+      _propagate_auxiliaries_ = false;
       return;
     }
 
@@ -90,25 +133,57 @@ namespace snemo {
       return;
     }
 
-    void signal_to_geiger_tp_algo::add_geiger_tp(const signal_to_tp_working_data & my_wd_data_,
+    void signal_to_geiger_tp_algo::set_propagate_auxiliaries(bool propagate_auxiliaries_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "SD to geiger tp algorithm is already initialized, auxiliaries propagation can't be set ! ");
+      _propagate_auxiliaries_ = propagate_auxiliaries_;
+      return;
+    }
+
+    bool signal_to_geiger_tp_algo::is_propagate_auxiliaries() const
+    {
+      return _propagate_auxiliaries_;
+    }
+
+    void signal_to_geiger_tp_algo::add_geiger_tp(const signal_data & signal_data_,
+						 const signal_to_tp_working_data & my_wd_data_,
 						 uint32_t signal_clocktick_,
 						 int32_t hit_id_,
 						 geiger_tp_data & my_geiger_tp_data_)
+    {
+      _add_geiger_tp(&signal_data_.get_geiger_signals()[my_wd_data_.signal_index].get().get_auxiliaries(),
+		     my_wd_data_,
+		     signal_clocktick_,
+		     hit_id_,
+		     my_geiger_tp_data_);
+      return;
+    }
+
+    void signal_to_geiger_tp_algo::_add_geiger_tp(const datatools::properties * auxiliaries_,
+						  const signal_to_tp_working_data & my_wd_data_,
+						  uint32_t signal_clocktick_,
+						  int32_t hit_id_,
+						  geiger_tp_data & my_geiger_tp_data_)
     {
       snemo::digitization::geiger_tp & gg_tp = my_geiger_tp_data_.add();
+      geomtools::geom_id electronic_id;
+      signal_to_tp_working_data::unpack_eid(my_wd_data_.packed_eid, electronic_id);
       geomtools::geom_id temporary_feb_id;
-      temporary_feb_id.set_type(my_wd_data_.feb_id.get_type());
+      temporary_feb_id.set_type(electronic_id.get_type());
       temporary_feb_id.set_depth(mapping::BOARD_DEPTH);
-      my_wd_data_.feb_id.extract_to(temporary_feb_id);
+      electronic_id.extract_to(temporary_feb_id);
       gg_tp.set_header(hit_id_,
 		       temporary_feb_id,
 		       signal_clocktick_,
 		       mapping::THREE_WIRES_TRACKER_MODE,
 		       mapping::SIDE_MODE,
 		       mapping::NUMBER_OF_CONNECTED_ROWS);
-      gg_tp.set_gg_tp_active_bit(my_wd_data_.feb_id.get(mapping::CHANNEL_INDEX));
-      gg_tp.set_auxiliaries(my_wd_data_.auxiliaries);
-      _activated_bits_[my_wd_data_.feb_id.get(mapping::CHANNEL_INDEX)] = 1;
+      gg_tp.set_gg_tp_active_bit(my_wd_data_.get_channel());
+      if (_propagate_auxiliaries_ && auxiliaries_ != 0)
+	{
+	  gg_tp.set_auxiliaries(*auxiliaries_);
+	}
+      _activated_bits_[my_wd_data_.get_channel()] = 1;
       // gg_tp.tree_dump(std::clog, "***** Geiger TP creation : *****", "INFO : "); 
 
       return;
@@ -117,8 +192,8 @@ namespace snemo {
     void signal_to_geiger_tp_algo::update_gg_tp(const signal_to_tp_working_data & my_wd_data_,
 						geiger_tp & my_geiger_tp_)
     {
-      my_geiger_tp_.set_gg_tp_active_bit(my_wd_data_.feb_id.get(mapping::CHANNEL_INDEX));
-      _activated_bits_[my_wd_data_.feb_id.get(mapping::CHANNEL_INDEX)] = 1;
+      my_geiger_tp_.set_gg_tp_active_bit(my_wd_data_.get_channel());
+      _activated_bits_[my_wd_data_.get_channel()] = 1;
       // my_geiger_tp_.tree_dump(std::clog, "***** Geiger TP Update : *****", "INFO : ");
       return;
     }
@@ -127,7 +202,8 @@ namespace snemo {
 							 working_data_collection_type & wd_collection_)
     {
       DT_THROW_IF(!is_initialized(), std::logic_error, "SD to geiger TP algorithm is not initialized ! ");
-      std::size_t number_of_hits = signal_data_.get_geiger_signals().size();      
+      std::size_t number_of_hits = signal_data_.get_geiger_signals().size();
+      wd_collection_.reserve(wd_collection_.size() + number_of_hits);
       double first_geiger_time_reference = signal_data_.get_geiger_signals()[0].get().get_anode_avalanche_time();
       
       for (std::size_t i = 0; i < number_of_hits; i++)
@@ -139,47 +215,86 @@ namespace snemo {
 	}
       
       for (std::size_t i = 0; i < number_of_hits; i++)
-	{	 	    
-	  const geiger_signal & a_geiger_signal    = signal_data_.get_geiger_signals()[i].get();
-	  const geomtools::geom_id & geom_id       = a_geiger_signal.get_geom_id();
-	  const datatools::properties & properties = a_geiger_signal.get_auxiliaries();
-	  geomtools::geom_id electronic_id;
+	{
+	  const geiger_signal & a_geiger_signal = signal_data_.get_geiger_signals()[i].get();
+	  signal_to_tp_working_data a_working_data;
+	  _make_working_data(i,
+			     a_geiger_signal.get_geom_id(),
+			     a_geiger_signal.get_anode_avalanche_time(),
+			     first_geiger_time_reference,
+			     a_working_data);
+	  wd_collection_.push_back(a_working_data);
+	}
 
-	  _electronic_mapping_->convert_GID_to_EID(mapping::THREE_WIRES_TRACKER_MODE, geom_id, electronic_id);
+      return ;
+    }
 
-	  double relative_time = a_geiger_signal.get_anode_avalanche_time() - first_geiger_time_reference ;
-	  uint32_t a_geiger_signal_clocktick = std::floor(first_geiger_time_reference/800) +  _clocktick_ref_ + clock_utils::TRACKER_FEB_SHIFT_CLOCKTICK_NUMBER;
-	  
-	  if (relative_time > 800)
-	    {
-	      a_geiger_signal_clocktick += static_cast<int32_t>(relative_time) / 800;
-	    }
-	  
+    void signal_to_geiger_tp_algo::_prepare_working_data(const signal_columns & signal_columns_,
+							 working_data_collection_type & wd_collection_)
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "SD to geiger TP algorithm is not initialized ! ");
+      const std::vector<uint64_t> & packed_gids = signal_columns_.get_geiger_packed_gids();
+      const std::vector<double> & anode_times   = signal_columns_.get_geiger_anode_avalanche_times();
+      std::size_t number_of_hits = signal_columns_.get_number_of_geiger_signals();
+      wd_collection_.reserve(wd_collection_.size() + number_of_hits);
+      const double first_geiger_time_reference = *std::min_element(anode_times.begin(), anode_times.end());
+
+      geomtools::geom_id geom_id;
+      for (std::size_t i = 0; i < number_of_hits; i++)
+	{
+	  signal_columns::unpack_gid(packed_gids[i], geom_id);
 	  signal_to_tp_working_data a_working_data;
-	  a_working_data.signal_ref    = & a_geiger_signal;
-	  a_working_data.feb_id        = electronic_id;
-	  a_working_data.auxiliaries   = properties;
-	  a_working_data.clocktick_800 = a_geiger_signal_clocktick;	      
-	  wd_collection_.push_back(a_working_data);	
+	  _make_working_data(i,
+			     geom_id,
+			     anode_times[i],
+			     first_geiger_time_reference,
+			     a_working_data);
+	  wd_collection_.push_back(a_working_data);
 	}
 
       return ;
     }
 
+    void signal_to_geiger_tp_algo::_make_working_data(uint32_t signal_index_,
+						      const geomtools::geom_id & geom_id_,
+						      double anode_avalanche_time_,
+						      double first_geiger_time_reference_,
+						      signal_to_tp_working_data & a_working_data_)
+    {
+      geomtools::geom_id electronic_id;
+      _electronic_mapping_->convert_GID_to_EID(mapping::THREE_WIRES_TRACKER_MODE, geom_id_, electronic_id);
+
+      double relative_time = anode_avalanche_time_ - first_geiger_time_reference_;
+      uint32_t a_geiger_signal_clocktick = clock_utils::time_to_clocktick(first_geiger_time_reference_, clock_utils::TRACKER_CLOCKTICK) +  _clocktick_ref_ + clock_utils::TRACKER_FEB_SHIFT_CLOCKTICK_NUMBER;
+
+      if (relative_time > 800)
+	{
+	  a_geiger_signal_clocktick += clock_utils::time_to_clocktick(relative_time, clock_utils::TRACKER_CLOCKTICK);
+	}
+
+      a_working_data_.signal_index  = signal_index_;
+      a_working_data_.packed_eid    = signal_to_tp_working_data::pack_eid(electronic_id);
+      a_working_data_.clocktick_800 = a_geiger_signal_clocktick;
+      return;
+    }
+
     void signal_to_geiger_tp_algo::_sort_working_data(working_data_collection_type & wd_collection_)
     {
       std::sort(wd_collection_.begin(), wd_collection_.end());
       return;
     }
 
-    void signal_to_geiger_tp_algo::_geiger_tp_process(const working_data_collection_type & wd_collection_,
+    void signal_to_geiger_tp_algo::_geiger_tp_process(const signal_data * signal_data_,
+						      const working_data_collection_type & wd_collection_,
 						      geiger_tp_data & my_geiger_tp_data_)
     {
       DT_THROW_IF(!is_initialized(), std::logic_error, "SD to geiger TP algorithm is not initialized ! ");
       int32_t geiger_tp_hit_id = 0;
+      geomtools::geom_id electronic_id;
       for (unsigned int i = 0; i < wd_collection_.size(); i++)
 	{
-	  uint32_t signal_clocktick  = wd_collection_[i].clocktick_800;	    
+	  uint32_t signal_clocktick  = wd_collection_[i].clocktick_800;
+	  signal_to_tp_working_data::unpack_eid(wd_collection_[i].packed_eid, electronic_id);
 	  int existing_index = -1;
 	  bool existing_eid  = false;
 	  
@@ -188,7 +303,7 @@ namespace snemo {
 	      bool existing_ct = false;
 	      std::vector<datatools::handle<geiger_tp> > my_list_of_gg_tp_per_eid;
 
-	      my_geiger_tp_data_.get_list_of_gg_tp_per_eid(wd_collection_[i].feb_id , my_list_of_gg_tp_per_eid);
+	      my_geiger_tp_data_.get_list_of_gg_tp_per_eid(electronic_id, my_list_of_gg_tp_per_eid);
 
 	      if (my_list_of_gg_tp_per_eid.empty())
 		{
@@ -218,10 +333,16 @@ namespace snemo {
 	      // Eid is not existing or clocktick is different, geiger TP first creation
 	      else
 		{
-		  add_geiger_tp(wd_collection_[i],
-				signal_clocktick,
-				geiger_tp_hit_id, 
-				my_geiger_tp_data_);
+		  const datatools::properties * auxiliaries = 0;
+		  if (signal_data_ != 0)
+		    {
+		      auxiliaries = &signal_data_->get_geiger_signals()[wd_collection_[i].signal_index].get().get_auxiliaries();
+		    }
+		  _add_geiger_tp(auxiliaries,
+				 wd_collection_[i],
+				 signal_clocktick,
+				 geiger_tp_hit_id,
+				 my_geiger_tp_data_);
 		}
 	      signal_clocktick++;
 	    } // end of for (j < 10)
@@ -242,11 +363,25 @@ namespace snemo {
     void signal_to_geiger_tp_algo::_process(const signal_data & signal_data_,
 					    geiger_tp_data & my_geiger_tp_data_)
     {
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_SIGNAL_TO_GEIGER_TP);
       DT_THROW_IF(!is_initialized(), std::logic_error, "SD to geiger TP algorithm is not initialized ! ");
       working_data_collection_type my_wd_collection;
       _prepare_working_data(signal_data_, my_wd_collection);
       _sort_working_data(my_wd_collection);
-      _geiger_tp_process(my_wd_collection, my_geiger_tp_data_);
+      _geiger_tp_process(&signal_data_, my_wd_collection, my_geiger_tp_data_);
+      return;
+    }
+
+    void signal_to_geiger_tp_algo::process(const signal_columns & signal_columns_,
+					   geiger_tp_data & my_geiger_tp_data_)
+    {
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_SIGNAL_TO_GEIGER_TP);
+      DT_THROW_IF(!is_initialized(), std::logic_error, "SD to geiger TP algorithm is not initialized ! ");
+      if (!signal_columns_.has_geiger_signals()) return;
+      working_data_collection_type my_wd_collection;
+      _prepare_working_data(signal_columns_, my_wd_collection);
+      _sort_working_data(my_wd_collection);
+      _geiger_tp_process(0, my_wd_collection, my_geiger_tp_data_);
       return;
     }
 
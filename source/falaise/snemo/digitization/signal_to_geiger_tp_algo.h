@@ -12,6 +12,7 @@
 // Third party:
 // - Bayeux/datatools :
 #include <datatools/logger.h>
+#include <datatools/properties.h>
 // - Bayeux/mctools:
 #include <mctools/simulated_data.h>
 // - Bayeux/geomtools:
@@ -20,6 +21,7 @@
 // This project :
 #include <snemo/digitization/geiger_tp_data.h>
 #include <snemo/digitization/signal_data.h>
+#include <snemo/digitization/signal_columns.h>
 #include <snemo/digitization/electronic_mapping.h>
 #include <snemo/digitization/mapping.h>
 #include <snemo/digitization/geiger_tp_constants.h>
@@ -33,19 +35,27 @@ namespace snemo {
     {
     public :
 			
+			/// \brief Compact working record (the auxiliaries stay in the signal, reached through its index)
 			class signal_to_tp_working_data
 			{
 			public:
         signal_to_tp_working_data();
 				void reset();
  				bool operator<(const signal_to_tp_working_data &) const;
-     
-				const geiger_signal * signal_ref;
-				geomtools::geom_id    feb_id;
-				datatools::properties auxiliaries;
-				uint32_t              clocktick_800;
-				double                shift_800;
-			}; 
+
+				/// Pack a FEB electronic ID (rack, crate, board, channel) into a 32 bits word (8 bits per address)
+				static uint32_t pack_eid(const geomtools::geom_id & electronic_id_);
+
+				/// Unpack a 32 bits word into a FEB electronic ID at channel depth
+				static void unpack_eid(uint32_t packed_eid_, geomtools::geom_id & electronic_id_);
+
+				/// Return the channel of the packed electronic ID
+				uint32_t get_channel() const;
+
+				uint32_t signal_index;  //!< Index of the geiger signal in the signal data
+				uint32_t packed_eid;    //!< Packed electronic ID of the cell
+				uint32_t clocktick_800; //!< Clocktick 800 ns of the signal
+			};
 			
 			typedef std::vector<signal_to_tp_working_data> working_data_collection_type;
 			
@@ -58,6 +68,10 @@ namespace snemo {
       /// Initializing
       void initialize(electronic_mapping & my_electronic_mapping_);
 
+      /// Initializing with a set of properties
+      void initialize(electronic_mapping & my_electronic_mapping_,
+											const datatools::properties & config_);
+
       /// Check if the algorithm is initialized 
       bool is_initialized() const;
 
@@ -70,8 +84,15 @@ namespace snemo {
       /// Set the clocktick shift
       void set_clocktick_shift(double clocktick_shift_);
 
+			/// Set the propagation of signal auxiliaries into the geiger TPs
+			void set_propagate_auxiliaries(bool propagate_auxiliaries_);
+
+			/// Check if signal auxiliaries are propagated into the geiger TPs
+			bool is_propagate_auxiliaries() const;
+
 			/// Add a geiger tp from a working data
-			void add_geiger_tp(const signal_to_tp_working_data & my_wd_data_,
+			void add_geiger_tp(const signal_data & signal_data_,
+												 const signal_to_tp_working_data & my_wd_data_,
 												 uint32_t signal_clocktick_,
 												 int32_t hit_id_,
 												 geiger_tp_data & my_geiger_tp_data_);
@@ -84,17 +105,40 @@ namespace snemo {
       void process(const signal_data & signal_data_,
 									 geiger_tp_data & my_geiger_tp_data_);
 
+      /// Process to fill a geiger tp data object from columnar signals (no auxiliaries propagation)
+      void process(const signal_columns & signal_columns_,
+									 geiger_tp_data & my_geiger_tp_data_);
+
     protected: 
 
+			/// Build the working data of one geiger signal
+			void _make_working_data(uint32_t signal_index_,
+															const geomtools::geom_id & geom_id_,
+															double anode_avalanche_time_,
+															double first_geiger_time_reference_,
+															signal_to_tp_working_data & a_working_data_);
+
 			/// Prepare the working data collection (sort by clocktick)
 			void _prepare_working_data(const signal_data & signal_data_,
 																 working_data_collection_type & wd_collection_);
 
+			/// Prepare the working data collection from columnar signals
+			void _prepare_working_data(const signal_columns & signal_columns_,
+																 working_data_collection_type & wd_collection_);
+
+			/// Add a geiger tp from a working data with optional auxiliaries
+			void _add_geiger_tp(const datatools::properties * auxiliaries_,
+													const signal_to_tp_working_data & my_wd_data_,
+													uint32_t signal_clocktick_,
+													int32_t hit_id_,
+													geiger_tp_data & my_geiger_tp_data_);
+
 			/// Sort working data by clocktick
 			void _sort_working_data(working_data_collection_type & wd_collection_);
 
 			/// Create geiger tp from working data collection
-			void _geiger_tp_process(const working_data_collection_type & wd_collection_,
+			void _geiger_tp_process(const signal_data * signal_data_,
+															const working_data_collection_type & wd_collection_,
 															geiger_tp_data & my_geiger_tp_data_);
 
       ///  Process to fill a geiger tp data object from signal data
@@ -107,6 +151,7 @@ namespace snemo {
       bool    _initialized_;     //!< Initialization flag
       uint32_t _clocktick_ref_;   //!< Clocktick reference of the algorithm
       double  _clocktick_shift_; //!< Clocktick shift between [0:800]
+      bool    _propagate_auxiliaries_; //!< Flag to copy signal auxiliaries into the geiger TPs (disabled by default)
 			electronic_mapping * _electronic_mapping_; //!< Convert geometric ID into electronic ID
 
 			// Data :
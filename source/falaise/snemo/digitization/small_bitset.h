@@ -0,0 +1,327 @@
+// snemo/digitization/small_bitset.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_SMALL_BITSET_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_SMALL_BITSET_H
+
+// Standard library :
+#include <bitset>
+#include <string>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+// - Boost:
+#include <boost/cstdint.hpp>
+
+namespace snemo {
+
+  namespace digitization {
+
+		/// \brief Smallest unsigned word holding a number of bits
+		template <std::size_t Size>
+		struct small_bitset_word
+		{
+			typedef typename std::conditional<(Size <= 8), uint8_t,
+																				typename std::conditional<(Size <= 16), uint16_t,
+																																	typename std::conditional<(Size <= 32), uint32_t, uint64_t>::type>::type>::type type;
+		};
+
+		/// \brief Fixed size bitset stored in the smallest unsigned word
+		///
+		/// Same interface as the part of std::bitset used by the trigger
+		/// structures (bits access, set, reset, test, any, count, to_ulong, bitwise
+		/// operators and stream output) and converting to and from std::bitset, but
+		/// stored in a single small word : a 7 bits tracker zone data uses one
+		/// byte and a 10 bits zoning word two bytes, instead of the 8 bytes of a
+		/// std::bitset. It is trivially copyable.
+		template <std::size_t Size>
+		class small_bitset
+		{
+		public :
+
+			typedef typename small_bitset_word<Size>::type word_type;
+
+			static_assert(Size > 0 && Size <= 64, "Small bitset size must be in [1;64] !");
+
+			/// Mask of the bits of the bitset in its word
+			static const word_type MASK = (word_type) (Size == 8 * sizeof(word_type) ? ~(word_type) 0 : (((word_type) 1 << (Size % (8 * sizeof(word_type)))) - 1));
+
+			/// \brief Reference to a bit of a small bitset
+			class reference
+			{
+			public :
+
+				reference(small_bitset & bitset_, std::size_t pos_) : _bitset_(bitset_), _pos_(pos_) {}
+
+				reference & operator=(bool value_)
+				{
+					_bitset_._set_bit(_pos_, value_);
+					return *this;
+				}
+
+				reference & operator=(const reference & other_)
+				{
+					_bitset_._set_bit(_pos_, (bool) other_);
+					return *this;
+				}
+
+				operator bool() const
+				{
+					return _bitset_._get_bit(_pos_);
+				}
+
+				bool operator~() const
+				{
+					return !_bitset_._get_bit(_pos_);
+				}
+
+				reference & flip()
+				{
+					_bitset_._set_bit(_pos_, !_bitset_._get_bit(_pos_));
+					return *this;
+				}
+
+			private :
+
+				small_bitset & _bitset_; //!< Referenced bitset
+				std::size_t _pos_;       //!< Position of the referenced bit
+
+			};
+
+			/// Default constructor, all bits reset
+			small_bitset() : _word_(0) {}
+
+			/// Constructor from an integer value (bits above Size are dropped)
+			small_bitset(unsigned long long value_) : _word_((word_type) value_ & MASK) {}
+
+			/// Constructor from a std::bitset
+			small_bitset(const std::bitset<Size> & bitset_) : _word_((word_type) bitset_.to_ullong()) {}
+
+			/// Conversion to a std::bitset
+			operator std::bitset<Size>() const
+			{
+				return std::bitset<Size>((unsigned long long) _word_);
+			}
+
+			/// Return the word holding the bits
+			word_type get_word() const
+			{
+				return _word_;
+			}
+
+			/// Return the number of bits
+			static std::size_t size()
+			{
+				return Size;
+			}
+
+			bool operator[](std::size_t pos_) const
+			{
+				return _get_bit(pos_);
+			}
+
+			reference operator[](std::size_t pos_)
+			{
+				return reference(*this, pos_);
+			}
+
+			bool test(std::size_t pos_) const
+			{
+				_check_position(pos_);
+				return _get_bit(pos_);
+			}
+
+			small_bitset & set()
+			{
+				_word_ = MASK;
+				return *this;
+			}
+
+			small_bitset & set(std::size_t pos_, bool value_ = true)
+			{
+				_check_position(pos_);
+				_set_bit(pos_, value_);
+				return *this;
+			}
+
+			small_bitset & reset()
+			{
+				_word_ = 0;
+				return *this;
+			}
+
+			small_bitset & reset(std::size_t pos_)
+			{
+				_check_position(pos_);
+				_set_bit(pos_, false);
+				return *this;
+			}
+
+			small_bitset & flip()
+			{
+				_word_ = ~_word_ & MASK;
+				return *this;
+			}
+
+			small_bitset & flip(std::size_t pos_)
+			{
+				_check_position(pos_);
+				_set_bit(pos_, !_get_bit(pos_));
+				return *this;
+			}
+
+			bool any() const
+			{
+				return _word_ != 0;
+			}
+
+			bool none() const
+			{
+				return _word_ == 0;
+			}
+
+			bool all() const
+			{
+				return _word_ == MASK;
+			}
+
+			std::size_t count() const
+			{
+				return std::bitset<8 * sizeof(word_type)>((unsigned long long) _word_).count();
+			}
+
+			unsigned long to_ulong() const
+			{
+				return _word_;
+			}
+
+			unsigned long long to_ullong() const
+			{
+				return _word_;
+			}
+
+			std::string to_string() const
+			{
+				return std::bitset<Size>((unsigned long long) _word_).to_string();
+			}
+
+			bool operator==(const small_bitset & other_) const
+			{
+				return _word_ == other_._word_;
+			}
+
+			bool operator!=(const small_bitset & other_) const
+			{
+				return _word_ != other_._word_;
+			}
+
+			small_bitset & operator&=(const small_bitset & other_)
+			{
+				_word_ &= other_._word_;
+				return *this;
+			}
+
+			small_bitset & operator|=(const small_bitset & other_)
+			{
+				_word_ |= other_._word_;
+				return *this;
+			}
+
+			small_bitset & operator^=(const small_bitset & other_)
+			{
+				_word_ ^= other_._word_;
+				return *this;
+			}
+
+			small_bitset & operator<<=(std::size_t shift_)
+			{
+				_word_ = shift_ < Size ? (word_type) (_word_ << shift_) & MASK : 0;
+				return *this;
+			}
+
+			small_bitset & operator>>=(std::size_t shift_)
+			{
+				_word_ = shift_ < Size ? _word_ >> shift_ : 0;
+				return *this;
+			}
+
+			small_bitset operator~() const
+			{
+				return small_bitset(*this).flip();
+			}
+
+			small_bitset operator&(const small_bitset & other_) const
+			{
+				return small_bitset(*this) &= other_;
+			}
+
+			small_bitset operator|(const small_bitset & other_) const
+			{
+				return small_bitset(*this) |= other_;
+			}
+
+			small_bitset operator^(const small_bitset & other_) const
+			{
+				return small_bitset(*this) ^= other_;
+			}
+
+			small_bitset operator<<(std::size_t shift_) const
+			{
+				return small_bitset(*this) <<= shift_;
+			}
+
+			small_bitset operator>>(std::size_t shift_) const
+			{
+				return small_bitset(*this) >>= shift_;
+			}
+
+			/// Print the bits, most significant bit first as a std::bitset
+			friend std::ostream & operator<<(std::ostream & out_, const small_bitset & bitset_)
+			{
+				return out_ << bitset_.to_string();
+			}
+
+		private :
+
+			bool _get_bit(std::size_t pos_) const
+			{
+				return (_word_ >> pos_) & 1;
+			}
+
+			void _set_bit(std::size_t pos_, bool value_)
+			{
+				if (value_) _word_ |= (word_type) ((word_type) 1 << pos_);
+				else _word_ &= (word_type) ~((word_type) 1 << pos_);
+				return;
+			}
+
+			static void _check_position(std::size_t pos_)
+			{
+				if (pos_ >= Size) throw std::out_of_range("small_bitset : bit position is out of range ! ");
+				return;
+			}
+
+		private :
+
+			word_type _word_; //!< Bits of the bitset, bit 0 is the least significant bit
+
+		};
+
+		template <std::size_t Size>
+		const typename small_bitset<Size>::word_type small_bitset<Size>::MASK;
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_SMALL_BITSET_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
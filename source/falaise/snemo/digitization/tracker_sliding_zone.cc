@@ -9,6 +9,7 @@
 
 // Ourselves:
 #include <falaise/snemo/digitization/tracker_sliding_zone.h>
+#include <falaise/snemo/digitization/instrumentation.h>
 
 namespace snemo {
 
@@ -103,7 +104,7 @@ namespace snemo {
       return;
     }
 
-    void tracker_sliding_zone::build_pattern(tracker_trigger_mem_maker::mem1_type & mem1_, tracker_trigger_mem_maker::mem2_type & mem2_)
+    void tracker_sliding_zone::build_pattern(const tracker_trigger_mem_maker::mem1_type & mem1_, const tracker_trigger_mem_maker::mem2_type & mem2_)
     {
       // Pattern data :
       // layer proj :[ 1 0 ]   |  row proj [ 1 0 ] for a sliding zone
@@ -124,6 +125,7 @@ namespace snemo {
       tracker_trigger_mem_maker::mem2_type::data_type hdata;
       mem2_.fetch(haddress, hdata);
       data_LR_proj = hdata;
+      FLDIGI_INSTRUMENT_COUNT(COUNTER_LUT_FETCHES, 2);
       return;
     }
 
@@ -60,7 +60,7 @@ namespace snemo {
 
       void compute_lr_proj();
       
-      void build_pattern(tracker_trigger_mem_maker::mem1_type & mem1_, tracker_trigger_mem_maker::mem2_type & mem2_);
+      void build_pattern(const tracker_trigger_mem_maker::mem1_type & mem1_, const tracker_trigger_mem_maker::mem2_type & mem2_);
 
       static void print_layout(std::ostream & out_);
 
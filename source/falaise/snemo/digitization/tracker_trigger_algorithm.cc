@@ -5,6 +5,7 @@
 // Standard library :
 #include <vector>
 #include <fstream>
+#include <algorithm>
 
 // Boost :
 #include <boost/dynamic_bitset.hpp>
@@ -17,6 +18,7 @@
 #include <snemo/digitization/geiger_tp_constants.h>
 #include <snemo/digitization/memory.h>
 #include <snemo/digitization/mapping.h>
+#include <snemo/digitization/instrumentation.h>
 
 namespace snemo {
 
@@ -26,6 +28,12 @@ namespace snemo {
     {
       _initialized_ = false;
       _electronic_mapping_ = 0;
+      std::fill(_packed_matrix_, _packed_matrix_ + PACKED_MATRIX_SIZE, 0);
+      std::fill(_sliding_zones_io_, _sliding_zones_io_ + trigger_info::NSIDES, 0);
+      std::fill(_sliding_zones_lr_, _sliding_zones_lr_ + trigger_info::NSIDES, 0);
+      _cache_size_ = DEFAULT_CACHE_SIZE;
+      _cache_hits_ = 0;
+      _cache_misses_ = 0;
       return;
     }
 
@@ -45,42 +53,97 @@ namespace snemo {
       return;
     }
 
-    void tracker_trigger_algorithm::fill_mem1_all(const std::string & filename_)
+    void tracker_trigger_algorithm::set_firmware(const std::shared_ptr<const trigger_firmware> & firmware_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Tracker trigger algorithm is already initialized, trigger firmware can't be set ! ");
+      DT_THROW_IF(!firmware_ || !firmware_->is_initialized(), std::logic_error, "Trigger firmware is not initialized ! ");
+      _firmware_ = firmware_;
+      _own_firmware_.reset();
+      return;
+    }
+
+    bool tracker_trigger_algorithm::has_firmware() const
+    {
+      return _firmware_ != nullptr;
+    }
+
+    const std::shared_ptr<const trigger_firmware> & tracker_trigger_algorithm::get_firmware() const
+    {
+      return _firmware_;
+    }
+
+    trigger_firmware & tracker_trigger_algorithm::_grab_own_firmware()
     {
       DT_THROW_IF(is_initialized(), std::logic_error, "Tracker trigger algorithm is already initialized ! ");
-      _sliding_zone_vertical_memory_.load_from_file(filename_);
+      DT_THROW_IF(has_firmware(), std::logic_error, "Tracker trigger algorithm uses a shared trigger firmware, its memories can't be filled ! ");
+      if (!_own_firmware_) _own_firmware_.reset(new trigger_firmware);
+      return *_own_firmware_;
+    }
+
+    void tracker_trigger_algorithm::fill_mem1_all(const std::string & filename_)
+    {
+      _grab_own_firmware().load_mem1(filename_);
       return;
     }
 
     void tracker_trigger_algorithm::fill_mem2_all(const std::string & filename_)
     {
-      DT_THROW_IF(is_initialized(), std::logic_error, "Tracker trigger algorithm is already initialized ! ");
-      _sliding_zone_horizontal_memory_.load_from_file(filename_);
+      _grab_own_firmware().load_mem2(filename_);
       return;
     }
 
     void tracker_trigger_algorithm::fill_mem3_all(const std::string & filename_)
     {
-      DT_THROW_IF(is_initialized(), std::logic_error, "Tracker trigger algorithm is already initialized ! ");
-      _zone_vertical_memory_.load_from_file(filename_);
+      _grab_own_firmware().load_mem3(filename_);
       return;
     }
 
     void tracker_trigger_algorithm::fill_mem4_all(const std::string & filename_)
     {
-      DT_THROW_IF(is_initialized(), std::logic_error, "Tracker trigger algorithm is already initialized ! ");
-      _zone_horizontal_memory_.load_from_file(filename_);
+      _grab_own_firmware().load_mem4(filename_);
       return;
     }
 
     void tracker_trigger_algorithm::fill_mem5_all(const std::string & filename_)
     {
-      DT_THROW_IF(is_initialized(), std::logic_error, "Tracker trigger algorithm is already initialized ! ");
-      _zone_vertical_for_horizontal_memory_.load_from_file(filename_);
+      _grab_own_firmware().load_mem5(filename_);
       return;
     }
 
 
+    void tracker_trigger_algorithm::set_cache_size(unsigned int cache_size_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Tracker trigger algorithm is already initialized, cache size can't be set ! ");
+      _cache_size_ = cache_size_;
+      return;
+    }
+
+    unsigned int tracker_trigger_algorithm::get_cache_size() const
+    {
+      return _cache_size_;
+    }
+
+    std::size_t tracker_trigger_algorithm::get_cache_hits() const
+    {
+      return _cache_hits_;
+    }
+
+    std::size_t tracker_trigger_algorithm::get_cache_misses() const
+    {
+      return _cache_misses_;
+    }
+
+    void tracker_trigger_algorithm::clear_cache()
+    {
+      for (std::size_t i = 0; i < _cache_.size(); i++)
+	{
+	  _cache_[i].valid = false;
+	}
+      _cache_hits_ = 0;
+      _cache_misses_ = 0;
+      return;
+    }
+
     void tracker_trigger_algorithm::initialize()
     {
       datatools::properties dummy_config;
@@ -93,35 +156,22 @@ namespace snemo {
       DT_THROW_IF(is_initialized(), std::logic_error, "Tracker trigger algorithm is already initialized ! ");
       DT_THROW_IF(_electronic_mapping_ == 0, std::logic_error, "Missing electronic mapping ! " );
 
-      if (config_.has_key("mem1_file")) {
-	std::string mem1_filename = config_.fetch_string("mem1_file");
-	datatools::fetch_path_with_env(mem1_filename);
-	fill_mem1_all(mem1_filename);
-      }
-
-      if (config_.has_key("mem2_file")) {
-	std::string mem2_filename = config_.fetch_string("mem2_file");
-	datatools::fetch_path_with_env(mem2_filename);
-	fill_mem2_all(mem2_filename);
+      // The memory files are loaded in a firmware image of the algorithm when no image is shared :
+      if (!has_firmware()) {
+	trigger_firmware & own_firmware = _grab_own_firmware();
+	own_firmware.set_electronic_mapping(*_electronic_mapping_);
+	own_firmware.initialize(config_);
+	_firmware_ = _own_firmware_;
+	_own_firmware_.reset();
       }
 
-      if (config_.has_key("mem3_file")) {
-	std::string mem3_filename = config_.fetch_string("mem3_file");
-	datatools::fetch_path_with_env(mem3_filename);
-	fill_mem3_all(mem3_filename);
-      }
-
-      if (config_.has_key("mem4_file")) {
-	std::string mem4_filename = config_.fetch_string("mem4_file");
-	datatools::fetch_path_with_env(mem4_filename);
-	fill_mem4_all(mem4_filename);
-      }
-
-      if (config_.has_key("mem5_file")) {
-	std::string mem5_filename = config_.fetch_string("mem5_file");
-	datatools::fetch_path_with_env(mem5_filename);
-	fill_mem5_all(mem5_filename);
+      if (config_.has_key("tracker_record_cache_size")) {
+	int cache_size = config_.fetch_integer("tracker_record_cache_size");
+	DT_THROW_IF(cache_size < 0, std::domain_error, "Invalid negative tracker record cache size !");
+	set_cache_size((unsigned int) cache_size);
       }
+      _cache_.assign(_cache_size_, cache_entry());
+      clear_cache();
 
       _initialized_ = true;
       return;
@@ -137,7 +187,14 @@ namespace snemo {
       DT_THROW_IF(!is_initialized(), std::logic_error, "Tracker trigger algorithm is not initialized, it can't be reset ! ");
       _initialized_ = false;
       _electronic_mapping_ = 0;
+      _firmware_.reset();
+      _own_firmware_.reset();
       _a_geiger_matrix_for_a_clocktick_.reset();
+      std::fill(_packed_matrix_, _packed_matrix_ + PACKED_MATRIX_SIZE, 0);
+      _cache_.clear();
+      _cache_size_ = DEFAULT_CACHE_SIZE;
+      _cache_hits_ = 0;
+      _cache_misses_ = 0;
       return;
     }
 
@@ -208,10 +265,19 @@ namespace snemo {
 	  unsigned int layer = hit_cells_gids_[i].get(mapping::LAYER_INDEX);
 	  unsigned int row   = hit_cells_gids_[i].get(mapping::ROW_INDEX);
 	  _a_geiger_matrix_for_a_clocktick_.matrix[side][layer][row] = 1;
+	  const unsigned int cell_index = trigger_firmware::cell_index(side, layer, row);
+	  _packed_matrix_[cell_index / 64] |= (uint64_t) 1 << (cell_index % 64);
 	}
       return;
     }
 
+    void tracker_trigger_algorithm::reset_matrix()
+    {
+      _a_geiger_matrix_for_a_clocktick_.reset();
+      std::fill(_packed_matrix_, _packed_matrix_ + PACKED_MATRIX_SIZE, 0);
+      return;
+    }
+
     const trigger_structures::geiger_matrix tracker_trigger_algorithm::get_geiger_matrix_for_a_clocktick() const
     {
       return _a_geiger_matrix_for_a_clocktick_;
@@ -229,6 +295,8 @@ namespace snemo {
 	    {
 	      _zones_[iside][izone].reset();
 	    }
+	  _sliding_zones_io_[iside] = 0;
+	  _sliding_zones_lr_[iside] = 0;
 	}
       return;
     }
@@ -252,14 +320,19 @@ namespace snemo {
       return;
     }
 
-    void tracker_trigger_algorithm::build_sliding_zones(tracker_trigger_mem_maker::mem1_type & mem1_,
-								  tracker_trigger_mem_maker::mem2_type & mem2_)
+    void tracker_trigger_algorithm::build_sliding_zones(const tracker_trigger_mem_maker::mem1_type & mem1_,
+								  const tracker_trigger_mem_maker::mem2_type & mem2_)
     {
       for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++) {
+	_sliding_zones_io_[iside] = 0;
+	_sliding_zones_lr_[iside] = 0;
 	for (unsigned int iszone = 0; iszone < trigger_info::NSLZONES; iszone ++) {
 	  build_sliding_zone(iside, iszone);
 	  _sliding_zones_[iside][iszone].build_pattern(mem1_, mem2_);
 	  //_sliding_zones_[iside][iszone].print(std::clog);
+	  const unsigned int shift = trigger_info::SLZONE_DATA_IO_PROJ * (trigger_info::NSLZONES - 1 - iszone);
+	  _sliding_zones_io_[iside] |= (uint64_t) _sliding_zones_[iside][iszone].data_IO_proj.to_ulong() << shift;
+	  _sliding_zones_lr_[iside] |= (uint64_t) _sliding_zones_[iside][iszone].data_LR_proj.to_ulong() << shift;
 	}
       }
       return;
@@ -285,22 +358,35 @@ namespace snemo {
     }
 
     void tracker_trigger_algorithm::build_zones()
+    {
+      build_zone_patterns();
+      build_near_source_patterns();
+      return;
+    }
+
+    void tracker_trigger_algorithm::build_zone_patterns()
     {
       for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
 	{
 	  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
 	    {
-	      build_zone(iside, izone);
-	      build_in_out_pattern(_zones_[iside][izone], _zone_vertical_memory_);
-	      build_left_mid_right_pattern(_zones_[iside][izone], _zone_horizontal_memory_, _zone_vertical_for_horizontal_memory_);
-	      build_near_source_pattern(_zones_[iside][izone]);
+	      // Projections of the sliding zones A, B, C and D of the zone, in the address order D0 D1 C0 C1 B0 B1 A0 A1 :
+	      const unsigned int shift = trigger_info::SLZONE_DATA_IO_PROJ * (trigger_info::NSLZONES - 4 - 3 * izone);
+	      const unsigned int lr_address = (_sliding_zones_lr_[iside] >> shift) & 0xFF;
+	      unsigned int io_address = (_sliding_zones_io_[iside] >> shift) & 0xFF;
+	      // The vertical address uses the sliding zone C in place of the sliding zone D (see build_in_out_pattern) :
+	      io_address = (io_address & 0xFC) | ((io_address >> 2) & 0x3);
+	      const uint8_t zone_pattern = _firmware_->get_zone_pattern(io_address, (lr_address >> 1) & 0x3F);
+	      _zones_[iside][izone].data_in_out_pattern = zone_pattern & 0x3;
+	      _zones_[iside][izone].data_left_mid_right_pattern = zone_pattern >> trigger_info::DATA_IO_PATTERN_SIZE;
 	    }
 	}
+      FLDIGI_INSTRUMENT_COUNT(COUNTER_LUT_FETCHES, trigger_info::NSIDES * trigger_info::NZONES);
       return;
     }
 
     void tracker_trigger_algorithm::build_in_out_pattern(tracker_zone & zone_,
-								   tracker_trigger_mem_maker::mem3_type & mem3_)
+								   const tracker_trigger_mem_maker::mem3_type & mem3_)
     {
       unsigned int side = zone_.side;
       unsigned int zone_id = zone_.zone_id;
@@ -322,13 +408,14 @@ namespace snemo {
       if (SZA_IO.test(1)) ZONE_ADDR_IO.set(7, true);
 
       mem3_.fetch(ZONE_ADDR_IO, zone_.data_in_out_pattern);
+      FLDIGI_INSTRUMENT_COUNT(COUNTER_LUT_FETCHES, 1);
 
       return;
     }
 
     void tracker_trigger_algorithm::build_left_mid_right_pattern(tracker_zone & zone_,
-									   tracker_trigger_mem_maker::mem4_type & mem4_,
-									   tracker_trigger_mem_maker::mem5_type & mem5_)
+									   const tracker_trigger_mem_maker::mem4_type & mem4_,
+									   const tracker_trigger_mem_maker::mem5_type & mem5_)
     {
       unsigned int side = zone_.side;
       unsigned int zone_id = zone_.zone_id;
@@ -358,6 +445,7 @@ namespace snemo {
       if (ZONE_ADDR_LR_REDUCTED != 0)
 	{
 	  mem4_.fetch(ZONE_ADDR_LR_REDUCTED, zone_.data_left_mid_right_pattern);
+	  FLDIGI_INSTRUMENT_COUNT(COUNTER_LUT_FETCHES, 1);
 	}
 
       else
@@ -379,6 +467,7 @@ namespace snemo {
 	  ZONE_ADDR_IO[7] = SZA_IO[1];
 
 	  mem5_.fetch(ZONE_ADDR_IO, zone_.data_left_mid_right_pattern);
+	  FLDIGI_INSTRUMENT_COUNT(COUNTER_LUT_FETCHES, 1);
 	}
       return;
     }
@@ -423,6 +512,38 @@ namespace snemo {
       return;
     }
 
+    void tracker_trigger_algorithm::build_near_source_patterns()
+    {
+      for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	{
+	  // Rows of the side with at least one hit cell in the near source layers :
+	  uint64_t near_source_rows[tracker_zone::ROWS_MASK_SIZE] = {0};
+	  for (unsigned int ilayer = 0; ilayer < trigger_info::NUMBER_OF_LAYERS_HIT_FOR_NEAR_SOURCE_BIT; ilayer++)
+	    {
+	      uint64_t layer_rows[tracker_zone::ROWS_MASK_SIZE];
+	      _get_packed_layer_rows(iside, ilayer, layer_rows);
+	      for (unsigned int iword = 0; iword < tracker_zone::ROWS_MASK_SIZE; iword++) near_source_rows[iword] |= layer_rows[iword];
+	    }
+
+	  // The masks of the zones only cover rows below NROWS :
+	  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
+	    {
+	      const uint64_t * left_mask = tracker_zone::near_source_rows_mask(izone, tracker_zone::DATA_NEAR_SOURCE_BIT_LEFT);
+	      const uint64_t * right_mask = tracker_zone::near_source_rows_mask(izone, tracker_zone::DATA_NEAR_SOURCE_BIT_RIGHT);
+	      uint64_t left = 0;
+	      uint64_t right = 0;
+	      for (unsigned int iword = 0; iword < tracker_zone::ROWS_MASK_SIZE; iword++)
+		{
+		  left |= near_source_rows[iword] & left_mask[iword];
+		  right |= near_source_rows[iword] & right_mask[iword];
+		}
+	      _zones_[iside][izone].data_near_source.set(tracker_zone::DATA_NEAR_SOURCE_BIT_LEFT, left != 0);
+	      _zones_[iside][izone].data_near_source.set(tracker_zone::DATA_NEAR_SOURCE_BIT_RIGHT, right != 0);
+	    }
+	}
+      return;
+    }
+
     void tracker_trigger_algorithm::build_tracker_record(trigger_structures::tracker_record & a_tracker_record_)
     {
       for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
@@ -438,6 +559,7 @@ namespace snemo {
 	      a_tracker_record_.finale_data_per_zone[iside][izone][trigger_structures::tracker_record::FINALE_DATA_BIT_NSZ_LEFT]  = _zones_[iside][izone].data_near_source[1];
 	    }
 	}
+      a_tracker_record_.update_zone_masks();
 
       // Build tracker zoning words
       // - mode LMR "normal" delayed (pattern) -> Tracker / Tracker + calo
@@ -486,7 +608,7 @@ namespace snemo {
       for (unsigned int ilayer = trigger_info::NLAYERS - 1; ilayer > 0; ilayer--) {
 	for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++) {
 	  for (unsigned int irow = 0; irow < tracker_zone::width(izone); irow++) {
-	    out_ << (_zones_[0][izone].cells[ilayer][irow] ? 'o' : '.');
+	    out_ << (_a_geiger_matrix_for_a_clocktick_.matrix[0][ilayer][tracker_zone::start_row(izone) + irow] ? 'o' : '.');
 	  }
 	  out_ << ' ';
 	}
@@ -499,7 +621,7 @@ namespace snemo {
       for (unsigned int ilayer = 0; ilayer < trigger_info::NLAYERS; ilayer++) {
 	for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++) {
 	  for (unsigned int irow = 0; irow < tracker_zone::width(izone); irow++) {
-	    out_ << (_zones_[1][izone].cells[ilayer][irow] ? 'o' : '.');
+	    out_ << (_a_geiger_matrix_for_a_clocktick_.matrix[1][ilayer][tracker_zone::start_row(izone) + irow] ? 'o' : '.');
 	  }
 	  out_ << ' ';
 	}
@@ -510,22 +632,106 @@ namespace snemo {
       return;
     }
 
+    void tracker_trigger_algorithm::_fill_matrix_from_ctw(const geiger_ctw & my_geiger_ctw_)
+    {
+      // Same cells as build_hit_cells_gids_from_ctw then fill_matrix, decoded with the table of the firmware :
+      const uint32_t ctw_rack  = my_geiger_ctw_.get_geom_id().get(mapping::RACK_INDEX);
+      const uint32_t ctw_crate = my_geiger_ctw_.get_geom_id().get(mapping::CRATE_INDEX);
+      DT_THROW_IF(ctw_rack != mapping::GEIGER_RACK_ID || ctw_crate >= mapping::NUMBER_OF_CRATES, std::logic_error,
+		  "Geiger CTW rack [" << ctw_rack << "] crate [" << ctw_crate << "] is not a Geiger crate ! ");
+      for (unsigned int i = 0; i < mapping::NUMBER_OF_FEBS_BY_CRATE; i++)
+	{
+	  std::bitset<geiger::tp::FULL_SIZE> my_bitset;
+	  my_geiger_ctw_.get_100_bits_in_ctw_word(i, my_bitset);
+	  const uint32_t board_id = get_board_id(my_bitset);
+	  for (int32_t j = geiger::tp::TP_BEGIN; j <= geiger::tp::TP_THREE_WIRES_END; j++)
+	    {
+	      if (!my_bitset.test(j)) continue;
+	      const uint16_t cell_index = _firmware_->get_cell_index(ctw_crate, board_id, j - geiger::tp::TP_BEGIN);
+	      if (cell_index == trigger_firmware::INVALID_CELL) continue;
+	      const unsigned int side  = cell_index / (trigger_info::NLAYERS * trigger_info::NROWS);
+	      const unsigned int layer = (cell_index / trigger_info::NROWS) % trigger_info::NLAYERS;
+	      const unsigned int row   = cell_index % trigger_info::NROWS;
+	      _a_geiger_matrix_for_a_clocktick_.matrix[side][layer][row] = 1;
+	      _packed_matrix_[cell_index / 64] |= (uint64_t) 1 << (cell_index % 64);
+	    }
+	}
+      return;
+    }
+
+    void tracker_trigger_algorithm::_get_packed_layer_rows(unsigned int side_, unsigned int layer_, uint64_t rows_[tracker_zone::ROWS_MASK_SIZE]) const
+    {
+      const unsigned int first_cell = trigger_firmware::cell_index(side_, layer_, 0);
+      for (unsigned int iword = 0; iword < tracker_zone::ROWS_MASK_SIZE; iword++)
+	{
+	  const unsigned int packed_word = first_cell / 64 + iword;
+	  const unsigned int shift = first_cell % 64;
+	  rows_[iword] = packed_word < PACKED_MATRIX_SIZE ? _packed_matrix_[packed_word] >> shift : 0;
+	  if (shift != 0 && packed_word + 1 < PACKED_MATRIX_SIZE) rows_[iword] |= _packed_matrix_[packed_word + 1] << (64 - shift);
+	}
+      return;
+    }
+
+    uint64_t tracker_trigger_algorithm::_hash_packed_matrix() const
+    {
+      uint64_t hash = 0xcbf29ce484222325ULL;
+      for (unsigned int i = 0; i < PACKED_MATRIX_SIZE; i++)
+	{
+	  hash ^= _packed_matrix_[i];
+	  hash *= 0x9e3779b97f4a7c15ULL;
+	  hash ^= hash >> 29;
+	}
+      return hash;
+    }
+
+    void tracker_trigger_algorithm::_build_tracker_record_for_a_clocktick(trigger_structures::tracker_record & a_tracker_record_)
+    {
+      reset_zones_informations();
+      build_sliding_zones(_firmware_->get_sliding_zone_vertical_memory(), _firmware_->get_sliding_zone_horizontal_memory());
+      build_zones();
+      build_tracker_record(a_tracker_record_);
+      return;
+    }
+
     void tracker_trigger_algorithm::_process_for_a_clocktick(const std::vector<datatools::handle<geiger_ctw> > geiger_ctw_list_per_clocktick_,
 								       trigger_structures::tracker_record & a_tracker_record_)
     {
       _a_geiger_matrix_for_a_clocktick_.reset();
-      reset_zones_informations();
+      std::fill(_packed_matrix_, _packed_matrix_ + PACKED_MATRIX_SIZE, 0);
+      FLDIGI_INSTRUMENT_COUNT(COUNTER_GEIGER_CTWS_DECODED, geiger_ctw_list_per_clocktick_.size());
       for (unsigned int isize = 0; isize < geiger_ctw_list_per_clocktick_.size(); isize++)
        	{
-       	  std::vector<geomtools::geom_id> hit_cells_gids;
-       	  build_hit_cells_gids_from_ctw(geiger_ctw_list_per_clocktick_[isize].get(), hit_cells_gids);
-       	  fill_matrix(hit_cells_gids);
+	  _fill_matrix_from_ctw(geiger_ctw_list_per_clocktick_[isize].get());
 	} // end of isize
       _a_geiger_matrix_for_a_clocktick_.clocktick_1600ns = geiger_ctw_list_per_clocktick_[0].get().get_clocktick_800ns();
 
-      build_sliding_zones(_sliding_zone_vertical_memory_, _sliding_zone_horizontal_memory_);
-      build_zones();
-      build_tracker_record(a_tracker_record_);
+      if (_cache_.empty())
+	{
+	  _build_tracker_record_for_a_clocktick(a_tracker_record_);
+	  return;
+	}
+
+      // Tracker record cache, the key is checked against the full packed matrix :
+      const uint64_t key = _hash_packed_matrix();
+      cache_entry & an_entry = _cache_[key % _cache_.size()];
+      if (an_entry.valid
+	  && an_entry.key == key
+	  && std::equal(_packed_matrix_, _packed_matrix_ + PACKED_MATRIX_SIZE, an_entry.packed_matrix))
+	{
+	  _cache_hits_++;
+	  FLDIGI_INSTRUMENT_COUNT(COUNTER_TRACKER_CACHE_HITS, 1);
+	  const uint32_t clocktick_1600ns = a_tracker_record_.clocktick_1600ns;
+	  a_tracker_record_ = an_entry.record;
+	  a_tracker_record_.clocktick_1600ns = clocktick_1600ns;
+	  return;
+	}
+      _cache_misses_++;
+      FLDIGI_INSTRUMENT_COUNT(COUNTER_TRACKER_CACHE_MISSES, 1);
+      _build_tracker_record_for_a_clocktick(a_tracker_record_);
+      an_entry.valid = true;
+      an_entry.key = key;
+      std::copy(_packed_matrix_, _packed_matrix_ + PACKED_MATRIX_SIZE, an_entry.packed_matrix);
+      an_entry.record = a_tracker_record_;
 
       //_a_geiger_matrix_for_a_clocktick_.display();
       //a_tracker_record_.display();
@@ -545,6 +751,7 @@ namespace snemo {
 						      trigger_structures::tracker_record & a_tracker_record_)
     {
       DT_THROW_IF(!is_initialized(), std::logic_error, "Tracker trigger algorithm is not initialized, it can't process ! ");
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_TRACKER_TRIGGER);
       if (geiger_ctw_list_per_clocktick_.size() != 0)
 	{
 	  _process(geiger_ctw_list_per_clocktick_,
@@ -553,6 +760,7 @@ namespace snemo {
       else
 	{
 	  _a_geiger_matrix_for_a_clocktick_.reset();
+	  std::fill(_packed_matrix_, _packed_matrix_ + PACKED_MATRIX_SIZE, 0);
 	  reset_zones_informations();
 	}
 
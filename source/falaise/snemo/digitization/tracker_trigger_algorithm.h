@@ -8,6 +8,8 @@
 // Standard library :
 #include <string>
 #include <bitset>
+#include <vector>
+#include <memory>
 
 // This project :
 #include <snemo/digitization/geiger_ctw_data.h>
@@ -18,6 +20,7 @@
 #include <snemo/digitization/trigger_structures.h>
 #include <snemo/digitization/tracker_zone.h>
 #include <snemo/digitization/tracker_sliding_zone.h>
+#include <snemo/digitization/trigger_firmware.h>
 
 namespace datatools {
 	class properties;
@@ -28,9 +31,28 @@ namespace snemo {
   namespace digitization {
 
     /// \brief Trigger algorithm general process
+    ///
+    /// Geiger cells stay active during several clockticks 1600 ns, so the same
+    /// Geiger matrix is usually processed several times in an event. The tracker
+    /// records are cached by matrix content (tracker section key
+    /// 'tracker_record_cache_size', 0 disables the cache) : when the matrix of a
+    /// clocktick is in the cache, the sliding zones, zones and tracker record are
+    /// not rebuilt and the zones keep the state of the last computed clocktick.
+    ///
+    /// The memories and the Geiger channels decoding table are held by a read
+    /// only trigger firmware image. It is either shared with other algorithms
+    /// (set_firmware) or loaded by the algorithm itself at initialization from
+    /// the memory files of the tracker section.
     class tracker_trigger_algorithm
     {
 		public :
+
+			/// Default number of entries of the tracker record cache
+			static const unsigned int DEFAULT_CACHE_SIZE = 16;
+
+			/// Number of 64 bits words of a packed Geiger matrix
+			static const unsigned int PACKED_MATRIX_SIZE = (trigger_info::NSIDES * trigger_info::NLAYERS * trigger_info::NROWS + 63) / 64;
+
 			/// Trigger display manager is a friend because it can access to members for display
 		 	friend class trigger_display_manager;
 
@@ -43,6 +65,15 @@ namespace snemo {
 			/// Set the electronic mapping object
       void set_electronic_mapping(const electronic_mapping & my_electronic_mapping_);
 
+			/// Set a shared trigger firmware image (the memory files of the configuration are then ignored)
+			void set_firmware(const std::shared_ptr<const trigger_firmware> & firmware_);
+
+			/// Check if the trigger firmware image is set
+			bool has_firmware() const;
+
+			/// Return the trigger firmware image
+			const std::shared_ptr<const trigger_firmware> & get_firmware() const;
+
 			/// Fill memory 1 for all zones
 			void fill_mem1_all(const std::string & filename_);
 
@@ -58,6 +89,21 @@ namespace snemo {
 			/// Fill memory 5 for all zones
 			void fill_mem5_all(const std::string & filename_);
 
+			/// Set the number of entries of the tracker record cache (0 disables the cache)
+			void set_cache_size(unsigned int cache_size_);
+
+			/// Return the number of entries of the tracker record cache
+			unsigned int get_cache_size() const;
+
+			/// Return the number of clockticks whose tracker record was found in the cache
+			std::size_t get_cache_hits() const;
+
+			/// Return the number of clockticks whose tracker record was computed
+			std::size_t get_cache_misses() const;
+
+			/// Clear the tracker record cache and its counters
+			void clear_cache();
+
 			/// Initializing
       void initialize();
 
@@ -96,8 +142,8 @@ namespace snemo {
 			void build_sliding_zone(unsigned int side_, unsigned int szone_id_);
 
 			/// Build all sliding zones with memories mem1 and mem2 for projections
-			void build_sliding_zones(tracker_trigger_mem_maker::mem1_type & mem1_,
-															 tracker_trigger_mem_maker::mem2_type & mem2_);
+			void build_sliding_zones(const tracker_trigger_mem_maker::mem1_type & mem1_,
+															 const tracker_trigger_mem_maker::mem2_type & mem2_);
 
 
 			/// Build one zone information for a clocktick
@@ -106,18 +152,24 @@ namespace snemo {
 			/// Build all zones responses for a clocktick
 			void build_zones();
 
-			/// Build the vertical information for a zone
+			/// Build the vertical information for a zone (reference implementation)
 			void build_in_out_pattern(tracker_zone & zone_,
-																tracker_trigger_mem_maker::mem3_type & mem3_);
+																const tracker_trigger_mem_maker::mem3_type & mem3_);
 
-			/// Build the horizeontal information for a zone
+			/// Build the horizeontal information for a zone (reference implementation)
 			void build_left_mid_right_pattern(tracker_zone & zone_,
-																				tracker_trigger_mem_maker::mem4_type & mem4_,
-																				tracker_trigger_mem_maker::mem5_type & mem5_);
+																				const tracker_trigger_mem_maker::mem4_type & mem4_,
+																				const tracker_trigger_mem_maker::mem5_type & mem5_);
+
+			/// Build the vertical and horizontal information of all the zones from the packed sliding zones projections
+			void build_zone_patterns();
 
-			/// Build near source information for a zone
+			/// Build near source information for a zone (reference cell by cell implementation)
 			void build_near_source_pattern(tracker_zone & zone_);
 
+			/// Build near source information for all the zones from the packed Geiger matrix
+			void build_near_source_patterns();
+
 			/// Build tracker record for each clocktick
 			void build_tracker_record(trigger_structures::tracker_record & a_tracker_record_);
 
@@ -130,6 +182,30 @@ namespace snemo {
 
 		protected :
 
+			/// \brief Entry of the tracker record cache
+			struct cache_entry
+			{
+				bool valid;                                 //!< Validity of the entry
+				uint64_t key;                               //!< Hash of the packed Geiger matrix
+				uint64_t packed_matrix[PACKED_MATRIX_SIZE]; //!< Packed Geiger matrix
+				trigger_structures::tracker_record record;  //!< Tracker record of the Geiger matrix
+			};
+
+			/// Return the trigger firmware image loaded by the algorithm (before initialization)
+			trigger_firmware & _grab_own_firmware();
+
+			/// Fill the Geiger matrix of the clocktick with the active cells of a Geiger CTW
+			void _fill_matrix_from_ctw(const geiger_ctw & my_geiger_ctw_);
+
+			/// Return the rows of a layer of a side from the packed Geiger matrix (bits above NROWS belong to the next layer)
+			void _get_packed_layer_rows(unsigned int side_, unsigned int layer_, uint64_t rows_[tracker_zone::ROWS_MASK_SIZE]) const;
+
+			/// Return the hash of the packed Geiger matrix of the clocktick
+			uint64_t _hash_packed_matrix() const;
+
+			/// Build the sliding zones, zones and tracker record of the Geiger matrix of the clocktick
+			void _build_tracker_record_for_a_clocktick(trigger_structures::tracker_record & a_tracker_record_);
+
 			/// Process for a clocktick
 			void _process_for_a_clocktick(const std::vector<datatools::handle<geiger_ctw> > geiger_ctw_list_per_clocktick_,
 																		trigger_structures::tracker_record & a_tracker_record_);
@@ -144,16 +220,22 @@ namespace snemo {
       bool _initialized_; //!< Initialization
 			const electronic_mapping * _electronic_mapping_; //!< Convert geometric ID into electronic ID flag
 
-			tracker_trigger_mem_maker::mem1_type _sliding_zone_vertical_memory_;
-			tracker_trigger_mem_maker::mem2_type _sliding_zone_horizontal_memory_;
-			tracker_trigger_mem_maker::mem3_type _zone_vertical_memory_;
-			tracker_trigger_mem_maker::mem4_type _zone_horizontal_memory_;
-			tracker_trigger_mem_maker::mem5_type _zone_vertical_for_horizontal_memory_;
+			std::shared_ptr<const trigger_firmware> _firmware_; //!< Read only trigger firmware image (memories, Geiger channels decoding)
+			std::shared_ptr<trigger_firmware> _own_firmware_;   //!< Trigger firmware image filled by the algorithm before initialization
 
 			// Data :
 			trigger_structures::geiger_matrix _a_geiger_matrix_for_a_clocktick_;
 			tracker_zone _zones_[trigger_info::NSIDES][trigger_info::NZONES];
 			tracker_sliding_zone _sliding_zones_[trigger_info::NSIDES][trigger_info::NSLZONES];
+			uint64_t _packed_matrix_[PACKED_MATRIX_SIZE]; //!< Packed Geiger matrix of the clocktick (one bit per cell)
+			uint64_t _sliding_zones_io_[trigger_info::NSIDES]; //!< IO projections of the sliding zones of a side (2 bits per sliding zone, last sliding zone first)
+			uint64_t _sliding_zones_lr_[trigger_info::NSIDES]; //!< LR projections of the sliding zones of a side (2 bits per sliding zone, last sliding zone first)
+
+			// Tracker record cache :
+			unsigned int _cache_size_;        //!< Number of entries of the cache
+			std::vector<cache_entry> _cache_; //!< Direct mapped cache of the tracker records
+			std::size_t _cache_hits_;         //!< Number of tracker records found in the cache
+			std::size_t _cache_misses_;       //!< Number of tracker records computed
 
 		};
 
@@ -4,6 +4,7 @@
 
 // Standard library : 
 #include <iostream>
+#include <algorithm>
 
 // Ourselves:
 #include <falaise/snemo/digitization/tracker_zone.h>
@@ -12,6 +13,8 @@ namespace snemo {
 
   namespace digitization {
 
+    const unsigned int tracker_zone::ROWS_MASK_SIZE;
+
     tracker_zone::tracker_zone()
     {
       reset();
@@ -57,6 +60,32 @@ namespace snemo {
       return stop_row(i_) - start_row(i_) + 1;
     }
    
+    const uint64_t * tracker_zone::near_source_rows_mask(unsigned int i_, unsigned int bit_)
+    {
+      // Same rows as the near source pattern of a zone (see tracker_trigger_algorithm::build_near_source_pattern) :
+      struct near_source_masks
+      {
+	near_source_masks()
+	{
+	  std::fill(&masks[0][0][0], &masks[0][0][0] + snemo::digitization::trigger_info::NZONES * snemo::digitization::trigger_info::DATA_NSZ_PATTERN_SIZE * ROWS_MASK_SIZE, 0);
+	  for (unsigned int izone = 0; izone < snemo::digitization::trigger_info::NZONES; izone++) {
+	    const unsigned int zone_middle = width(izone) / 2;
+	    for (unsigned int irow = 0; irow < width(izone); irow++) {
+	      bool left = irow < zone_middle;
+	      bool right = irow >= zone_middle;
+	      if (irow == zone_middle && (zone_middle % 2 == 1 || izone == 0 || izone == 5 || izone == 9)) left = true;
+	      const unsigned int global_row = start_row(izone) + irow;
+	      if (left) masks[izone][DATA_NEAR_SOURCE_BIT_LEFT][global_row / 64] |= (uint64_t) 1 << (global_row % 64);
+	      if (right) masks[izone][DATA_NEAR_SOURCE_BIT_RIGHT][global_row / 64] |= (uint64_t) 1 << (global_row % 64);
+	    }
+	  }
+	}
+	uint64_t masks[snemo::digitization::trigger_info::NZONES][snemo::digitization::trigger_info::DATA_NSZ_PATTERN_SIZE][ROWS_MASK_SIZE];
+      };
+      static const near_source_masks near_source_table;
+      return near_source_table.masks[i_][bit_];
+    }
+
     void tracker_zone::print_layout(std::ostream & out_)
     {
       out_ << "Zone layout: " << '\n';
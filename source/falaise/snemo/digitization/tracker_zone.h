@@ -26,6 +26,9 @@ namespace snemo {
 				DATA_NEAR_SOURCE_BIT_LEFT  = 1				
 			};
 
+			/// Number of 64 bits words of a rows mask of a side (one bit per row)
+			static const unsigned int ROWS_MASK_SIZE = (snemo::digitization::trigger_info::NROWS + 63) / 64;
+
 			tracker_zone();
 
       void reset();
@@ -35,6 +38,9 @@ namespace snemo {
       static unsigned int stop_row(unsigned int i_);
 
       static unsigned int width(unsigned int i_);
+
+			/// Return the mask of the rows of a side setting a near source bit (left or right) of a zone
+			static const uint64_t * near_source_rows_mask(unsigned int i_, unsigned int bit_);
 		
       static void print_layout(std::ostream & out_);
 
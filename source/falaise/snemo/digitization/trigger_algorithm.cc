@@ -5,12 +5,32 @@
 // Ourselves:
 #include <snemo/digitization/trigger_algorithm.h>
 #include <snemo/digitization/mapping.h>
+#include <snemo/digitization/instrumentation.h>
 
+// Standard library :
+#include <algorithm>
 
 namespace snemo {
 
   namespace digitization {
 
+    trigger_algorithm::front_end_records::front_end_records()
+    {
+      front_end_records::reset();
+      return;
+    }
+
+    void trigger_algorithm::front_end_records::reset()
+    {
+      calo_records_25ns.clear();
+      tracker_records.clear();
+      geiger_matrix_records.clear();
+      tracker_clocktick_min_1600ns = clock_utils::INVALID_CLOCKTICK;
+      tracker_clocktick_max_1600ns = clock_utils::INVALID_CLOCKTICK;
+      with_tracker_records = false;
+      return;
+    }
+
     trigger_algorithm::trigger_algorithm()
     {
       _initialized_ = false;
@@ -25,6 +45,7 @@ namespace snemo {
       _activate_ape_dave_coincidence_ = false;
       _activate_ape_coincidence_only_ = false;
       _activate_any_coincidences_ = false;
+      _retention_policy_ = RETENTION_FULL_DEBUG;
       _calo_records_25ns_.clear();
       _coincidence_calo_records_1600ns_.clear();
       _tracker_records_.clear();
@@ -34,7 +55,22 @@ namespace snemo {
       _previous_event_records_.reset();
       _L1_calo_decision_records_.clear();
       _L2_decision_records_.clear();
+      _front_end_records_.reset();
       _finale_trigger_decision_ = false;
+      _per_to_delete_.first = false;
+      _per_to_delete_.second = -1;
+      _streaming_ = false;
+      _stream_clocktick_25ns_ = 0;
+      _stream_clocktick_1600ns_ = 0;
+      _stream_last_calo_ctw_25ns_ = INVALID_STREAM_CLOCKTICK;
+      _stream_last_calo_record_25ns_ = INVALID_STREAM_CLOCKTICK;
+      _stream_calo_reference_25ns_ = 0;
+      _stream_geiger_reference_800ns_ = 0;
+      _stream_calo_ctws_.clear();
+      _stream_geiger_ctws_.clear();
+      _stream_coinc_calo_records_.clear();
+      _stream_L1_calo_decisions_.clear();
+      _stream_L2_decisions_.clear();
       return;
     }
 
@@ -62,6 +98,7 @@ namespace snemo {
       _activate_ape_dave_coincidence_ = false;
       _activate_ape_coincidence_only_ = false;
       _activate_any_coincidences_ = false;
+      _retention_policy_ = RETENTION_FULL_DEBUG;
       _tracker_algo_.reset();
       _calo_algo_.reset();
       _coinc_algo_.reset();
@@ -74,7 +111,22 @@ namespace snemo {
       _previous_event_records_.reset();
       _L1_calo_decision_records_.clear();
       _L2_decision_records_.clear();
+      _front_end_records_.reset();
       _finale_trigger_decision_ = false;
+      _per_to_delete_.first = false;
+      _per_to_delete_.second = -1;
+      _streaming_ = false;
+      _stream_clocktick_25ns_ = 0;
+      _stream_clocktick_1600ns_ = 0;
+      _stream_last_calo_ctw_25ns_ = INVALID_STREAM_CLOCKTICK;
+      _stream_last_calo_record_25ns_ = INVALID_STREAM_CLOCKTICK;
+      _stream_calo_reference_25ns_ = 0;
+      _stream_geiger_reference_800ns_ = 0;
+      _stream_calo_ctws_.clear();
+      _stream_geiger_ctws_.clear();
+      _stream_coinc_calo_records_.clear();
+      _stream_L1_calo_decisions_.clear();
+      _stream_L2_decisions_.clear();
       return;
     }
 
@@ -87,9 +139,10 @@ namespace snemo {
       _geiger_matrix_records_.clear();
       _pair_records_.clear();
       _coincidence_records_.clear();
-      _previous_event_records_->clear();
+      if (_previous_event_records_) _previous_event_records_->clear();
       _L1_calo_decision_records_.clear();
       _L2_decision_records_.clear();
+      _front_end_records_.reset();
       _finale_trigger_decision_ = false;
       return;
     }
@@ -109,6 +162,18 @@ namespace snemo {
       return;
     }
 
+    void trigger_algorithm::set_firmware(const std::shared_ptr<const trigger_firmware> & firmware_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger algorithm is already initialized, trigger firmware can't be set ! ");
+      _tracker_algo_.set_firmware(firmware_);
+      return;
+    }
+
+    const std::shared_ptr<const trigger_firmware> & trigger_algorithm::get_firmware() const
+    {
+      return _tracker_algo_.get_firmware();
+    }
+
     bool trigger_algorithm::has_calorimeter_gate_size() const
     {
       return _coincidence_calorimeter_gate_size_ != 0;
@@ -160,6 +225,26 @@ namespace snemo {
       return _activate_any_coincidences_;
     }
 
+    void trigger_algorithm::set_retention_policy(retention_policy_type retention_policy_)
+    {
+      DT_THROW_IF(retention_policy_ == RETENTION_UNDEFINED, std::domain_error, "Invalid retention policy ! ");
+      _retention_policy_ = retention_policy_;
+      return;
+    }
+
+    trigger_algorithm::retention_policy_type trigger_algorithm::get_retention_policy() const
+    {
+      return _retention_policy_;
+    }
+
+    trigger_algorithm::retention_policy_type trigger_algorithm::retention_policy_from_label(const std::string & label_)
+    {
+      if (label_ == "decisions") return RETENTION_DECISIONS;
+      if (label_ == "records") return RETENTION_RECORDS;
+      if (label_ == "full_debug") return RETENTION_FULL_DEBUG;
+      return RETENTION_UNDEFINED;
+    }
+
     void trigger_algorithm::initialize()
     {
       datatools::multi_properties dummy_config;
@@ -214,6 +299,12 @@ namespace snemo {
 	}
       }
 
+      if (general_config.has_key("retention_policy")) {
+	retention_policy_type retention_policy = retention_policy_from_label(general_config.fetch_string("retention_policy"));
+	DT_THROW_IF(retention_policy == RETENTION_UNDEFINED, std::domain_error, "Invalid retention policy '" << general_config.fetch_string("retention_policy") << "' !");
+	set_retention_policy(retention_policy);
+      }
+
       datatools::properties calo_config;
       calo_config = mconfig_.get_section("calorimeter");
       // calo_config.tree_dump(std::clog, "Calorimeter config from multi properties");
@@ -238,41 +329,46 @@ namespace snemo {
       return _initialized_;
     }
 
-    const std::vector<trigger_structures::calo_summary_record> trigger_algorithm::get_calo_records_25ns_vector() const
+    const std::vector<trigger_structures::calo_summary_record> & trigger_algorithm::get_calo_records_25ns_vector() const
     {
       return _calo_records_25ns_;
     }
 
-    const std::vector<trigger_structures::coincidence_calo_record> trigger_algorithm::get_coincidence_calo_records_1600ns_vector() const
+    const std::vector<trigger_structures::coincidence_calo_record> & trigger_algorithm::get_coincidence_calo_records_1600ns_vector() const
     {
       return _coincidence_calo_records_1600ns_;
     }
 
-    const std::vector<trigger_structures::tracker_record> trigger_algorithm::get_tracker_records_vector() const
+    const std::vector<trigger_structures::tracker_record> & trigger_algorithm::get_tracker_records_vector() const
     {
       return _tracker_records_;
     }
 
-    const std::vector<trigger_structures::geiger_matrix> trigger_algorithm::get_geiger_matrix_records_vector() const
+    const std::vector<trigger_structures::geiger_matrix> & trigger_algorithm::get_geiger_matrix_records_vector() const
     {
       return _geiger_matrix_records_;
     }
 
-    const std::vector<trigger_structures::coincidence_event_record> trigger_algorithm::get_coincidence_records_vector() const
+    const std::vector<trigger_structures::coincidence_event_record> & trigger_algorithm::get_coincidence_records_vector() const
     {
       return _coincidence_records_;
     }
 
-    const std::vector<trigger_structures::L1_calo_decision> trigger_algorithm::get_L1_calo_decision_records_vector() const
+    const std::vector<trigger_structures::L1_calo_decision> & trigger_algorithm::get_L1_calo_decision_records_vector() const
     {
       return _L1_calo_decision_records_;
     }
 
-    const std::vector<trigger_structures::L2_decision> trigger_algorithm::get_L2_decision_records_vector() const
+    const std::vector<trigger_structures::L2_decision> & trigger_algorithm::get_L2_decision_records_vector() const
     {
       return _L2_decision_records_;
     }
 
+    const std::vector<std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> > & trigger_algorithm::get_pair_records_vector() const
+    {
+      return _pair_records_;
+    }
+
     bool trigger_algorithm::get_finale_decision() const
     {
       return _finale_trigger_decision_;
@@ -288,8 +384,7 @@ namespace snemo {
 
       	  if (a_ctrec.calo_finale_decision == true)
       	    {
-	      uint32_t ctrec_clocktick_1600ns = 0;
-      	      _clock_manager_->compute_clocktick_25ns_to_1600ns(a_ctrec.clocktick_25ns, ctrec_clocktick_1600ns);
+	      const uint32_t ctrec_clocktick_1600ns = clock_utils::clocktick_25ns_to_1600ns(a_ctrec.clocktick_25ns);
 
       	      if (coincidence_calo_records_1600ns_.size() == 0)
       		{
@@ -405,79 +500,73 @@ namespace snemo {
       bool total_multiplicity_threshold = a_coinc_calo_record_1600ns_.total_multiplicity_threshold;
       bool calo_decision = a_coinc_calo_record_1600ns_.decision;
 
-      unsigned int clocktick_1600_from_25 = 0;
-      _clock_manager_->compute_clocktick_25ns_to_1600ns(a_calo_summary_record_25ns_.clocktick_25ns,
-							clocktick_1600_from_25);
+      // The calo summary record belongs to the gate of the coinc calo record (guaranteed by the caller) :
+      a_coinc_calo_record_1600ns_.calo_zoning_word[0] = a_calo_summary_record_25ns_.zoning_word[0];
+      a_coinc_calo_record_1600ns_.calo_zoning_word[1] = a_calo_summary_record_25ns_.zoning_word[1];
 
-      if (clocktick_1600_from_25 <= a_coinc_calo_record_1600ns_.clocktick_1600ns + _coincidence_calorimeter_gate_size_)
+      for (unsigned int i = 0; i < trigger_info::CALO_ZONING_PER_SIDE_BITSET_SIZE; i++)
 	{
-	  a_coinc_calo_record_1600ns_.calo_zoning_word[0] = a_calo_summary_record_25ns_.zoning_word[0];
-	  a_coinc_calo_record_1600ns_.calo_zoning_word[1] = a_calo_summary_record_25ns_.zoning_word[1];
-
-	  for (unsigned int i = 0; i < trigger_info::CALO_ZONING_PER_SIDE_BITSET_SIZE; i++)
+	  if (a_coinc_calo_record_1600ns_.calo_zoning_word[0].test(i) == true)
 	    {
-	      if (a_coinc_calo_record_1600ns_.calo_zoning_word[0].test(i) == true)
-		{
-		  zoning_word_side_0.set(i, true);
-		}
-	      if (a_coinc_calo_record_1600ns_.calo_zoning_word[1].test(i) == true)
-		{
-		  zoning_word_side_1.set(i, true);
-		}
-	    }
-	  a_coinc_calo_record_1600ns_.calo_zoning_word[0] = zoning_word_side_0;
-	  a_coinc_calo_record_1600ns_.calo_zoning_word[1] = zoning_word_side_1;
-	  a_coinc_calo_record_1600ns_.xt_info_bitset = xt_info;
-
-	  unsigned int number_of_zone_touch_side_0 = a_coinc_calo_record_1600ns_.calo_zoning_word[0].count();
-	  unsigned int number_of_zone_touch_side_1 = a_coinc_calo_record_1600ns_.calo_zoning_word[1].count();
-
-	  if (multiplicity_side_0 < a_calo_summary_record_25ns_.total_multiplicity_side_0.to_ulong())
-	    {
-	      a_coinc_calo_record_1600ns_.total_multiplicity_side_0 = a_calo_summary_record_25ns_.total_multiplicity_side_0.to_ulong();
+	      zoning_word_side_0.set(i, true);
 	    }
-	  if (number_of_zone_touch_side_0 > multiplicity_side_0)
+	  if (a_coinc_calo_record_1600ns_.calo_zoning_word[1].test(i) == true)
 	    {
-	      a_coinc_calo_record_1600ns_.total_multiplicity_side_0 = number_of_zone_touch_side_0;
+	      zoning_word_side_1.set(i, true);
 	    }
+	}
+      a_coinc_calo_record_1600ns_.calo_zoning_word[0] = zoning_word_side_0;
+      a_coinc_calo_record_1600ns_.calo_zoning_word[1] = zoning_word_side_1;
+      a_coinc_calo_record_1600ns_.xt_info_bitset = xt_info;
 
-	  if (multiplicity_side_1 < a_calo_summary_record_25ns_.total_multiplicity_side_1.to_ulong())
-	    {
-	      a_coinc_calo_record_1600ns_.total_multiplicity_side_1 = a_calo_summary_record_25ns_.total_multiplicity_side_1.to_ulong();
-	    }
-	  if (number_of_zone_touch_side_1 > multiplicity_side_1)
-	    {
-	      a_coinc_calo_record_1600ns_.total_multiplicity_side_1 = number_of_zone_touch_side_1;
-	    }
+      unsigned int number_of_zone_touch_side_0 = a_coinc_calo_record_1600ns_.calo_zoning_word[0].count();
+      unsigned int number_of_zone_touch_side_1 = a_coinc_calo_record_1600ns_.calo_zoning_word[1].count();
 
-	  if (multiplicity_gveto < a_calo_summary_record_25ns_.total_multiplicity_gveto.to_ulong())
-	    {
-	      a_coinc_calo_record_1600ns_.total_multiplicity_gveto = a_calo_summary_record_25ns_.total_multiplicity_gveto.to_ulong();
-	    }
+      if (multiplicity_side_0 < a_calo_summary_record_25ns_.total_multiplicity_side_0.to_ulong())
+	{
+	  a_coinc_calo_record_1600ns_.total_multiplicity_side_0 = a_calo_summary_record_25ns_.total_multiplicity_side_0.to_ulong();
+	}
+      if (number_of_zone_touch_side_0 > multiplicity_side_0)
+	{
+	  a_coinc_calo_record_1600ns_.total_multiplicity_side_0 = number_of_zone_touch_side_0;
+	}
+
+      if (multiplicity_side_1 < a_calo_summary_record_25ns_.total_multiplicity_side_1.to_ulong())
+	{
+	  a_coinc_calo_record_1600ns_.total_multiplicity_side_1 = a_calo_summary_record_25ns_.total_multiplicity_side_1.to_ulong();
+	}
+      if (number_of_zone_touch_side_1 > multiplicity_side_1)
+	{
+	  a_coinc_calo_record_1600ns_.total_multiplicity_side_1 = number_of_zone_touch_side_1;
+	}
 
-	  a_coinc_calo_record_1600ns_.LTO_side_0 = a_coinc_calo_record_1600ns_.LTO_side_0 + a_calo_summary_record_25ns_.LTO_side_0;
-	  a_coinc_calo_record_1600ns_.LTO_side_1 = a_coinc_calo_record_1600ns_.LTO_side_1 + a_calo_summary_record_25ns_.LTO_side_1;
-	  a_coinc_calo_record_1600ns_.LTO_gveto = a_coinc_calo_record_1600ns_.LTO_gveto + a_calo_summary_record_25ns_.LTO_gveto;
+      if (multiplicity_gveto < a_calo_summary_record_25ns_.total_multiplicity_gveto.to_ulong())
+	{
+	  a_coinc_calo_record_1600ns_.total_multiplicity_gveto = a_calo_summary_record_25ns_.total_multiplicity_gveto.to_ulong();
+	}
 
-	  if (a_coinc_calo_record_1600ns_.LTO_side_0 || lto_side_0) a_coinc_calo_record_1600ns_.LTO_side_0 = true;
-	  if (a_coinc_calo_record_1600ns_.LTO_side_1 || lto_side_1) a_coinc_calo_record_1600ns_.LTO_side_1 = true;
-	  if (a_coinc_calo_record_1600ns_.LTO_gveto  || lto_gveto) a_coinc_calo_record_1600ns_.LTO_gveto = true;
+      a_coinc_calo_record_1600ns_.LTO_side_0 = a_coinc_calo_record_1600ns_.LTO_side_0 + a_calo_summary_record_25ns_.LTO_side_0;
+      a_coinc_calo_record_1600ns_.LTO_side_1 = a_coinc_calo_record_1600ns_.LTO_side_1 + a_calo_summary_record_25ns_.LTO_side_1;
+      a_coinc_calo_record_1600ns_.LTO_gveto = a_coinc_calo_record_1600ns_.LTO_gveto + a_calo_summary_record_25ns_.LTO_gveto;
 
-	  a_coinc_calo_record_1600ns_.xt_info_bitset = a_calo_summary_record_25ns_.xt_info_bitset;
-	  a_coinc_calo_record_1600ns_.single_side_coinc = a_calo_summary_record_25ns_.single_side_coinc;
+      if (a_coinc_calo_record_1600ns_.LTO_side_0 || lto_side_0) a_coinc_calo_record_1600ns_.LTO_side_0 = true;
+      if (a_coinc_calo_record_1600ns_.LTO_side_1 || lto_side_1) a_coinc_calo_record_1600ns_.LTO_side_1 = true;
+      if (a_coinc_calo_record_1600ns_.LTO_gveto  || lto_gveto) a_coinc_calo_record_1600ns_.LTO_gveto = true;
 
-	  if (!a_calo_summary_record_25ns_.single_side_coinc || !single_side)
-	    {
-	      a_coinc_calo_record_1600ns_.single_side_coinc = false;
-	    }
-	  else if (a_coinc_calo_record_1600ns_.calo_zoning_word[0].any() && a_coinc_calo_record_1600ns_.calo_zoning_word[1].any()) a_coinc_calo_record_1600ns_.single_side_coinc = false;
-	  else a_coinc_calo_record_1600ns_.single_side_coinc = true;
+      a_coinc_calo_record_1600ns_.xt_info_bitset = a_calo_summary_record_25ns_.xt_info_bitset;
+      a_coinc_calo_record_1600ns_.single_side_coinc = a_calo_summary_record_25ns_.single_side_coinc;
 
-	  a_coinc_calo_record_1600ns_.total_multiplicity_threshold =  a_calo_summary_record_25ns_.total_multiplicity_threshold;
-	  if (a_coinc_calo_record_1600ns_.total_multiplicity_threshold || total_multiplicity_threshold) a_coinc_calo_record_1600ns_.total_multiplicity_threshold = true;
-	  a_coinc_calo_record_1600ns_.decision = a_calo_summary_record_25ns_.calo_finale_decision;
-	  if (a_coinc_calo_record_1600ns_.decision || calo_decision)  a_coinc_calo_record_1600ns_.decision = true;
+      if (!a_calo_summary_record_25ns_.single_side_coinc || !single_side)
+	{
+	  a_coinc_calo_record_1600ns_.single_side_coinc = false;
 	}
+      else if (a_coinc_calo_record_1600ns_.calo_zoning_word[0].any() && a_coinc_calo_record_1600ns_.calo_zoning_word[1].any()) a_coinc_calo_record_1600ns_.single_side_coinc = false;
+      else a_coinc_calo_record_1600ns_.single_side_coinc = true;
+
+      a_coinc_calo_record_1600ns_.total_multiplicity_threshold =  a_calo_summary_record_25ns_.total_multiplicity_threshold;
+      if (a_coinc_calo_record_1600ns_.total_multiplicity_threshold || total_multiplicity_threshold) a_coinc_calo_record_1600ns_.total_multiplicity_threshold = true;
+      a_coinc_calo_record_1600ns_.decision = a_calo_summary_record_25ns_.calo_finale_decision;
+      if (a_coinc_calo_record_1600ns_.decision || calo_decision)  a_coinc_calo_record_1600ns_.decision = true;
 
       return;
     }
@@ -592,26 +681,596 @@ namespace snemo {
 		} // end of iside
 	    }
 	} // end of for coinc record size
+      a_previous_event_record.update_tracker_zone_masks();
       _previous_event_records_->push_back(a_previous_event_record);
 
       return;
     }
 
+    void trigger_algorithm::_prune_coincidence_records(uint32_t clocktick_1600ns_)
+    {
+      std::size_t index = 0;
+      while (index < _coincidence_records_.size()
+	     && (uint32_t)(clocktick_1600ns_ - _coincidence_records_[index].clocktick_1600ns) > _L2_decision_coincidence_gate_size_) index++;
+      if (index != 0) _coincidence_records_.erase(_coincidence_records_.begin(), _coincidence_records_.begin() + index);
+      return;
+    }
+
+    void trigger_algorithm::_update_previous_event_records(uint32_t clocktick_1600ns_)
+    {
+      if (!_previous_event_records_->empty())
+	{
+	  auto it_circ = _previous_event_records_->begin();
+	  unsigned int pers_counter = 0;
+	  if (_per_to_delete_.first)
+	    {
+	      if (_previous_event_records_->size() > 1)
+		{
+		  _previous_event_records_->erase(_previous_event_records_->begin() + _per_to_delete_.second);
+		}
+	      else if (_previous_event_records_->size() == 1)
+		{
+		  _previous_event_records_->clear();
+		}
+	      _per_to_delete_.first = false;
+	      _per_to_delete_.second = -1;
+	    }
+
+	  // Problem here : counter 1600 on it_circ gives a strange value
+	  for (; it_circ != _previous_event_records_->end(); it_circ++)
+	    {
+	      DT_THROW_IF(it_circ->counter_1600ns > clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK, std::logic_error, "Previous Event Record counter out of bounds [0;clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK (625)] !");
+	      if (it_circ->counter_1600ns <= clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK)
+		{
+		  // Unsigned difference : valid across the wrap of the 32 bits clockticks
+		  int counter_result = clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK - (int)(uint32_t)(clocktick_1600ns_ - it_circ->previous_clocktick_1600ns);
+		  if (counter_result <= 0) counter_result = 0;
+		  it_circ->counter_1600ns = counter_result;
+		}
+	      if (it_circ->counter_1600ns == 0)
+		{
+		  // PER has to be erased in the circular buffer because the counter equal to 0.
+		  // Flag to remember this per has to be delete:
+		  _per_to_delete_.first = true;
+		  _per_to_delete_.second = pers_counter;
+		}
+	    }
+	  pers_counter++;
+	}
+      return;
+    }
+
+    void trigger_algorithm::_process_clocktick_1600ns(uint32_t clocktick_1600ns_,
+						      const geiger_ctw_data::geiger_ctw_collection_type & geiger_ctw_list_per_clocktick_1600_,
+						      const trigger_structures::coincidence_calo_record & a_coinc_calo_record_for_pair_)
+    {
+      trigger_structures::tracker_record a_tracker_record;
+      a_tracker_record.clocktick_1600ns = clocktick_1600ns_;
+      trigger_structures::geiger_matrix a_geiger_matrix;
+      trigger_structures::geiger_matrix * a_geiger_matrix_ptr = 0;
+
+      if (geiger_ctw_list_per_clocktick_1600_.size() != 0)
+	{
+	  if (_retention_policy_ >= RETENTION_FULL_DEBUG) a_geiger_matrix_ptr = &a_geiger_matrix;
+	  _process_tracker_clocktick_1600ns(clocktick_1600ns_,
+					    geiger_ctw_list_per_clocktick_1600_,
+					    a_tracker_record,
+					    a_geiger_matrix_ptr);
+	}
+
+      _process_coincidence_clocktick_1600ns(clocktick_1600ns_,
+					    a_tracker_record,
+					    a_geiger_matrix_ptr,
+					    a_coinc_calo_record_for_pair_);
+      return;
+    }
+
+    void trigger_algorithm::_process_tracker_clocktick_1600ns(uint32_t clocktick_1600ns_,
+							      const geiger_ctw_data::geiger_ctw_collection_type & geiger_ctw_list_per_clocktick_1600_,
+							      trigger_structures::tracker_record & a_tracker_record_,
+							      trigger_structures::geiger_matrix * a_geiger_matrix_)
+    {
+      _tracker_algo_.process(geiger_ctw_list_per_clocktick_1600_,
+			     a_tracker_record_);
+      if (a_geiger_matrix_ != 0)
+	{
+	  *a_geiger_matrix_ = _tracker_algo_.get_geiger_matrix_for_a_clocktick();
+	  a_geiger_matrix_->clocktick_1600ns = clocktick_1600ns_;
+	}
+      return;
+    }
+
+    void trigger_algorithm::_process_coincidence_clocktick_1600ns(uint32_t clocktick_1600ns_,
+								  const trigger_structures::tracker_record & a_tracker_record_,
+								  const trigger_structures::geiger_matrix * a_geiger_matrix_,
+								  const trigger_structures::coincidence_calo_record & a_coinc_calo_record_for_pair_)
+    {
+      if (_retention_policy_ >= RETENTION_RECORDS && !a_tracker_record_.is_empty()) _tracker_records_.push_back(a_tracker_record_);
+      if (_retention_policy_ >= RETENTION_FULL_DEBUG && a_geiger_matrix_ != 0 && !a_geiger_matrix_->is_empty()) _geiger_matrix_records_.push_back(*a_geiger_matrix_);
+
+      if (!a_coinc_calo_record_for_pair_.is_empty() || !a_tracker_record_.is_empty())
+	{
+	  std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> pair_for_a_clocktick;
+	  pair_for_a_clocktick.first  = a_coinc_calo_record_for_pair_;
+	  pair_for_a_clocktick.second = a_tracker_record_;
+	  if (_retention_policy_ >= RETENTION_FULL_DEBUG) _pair_records_.push_back(pair_for_a_clocktick);
+
+	  // Process calo tracker coincidence for a clocktick in coinc_algo
+	  // The coincidence process can be process(pair_for_a_ct)
+	  // { CARACO(), APE(), DAVE() }
+	  trigger_structures::coincidence_event_record a_coincidence_event_record;
+	  trigger_structures::L2_decision a_L2_decision;
+
+	  // Check if a L2 decision already exists in the L2 decision gate [CTi-5; CTi[ (unsigned difference : valid across the wrap of the 32 bits clockticks)
+	  bool L2_decision_already_created = false;
+	  if (!_L2_decision_records_.empty()
+	      && (uint32_t)(clocktick_1600ns_ - _L2_decision_records_.back().L2_ct_decision) >= 1
+	      && (uint32_t)(clocktick_1600ns_ - _L2_decision_records_.back().L2_ct_decision) <= _L2_decision_coincidence_gate_size_
+	      && _L2_decision_records_.back().L2_decision_bool)
+	    {
+	      L2_decision_already_created = true;
+	    }
+
+	  // CARACO or APE or DAVE in coinc algo :
+	  _coinc_algo_.process(pair_for_a_clocktick,
+			       a_coincidence_event_record,
+			       a_L2_decision,
+			       _previous_event_records_);
+
+	  if (a_coincidence_event_record.clocktick_1600ns != clock_utils::INVALID_CLOCKTICK
+	      && a_coincidence_event_record.clocktick_1600ns == clocktick_1600ns_
+	      && a_coincidence_event_record.decision == true
+	      && a_coincidence_event_record.trigger_mode != trigger_structures::L2_trigger_mode::INVALID)
+	    {
+	      // Only the coincidence records of the L2 decision gate are needed to build the previous event records :
+	      if (_retention_policy_ < RETENTION_RECORDS) _prune_coincidence_records(clocktick_1600ns_);
+	      _coincidence_records_.push_back(a_coincidence_event_record);
+	    }
+
+	  // L2 decision to push back (not at each clocktick). Only if there is no other L2 decision in the
+	  // L2 decision gate [CTi-5; CTi]
+	  if (a_L2_decision.L2_decision_bool == true
+	      && a_L2_decision.L2_ct_decision != clock_utils::INVALID_CLOCKTICK
+	      && a_L2_decision.L2_trigger_mode != trigger_structures::L2_trigger_mode::INVALID
+	      && L2_decision_already_created == false)
+	    {
+	      _L2_decision_records_.push_back(a_L2_decision);
+	    }
+
+	} // end of if calo is empty || tracker is empty
+
+      // Build a PER only at the end of the L2 decision gate :
+      if (!_L2_decision_records_.empty())
+	{
+	  trigger_structures::L2_decision the_L2_decision = _L2_decision_records_.back();
+
+	  if (clocktick_1600ns_ == (_L2_decision_records_.back().L2_ct_decision + _L2_decision_coincidence_gate_size_)
+	      && (the_L2_decision.L2_trigger_mode == trigger_structures::L2_trigger_mode::CARACO
+		  || the_L2_decision.L2_trigger_mode == trigger_structures::L2_trigger_mode::CALO_TRACKER_TIME_COINC))
+	    {
+	      _build_previous_event_record();
+	    }
+	}
+
+      return;
+    }
+
     void trigger_algorithm::process(const calo_ctw_data & calo_ctw_data_,
 				    const geiger_ctw_data & geiger_ctw_data_)
     {
       DT_THROW_IF(!is_initialized(), std::logic_error, "Trigger algorithm is not initialized, it can't process ! ");
+      DT_THROW_IF(is_streaming(), std::logic_error, "Trigger algorithm is in stream mode, it can't process an event ! ");
       _process(calo_ctw_data_,
     	       geiger_ctw_data_);
       return;
     }
 
+    bool trigger_algorithm::needs_tracker_records() const
+    {
+      return _activate_any_coincidences_ && !_activate_calorimeter_only_;
+    }
+
+    void trigger_algorithm::process_front_end(const calo_ctw_data & calo_ctw_data_,
+					      const geiger_ctw_data & geiger_ctw_data_,
+					      front_end_records & front_end_records_,
+					      bool with_tracker_records_,
+					      bool with_geiger_matrices_)
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Trigger algorithm is not initialized, it can't process ! ");
+      DT_THROW_IF(is_streaming(), std::logic_error, "Trigger algorithm is in stream mode, it can't process an event ! ");
+      _process_front_end(calo_ctw_data_,
+			 geiger_ctw_data_,
+			 front_end_records_,
+			 with_tracker_records_,
+			 with_geiger_matrices_);
+      return;
+    }
+
+    void trigger_algorithm::process_back_end(const front_end_records & front_end_records_)
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Trigger algorithm is not initialized, it can't process ! ");
+      DT_THROW_IF(is_streaming(), std::logic_error, "Trigger algorithm is in stream mode, it can't process an event ! ");
+      DT_THROW_IF(needs_tracker_records() && !front_end_records_.with_tracker_records, std::logic_error, "Front end records are built without tracker records ! ");
+      _process_back_end(front_end_records_);
+      return;
+    }
+
+    void trigger_algorithm::start_stream()
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Trigger algorithm is not initialized, it can't start a stream ! ");
+      DT_THROW_IF(is_streaming(), std::logic_error, "Trigger algorithm stream is already started ! ");
+      _calo_records_25ns_.clear();
+      _coincidence_calo_records_1600ns_.clear();
+      _tracker_records_.clear();
+      _geiger_matrix_records_.clear();
+      _pair_records_.clear();
+      _coincidence_records_.clear();
+      _previous_event_records_.reset(new buffer_previous_event_record_type(_previous_event_circular_buffer_depth_));
+      _L1_calo_decision_records_.clear();
+      _L2_decision_records_.clear();
+      _front_end_records_.reset();
+      _finale_trigger_decision_ = false;
+      _per_to_delete_.first = false;
+      _per_to_delete_.second = -1;
+      _calo_algo_.start_stream();
+      _stream_clocktick_25ns_ = 0;
+      _stream_clocktick_1600ns_ = 0;
+      _stream_last_calo_ctw_25ns_ = INVALID_STREAM_CLOCKTICK;
+      _stream_last_calo_record_25ns_ = INVALID_STREAM_CLOCKTICK;
+      _stream_calo_reference_25ns_ = 0;
+      _stream_geiger_reference_800ns_ = 0;
+      _stream_calo_ctws_.clear();
+      _stream_geiger_ctws_.clear();
+      _stream_coinc_calo_records_.clear();
+      _stream_L1_calo_decisions_.clear();
+      _stream_L2_decisions_.clear();
+      _streaming_ = true;
+      return;
+    }
+
+    bool trigger_algorithm::is_streaming() const
+    {
+      return _streaming_;
+    }
+
+    void trigger_algorithm::push_stream(const calo_ctw_data & calo_ctw_data_,
+					const geiger_ctw_data & geiger_ctw_data_)
+    {
+      DT_THROW_IF(!is_streaming(), std::logic_error, "Trigger algorithm stream is not started, CTWs can't be pushed ! ");
+
+      for (unsigned int i = 0; i < calo_ctw_data_.get_calo_ctws().size(); i++)
+	{
+	  const calo_ctw_data::calo_ctw_handle_type & a_calo_ctw_handle = calo_ctw_data_.get_calo_ctws()[i];
+	  uint64_t clocktick_25ns = _unwrap_stream_clocktick(a_calo_ctw_handle.get().get_clocktick_25ns(), _stream_calo_reference_25ns_);
+	  DT_THROW_IF(clocktick_25ns < _stream_clocktick_25ns_, std::logic_error, "Calo CTW clocktick [" << clocktick_25ns << "] is older than the stream time [" << _stream_clocktick_25ns_ << "] ! ");
+	  _stream_calo_ctws_[clocktick_25ns].push_back(a_calo_ctw_handle);
+	  if (clocktick_25ns > _stream_calo_reference_25ns_) _stream_calo_reference_25ns_ = clocktick_25ns;
+	}
+
+      // Geiger CTWs are only used by the coincidence trigger :
+      if (!_activate_any_coincidences_ || _activate_calorimeter_only_) return;
+
+      // Add only 1 of 2 gg ctw data due to data transfer limitation (CB to TB)
+      for (unsigned int i = 0; i < geiger_ctw_data_.get_geiger_ctws().size(); i++)
+	{
+	  const geiger_ctw & a_gg_ctw = geiger_ctw_data_.get_geiger_ctws()[i].get();
+	  uint64_t clocktick_800ns = _unwrap_stream_clocktick(a_gg_ctw.get_clocktick_800ns(), _stream_geiger_reference_800ns_);
+	  if (clocktick_800ns > _stream_geiger_reference_800ns_) _stream_geiger_reference_800ns_ = clocktick_800ns;
+	  if (clocktick_800ns % 2 != 0) continue;
+	  // Convert CT 800 into CT 1600 :
+	  uint64_t clocktick_1600ns = clock_utils::clocktick_800ns_to_1600ns(clocktick_800ns);
+	  DT_THROW_IF(clocktick_1600ns < _stream_clocktick_1600ns_, std::logic_error, "Geiger CTW clocktick [" << clocktick_800ns << "] is older than the stream time [" << _stream_clocktick_1600ns_ << "] ! ");
+	  geiger_ctw_data::geiger_ctw_handle_type to_add_gg_ctw(new geiger_ctw(a_gg_ctw));
+	  to_add_gg_ctw.grab().set_clocktick_800ns((uint32_t) clocktick_1600ns);
+	  _stream_geiger_ctws_[clocktick_1600ns].push_back(to_add_gg_ctw);
+	}
+
+      return;
+    }
+
+    void trigger_algorithm::advance_stream(uint64_t clocktick_1600ns_)
+    {
+      DT_THROW_IF(!is_streaming(), std::logic_error, "Trigger algorithm stream is not started, it can't advance ! ");
+      if (clocktick_1600ns_ <= _stream_clocktick_1600ns_) return;
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_TRIGGER);
+
+      // The collections only hold the records of the last advance, except the
+      // last L2 decision (L2 decision gate) and the coincidence records of the
+      // L2 decision gate (previous event record building) :
+      _calo_records_25ns_.clear();
+      _coincidence_calo_records_1600ns_.clear();
+      _tracker_records_.clear();
+      _geiger_matrix_records_.clear();
+      _pair_records_.clear();
+      _L1_calo_decision_records_.clear();
+      if (_L2_decision_records_.size() > 1) _L2_decision_records_.erase(_L2_decision_records_.begin(), _L2_decision_records_.end() - 1);
+      _prune_coincidence_records((uint32_t) _stream_clocktick_1600ns_);
+
+      _process_stream_calorimeter(clocktick_1600ns_);
+      if (_activate_any_coincidences_ && !_activate_calorimeter_only_)
+	{
+	  _process_stream_clockticks_1600ns(clocktick_1600ns_);
+	}
+      if (!_L2_decision_records_.empty()) _finale_trigger_decision_ = true;
+      _stream_clocktick_1600ns_ = clocktick_1600ns_;
+
+      // Unwrapping references follow the stream time :
+      const uint64_t clocktick_25ns = _stream_clocktick_25ns_;
+      const uint64_t clocktick_800ns = clock_utils::first_clocktick_800ns_of_1600ns(_stream_clocktick_1600ns_);
+      if (clocktick_25ns > _stream_calo_reference_25ns_) _stream_calo_reference_25ns_ = clocktick_25ns;
+      if (clocktick_800ns > _stream_geiger_reference_800ns_) _stream_geiger_reference_800ns_ = clocktick_800ns;
+      return;
+    }
+
+    void trigger_algorithm::flush_stream()
+    {
+      DT_THROW_IF(!is_streaming(), std::logic_error, "Trigger algorithm stream is not started, it can't be flushed ! ");
+      uint64_t last_clocktick_1600ns = INVALID_STREAM_CLOCKTICK;
+      uint64_t last_calo_clocktick_25ns = _stream_last_calo_ctw_25ns_;
+      if (!_stream_calo_ctws_.empty()) last_calo_clocktick_25ns = _stream_calo_ctws_.rbegin()->first;
+      if (last_calo_clocktick_25ns != INVALID_STREAM_CLOCKTICK)
+	{
+	  // End of the calorimeter gate then end of the coincidence calorimeter gate :
+	  last_clocktick_1600ns = clock_utils::clocktick_25ns_to_1600ns(last_calo_clocktick_25ns + _calo_algo_.get_circular_buffer_depth() - 1)
+	    + _coincidence_calorimeter_gate_size_;
+	}
+      if (!_stream_geiger_ctws_.empty()
+	  && (last_clocktick_1600ns == INVALID_STREAM_CLOCKTICK || _stream_geiger_ctws_.rbegin()->first > last_clocktick_1600ns))
+	{
+	  last_clocktick_1600ns = _stream_geiger_ctws_.rbegin()->first;
+	}
+      if (last_clocktick_1600ns != INVALID_STREAM_CLOCKTICK)
+	{
+	  // Previous event record building at the end of the L2 decision gate :
+	  advance_stream(last_clocktick_1600ns + _L2_decision_coincidence_gate_size_ + 1);
+	}
+      return;
+    }
+
+    void trigger_algorithm::stop_stream()
+    {
+      DT_THROW_IF(!is_streaming(), std::logic_error, "Trigger algorithm stream is not started, it can't be stopped ! ");
+      _stream_calo_ctws_.clear();
+      _stream_geiger_ctws_.clear();
+      _stream_coinc_calo_records_.clear();
+      _streaming_ = false;
+      return;
+    }
+
+    uint64_t trigger_algorithm::get_stream_clocktick_1600ns() const
+    {
+      return _stream_clocktick_1600ns_;
+    }
+
+    std::size_t trigger_algorithm::get_stream_backlog_size() const
+    {
+      std::size_t backlog_size = _stream_coinc_calo_records_.size() + _coincidence_records_.size() + _L2_decision_records_.size();
+      for (std::map<uint64_t, calo_ctw_data::calo_ctw_collection_type>::const_iterator it = _stream_calo_ctws_.begin(); it != _stream_calo_ctws_.end(); it++)
+	{
+	  backlog_size += it->second.size();
+	}
+      for (std::map<uint64_t, geiger_ctw_data::geiger_ctw_collection_type>::const_iterator it = _stream_geiger_ctws_.begin(); it != _stream_geiger_ctws_.end(); it++)
+	{
+	  backlog_size += it->second.size();
+	}
+      if (_previous_event_records_) backlog_size += _previous_event_records_->size();
+      return backlog_size;
+    }
+
+    bool trigger_algorithm::has_stream_L1_calo_decision() const
+    {
+      return !_stream_L1_calo_decisions_.empty();
+    }
+
+    trigger_structures::L1_calo_decision trigger_algorithm::pop_stream_L1_calo_decision()
+    {
+      DT_THROW_IF(!has_stream_L1_calo_decision(), std::logic_error, "No L1 calo decision emitted by the stream ! ");
+      trigger_structures::L1_calo_decision a_L1_calo_decision = _stream_L1_calo_decisions_.front();
+      _stream_L1_calo_decisions_.pop_front();
+      return a_L1_calo_decision;
+    }
+
+    bool trigger_algorithm::has_stream_L2_decision() const
+    {
+      return !_stream_L2_decisions_.empty();
+    }
+
+    trigger_structures::L2_decision trigger_algorithm::pop_stream_L2_decision()
+    {
+      DT_THROW_IF(!has_stream_L2_decision(), std::logic_error, "No L2 decision emitted by the stream ! ");
+      trigger_structures::L2_decision a_L2_decision = _stream_L2_decisions_.front();
+      _stream_L2_decisions_.pop_front();
+      return a_L2_decision;
+    }
+
+    uint64_t trigger_algorithm::_unwrap_stream_clocktick(uint32_t clocktick_, uint64_t reference_)
+    {
+      int32_t delta = (int32_t)(clocktick_ - (uint32_t) reference_);
+      if (delta < 0 && (uint64_t)(-(int64_t) delta) > reference_) return clocktick_;
+      return reference_ + (int64_t) delta;
+    }
+
+    void trigger_algorithm::_process_stream_calorimeter(uint64_t clocktick_1600ns_)
+    {
+      // Calorimeter clockticks 25 ns contributing to the clockticks 1600 ns before the limit :
+      const uint64_t clocktick_25ns_limit = clock_utils::first_clocktick_25ns_of_1600ns(clocktick_1600ns_);
+      const uint64_t gate_depth = _calo_algo_.get_circular_buffer_depth();
+      uint64_t iclocktick = _stream_clocktick_25ns_;
+      while (true)
+	{
+	  // Skip the idle clockticks once the calorimeter gate is drained :
+	  if (_stream_last_calo_ctw_25ns_ == INVALID_STREAM_CLOCKTICK || iclocktick >= _stream_last_calo_ctw_25ns_ + gate_depth)
+	    {
+	      if (_stream_calo_ctws_.empty()) break;
+	      if (_stream_calo_ctws_.begin()->first > iclocktick) iclocktick = _stream_calo_ctws_.begin()->first;
+	    }
+	  if (iclocktick >= clocktick_25ns_limit) break;
+
+	  calo_ctw_data::calo_ctw_collection_type ctw_list_per_clocktick;
+	  if (!_stream_calo_ctws_.empty() && _stream_calo_ctws_.begin()->first == iclocktick)
+	    {
+	      ctw_list_per_clocktick.swap(_stream_calo_ctws_.begin()->second);
+	      _stream_calo_ctws_.erase(_stream_calo_ctws_.begin());
+	      _stream_last_calo_ctw_25ns_ = iclocktick;
+	    }
+	  std::size_t number_of_calo_records = _calo_records_25ns_.size();
+	  _calo_algo_.process_clocktick((uint32_t) iclocktick, ctw_list_per_clocktick, _calo_records_25ns_);
+	  if (_calo_records_25ns_.size() != number_of_calo_records)
+	    {
+	      _process_stream_calo_record(_calo_records_25ns_.back(), iclocktick);
+	      if (_retention_policy_ < RETENTION_RECORDS) _calo_records_25ns_.pop_back();
+	    }
+	  iclocktick++;
+	}
+      if (clocktick_25ns_limit > _stream_clocktick_25ns_) _stream_clocktick_25ns_ = clocktick_25ns_limit;
+      return;
+    }
+
+    void trigger_algorithm::_process_stream_calo_record(const trigger_structures::calo_summary_record & a_calo_record_25ns_,
+							uint64_t clocktick_25ns_)
+    {
+      // Create calo L1 decision at the beginning of contiguous calo records :
+      if ((_stream_last_calo_record_25ns_ == INVALID_STREAM_CLOCKTICK || clocktick_25ns_ != _stream_last_calo_record_25ns_ + 1) && a_calo_record_25ns_.calo_finale_decision == true)
+	{
+	  trigger_structures::L1_calo_decision a_L1_calo_decision_25ns;
+	  a_L1_calo_decision_25ns.L1_calo_decision_bool = true;
+	  a_L1_calo_decision_25ns.L1_calo_ct_decision = a_calo_record_25ns_.clocktick_25ns;
+	  _L1_calo_decision_records_.push_back(a_L1_calo_decision_25ns);
+	  _stream_L1_calo_decisions_.push_back(a_L1_calo_decision_25ns);
+
+	  // Configuration is calorimeter only : L1 = L2
+	  if (_activate_calorimeter_only_ && !_activate_any_coincidences_)
+	    {
+	      trigger_structures::L2_decision a_L2_decision;
+	      a_L2_decision.L2_decision_bool = true;
+	      a_L2_decision.L2_ct_decision = a_L1_calo_decision_25ns.L1_calo_ct_decision;
+	      a_L2_decision.L2_trigger_mode = trigger_structures::CALO_ONLY;
+	      _L2_decision_records_.push_back(a_L2_decision);
+	      _stream_L2_decisions_.push_back(a_L2_decision);
+	    }
+	}
+      _stream_last_calo_record_25ns_ = clocktick_25ns_;
+
+      // Rescaling calorimeter 25 ns at 1600 ns and extension during the coincidence calorimeter gate :
+      if (_activate_any_coincidences_ && !_activate_calorimeter_only_ && a_calo_record_25ns_.calo_finale_decision == true)
+	{
+	  const uint64_t clocktick_1600ns = clock_utils::clocktick_25ns_to_1600ns(clocktick_25ns_);
+	  std::pair<std::map<uint64_t, trigger_structures::coincidence_calo_record>::iterator, bool> inserted
+	    = _stream_coinc_calo_records_.insert(std::make_pair(clocktick_1600ns, trigger_structures::coincidence_calo_record()));
+	  trigger_structures::coincidence_calo_record & a_coinc_calo_record = inserted.first->second;
+	  if (inserted.second) a_coinc_calo_record.clocktick_1600ns = (uint32_t) clocktick_1600ns;
+	  _update_coinc_calo_record(a_calo_record_25ns_, a_coinc_calo_record);
+
+	  for (uint64_t iclocktick = clocktick_1600ns + 1; iclocktick <= clocktick_1600ns + _coincidence_calorimeter_gate_size_; iclocktick++)
+	    {
+	      trigger_structures::coincidence_calo_record & on_gate_coinc_calo_record = _stream_coinc_calo_records_[iclocktick];
+	      on_gate_coinc_calo_record = a_coinc_calo_record;
+	      on_gate_coinc_calo_record.clocktick_1600ns = (uint32_t) iclocktick;
+	    }
+	}
+
+      return;
+    }
+
+    uint64_t trigger_algorithm::_next_stream_clocktick_1600ns(uint64_t clocktick_1600ns_) const
+    {
+      uint64_t next_clocktick = INVALID_STREAM_CLOCKTICK;
+      if (!_stream_geiger_ctws_.empty()) next_clocktick = std::min(next_clocktick, _stream_geiger_ctws_.begin()->first);
+      if (!_stream_coinc_calo_records_.empty()) next_clocktick = std::min(next_clocktick, _stream_coinc_calo_records_.begin()->first);
+
+      // Previous event record building at the end of the L2 decision gate :
+      const uint32_t clocktick_1600ns = clocktick_1600ns_;
+      if (!_L2_decision_records_.empty()
+	  && (_L2_decision_records_.back().L2_trigger_mode == trigger_structures::L2_trigger_mode::CARACO
+	      || _L2_decision_records_.back().L2_trigger_mode == trigger_structures::L2_trigger_mode::CALO_TRACKER_TIME_COINC))
+	{
+	  uint64_t L2_decision_clocktick = clocktick_1600ns_ - (uint32_t)(clocktick_1600ns - _L2_decision_records_.back().L2_ct_decision);
+	  uint64_t per_building_clocktick = L2_decision_clocktick + _L2_decision_coincidence_gate_size_;
+	  if (per_building_clocktick >= clocktick_1600ns_) next_clocktick = std::min(next_clocktick, per_building_clocktick);
+	}
+
+      // Death (counter set to 0) then deletion of the previous event records :
+      if (_previous_event_records_)
+	{
+	  for (buffer_previous_event_record_type::const_iterator it_circ = _previous_event_records_->begin(); it_circ != _previous_event_records_->end(); it_circ++)
+	    {
+	      uint64_t previous_clocktick = clocktick_1600ns_ - (uint32_t)(clocktick_1600ns - it_circ->previous_clocktick_1600ns);
+	      uint64_t death_clocktick = previous_clocktick + clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK;
+	      if (death_clocktick >= clocktick_1600ns_) next_clocktick = std::min(next_clocktick, death_clocktick);
+	      else if (death_clocktick + 1 >= clocktick_1600ns_) next_clocktick = std::min(next_clocktick, death_clocktick + 1);
+	    }
+	}
+
+      return next_clocktick;
+    }
+
+    void trigger_algorithm::_process_stream_clockticks_1600ns(uint64_t clocktick_1600ns_)
+    {
+      uint64_t ict1600 = _stream_clocktick_1600ns_;
+      while (true)
+	{
+	  ict1600 = _next_stream_clocktick_1600ns(ict1600);
+	  if (ict1600 == INVALID_STREAM_CLOCKTICK || ict1600 >= clocktick_1600ns_) break;
+	  FLDIGI_INSTRUMENT_COUNT(COUNTER_TRIGGER_CLOCKTICKS_1600NS, 1);
+
+	  // Decrease PERs counters if exist and delete if a counter is set to 0.
+	  _update_previous_event_records((uint32_t) ict1600);
+
+	  geiger_ctw_data::geiger_ctw_collection_type geiger_ctw_list_per_clocktick_1600;
+	  if (!_stream_geiger_ctws_.empty() && _stream_geiger_ctws_.begin()->first == ict1600)
+	    {
+	      geiger_ctw_list_per_clocktick_1600.swap(_stream_geiger_ctws_.begin()->second);
+	      _stream_geiger_ctws_.erase(_stream_geiger_ctws_.begin());
+	    }
+
+	  trigger_structures::coincidence_calo_record a_coinc_calo_record_for_pair;
+	  a_coinc_calo_record_for_pair.clocktick_1600ns = (uint32_t) ict1600;
+	  if (!_stream_coinc_calo_records_.empty() && _stream_coinc_calo_records_.begin()->first == ict1600)
+	    {
+	      a_coinc_calo_record_for_pair = _stream_coinc_calo_records_.begin()->second;
+	      _stream_coinc_calo_records_.erase(_stream_coinc_calo_records_.begin());
+	      if (_retention_policy_ >= RETENTION_RECORDS) _coincidence_calo_records_1600ns_.push_back(a_coinc_calo_record_for_pair);
+	    }
+
+	  std::size_t number_of_L2_decisions = _L2_decision_records_.size();
+	  _process_clocktick_1600ns((uint32_t) ict1600,
+				    geiger_ctw_list_per_clocktick_1600,
+				    a_coinc_calo_record_for_pair);
+	  if (_L2_decision_records_.size() != number_of_L2_decisions) _stream_L2_decisions_.push_back(_L2_decision_records_.back());
+	  ict1600++;
+	}
+      return;
+    }
+
     void trigger_algorithm::_process(const calo_ctw_data & calo_ctw_data_,
 				     const geiger_ctw_data & geiger_ctw_data_)
     {
-      _previous_event_records_.reset(new buffer_previous_event_record_type(_previous_event_circular_buffer_depth_));
-      snemo::digitization::geiger_ctw_data geiger_ctw_data_1600ns;
+      FLDIGI_INSTRUMENT_SCOPE(STAGE_TRIGGER);
+      _process_front_end(calo_ctw_data_,
+			 geiger_ctw_data_,
+			 _front_end_records_,
+			 needs_tracker_records(),
+			 _retention_policy_ >= RETENTION_FULL_DEBUG);
+      _process_back_end(_front_end_records_);
+      return;
+    }
+
+    void trigger_algorithm::_process_front_end(const calo_ctw_data & calo_ctw_data_,
+					       const geiger_ctw_data & geiger_ctw_data_,
+					       front_end_records & front_end_records_,
+					       bool with_tracker_records_,
+					       bool with_geiger_matrices_)
+    {
+      front_end_records_.reset();
+
+      // Process the calorimeter algorithm at 25 ns to create calo record at 25 ns
+      _calo_algo_.process(calo_ctw_data_,
+			  front_end_records_.calo_records_25ns);
 
+      if (!with_tracker_records_) return;
+      front_end_records_.with_tracker_records = true;
+
+      snemo::digitization::geiger_ctw_data geiger_ctw_data_1600ns;
       // Add only 1 of 2 gg ctw data due to data transfer limitation (CB to TB)
       for (unsigned int i = 0; i < geiger_ctw_data_.get_geiger_ctws().size(); i++)
       	{
@@ -621,22 +1280,59 @@ namespace snemo {
       	      snemo::digitization::geiger_ctw & to_add_gg_ctw = geiger_ctw_data_1600ns.add();
       	      to_add_gg_ctw = a_gg_ctw;
       	      // Convert CT 800 into CT 1600 :
-      	      uint32_t gg_ctw_clocktick_1600ns = clock_utils::INVALID_CLOCKTICK;
-      	      _clock_manager_->compute_clocktick_800ns_to_1600ns(a_gg_ctw.get_clocktick_800ns(),
-      								 gg_ctw_clocktick_1600ns);
-      	      to_add_gg_ctw.set_clocktick_800ns(gg_ctw_clocktick_1600ns);
+      	      to_add_gg_ctw.set_clocktick_800ns(clock_utils::clocktick_800ns_to_1600ns(a_gg_ctw.get_clocktick_800ns()));
       	    }
       	}
+      if (geiger_ctw_data_1600ns.get_geiger_ctws().size() == 0) return;
+      front_end_records_.tracker_clocktick_min_1600ns = geiger_ctw_data_1600ns.get_clocktick_min();
+      front_end_records_.tracker_clocktick_max_1600ns = geiger_ctw_data_1600ns.get_clocktick_max();
 
-      // Process the calorimeter algorithm at 25 ns to create calo record at 25 ns
-      _calo_algo_.process(calo_ctw_data_,
-			  _calo_records_25ns_);
+      // Gather the Geiger CTWs per clocktick 1600 ns then process the tracker algorithm for each of them :
+      std::map<uint32_t, geiger_ctw_data::geiger_ctw_collection_type> geiger_ctw_lists_per_clocktick_1600;
+      for (unsigned int i = 0; i < geiger_ctw_data_1600ns.get_geiger_ctws().size(); i++)
+	{
+	  const geiger_ctw_data::geiger_ctw_handle_type & a_gg_ctw_handle = geiger_ctw_data_1600ns.get_geiger_ctws()[i];
+	  if (a_gg_ctw_handle.get().has_trigger_primitive_values())
+	    {
+	      geiger_ctw_lists_per_clocktick_1600[a_gg_ctw_handle.get().get_clocktick_800ns()].push_back(a_gg_ctw_handle);
+	    }
+	}
+      front_end_records_.tracker_records.reserve(geiger_ctw_lists_per_clocktick_1600.size());
+      if (with_geiger_matrices_) front_end_records_.geiger_matrix_records.reserve(geiger_ctw_lists_per_clocktick_1600.size());
+      std::map<uint32_t, geiger_ctw_data::geiger_ctw_collection_type>::const_iterator it_list = geiger_ctw_lists_per_clocktick_1600.begin();
+      for (; it_list != geiger_ctw_lists_per_clocktick_1600.end(); it_list++)
+	{
+	  front_end_records_.tracker_records.push_back(trigger_structures::tracker_record());
+	  trigger_structures::tracker_record & a_tracker_record = front_end_records_.tracker_records.back();
+	  a_tracker_record.clocktick_1600ns = it_list->first;
+	  trigger_structures::geiger_matrix * a_geiger_matrix = 0;
+	  if (with_geiger_matrices_)
+	    {
+	      front_end_records_.geiger_matrix_records.push_back(trigger_structures::geiger_matrix());
+	      a_geiger_matrix = &front_end_records_.geiger_matrix_records.back();
+	    }
+	  _process_tracker_clocktick_1600ns(it_list->first,
+					    it_list->second,
+					    a_tracker_record,
+					    a_geiger_matrix);
+	}
+      return;
+    }
+
+    void trigger_algorithm::_process_back_end(const front_end_records & front_end_records_)
+    {
+      _previous_event_records_.reset(new buffer_previous_event_record_type(_previous_event_circular_buffer_depth_));
+      if (_retention_policy_ >= RETENTION_RECORDS)
+	{
+	  _calo_records_25ns_.insert(_calo_records_25ns_.end(), front_end_records_.calo_records_25ns.begin(), front_end_records_.calo_records_25ns.end());
+	}
+      const std::vector<trigger_structures::calo_summary_record> & calo_records_25ns = front_end_records_.calo_records_25ns;
 
       uint32_t last_calo_ct_25ns = clock_utils::INVALID_CLOCKTICK;
       // Create calo L1 decision(s) :
-      for (unsigned int i = 0; i < _calo_records_25ns_.size(); i++)
+      for (unsigned int i = 0; i < calo_records_25ns.size(); i++)
 	{
-	  trigger_structures::calo_summary_record a_calo_record_25ns = _calo_records_25ns_[i];
+	  const trigger_structures::calo_summary_record & a_calo_record_25ns = calo_records_25ns[i];
 
 	  uint32_t calo_record_ct_25ns = a_calo_record_25ns.clocktick_25ns;
 
@@ -673,7 +1369,7 @@ namespace snemo {
       // Any coincidences are activated and calo only is not activated, rescaling calorimeter at 1600 ns in any case
       else if (_activate_any_coincidences_ && !_activate_calorimeter_only_)
 	{
-	  _rescale_calo_records_at_1600ns(_calo_records_25ns_,
+	  _rescale_calo_records_at_1600ns(calo_records_25ns,
 	  				  _coincidence_calo_records_1600ns_);
 
 	  // Calculate the ct 1600 minimum and ct 1600 maximum :
@@ -688,10 +1384,10 @@ namespace snemo {
 	      calorimeter_ct_max_1600 = _coincidence_calo_records_1600ns_.back().clocktick_1600ns;
 	    }
 
-	  if (geiger_ctw_data_1600ns.get_geiger_ctws().size() != 0)
+	  if (front_end_records_.tracker_clocktick_min_1600ns != clock_utils::INVALID_CLOCKTICK)
 	    {
-	      tracker_ct_min_1600 = geiger_ctw_data_1600ns.get_clocktick_min();
-	      tracker_ct_max_1600 = geiger_ctw_data_1600ns.get_clocktick_max();
+	      tracker_ct_min_1600 = front_end_records_.tracker_clocktick_min_1600ns;
+	      tracker_ct_max_1600 = front_end_records_.tracker_clocktick_max_1600ns;
 	    }
 
 	  uint32_t clocktick_min = clock_utils::INVALID_CLOCKTICK;
@@ -715,77 +1411,35 @@ namespace snemo {
 	  if (clocktick_min != clock_utils::INVALID_CLOCKTICK && clocktick_max != clock_utils::INVALID_CLOCKTICK)
 	    {
 	      // Maybe time optimisation to do here, is it mandatory to go for each clocktick ?
-	      // Maybe prepare tracker record outside this loop but it breaks the time implementation (close to the electronics)
-
-	      std::pair <bool, unsigned int> per_to_delete;
-	      per_to_delete.first = false;
-	      per_to_delete.second = -1;
+	      // The tracker records are prepared by the front end, only the gates and coincidences are processed for each clocktick
+
+	      _per_to_delete_.first = false;
+	      _per_to_delete_.second = -1;
+	      FLDIGI_INSTRUMENT_COUNT(COUNTER_TRIGGER_CLOCKTICKS_1600NS, clocktick_max - clocktick_min + 1);
+	      // Time ordered tracker records of the front end, a clocktick without Geiger CTW has an empty tracker record :
+	      const bool with_geiger_matrices = front_end_records_.geiger_matrix_records.size() == front_end_records_.tracker_records.size();
+	      std::size_t tracker_index = 0;
 	      for (uint32_t ict1600 = clocktick_min; ict1600 <= clocktick_max; ict1600++)
 		{
 		  //std::clog << "************* CT1600 : " << ict1600 << " ****************" <<std::endl;
 
 		  // Decrease PERs counters if exist and delete if a counter is set to 0.
-		  if (!_previous_event_records_->empty())
+		  _update_previous_event_records(ict1600);
+
+		  trigger_structures::tracker_record no_tracker_record;
+		  const trigger_structures::tracker_record * a_tracker_record = &no_tracker_record;
+		  const trigger_structures::geiger_matrix * a_geiger_matrix = 0;
+		  while (tracker_index < front_end_records_.tracker_records.size()
+			 && front_end_records_.tracker_records[tracker_index].clocktick_1600ns < ict1600) tracker_index++;
+		  if (tracker_index < front_end_records_.tracker_records.size()
+		      && front_end_records_.tracker_records[tracker_index].clocktick_1600ns == ict1600)
 		    {
-		      // _previous_event_records_->back().counter_1600ns = clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK - ict1600 + _previous_event_records_->back().previous_clocktick_1600ns;
-		      // std::clog << "CT PER = " << _previous_event_records_->back().previous_clocktick_1600ns << " counter = " <<
-		      // 	_previous_event_records_->back().counter_1600ns << std::endl;
-
-		      auto it_circ = _previous_event_records_->begin();
-		      unsigned int pers_counter = 0;
-		      if (per_to_delete.first)
-			{
-			  if (_previous_event_records_->size() > 1)
-			    {
-			      _previous_event_records_->erase(_previous_event_records_->begin() + per_to_delete.second);
-			    }
-			  else if (_previous_event_records_->size() == 1)
-			    {
-			      _previous_event_records_->clear();
-			    }
-			  per_to_delete.first = false;
-			  per_to_delete.second = -1;
-			}
-
-		      // Problem here : counter 1600 on it_circ gives a strange value
-		      for (; it_circ != _previous_event_records_->end(); it_circ++)
-			{
-			  DT_THROW_IF(it_circ->counter_1600ns > clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK, std::logic_error, "Previous Event Record counter out of bounds [0;clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK (625)] !");
-			  if (it_circ->counter_1600ns <= clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK)
-			    {
-			      int counter_result = clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK - ict1600 + it_circ->previous_clocktick_1600ns;
-			      if (counter_result <= 0) counter_result = 0;
-			      it_circ->counter_1600ns = counter_result;
-			      // std::clog << "CT PER = " << it_circ->previous_clocktick_1600ns << " counter = " << it_circ->counter_1600ns << std::endl;
-			    }
-			  if (it_circ->counter_1600ns == 0)
-			    {
-			      // PER has to be erased in the circular buffer because the counter equal to 0.
-			      // Flag to remember this per has to be delete:
-			      per_to_delete.first = true;
-			      per_to_delete.second = pers_counter;
-			    }
-			}
-		      pers_counter++;
+		      a_tracker_record = &front_end_records_.tracker_records[tracker_index];
+		      if (with_geiger_matrices) a_geiger_matrix = &front_end_records_.geiger_matrix_records[tracker_index];
 		    }
-
-		  // std::clog << "Size of PERs = " << _previous_event_records_->size() << " Empty : " << _previous_event_records_->empty() << std::endl;
-
-		  trigger_structures::tracker_record a_tracker_record;
-		  a_tracker_record.clocktick_1600ns = ict1600;
-
-
-		  if (geiger_ctw_data_1600ns.get_geiger_ctws().size() != 0)
+		  else
 		    {
-		      geiger_ctw_data::geiger_ctw_collection_type geiger_ctw_list_per_clocktick_1600;
-		      geiger_ctw_data_1600ns.get_list_of_geiger_ctw_per_clocktick(ict1600, geiger_ctw_list_per_clocktick_1600);
-		      _tracker_algo_.process(geiger_ctw_list_per_clocktick_1600,
-					     a_tracker_record);
-		      if (!a_tracker_record.is_empty()) _tracker_records_.push_back(a_tracker_record);
-
-		      trigger_structures::geiger_matrix a_geiger_matrix = _tracker_algo_.get_geiger_matrix_for_a_clocktick();
-		      a_geiger_matrix.clocktick_1600ns = ict1600;
-		      if (!a_geiger_matrix.is_empty()) _geiger_matrix_records_.push_back(a_geiger_matrix);
+		      no_tracker_record.clocktick_1600ns = ict1600;
 		    }
 
 		  trigger_structures::coincidence_calo_record a_coinc_calo_record_for_pair;
@@ -800,77 +1454,24 @@ namespace snemo {
 			}
 		    }
 
-		  if (!a_coinc_calo_record_for_pair.is_empty() || !a_tracker_record.is_empty())
-		    {
-		      std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> pair_for_a_clocktick;
-		      pair_for_a_clocktick.first  = a_coinc_calo_record_for_pair;
-		      pair_for_a_clocktick.second = a_tracker_record;
-		      _pair_records_.push_back(pair_for_a_clocktick);
-
-		      // Process calo tracker coincidence for a clocktick in coinc_algo
-		      // The coincidence process can be process(pair_for_a_ct)
-		      // { CARACO(), APE(), DAVE() }
-		      trigger_structures::coincidence_event_record a_coincidence_event_record;
-		      trigger_structures::L2_decision a_L2_decision;
-
-		      bool L2_decision_already_created = false;
-		      // Maybe check if a L2_decision already exist before coinc processing ?
-
-		      if (!_L2_decision_records_.empty()
-			  && (int)_L2_decision_records_.back().L2_ct_decision >= (int)((ict1600 - _L2_decision_coincidence_gate_size_))
-			  && _L2_decision_records_.back().L2_ct_decision < ict1600
-			  && _L2_decision_records_.back().L2_decision_bool)
-			{
-			  L2_decision_already_created = true;
-			}
-
-		      // CARACO or APE or DAVE in coinc algo :
-		      _coinc_algo_.process(pair_for_a_clocktick,
-					   a_coincidence_event_record,
-					   a_L2_decision,
-					   _previous_event_records_);
-
-		      if (a_coincidence_event_record.clocktick_1600ns != clock_utils::INVALID_CLOCKTICK
-			  && a_coincidence_event_record.clocktick_1600ns == ict1600
-			  && a_coincidence_event_record.decision == true
-			  && a_coincidence_event_record.trigger_mode != trigger_structures::L2_trigger_mode::INVALID)
-			{
-			  _coincidence_records_.push_back(a_coincidence_event_record);
-			}
-
-		      // L2 decision to push back (not at each clocktick). Only if there is no other L2 decision in the
-		      // L2 decision gate [CTi-5; CTi]
-		      if (a_L2_decision.L2_decision_bool == true
-			  && a_L2_decision.L2_ct_decision != clock_utils::INVALID_CLOCKTICK
-			  && a_L2_decision.L2_trigger_mode != trigger_structures::L2_trigger_mode::INVALID
-			  && L2_decision_already_created == false)
-			{
-			  _L2_decision_records_.push_back(a_L2_decision);
-			}
-
-		    } // end of if calo is empty || tracker is empty
-
-		  // Build a PER only at the end of the L2 decision gate :
-		  if (!_L2_decision_records_.empty())
-		    {
-		      // std::clog << "L2 ct + L2 decision = " << _L2_decision_records_.back().L2_ct_decision + _L2_decision_coincidence_gate_size_ << " ict = " << ict1600 << std::endl;
-
-		      trigger_structures::L2_decision the_L2_decision = _L2_decision_records_.back();
-
-		      if (ict1600 == (_L2_decision_records_.back().L2_ct_decision + _L2_decision_coincidence_gate_size_)
-			  && (the_L2_decision.L2_trigger_mode == trigger_structures::L2_trigger_mode::CARACO
-			      || the_L2_decision.L2_trigger_mode == trigger_structures::L2_trigger_mode::CALO_TRACKER_TIME_COINC))
-			{
-			  _build_previous_event_record();
-			}
-		    }
-
+		  _process_coincidence_clocktick_1600ns(ict1600,
+							*a_tracker_record,
+							a_geiger_matrix,
+							a_coinc_calo_record_for_pair);
 		} // end of ict1600
 
 	    } // end of if ct min
 
 	} // end of else if any_coinc
 
+      if (!_L2_decision_records_.empty()) _finale_trigger_decision_ = true;
+
+      // The calo records are only needed during the process :
+      if (_retention_policy_ < RETENTION_RECORDS)
+	{
+	  _calo_records_25ns_.clear();
+	  _coincidence_calo_records_1600ns_.clear();
+	}
 
       // for (unsigned int i = 0; i < _coincidence_calo_records_1600ns_.size(); i++)
       // 	{
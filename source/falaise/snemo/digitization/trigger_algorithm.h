@@ -8,6 +8,10 @@
 // Standard library :
 #include <string>
 #include <bitset>
+#include <map>
+#include <deque>
+#include <limits>
+#include <memory>
 
 // This project :
 #include <snemo/digitization/calo_ctw_data.h>
@@ -28,10 +32,67 @@ namespace snemo {
   namespace digitization {
 
     /// \brief Full trigger algorithm for the process. The trigger decision is taken here.
+    ///
+    /// Two processing modes are available :
+    ///  - event mode (process) : the CTWs of an event are processed in isolation,
+    ///    the clocks start at the first CTW of the event,
+    ///  - stream mode (start_stream, push_stream, advance_stream, flush_stream) :
+    ///    time ordered CTWs are processed continuously, the calorimeter 25 ns and
+    ///    the trigger 1600 ns clocks (and the previous event records) run across
+    ///    event boundaries. Idle clockticks are skipped and the consumed data are
+    ///    released, so the memory is bounded by the activity of the detector, not
+    ///    by the simulated time. L1 and L2 decisions are emitted in FIFOs.
+    ///
+    /// In stream mode the 32 bits CTW clockticks are unwrapped into 64 bits
+    /// clockticks : the CTWs pushed must be within 2^31 clockticks of the stream
+    /// time (53 s for the calorimeter). The clockticks of the emitted decisions
+    /// are the 32 bits clockticks of the CTWs.
+    ///
+    /// The event mode is split in a front end (CTWs decoding, calorimeter records,
+    /// tracker records) which only depends on the calorimeter and tracker
+    /// configurations, and a back end (gates, coincidences and decisions). The front
+    /// end products of an event can be evaluated by several back ends (see trigger_scan).
+    ///
+    /// The retention policy ('general' section key 'retention_policy') selects
+    /// the products kept after a process : the decisions only (production), the
+    /// trigger records too, or all the intermediate products ('full_debug', the
+    /// default, needed by the trigger display and the trigger records writer).
+    /// Products which are not kept are not copied at all.
     class trigger_algorithm
     {
  		public :
 
+			/// Invalid value for a stream clocktick
+			static const uint64_t INVALID_STREAM_CLOCKTICK = std::numeric_limits<uint64_t>::max();
+
+			/// Trigger products kept after a process (each policy keeps the products of the previous one)
+			enum retention_policy_type {
+				RETENTION_UNDEFINED  = -1,
+				RETENTION_DECISIONS  =  0, //!< Finale, L1 calo and L2 decisions
+				RETENTION_RECORDS    =  1, //!< Decisions, calo, coincidence calo, tracker and coincidence records
+				RETENTION_FULL_DEBUG =  2  //!< Records, Geiger matrices and calo / tracker pairs
+			};
+
+			/// \brief Products of the trigger front end for an event (CTWs decoding,
+			/// calorimeter records, Geiger matrices, sliding zones and zones). They do not
+			/// depend on the gates nor on the coincidence configuration and can be shared by
+			/// several trigger configurations (see trigger_scan).
+			struct front_end_records
+			{
+				/// Default constructor
+				front_end_records();
+
+				/// Reset the records
+				void reset();
+
+				std::vector<trigger_structures::calo_summary_record> calo_records_25ns; //!< Calo summary records @ 25 ns
+				std::vector<trigger_structures::tracker_record> tracker_records;        //!< Tracker records of the clockticks 1600 ns with Geiger CTWs (time ordered)
+				std::vector<trigger_structures::geiger_matrix> geiger_matrix_records;   //!< Geiger matrices of the tracker records (if requested)
+				uint32_t tracker_clocktick_min_1600ns; //!< First clocktick 1600 ns of the Geiger CTWs
+				uint32_t tracker_clocktick_max_1600ns; //!< Last clocktick 1600 ns of the Geiger CTWs
+				bool with_tracker_records;             //!< Flag for the tracker records built by the front end
+			};
+
 			/// Trigger display manager is a friend because it can access to members for display
 			// friend class trigger_display_manager;
 
@@ -53,6 +114,12 @@ namespace snemo {
 			/// Set the clock manager object
 			void set_clock_manager(const clock_utils & my_clock_manager_);
 
+			/// Set a shared trigger firmware image for the tracker trigger algorithm
+			void set_firmware(const std::shared_ptr<const trigger_firmware> & firmware_);
+
+			/// Return the trigger firmware image of the tracker trigger algorithm (set at initialization)
+			const std::shared_ptr<const trigger_firmware> & get_firmware() const;
+
 			/// Check if calorimeter gate size is set
 			bool has_calorimeter_gate_size() const;
 
@@ -80,6 +147,15 @@ namespace snemo {
       /// Check if the coincidence config is activated
 			bool is_activated_coincidence() const;
 
+			/// Set the retention policy of the trigger products
+			void set_retention_policy(retention_policy_type retention_policy_);
+
+			/// Get the retention policy of the trigger products
+			retention_policy_type get_retention_policy() const;
+
+			/// Return the retention policy of a label ('decisions', 'records' or 'full_debug')
+			static retention_policy_type retention_policy_from_label(const std::string & label_);
+
       /// Initializing
       void initialize();
 
@@ -90,25 +166,28 @@ namespace snemo {
       bool is_initialized() const;
 
 			/// Get the vector of calo summary record
-			const std::vector<trigger_structures::calo_summary_record> get_calo_records_25ns_vector() const;
+			const std::vector<trigger_structures::calo_summary_record> & get_calo_records_25ns_vector() const;
 
 			/// Get the vector of coincidence record
-			const std::vector<trigger_structures::coincidence_calo_record> get_coincidence_calo_records_1600ns_vector() const;
+			const std::vector<trigger_structures::coincidence_calo_record> & get_coincidence_calo_records_1600ns_vector() const;
 
 			/// Get the vector of tracker record
-			const std::vector<trigger_structures::tracker_record> get_tracker_records_vector() const;
+			const std::vector<trigger_structures::tracker_record> & get_tracker_records_vector() const;
 
 			/// Get the vector of geiger matrix record
-			const std::vector<trigger_structures::geiger_matrix> get_geiger_matrix_records_vector() const;
+			const std::vector<trigger_structures::geiger_matrix> & get_geiger_matrix_records_vector() const;
 
 			/// Get the vector of coincidence record
-			const std::vector<trigger_structures::coincidence_event_record> get_coincidence_records_vector() const;
+			const std::vector<trigger_structures::coincidence_event_record> & get_coincidence_records_vector() const;
 
 			/// Get the vector of L1 calo decision record
-			const std::vector<trigger_structures::L1_calo_decision> get_L1_calo_decision_records_vector() const;
+			const std::vector<trigger_structures::L1_calo_decision> & get_L1_calo_decision_records_vector() const;
 
 			/// Get the vector of L2 decision record
-			const std::vector<trigger_structures::L2_decision> get_L2_decision_records_vector() const;
+			const std::vector<trigger_structures::L2_decision> & get_L2_decision_records_vector() const;
+
+			/// Get the vector of calo / tracker pairs
+			const std::vector<std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> > & get_pair_records_vector() const;
 
 			/// Get the finale trigger decision
 			bool get_finale_decision() const;
@@ -117,6 +196,56 @@ namespace snemo {
       void process(const calo_ctw_data & calo_ctw_data_,
 									 const geiger_ctw_data & geiger_ctw_data_);
 
+			/// Check if the trigger configuration needs the tracker records of the front end
+			bool needs_tracker_records() const;
+
+			/// Process the front end of an event, the tracker records and the Geiger matrices are built only if requested
+			void process_front_end(const calo_ctw_data & calo_ctw_data_,
+														 const geiger_ctw_data & geiger_ctw_data_,
+														 front_end_records & front_end_records_,
+														 bool with_tracker_records_,
+														 bool with_geiger_matrices_);
+
+			/// Process the gates and the coincidences of an event from the products of the front end
+			void process_back_end(const front_end_records & front_end_records_);
+
+			/// Start the stream mode (continuous time processing)
+			void start_stream();
+
+			/// Check if the stream mode is started
+			bool is_streaming() const;
+
+			/// Add time ordered CTWs to the stream (CTWs older than the stream time are rejected)
+			void push_stream(const calo_ctw_data & calo_ctw_data_,
+											 const geiger_ctw_data & geiger_ctw_data_);
+
+			/// Process the stream up to a clocktick 1600 ns (excluded), all the CTWs before it must have been pushed
+			void advance_stream(uint64_t clocktick_1600ns_);
+
+			/// Process all the CTWs pushed in the stream
+			void flush_stream();
+
+			/// Stop the stream mode, the pending CTWs are dropped
+			void stop_stream();
+
+			/// Return the next clocktick 1600 ns to process in the stream
+			uint64_t get_stream_clocktick_1600ns() const;
+
+			/// Return the number of pending CTWs and records kept by the stream
+			std::size_t get_stream_backlog_size() const;
+
+			/// Check if a L1 calo decision is emitted by the stream
+			bool has_stream_L1_calo_decision() const;
+
+			/// Pop the oldest L1 calo decision emitted by the stream
+			trigger_structures::L1_calo_decision pop_stream_L1_calo_decision();
+
+			/// Check if a L2 decision is emitted by the stream
+			bool has_stream_L2_decision() const;
+
+			/// Pop the oldest L2 decision emitted by the stream
+			trigger_structures::L2_decision pop_stream_L2_decision();
+
     protected :
 
 			/// Rescaling calorimeter 25 ns at 1600 ns for coincidences with tracker
@@ -133,10 +262,59 @@ namespace snemo {
 			// Build a previous event record useful for delayed coincidences
 			void _build_previous_event_record();
 
+			/// Remove the coincidence records out of the L2 decision gate of a clocktick 1600 ns (not needed for the previous event records)
+			void _prune_coincidence_records(uint32_t clocktick_1600ns_);
+
+			/// Decrease the previous event records counters and delete the dead ones
+			void _update_previous_event_records(uint32_t clocktick_1600ns_);
+
+			/// Process the tracker and coincidence algorithms for a clocktick 1600 ns
+			void _process_clocktick_1600ns(uint32_t clocktick_1600ns_,
+																		 const geiger_ctw_data::geiger_ctw_collection_type & geiger_ctw_list_per_clocktick_1600_,
+																		 const trigger_structures::coincidence_calo_record & a_coinc_calo_record_for_pair_);
+
+			/// Process the tracker algorithm for a clocktick 1600 ns, the Geiger matrix is fetched if requested
+			void _process_tracker_clocktick_1600ns(uint32_t clocktick_1600ns_,
+																						 const geiger_ctw_data::geiger_ctw_collection_type & geiger_ctw_list_per_clocktick_1600_,
+																						 trigger_structures::tracker_record & a_tracker_record_,
+																						 trigger_structures::geiger_matrix * a_geiger_matrix_);
+
+			/// Process the coincidence algorithm for a clocktick 1600 ns from its tracker record (and Geiger matrix if any)
+			void _process_coincidence_clocktick_1600ns(uint32_t clocktick_1600ns_,
+																								 const trigger_structures::tracker_record & a_tracker_record_,
+																								 const trigger_structures::geiger_matrix * a_geiger_matrix_,
+																								 const trigger_structures::coincidence_calo_record & a_coinc_calo_record_for_pair_);
+
+			/// Unwrap a 32 bits clocktick into the nearest 64 bits clocktick of a reference
+			static uint64_t _unwrap_stream_clocktick(uint32_t clocktick_, uint64_t reference_);
+
+			/// Process the calorimeter clockticks 25 ns of the stream before a clocktick 1600 ns
+			void _process_stream_calorimeter(uint64_t clocktick_1600ns_);
+
+			/// Create the L1 decisions and the coincidence calo records of a calo summary record of the stream
+			void _process_stream_calo_record(const trigger_structures::calo_summary_record & a_calo_record_25ns_,
+																			 uint64_t clocktick_25ns_);
+
+			/// Return the next active clocktick 1600 ns of the stream from a clocktick (INVALID_STREAM_CLOCKTICK if none)
+			uint64_t _next_stream_clocktick_1600ns(uint64_t clocktick_1600ns_) const;
+
+			/// Process the active clockticks 1600 ns of the stream before a clocktick 1600 ns
+			void _process_stream_clockticks_1600ns(uint64_t clocktick_1600ns_);
+
       /// Protected general process
 			void _process(const calo_ctw_data & calo_ctw_data_,
 										const geiger_ctw_data & geiger_ctw_data_);
 
+			/// Protected front end process
+			void _process_front_end(const calo_ctw_data & calo_ctw_data_,
+															const geiger_ctw_data & geiger_ctw_data_,
+															front_end_records & front_end_records_,
+															bool with_tracker_records_,
+															bool with_geiger_matrices_);
+
+			/// Protected back end process
+			void _process_back_end(const front_end_records & front_end_records_);
+
     private :
 
 			typedef boost::circular_buffer<trigger_structures::previous_event_record> buffer_previous_event_record_type;
@@ -157,6 +335,7 @@ namespace snemo {
 			bool _activate_ape_dave_coincidence_;
 			bool _activate_ape_coincidence_only_;
 			bool _activate_any_coincidences_; //!< Boolean activating any coincidence
+			retention_policy_type _retention_policy_; //!< Retention policy of the trigger products
 
 			// Trigger algorithms :
 		  tracker_trigger_algorithm      _tracker_algo_; //!< Tracker trigger algorithm @ 1600ns
@@ -174,7 +353,23 @@ namespace snemo {
 			std::vector<trigger_structures::L1_calo_decision> _L1_calo_decision_records_; //!< Collection of L1 calorimeter decision @ 25 ns
 			std::vector<trigger_structures::L2_decision> _L2_decision_records_; //!< Collection of L2 decision (which launch the readout)
 
+			front_end_records _front_end_records_; //!< Products of the front end of the event mode
 			bool _finale_trigger_decision_; //!< The finale decision for the trigger
+			std::pair<bool, unsigned int> _per_to_delete_; //!< Previous event record to delete at the next clocktick 1600 ns
+
+			// Stream mode :
+			bool _streaming_; //!< Stream mode flag
+			uint64_t _stream_clocktick_25ns_;          //!< Next calorimeter clocktick 25 ns to process
+			uint64_t _stream_clocktick_1600ns_;        //!< Next clocktick 1600 ns to process
+			uint64_t _stream_last_calo_ctw_25ns_;      //!< Clocktick 25 ns of the last processed calo CTWs (calorimeter gate draining)
+			uint64_t _stream_last_calo_record_25ns_;   //!< Clocktick 25 ns of the last calo summary record (L1 decisions)
+			uint64_t _stream_calo_reference_25ns_;     //!< Reference to unwrap the calo CTWs clockticks
+			uint64_t _stream_geiger_reference_800ns_;  //!< Reference to unwrap the Geiger CTWs clockticks
+			std::map<uint64_t, calo_ctw_data::calo_ctw_collection_type> _stream_calo_ctws_; //!< Pending calo CTWs per clocktick 25 ns
+			std::map<uint64_t, geiger_ctw_data::geiger_ctw_collection_type> _stream_geiger_ctws_; //!< Pending even Geiger CTWs per clocktick 1600 ns
+			std::map<uint64_t, trigger_structures::coincidence_calo_record> _stream_coinc_calo_records_; //!< Pending coincidence calo records per clocktick 1600 ns
+			std::deque<trigger_structures::L1_calo_decision> _stream_L1_calo_decisions_; //!< L1 calo decisions emitted by the stream
+			std::deque<trigger_structures::L2_decision> _stream_L2_decisions_; //!< L2 decisions emitted by the stream
 
     };
 
@@ -7,12 +7,111 @@
 #include <snemo/digitization/trigger_algorithm.h>
 #include <snemo/digitization/trigger_structures.h>
 
+// Standard library :
+#include <cstdio>
+#include <cstring>
+
 namespace snemo {
 
   namespace digitization {
 
+    namespace {
+
+      // Display matrix line templates :
+      const char CALO_LINE_TEMPLATE[]      = "  |[       ][          ][          ][          ][          ][         ][          ][          ][          ][       ]|\n";
+      const char TRACKER_LINE_TEMPLATE[]   = "  |.................................................................................................................|\n";
+      const char SEPARATOR_LINE_TEMPLATE[] = "  |_________________________________________________________________________________________________________________|\n";
+      const char ZONES_LINE[] = "     Zone0      Zone1       Zone2       Zone3       Zone4      Zone5       Zone6       Zone7      Zone 8     Zone9 \n";
+      static_assert(sizeof(CALO_LINE_TEMPLATE) == trigger_display_manager::MATRIX_LINE_SIZE + 1
+		    && sizeof(TRACKER_LINE_TEMPLATE) == trigger_display_manager::MATRIX_LINE_SIZE + 1
+		    && sizeof(SEPARATOR_LINE_TEMPLATE) == trigger_display_manager::MATRIX_LINE_SIZE + 1,
+		    "Display matrix line templates must fill a whole matrix line !");
+
+      // Calorimeter zones columns [first;last[ on the display matrix :
+      const unsigned int CALO_ZONE_FIRST_COLUMN[trigger_info::NZONES] = {4, 13, 25, 37, 49, 61, 72, 84, 96, 108};
+      const unsigned int CALO_ZONE_LAST_COLUMN[trigger_info::NZONES] = {11, 23, 35, 47, 59, 70, 82, 94, 106, 115};
+
+      // Calorimeter zones rows for each side :
+      const unsigned int CALO_ZONE_ROW[trigger_info::NSIDES] = {0, 20};
+
+      // Separator row between the two sides :
+      const unsigned int SEPARATOR_ROW = 10;
+
+      // Words of the FIFO binary records :
+      const unsigned int FIFO_RECORD_TYPE_SHIFT = 62;
+      const unsigned int FIFO_RECORD_COUNTER_SHIFT = 48;
+      const uint64_t FIFO_RECORD_WORD_MASK = (static_cast<uint64_t>(1) << FIFO_RECORD_COUNTER_SHIFT) - 1;
+      const std::size_t FIFO_MAX_WIDTH = FIFO_RECORD_COUNTER_SHIFT;
+
+      // Write the lowest bits of a word, most significant bit first, as '0' and '1' characters :
+      void format_bits(char * out_, uint64_t word_, std::size_t width_)
+      {
+	for (std::size_t i = 0; i < width_; i++)
+	  {
+	    out_[i] = '0' + ((word_ >> (width_ - 1 - i)) & 1);
+	  }
+	return;
+      }
+
+      // Append the lowest bits of a word to a text buffer, most or least significant bit first :
+      void append_bits(std::string & out_, uint64_t word_, std::size_t width_, bool msb_first_ = true)
+      {
+	for (std::size_t i = 0; i < width_; i++)
+	  {
+	    const std::size_t ibit = msb_first_ ? width_ - 1 - i : i;
+	    out_ += (char) ('0' + ((word_ >> ibit) & 1));
+	  }
+	return;
+      }
+
+      // Append a boolean as the '0' or '1' character followed by a space :
+      void append_flag(std::string & out_, bool flag_)
+      {
+	out_ += flag_ ? '1' : '0';
+	out_ += ' ';
+	return;
+      }
+
+      // Format a FIFO text line 'counter : word;' into a line of FIFO_COUNTER_SIZE + width_ + 5 characters :
+      void format_fifo_line(char * line_, uint32_t counter_, uint64_t word_, std::size_t width_)
+      {
+	const std::size_t counter_size = trigger_display_manager::FIFO_COUNTER_SIZE;
+	format_bits(line_, counter_, counter_size);
+	std::memcpy(line_ + counter_size, " : ", 3);
+	format_bits(line_ + counter_size + 3, word_, width_);
+	line_[counter_size + 3 + width_] = ';';
+	line_[counter_size + 4 + width_] = '\n';
+	return;
+      }
+
+      void write_fifo_record(char * out_, uint64_t record_)
+      {
+	for (std::size_t i = 0; i < trigger_display_manager::FIFO_BINARY_RECORD_SIZE; i++)
+	  {
+	    out_[i] = (char) ((record_ >> (8 * i)) & 0xFF);
+	  }
+	return;
+      }
+
+      uint64_t read_fifo_record(const char * in_)
+      {
+	uint64_t record = 0;
+	for (std::size_t i = 0; i < trigger_display_manager::FIFO_BINARY_RECORD_SIZE; i++)
+	  {
+	    record |= static_cast<uint64_t>(static_cast<unsigned char>(in_[i])) << (8 * i);
+	  }
+	return record;
+      }
+
+    }
+
     const uint32_t trigger_display_manager::NUMBER_OF_HORIZONTAL_CHAR;
     const uint32_t trigger_display_manager::NUMBER_OF_VERTICAL_CHAR;
+    const uint32_t trigger_display_manager::MATRIX_LINE_SIZE;
+    const uint32_t trigger_display_manager::FIFO_COUNTER_SIZE;
+    const uint32_t trigger_display_manager::FIFO_BINARY_RECORD_SIZE;
+    const uint32_t trigger_display_manager::FIFO_BINARY_MAGIC;
+    const uint32_t trigger_display_manager::FIFO_BINARY_VERSION;
 
     trigger_display_manager::trigger_display_manager()
     {
@@ -22,14 +121,8 @@ namespace snemo {
       _tracker_1600ns_   = false;
       _coinc_1600ns_     = false;
       _decision_trigger_ = false;
-
-      for (unsigned int i = 0; i < NUMBER_OF_HORIZONTAL_CHAR; i++)
-    	{
-    	  for (unsigned int j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-    	    {
-    	      _char_matrix_[i][j] = '.';
-    	    }
-    	}
+      _fifo_binary_      = false;
+      fill_matrix_pattern();
       return;
     }
 
@@ -86,6 +179,13 @@ namespace snemo {
     	  _decision_trigger_ = decision_trigger_config;
     	}
       }
+
+      if (!is_fifo_binary()) {
+	if (config_.has_key("fifo_binary")) {
+	  bool fifo_binary_config = config_.fetch_boolean("fifo_binary");
+	  _fifo_binary_ = fifo_binary_config;
+	}
+      }
       fill_matrix_pattern();
       _initialized_ = true;
       return;
@@ -105,6 +205,7 @@ namespace snemo {
       _tracker_1600ns_   = false;
       _coinc_1600ns_     = false;
       _decision_trigger_ = false;
+      _fifo_binary_      = false;
       return;
     }
 
@@ -133,229 +234,54 @@ namespace snemo {
       return _decision_trigger_;
     }
 
+    bool trigger_display_manager::is_fifo_binary() const
+    {
+      return _fifo_binary_;
+    }
+
     void trigger_display_manager::fill_calo_trigger_matrix_25ns(std::bitset<10> zoning_word_[trigger_info::NSIDES])
     {
-      for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
-       	{
-      	  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
-      	    {
-      	      if (izone == 0 || izone == 9)
-      		{
-      		  if (zoning_word_[iside][izone] == true)
-      		    {
-      		      for (uint32_t j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-      			{
-      			  if      (iside == 0 && izone == 0 && j > 3 && j < 11) _char_matrix_[0][j] = '*';
-      			  else if (iside == 1 && izone == 0 && j > 3 && j < 11) _char_matrix_[20][j] = '*';
-      			  else if (iside == 0 && izone == 9 && j > 107 && j < 115) _char_matrix_[0][j] = '*';
-      			  else if (iside == 1 && izone == 9 && j > 107 && j < 115) _char_matrix_[20][j] = '*';
-      			}
-      		    }
-      		  else
-      		    {
-      		      for (uint32_t j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-      			{
-      			  if      (iside == 0 && izone == 0 && j > 3 && j < 11) _char_matrix_[0][j] = ' ';
-      			  else if (iside == 1 && izone == 0 && j > 3 && j < 11) _char_matrix_[20][j] = ' ';
-      			  else if (iside == 0 && izone == 9 && j > 107 && j < 115) _char_matrix_[0][j] = ' ';
-      			  else if (iside == 1 && izone == 9 && j > 107 && j < 115) _char_matrix_[20][j] = ' ';
-      			}
-      		    }
-      		} //end of if izone
-
-      	      else if (izone == 5)
-      		{
-      		  if (zoning_word_[iside][izone] == true)
-      		    {
-      		      for (uint32_t j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-      			{
-      			  if      (iside == 0 && j > 60 && j < 70) _char_matrix_[0][j] = '*';
-      			  else if (iside == 1 && j > 60 && j < 70) _char_matrix_[20][j] = '*';
-      			}
-      		    }
-      		  else
-      		    {
-      		      for (uint32_t j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-      			{
-      			  if      (iside == 0 && j > 60 && j < 70) _char_matrix_[0][j] = ' ';
-      			  else if (iside == 1 && j > 60 && j < 70) _char_matrix_[20][j] = ' ';
-      			}
-      		    }
-      		} // end of else if izone == 5
-
-      	      else
-      		{
-      		  if (zoning_word_[iside][izone] == true)
-      		    {
-      		      for (uint32_t j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-      			{
-      			  if      (iside == 0 && izone == 1 && j > 12 && j < 23) _char_matrix_[0][j]   = '*';
-      			  else if (iside == 1 && izone == 1 && j > 12 && j < 23) _char_matrix_[20][j]  = '*';
-      			  else if (iside == 0 && izone == 2 && j > 24 && j < 35) _char_matrix_[0][j]   = '*';
-      			  else if (iside == 1 && izone == 2 && j > 24 && j < 35) _char_matrix_[20][j]  = '*';
-      			  else if (iside == 0 && izone == 3 && j > 36 && j < 47) _char_matrix_[0][j]   = '*';
-      			  else if (iside == 1 && izone == 3 && j > 36 && j < 47) _char_matrix_[20][j]  = '*';
-      			  else if (iside == 0 && izone == 4 && j > 48 && j < 59) _char_matrix_[0][j]   = '*';
-      			  else if (iside == 1 && izone == 4 && j > 48 && j < 59) _char_matrix_[20][j]  = '*';
-      			  else if (iside == 0 && izone == 6 && j > 71 && j < 82) _char_matrix_[0][j]   = '*';
-      			  else if (iside == 1 && izone == 6 && j > 71 && j < 82) _char_matrix_[20][j]  = '*';
-      			  else if (iside == 0 && izone == 7 && j > 83 && j < 94) _char_matrix_[0][j]   = '*';
-      			  else if (iside == 1 && izone == 7 && j > 83 && j < 94) _char_matrix_[20][j]  = '*';
-      			  else if (iside == 0 && izone == 8 && j > 95 && j < 106) _char_matrix_[0][j]  = '*';
-      			  else if (iside == 1 && izone == 8 && j > 95 && j < 106) _char_matrix_[20][j] = '*';
-      			}
-      		    }
-      		  else
-      		    {
-      		      for (uint32_t j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-      			{
-      			  if      (iside == 0 && izone == 1 && j > 12 && j < 23) _char_matrix_[0][j]   = ' ';
-      			  else if (iside == 1 && izone == 1 && j > 12 && j < 23) _char_matrix_[20][j]  = ' ';
-      			  else if (iside == 0 && izone == 2 && j > 24 && j < 35) _char_matrix_[0][j]   = ' ';
-      			  else if (iside == 1 && izone == 2 && j > 24 && j < 35) _char_matrix_[20][j]  = ' ';
-      			  else if (iside == 0 && izone == 3 && j > 36 && j < 47) _char_matrix_[0][j]   = ' ';
-      			  else if (iside == 1 && izone == 3 && j > 36 && j < 47) _char_matrix_[20][j]  = ' ';
-      			  else if (iside == 0 && izone == 4 && j > 48 && j < 59) _char_matrix_[0][j]   = ' ';
-      			  else if (iside == 1 && izone == 4 && j > 48 && j < 59) _char_matrix_[20][j]  = ' ';
-      			  else if (iside == 0 && izone == 6 && j > 71 && j < 82) _char_matrix_[0][j]   = ' ';
-      			  else if (iside == 1 && izone == 6 && j > 71 && j < 82) _char_matrix_[20][j]  = ' ';
-      			  else if (iside == 0 && izone == 7 && j > 83 && j < 94) _char_matrix_[0][j]   = ' ';
-      			  else if (iside == 1 && izone == 7 && j > 83 && j < 94) _char_matrix_[20][j]  = ' ';
-      			  else if (iside == 0 && izone == 8 && j > 95 && j < 106) _char_matrix_[0][j]  = ' ';
-      			  else if (iside == 1 && izone == 8 && j > 95 && j < 106) _char_matrix_[20][j] = ' ';
-      			}
-      		    }
-      		} // end of else izone
-      	    } // end of izone
-      	} // end of iside
+      _fill_calo_zones(zoning_word_);
       return;
     }
 
     void trigger_display_manager::fill_calo_trigger_matrix_1600ns(std::bitset<10> zoning_word_[trigger_info::NSIDES])
     {
-      for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
-       	{
-     	  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
-      	    {
-      	      if (izone == 0 || izone == 9)
-      		{
-      		  if (zoning_word_[iside][izone] == true)
-    		    {
-    		      for (unsigned int j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-    			{
-    			  if      (iside == 0 && izone == 0 && j > 3 && j < 11) _char_matrix_[0][j] = '*';
-    			  else if (iside == 1 && izone == 0 && j > 3 && j < 11) _char_matrix_[20][j] = '*';
-    			  else if (iside == 0 && izone == 9 && j > 107 && j < 115) _char_matrix_[0][j] = '*';
-    			  else if (iside == 1 && izone == 9 && j > 107 && j < 115) _char_matrix_[20][j] = '*';
-    			}
-    		    }
-    		  else
-    		    {
-    		      for (unsigned int j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-    			{
-    			  if      (iside == 0 && izone == 0 && j > 3 && j < 11) _char_matrix_[0][j] = ' ';
-    			  else if (iside == 1 && izone == 0 && j > 3 && j < 11) _char_matrix_[20][j] = ' ';
-    			  else if (iside == 0 && izone == 9 && j > 107 && j < 115) _char_matrix_[0][j] = ' ';
-    			  else if (iside == 1 && izone == 9 && j > 107 && j < 115) _char_matrix_[20][j] = ' ';
-    			}
-    		    }
-    		} //end of if izone
-
-    	      else if (izone == 5)
-      		{
-      		  if (zoning_word_[iside][izone] == true)
-    		    {
-    		      for (unsigned int j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-    			{
-    			  if      (iside == 0 && j > 60 && j < 70) _char_matrix_[0][j] = '*';
-    			  else if (iside == 1 && j > 60 && j < 70) _char_matrix_[20][j] = '*';
-    			}
-    		    }
-    		  else
-    		    {
-    		      for (unsigned int j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-    			{
-    			  if      (iside == 0 && j > 60 && j < 70) _char_matrix_[0][j] = ' ';
-    			  else if (iside == 1 && j > 60 && j < 70) _char_matrix_[20][j] = ' ';
-    			}
-    		    }
-    		} // end of else if izone == 5
-
-    	      else
-    		{
-    		  if (zoning_word_[iside][izone] == true)
-    		    {
-    		      for (unsigned int j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-    			{
-    			  if      (iside == 0 && izone == 1 && j > 12 && j < 23) _char_matrix_[0][j]   = '*';
-    			  else if (iside == 1 && izone == 1 && j > 12 && j < 23) _char_matrix_[20][j]  = '*';
-    			  else if (iside == 0 && izone == 2 && j > 24 && j < 35) _char_matrix_[0][j]   = '*';
-    			  else if (iside == 1 && izone == 2 && j > 24 && j < 35) _char_matrix_[20][j]  = '*';
-    			  else if (iside == 0 && izone == 3 && j > 36 && j < 47) _char_matrix_[0][j]   = '*';
-    			  else if (iside == 1 && izone == 3 && j > 36 && j < 47) _char_matrix_[20][j]  = '*';
-    			  else if (iside == 0 && izone == 4 && j > 48 && j < 59) _char_matrix_[0][j]   = '*';
-    			  else if (iside == 1 && izone == 4 && j > 48 && j < 59) _char_matrix_[20][j]  = '*';
-    			  else if (iside == 0 && izone == 6 && j > 71 && j < 82) _char_matrix_[0][j]   = '*';
-    			  else if (iside == 1 && izone == 6 && j > 71 && j < 82) _char_matrix_[20][j]  = '*';
-    			  else if (iside == 0 && izone == 7 && j > 83 && j < 94) _char_matrix_[0][j]   = '*';
-    			  else if (iside == 1 && izone == 7 && j > 83 && j < 94) _char_matrix_[20][j]  = '*';
-    			  else if (iside == 0 && izone == 8 && j > 95 && j < 106) _char_matrix_[0][j]  = '*';
-    			  else if (iside == 1 && izone == 8 && j > 95 && j < 106) _char_matrix_[20][j] = '*';
-
-    			}
-    		    }
-    		  else
-    		    {
-    		      for (unsigned int j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-    			{
-    			  if      (iside == 0 && izone == 1 && j > 12 && j < 23) _char_matrix_[0][j]   = ' ';
-    			  else if (iside == 1 && izone == 1 && j > 12 && j < 23) _char_matrix_[20][j]  = ' ';
-    			  else if (iside == 0 && izone == 2 && j > 24 && j < 35) _char_matrix_[0][j]   = ' ';
-    			  else if (iside == 1 && izone == 2 && j > 24 && j < 35) _char_matrix_[20][j]  = ' ';
-    			  else if (iside == 0 && izone == 3 && j > 36 && j < 47) _char_matrix_[0][j]   = ' ';
-    			  else if (iside == 1 && izone == 3 && j > 36 && j < 47) _char_matrix_[20][j]  = ' ';
-    			  else if (iside == 0 && izone == 4 && j > 48 && j < 59) _char_matrix_[0][j]   = ' ';
-    			  else if (iside == 1 && izone == 4 && j > 48 && j < 59) _char_matrix_[20][j]  = ' ';
-    			  else if (iside == 0 && izone == 6 && j > 71 && j < 82) _char_matrix_[0][j]   = ' ';
-    			  else if (iside == 1 && izone == 6 && j > 71 && j < 82) _char_matrix_[20][j]  = ' ';
-    			  else if (iside == 0 && izone == 7 && j > 83 && j < 94) _char_matrix_[0][j]   = ' ';
-    			  else if (iside == 1 && izone == 7 && j > 83 && j < 94) _char_matrix_[20][j]  = ' ';
-    			  else if (iside == 0 && izone == 8 && j > 95 && j < 106) _char_matrix_[0][j]  = ' ';
-    			  else if (iside == 1 && izone == 8 && j > 95 && j < 106) _char_matrix_[20][j] = ' ';
-    			}
-    		    }
-    		} // end of else izone
-    	    } // end of izone
-    	} // end of iside
+      _fill_calo_zones(zoning_word_);
+      return;
+    }
 
+    void trigger_display_manager::_fill_calo_zones(const std::bitset<10> zoning_word_[trigger_info::NSIDES])
+    {
+      for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	{
+	  char * row = _char_matrix_[CALO_ZONE_ROW[iside]];
+	  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
+	    {
+	      std::memset(row + CALO_ZONE_FIRST_COLUMN[izone], zoning_word_[iside][izone] ? '*' : ' ', CALO_ZONE_LAST_COLUMN[izone] - CALO_ZONE_FIRST_COLUMN[izone]);
+	    }
+	}
       return;
     }
 
 
     void trigger_display_manager::fill_tracker_trigger_matrix_1600ns(bool geiger_matrix_[trigger_info::NSIDES][trigger_info::NLAYERS][trigger_info::NROWS])
     {
-
+      // Side 0 is displayed from the last layer (row 1) to the first one (row 9),
+      // side 1 from the first layer (row 11) to the last one (row 19) :
       for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
-      	{
-      	  unsigned int layer = 0;
-      	  for (unsigned int jlayer = trigger_info::NLAYERS - 1; jlayer != (unsigned)0 -1; jlayer--) // Value GEIGER_LAYER_SIZE = 9
-      	    {
-      	      for (unsigned int krow = 0; krow < trigger_info::NROWS; krow++)
-      		{
-      		  if (geiger_matrix_[iside][jlayer][krow]
-      		      && iside == 0)
-      		    {
-      		      _char_matrix_[layer+1][krow+3] = '*';
-      		    }
-      		  else if (geiger_matrix_[iside][jlayer][krow]
-      			   && iside == 1)
-      		    {
-      		      _char_matrix_[jlayer+11][krow+3] = '*';
-      		    }
-      		} // end of krow
-      	      layer++;
-      	    } // end of jlayer
-      	} // end of iside
+	{
+	  for (unsigned int jlayer = 0; jlayer < trigger_info::NLAYERS; jlayer++)
+	    {
+	      const unsigned int irow = (iside == 0) ? trigger_info::NLAYERS - jlayer : jlayer + 11;
+	      char * row = _char_matrix_[irow] + 3;
+	      const bool * cells = geiger_matrix_[iside][jlayer];
+	      for (unsigned int krow = 0; krow < trigger_info::NROWS; krow++)
+		{
+		  if (cells[krow]) row[krow] = '*';
+		} // end of krow
+	    } // end of jlayer
+	} // end of iside
       return;
     }
 
@@ -742,12 +668,15 @@ namespace snemo {
       return;
     }
 
-    void trigger_display_manager::display_ctw_fifo_trigger_implementation_1600ns(std::ofstream * calo_ofstreams_,
-										 std::ofstream * tracker_ofstreams_,
-										 const calo_ctw_data & a_calo_ctw_data_,
-										 const geiger_ctw_data & a_geiger_ctw_data_)
-
+    void trigger_display_manager::build_ctw_fifo_trigger_implementation_1600ns(const calo_ctw_data & a_calo_ctw_data_,
+										const geiger_ctw_data & a_geiger_ctw_data_)
     {
+      for (unsigned int icrate = 0; icrate < mapping::NUMBER_OF_CRATES; icrate++)
+	{
+	  _calo_fifo_buffers_[icrate].clear();
+	  _tracker_fifo_buffers_[icrate].clear();
+	}
+
       if (a_calo_ctw_data_.has_calo_ctw()) {
 	uint64_t ct_min_25 = a_calo_ctw_data_.get_clocktick_min();
 	uint64_t ct_max_25 = a_calo_ctw_data_.get_clocktick_max();
@@ -755,24 +684,19 @@ namespace snemo {
 	uint32_t fifo_depth = 4096;
 	std::size_t calo_fifo_width = 24;
 
-	std::bitset<13> binary_counter = 0x0;
+	for (unsigned int icrate = 0; icrate < mapping::NUMBER_OF_CRATES; icrate++)
+	  {
+	    _start_fifo_buffer(_calo_fifo_buffers_[icrate], calo_fifo_width, fifo_depth);
+	  }
+
 	uint32_t decimal_counter = 0;
 
 	for (uint64_t i = 0; i < ct_min_25; i++)
 	  {
-	    binary_counter = decimal_counter;
-	    calo_ofstreams_[0] << binary_counter << " : ";
-	    for (std::size_t zero = 0; zero < calo_fifo_width; zero++) calo_ofstreams_[0] << "0";
-	    calo_ofstreams_[0] << ';' << std::endl;
-
-	    calo_ofstreams_[1] << binary_counter << " : ";
-	    for (std::size_t zero = 0; zero < calo_fifo_width; zero++) calo_ofstreams_[1] << "0";
-	    calo_ofstreams_[1] << ';' << std::endl;
-
-	    calo_ofstreams_[2] << binary_counter << " : ";
-	    for (std::size_t zero = 0; zero < calo_fifo_width; zero++) calo_ofstreams_[2] << "0";
-	    calo_ofstreams_[2] << ';' << std::endl;
-
+	    for (unsigned int icrate = 0; icrate < mapping::NUMBER_OF_CRATES; icrate++)
+	      {
+		_append_fifo_word(_calo_fifo_buffers_[icrate], decimal_counter, 0x0, calo_fifo_width);
+	      }
 	    decimal_counter++;
 	  }
 
@@ -780,13 +704,10 @@ namespace snemo {
 	     i <= ct_max_25;
 	     i++)
 	  {
-	    binary_counter = decimal_counter;
 	    snemo::digitization::calo_ctw_data::calo_ctw_collection_type calo_ctw_collection;
 	    a_calo_ctw_data_.get_list_of_calo_ctw_per_clocktick(i, calo_ctw_collection);
 
-	    bool writed_calo_ctw_0 = false;
-	    bool writed_calo_ctw_1 = false;
-	    bool writed_calo_ctw_2 = false;
+	    bool writed_calo_ctw[mapping::NUMBER_OF_CRATES] = {false, false, false};
 
 	    for (auto ictw = calo_ctw_collection.begin();
 		 ictw != calo_ctw_collection.end();
@@ -795,67 +716,30 @@ namespace snemo {
 
 	      std::size_t calo_ctw_number = a_handle_calo_ctw.get().get_geom_id().get(mapping::RACK_DEPTH);
 
-	      if (calo_ctw_number == 0) {
-		calo_ofstreams_[0] << binary_counter << " : ";
-		std::bitset<calo::ctw::FULL_BITSET_SIZE> ctw_zoning_word_0 = 0x0;
-	      	a_handle_calo_ctw.get().get_full_word(ctw_zoning_word_0);
-		for (std::size_t zero = 0; zero < 6; zero++) calo_ofstreams_[0] << "0";
-	      	calo_ofstreams_[0] << ctw_zoning_word_0 << ';' << std::endl;
-		writed_calo_ctw_0 = true;
-	      }
-	      else if (calo_ctw_number == 1) {
-		calo_ofstreams_[1] << binary_counter << " : ";
-	      	std::bitset<calo::ctw::FULL_BITSET_SIZE> ctw_zoning_word_1 = 0x0;
-	      	a_handle_calo_ctw.get().get_full_word(ctw_zoning_word_1);
-		for (std::size_t zero = 0; zero < 6; zero++) calo_ofstreams_[1] << "0";
-	      	calo_ofstreams_[1] << ctw_zoning_word_1 << ';' << std::endl;
-		writed_calo_ctw_1 = true;
-	      }
-	      else if (calo_ctw_number == 2) {
-		calo_ofstreams_[2] << binary_counter << " : ";
-	      	std::bitset<calo::ctw::FULL_BITSET_SIZE> ctw_zoning_word_2 = 0x0;
-	      	a_handle_calo_ctw.get().get_full_word(ctw_zoning_word_2);
-		for (std::size_t zero = 0; zero < 6; zero++) calo_ofstreams_[2] << "0";
-	      	calo_ofstreams_[2] << ctw_zoning_word_2 << ';' << std::endl;
-		writed_calo_ctw_2 = true;
+	      if (calo_ctw_number < mapping::NUMBER_OF_CRATES) {
+		// The 18 bits CTW word is left padded with zeros to the FIFO width :
+		std::bitset<calo::ctw::FULL_BITSET_SIZE> ctw_zoning_word = 0x0;
+		a_handle_calo_ctw.get().get_full_word(ctw_zoning_word);
+		_append_fifo_word(_calo_fifo_buffers_[calo_ctw_number], decimal_counter, ctw_zoning_word.to_ullong(), calo_fifo_width);
+		writed_calo_ctw[calo_ctw_number] = true;
 	      }
 
 	    } // end of ictw
 
-	    if (!writed_calo_ctw_0) {
-	      calo_ofstreams_[0] << binary_counter << " : ";
-	      for (std::size_t zero = 0; zero < calo_fifo_width; zero++) calo_ofstreams_[0] << "0";
-	      calo_ofstreams_[0] << ';' << std::endl;
-	    }
-	    if (!writed_calo_ctw_1) {
-	      calo_ofstreams_[1] << binary_counter << " : ";
-	      for (std::size_t zero = 0; zero < calo_fifo_width; zero++) calo_ofstreams_[1] << "0";
-	      calo_ofstreams_[1] << ';' << std::endl;
-	    }
-	    if (!writed_calo_ctw_2) {
-	      calo_ofstreams_[2] << binary_counter << " : ";
-	      for (std::size_t zero = 0; zero < calo_fifo_width; zero++) calo_ofstreams_[2] << "0";
-	      calo_ofstreams_[2] << ';' << std::endl;
-	    }
+	    for (unsigned int icrate = 0; icrate < mapping::NUMBER_OF_CRATES; icrate++)
+	      {
+		if (!writed_calo_ctw[icrate]) _append_fifo_word(_calo_fifo_buffers_[icrate], decimal_counter, 0x0, calo_fifo_width);
+	      }
 
 	    decimal_counter++;
 	  }
 
 	for (uint64_t i = ct_max_25 + 1; i < fifo_depth; i++)
 	  {
-	    binary_counter = decimal_counter;
-	    calo_ofstreams_[0] << binary_counter << " : ";
-	    for (std::size_t zero = 0; zero < calo_fifo_width; zero++) calo_ofstreams_[0] << "0";
-	    calo_ofstreams_[0] << ';' << std::endl;
-
-	    calo_ofstreams_[1] << binary_counter << " : ";
-	    for (std::size_t zero = 0; zero < calo_fifo_width; zero++) calo_ofstreams_[1] << "0";
-	    calo_ofstreams_[1] << ';' << std::endl;
-
-	    calo_ofstreams_[2] << binary_counter << " : ";
-	    for (std::size_t zero = 0; zero < calo_fifo_width; zero++) calo_ofstreams_[2] << "0";
-	    calo_ofstreams_[2] << ';' << std::endl;
-
+	    for (unsigned int icrate = 0; icrate < mapping::NUMBER_OF_CRATES; icrate++)
+	      {
+		_append_fifo_word(_calo_fifo_buffers_[icrate], decimal_counter, 0x0, calo_fifo_width);
+	      }
 	    decimal_counter++;
 	  }
 
@@ -882,50 +766,34 @@ namespace snemo {
 	for (unsigned int i = 0; i < geiger_ctw_data_1600ns.get_geiger_ctws().size(); i++)
 	  {
 	    geiger_ctw & a_gg_ctw = geiger_ctw_data_1600ns.grab_geiger_ctws()[i].grab();
-	    const uint32_t TRACKER_CLOCKTICK = 800;
-	    const uint32_t TRIGGER_CLOCKTICK = 1600;
-	    const uint32_t TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS = 1;
-	    uint32_t clocktick_1600ns = (a_gg_ctw.get_clocktick_800ns() * TRACKER_CLOCKTICK) / TRIGGER_CLOCKTICK;
-	    clocktick_1600ns = clocktick_1600ns + TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS;
-	    a_gg_ctw.set_clocktick_800ns(clocktick_1600ns);
+	    a_gg_ctw.set_clocktick_800ns(clock_utils::clocktick_800ns_to_1600ns(a_gg_ctw.get_clocktick_800ns()));
 	  }
 
 	const uint32_t fifo_depth = 2048;
 	const std::size_t tracker_fifo_width = 36;
-	const std::size_t conversion_clocktick_25_1600 = 64;
+	const std::size_t conversion_clocktick_25_1600 = clock_utils::NUMBER_OF_25_CLOCK_IN_1600;
 	const std::size_t tracker_raster_fifo = 37; // 19 * 2,  19 utile (gg TP) (36 bits) + 19 zero (36 bits) en alternance
 
-	const std::bitset<tracker_fifo_width> tracker_zero_bitset = 0x0;
-	std::bitset<13> binary_counter = 0x0;
+	for (unsigned int icrate = 0; icrate < mapping::NUMBER_OF_CRATES; icrate++)
+	  {
+	    _start_fifo_buffer(_tracker_fifo_buffers_[icrate], tracker_fifo_width, fifo_depth);
+	  }
+
 	uint32_t decimal_counter = 0;
 
 	uint64_t geiger_ct_min_1600 = geiger_ctw_data_1600ns.get_clocktick_min();
 	uint64_t geiger_ct_max_1600 = geiger_ctw_data_1600ns.get_clocktick_max();
 
-	std::clog << "GG ct min = " << geiger_ct_min_1600 << std::endl;
-
 	uint64_t geiger_ct_min_25 = conversion_clocktick_25_1600 * geiger_ct_min_1600;
 	uint64_t geiger_begin_new_raster = tracker_raster_fifo * (geiger_ct_max_1600 + 1);
 
 	for (uint64_t i = 0; i < geiger_ct_min_25; i++)
 	  {
-	    binary_counter = decimal_counter;
-
-	    tracker_ofstreams_[0] << binary_counter << " : ";
-	    tracker_ofstreams_[0] << tracker_zero_bitset << ';' << std::endl;
-
-	    tracker_ofstreams_[1] << binary_counter << " : ";
-	    tracker_ofstreams_[1] << tracker_zero_bitset << ';' << std::endl;
-
-	    tracker_ofstreams_[2] << binary_counter << " : ";
-	    tracker_ofstreams_[2] << tracker_zero_bitset << ';' << std::endl;
-
-	    if (i != 0 && i % tracker_raster_fifo == 0) {
-	      tracker_ofstreams_[0] << std::endl;
-	      tracker_ofstreams_[1] << std::endl;
-	      tracker_ofstreams_[2] << std::endl;
-	    }
-
+	    for (unsigned int icrate = 0; icrate < mapping::NUMBER_OF_CRATES; icrate++)
+	      {
+		_append_fifo_word(_tracker_fifo_buffers_[icrate], decimal_counter, 0x0, tracker_fifo_width);
+		if (i != 0 && i % tracker_raster_fifo == 0) _append_fifo_separator(_tracker_fifo_buffers_[icrate]);
+	      }
 	    decimal_counter++;
 	  }
 
@@ -933,17 +801,9 @@ namespace snemo {
 	     i <= geiger_ctw_data_1600ns.get_clocktick_max();
 	     i++)
 	  {
-	    binary_counter = decimal_counter;
 	    snemo::digitization::geiger_ctw_data::geiger_ctw_collection_type gg_ctw_collection;
 	    geiger_ctw_data_1600ns.get_list_of_geiger_ctw_per_clocktick(i, gg_ctw_collection);
 
-	    for (auto ictw = gg_ctw_collection.begin();
-		 ictw != gg_ctw_collection.end();
-		 ictw++) {
-	      datatools::handle<geiger_ctw> a_handle_gg_ctw = *ictw;
-	      a_handle_gg_ctw.get().tree_dump(std::clog);
-	    }
-
 	    uint32_t initial_counter = decimal_counter;
 
 	    for (auto ictw = gg_ctw_collection.begin();
@@ -953,220 +813,269 @@ namespace snemo {
 	      datatools::handle<geiger_ctw> a_handle_gg_ctw = *ictw;
 	      std::size_t tracker_ctw_number = a_handle_gg_ctw.get().get_geom_id().get(mapping::RACK_DEPTH);
 
-	      if (tracker_ctw_number == 0)
+	      // The crate 0 words follow the counter left by the previous CTW, the crates 1 and 2
+	      // words start from the clocktick counter and only the crate 2 words move it forward :
+	      if (tracker_ctw_number != 0) decimal_counter = initial_counter;
+	      if (tracker_ctw_number < mapping::NUMBER_OF_CRATES)
 		{
 		  // Only 19 FEBs, 36 bits / clock25ns + 19 * 36 zero bits
+		  std::vector<char> & fifo_buffer = _tracker_fifo_buffers_[tracker_ctw_number];
 		  for (std::size_t iblock = 0; iblock < mapping::NUMBER_OF_FEBS_BY_CRATE; iblock++)
 		    {
-		      binary_counter = decimal_counter;
-		      tracker_ofstreams_[0] << binary_counter << " : ";
-		      std::bitset<geiger::tp::TP_THREE_WIRES_SIZE> gg_ctw_tp_word = 0x0;
-		      a_handle_gg_ctw.get().get_36_bits_in_ctw_word(iblock, gg_ctw_tp_word);
-		      tracker_ofstreams_[0] << gg_ctw_tp_word << ';' << std::endl;
-		      decimal_counter++;
-
-		      binary_counter = decimal_counter;
-		      tracker_ofstreams_[0] << binary_counter << " : " << tracker_zero_bitset << ';' << std::endl;
-		      decimal_counter++;
-		    }
-		}
-
-	      decimal_counter = initial_counter;
-	      if (tracker_ctw_number == 1)
-		{
-		  // Only 19 FEBs, 36 bits / clock25ns + 36 zero bits
-		  for (std::size_t iblock = 0; iblock < mapping::NUMBER_OF_FEBS_BY_CRATE; iblock++)
-		    {
-		      binary_counter = decimal_counter;
-		      tracker_ofstreams_[1] << binary_counter << " : ";
-		      std::bitset<geiger::tp::TP_THREE_WIRES_SIZE> gg_ctw_tp_word = 0x0;
-		      a_handle_gg_ctw.get().get_36_bits_in_ctw_word(iblock, gg_ctw_tp_word);
-		      tracker_ofstreams_[1] << gg_ctw_tp_word << ';' << std::endl;
-		      decimal_counter++;
-
-		      binary_counter = decimal_counter;
-		      tracker_ofstreams_[1] << binary_counter << " : " << tracker_zero_bitset << ';' << std::endl;
-
-		      decimal_counter++;
-		    }
-		}
-
-	      decimal_counter = initial_counter;
-	      if (tracker_ctw_number == 2)
-		{
-		  // Only 19 FEBs, 36 bits / clock25ns + 36 zero bits
-		  for (std::size_t iblock = 0; iblock < mapping::NUMBER_OF_FEBS_BY_CRATE; iblock++)
-		    {
-		      binary_counter = initial_counter;
-		      tracker_ofstreams_[2] << binary_counter << " : ";
+		      // The crate 2 TP words keep the counter of the first word of the clocktick :
+		      const uint32_t tp_word_counter = (tracker_ctw_number == 2) ? initial_counter : decimal_counter;
 		      std::bitset<geiger::tp::TP_THREE_WIRES_SIZE> gg_ctw_tp_word = 0x0;
 		      a_handle_gg_ctw.get().get_36_bits_in_ctw_word(iblock, gg_ctw_tp_word);
-		      tracker_ofstreams_[2] << gg_ctw_tp_word << ';' << std::endl;
+		      _append_fifo_word(fifo_buffer, tp_word_counter, gg_ctw_tp_word.to_ullong(), tracker_fifo_width);
 		      decimal_counter++;
 
-		      binary_counter = decimal_counter;
-		      tracker_ofstreams_[2] << binary_counter << " : " << tracker_zero_bitset << ';' << std::endl;
-
+		      _append_fifo_word(fifo_buffer, decimal_counter, 0x0, tracker_fifo_width);
 		      decimal_counter++;
 		    }
 		}
+	      if (tracker_ctw_number < 2) decimal_counter = initial_counter;
 
 	    } // end of ictw
 
 	    initial_counter = decimal_counter;
 
-	    tracker_ofstreams_[0] << std::endl;
-	    tracker_ofstreams_[1] << std::endl;
-	    tracker_ofstreams_[2] << std::endl;
+	    for (unsigned int icrate = 0; icrate < mapping::NUMBER_OF_CRATES; icrate++)
+	      {
+		_append_fifo_separator(_tracker_fifo_buffers_[icrate]);
+	      }
 
 	  } // end of CT 1600
 
 	decimal_counter--;
-	std::clog << "binary counter = " << binary_counter << std::endl;
-	std::clog << "decimal counter = " << decimal_counter << std::endl;
-	std::clog << "geiger_begin_new_raster " << geiger_begin_new_raster << std::endl;
 
 	for (uint64_t i = decimal_counter; i < fifo_depth; i++)
 	  {
-	    binary_counter = decimal_counter;
+	    for (unsigned int icrate = 0; icrate < mapping::NUMBER_OF_CRATES; icrate++)
+	      {
+		_append_fifo_word(_tracker_fifo_buffers_[icrate], decimal_counter, 0x0, tracker_fifo_width);
+		if (i != geiger_begin_new_raster && i % tracker_raster_fifo == 0) _append_fifo_separator(_tracker_fifo_buffers_[icrate]);
+	      }
+	    decimal_counter++;
+	  }
+      }
 
-	    tracker_ofstreams_[0] << binary_counter << " : ";
-	    tracker_ofstreams_[0] << tracker_zero_bitset << ';' << std::endl;
+      return;
+    }
 
+    const std::vector<char> & trigger_display_manager::get_calo_fifo_buffer(unsigned int crate_) const
+    {
+      DT_THROW_IF(crate_ >= mapping::NUMBER_OF_CRATES, std::range_error, "Invalid crate number " << crate_ << " ! ");
+      return _calo_fifo_buffers_[crate_];
+    }
 
-	    tracker_ofstreams_[1] << binary_counter << " : ";
-	    tracker_ofstreams_[1] << tracker_zero_bitset << ';' << std::endl;
+    const std::vector<char> & trigger_display_manager::get_tracker_fifo_buffer(unsigned int crate_) const
+    {
+      DT_THROW_IF(crate_ >= mapping::NUMBER_OF_CRATES, std::range_error, "Invalid crate number " << crate_ << " ! ");
+      return _tracker_fifo_buffers_[crate_];
+    }
 
-	    tracker_ofstreams_[2] << binary_counter << " : ";
-	    tracker_ofstreams_[2] << tracker_zero_bitset << ';' << std::endl;
+    void trigger_display_manager::_start_fifo_buffer(std::vector<char> & buffer_, std::size_t width_, std::size_t fifo_depth_) const
+    {
+      DT_THROW_IF(width_ > FIFO_MAX_WIDTH, std::range_error, "FIFO width " << width_ << " is larger than " << FIFO_MAX_WIDTH << " bits ! ");
+      buffer_.clear();
+      if (is_fifo_binary())
+	{
+	  buffer_.reserve((fifo_depth_ + 1) * FIFO_BINARY_RECORD_SIZE);
+	  const uint64_t header = (static_cast<uint64_t>(FIFO_RECORD_HEADER) << FIFO_RECORD_TYPE_SHIFT)
+	    | (static_cast<uint64_t>(FIFO_BINARY_MAGIC) << 16)
+	    | (static_cast<uint64_t>(FIFO_BINARY_VERSION) << 8)
+	    | static_cast<uint64_t>(width_);
+	  buffer_.resize(FIFO_BINARY_RECORD_SIZE);
+	  write_fifo_record(buffer_.data(), header);
+	}
+      else
+	{
+	  buffer_.reserve(fifo_depth_ * (FIFO_COUNTER_SIZE + width_ + 6));
+	}
+      return;
+    }
 
-	    if (i != geiger_begin_new_raster && i % tracker_raster_fifo == 0) {
-	      tracker_ofstreams_[0] << std::endl;
-	      tracker_ofstreams_[1] << std::endl;
-	      tracker_ofstreams_[2] << std::endl;
-	    }
+    void trigger_display_manager::_append_fifo_word(std::vector<char> & buffer_, uint32_t counter_, uint64_t word_, std::size_t width_) const
+    {
+      const std::size_t offset = buffer_.size();
+      const uint32_t counter = counter_ & ((1u << FIFO_COUNTER_SIZE) - 1);
+      if (is_fifo_binary())
+	{
+	  const uint64_t record = (static_cast<uint64_t>(FIFO_RECORD_WORD) << FIFO_RECORD_TYPE_SHIFT)
+	    | (static_cast<uint64_t>(counter) << FIFO_RECORD_COUNTER_SHIFT)
+	    | (word_ & FIFO_RECORD_WORD_MASK);
+	  buffer_.resize(offset + FIFO_BINARY_RECORD_SIZE);
+	  write_fifo_record(buffer_.data() + offset, record);
+	}
+      else
+	{
+	  buffer_.resize(offset + FIFO_COUNTER_SIZE + width_ + 5);
+	  format_fifo_line(buffer_.data() + offset, counter, word_, width_);
+	}
+      return;
+    }
 
-	    decimal_counter++;
-	  }
-      }
+    void trigger_display_manager::_append_fifo_separator(std::vector<char> & buffer_) const
+    {
+      if (is_fifo_binary())
+	{
+	  const std::size_t offset = buffer_.size();
+	  buffer_.resize(offset + FIFO_BINARY_RECORD_SIZE);
+	  write_fifo_record(buffer_.data() + offset, static_cast<uint64_t>(FIFO_RECORD_SEPARATOR) << FIFO_RECORD_TYPE_SHIFT);
+	}
+      else
+	{
+	  buffer_.push_back('\n');
+	}
+      return;
+    }
 
+    void trigger_display_manager::print_binary_fifo(std::istream & in_, std::ostream & out_)
+    {
+      char record_bytes[FIFO_BINARY_RECORD_SIZE];
+      char line[FIFO_COUNTER_SIZE + FIFO_MAX_WIDTH + 5];
+      std::size_t width = 0;
+      while (in_.read(record_bytes, FIFO_BINARY_RECORD_SIZE))
+	{
+	  const uint64_t record = read_fifo_record(record_bytes);
+	  const uint32_t record_type = record >> FIFO_RECORD_TYPE_SHIFT;
+	  if (record_type == FIFO_RECORD_HEADER)
+	    {
+	      const uint32_t magic = (record >> 16) & 0xFFFFFFFF;
+	      const uint32_t version = (record >> 8) & 0xFF;
+	      DT_THROW_IF(magic != FIFO_BINARY_MAGIC, std::logic_error, "Invalid binary FIFO magic number " << std::hex << magic << std::dec << " ! ");
+	      DT_THROW_IF(version != FIFO_BINARY_VERSION, std::logic_error, "Unsupported binary FIFO version " << version << " ! ");
+	      width = record & 0xFF;
+	      DT_THROW_IF(width > FIFO_MAX_WIDTH, std::logic_error, "Invalid binary FIFO width " << width << " ! ");
+	    }
+	  else if (record_type == FIFO_RECORD_WORD)
+	    {
+	      DT_THROW_IF(width == 0, std::logic_error, "Binary FIFO word without header ! ");
+	      const uint32_t counter = (record >> FIFO_RECORD_COUNTER_SHIFT) & ((1u << FIFO_COUNTER_SIZE) - 1);
+	      format_fifo_line(line, counter, record & FIFO_RECORD_WORD_MASK, width);
+	      out_.write(line, FIFO_COUNTER_SIZE + width + 5);
+	    }
+	  else if (record_type == FIFO_RECORD_SEPARATOR)
+	    {
+	      out_.put('\n');
+	    }
+	  else
+	    {
+	      DT_THROW(std::logic_error, "Invalid binary FIFO record type " << record_type << " ! ");
+	    }
+	}
+      DT_THROW_IF(in_.gcount() != 0, std::logic_error, "Truncated binary FIFO record ! ");
+      out_.flush();
+      return;
+    }
+
+    void trigger_display_manager::display_ctw_fifo_trigger_implementation_1600ns(std::ofstream * calo_ofstreams_,
+										 std::ofstream * tracker_ofstreams_,
+										 const calo_ctw_data & a_calo_ctw_data_,
+										 const geiger_ctw_data & a_geiger_ctw_data_)
 
+    {
+      build_ctw_fifo_trigger_implementation_1600ns(a_calo_ctw_data_, a_geiger_ctw_data_);
+      for (unsigned int icrate = 0; icrate < mapping::NUMBER_OF_CRATES; icrate++)
+	{
+	  const std::vector<char> & calo_buffer = _calo_fifo_buffers_[icrate];
+	  if (!calo_buffer.empty())
+	    {
+	      calo_ofstreams_[icrate].write(calo_buffer.data(), calo_buffer.size());
+	      calo_ofstreams_[icrate].flush();
+	    }
+	  const std::vector<char> & tracker_buffer = _tracker_fifo_buffers_[icrate];
+	  if (!tracker_buffer.empty())
+	    {
+	      tracker_ofstreams_[icrate].write(tracker_buffer.data(), tracker_buffer.size());
+	      tracker_ofstreams_[icrate].flush();
+	    }
+	}
       return;
     }
 
     void trigger_display_manager::display_trigger_implementation_1600ns(std::ofstream & out_,
     									const trigger_algorithm & a_trigger_algo_)
     {
-      std::vector<snemo::digitization::trigger_structures::coincidence_event_record> coincidence_collection_records = a_trigger_algo_.get_coincidence_records_vector();
+      const std::vector<snemo::digitization::trigger_structures::coincidence_event_record> & coincidence_collection_records = a_trigger_algo_.get_coincidence_records_vector();
 
+      // The clockticks are formatted in the implementation buffer and written at once :
+      std::string & buffer = _implementation_buffer_;
+      buffer.clear();
       std::size_t number_of_clocktick = coincidence_collection_records.size();
       for (std::size_t i = 0; i < number_of_clocktick; i++)
     	{
-    	  snemo::digitization::trigger_structures::coincidence_event_record a_CER = coincidence_collection_records[i];
-    	  out_ << "Clocktick " << a_CER.clocktick_1600ns << std::endl;
-
-    	  out_ << a_CER.xt_info_bitset << ' ';
-    	  out_ << a_CER.total_multiplicity_threshold << ' ';
-    	  out_ << a_CER.single_side_coinc << ' ';
-	  out_ << a_CER.LTO_gveto << ' ';
-    	  out_ << a_CER.total_multiplicity_gveto << ' ';
-    	  out_ << a_CER.LTO_side_1 << ' ';
-    	  out_ << a_CER.LTO_side_0 << ' ';
-    	  out_ << a_CER.total_multiplicity_side_1 << ' ';
-    	  out_ << a_CER.total_multiplicity_side_0 << ' ';
+    	  const snemo::digitization::trigger_structures::coincidence_event_record & a_CER = coincidence_collection_records[i];
+	  char clocktick_text[32];
+	  std::snprintf(clocktick_text, sizeof(clocktick_text), "Clocktick %u\n", (unsigned int) a_CER.clocktick_1600ns);
+	  buffer += clocktick_text;
+
+	  append_bits(buffer, a_CER.xt_info_bitset.to_ullong(), a_CER.xt_info_bitset.size());
+	  buffer += ' ';
+	  append_flag(buffer, a_CER.total_multiplicity_threshold);
+	  append_flag(buffer, a_CER.single_side_coinc);
+	  append_flag(buffer, a_CER.LTO_gveto);
+	  append_bits(buffer, a_CER.total_multiplicity_gveto.to_ullong(), a_CER.total_multiplicity_gveto.size());
+	  buffer += ' ';
+	  append_flag(buffer, a_CER.LTO_side_1);
+	  append_flag(buffer, a_CER.LTO_side_0);
+	  append_bits(buffer, a_CER.total_multiplicity_side_1.to_ullong(), a_CER.total_multiplicity_side_1.size());
+	  buffer += ' ';
+	  append_bits(buffer, a_CER.total_multiplicity_side_0.to_ullong(), a_CER.total_multiplicity_side_0.size());
+	  buffer += ' ';
     	  for (unsigned int iside = trigger_info::NSIDES-1; iside != (unsigned)0-1; iside--)
     	    {
-    	      for (unsigned int izone = trigger_info::NZONES-1; izone != (unsigned)0-1 ; izone--)
-    		{
-    		  out_ << a_CER.calo_zoning_word[iside][izone];
-    		}
-    	      out_ << ' ';
+	      append_bits(buffer, a_CER.calo_zoning_word[iside].to_ullong(), trigger_info::NZONES);
+	      buffer += ' ';
     	    }
-    	  out_ << std::endl;
+	  buffer += '\n';
 
 	  for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
 	    {
-	      out_ << "S" << iside << " ";
+	      buffer += 'S';
+	      buffer += (char) ('0' + iside);
+	      buffer += ' ';
 	      for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
 		{
-		  out_ << a_CER.tracker_finale_data_per_zone[iside][izone] << ' ';
+		  append_bits(buffer, a_CER.tracker_finale_data_per_zone[iside][izone].to_ullong(), trigger_info::DATA_FULL_BITSET_SIZE);
+		  buffer += ' ';
 		} // end of izone
-	      out_ << std::endl;
+	      buffer += '\n';
 	    }
 
-	  for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	  // Zoning words are written from the first zone to the last one :
+	  const char * zoning_word_labels[3] = {"ZW_PAT_S", "ZW_NSZ_S", "ZW_COI_S"};
+	  const trigger_structures::zoning_word_type * zoning_words[3] = {a_CER.tracker_zoning_word_pattern,
+									  a_CER.tracker_zoning_word_near_source,
+									  a_CER.coincidence_zoning_word};
+	  for (unsigned int iword = 0; iword < 3; iword++)
 	    {
-	      out_ << "ZW_PAT_S" << iside << ' ';
-	      for (unsigned int ibit = 0; ibit < a_CER.tracker_zoning_word_pattern[0].size(); ibit++)
+	      for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
 		{
-		  out_ << a_CER.tracker_zoning_word_pattern[iside][ibit];
+		  buffer += zoning_word_labels[iword];
+		  buffer += (char) ('0' + iside);
+		  buffer += ' ';
+		  append_bits(buffer, zoning_words[iword][iside].to_ullong(), trigger_info::NZONES, false);
+		  buffer += ' ';
 		}
-	      out_ << ' ';
+	      buffer += '\n';
 	    }
-	  out_ << std::endl;
-
-	  for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
-	    {
-	      out_ << "ZW_NSZ_S" << iside << ' ';
-	      for (unsigned int ibit = 0; ibit < a_CER.tracker_zoning_word_near_source[0].size(); ibit++)
-		{
-		  out_ << a_CER.tracker_zoning_word_near_source[iside][ibit];
-		}
-	      out_ << ' ';
-	    }
-	  out_ << std::endl;
-
-	  for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
-	    {
-	      out_ << "ZW_COI_S" << iside << ' ';
-	      for (unsigned int ibit = 0; ibit < a_CER.coincidence_zoning_word[0].size(); ibit++)
-		{
-		  out_ << a_CER.coincidence_zoning_word[iside][ibit];
-		}
-	      out_ << ' ';
-	    }
-	  out_ << std::endl;
 
 	} // end of iclocktick
 
+      out_.write(buffer.data(), buffer.size());
+      out_.flush();
       return;
     }
 
     void trigger_display_manager::fill_matrix_pattern()
     {
-      for (unsigned int j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-    	{
-    	  if (j == 0) _char_matrix_[10][j] = ' ';
-    	  else _char_matrix_[10][j] = '_';
-    	}
-
       for (unsigned int i = 0; i < NUMBER_OF_VERTICAL_CHAR; i++)
     	{
-    	  for (unsigned int j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-    	    {
-    	      if (i == 0 || i == 20)
-    		{
-    		  if (j == 0 || j == 1) _char_matrix_[i][j] = ' ';
-    		  else if (j == 2 || j == 116) _char_matrix_[i][j] = '|';
-    		  else if (j == 3 || j == 12 || j == 24 || j == 36 || j == 48 || j == 60 || j == 71 || j == 83 || j == 95 || j == 107) _char_matrix_[i][j] = '[';
-    		  else if (j == 11 || j == 23 || j == 35 || j == 47 || j == 59 || j == 70 || j == 82 || j == 94 || j == 106 || j == 115) _char_matrix_[i][j] = ']';
-    		  else _char_matrix_[i][j] = ' ';
-    		}
-
-    	      else
-    		{
-    		  if (j == 0 || j == 1) _char_matrix_[i][j] = ' ';
-    		  else if (j == 2 || j == 116) _char_matrix_[i][j] = '|';
-    		}
-    	    }
-    	}
-      for (unsigned int i = 1; i < NUMBER_OF_VERTICAL_CHAR - 1; i++)
-    	{
-    	  for (unsigned int j = 3; j < NUMBER_OF_HORIZONTAL_CHAR - 1; j++)
-    	    {
-    	      if (i == 10) {}
-    	      else _char_matrix_[i][j] = '.';
-    	    }
+	  const char * line_template = TRACKER_LINE_TEMPLATE;
+	  if (i == CALO_ZONE_ROW[0] || i == CALO_ZONE_ROW[1]) line_template = CALO_LINE_TEMPLATE;
+	  else if (i == SEPARATOR_ROW) line_template = SEPARATOR_LINE_TEMPLATE;
+	  std::memcpy(_char_matrix_[i], line_template, MATRIX_LINE_SIZE);
     	}
       return;
     }
@@ -1179,25 +1088,9 @@ namespace snemo {
 
     void trigger_display_manager::reset_calo_display()
     {
-      for (unsigned int i = 0; i < NUMBER_OF_VERTICAL_CHAR; i++)
+      for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
     	{
-    	  for (unsigned int j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-    	    {
-    	      if (i == 0 || i == 20)
-    		{
-    		  if (j == 0 || j == 1) _char_matrix_[i][j] = ' ';
-    		  else if (j == 2 || j == 116) _char_matrix_[i][j] = '|';
-    		  else if (j == 3 || j == 12 || j == 24 || j == 36 || j == 48 || j == 60 || j == 71 || j == 83 || j == 95 || j == 107) _char_matrix_[i][j] = '[';
-    		  else if (j == 11 || j == 23 || j == 35 || j == 47 || j == 59 || j == 70 || j == 82 || j == 94 || j == 106 || j == 115) _char_matrix_[i][j] = ']';
-    		  else _char_matrix_[i][j] = ' ';
-    		}
-
-    	      else
-    		{
-    		  if (j == 0 || j == 1) _char_matrix_[i][j] = ' ';
-    		  else if (j == 2 || j == 116) _char_matrix_[i][j] = '|';
-    		}
-    	    }
+	  std::memcpy(_char_matrix_[CALO_ZONE_ROW[iside]], CALO_LINE_TEMPLATE, MATRIX_LINE_SIZE);
     	}
       return;
     }
@@ -1206,28 +1099,25 @@ namespace snemo {
     {
       for (unsigned int i = 1; i < NUMBER_OF_VERTICAL_CHAR - 1; i++)
     	{
-    	  for (unsigned int j = 3; j < NUMBER_OF_HORIZONTAL_CHAR - 1; j++)
-    	    {
-    	      if (i == 10) {}
-    	      else _char_matrix_[i][j] = '.';
-    	    }
+    	  if (i != SEPARATOR_ROW) std::memcpy(_char_matrix_[i], TRACKER_LINE_TEMPLATE, MATRIX_LINE_SIZE);
     	}
       return;
     }
 
     void trigger_display_manager::display_matrix()
     {
-      std::clog << "     Zone0      Zone1       Zone2       Zone3       Zone4      Zone5       Zone6       Zone7      Zone 8     Zone9 " << std::endl;
-      for (unsigned int i = 0; i < NUMBER_OF_VERTICAL_CHAR; i++)
-    	{
-    	  for (unsigned int j = 0; j < NUMBER_OF_HORIZONTAL_CHAR; j++)
-    	    {
-    	      std::clog << _char_matrix_[i][j];
-    	    }
-    	  std::clog << std::endl;
-    	}
-      std::clog << "     Zone0      Zone1       Zone2       Zone3       Zone4      Zone5       Zone6       Zone7      Zone 8     Zone9 " << std::endl;
-      std::clog << std::endl;
+      display_matrix(std::clog);
+      return;
+    }
+
+    void trigger_display_manager::display_matrix(std::ostream & out_) const
+    {
+      // Matrix lines are stored with their new line, the matrix is written at once :
+      out_.write(ZONES_LINE, sizeof(ZONES_LINE) - 1);
+      out_.write(&_char_matrix_[0][0], sizeof(_char_matrix_));
+      out_.write(ZONES_LINE, sizeof(ZONES_LINE) - 1);
+      out_ << std::endl;
+      return;
     }
 
   } // end of namespace digitization
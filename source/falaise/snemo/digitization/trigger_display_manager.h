@@ -7,7 +7,9 @@
 // Standard library :
 #include <string>
 #include <bitset>
+#include <vector>
 #include <iostream>
+#include <fstream>
 
 // This project :
 #include <snemo/digitization/electronic_mapping.h>
@@ -33,6 +35,12 @@ namespace snemo {
 		/// - Geiger matrix each 1600ns
 		/// - Coincidences between calorimeter zones and Geiger matrix each 1600ns
 		// /// - Coincidence when the trigger decision is true for the first time
+		///
+		/// The displays are formatted into buffers allocated once (matrix lines
+		/// ended by a new line, FIFO and implementation buffers keeping their
+		/// capacity) and written with one bulk write per stream. The CTW FIFO
+		/// dumps can be written in a compact binary form (8 bytes per FIFO
+		/// line) which print_binary_fifo() turns back into the text form.
 
     class trigger_display_manager
     {
@@ -44,6 +52,33 @@ namespace snemo {
 			/// Number of vertical characters for display
 			static const uint32_t NUMBER_OF_VERTICAL_CHAR = 21;
 
+			/// Number of characters of a display matrix line, new line included
+			static const uint32_t MATRIX_LINE_SIZE = NUMBER_OF_HORIZONTAL_CHAR + 1;
+
+			/// Number of bits of the FIFO lines counter
+			static const uint32_t FIFO_COUNTER_SIZE = 13;
+
+			/// Size in bytes of a binary FIFO record
+			static const uint32_t FIFO_BINARY_RECORD_SIZE = 8;
+
+			/// Magic number of a binary FIFO dump header
+			static const uint32_t FIFO_BINARY_MAGIC = 0x46494630;
+
+			/// Version of the binary FIFO dump format
+			static const uint32_t FIFO_BINARY_VERSION = 1;
+
+			/// \brief Type of a binary FIFO record, stored in its two most significant bits
+			///
+			/// A word record holds the word in bits [0;48[ and the FIFO
+			/// counter in bits [48;61[. A header record holds the word width
+			/// in bits [0;8[, the version in bits [8;16[ and the magic number
+			/// in bits [16;48[. Records are written little endian.
+			enum fifo_record_type {
+				FIFO_RECORD_WORD      = 0, //!< FIFO line with its counter and word
+				FIFO_RECORD_HEADER    = 1, //!< Dump header
+				FIFO_RECORD_SEPARATOR = 2  //!< Empty line between two rasters
+			};
+
       /// Default constructor
       trigger_display_manager();
 
@@ -77,6 +112,9 @@ namespace snemo {
 			/// Check if the decision trigger config is activated
 			bool is_decision_trigger() const;
 
+			/// Check if the CTW FIFO dumps are written in binary form
+			bool is_fifo_binary() const;
+
 			/// Fill calorimeter zones for 25ns
 			void fill_calo_trigger_matrix_25ns(std::bitset<10> zoning_word_[trigger_info::NSIDES]);
 
@@ -116,6 +154,19 @@ namespace snemo {
 			/// Display calorimeter zones and tracker matrix each 1600 for the clocktick decision
 			void display_decision_trigger();
 
+			/// Format the CTW FIFOs of a coincidence event 1600ns for trigger board implementation at LAL into the FIFO buffers
+			void build_ctw_fifo_trigger_implementation_1600ns(const calo_ctw_data & a_calo_ctw_data_,
+																												const geiger_ctw_data & a_geiger_ctw_data_);
+
+			/// Return the FIFO buffer of a calorimeter crate
+			const std::vector<char> & get_calo_fifo_buffer(unsigned int crate_) const;
+
+			/// Return the FIFO buffer of a tracker crate
+			const std::vector<char> & get_tracker_fifo_buffer(unsigned int crate_) const;
+
+			/// Print a binary FIFO dump in the text form
+			static void print_binary_fifo(std::istream & in_, std::ostream & out_);
+
 			/// Display few clockticks for a coincidence event 1600ns for trigger board implementation at LAL
 			void display_ctw_fifo_trigger_implementation_1600ns(std::ofstream * calo_ofstreams_,
 																													std::ofstream * tracker_ofstreams_,
@@ -141,6 +192,23 @@ namespace snemo {
 			/// Display the total matrix
 			void display_matrix();
 
+			/// Display the total matrix in an output stream
+			void display_matrix(std::ostream & out_) const;
+
+		protected :
+
+			/// Fill the calorimeter zones rows
+			void _fill_calo_zones(const std::bitset<10> zoning_word_[trigger_info::NSIDES]);
+
+			/// Clear a FIFO buffer and start a new dump in it
+			void _start_fifo_buffer(std::vector<char> & buffer_, std::size_t width_, std::size_t fifo_depth_) const;
+
+			/// Append a FIFO line to a FIFO buffer
+			void _append_fifo_word(std::vector<char> & buffer_, uint32_t counter_, uint64_t word_, std::size_t width_) const;
+
+			/// Append an empty line to a FIFO buffer
+			void _append_fifo_separator(std::vector<char> & buffer_) const;
+
     private :
 
       // Configuration :
@@ -150,9 +218,13 @@ namespace snemo {
       bool _tracker_1600ns_;   //!< Configuration to display tracker@1600ns
       bool _coinc_1600ns_;     //!< Configuration to display coinc@1600ns
 			bool _decision_trigger_; //!< Configuration to display the moment when the trigger decision is true
+			bool _fifo_binary_;      //!< Configuration to write the CTW FIFO dumps in binary form
 
 			// Data :
-			char _char_matrix_[NUMBER_OF_VERTICAL_CHAR][NUMBER_OF_HORIZONTAL_CHAR]; //!< Matrix of characters representing calorimeter zones and geiger matrix
+			char _char_matrix_[NUMBER_OF_VERTICAL_CHAR][MATRIX_LINE_SIZE]; //!< Matrix of characters representing calorimeter zones and geiger matrix, each line ended by a new line
+			std::vector<char> _calo_fifo_buffers_[mapping::NUMBER_OF_CRATES];    //!< Calorimeter CTW FIFO dumps
+			std::vector<char> _tracker_fifo_buffers_[mapping::NUMBER_OF_CRATES]; //!< Tracker CTW FIFO dumps
+			std::string _implementation_buffer_; //!< Trigger implementation display
     };
 
   } // end of namespace digitization
@@ -0,0 +1,243 @@
+// snemo/digitization/trigger_firmware.cc
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+// Standard library :
+#include <algorithm>
+
+// Ourselves:
+#include <snemo/digitization/trigger_firmware.h>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+#include <datatools/multi_properties.h>
+#include <datatools/utils.h>
+
+// This project :
+#include <snemo/digitization/electronic_mapping.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+    const uint16_t trigger_firmware::INVALID_CELL;
+    const unsigned int trigger_firmware::NUMBER_OF_BOARD_IDS;
+    const unsigned int trigger_firmware::NUMBER_OF_TP_CHANNELS;
+    const unsigned int trigger_firmware::NUMBER_OF_ZONE_PATTERNS;
+
+    trigger_firmware::trigger_firmware()
+    {
+      _initialized_ = false;
+      _electronic_mapping_ = 0;
+      std::fill(&_cell_indexes_[0][0][0], &_cell_indexes_[0][0][0] + mapping::NUMBER_OF_CRATES * NUMBER_OF_BOARD_IDS * NUMBER_OF_TP_CHANNELS, INVALID_CELL);
+      std::fill(_zone_patterns_, _zone_patterns_ + NUMBER_OF_ZONE_PATTERNS, 0);
+      return;
+    }
+
+    trigger_firmware::~trigger_firmware()
+    {
+      if (is_initialized())
+	{
+	  reset();
+	}
+      return;
+    }
+
+    void trigger_firmware::set_electronic_mapping(const electronic_mapping & my_electronic_mapping_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger firmware is already initialized, electronic mapping can't be set ! ");
+      _electronic_mapping_ = & my_electronic_mapping_;
+      return;
+    }
+
+    void trigger_firmware::load_mem1(const std::string & filename_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger firmware is already initialized ! ");
+      _sliding_zone_vertical_memory_.load_from_file(filename_);
+      return;
+    }
+
+    void trigger_firmware::load_mem2(const std::string & filename_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger firmware is already initialized ! ");
+      _sliding_zone_horizontal_memory_.load_from_file(filename_);
+      return;
+    }
+
+    void trigger_firmware::load_mem3(const std::string & filename_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger firmware is already initialized ! ");
+      _zone_vertical_memory_.load_from_file(filename_);
+      return;
+    }
+
+    void trigger_firmware::load_mem4(const std::string & filename_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger firmware is already initialized ! ");
+      _zone_horizontal_memory_.load_from_file(filename_);
+      return;
+    }
+
+    void trigger_firmware::load_mem5(const std::string & filename_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger firmware is already initialized ! ");
+      _zone_vertical_for_horizontal_memory_.load_from_file(filename_);
+      return;
+    }
+
+    void trigger_firmware::initialize()
+    {
+      datatools::properties dummy_config;
+      initialize(dummy_config);
+      return;
+    }
+
+    void trigger_firmware::initialize(const datatools::properties & tracker_config_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger firmware is already initialized ! ");
+      DT_THROW_IF(_electronic_mapping_ == 0, std::logic_error, "Missing electronic mapping ! " );
+
+      if (tracker_config_.has_key("mem1_file")) {
+	std::string mem1_filename = tracker_config_.fetch_string("mem1_file");
+	datatools::fetch_path_with_env(mem1_filename);
+	load_mem1(mem1_filename);
+      }
+
+      if (tracker_config_.has_key("mem2_file")) {
+	std::string mem2_filename = tracker_config_.fetch_string("mem2_file");
+	datatools::fetch_path_with_env(mem2_filename);
+	load_mem2(mem2_filename);
+      }
+
+      if (tracker_config_.has_key("mem3_file")) {
+	std::string mem3_filename = tracker_config_.fetch_string("mem3_file");
+	datatools::fetch_path_with_env(mem3_filename);
+	load_mem3(mem3_filename);
+      }
+
+      if (tracker_config_.has_key("mem4_file")) {
+	std::string mem4_filename = tracker_config_.fetch_string("mem4_file");
+	datatools::fetch_path_with_env(mem4_filename);
+	load_mem4(mem4_filename);
+      }
+
+      if (tracker_config_.has_key("mem5_file")) {
+	std::string mem5_filename = tracker_config_.fetch_string("mem5_file");
+	datatools::fetch_path_with_env(mem5_filename);
+	load_mem5(mem5_filename);
+      }
+
+      _build_cell_indexes();
+      _build_zone_patterns();
+      _initialized_ = true;
+      return;
+    }
+
+    bool trigger_firmware::is_initialized() const
+    {
+      return _initialized_;
+    }
+
+    void trigger_firmware::reset()
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Trigger firmware is not initialized, it can't be reset ! ");
+      _initialized_ = false;
+      _electronic_mapping_ = 0;
+      _sliding_zone_vertical_memory_.reset();
+      _sliding_zone_horizontal_memory_.reset();
+      _zone_vertical_memory_.reset();
+      _zone_horizontal_memory_.reset();
+      _zone_vertical_for_horizontal_memory_.reset();
+      std::fill(&_cell_indexes_[0][0][0], &_cell_indexes_[0][0][0] + mapping::NUMBER_OF_CRATES * NUMBER_OF_BOARD_IDS * NUMBER_OF_TP_CHANNELS, INVALID_CELL);
+      std::fill(_zone_patterns_, _zone_patterns_ + NUMBER_OF_ZONE_PATTERNS, 0);
+      return;
+    }
+
+    const tracker_trigger_mem_maker::mem1_type & trigger_firmware::get_sliding_zone_vertical_memory() const
+    {
+      return _sliding_zone_vertical_memory_;
+    }
+
+    const tracker_trigger_mem_maker::mem2_type & trigger_firmware::get_sliding_zone_horizontal_memory() const
+    {
+      return _sliding_zone_horizontal_memory_;
+    }
+
+    const tracker_trigger_mem_maker::mem3_type & trigger_firmware::get_zone_vertical_memory() const
+    {
+      return _zone_vertical_memory_;
+    }
+
+    const tracker_trigger_mem_maker::mem4_type & trigger_firmware::get_zone_horizontal_memory() const
+    {
+      return _zone_horizontal_memory_;
+    }
+
+    const tracker_trigger_mem_maker::mem5_type & trigger_firmware::get_zone_vertical_for_horizontal_memory() const
+    {
+      return _zone_vertical_for_horizontal_memory_;
+    }
+
+    std::shared_ptr<const trigger_firmware> trigger_firmware::build(const datatools::multi_properties & mconfig_,
+								       const electronic_mapping & my_electronic_mapping_)
+    {
+      std::shared_ptr<trigger_firmware> a_firmware(new trigger_firmware);
+      a_firmware->set_electronic_mapping(my_electronic_mapping_);
+      datatools::properties tracker_config;
+      if (mconfig_.has_section("tracker")) tracker_config = mconfig_.get_section("tracker");
+      a_firmware->initialize(tracker_config);
+      return a_firmware;
+    }
+
+    void trigger_firmware::_build_cell_indexes()
+    {
+      for (unsigned int icrate = 0; icrate < mapping::NUMBER_OF_CRATES; icrate++)
+	{
+	  for (unsigned int iboard = 0; iboard < NUMBER_OF_BOARD_IDS; iboard++)
+	    {
+	      for (unsigned int ichannel = 0; ichannel < NUMBER_OF_TP_CHANNELS; ichannel++)
+		{
+		  _cell_indexes_[icrate][iboard][ichannel] = INVALID_CELL;
+		  geomtools::geom_id electronic_id;
+		  electronic_id.set_depth(mapping::CHANNEL_DEPTH);
+		  electronic_id.set_type(mapping::FEB_CATEGORY_TYPE);
+		  electronic_id.set(mapping::RACK_INDEX, mapping::GEIGER_RACK_ID);
+		  electronic_id.set(mapping::CRATE_INDEX, icrate);
+		  electronic_id.set(mapping::BOARD_INDEX, iboard);
+		  electronic_id.set(mapping::CHANNEL_INDEX, geiger::tp::TP_BEGIN + ichannel);
+		  geomtools::geom_id cell_gid;
+		  _electronic_mapping_->convert_EID_to_GID(mapping::THREE_WIRES_TRACKER_MODE, electronic_id, cell_gid);
+		  if (!cell_gid.is_valid() || cell_gid.get_type() != mapping::GEIGER_CATEGORY_TYPE) continue;
+		  const unsigned int side  = cell_gid.get(mapping::SIDE_INDEX);
+		  const unsigned int layer = cell_gid.get(mapping::LAYER_INDEX);
+		  const unsigned int row   = cell_gid.get(mapping::ROW_INDEX);
+		  if (side >= trigger_info::NSIDES || layer >= trigger_info::NLAYERS || row >= trigger_info::NROWS) continue;
+		  _cell_indexes_[icrate][iboard][ichannel] = cell_index(side, layer, row);
+		}
+	    }
+	}
+      return;
+    }
+
+    void trigger_firmware::_build_zone_patterns()
+    {
+      // Same fetches as tracker_trigger_algorithm::build_in_out_pattern and build_left_mid_right_pattern,
+      // memory 5 gives the horizontal data when the reduced LR address is empty :
+      for (unsigned int io_address = 0; io_address < (1u << trigger_info::ZONE_ADDR_IO_PATTERN_SIZE); io_address++)
+	{
+	  const unsigned long io_data = _zone_vertical_memory_.fetch(tracker_trigger_mem_maker::mem3_type::address_type(io_address)).to_ulong();
+	  const unsigned long lmr_data_from_io = _zone_vertical_for_horizontal_memory_.fetch(tracker_trigger_mem_maker::mem5_type::address_type(io_address)).to_ulong();
+	  for (unsigned int lr_address = 0; lr_address < (1u << trigger_info::ZONE_ADDR_LMR_PATTERN_SIZE); lr_address++)
+	    {
+	      const unsigned long lmr_data = lr_address != 0 ? _zone_horizontal_memory_.fetch(tracker_trigger_mem_maker::mem4_type::address_type(lr_address)).to_ulong() : lmr_data_from_io;
+	      _zone_patterns_[(lr_address << trigger_info::ZONE_ADDR_IO_PATTERN_SIZE) | io_address] = io_data | (lmr_data << trigger_info::DATA_IO_PATTERN_SIZE);
+	    }
+	}
+      return;
+    }
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
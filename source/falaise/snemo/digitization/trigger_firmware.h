@@ -0,0 +1,165 @@
+// snemo/digitization/trigger_firmware.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_FIRMWARE_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_FIRMWARE_H
+
+// Standard library :
+#include <string>
+#include <memory>
+
+// - Boost:
+#include <boost/cstdint.hpp>
+
+// This project :
+#include <snemo/digitization/tracker_trigger_mem_maker.h>
+#include <snemo/digitization/geiger_tp_constants.h>
+#include <snemo/digitization/mapping.h>
+#include <snemo/digitization/trigger_info.h>
+
+namespace datatools {
+	class properties;
+	class multi_properties;
+}
+
+namespace snemo {
+
+  namespace digitization {
+
+		class electronic_mapping;
+
+		/// \brief Read only image of the trigger firmware
+		///
+		/// The image holds the tracker trigger memories (LUTs) and the table
+		/// decoding the Geiger CTWs channels into tracker cells. It is loaded once
+		/// from the 'tracker' section of the trigger configuration and is not
+		/// modified once initialized : tracker trigger algorithms (trigger scan
+		/// configurations, parallel workers) share it through a pointer to const,
+		/// without lock, and the memory use does not depend on their number.
+		class trigger_firmware
+		{
+		public :
+
+			/// Invalid cell index of the Geiger channels decoding table (unmapped channel)
+			static const uint16_t INVALID_CELL = 0xFFFF;
+
+			/// Number of board IDs of a Geiger crate (5 bits board ID)
+			static const unsigned int NUMBER_OF_BOARD_IDS = 32;
+
+			/// Number of trigger primitive channels of a Geiger FEB (three wires mode)
+			static const unsigned int NUMBER_OF_TP_CHANNELS = geiger::tp::TP_THREE_WIRES_END - geiger::tp::TP_BEGIN + 1;
+
+			/// Number of entries of the zone patterns LUT, addressed by the zone IO address and the reduced zone LR address
+			static const unsigned int NUMBER_OF_ZONE_PATTERNS = 1 << (trigger_info::ZONE_ADDR_IO_PATTERN_SIZE + trigger_info::ZONE_ADDR_LMR_PATTERN_SIZE);
+
+			/// Default constructor
+			trigger_firmware();
+
+			/// Destructor
+			virtual ~trigger_firmware();
+
+			/// Set the electronic mapping object used to build the Geiger channels decoding table
+			void set_electronic_mapping(const electronic_mapping & my_electronic_mapping_);
+
+			/// Load memory 1 (sliding zone vertical memory)
+			void load_mem1(const std::string & filename_);
+
+			/// Load memory 2 (sliding zone horizontal memory)
+			void load_mem2(const std::string & filename_);
+
+			/// Load memory 3 (zone vertical memory)
+			void load_mem3(const std::string & filename_);
+
+			/// Load memory 4 (zone horizontal memory)
+			void load_mem4(const std::string & filename_);
+
+			/// Load memory 5 (zone vertical for horizontal memory)
+			void load_mem5(const std::string & filename_);
+
+			/// Initializing, the image is read only afterwards
+			void initialize();
+
+			/// Initializing from the tracker section of the trigger configuration
+			void initialize(const datatools::properties & tracker_config_);
+
+			/// Check if the image is initialized
+			bool is_initialized() const;
+
+			/// Reset the image
+			void reset();
+
+			/// Return the sliding zone vertical memory
+			const tracker_trigger_mem_maker::mem1_type & get_sliding_zone_vertical_memory() const;
+
+			/// Return the sliding zone horizontal memory
+			const tracker_trigger_mem_maker::mem2_type & get_sliding_zone_horizontal_memory() const;
+
+			/// Return the zone vertical memory
+			const tracker_trigger_mem_maker::mem3_type & get_zone_vertical_memory() const;
+
+			/// Return the zone horizontal memory
+			const tracker_trigger_mem_maker::mem4_type & get_zone_horizontal_memory() const;
+
+			/// Return the zone vertical for horizontal memory
+			const tracker_trigger_mem_maker::mem5_type & get_zone_vertical_for_horizontal_memory() const;
+
+			/// Return the index of a tracker cell in the Geiger matrix
+			static unsigned int cell_index(unsigned int side_, unsigned int layer_, unsigned int row_)
+			{
+				return (side_ * trigger_info::NLAYERS + layer_) * trigger_info::NROWS + row_;
+			}
+
+			/// Return the index of the tracker cell of a Geiger channel (INVALID_CELL if not mapped)
+			uint16_t get_cell_index(unsigned int crate_, unsigned int board_id_, unsigned int channel_) const
+			{
+				return _cell_indexes_[crate_][board_id_][channel_];
+			}
+
+			/// Return the zone data (INNER, OUTER, RIGHT, MIDDLE and LEFT bits of the tracker record) of a zone IO address and reduced LR address
+			uint8_t get_zone_pattern(unsigned int io_address_, unsigned int lr_address_) const
+			{
+				return _zone_patterns_[(lr_address_ << trigger_info::ZONE_ADDR_IO_PATTERN_SIZE) | io_address_];
+			}
+
+			/// Build a shared image from the tracker section of a trigger configuration
+			static std::shared_ptr<const trigger_firmware> build(const datatools::multi_properties & mconfig_,
+																																 const electronic_mapping & my_electronic_mapping_);
+
+		protected :
+
+			/// Build the Geiger channels decoding table from the electronic mapping
+			void _build_cell_indexes();
+
+			/// Build the dense zone patterns LUT from memories 3, 4 and 5
+			void _build_zone_patterns();
+
+		private :
+
+			bool _initialized_; //!< Initialization flag
+			const electronic_mapping * _electronic_mapping_; //!< Convert electronic ID into geometric ID
+
+			tracker_trigger_mem_maker::mem1_type _sliding_zone_vertical_memory_;        //!< Memory 1
+			tracker_trigger_mem_maker::mem2_type _sliding_zone_horizontal_memory_;      //!< Memory 2
+			tracker_trigger_mem_maker::mem3_type _zone_vertical_memory_;                //!< Memory 3
+			tracker_trigger_mem_maker::mem4_type _zone_horizontal_memory_;              //!< Memory 4
+			tracker_trigger_mem_maker::mem5_type _zone_vertical_for_horizontal_memory_; //!< Memory 5
+
+			uint16_t _cell_indexes_[mapping::NUMBER_OF_CRATES][NUMBER_OF_BOARD_IDS][NUMBER_OF_TP_CHANNELS]; //!< Cell index per Geiger crate, board ID and channel
+			uint8_t _zone_patterns_[NUMBER_OF_ZONE_PATTERNS]; //!< Zone data per zone IO address and reduced zone LR address
+
+		};
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_FIRMWARE_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,148 @@
+// snemo/digitization/trigger_record_reader.cc
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+// Ourselves:
+#include <snemo/digitization/trigger_record_reader.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+    namespace {
+
+      bool read_uint32(std::ifstream & file_, uint32_t & value_)
+      {
+	file_.read(reinterpret_cast<char *>(&value_), sizeof(uint32_t));
+	return file_.gcount() == sizeof(uint32_t);
+      }
+
+    }
+
+    trigger_record_reader::trigger_record_reader()
+    {
+      _format_version_ = 0;
+      _number_of_events_in_chunk_ = 0;
+      _next_event_index_ = 0;
+      return;
+    }
+
+    trigger_record_reader::~trigger_record_reader()
+    {
+      if (is_open()) close();
+      return;
+    }
+
+    void trigger_record_reader::open(const std::string & filename_)
+    {
+      DT_THROW_IF(is_open(), std::logic_error, "Reader is already open with file '" << _filename_ << "' ! ");
+      _file_.open(filename_.c_str(), std::ios::in | std::ios::binary);
+      DT_THROW_IF(!_file_, std::runtime_error, "Cannot open file '" << filename_ << "' ! ");
+      char magic[trigger_records_format::MAGIC_SIZE];
+      _file_.read(magic, trigger_records_format::MAGIC_SIZE);
+      const bool valid_magic = (_file_.gcount() == (std::streamsize) trigger_records_format::MAGIC_SIZE)
+	&& std::memcmp(magic, trigger_records_format::magic(), trigger_records_format::MAGIC_SIZE) == 0;
+      uint32_t number_of_columns = 0;
+      const bool valid_header = valid_magic
+	&& read_uint32(_file_, _format_version_)
+	&& read_uint32(_file_, number_of_columns);
+      if (!valid_header
+	  || _format_version_ != trigger_records_format::FORMAT_VERSION
+	  || number_of_columns != trigger_records_format::NUMBER_OF_COLUMNS)
+	{
+	  _file_.close();
+	  DT_THROW_IF(true, std::logic_error, "File '" << filename_ << "' is not a supported trigger records file ! ");
+	}
+      _filename_ = filename_;
+      _columns_.assign(trigger_records_format::NUMBER_OF_COLUMNS, std::string());
+      _number_of_events_in_chunk_ = 0;
+      _next_event_index_ = 0;
+      return;
+    }
+
+    bool trigger_record_reader::is_open() const
+    {
+      return _file_.is_open();
+    }
+
+    void trigger_record_reader::close()
+    {
+      DT_THROW_IF(!is_open(), std::logic_error, "Reader is not open ! ");
+      _file_.close();
+      _filename_.clear();
+      _format_version_ = 0;
+      _columns_.clear();
+      _number_of_events_in_chunk_ = 0;
+      _next_event_index_ = 0;
+      _record_offsets_.clear();
+      _stored_buffer_.clear();
+      return;
+    }
+
+    bool trigger_record_reader::load_next_chunk()
+    {
+      DT_THROW_IF(!is_open(), std::logic_error, "Reader is not open ! ");
+      _number_of_events_in_chunk_ = 0;
+      _next_event_index_ = 0;
+      _record_offsets_.assign(trigger_records_format::NUMBER_OF_COLUMNS, 0);
+
+      uint32_t number_of_events = 0;
+      if (!read_uint32(_file_, number_of_events)) return false;
+
+      for (std::size_t icol = 0; icol < _columns_.size(); icol++)
+	{
+	  uint32_t raw_size = 0;
+	  uint32_t stored_size = 0;
+	  DT_THROW_IF(!read_uint32(_file_, raw_size) || !read_uint32(_file_, stored_size),
+		      std::runtime_error, "Truncated chunk in file '" << _filename_ << "' ! ");
+	  std::string & raw_column = _columns_[icol];
+	  std::string & target = (stored_size == raw_size) ? raw_column : _stored_buffer_;
+	  target.resize(stored_size);
+	  if (stored_size > 0) _file_.read(&target[0], stored_size);
+	  DT_THROW_IF(_file_.gcount() != (std::streamsize) stored_size && stored_size > 0,
+		      std::runtime_error, "Truncated column '" << trigger_records_format::get_column_name(static_cast<trigger_records_format::column_id>(icol))
+		      << "' in file '" << _filename_ << "' ! ");
+	  if (stored_size != raw_size) trigger_records_format::uncompress_column(_stored_buffer_, raw_size, raw_column);
+	}
+      _number_of_events_in_chunk_ = number_of_events;
+      return true;
+    }
+
+    std::size_t trigger_record_reader::get_number_of_events_in_chunk() const
+    {
+      return _number_of_events_in_chunk_;
+    }
+
+    const std::string & trigger_record_reader::get_column(trigger_records_format::column_id column_) const
+    {
+      DT_THROW_IF(column_ >= _columns_.size(), std::range_error, "Invalid column " << column_ << " ! ");
+      return _columns_[column_];
+    }
+
+    std::size_t trigger_record_reader::get_number_of_values(trigger_records_format::column_id column_) const
+    {
+      return get_column(column_).size() / trigger_records_format::get_column_width(column_);
+    }
+
+    bool trigger_record_reader::read_next_event(trigger_event_records & event_)
+    {
+      while (_next_event_index_ >= _number_of_events_in_chunk_)
+	{
+	  if (!load_next_chunk()) return false;
+	}
+      trigger_records_format::extract_event(_columns_, _next_event_index_, _record_offsets_, event_);
+      _next_event_index_++;
+      return true;
+    }
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,103 @@
+// snemo/digitization/trigger_record_reader.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_RECORD_READER_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_RECORD_READER_H
+
+// Standard library :
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstring>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project :
+#include <snemo/digitization/trigger_records_format.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+		/// \brief Streaming reader of trigger records in the columnar chunked format.
+		///
+		/// Chunks are loaded one at a time. Columns of the current chunk can be
+		/// scanned directly (e.g. all L2 decisions) without rebuilding the records,
+		/// or events can be rebuilt one by one with read_next_event.
+		class trigger_record_reader
+		{
+		public :
+
+			/// Default constructor
+			trigger_record_reader();
+
+			/// Destructor
+			virtual ~trigger_record_reader();
+
+			/// Open a file
+			void open(const std::string & filename_);
+
+			/// Check if a file is open
+			bool is_open() const;
+
+			/// Close the file
+			void close();
+
+			/// Load the next chunk, return false at the end of the file
+			bool load_next_chunk();
+
+			/// Return the number of events in the current chunk
+			std::size_t get_number_of_events_in_chunk() const;
+
+			/// Return the raw bytes of a column of the current chunk
+			const std::string & get_column(trigger_records_format::column_id column_) const;
+
+			/// Return the number of values of a column of the current chunk
+			std::size_t get_number_of_values(trigger_records_format::column_id column_) const;
+
+			/// Return a value of a column of the current chunk
+			template <typename T>
+			T get_value(trigger_records_format::column_id column_, std::size_t index_) const
+			{
+				DT_THROW_IF(sizeof(T) != trigger_records_format::get_column_width(column_), std::logic_error,
+										"Type size does not match the width of column '" << trigger_records_format::get_column_name(column_) << "' ! ");
+				const std::string & column = get_column(column_);
+				DT_THROW_IF((index_ + 1) * sizeof(T) > column.size(), std::range_error,
+										"Value #" << index_ << " of column '" << trigger_records_format::get_column_name(column_) << "' is out of range ! ");
+				T value;
+				std::memcpy(&value, column.data() + index_ * sizeof(T), sizeof(T));
+				return value;
+			}
+
+			/// Rebuild the next event (chunks are loaded as needed), return false at the end of the file
+			bool read_next_event(trigger_event_records & event_);
+
+		private :
+
+			std::string _filename_;        //!< Name of the current file
+			std::ifstream _file_;          //!< Input file
+			uint32_t _format_version_;     //!< Format version of the file
+			std::vector<std::string> _columns_; //!< Raw columns of the current chunk
+			std::size_t _number_of_events_in_chunk_; //!< Number of events in the current chunk
+			std::size_t _next_event_index_; //!< Index of the next event to rebuild in the current chunk
+			std::vector<std::size_t> _record_offsets_; //!< Record offsets of the next event to rebuild
+			std::string _stored_buffer_;   //!< Working buffer for compressed columns
+
+		};
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_RECORD_READER_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
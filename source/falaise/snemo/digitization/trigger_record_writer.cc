@@ -0,0 +1,157 @@
+// snemo/digitization/trigger_record_writer.cc
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+// Ourselves:
+#include <snemo/digitization/trigger_record_writer.h>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+    namespace {
+
+      void write_uint32(std::ofstream & file_, uint32_t value_)
+      {
+	file_.write(reinterpret_cast<const char *>(&value_), sizeof(uint32_t));
+	return;
+      }
+
+    }
+
+    const std::size_t trigger_record_writer::DEFAULT_CHUNK_SIZE;
+    const int trigger_record_writer::DEFAULT_COMPRESSION_LEVEL;
+
+    trigger_record_writer::trigger_record_writer()
+    {
+      _chunk_size_ = DEFAULT_CHUNK_SIZE;
+      _compression_level_ = DEFAULT_COMPRESSION_LEVEL;
+      _number_of_pending_events_ = 0;
+      _number_of_events_ = 0;
+      return;
+    }
+
+    trigger_record_writer::~trigger_record_writer()
+    {
+      if (is_open()) close();
+      return;
+    }
+
+    void trigger_record_writer::set_chunk_size(std::size_t chunk_size_)
+    {
+      DT_THROW_IF(is_open(), std::logic_error, "Writer is already open ! ");
+      DT_THROW_IF(chunk_size_ == 0, std::range_error, "Invalid null chunk size ! ");
+      _chunk_size_ = chunk_size_;
+      return;
+    }
+
+    std::size_t trigger_record_writer::get_chunk_size() const
+    {
+      return _chunk_size_;
+    }
+
+    void trigger_record_writer::set_compression_level(int compression_level_)
+    {
+      DT_THROW_IF(is_open(), std::logic_error, "Writer is already open ! ");
+      DT_THROW_IF(compression_level_ < 0 || compression_level_ > 9, std::range_error, "Invalid compression level " << compression_level_ << " ! ");
+      _compression_level_ = compression_level_;
+      return;
+    }
+
+    int trigger_record_writer::get_compression_level() const
+    {
+      return _compression_level_;
+    }
+
+    void trigger_record_writer::open(const std::string & filename_)
+    {
+      DT_THROW_IF(is_open(), std::logic_error, "Writer is already open with file '" << _filename_ << "' ! ");
+      _file_.open(filename_.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      DT_THROW_IF(!_file_, std::runtime_error, "Cannot open file '" << filename_ << "' ! ");
+      _filename_ = filename_;
+      _file_.write(trigger_records_format::magic(), trigger_records_format::MAGIC_SIZE);
+      write_uint32(_file_, trigger_records_format::FORMAT_VERSION);
+      write_uint32(_file_, trigger_records_format::NUMBER_OF_COLUMNS);
+      _columns_.assign(trigger_records_format::NUMBER_OF_COLUMNS, std::string());
+      _number_of_pending_events_ = 0;
+      _number_of_events_ = 0;
+      return;
+    }
+
+    bool trigger_record_writer::is_open() const
+    {
+      return _file_.is_open();
+    }
+
+    void trigger_record_writer::write(const trigger_event_records & event_)
+    {
+      DT_THROW_IF(!is_open(), std::logic_error, "Writer is not open ! ");
+      trigger_records_format::append_event(event_, _columns_);
+      _number_of_pending_events_++;
+      _number_of_events_++;
+      if (_number_of_pending_events_ >= _chunk_size_) _flush_chunk();
+      return;
+    }
+
+    void trigger_record_writer::write(int32_t event_id_, const trigger_algorithm & trigger_algo_)
+    {
+      _event_buffer_.fill(event_id_, trigger_algo_);
+      write(_event_buffer_);
+      return;
+    }
+
+    std::size_t trigger_record_writer::get_number_of_events() const
+    {
+      return _number_of_events_;
+    }
+
+    void trigger_record_writer::close()
+    {
+      DT_THROW_IF(!is_open(), std::logic_error, "Writer is not open ! ");
+      if (_number_of_pending_events_ > 0) _flush_chunk();
+      _file_.close();
+      _filename_.clear();
+      _columns_.clear();
+      _compressed_buffer_.clear();
+      return;
+    }
+
+    void trigger_record_writer::_flush_chunk()
+    {
+      write_uint32(_file_, _number_of_pending_events_);
+      for (std::size_t icol = 0; icol < _columns_.size(); icol++)
+	{
+	  std::string & raw_column = _columns_[icol];
+	  const std::string * stored_column = &raw_column;
+	  if (_compression_level_ > 0 && !raw_column.empty())
+	    {
+	      trigger_records_format::compress_column(raw_column, _compression_level_, _compressed_buffer_);
+	      // Keep the raw bytes when the compression does not pay :
+	      if (_compressed_buffer_.size() < raw_column.size()) stored_column = &_compressed_buffer_;
+	    }
+	  write_uint32(_file_, raw_column.size());
+	  write_uint32(_file_, stored_column->size());
+	  _file_.write(stored_column->data(), stored_column->size());
+	  // Keep the capacity for the next chunk :
+	  raw_column.clear();
+	}
+      DT_THROW_IF(!_file_, std::runtime_error, "Write error on file '" << _filename_ << "' ! ");
+      _number_of_pending_events_ = 0;
+      return;
+    }
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
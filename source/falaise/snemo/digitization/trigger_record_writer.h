@@ -0,0 +1,102 @@
+// snemo/digitization/trigger_record_writer.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_RECORD_WRITER_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_RECORD_WRITER_H
+
+// Standard library :
+#include <string>
+#include <vector>
+#include <fstream>
+
+// This project :
+#include <snemo/digitization/trigger_records_format.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+		/// \brief Streaming writer of trigger records in the columnar chunked format.
+		///
+		/// Events are buffered column by column and flushed as a chunk every
+		/// 'chunk size' events. Each column of a chunk is zlib compressed on its own
+		/// unless the compression level is 0 or the compression does not pay.
+		class trigger_record_writer
+		{
+		public :
+
+			/// Default number of events per chunk
+			static const std::size_t DEFAULT_CHUNK_SIZE = 1000;
+
+			/// Default zlib compression level
+			static const int DEFAULT_COMPRESSION_LEVEL = 6;
+
+			/// Default constructor
+			trigger_record_writer();
+
+			/// Destructor (close the file)
+			virtual ~trigger_record_writer();
+
+			/// Set the number of events per chunk
+			void set_chunk_size(std::size_t chunk_size_);
+
+			/// Get the number of events per chunk
+			std::size_t get_chunk_size() const;
+
+			/// Set the zlib compression level (0 : no compression, 1..9)
+			void set_compression_level(int compression_level_);
+
+			/// Get the zlib compression level
+			int get_compression_level() const;
+
+			/// Open a file
+			void open(const std::string & filename_);
+
+			/// Check if a file is open
+			bool is_open() const;
+
+			/// Write the trigger records of an event
+			void write(const trigger_event_records & event_);
+
+			/// Write the current trigger records of a trigger algorithm
+			void write(int32_t event_id_, const trigger_algorithm & trigger_algo_);
+
+			/// Return the number of written events
+			std::size_t get_number_of_events() const;
+
+			/// Flush the pending events and close the file
+			void close();
+
+		protected :
+
+			/// Write the pending events as a chunk
+			void _flush_chunk();
+
+		private :
+
+			std::size_t _chunk_size_;        //!< Number of events per chunk
+			int _compression_level_;         //!< Zlib compression level
+			std::string _filename_;          //!< Name of the current file
+			std::ofstream _file_;            //!< Output file
+			std::vector<std::string> _columns_; //!< Columns of the pending chunk
+			std::size_t _number_of_pending_events_; //!< Number of events in the pending chunk
+			std::size_t _number_of_events_;  //!< Number of written events
+			std::string _compressed_buffer_; //!< Working buffer for compression
+			trigger_event_records _event_buffer_; //!< Working event for write from a trigger algorithm
+
+		};
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_RECORD_WRITER_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,476 @@
+// snemo/digitization/trigger_records_format.cc
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+// Ourselves:
+#include <snemo/digitization/trigger_records_format.h>
+
+// Standard library :
+#include <cstring>
+
+// Third party:
+// - Boost :
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/copy.hpp>
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+
+// This project :
+#include <snemo/digitization/trigger_algorithm.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+    namespace {
+
+      template <typename T>
+      void put_value(std::string & column_, T value_)
+      {
+	column_.append(reinterpret_cast<const char *>(&value_), sizeof(T));
+	return;
+      }
+
+      template <typename T>
+      T get_value(const std::string & column_, std::size_t index_)
+      {
+	DT_THROW_IF((index_ + 1) * sizeof(T) > column_.size(), std::range_error, "Column value #" << index_ << " is out of range ! ");
+	T value;
+	std::memcpy(&value, column_.data() + index_ * sizeof(T), sizeof(T));
+	return value;
+      }
+
+      uint32_t pack_zoning(const trigger_structures::zoning_word_type zoning_word_[trigger_info::NSIDES])
+      {
+	return static_cast<uint32_t>(zoning_word_[0].to_ulong())
+	  | (static_cast<uint32_t>(zoning_word_[1].to_ulong()) << 16);
+      }
+
+      void unpack_zoning(uint32_t packed_, trigger_structures::zoning_word_type zoning_word_[trigger_info::NSIDES])
+      {
+	zoning_word_[0] = trigger_structures::zoning_word_type(packed_ & 0xFFFF);
+	zoning_word_[1] = trigger_structures::zoning_word_type((packed_ >> 16) & 0xFFFF);
+	return;
+      }
+
+      void put_finale_data(std::string & column_,
+			   const trigger_structures::finale_data_type finale_data_[trigger_info::NSIDES][trigger_info::NZONES])
+      {
+	for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
+	    {
+	      column_.push_back(static_cast<char>(finale_data_[iside][izone].to_ulong()));
+	    }
+	return;
+      }
+
+      void get_finale_data(const std::string & column_,
+			   std::size_t index_,
+			   trigger_structures::finale_data_type finale_data_[trigger_info::NSIDES][trigger_info::NZONES])
+      {
+	const std::size_t offset = index_ * trigger_records_format::FINALE_DATA_SIZE;
+	DT_THROW_IF(offset + trigger_records_format::FINALE_DATA_SIZE > column_.size(), std::range_error, "Finale data #" << index_ << " is out of range ! ");
+	for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
+	    {
+	      const unsigned char byte = column_[offset + iside * trigger_info::NZONES + izone];
+	      finale_data_[iside][izone] = trigger_structures::finale_data_type(byte);
+	    }
+	return;
+      }
+
+      // Calorimeter flags shared by the calo records and the coincidence base records :
+      template <typename Record>
+      uint32_t pack_calo_flags(const Record & record_)
+      {
+	uint32_t flags = 0;
+	flags |= record_.total_multiplicity_side_0.to_ulong() << trigger_records_format::CALO_FLAG_HTM_SIDE_0;
+	flags |= record_.total_multiplicity_side_1.to_ulong() << trigger_records_format::CALO_FLAG_HTM_SIDE_1;
+	flags |= static_cast<uint32_t>(record_.LTO_side_0) << trigger_records_format::CALO_FLAG_LTO_SIDE_0;
+	flags |= static_cast<uint32_t>(record_.LTO_side_1) << trigger_records_format::CALO_FLAG_LTO_SIDE_1;
+	flags |= record_.total_multiplicity_gveto.to_ulong() << trigger_records_format::CALO_FLAG_HTM_GVETO;
+	flags |= static_cast<uint32_t>(record_.LTO_gveto) << trigger_records_format::CALO_FLAG_LTO_GVETO;
+	flags |= record_.xt_info_bitset.to_ulong() << trigger_records_format::CALO_FLAG_XT_INFO;
+	return flags;
+      }
+
+      template <typename Record>
+      void unpack_calo_flags(uint32_t flags_, Record & record_)
+      {
+	typedef trigger_structures::multiplicity_type htm_type;
+	record_.total_multiplicity_side_0 = htm_type((flags_ >> trigger_records_format::CALO_FLAG_HTM_SIDE_0) & 0x3);
+	record_.total_multiplicity_side_1 = htm_type((flags_ >> trigger_records_format::CALO_FLAG_HTM_SIDE_1) & 0x3);
+	record_.LTO_side_0 = (flags_ >> trigger_records_format::CALO_FLAG_LTO_SIDE_0) & 0x1;
+	record_.LTO_side_1 = (flags_ >> trigger_records_format::CALO_FLAG_LTO_SIDE_1) & 0x1;
+	record_.total_multiplicity_gveto = htm_type((flags_ >> trigger_records_format::CALO_FLAG_HTM_GVETO) & 0x3);
+	record_.LTO_gveto = (flags_ >> trigger_records_format::CALO_FLAG_LTO_GVETO) & 0x1;
+	record_.xt_info_bitset = trigger_structures::xt_info_type((flags_ >> trigger_records_format::CALO_FLAG_XT_INFO) & 0x7);
+	return;
+      }
+
+      uint32_t pack_summary_bits(bool single_side_coinc_, bool total_multiplicity_threshold_, bool decision_)
+      {
+	return (static_cast<uint32_t>(single_side_coinc_) << trigger_records_format::CALO_FLAG_SINGLE_SIDE_COINC)
+	  | (static_cast<uint32_t>(total_multiplicity_threshold_) << trigger_records_format::CALO_FLAG_TOTAL_MULTIPLICITY_THRESHOLD)
+	  | (static_cast<uint32_t>(decision_) << trigger_records_format::CALO_FLAG_DECISION);
+      }
+
+      bool flag_bit(uint32_t flags_, unsigned int bit_)
+      {
+	return (flags_ >> bit_) & 0x1;
+      }
+
+      uint64_t pack_zoning_pair(const trigger_structures::zoning_word_type first_[trigger_info::NSIDES],
+				const trigger_structures::zoning_word_type second_[trigger_info::NSIDES])
+      {
+	return static_cast<uint64_t>(pack_zoning(first_)) | (static_cast<uint64_t>(pack_zoning(second_)) << 32);
+      }
+
+      void unpack_zoning_pair(uint64_t packed_,
+			      trigger_structures::zoning_word_type first_[trigger_info::NSIDES],
+			      trigger_structures::zoning_word_type second_[trigger_info::NSIDES])
+      {
+	unpack_zoning(packed_ & 0xFFFFFFFF, first_);
+	unpack_zoning(packed_ >> 32, second_);
+	return;
+      }
+
+      const std::size_t COLUMN_WIDTHS[trigger_records_format::NUMBER_OF_COLUMNS] = {
+	4, 1, 4, 4, 4, 4, 4, 4, 4,                    // Event
+	4, 4, 4,                                      // Calo
+	4, 4, 4,                                      // Coincidence calo
+	4, 8, trigger_records_format::FINALE_DATA_SIZE, 1, // Tracker
+	4, trigger_records_format::GEIGER_MATRIX_SIZE,     // Geiger matrix
+	4, 8, 8, trigger_records_format::FINALE_DATA_SIZE, 4, // Coincidence event
+	4, 1,                                         // L1 calo
+	4, 1, 1                                       // L2
+      };
+
+      const char * COLUMN_NAMES[trigger_records_format::NUMBER_OF_COLUMNS] = {
+	"event_id", "event_finale_decision",
+	"event_nb_calo_records", "event_nb_coinc_calo_records", "event_nb_tracker_records",
+	"event_nb_geiger_matrices", "event_nb_coinc_event_records",
+	"event_nb_L1_calo_decisions", "event_nb_L2_decisions",
+	"calo_clocktick", "calo_zoning", "calo_flags",
+	"coinc_calo_clocktick", "coinc_calo_zoning", "coinc_calo_flags",
+	"tracker_clocktick", "tracker_zoning", "tracker_finale_data", "tracker_flags",
+	"geiger_matrix_clocktick", "geiger_matrix_words",
+	"coinc_event_clocktick", "coinc_event_zoning", "coinc_event_tracker_zoning",
+	"coinc_event_finale_data", "coinc_event_flags",
+	"L1_calo_clocktick", "L1_calo_decision",
+	"L2_clocktick", "L2_decision", "L2_trigger_mode"
+      };
+
+    } // end of anonymous namespace
+
+    const std::size_t trigger_records_format::MAGIC_SIZE;
+    const uint32_t trigger_records_format::FORMAT_VERSION;
+    const std::size_t trigger_records_format::FINALE_DATA_SIZE;
+    const std::size_t trigger_records_format::GEIGER_MATRIX_SIZE;
+
+    trigger_event_records::trigger_event_records()
+    {
+      reset();
+      return;
+    }
+
+    void trigger_event_records::reset()
+    {
+      event_id = -1;
+      finale_decision = false;
+      calo_records_25ns.clear();
+      coincidence_calo_records_1600ns.clear();
+      tracker_records.clear();
+      geiger_matrix_records.clear();
+      coincidence_records.clear();
+      L1_calo_decision_records.clear();
+      L2_decision_records.clear();
+      return;
+    }
+
+    void trigger_event_records::fill(int32_t event_id_, const trigger_algorithm & trigger_algo_)
+    {
+      event_id = event_id_;
+      finale_decision = trigger_algo_.get_finale_decision();
+      calo_records_25ns = trigger_algo_.get_calo_records_25ns_vector();
+      coincidence_calo_records_1600ns = trigger_algo_.get_coincidence_calo_records_1600ns_vector();
+      tracker_records = trigger_algo_.get_tracker_records_vector();
+      geiger_matrix_records = trigger_algo_.get_geiger_matrix_records_vector();
+      coincidence_records = trigger_algo_.get_coincidence_records_vector();
+      L1_calo_decision_records = trigger_algo_.get_L1_calo_decision_records_vector();
+      L2_decision_records = trigger_algo_.get_L2_decision_records_vector();
+      return;
+    }
+
+    const char * trigger_records_format::magic()
+    {
+      return "SNTRGREC";
+    }
+
+    std::size_t trigger_records_format::get_column_width(column_id column_)
+    {
+      DT_THROW_IF(column_ >= NUMBER_OF_COLUMNS, std::range_error, "Invalid column " << column_ << " ! ");
+      return COLUMN_WIDTHS[column_];
+    }
+
+    const char * trigger_records_format::get_column_name(column_id column_)
+    {
+      DT_THROW_IF(column_ >= NUMBER_OF_COLUMNS, std::range_error, "Invalid column " << column_ << " ! ");
+      return COLUMN_NAMES[column_];
+    }
+
+    trigger_records_format::column_id trigger_records_format::get_counter_column(column_id column_)
+    {
+      if (column_ <= EVENT_NB_L2_DECISIONS) return EVENT_ID;
+      if (column_ <= CALO_FLAGS) return EVENT_NB_CALO_RECORDS;
+      if (column_ <= COINC_CALO_FLAGS) return EVENT_NB_COINC_CALO_RECORDS;
+      if (column_ <= TRACKER_FLAGS) return EVENT_NB_TRACKER_RECORDS;
+      if (column_ <= GEIGER_MATRIX_WORDS) return EVENT_NB_GEIGER_MATRICES;
+      if (column_ <= COINC_EVENT_FLAGS) return EVENT_NB_COINC_EVENT_RECORDS;
+      if (column_ <= L1_CALO_DECISION) return EVENT_NB_L1_CALO_DECISIONS;
+      DT_THROW_IF(column_ >= NUMBER_OF_COLUMNS, std::range_error, "Invalid column " << column_ << " ! ");
+      return EVENT_NB_L2_DECISIONS;
+    }
+
+    void trigger_records_format::append_event(const trigger_event_records & event_,
+					      std::vector<std::string> & columns_)
+    {
+      columns_.resize(NUMBER_OF_COLUMNS);
+
+      put_value<int32_t>(columns_[EVENT_ID], event_.event_id);
+      put_value<uint8_t>(columns_[EVENT_FINALE_DECISION], event_.finale_decision);
+      put_value<uint32_t>(columns_[EVENT_NB_CALO_RECORDS], event_.calo_records_25ns.size());
+      put_value<uint32_t>(columns_[EVENT_NB_COINC_CALO_RECORDS], event_.coincidence_calo_records_1600ns.size());
+      put_value<uint32_t>(columns_[EVENT_NB_TRACKER_RECORDS], event_.tracker_records.size());
+      put_value<uint32_t>(columns_[EVENT_NB_GEIGER_MATRICES], event_.geiger_matrix_records.size());
+      put_value<uint32_t>(columns_[EVENT_NB_COINC_EVENT_RECORDS], event_.coincidence_records.size());
+      put_value<uint32_t>(columns_[EVENT_NB_L1_CALO_DECISIONS], event_.L1_calo_decision_records.size());
+      put_value<uint32_t>(columns_[EVENT_NB_L2_DECISIONS], event_.L2_decision_records.size());
+
+      for (std::size_t i = 0; i < event_.calo_records_25ns.size(); i++)
+	{
+	  const trigger_structures::calo_summary_record & record = event_.calo_records_25ns[i];
+	  put_value<uint32_t>(columns_[CALO_CLOCKTICK], record.clocktick_25ns);
+	  put_value<uint32_t>(columns_[CALO_ZONING], pack_zoning(record.zoning_word));
+	  put_value<uint32_t>(columns_[CALO_FLAGS], pack_calo_flags(record)
+			      | pack_summary_bits(record.single_side_coinc, record.total_multiplicity_threshold, record.calo_finale_decision));
+	}
+
+      for (std::size_t i = 0; i < event_.coincidence_calo_records_1600ns.size(); i++)
+	{
+	  const trigger_structures::coincidence_calo_record & record = event_.coincidence_calo_records_1600ns[i];
+	  put_value<uint32_t>(columns_[COINC_CALO_CLOCKTICK], record.clocktick_1600ns);
+	  put_value<uint32_t>(columns_[COINC_CALO_ZONING], pack_zoning(record.calo_zoning_word));
+	  put_value<uint32_t>(columns_[COINC_CALO_FLAGS], pack_calo_flags(record)
+			      | pack_summary_bits(record.single_side_coinc, record.total_multiplicity_threshold, record.decision));
+	}
+
+      for (std::size_t i = 0; i < event_.tracker_records.size(); i++)
+	{
+	  const trigger_structures::tracker_record & record = event_.tracker_records[i];
+	  put_value<uint32_t>(columns_[TRACKER_CLOCKTICK], record.clocktick_1600ns);
+	  put_value<uint64_t>(columns_[TRACKER_ZONING], pack_zoning_pair(record.zoning_word_pattern, record.zoning_word_near_source));
+	  put_finale_data(columns_[TRACKER_FINALE_DATA], record.finale_data_per_zone);
+	  put_value<uint8_t>(columns_[TRACKER_FLAGS], static_cast<uint8_t>(record.single_side_coinc) | (static_cast<uint8_t>(record.finale_decision) << 1));
+	}
+
+      for (std::size_t i = 0; i < event_.geiger_matrix_records.size(); i++)
+	{
+	  const trigger_structures::geiger_matrix & record = event_.geiger_matrix_records[i];
+	  put_value<uint32_t>(columns_[GEIGER_MATRIX_CLOCKTICK], record.clocktick_1600ns);
+	  uint64_t words[GEIGER_MATRIX_SIZE / 8] = {0};
+	  std::size_t bit_index = 0;
+	  for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	    for (unsigned int ilayer = 0; ilayer < trigger_info::NLAYERS; ilayer++)
+	      for (unsigned int irow = 0; irow < trigger_info::NROWS; irow++)
+		{
+		  if (record.matrix[iside][ilayer][irow]) words[bit_index / 64] |= (0x1ULL << (bit_index % 64));
+		  bit_index++;
+		}
+	  columns_[GEIGER_MATRIX_WORDS].append(reinterpret_cast<const char *>(words), GEIGER_MATRIX_SIZE);
+	}
+
+      for (std::size_t i = 0; i < event_.coincidence_records.size(); i++)
+	{
+	  const trigger_structures::coincidence_event_record & record = event_.coincidence_records[i];
+	  put_value<uint32_t>(columns_[COINC_EVENT_CLOCKTICK], record.clocktick_1600ns);
+	  put_value<uint64_t>(columns_[COINC_EVENT_ZONING], pack_zoning_pair(record.calo_zoning_word, record.coincidence_zoning_word));
+	  put_value<uint64_t>(columns_[COINC_EVENT_TRACKER_ZONING], pack_zoning_pair(record.tracker_zoning_word_pattern, record.tracker_zoning_word_near_source));
+	  put_finale_data(columns_[COINC_EVENT_FINALE_DATA], record.tracker_finale_data_per_zone);
+	  put_value<uint32_t>(columns_[COINC_EVENT_FLAGS], pack_calo_flags(record)
+			      | pack_summary_bits(record.single_side_coinc, record.total_multiplicity_threshold, record.decision)
+			      | (static_cast<uint32_t>(record.trigger_mode) << COINC_EVENT_FLAG_TRIGGER_MODE));
+	}
+
+      for (std::size_t i = 0; i < event_.L1_calo_decision_records.size(); i++)
+	{
+	  const trigger_structures::L1_calo_decision & record = event_.L1_calo_decision_records[i];
+	  put_value<uint32_t>(columns_[L1_CALO_CLOCKTICK], record.L1_calo_ct_decision);
+	  put_value<uint8_t>(columns_[L1_CALO_DECISION], record.L1_calo_decision_bool);
+	}
+
+      for (std::size_t i = 0; i < event_.L2_decision_records.size(); i++)
+	{
+	  const trigger_structures::L2_decision & record = event_.L2_decision_records[i];
+	  put_value<uint32_t>(columns_[L2_CLOCKTICK], record.L2_ct_decision);
+	  put_value<uint8_t>(columns_[L2_DECISION], record.L2_decision_bool);
+	  put_value<uint8_t>(columns_[L2_TRIGGER_MODE], record.L2_trigger_mode);
+	}
+
+      return;
+    }
+
+    void trigger_records_format::compress_column(const std::string & raw_column_,
+						 int compression_level_,
+						 std::string & stored_column_)
+    {
+      stored_column_.clear();
+      boost::iostreams::filtering_ostream out;
+      out.push(boost::iostreams::zlib_compressor(boost::iostreams::zlib_params(compression_level_)));
+      out.push(boost::iostreams::back_inserter(stored_column_));
+      out.write(raw_column_.data(), raw_column_.size());
+      out.reset();
+      return;
+    }
+
+    void trigger_records_format::uncompress_column(const std::string & stored_column_,
+						   std::size_t raw_size_,
+						   std::string & raw_column_)
+    {
+      raw_column_.clear();
+      raw_column_.reserve(raw_size_);
+      boost::iostreams::filtering_istream in;
+      in.push(boost::iostreams::zlib_decompressor());
+      in.push(boost::iostreams::array_source(stored_column_.data(), stored_column_.size()));
+      boost::iostreams::copy(in, boost::iostreams::back_inserter(raw_column_));
+      DT_THROW_IF(raw_column_.size() != raw_size_, std::logic_error, "Uncompressed column size " << raw_column_.size() << " does not match the expected size " << raw_size_ << " ! ");
+      return;
+    }
+
+    void trigger_records_format::extract_event(const std::vector<std::string> & columns_,
+					       std::size_t event_index_,
+					       std::vector<std::size_t> & record_offsets_,
+					       trigger_event_records & event_)
+    {
+      DT_THROW_IF(columns_.size() != NUMBER_OF_COLUMNS, std::logic_error, "Invalid number of columns " << columns_.size() << " ! ");
+      record_offsets_.resize(NUMBER_OF_COLUMNS, 0);
+      event_.reset();
+
+      event_.event_id = get_value<int32_t>(columns_[EVENT_ID], event_index_);
+      event_.finale_decision = get_value<uint8_t>(columns_[EVENT_FINALE_DECISION], event_index_);
+
+      std::size_t & calo_offset = record_offsets_[EVENT_NB_CALO_RECORDS];
+      event_.calo_records_25ns.resize(get_value<uint32_t>(columns_[EVENT_NB_CALO_RECORDS], event_index_));
+      for (std::size_t i = 0; i < event_.calo_records_25ns.size(); i++, calo_offset++)
+	{
+	  trigger_structures::calo_summary_record & record = event_.calo_records_25ns[i];
+	  record.clocktick_25ns = get_value<uint32_t>(columns_[CALO_CLOCKTICK], calo_offset);
+	  unpack_zoning(get_value<uint32_t>(columns_[CALO_ZONING], calo_offset), record.zoning_word);
+	  const uint32_t flags = get_value<uint32_t>(columns_[CALO_FLAGS], calo_offset);
+	  unpack_calo_flags(flags, record);
+	  record.single_side_coinc = flag_bit(flags, CALO_FLAG_SINGLE_SIDE_COINC);
+	  record.total_multiplicity_threshold = flag_bit(flags, CALO_FLAG_TOTAL_MULTIPLICITY_THRESHOLD);
+	  record.calo_finale_decision = flag_bit(flags, CALO_FLAG_DECISION);
+	}
+
+      std::size_t & coinc_calo_offset = record_offsets_[EVENT_NB_COINC_CALO_RECORDS];
+      event_.coincidence_calo_records_1600ns.resize(get_value<uint32_t>(columns_[EVENT_NB_COINC_CALO_RECORDS], event_index_));
+      for (std::size_t i = 0; i < event_.coincidence_calo_records_1600ns.size(); i++, coinc_calo_offset++)
+	{
+	  trigger_structures::coincidence_calo_record & record = event_.coincidence_calo_records_1600ns[i];
+	  record.clocktick_1600ns = get_value<uint32_t>(columns_[COINC_CALO_CLOCKTICK], coinc_calo_offset);
+	  unpack_zoning(get_value<uint32_t>(columns_[COINC_CALO_ZONING], coinc_calo_offset), record.calo_zoning_word);
+	  const uint32_t flags = get_value<uint32_t>(columns_[COINC_CALO_FLAGS], coinc_calo_offset);
+	  unpack_calo_flags(flags, record);
+	  record.single_side_coinc = flag_bit(flags, CALO_FLAG_SINGLE_SIDE_COINC);
+	  record.total_multiplicity_threshold = flag_bit(flags, CALO_FLAG_TOTAL_MULTIPLICITY_THRESHOLD);
+	  record.decision = flag_bit(flags, CALO_FLAG_DECISION);
+	}
+
+      std::size_t & tracker_offset = record_offsets_[EVENT_NB_TRACKER_RECORDS];
+      event_.tracker_records.resize(get_value<uint32_t>(columns_[EVENT_NB_TRACKER_RECORDS], event_index_));
+      for (std::size_t i = 0; i < event_.tracker_records.size(); i++, tracker_offset++)
+	{
+	  trigger_structures::tracker_record & record = event_.tracker_records[i];
+	  record.clocktick_1600ns = get_value<uint32_t>(columns_[TRACKER_CLOCKTICK], tracker_offset);
+	  unpack_zoning_pair(get_value<uint64_t>(columns_[TRACKER_ZONING], tracker_offset), record.zoning_word_pattern, record.zoning_word_near_source);
+	  get_finale_data(columns_[TRACKER_FINALE_DATA], tracker_offset, record.finale_data_per_zone);
+	  record.update_zone_masks();
+	  const uint8_t flags = get_value<uint8_t>(columns_[TRACKER_FLAGS], tracker_offset);
+	  record.single_side_coinc = flags & 0x1;
+	  record.finale_decision = (flags >> 1) & 0x1;
+	}
+
+      std::size_t & matrix_offset = record_offsets_[EVENT_NB_GEIGER_MATRICES];
+      event_.geiger_matrix_records.resize(get_value<uint32_t>(columns_[EVENT_NB_GEIGER_MATRICES], event_index_));
+      for (std::size_t i = 0; i < event_.geiger_matrix_records.size(); i++, matrix_offset++)
+	{
+	  trigger_structures::geiger_matrix & record = event_.geiger_matrix_records[i];
+	  record.clocktick_1600ns = get_value<uint32_t>(columns_[GEIGER_MATRIX_CLOCKTICK], matrix_offset);
+	  const std::string & words_column = columns_[GEIGER_MATRIX_WORDS];
+	  DT_THROW_IF((matrix_offset + 1) * GEIGER_MATRIX_SIZE > words_column.size(), std::range_error, "Geiger matrix #" << matrix_offset << " is out of range ! ");
+	  uint64_t words[GEIGER_MATRIX_SIZE / 8];
+	  std::memcpy(words, words_column.data() + matrix_offset * GEIGER_MATRIX_SIZE, GEIGER_MATRIX_SIZE);
+	  std::size_t bit_index = 0;
+	  for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	    for (unsigned int ilayer = 0; ilayer < trigger_info::NLAYERS; ilayer++)
+	      for (unsigned int irow = 0; irow < trigger_info::NROWS; irow++)
+		{
+		  record.matrix[iside][ilayer][irow] = (words[bit_index / 64] >> (bit_index % 64)) & 0x1;
+		  bit_index++;
+		}
+	}
+
+      std::size_t & coinc_event_offset = record_offsets_[EVENT_NB_COINC_EVENT_RECORDS];
+      event_.coincidence_records.resize(get_value<uint32_t>(columns_[EVENT_NB_COINC_EVENT_RECORDS], event_index_));
+      for (std::size_t i = 0; i < event_.coincidence_records.size(); i++, coinc_event_offset++)
+	{
+	  trigger_structures::coincidence_event_record & record = event_.coincidence_records[i];
+	  record.clocktick_1600ns = get_value<uint32_t>(columns_[COINC_EVENT_CLOCKTICK], coinc_event_offset);
+	  unpack_zoning_pair(get_value<uint64_t>(columns_[COINC_EVENT_ZONING], coinc_event_offset), record.calo_zoning_word, record.coincidence_zoning_word);
+	  unpack_zoning_pair(get_value<uint64_t>(columns_[COINC_EVENT_TRACKER_ZONING], coinc_event_offset), record.tracker_zoning_word_pattern, record.tracker_zoning_word_near_source);
+	  get_finale_data(columns_[COINC_EVENT_FINALE_DATA], coinc_event_offset, record.tracker_finale_data_per_zone);
+	  const uint32_t flags = get_value<uint32_t>(columns_[COINC_EVENT_FLAGS], coinc_event_offset);
+	  unpack_calo_flags(flags, record);
+	  record.single_side_coinc = flag_bit(flags, CALO_FLAG_SINGLE_SIDE_COINC);
+	  record.total_multiplicity_threshold = flag_bit(flags, CALO_FLAG_TOTAL_MULTIPLICITY_THRESHOLD);
+	  record.decision = flag_bit(flags, CALO_FLAG_DECISION);
+	  record.trigger_mode = static_cast<trigger_structures::L2_trigger_mode>((flags >> COINC_EVENT_FLAG_TRIGGER_MODE) & 0xFF);
+	}
+
+      std::size_t & L1_offset = record_offsets_[EVENT_NB_L1_CALO_DECISIONS];
+      event_.L1_calo_decision_records.resize(get_value<uint32_t>(columns_[EVENT_NB_L1_CALO_DECISIONS], event_index_));
+      for (std::size_t i = 0; i < event_.L1_calo_decision_records.size(); i++, L1_offset++)
+	{
+	  trigger_structures::L1_calo_decision & record = event_.L1_calo_decision_records[i];
+	  record.L1_calo_ct_decision = get_value<uint32_t>(columns_[L1_CALO_CLOCKTICK], L1_offset);
+	  record.L1_calo_decision_bool = get_value<uint8_t>(columns_[L1_CALO_DECISION], L1_offset);
+	}
+
+      std::size_t & L2_offset = record_offsets_[EVENT_NB_L2_DECISIONS];
+      event_.L2_decision_records.resize(get_value<uint32_t>(columns_[EVENT_NB_L2_DECISIONS], event_index_));
+      for (std::size_t i = 0; i < event_.L2_decision_records.size(); i++, L2_offset++)
+	{
+	  trigger_structures::L2_decision & record = event_.L2_decision_records[i];
+	  record.L2_ct_decision = get_value<uint32_t>(columns_[L2_CLOCKTICK], L2_offset);
+	  record.L2_decision_bool = get_value<uint8_t>(columns_[L2_DECISION], L2_offset);
+	  record.L2_trigger_mode = static_cast<trigger_structures::L2_trigger_mode>(get_value<uint8_t>(columns_[L2_TRIGGER_MODE], L2_offset));
+	}
+
+      return;
+    }
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
@@ -0,0 +1,171 @@
+// snemo/digitization/trigger_records_format.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_RECORDS_FORMAT_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_RECORDS_FORMAT_H
+
+// Standard library :
+#include <string>
+#include <vector>
+
+// Third party:
+// - Boost :
+#include <boost/cstdint.hpp>
+
+// This project :
+#include <snemo/digitization/trigger_structures.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+		class trigger_algorithm;
+
+		/// \brief Trigger records of one event (input of the writer, output of the reader)
+		struct trigger_event_records
+		{
+			trigger_event_records();
+			void reset();
+
+			/// Fill from the current content of a trigger algorithm
+			void fill(int32_t event_id_, const trigger_algorithm & trigger_algo_);
+
+			int32_t event_id;
+			bool finale_decision;
+			std::vector<trigger_structures::calo_summary_record> calo_records_25ns;
+			std::vector<trigger_structures::coincidence_calo_record> coincidence_calo_records_1600ns;
+			std::vector<trigger_structures::tracker_record> tracker_records;
+			std::vector<trigger_structures::geiger_matrix> geiger_matrix_records;
+			std::vector<trigger_structures::coincidence_event_record> coincidence_records;
+			std::vector<trigger_structures::L1_calo_decision> L1_calo_decision_records;
+			std::vector<trigger_structures::L2_decision> L2_decision_records;
+		};
+
+		/// \brief Layout of the columnar chunked trigger records files.
+		///
+		/// A file is a header followed by chunks of events. A chunk stores, for each
+		/// column, its raw size, its stored (possibly zlib compressed) size and its bytes.
+		/// Each column holds fixed width values in native (little endian) byte order.
+		class trigger_records_format
+		{
+		public :
+
+			/// File magic word
+			static const char * magic();
+
+			/// Size of the file magic word
+			static const std::size_t MAGIC_SIZE = 8;
+
+			/// Version of the file format
+			static const uint32_t FORMAT_VERSION = 1;
+
+			/// Size of the packed finale data per zone (one byte per side and zone)
+			static const std::size_t FINALE_DATA_SIZE = trigger_info::NSIDES * trigger_info::NZONES;
+
+			/// Size of the packed geiger matrix (32 words of 64 bits)
+			static const std::size_t GEIGER_MATRIX_SIZE = 256;
+
+			/// Columns of a chunk
+			enum column_id {
+				// Per event columns :
+				EVENT_ID = 0,                  //!< int32
+				EVENT_FINALE_DECISION,         //!< uint8
+				EVENT_NB_CALO_RECORDS,         //!< uint32
+				EVENT_NB_COINC_CALO_RECORDS,   //!< uint32
+				EVENT_NB_TRACKER_RECORDS,      //!< uint32
+				EVENT_NB_GEIGER_MATRICES,      //!< uint32
+				EVENT_NB_COINC_EVENT_RECORDS,  //!< uint32
+				EVENT_NB_L1_CALO_DECISIONS,    //!< uint32
+				EVENT_NB_L2_DECISIONS,         //!< uint32
+				// Calo summary records @ 25 ns :
+				CALO_CLOCKTICK,                //!< uint32
+				CALO_ZONING,                   //!< uint32 (side 0 | side 1 << 16)
+				CALO_FLAGS,                    //!< uint32 (see pack_calo_flags)
+				// Coincidence calo records @ 1600 ns :
+				COINC_CALO_CLOCKTICK,          //!< uint32
+				COINC_CALO_ZONING,             //!< uint32 (side 0 | side 1 << 16)
+				COINC_CALO_FLAGS,              //!< uint32
+				// Tracker records @ 1600 ns :
+				TRACKER_CLOCKTICK,             //!< uint32
+				TRACKER_ZONING,                //!< uint64 (pattern S0, S1, near source S0, S1 per 16 bits)
+				TRACKER_FINALE_DATA,           //!< FINALE_DATA_SIZE bytes
+				TRACKER_FLAGS,                 //!< uint8 (single side coinc | finale decision << 1)
+				// Geiger matrices @ 1600 ns :
+				GEIGER_MATRIX_CLOCKTICK,       //!< uint32
+				GEIGER_MATRIX_WORDS,           //!< GEIGER_MATRIX_SIZE bytes
+				// Coincidence event records @ 1600 ns :
+				COINC_EVENT_CLOCKTICK,         //!< uint32
+				COINC_EVENT_ZONING,            //!< uint64 (calo S0, S1, coincidence S0, S1 per 16 bits)
+				COINC_EVENT_TRACKER_ZONING,    //!< uint64 (pattern S0, S1, near source S0, S1 per 16 bits)
+				COINC_EVENT_FINALE_DATA,       //!< FINALE_DATA_SIZE bytes
+				COINC_EVENT_FLAGS,             //!< uint32 (calo flags | trigger mode << 24)
+				// L1 calo decisions @ 25 ns :
+				L1_CALO_CLOCKTICK,             //!< uint32
+				L1_CALO_DECISION,              //!< uint8
+				// L2 decisions @ 1600 ns :
+				L2_CLOCKTICK,                  //!< uint32
+				L2_DECISION,                   //!< uint8
+				L2_TRIGGER_MODE,               //!< uint8
+				NUMBER_OF_COLUMNS
+			};
+
+			/// Bits of the packed calorimeter flags
+			enum calo_flag_bit {
+				CALO_FLAG_HTM_SIDE_0  = 0,  //!< 2 bits
+				CALO_FLAG_HTM_SIDE_1  = 2,  //!< 2 bits
+				CALO_FLAG_LTO_SIDE_0  = 4,
+				CALO_FLAG_LTO_SIDE_1  = 5,
+				CALO_FLAG_HTM_GVETO   = 6,  //!< 2 bits
+				CALO_FLAG_LTO_GVETO   = 8,
+				CALO_FLAG_XT_INFO     = 9,  //!< 3 bits
+				CALO_FLAG_SINGLE_SIDE_COINC  = 12,
+				CALO_FLAG_TOTAL_MULTIPLICITY_THRESHOLD = 13,
+				CALO_FLAG_DECISION    = 14,
+				COINC_EVENT_FLAG_TRIGGER_MODE = 24 //!< 8 bits
+			};
+
+			/// Return the width in bytes of one value of a column
+			static std::size_t get_column_width(column_id column_);
+
+			/// Return the name of a column
+			static const char * get_column_name(column_id column_);
+
+			/// Return the per event record counter column of a record column
+			static column_id get_counter_column(column_id column_);
+
+			/// Append an event to the columns
+			static void append_event(const trigger_event_records & event_,
+															 std::vector<std::string> & columns_);
+
+			/// Zlib compress a column (level 1..9)
+			static void compress_column(const std::string & raw_column_,
+																	int compression_level_,
+																	std::string & stored_column_);
+
+			/// Zlib uncompress a column of known raw size
+			static void uncompress_column(const std::string & stored_column_,
+																		std::size_t raw_size_,
+																		std::string & raw_column_);
+
+			/// Extract an event from the columns (record_offsets_ are updated to the next event)
+			static void extract_event(const std::vector<std::string> & columns_,
+																std::size_t event_index_,
+																std::vector<std::size_t> & record_offsets_,
+																trigger_event_records & event_);
+
+		};
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_RECORDS_FORMAT_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
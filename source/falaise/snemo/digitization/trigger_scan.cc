@@ -0,0 +1,210 @@
+// snemo/digitization/trigger_scan.cc
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+// Ourselves:
+#include <snemo/digitization/trigger_scan.h>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+#include <datatools/multi_properties.h>
+
+// This project :
+#include <snemo/digitization/calo_ctw_data.h>
+#include <snemo/digitization/geiger_ctw_data.h>
+#include <snemo/digitization/electronic_mapping.h>
+#include <snemo/digitization/clock_utils.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+    trigger_scan::configuration::configuration()
+    {
+      calorimeter_gate_size = 0;
+      L2_decision_coincidence_gate_size = 0;
+      previous_event_buffer_depth = 0;
+      activate_calorimeter_only = false;
+      activate_any_coincidences = true;
+      return;
+    }
+
+    trigger_scan::trigger_scan()
+    {
+      _initialized_ = false;
+      _electronic_mapping_ = nullptr;
+      _clock_manager_ = nullptr;
+      _with_tracker_records_ = false;
+      _with_geiger_matrices_ = false;
+      _number_of_processed_events_ = 0;
+      return;
+    }
+
+    trigger_scan::~trigger_scan()
+    {
+      if (is_initialized())
+	{
+	  reset();
+	}
+      return;
+    }
+
+    void trigger_scan::set_electronic_mapping(const electronic_mapping & my_electronic_mapping_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger scan is already initialized, electronic mapping can't be set ! ");
+      _electronic_mapping_ = & my_electronic_mapping_;
+      return;
+    }
+
+    void trigger_scan::set_clock_manager(const clock_utils & my_clock_manager_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger scan is already initialized, clock manager can't be set ! ");
+      _clock_manager_ = & my_clock_manager_;
+      return;
+    }
+
+    void trigger_scan::add_configuration(const configuration & configuration_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger scan is already initialized, configuration can't be added ! ");
+      _configurations_.push_back(configuration_);
+      return;
+    }
+
+    std::size_t trigger_scan::get_number_of_configurations() const
+    {
+      return _configurations_.size();
+    }
+
+    const trigger_scan::configuration & trigger_scan::get_configuration(std::size_t index_) const
+    {
+      DT_THROW_IF(index_ >= _configurations_.size(), std::range_error, "Invalid configuration index [" << index_ << "] ! ");
+      return _configurations_[index_];
+    }
+
+    void trigger_scan::initialize(const datatools::multi_properties & mconfig_)
+    {
+      DT_THROW_IF(is_initialized(), std::logic_error, "Trigger scan is already initialized ! ");
+      DT_THROW_IF(_electronic_mapping_ == 0, std::logic_error, "Missing electronic mapping ! " );
+      DT_THROW_IF(_clock_manager_ == 0, std::logic_error, "Missing clock manager ! " );
+      DT_THROW_IF(_configurations_.empty(), std::logic_error, "No configuration to scan ! ");
+
+      _with_tracker_records_ = false;
+      _with_geiger_matrices_ = false;
+      // The configurations share the tracker section, its firmware image is loaded once :
+      _firmware_ = trigger_firmware::build(mconfig_, *_electronic_mapping_);
+      for (std::size_t i = 0; i < _configurations_.size(); i++)
+	{
+	  const configuration & a_configuration = _configurations_[i];
+	  // The coincidence flags of the configuration override the 'general' section :
+	  datatools::multi_properties trigger_config = mconfig_;
+	  if (!trigger_config.has_section("general")) trigger_config.add("general", "trigger_component");
+	  datatools::properties & general_config = trigger_config.grab("general").grab_properties();
+	  general_config.update("activate_calorimeter_only", a_configuration.activate_calorimeter_only);
+	  general_config.update("activate_any_coincidences", a_configuration.activate_any_coincidences);
+
+	  std::unique_ptr<trigger_algorithm> a_trigger_algo(new trigger_algorithm);
+	  a_trigger_algo->set_electronic_mapping(*_electronic_mapping_);
+	  a_trigger_algo->set_clock_manager(*_clock_manager_);
+	  a_trigger_algo->set_firmware(_firmware_);
+	  if (a_configuration.calorimeter_gate_size != 0) a_trigger_algo->set_calorimeter_gate_size(a_configuration.calorimeter_gate_size);
+	  if (a_configuration.L2_decision_coincidence_gate_size != 0) a_trigger_algo->set_L2_decision_coincidence_gate_size(a_configuration.L2_decision_coincidence_gate_size);
+	  if (a_configuration.previous_event_buffer_depth != 0) a_trigger_algo->set_previous_event_buffer_depth(a_configuration.previous_event_buffer_depth);
+	  a_trigger_algo->initialize(trigger_config);
+
+	  if (a_trigger_algo->needs_tracker_records())
+	    {
+	      _with_tracker_records_ = true;
+	      if (a_trigger_algo->get_retention_policy() >= trigger_algorithm::RETENTION_FULL_DEBUG) _with_geiger_matrices_ = true;
+	    }
+	  _trigger_algos_.push_back(std::move(a_trigger_algo));
+	}
+      _number_of_triggered_events_.assign(_configurations_.size(), 0);
+      _number_of_processed_events_ = 0;
+      _initialized_ = true;
+      return;
+    }
+
+    bool trigger_scan::is_initialized() const
+    {
+      return _initialized_;
+    }
+
+    void trigger_scan::reset()
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Trigger scan is not initialized, it can't be reset ! ");
+      _initialized_ = false;
+      _trigger_algos_.clear();
+      _firmware_.reset();
+      _front_end_records_.reset();
+      _with_tracker_records_ = false;
+      _with_geiger_matrices_ = false;
+      _number_of_processed_events_ = 0;
+      _number_of_triggered_events_.clear();
+      return;
+    }
+
+    void trigger_scan::reset_counters()
+    {
+      _number_of_processed_events_ = 0;
+      _number_of_triggered_events_.assign(_configurations_.size(), 0);
+      return;
+    }
+
+    void trigger_scan::process(const calo_ctw_data & calo_ctw_data_,
+			       const geiger_ctw_data & geiger_ctw_data_)
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Trigger scan is not initialized, it can't process ! ");
+      // All the algorithms share the calorimeter and tracker configurations :
+      _trigger_algos_.front()->process_front_end(calo_ctw_data_,
+						 geiger_ctw_data_,
+						 _front_end_records_,
+						 _with_tracker_records_,
+						 _with_geiger_matrices_);
+      for (std::size_t i = 0; i < _trigger_algos_.size(); i++)
+	{
+	  trigger_algorithm & a_trigger_algo = *_trigger_algos_[i];
+	  a_trigger_algo.reset_data();
+	  a_trigger_algo.process_back_end(_front_end_records_);
+	  if (a_trigger_algo.get_finale_decision()) _number_of_triggered_events_[i]++;
+	}
+      _number_of_processed_events_++;
+      return;
+    }
+
+    const trigger_algorithm & trigger_scan::get_trigger_algorithm(std::size_t index_) const
+    {
+      DT_THROW_IF(!is_initialized(), std::logic_error, "Trigger scan is not initialized ! ");
+      DT_THROW_IF(index_ >= _trigger_algos_.size(), std::range_error, "Invalid configuration index [" << index_ << "] ! ");
+      return *_trigger_algos_[index_];
+    }
+
+    bool trigger_scan::get_finale_decision(std::size_t index_) const
+    {
+      return get_trigger_algorithm(index_).get_finale_decision();
+    }
+
+    const std::shared_ptr<const trigger_firmware> & trigger_scan::get_firmware() const
+    {
+      return _firmware_;
+    }
+
+    const trigger_algorithm::front_end_records & trigger_scan::get_front_end_records() const
+    {
+      return _front_end_records_;
+    }
+
+    std::size_t trigger_scan::get_number_of_processed_events() const
+    {
+      return _number_of_processed_events_;
+    }
+
+    std::size_t trigger_scan::get_number_of_triggered_events(std::size_t index_) const
+    {
+      DT_THROW_IF(index_ >= _number_of_triggered_events_.size(), std::range_error, "Invalid configuration index [" << index_ << "] ! ");
+      return _number_of_triggered_events_[index_];
+    }
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
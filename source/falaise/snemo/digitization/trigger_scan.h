@@ -0,0 +1,141 @@
+// snemo/digitization/trigger_scan.h
+// Author(s): Yves LEMIERE <lemiere@lpccaen.in2p3.fr>
+// Author(s): Guillaume OLIVIERO <goliviero@lpccaen.in2p3.fr>
+
+#ifndef FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_SCAN_H
+#define FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_SCAN_H
+
+// Standard library :
+#include <string>
+#include <vector>
+#include <memory>
+
+// This project :
+#include <snemo/digitization/trigger_algorithm.h>
+
+namespace datatools {
+  class multi_properties;
+}
+
+namespace snemo {
+
+  namespace digitization {
+
+		class calo_ctw_data;
+		class geiger_ctw_data;
+		class electronic_mapping;
+		class clock_utils;
+
+		/// \brief Evaluation of several trigger configurations on the same events.
+		///
+		/// The configurations of a scan share the calorimeter and tracker sections
+		/// of the trigger configuration and differ by their gates, their previous
+		/// event buffer depth and their coincidence flags. The trigger front end
+		/// (CTWs decoding, calorimeter records, Geiger matrices and zones) is run
+		/// once per event and its products are evaluated by the back end of each
+		/// configuration. The decisions and records of a configuration are the ones
+		/// of a trigger algorithm configured alone and processing the same event.
+		/// The tracker memories are loaded once in a firmware image shared by the
+		/// configurations.
+		class trigger_scan
+		{
+		public :
+
+			/// \brief Parameters of a scanned trigger configuration
+			struct configuration
+			{
+				/// Default constructor
+				configuration();
+
+				std::string label;                              //!< Label of the configuration
+				unsigned int calorimeter_gate_size;             //!< Coincidence calorimeter gate size (0 : value of the 'general' section)
+				unsigned int L2_decision_coincidence_gate_size; //!< L2 decision coincidence gate size (0 : value of the 'general' section)
+				unsigned int previous_event_buffer_depth;       //!< Previous event buffer depth (0 : value of the 'general' section)
+				bool activate_calorimeter_only;                 //!< Calorimeter only trigger
+				bool activate_any_coincidences;                 //!< Calorimeter / tracker coincidences
+			};
+
+			/// Default constructor
+			trigger_scan();
+
+			/// Destructor
+			virtual ~trigger_scan();
+
+			/// Set the electronic mapping object
+			void set_electronic_mapping(const electronic_mapping & my_electronic_mapping_);
+
+			/// Set the clock manager
+			void set_clock_manager(const clock_utils & my_clock_manager_);
+
+			/// Add a configuration to scan
+			void add_configuration(const configuration & configuration_);
+
+			/// Return the number of scanned configurations
+			std::size_t get_number_of_configurations() const;
+
+			/// Return a scanned configuration
+			const configuration & get_configuration(std::size_t index_) const;
+
+			/// Initialize the trigger algorithm of each configuration from a common trigger configuration
+			void initialize(const datatools::multi_properties & mconfig_);
+
+			/// Check if the scan is initialized
+			bool is_initialized() const;
+
+			/// Reset the scan
+			void reset();
+
+			/// Reset the event counters
+			void reset_counters();
+
+			/// Process the CTWs of an event with all the configurations
+			void process(const calo_ctw_data & calo_ctw_data_,
+									 const geiger_ctw_data & geiger_ctw_data_);
+
+			/// Return the trigger algorithm of a configuration (products of the last processed event)
+			const trigger_algorithm & get_trigger_algorithm(std::size_t index_) const;
+
+			/// Return the finale decision of a configuration for the last processed event
+			bool get_finale_decision(std::size_t index_) const;
+
+			/// Return the trigger firmware image shared by the configurations
+			const std::shared_ptr<const trigger_firmware> & get_firmware() const;
+
+			/// Return the front end products of the last processed event
+			const trigger_algorithm::front_end_records & get_front_end_records() const;
+
+			/// Return the number of processed events
+			std::size_t get_number_of_processed_events() const;
+
+			/// Return the number of events triggered by a configuration
+			std::size_t get_number_of_triggered_events(std::size_t index_) const;
+
+		private :
+
+			bool _initialized_; //!< Initialization flag
+			const electronic_mapping * _electronic_mapping_; //!< Convert geometric ID into electronic ID
+			const clock_utils * _clock_manager_; //!< Pointer to a clock manager useful for clocktick conversions
+			std::vector<configuration> _configurations_; //!< Scanned configurations
+			std::shared_ptr<const trigger_firmware> _firmware_; //!< Trigger firmware image shared by the configurations
+			std::vector<std::unique_ptr<trigger_algorithm> > _trigger_algos_; //!< Trigger algorithm of each configuration
+			bool _with_tracker_records_; //!< Tracker records needed by at least one configuration
+			bool _with_geiger_matrices_; //!< Geiger matrices kept by at least one configuration
+			trigger_algorithm::front_end_records _front_end_records_; //!< Front end products of the current event
+			std::size_t _number_of_processed_events_; //!< Number of processed events
+			std::vector<std::size_t> _number_of_triggered_events_; //!< Number of triggered events per configuration
+
+		};
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+#endif // FALAISE_DIGITIZATION_PLUGIN_SNEMO_DIGITIZATION_TRIGGER_SCAN_H
+
+/*
+** Local Variables: --
+** mode: c++ --
+** c-file-style: "gnu" --
+** tab-width: 2 --
+** End: --
+*/
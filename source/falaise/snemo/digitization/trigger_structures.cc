@@ -12,6 +12,29 @@ namespace snemo {
 
   namespace digitization {
 
+    void trigger_structures::pack_zone_masks(const finale_data_type (& finale_data_per_zone_)[trigger_info::NSIDES][trigger_info::NZONES],
+					     zoning_word_type (& zone_masks_)[trigger_info::NSIDES][trigger_info::DATA_FULL_BITSET_SIZE])
+    {
+      for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	{
+	  // Transpose the zones x bits matrix of the side :
+	  unsigned long words[trigger_info::DATA_FULL_BITSET_SIZE] = {0};
+	  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
+	    {
+	      const unsigned long zone_data = finale_data_per_zone_[iside][izone].to_ulong();
+	      for (unsigned int ibit = 0; ibit < trigger_info::DATA_FULL_BITSET_SIZE; ibit++)
+		{
+		  words[ibit] |= ((zone_data >> ibit) & 1UL) << izone;
+		}
+	    }
+	  for (unsigned int ibit = 0; ibit < trigger_info::DATA_FULL_BITSET_SIZE; ibit++)
+	    {
+	      zone_masks_[iside][ibit] = zoning_word_type(words[ibit]);
+	    }
+	}
+      return;
+    }
+
    trigger_structures::calo_record::calo_record()
     {
       calo_record::reset();
@@ -122,6 +145,10 @@ namespace snemo {
 	    {
 	      finale_data_per_zone[iside][izone].reset();
 	    }
+	  for (unsigned int ibit = 0; ibit < trigger_info::DATA_FULL_BITSET_SIZE; ibit++)
+	    {
+	      zone_masks[iside][ibit].reset();
+	    }
 	  zoning_word_pattern[iside].reset();
 	  zoning_word_near_source[iside].reset();
 	}
@@ -130,6 +157,12 @@ namespace snemo {
       return;
     }
 
+    void trigger_structures::tracker_record::update_zone_masks()
+    {
+      trigger_structures::pack_zone_masks(finale_data_per_zone, zone_masks);
+      return;
+    }
+
     bool trigger_structures::tracker_record::is_empty() const
     {
       for (unsigned int i = 0; i < trigger_info::NSIDES; i++)
@@ -570,6 +603,10 @@ namespace snemo {
 	    {
 	      tracker_finale_data_per_zone[iside][izone].reset();
 	    }
+	  for (unsigned int ibit = 0; ibit < trigger_info::DATA_FULL_BITSET_SIZE; ibit++)
+	    {
+	      tracker_zone_masks[iside][ibit].reset();
+	    }
 	  coincidence_zoning_word[iside].reset();
 	  tracker_zoning_word_pattern[iside].reset();
 	  tracker_zoning_word_near_source[iside].reset();
@@ -578,6 +615,12 @@ namespace snemo {
       return;
     }
 
+    void trigger_structures::previous_event_record::update_tracker_zone_masks()
+    {
+      trigger_structures::pack_zone_masks(tracker_finale_data_per_zone, tracker_zone_masks);
+      return;
+    }
+
     void trigger_structures::previous_event_record::display(std::ostream & out_) const
     {
       out_ << "************************************************************************************" << std::endl;
@@ -8,6 +8,7 @@
 
 // Standard library :
 #include <bitset>
+#include <type_traits>
 
 // Third part :
 // Boost :
@@ -15,6 +16,7 @@
 // This project :
 #include <snemo/digitization/calo_ctw_constants.h>
 #include <snemo/digitization/trigger_info.h>
+#include <snemo/digitization/small_bitset.h>
 
 namespace snemo {
 
@@ -39,6 +41,25 @@ namespace snemo {
 	DAVE         = 6
       };
 
+      // The records hold their bitsets in small words and their flags in bit fields,
+      // they are trivially copyable and copied by value by the trigger algorithms :
+
+      /// Zoning word of a side (one bit per zone)
+      typedef small_bitset<trigger_info::NZONES> zoning_word_type;
+
+      /// Finale data of a tracker zone (see tracker_record::bit_index)
+      typedef small_bitset<trigger_info::DATA_FULL_BITSET_SIZE> finale_data_type;
+
+      /// Calorimeter multiplicity
+      typedef small_bitset<calo::ctw::HTM_BITSET_SIZE> multiplicity_type;
+
+      /// Calorimeter XT information
+      typedef small_bitset<trigger_info::CALO_XT_INFO_BITSET_SIZE> xt_info_type;
+
+      /// Zones of a side packed per finale data bit : bit izone of zone_masks_[iside][ibit] is finale_data_per_zone_[iside][izone][ibit]
+      static void pack_zone_masks(const finale_data_type (& finale_data_per_zone_)[trigger_info::NSIDES][trigger_info::NZONES],
+				  zoning_word_type (& zone_masks_)[trigger_info::NSIDES][trigger_info::DATA_FULL_BITSET_SIZE]);
+
       // Calorimeter trigger structures :
       struct calo_record
       {
@@ -46,14 +67,14 @@ namespace snemo {
 	void reset();
 	void display(std::ostream & out_=std::clog) const;
 	uint32_t clocktick_25ns;
-	std::bitset<trigger_info::NZONES> zoning_word[trigger_info::NSIDES];
-	std::bitset<calo::ctw::HTM_BITSET_SIZE> total_multiplicity_side_0;
-	std::bitset<calo::ctw::HTM_BITSET_SIZE> total_multiplicity_side_1;
-	bool LTO_side_0;
-	bool LTO_side_1;
-	std::bitset<calo::ctw::HTM_BITSET_SIZE> total_multiplicity_gveto;
-	bool LTO_gveto;
-	std::bitset<trigger_info::CALO_XT_INFO_BITSET_SIZE> xt_info_bitset;
+	zoning_word_type zoning_word[trigger_info::NSIDES];
+	multiplicity_type total_multiplicity_side_0;
+	multiplicity_type total_multiplicity_side_1;
+	multiplicity_type total_multiplicity_gveto;
+	xt_info_type xt_info_bitset;
+	bool LTO_side_0 : 1;
+	bool LTO_side_1 : 1;
+	bool LTO_gveto : 1;
       };
 
       struct calo_summary_record : public calo_record
@@ -63,9 +84,9 @@ namespace snemo {
 	void reset_summary_boolean_only();
 	void display(std::ostream & out_=std::clog) const;
 	bool is_empty() const;
-	bool single_side_coinc;
-	bool total_multiplicity_threshold;
-	bool calo_finale_decision;
+	bool single_side_coinc : 1;
+	bool total_multiplicity_threshold : 1;
+	bool calo_finale_decision : 1;
       };
 
       // Tracker trigger structures :
@@ -85,12 +106,16 @@ namespace snemo {
 	void reset();
 	bool is_empty() const;
 	void display(std::ostream & out_=std::clog);
+	/// Pack the finale data per zone in the zone masks, to call each time the finale data are modified
+	void update_zone_masks();
 	uint32_t clocktick_1600ns;
-	std::bitset<trigger_info::DATA_FULL_BITSET_SIZE> finale_data_per_zone[trigger_info::NSIDES][trigger_info::NZONES];
-	std::bitset<trigger_info::NZONES> zoning_word_pattern[trigger_info::NSIDES];
-	std::bitset<trigger_info::NZONES> zoning_word_near_source[trigger_info::NSIDES];
-	bool single_side_coinc;
-	bool finale_decision;
+	// Finale data per zone packed per side and per finale data bit (one bit per zone) :
+	zoning_word_type zone_masks[trigger_info::NSIDES][trigger_info::DATA_FULL_BITSET_SIZE];
+	zoning_word_type zoning_word_pattern[trigger_info::NSIDES];
+	zoning_word_type zoning_word_near_source[trigger_info::NSIDES];
+	finale_data_type finale_data_per_zone[trigger_info::NSIDES][trigger_info::NZONES];
+	bool single_side_coinc : 1;
+	bool finale_decision : 1;
       };
 
       struct geiger_matrix
@@ -109,17 +134,17 @@ namespace snemo {
 	coincidence_base_record();
 	void reset();
 	void display(std::ostream & out_=std::clog) const;
-	std::bitset<trigger_info::NZONES> calo_zoning_word[trigger_info::NSIDES];
-	std::bitset<calo::ctw::HTM_BITSET_SIZE> total_multiplicity_side_0;
-	std::bitset<calo::ctw::HTM_BITSET_SIZE> total_multiplicity_side_1;
-	bool LTO_side_0;
-	bool LTO_side_1;
-	std::bitset<calo::ctw::HTM_BITSET_SIZE> total_multiplicity_gveto;
-	bool LTO_gveto;
-	std::bitset<trigger_info::CALO_XT_INFO_BITSET_SIZE> xt_info_bitset;
-	bool single_side_coinc;
-	bool total_multiplicity_threshold;
-	bool decision;
+	zoning_word_type calo_zoning_word[trigger_info::NSIDES];
+	multiplicity_type total_multiplicity_side_0;
+	multiplicity_type total_multiplicity_side_1;
+	multiplicity_type total_multiplicity_gveto;
+	xt_info_type xt_info_bitset;
+	bool LTO_side_0 : 1;
+	bool LTO_side_1 : 1;
+	bool LTO_gveto : 1;
+	bool single_side_coinc : 1;
+	bool total_multiplicity_threshold : 1;
+	bool decision : 1;
       };
 
       struct coincidence_calo_record : public coincidence_base_record
@@ -139,12 +164,12 @@ namespace snemo {
 	bool is_empty() const;
 	uint32_t clocktick_1600ns;
 	// Coincidence zoning word :
-	std::bitset<trigger_info::NZONES> coincidence_zoning_word[trigger_info::NSIDES];
+	zoning_word_type coincidence_zoning_word[trigger_info::NSIDES];
 	// Traker pattern zoning word :
-	std::bitset<trigger_info::NZONES> tracker_zoning_word_pattern[trigger_info::NSIDES];
+	zoning_word_type tracker_zoning_word_pattern[trigger_info::NSIDES];
 	// Tracker near source zoning word :
-	std::bitset<trigger_info::NZONES> tracker_zoning_word_near_source[trigger_info::NSIDES];
-	std::bitset<trigger_info::DATA_FULL_BITSET_SIZE> tracker_finale_data_per_zone[trigger_info::NSIDES][trigger_info::NZONES];
+	zoning_word_type tracker_zoning_word_near_source[trigger_info::NSIDES];
+	finale_data_type tracker_finale_data_per_zone[trigger_info::NSIDES][trigger_info::NZONES];
 	trigger_structures::L2_trigger_mode trigger_mode;
       };
 
@@ -153,15 +178,19 @@ namespace snemo {
 	previous_event_record();
 	void reset();
 	void display(std::ostream & out_=std::clog) const;
+	/// Pack the tracker finale data per zone in the tracker zone masks, to call each time the finale data are modified
+	void update_tracker_zone_masks();
 	uint32_t previous_clocktick_1600ns;
 	uint32_t counter_1600ns;
 	// Coincidence zoning word :
-	std::bitset<trigger_info::NZONES> coincidence_zoning_word[trigger_info::NSIDES];
+	zoning_word_type coincidence_zoning_word[trigger_info::NSIDES];
 	// Traker pattern zoning word :
-	std::bitset<trigger_info::NZONES> tracker_zoning_word_pattern[trigger_info::NSIDES];
+	zoning_word_type tracker_zoning_word_pattern[trigger_info::NSIDES];
 	// Tracker near source zoning word :
-	std::bitset<trigger_info::NZONES> tracker_zoning_word_near_source[trigger_info::NSIDES];
-	std::bitset<trigger_info::DATA_FULL_BITSET_SIZE> tracker_finale_data_per_zone[trigger_info::NSIDES][trigger_info::NZONES];
+	zoning_word_type tracker_zoning_word_near_source[trigger_info::NSIDES];
+	// Tracker finale data per zone packed per side and per finale data bit (one bit per zone) :
+	zoning_word_type tracker_zone_masks[trigger_info::NSIDES][trigger_info::DATA_FULL_BITSET_SIZE];
+	finale_data_type tracker_finale_data_per_zone[trigger_info::NSIDES][trigger_info::NZONES];
 	trigger_structures::L2_trigger_mode trigger_mode;
       };
 
@@ -197,6 +226,17 @@ namespace snemo {
 
     };
 
+    static_assert(sizeof(trigger_structures::finale_data_type) == 1 && sizeof(trigger_structures::zoning_word_type) == 2, "Trigger structures bitsets are not packed !");
+    static_assert(std::is_trivially_copyable<trigger_structures::calo_summary_record>::value
+		  && std::is_trivially_copyable<trigger_structures::tracker_record>::value
+		  && std::is_trivially_copyable<trigger_structures::coincidence_calo_record>::value
+		  && std::is_trivially_copyable<trigger_structures::coincidence_event_record>::value
+		  && std::is_trivially_copyable<trigger_structures::previous_event_record>::value, "Trigger records are not trivially copyable !");
+    static_assert(sizeof(trigger_structures::calo_summary_record) <= 20, "Calorimeter summary record is not packed !");
+    static_assert(sizeof(trigger_structures::tracker_record) <= 64, "Tracker record is not packed !");
+    static_assert(sizeof(trigger_structures::coincidence_event_record) <= 64, "Coincidence event record is not packed !");
+    static_assert(sizeof(trigger_structures::previous_event_record) <= 96, "Previous event record is not packed !");
+
   } // end of namespace digitization
 
 } // end of namespace snemo
@@ -4,11 +4,13 @@
 #include <iostream>
 #include <exception>
 #include <cstdlib>
+#include <bitset>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/logger.h>
 #include <datatools/io_factory.h>
+#include <datatools/exception.h>
 
 // Falaise:
 #include <falaise/falaise.h>
@@ -52,6 +54,67 @@ int main(int argc_, char ** argv_)
       }
     std::clog << std::endl;
 
+    // Contribution to the calorimeter trigger, decoded again after each modification :
+    typedef snemo::digitization::calo_ctw::trigger_contribution contribution_type;
+    DT_THROW_IF(my_calo_ctw.get_trigger_contribution().multiplicity[0] != 1
+		|| my_calo_ctw.get_trigger_contribution().multiplicity[1] != 0
+		|| my_calo_ctw.get_trigger_contribution().zoning_word[0] != zoning_word.to_ulong()
+		|| my_calo_ctw.get_trigger_contribution().zoning_word[1] != 0
+		|| my_calo_ctw.get_trigger_contribution().flags != contribution_type::FLAG_LTO_SIDE_0,
+		std::logic_error, "Wrong main wall trigger contribution ! ");
+    my_calo_ctw.set_htm_main_wall(3);
+    DT_THROW_IF(my_calo_ctw.get_trigger_contribution().multiplicity[0] != 3, std::logic_error, "Trigger contribution is not updated ! ");
+
+    // All the trigger words of both layouts :
+    for (unsigned int crate = 0; crate <= snemo::digitization::mapping::XWALL_GVETO_CALO_CRATE; crate++)
+      {
+	snemo::digitization::calo_ctw a_calo_ctw;
+	geomtools::geom_id a_ctw_gid = ctw_gid;
+	a_ctw_gid.set(snemo::digitization::mapping::CRATE_INDEX, crate);
+	a_calo_ctw.set_header(hit_id, a_ctw_gid, clocktick_25ns);
+	for (unsigned long word = 0; word < (1ul << snemo::digitization::calo::ctw::FULL_BITSET_SIZE); word++)
+	  {
+	    std::bitset<snemo::digitization::calo::ctw::FULL_BITSET_SIZE> full_word(word);
+	    a_calo_ctw.set_full_word(full_word);
+	    const contribution_type & a_contribution = a_calo_ctw.get_trigger_contribution();
+	    unsigned int multiplicity[2] = {0, 0};
+	    unsigned int gveto_multiplicity = 0;
+	    unsigned long zoning[2] = {0, 0};
+	    unsigned int flags = 0;
+	    if (a_calo_ctw.is_main_wall())
+	      {
+		std::bitset<snemo::digitization::calo::ctw::MAIN_ZONING_BITSET_SIZE> main_zoning_word;
+		a_calo_ctw.get_main_zoning_word(main_zoning_word);
+		multiplicity[crate] = a_calo_ctw.get_htm_main_wall_info();
+		zoning[crate] = main_zoning_word.to_ulong();
+		if (a_calo_ctw.is_lto_main_wall()) flags |= (crate == 0 ? contribution_type::FLAG_LTO_SIDE_0 : contribution_type::FLAG_LTO_SIDE_1);
+	      }
+	    else
+	      {
+		std::bitset<snemo::digitization::calo::ctw::XWALL_ZONING_BITSET_SIZE> xwall_zoning_word;
+		a_calo_ctw.get_xwall_zoning_word(xwall_zoning_word);
+		multiplicity[0] = a_calo_ctw.get_htm_xwall_side_0_info();
+		multiplicity[1] = a_calo_ctw.get_htm_xwall_side_1_info();
+		gveto_multiplicity = a_calo_ctw.get_htm_gveto_info();
+		if (xwall_zoning_word.test(0)) zoning[0] |= 0x1;
+		if (xwall_zoning_word.test(1)) zoning[0] |= 0x200;
+		if (xwall_zoning_word.test(2)) zoning[1] |= 0x1;
+		if (xwall_zoning_word.test(3)) zoning[1] |= 0x200;
+		flags |= contribution_type::FLAG_GVETO;
+		if (a_calo_ctw.is_lto_xwall_side_0()) flags |= contribution_type::FLAG_LTO_SIDE_0;
+		if (a_calo_ctw.is_lto_xwall_side_1()) flags |= contribution_type::FLAG_LTO_SIDE_1;
+		if (a_calo_ctw.is_lto_gveto()) flags |= contribution_type::FLAG_LTO_GVETO;
+	      }
+	    DT_THROW_IF(a_contribution.multiplicity[0] != multiplicity[0]
+			|| a_contribution.multiplicity[1] != multiplicity[1]
+			|| a_contribution.gveto_multiplicity != gveto_multiplicity
+			|| a_contribution.zoning_word[0] != zoning[0]
+			|| a_contribution.zoning_word[1] != zoning[1]
+			|| a_contribution.flags != flags,
+			std::logic_error, "Wrong trigger contribution of the word " << full_word << " in crate " << crate << " ! ");
+	  }
+      }
+
     std::clog << "The end." << std::endl;
   }
 
@@ -4,17 +4,41 @@
 #include <iostream>
 #include <exception>
 #include <cstdlib>
+#include <set>
+#include <string>
+#include <tuple>
 
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/logger.h>
 #include <datatools/io_factory.h>
+#include <datatools/exception.h>
 
 // Falaise:
 #include <falaise/falaise.h>
 
 // This project :
 #include <snemo/digitization/calo_tp_to_ctw_algo.h>
+#include <snemo/digitization/mapping.h>
+
+/// Crate, clocktick and trigger word of a calorimeter CTW
+typedef std::tuple<uint32_t, uint32_t, std::string> ctw_key_type;
+
+/// Add the crate, clocktick and trigger word of the CTWs of a collection
+void collect_ctw_keys(const snemo::digitization::calo_ctw_data & calo_ctw_data_,
+		      std::multiset<ctw_key_type> & ctw_keys_)
+{
+  for (std::size_t i = 0; i < calo_ctw_data_.get_calo_ctws().size(); i++)
+    {
+      const snemo::digitization::calo_ctw & a_calo_ctw = calo_ctw_data_.get_calo_ctws()[i].get();
+      std::bitset<snemo::digitization::calo::ctw::FULL_BITSET_SIZE> a_full_word;
+      a_calo_ctw.get_full_word(a_full_word);
+      ctw_keys_.insert(ctw_key_type(a_calo_ctw.get_geom_id().get(snemo::digitization::mapping::CRATE_INDEX),
+				    a_calo_ctw.get_clocktick_25ns(),
+				    a_full_word.to_string()));
+    }
+  return;
+}
 
 int main(int  argc_, char ** argv_)
 {
@@ -93,6 +117,17 @@ int main(int  argc_, char ** argv_)
       ctp.set_htm(1);
       ctp.tree_dump(std::clog, "CTP 6 : ", "INFO : ");
     }
+    {
+      snemo::digitization::calo_tp & ctp = my_calo_tp_data.add();
+      ctp.set_hit_id(27);
+      ctp.grab_geom_id().set_type(42);
+      ctp.grab_geom_id().set_address(3,2,7);
+      ctp.grab_auxiliaries().store("author", "guillaume");
+      ctp.grab_auxiliaries().store_flag("fake");
+      ctp.set_clocktick_25ns(20);
+      ctp.set_htm(1);
+      ctp.tree_dump(std::clog, "CTP 7 : ", "INFO : ");
+    }
     snemo::digitization::calo_ctw_data my_calo_ctw_data;
     snemo::digitization::calo_tp_to_ctw_algo algo;
 
@@ -106,6 +141,33 @@ int main(int  argc_, char ** argv_)
 
     my_calo_ctw_data.tree_dump(std::clog, "my_calo_ctw_data : ", "INFO : ");
 
+    // Same TPs processed for all crates in one pass :
+    snemo::digitization::calo_ctw_data my_all_crates_calo_ctw_data;
+    snemo::digitization::calo_tp_to_ctw_algo all_crates_algo;
+    all_crates_algo.set_all_crates();
+    all_crates_algo.initialize();
+    all_crates_algo.process(my_calo_tp_data, my_all_crates_calo_ctw_data);
+
+    my_all_crates_calo_ctw_data.tree_dump(std::clog, "my_all_crates_calo_ctw_data : ", "INFO : ");
+
+    // The all crates CTWs are the union of the CTWs of each crate :
+    std::multiset<ctw_key_type> per_crate_ctw_keys;
+    for (unsigned int icrate = 0; icrate < snemo::digitization::mapping::NUMBER_OF_CRATES; icrate++)
+      {
+	snemo::digitization::calo_ctw_data a_crate_calo_ctw_data;
+	snemo::digitization::calo_tp_to_ctw_algo a_crate_algo;
+	a_crate_algo.set_crate_number(icrate);
+	a_crate_algo.initialize();
+	a_crate_algo.process(my_calo_tp_data, a_crate_calo_ctw_data);
+	DT_THROW_IF(a_crate_calo_ctw_data.get_calo_ctws().empty(), std::logic_error, "No CTW for the crate #" << icrate << " ! ");
+	collect_ctw_keys(a_crate_calo_ctw_data, per_crate_ctw_keys);
+      }
+    std::multiset<ctw_key_type> all_crates_ctw_keys;
+    collect_ctw_keys(my_all_crates_calo_ctw_data, all_crates_ctw_keys);
+    DT_THROW_IF(all_crates_ctw_keys.size() != per_crate_ctw_keys.size(), std::logic_error,
+		"All crates algorithm gives " << all_crates_ctw_keys.size() << " CTWs instead of " << per_crate_ctw_keys.size() << " ! ");
+    DT_THROW_IF(all_crates_ctw_keys != per_crate_ctw_keys, std::logic_error, "All crates CTWs differ from the union of the CTWs of each crate ! ");
+
     std::clog << "The end." << std::endl;
   }
 
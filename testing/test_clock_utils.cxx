@@ -0,0 +1,115 @@
+//test_clock_utils.cxx
+
+// Standard libraries :
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/clock_utils.h>
+
+int main( int  argc_ , char ** argv_ )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for class 'snemo::digitization::clock_utils' !" << std::endl;
+
+    typedef snemo::digitization::clock_utils clock_utils;
+
+    // Clock domain conversions against the definitions in nanoseconds :
+    for (uint64_t clocktick = 0; clocktick < 100000; clocktick++)
+      {
+	const uint64_t clocktick_1600_from_25 = clocktick * clock_utils::MAIN_CLOCKTICK / clock_utils::TRIGGER_CLOCKTICK + clock_utils::TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS;
+	const uint64_t clocktick_1600_from_800 = clocktick * clock_utils::TRACKER_CLOCKTICK / clock_utils::TRIGGER_CLOCKTICK + clock_utils::TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS;
+	DT_THROW_IF(clock_utils::clocktick_25ns_to_1600ns(clocktick) != clocktick_1600_from_25, std::logic_error, "Wrong conversion of the clocktick 25 ns " << clocktick << " ! ");
+	DT_THROW_IF(clock_utils::clocktick_800ns_to_1600ns(clocktick) != clocktick_1600_from_800, std::logic_error, "Wrong conversion of the clocktick 800 ns " << clocktick << " ! ");
+	DT_THROW_IF(clock_utils::clocktick_25ns_to_1600ns((uint32_t) clocktick) != (uint32_t) clocktick_1600_from_25, std::logic_error, "Wrong 32 bits conversion of the clocktick 25 ns " << clocktick << " ! ");
+      }
+
+    // No overflow for the large 32 bits clockticks :
+    const uint32_t large_clocktick_25 = 4000000000u;
+    DT_THROW_IF(clock_utils::clocktick_25ns_to_1600ns(large_clocktick_25) != (uint32_t) ((uint64_t) large_clocktick_25 * 25 / 1600 + 1), std::logic_error, "Overflow of the clocktick 25 ns conversion ! ");
+
+    // Clockticks 25 and 800 ns within a clocktick 1600 ns :
+    for (uint64_t clocktick_1600 = clock_utils::TRIGGER_COMPUTING_SHIFT_CLOCKTICK_1600NS; clocktick_1600 < 1000; clocktick_1600++)
+      {
+	const uint64_t first_25 = clock_utils::first_clocktick_25ns_of_1600ns(clocktick_1600);
+	const uint64_t last_25 = clock_utils::last_clocktick_25ns_of_1600ns(clocktick_1600);
+	DT_THROW_IF(last_25 - first_25 + 1 != clock_utils::NUMBER_OF_25_CLOCK_IN_1600, std::logic_error, "Wrong number of clockticks 25 ns in the clocktick 1600 ns " << clocktick_1600 << " ! ");
+	DT_THROW_IF(clock_utils::clocktick_25ns_to_1600ns(first_25) != clocktick_1600 || clock_utils::clocktick_25ns_to_1600ns(last_25) != clocktick_1600
+		    || clock_utils::clocktick_25ns_to_1600ns(last_25 + 1) != clocktick_1600 + 1, std::logic_error, "Wrong clockticks 25 ns range of the clocktick 1600 ns " << clocktick_1600 << " ! ");
+	const uint64_t first_800 = clock_utils::first_clocktick_800ns_of_1600ns(clocktick_1600);
+	const uint64_t last_800 = clock_utils::last_clocktick_800ns_of_1600ns(clocktick_1600);
+	DT_THROW_IF(clock_utils::clocktick_800ns_to_1600ns(first_800) != clocktick_1600 || clock_utils::clocktick_800ns_to_1600ns(last_800) != clocktick_1600
+		    || clock_utils::clocktick_800ns_to_1600ns(last_800 + 1) != clocktick_1600 + 1, std::logic_error, "Wrong clockticks 800 ns range of the clocktick 1600 ns " << clocktick_1600 << " ! ");
+      }
+
+    // Batch conversions :
+    std::vector<uint32_t> clockticks(1000);
+    for (std::size_t i = 0; i < clockticks.size(); i++) clockticks[i] = 37 * i;
+    std::vector<uint32_t> clockticks_1600_from_25(clockticks.size());
+    clock_utils::clockticks_25ns_to_1600ns(clockticks.data(), clockticks.size(), clockticks_1600_from_25.data());
+    std::vector<uint32_t> clockticks_1600_from_800 = clockticks;
+    clock_utils::clockticks_800ns_to_1600ns(clockticks_1600_from_800.data(), clockticks_1600_from_800.size(), clockticks_1600_from_800.data());
+    for (std::size_t i = 0; i < clockticks.size(); i++)
+      {
+	DT_THROW_IF(clockticks_1600_from_25[i] != clock_utils::clocktick_25ns_to_1600ns(clockticks[i])
+		    || clockticks_1600_from_800[i] != clock_utils::clocktick_800ns_to_1600ns(clockticks[i]), std::logic_error, "Wrong batch conversion of the clocktick " << clockticks[i] << " ! ");
+      }
+
+    // Time bucketing, floor(time / period) including the clocktick boundaries and the negative times :
+    const uint32_t periods[3] = {clock_utils::MAIN_CLOCKTICK, clock_utils::TRACKER_CLOCKTICK, clock_utils::TRIGGER_CLOCKTICK};
+    for (unsigned int iperiod = 0; iperiod < 3; iperiod++)
+      {
+	const uint32_t period = periods[iperiod];
+	for (int64_t clocktick = -100; clocktick < 100; clocktick++)
+	  {
+	    const double boundary = (double) clocktick * period;
+	    DT_THROW_IF(clock_utils::time_to_clocktick(boundary, period) != clocktick, std::logic_error, "Wrong clocktick of the time " << boundary << " ns ! ");
+	    DT_THROW_IF(clock_utils::time_to_clocktick(boundary + 0.5, period) != clocktick, std::logic_error, "Wrong clocktick of the time " << boundary + 0.5 << " ns ! ");
+	    DT_THROW_IF(clock_utils::time_to_clocktick(boundary - 0.001, period) != clocktick - 1, std::logic_error, "Wrong clocktick of the time " << boundary - 0.001 << " ns ! ");
+	    DT_THROW_IF(clock_utils::time_phase_in_clocktick(boundary + 0.5, period) != 0.5, std::logic_error, "Wrong phase of the time " << boundary + 0.5 << " ns ! ");
+	  }
+      }
+
+    // Clockticks references and phase shifts of the random 1600 ns shift :
+    snemo::digitization::clock_utils my_clock_manager;
+    my_clock_manager.initialize();
+    for (uint64_t ievent = 0; ievent < 1000; ievent++)
+      {
+	my_clock_manager.compute_clockticks_ref(27182, 0, ievent);
+	const double shift_1600 = my_clock_manager.get_shift_1600();
+	DT_THROW_IF(my_clock_manager.get_clocktick_25_ref() != (int32_t) std::floor(shift_1600 / clock_utils::MAIN_CLOCKTICK)
+		    || my_clock_manager.get_clocktick_800_ref() != (int32_t) std::floor(shift_1600 / clock_utils::TRACKER_CLOCKTICK), std::logic_error, "Wrong clockticks references for the shift " << shift_1600 << " ns ! ");
+	const double shift_25 = my_clock_manager.get_clocktick_25_ref() * (double) clock_utils::MAIN_CLOCKTICK + my_clock_manager.get_shift_25();
+	const double shift_800 = my_clock_manager.get_clocktick_800_ref() * (double) clock_utils::TRACKER_CLOCKTICK + my_clock_manager.get_shift_800();
+	DT_THROW_IF(std::abs(shift_25 - shift_1600) > 1.e-4 || std::abs(shift_800 - shift_1600) > 1.e-4, std::logic_error, "Wrong phase shifts for the shift " << shift_1600 << " ns ! ");
+      }
+    my_clock_manager.tree_dump(std::clog, "Clock utils : ", "INFO : ");
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
@@ -0,0 +1,501 @@
+//test_coincidence_trigger_algorithm.cxx
+
+// Standard libraries :
+#include <iostream>
+#include <random>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/coincidence_trigger_algorithm.h>
+#include <snemo/digitization/clock_utils.h>
+#include <snemo/digitization/mapping.h>
+
+namespace snemo {
+
+  namespace digitization {
+
+    // Reference per zone implementation of the CARACO, APE and DAVE spatial matches :
+
+    void reference_calo_tracker_coincidence(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> a_pair_for_a_clocktick_,
+					  trigger_structures::coincidence_event_record & a_coincidence_record_,
+					  trigger_structures::L2_decision & a_L2_decision_record_,
+					  trigger_structures::L2_trigger_mode & coincidence_decision_)
+
+    {
+      trigger_structures::coincidence_calo_record a_calo_record = a_pair_for_a_clocktick_.first;
+      trigger_structures::tracker_record a_tracker_record = a_pair_for_a_clocktick_.second;
+
+      DT_THROW_IF(a_calo_record.clocktick_1600ns != a_tracker_record.clocktick_1600ns, std::logic_error, "Calo tracker coincidence can't process, clockticks of a calo record [" << a_calo_record.clocktick_1600ns << "] and a tracker record [" << a_tracker_record.clocktick_1600ns << "] are not the same ! ");
+
+      for (unsigned int iside = 0; iside < mapping::NUMBER_OF_SIDES; iside++)
+      	{
+      	  for (unsigned int izone = 0; izone < mapping::NUMBER_OF_TRIGGER_ZONES; izone++)
+      	    {
+      	      std::bitset<3> hpattern_for_a_zone = 0x0;
+
+      	      int right = 0;
+      	      int mid   = 1;
+      	      int left  = 2;
+
+      	      hpattern_for_a_zone[right] = a_tracker_record.finale_data_per_zone[iside][izone][right+2];
+      	      hpattern_for_a_zone[mid]   = a_tracker_record.finale_data_per_zone[iside][izone][mid+2];
+      	      hpattern_for_a_zone[left]  = a_tracker_record.finale_data_per_zone[iside][izone][left+2];
+      	      if (hpattern_for_a_zone.any())
+      		{
+      		  if (hpattern_for_a_zone.test(mid) && a_calo_record.calo_zoning_word[iside].test(izone) != 0)
+      		    {
+      		      a_coincidence_record_.coincidence_zoning_word[iside].set(izone, true);
+      		      a_coincidence_record_.decision = true;
+      		      a_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::CARACO;
+      		      coincidence_decision_ = trigger_structures::L2_trigger_mode::CARACO;
+      		    }
+
+      		  if ((hpattern_for_a_zone.test(right) && a_calo_record.calo_zoning_word[iside].test(izone) != 0) ||
+      		      (izone+1 < 10 && hpattern_for_a_zone.test(right) && a_calo_record.calo_zoning_word[iside].test(izone+1) != 0))
+      		    {
+      		      a_coincidence_record_.coincidence_zoning_word[iside].set(izone, true);
+      		      a_coincidence_record_.decision = true;
+      		      a_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::CARACO;
+      		      coincidence_decision_ = trigger_structures::L2_trigger_mode::CARACO;
+      		    }
+
+      		  if ((hpattern_for_a_zone.test(left) && a_calo_record.calo_zoning_word[iside].test(izone) != 0) ||
+      		      ((int)(izone-1) > -1 && hpattern_for_a_zone.test(left) && a_calo_record.calo_zoning_word[iside].test(izone-1) != 0))
+      		    {
+      		      a_coincidence_record_.coincidence_zoning_word[iside].set(izone, true);
+      		      a_coincidence_record_.decision = true;
+      		      a_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::CARACO;
+      		      coincidence_decision_ = trigger_structures::L2_trigger_mode::CARACO;
+      		    }
+
+      		} // end of hpattern.any()
+      	    } // end of izone
+      	} // end of iside
+
+      if ((a_coincidence_record_.decision = true) && coincidence_decision_ == trigger_structures::L2_trigger_mode::CARACO)
+      	{
+	  a_coincidence_record_.clocktick_1600ns = a_calo_record.clocktick_1600ns;
+      	  a_coincidence_record_.calo_zoning_word[0] = a_calo_record.calo_zoning_word[0];
+      	  a_coincidence_record_.calo_zoning_word[1] = a_calo_record.calo_zoning_word[1];
+      	  a_coincidence_record_.total_multiplicity_side_0 = a_calo_record.total_multiplicity_side_0;
+      	  a_coincidence_record_.total_multiplicity_side_1 = a_calo_record.total_multiplicity_side_1;
+      	  a_coincidence_record_.LTO_side_0 = a_calo_record.LTO_side_0;
+      	  a_coincidence_record_.LTO_side_1 = a_calo_record.LTO_side_1;
+      	  a_coincidence_record_.total_multiplicity_gveto = a_calo_record.total_multiplicity_gveto;
+      	  a_coincidence_record_.LTO_gveto = a_calo_record.LTO_gveto;
+      	  a_coincidence_record_.xt_info_bitset = a_calo_record.xt_info_bitset;
+      	  a_coincidence_record_.single_side_coinc = a_calo_record.single_side_coinc;
+      	  a_coincidence_record_.total_multiplicity_threshold = a_calo_record.total_multiplicity_threshold;
+
+      	  for (unsigned int iside = 0; iside < mapping::NUMBER_OF_SIDES; iside++)
+      	    {
+      	      for (unsigned int izone = 0; izone < mapping::NUMBER_OF_TRIGGER_ZONES; izone++)
+      		{
+      		  a_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
+      		} // end of izone
+
+	      a_coincidence_record_.tracker_zoning_word_pattern[iside] = a_tracker_record.zoning_word_pattern[iside];
+	      a_coincidence_record_.tracker_zoning_word_near_source[iside] = a_tracker_record.zoning_word_near_source[iside];
+
+	    } // end of iside
+
+	  a_L2_decision_record_.L2_decision_bool = true;
+	  a_L2_decision_record_.L2_ct_decision = a_calo_record.clocktick_1600ns;
+	  a_L2_decision_record_.L2_trigger_mode = trigger_structures::L2_trigger_mode::CARACO;
+	}
+
+      return;
+    }
+
+    void reference_delayed_coincidence(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> a_pair_for_a_clocktick_,
+				       trigger_structures::coincidence_event_record & a_delayed_coincidence_record_,
+				       trigger_structures::L2_decision & a_L2_decision_record_,
+				       const trigger_structures::previous_event_record & a_previous_event_record_,
+				       trigger_structures::L2_trigger_mode & coincidence_decision_)
+    {
+      trigger_structures::tracker_record a_tracker_record = a_pair_for_a_clocktick_.second;
+
+      for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	{
+	  for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
+	    {
+	      std::bitset<3> delayed_hpattern_per_zone = 0x0;
+
+	      int right = 0;
+	      int mid   = 1;
+	      int left  = 2;
+
+	      delayed_hpattern_per_zone[right] = a_tracker_record.finale_data_per_zone[iside][izone][right+2];
+	      delayed_hpattern_per_zone[mid]   = a_tracker_record.finale_data_per_zone[iside][izone][mid+2];
+	      delayed_hpattern_per_zone[left]  = a_tracker_record.finale_data_per_zone[iside][izone][left+2];
+
+	      // APE trigger (Tracker previous / Tracker delayed coincidence)
+	      if (delayed_hpattern_per_zone.any())
+		{
+		  if (delayed_hpattern_per_zone.test(left) && izone == 0 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(left+2)
+									     || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(mid+2)
+									     || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(left+2)
+									     || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(mid+2)))
+		    {
+		      a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
+		      a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
+		      a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::APE;
+		      a_delayed_coincidence_record_.decision = true;
+		      coincidence_decision_ = trigger_structures::L2_trigger_mode::APE;
+		    }
+
+		  if (delayed_hpattern_per_zone.test(left) && (int)(izone-1) > -1 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone-1].test(right+2)
+									       || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(left+2)
+									       || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(mid+2)
+									       || a_previous_event_record_.tracker_finale_data_per_zone[1][izone-1].test(right+2)
+									       || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(left+2)
+									       || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(mid+2)))
+		    {
+		      a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
+		      a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
+		      a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::APE;
+		      a_delayed_coincidence_record_.decision = true;
+		      coincidence_decision_ = trigger_structures::L2_trigger_mode::APE;
+		    }
+
+		  if (delayed_hpattern_per_zone.test(mid) && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(left+2)
+							      || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(mid+2)
+							      || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(right+2)
+							      || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(left+2)
+							      || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(mid+2)
+							      || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(right+2)))
+		    {
+		      a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
+		      a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
+		      a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::APE;
+		      a_delayed_coincidence_record_.decision = true;
+		      coincidence_decision_ = trigger_structures::L2_trigger_mode::APE;
+		    }
+
+		  if (delayed_hpattern_per_zone.test(right) && izone == 10 &&(a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(mid+2)
+									      || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(right+2)
+									      || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(mid+2)
+									      || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(right+2)))
+		    {
+		      a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
+		      a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
+		      a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::APE;
+		      a_delayed_coincidence_record_.decision = true;
+		      coincidence_decision_ = trigger_structures::L2_trigger_mode::APE;
+		    }
+
+		  if (delayed_hpattern_per_zone.test(right) && izone + 1 < 10 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(mid+2)
+										  || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(right+2)
+										  || a_previous_event_record_.tracker_finale_data_per_zone[0][izone+1].test(left+2)
+										  || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(mid+2)
+										  || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(right+2)
+										  || a_previous_event_record_.tracker_finale_data_per_zone[1][izone+1].test(left+2)))
+		    {
+		      a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
+		      a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
+		      a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::APE;
+		      a_delayed_coincidence_record_.decision = true;
+		      coincidence_decision_ = trigger_structures::L2_trigger_mode::APE;
+		    }
+		}
+	    } // end of izone
+	} // end of iside
+
+      if (a_delayed_coincidence_record_.decision && coincidence_decision_ == trigger_structures::L2_trigger_mode::APE)
+	{
+	  for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	    {
+	      a_delayed_coincidence_record_.tracker_zoning_word_pattern[iside] = a_tracker_record.zoning_word_pattern[iside];
+	      a_delayed_coincidence_record_.tracker_zoning_word_near_source[iside] = a_tracker_record.zoning_word_near_source[iside];
+	    }
+	  a_delayed_coincidence_record_.single_side_coinc = a_tracker_record.single_side_coinc;
+	  a_L2_decision_record_.L2_decision_bool = true;
+	  a_L2_decision_record_.L2_ct_decision = a_tracker_record.clocktick_1600ns;
+	  a_L2_decision_record_.L2_trigger_mode = trigger_structures::L2_trigger_mode::APE;
+	}
+
+      // Delayed Alpha Veto Event (DAVE) trigger
+      else
+	{
+	  for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	    {
+	      for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
+		{
+		  std::bitset<2> delayed_near_source_per_zone = 0x0;
+		  int near_source_right = 0;
+		  int near_source_left  = 1;
+		  delayed_near_source_per_zone[near_source_right] = a_tracker_record.finale_data_per_zone[iside][izone][near_source_right + 5];
+		  delayed_near_source_per_zone[near_source_left]  = a_tracker_record.finale_data_per_zone[iside][izone][near_source_left + 5];
+
+		  if (delayed_near_source_per_zone.any())
+		    {
+		      if (delayed_near_source_per_zone.test(near_source_left) && izone == 0 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_left+5)
+												|| a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_right+5)
+												|| a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_left+5)
+												|| a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_right+5)))
+			{
+			  a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
+			  a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
+			  a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::DAVE;
+			  a_delayed_coincidence_record_.decision = true;
+			  coincidence_decision_ = trigger_structures::L2_trigger_mode::DAVE;
+			}
+
+
+		      if (delayed_near_source_per_zone.test(near_source_left) && (int) (izone-1) > -1 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone-1].test(near_source_right+5)
+												    || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_left+5)
+												    || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_right+5)
+												    || a_previous_event_record_.tracker_finale_data_per_zone[1][izone-1].test(near_source_right+5)
+												    || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_left+5)
+												    || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_right+5)))
+
+			{
+			  a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
+			  a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
+			  a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::DAVE;
+			  a_delayed_coincidence_record_.decision = true;
+			  coincidence_decision_ = trigger_structures::L2_trigger_mode::DAVE;
+			}
+
+
+		      if (delayed_near_source_per_zone.test(near_source_right) && izone == 10 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_left+5)
+												  || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_right+5)
+												  || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_left+5)
+												  || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_right+5)))
+			{
+			  a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
+			  a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
+			  a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::DAVE;
+			  a_delayed_coincidence_record_.decision = true;
+			  coincidence_decision_ = trigger_structures::L2_trigger_mode::DAVE;
+			}
+
+		      if (delayed_near_source_per_zone.test(near_source_right) && izone + 1 < 10 && (a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_left+5)
+												     || a_previous_event_record_.tracker_finale_data_per_zone[0][izone].test(near_source_right+5)
+												     || a_previous_event_record_.tracker_finale_data_per_zone[0][izone+1].test(near_source_left+5)
+												     || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_left+5)
+												     || a_previous_event_record_.tracker_finale_data_per_zone[1][izone].test(near_source_right+5)
+												     || a_previous_event_record_.tracker_finale_data_per_zone[1][izone+1].test(near_source_left+5)))
+			{
+			  a_delayed_coincidence_record_.clocktick_1600ns = a_tracker_record.clocktick_1600ns;
+			  a_delayed_coincidence_record_.tracker_finale_data_per_zone[iside][izone] = a_tracker_record.finale_data_per_zone[iside][izone];
+			  a_delayed_coincidence_record_.trigger_mode = trigger_structures::L2_trigger_mode::DAVE;
+			  a_delayed_coincidence_record_.decision = true;
+			  coincidence_decision_ = trigger_structures::L2_trigger_mode::DAVE;
+			}
+		    } // enf of if delayed any
+
+		} // end of izone
+	    } // end of iside
+
+	  if (a_delayed_coincidence_record_.decision && coincidence_decision_ == trigger_structures::L2_trigger_mode::DAVE)
+	    {
+	      for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+		{
+		  a_delayed_coincidence_record_.tracker_zoning_word_near_source[iside] = a_tracker_record.zoning_word_near_source[iside];
+		}
+	      a_delayed_coincidence_record_.single_side_coinc = a_tracker_record.single_side_coinc;
+	      a_L2_decision_record_.L2_decision_bool = true;
+	      a_L2_decision_record_.L2_ct_decision = a_tracker_record.clocktick_1600ns;
+	      a_L2_decision_record_.L2_trigger_mode = trigger_structures::L2_trigger_mode::DAVE;
+	    }
+
+	}//end of else
+
+      return;
+    }
+
+    void reference_process(const std::pair<trigger_structures::coincidence_calo_record, trigger_structures::tracker_record> & pair_for_a_clocktick_,
+			   trigger_structures::coincidence_event_record & a_coincidence_record_,
+			   trigger_structures::L2_decision & a_L2_decision_record_,
+			   const boost::scoped_ptr<boost::circular_buffer<trigger_structures::previous_event_record> > & previous_event_records_)
+    {
+      trigger_structures::L2_trigger_mode coincidence_decision = trigger_structures::L2_trigger_mode::INVALID;
+      reference_calo_tracker_coincidence(pair_for_a_clocktick_, a_coincidence_record_, a_L2_decision_record_, coincidence_decision);
+      for (auto it_circ = previous_event_records_->begin(); it_circ != previous_event_records_->end(); it_circ++)
+	{
+	  if (it_circ->counter_1600ns <= clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK
+	      && it_circ->counter_1600ns > 0
+	      && !a_L2_decision_record_.L2_decision_bool)
+	    {
+	      reference_delayed_coincidence(pair_for_a_clocktick_, a_coincidence_record_, a_L2_decision_record_, *it_circ, coincidence_decision);
+	    }
+	}
+      return;
+    }
+
+  } // end of namespace digitization
+
+} // end of namespace snemo
+
+namespace sdd = snemo::digitization;
+
+/// Random finale data per zone, each bit set with a probability
+void random_finale_data(std::mt19937 & generator_,
+			double probability_,
+			sdd::trigger_structures::finale_data_type (& finale_data_per_zone_)[sdd::trigger_info::NSIDES][sdd::trigger_info::NZONES])
+{
+  std::bernoulli_distribution bit(probability_);
+  for (unsigned int iside = 0; iside < sdd::trigger_info::NSIDES; iside++)
+    {
+      for (unsigned int izone = 0; izone < sdd::trigger_info::NZONES; izone++)
+	{
+	  for (unsigned int ibit = 0; ibit < sdd::trigger_info::DATA_FULL_BITSET_SIZE; ibit++)
+	    {
+	      finale_data_per_zone_[iside][izone][ibit] = bit(generator_);
+	    }
+	}
+    }
+  return;
+}
+
+/// Check that two coincidence records and L2 decisions are identical
+bool same_results(const sdd::trigger_structures::coincidence_event_record & a_,
+		  const sdd::trigger_structures::L2_decision & a_L2_,
+		  const sdd::trigger_structures::coincidence_event_record & b_,
+		  const sdd::trigger_structures::L2_decision & b_L2_)
+{
+  if (a_L2_.L2_decision_bool != b_L2_.L2_decision_bool
+      || a_L2_.L2_ct_decision != b_L2_.L2_ct_decision
+      || a_L2_.L2_trigger_mode != b_L2_.L2_trigger_mode) return false;
+  if (a_.clocktick_1600ns != b_.clocktick_1600ns
+      || a_.trigger_mode != b_.trigger_mode
+      || a_.decision != b_.decision
+      || a_.single_side_coinc != b_.single_side_coinc
+      || a_.total_multiplicity_threshold != b_.total_multiplicity_threshold
+      || a_.total_multiplicity_side_0 != b_.total_multiplicity_side_0
+      || a_.total_multiplicity_side_1 != b_.total_multiplicity_side_1
+      || a_.total_multiplicity_gveto != b_.total_multiplicity_gveto
+      || a_.LTO_side_0 != b_.LTO_side_0
+      || a_.LTO_side_1 != b_.LTO_side_1
+      || a_.LTO_gveto != b_.LTO_gveto
+      || a_.xt_info_bitset != b_.xt_info_bitset) return false;
+  for (unsigned int iside = 0; iside < sdd::trigger_info::NSIDES; iside++)
+    {
+      if (a_.calo_zoning_word[iside] != b_.calo_zoning_word[iside]
+	  || a_.coincidence_zoning_word[iside] != b_.coincidence_zoning_word[iside]
+	  || a_.tracker_zoning_word_pattern[iside] != b_.tracker_zoning_word_pattern[iside]
+	  || a_.tracker_zoning_word_near_source[iside] != b_.tracker_zoning_word_near_source[iside]) return false;
+      for (unsigned int izone = 0; izone < sdd::trigger_info::NZONES; izone++)
+	{
+	  if (a_.tracker_finale_data_per_zone[iside][izone] != b_.tracker_finale_data_per_zone[iside][izone]) return false;
+	}
+    }
+  return true;
+}
+
+int main( int  argc_ , char ** argv_ )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for class 'snemo::digitization::coincidence_trigger_algorithm' !" << std::endl;
+
+    // Zone masks are the transposition of the finale data per zone :
+    std::mt19937 generator(271828);
+    sdd::trigger_structures::tracker_record a_tracker_record;
+    random_finale_data(generator, 0.5, a_tracker_record.finale_data_per_zone);
+    a_tracker_record.update_zone_masks();
+    for (unsigned int iside = 0; iside < sdd::trigger_info::NSIDES; iside++)
+      {
+	for (unsigned int izone = 0; izone < sdd::trigger_info::NZONES; izone++)
+	  {
+	    for (unsigned int ibit = 0; ibit < sdd::trigger_info::DATA_FULL_BITSET_SIZE; ibit++)
+	      {
+		DT_THROW_IF(a_tracker_record.zone_masks[iside][ibit][izone] != a_tracker_record.finale_data_per_zone[iside][izone][ibit],
+			    std::logic_error, "Wrong zone mask for side " << iside << " zone " << izone << " bit " << ibit << " ! ");
+	      }
+	  }
+      }
+
+    // Word-parallel kernel against the per zone reference on random records :
+    sdd::coincidence_trigger_algorithm my_coincidence_algo;
+    my_coincidence_algo.initialize_simple();
+    boost::scoped_ptr<boost::circular_buffer<sdd::trigger_structures::previous_event_record> > previous_event_records;
+    previous_event_records.reset(new boost::circular_buffer<sdd::trigger_structures::previous_event_record>(10));
+
+    std::bernoulli_distribution calo_bit(0.15);
+    std::uniform_int_distribution<unsigned int> number_of_previous_events(0, 3);
+    std::uniform_int_distribution<uint32_t> counter(0, sdd::clock_utils::PREVIOUS_EVENT_RECORD_LIVING_NUMBER_OF_CLOCKTICK + 10);
+    const std::size_t number_of_trials = 200000;
+    std::size_t number_of_decisions[sdd::trigger_structures::L2_trigger_mode::DAVE + 1] = {0};
+    for (std::size_t itrial = 0; itrial < number_of_trials; itrial++)
+      {
+	// Sparse and dense patterns :
+	const double probability = (itrial % 3 == 0) ? 0.3 : 0.05;
+	std::pair<sdd::trigger_structures::coincidence_calo_record, sdd::trigger_structures::tracker_record> a_pair;
+	a_pair.first.clocktick_1600ns = itrial;
+	a_pair.first.single_side_coinc = itrial % 2;
+	a_pair.first.total_multiplicity_side_0 = itrial % 4;
+	for (unsigned int iside = 0; iside < sdd::trigger_info::NSIDES; iside++)
+	  {
+	    for (unsigned int izone = 0; izone < sdd::trigger_info::NZONES; izone++)
+	      {
+		a_pair.first.calo_zoning_word[iside][izone] = calo_bit(generator);
+	      }
+	  }
+	a_pair.second.clocktick_1600ns = itrial;
+	a_pair.second.single_side_coinc = itrial % 5 == 0;
+	random_finale_data(generator, probability, a_pair.second.finale_data_per_zone);
+	a_pair.second.zoning_word_pattern[0] = itrial % 1024;
+	a_pair.second.update_zone_masks();
+
+	previous_event_records->clear();
+	const unsigned int number_of_PERs = number_of_previous_events(generator);
+	for (unsigned int iper = 0; iper < number_of_PERs; iper++)
+	  {
+	    sdd::trigger_structures::previous_event_record a_PER;
+	    a_PER.counter_1600ns = counter(generator);
+	    random_finale_data(generator, probability, a_PER.tracker_finale_data_per_zone);
+	    a_PER.update_tracker_zone_masks();
+	    previous_event_records->push_back(a_PER);
+	  }
+
+	sdd::trigger_structures::coincidence_event_record a_coincidence_record;
+	sdd::trigger_structures::L2_decision a_L2_decision;
+	my_coincidence_algo.process(a_pair, a_coincidence_record, a_L2_decision, previous_event_records);
+
+	sdd::trigger_structures::coincidence_event_record a_reference_coincidence_record;
+	sdd::trigger_structures::L2_decision a_reference_L2_decision;
+	sdd::reference_process(a_pair, a_reference_coincidence_record, a_reference_L2_decision, previous_event_records);
+
+	DT_THROW_IF(!same_results(a_coincidence_record, a_L2_decision, a_reference_coincidence_record, a_reference_L2_decision),
+		    std::logic_error, "Coincidence kernel differs from the per zone reference at trial #" << itrial << " ! ");
+	number_of_decisions[a_L2_decision.L2_trigger_mode]++;
+      }
+
+    std::clog << "Trials : " << number_of_trials
+	      << " CARACO : " << number_of_decisions[sdd::trigger_structures::L2_trigger_mode::CARACO]
+	      << " APE : " << number_of_decisions[sdd::trigger_structures::L2_trigger_mode::APE]
+	      << " DAVE : " << number_of_decisions[sdd::trigger_structures::L2_trigger_mode::DAVE]
+	      << " None : " << number_of_decisions[sdd::trigger_structures::L2_trigger_mode::INVALID] << std::endl;
+    DT_THROW_IF(number_of_decisions[sdd::trigger_structures::L2_trigger_mode::CARACO] == 0
+		|| number_of_decisions[sdd::trigger_structures::L2_trigger_mode::APE] == 0
+		|| number_of_decisions[sdd::trigger_structures::L2_trigger_mode::DAVE] == 0
+		|| number_of_decisions[sdd::trigger_structures::L2_trigger_mode::INVALID] == 0,
+		std::logic_error, "All trigger modes are not covered ! ");
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
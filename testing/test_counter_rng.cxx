@@ -0,0 +1,94 @@
+//test_counter_rng.cxx
+
+// Standard libraries :
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/counter_rng.h>
+#include <snemo/digitization/clock_utils.h>
+
+int main( int  argc_ , char ** argv_ )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for class 'snemo::digitization::counter_rng' !" << std::endl;
+
+    const uint64_t seed = 314159;
+    const std::size_t number_of_events = 100;
+
+    // Same key, same stream :
+    snemo::digitization::counter_rng prng_1(seed, 0, 42);
+    snemo::digitization::counter_rng prng_2(seed, 0, 42);
+    std::vector<uint64_t> stream;
+    for (std::size_t i = 0; i < 10; i++)
+      {
+	stream.push_back(prng_1.next());
+	DT_THROW_IF(stream.back() != prng_2.next(), std::logic_error, "Same keys give different streams ! ");
+      }
+
+    // Random access in the stream :
+    prng_2.set_counter(5);
+    DT_THROW_IF(prng_2.next() != stream[5], std::logic_error, "Wrong random access in the stream ! ");
+
+    // Other keys, other streams :
+    snemo::digitization::counter_rng prng_3(seed, 1, 42);
+    snemo::digitization::counter_rng prng_4(seed, 0, 42, snemo::digitization::counter_rng::STREAM_GEIGER);
+    DT_THROW_IF(prng_3.get_key() == prng_1.get_key() || prng_4.get_key() == prng_1.get_key(), std::logic_error, "Different keys give the same stream ! ");
+
+    // Uniform distribution in [min;max[ :
+    double sum = 0.;
+    const std::size_t number_of_draws = 100000;
+    for (std::size_t i = 0; i < number_of_draws; i++)
+      {
+	const double value = prng_3.flat(0.0, 1600.0);
+	DT_THROW_IF(value < 0.0 || value >= 1600.0, std::logic_error, "Value " << value << " out of range ! ");
+	sum += value;
+      }
+    std::clog << "Mean of flat [0;1600[ : " << sum / number_of_draws << std::endl;
+    DT_THROW_IF(std::abs(sum / number_of_draws - 800.0) > 10.0, std::logic_error, "Wrong mean of the flat distribution ! ");
+
+    // Clockticks references of an event do not depend on the other events :
+    snemo::digitization::clock_utils my_clock_manager;
+    my_clock_manager.initialize();
+    std::vector<double> serial_shifts;
+    for (std::size_t ievent = 0; ievent < number_of_events; ievent++)
+      {
+	my_clock_manager.compute_clockticks_ref(seed, 0, ievent);
+	serial_shifts.push_back(my_clock_manager.get_shift_1600());
+      }
+    for (std::size_t ievent = number_of_events; ievent-- > 0;)
+      {
+	if (ievent % 3 == 0) continue;
+	my_clock_manager.compute_clockticks_ref(seed, 0, ievent);
+	DT_THROW_IF(my_clock_manager.get_shift_1600() != serial_shifts[ievent], std::logic_error, "Clock shift of event #" << ievent << " depends on the processing order ! ");
+      }
+    my_clock_manager.tree_dump(std::clog, "Clock utils : ", "INFO : ");
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
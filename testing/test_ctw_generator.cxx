@@ -0,0 +1,133 @@
+//test_ctw_generator.cxx
+
+// Standard libraries :
+#include <iostream>
+#include <chrono>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+#include <datatools/properties.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/ctw_generator.h>
+#include <snemo/digitization/calo_ctw_data.h>
+#include <snemo/digitization/geiger_ctw_data.h>
+#include <snemo/digitization/calo_trigger_algorithm.h>
+
+/// Return the number of active Geiger channels of the CTWs of a clocktick
+unsigned int count_geiger_channels(const snemo::digitization::geiger_ctw_data & geiger_ctw_data_, uint32_t clocktick_800_)
+{
+  unsigned int number_of_channels = 0;
+  snemo::digitization::geiger_ctw_data::geiger_ctw_collection_type ctws;
+  geiger_ctw_data_.get_list_of_geiger_ctw_per_clocktick(clocktick_800_, ctws);
+  for (std::size_t ictw = 0; ictw < ctws.size(); ictw++)
+    {
+      for (unsigned int iblock = 0; iblock < snemo::digitization::mapping::NUMBER_OF_FEBS_BY_CRATE; iblock++)
+	{
+	  std::bitset<snemo::digitization::geiger::tp::TP_THREE_WIRES_SIZE> channels;
+	  ctws[ictw].get().get_36_bits_in_ctw_word(iblock, channels);
+	  number_of_channels += channels.count();
+	}
+    }
+  return number_of_channels;
+}
+
+int main( int  argc_ , char ** argv_ )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for class 'snemo::digitization::ctw_generator' !" << std::endl;
+
+    // One track ending on the calorimeter :
+    snemo::digitization::ctw_generator my_generator;
+    my_generator.set_seed(314159);
+    my_generator.set_number_of_tracks(1);
+    my_generator.set_calo_multiplicity(1);
+    my_generator.initialize_simple();
+
+    for (uint64_t ievent = 0; ievent < 100; ievent++)
+      {
+	snemo::digitization::calo_ctw_data my_calo_ctw_data;
+	snemo::digitization::geiger_ctw_data my_geiger_ctw_data;
+	my_generator.generate(ievent, my_calo_ctw_data, my_geiger_ctw_data);
+	DT_THROW_IF(my_calo_ctw_data.get_calo_ctws().size() != 1, std::logic_error, "Wrong number of calo CTWs for event #" << ievent << " ! ");
+	const snemo::digitization::calo_ctw & my_calo_ctw = my_calo_ctw_data.get_calo_ctws()[0].get();
+	std::bitset<snemo::digitization::calo::ctw::MAIN_ZONING_BITSET_SIZE> zoning_word;
+	my_calo_ctw.get_main_zoning_word(zoning_word);
+	DT_THROW_IF(my_calo_ctw.get_htm_main_wall_info() != 1 || zoning_word.count() != 1, std::logic_error, "Wrong calo CTW for event #" << ievent << " ! ");
+	// All the cells of the track are active 2 clockticks after the prompt clocktick :
+	const unsigned int number_of_cells = count_geiger_channels(my_geiger_ctw_data, 102);
+	DT_THROW_IF(number_of_cells == 0 || number_of_cells > snemo::digitization::mapping::NUMBER_OF_LAYERS, std::logic_error,
+		    "Wrong number of track cells [" << number_of_cells << "] for event #" << ievent << " ! ");
+	DT_THROW_IF(my_geiger_ctw_data.get_clocktick_min() < 100 || my_geiger_ctw_data.get_clocktick_max() > 110, std::logic_error,
+		    "Wrong Geiger clockticks for event #" << ievent << " ! ");
+
+	// Same event ID, same event :
+	snemo::digitization::calo_ctw_data other_calo_ctw_data;
+	snemo::digitization::geiger_ctw_data other_geiger_ctw_data;
+	my_generator.generate(ievent, other_calo_ctw_data, other_geiger_ctw_data);
+	DT_THROW_IF(other_geiger_ctw_data.get_geiger_ctws().size() != my_geiger_ctw_data.get_geiger_ctws().size()
+		    || count_geiger_channels(other_geiger_ctw_data, 102) != number_of_cells,
+		    std::logic_error, "Event #" << ievent << " is not reproducible ! ");
+	if (ievent == 0) my_geiger_ctw_data.tree_dump(std::clog, "Geiger CTW(s) data : ", "INFO : ");
+      }
+
+    // Pile-up : tracks, delayed alphas and noise :
+    snemo::digitization::ctw_generator my_pileup_generator;
+    datatools::properties generator_config;
+    generator_config.store("seed", 27);
+    generator_config.store("number_of_tracks", 2);
+    generator_config.store("calo_multiplicity", 3);
+    generator_config.store("delayed_alpha_probability", 1.0);
+    generator_config.store_with_explicit_unit("geiger_noise_rate", 100 * CLHEP::hertz);
+    generator_config.store_with_explicit_unit("noise_window", 1 * CLHEP::millisecond);
+    my_pileup_generator.initialize(generator_config);
+
+    snemo::digitization::calo_trigger_algorithm my_calo_algo;
+    my_calo_algo.initialize_simple();
+
+    const std::size_t number_of_events = 10000;
+    std::size_t number_of_geiger_ctws = 0;
+    std::size_t number_of_calo_records = 0;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint64_t ievent = 0; ievent < number_of_events; ievent++)
+      {
+	snemo::digitization::calo_ctw_data my_calo_ctw_data;
+	snemo::digitization::geiger_ctw_data my_geiger_ctw_data;
+	my_pileup_generator.generate(ievent, my_calo_ctw_data, my_geiger_ctw_data);
+	number_of_geiger_ctws += my_geiger_ctw_data.get_geiger_ctws().size();
+	std::vector<snemo::digitization::trigger_structures::calo_summary_record> calo_records;
+	my_calo_algo.process(my_calo_ctw_data, calo_records);
+	number_of_calo_records += calo_records.size();
+      }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::clog << "Mean number of Geiger CTWs per event : " << double(number_of_geiger_ctws) / number_of_events << std::endl;
+    std::clog << "Events per second (generation and calo trigger) : " << number_of_events / elapsed << std::endl;
+    // Tracks, alphas and about 200 noisy cells per event :
+    DT_THROW_IF(number_of_geiger_ctws < 100 * number_of_events, std::logic_error, "Missing Geiger noise ! ");
+    DT_THROW_IF(number_of_calo_records == 0, std::logic_error, "No calo trigger ! ");
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
@@ -9,6 +9,7 @@
 // - Bayeux/datatools:
 #include <datatools/logger.h>
 #include <datatools/io_factory.h>
+#include <datatools/exception.h>
 
 // Falaise:
 #include <falaise/falaise.h>
@@ -32,6 +33,24 @@ int main(int argc_, char ** argv_)
     my_geiger_ctw.set_clocktick_800ns(20); 
     std::bitset<100> test_gg_tp_word (std::string ("1111111111111111111111111111111111111111111111111111010110111111111111111111111111111111111111111111"));  
     my_geiger_ctw.tree_dump(std::clog, "my_geiger_CTW : ", "INFO : "); 
+
+    // Packed serialization round trip :
+    std::bitset<snemo::digitization::geiger::tp::FULL_SIZE> test_gg_tp_bitset(test_gg_tp_word);
+    my_geiger_ctw.set_100_bits_in_ctw_word(4, test_gg_tp_bitset);
+    {
+      datatools::data_writer writer("test_geiger_ctw.xml", datatools::using_multiple_archives);
+      writer.store(my_geiger_ctw);
+    }
+    snemo::digitization::geiger_ctw my_loaded_geiger_ctw;
+    {
+      datatools::data_reader reader("test_geiger_ctw.xml", datatools::using_multiple_archives);
+      DT_THROW_IF(!reader.has_record_tag(), std::logic_error, "No record in the archive ! ");
+      reader.load(my_loaded_geiger_ctw);
+    }
+    std::bitset<snemo::digitization::geiger::tp::FULL_SIZE> loaded_gg_tp_bitset;
+    my_loaded_geiger_ctw.get_100_bits_in_ctw_word(4, loaded_gg_tp_bitset);
+    DT_THROW_IF(loaded_gg_tp_bitset != test_gg_tp_bitset, std::logic_error, "Loaded geiger CTW differs from the stored one ! ");
+    my_loaded_geiger_ctw.tree_dump(std::clog, "my_loaded_geiger_CTW : ", "INFO : ");
     std::clog << "The end." << std::endl;
   }
 
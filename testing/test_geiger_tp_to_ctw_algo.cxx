@@ -9,6 +9,7 @@
 // - Bayeux/datatools:
 #include <datatools/logger.h>
 #include <datatools/io_factory.h>
+#include <datatools/exception.h>
 
 // Falaise:
 #include <falaise/falaise.h>
@@ -49,6 +50,17 @@ int main( int  argc_ , char **argv_ )
 
     my_geiger_ctw_data.tree_dump(std::clog, "my_geiger_ctw_data : ", "INFO : ");
 
+    // Same process crate by crate (each crate can be processed independently) :
+    std::size_t number_of_ctws_per_crate = 0;
+    for (unsigned int icrate = 0; icrate <= snemo::digitization::mapping::NUMBER_OF_CRATES; icrate++)
+      {
+	snemo::digitization::geiger_ctw_data my_geiger_ctw_data_per_crate;
+	algo.process_crate(my_geiger_tp_data, icrate, my_geiger_ctw_data_per_crate);
+	number_of_ctws_per_crate += my_geiger_ctw_data_per_crate.get_geiger_ctws().size();
+      }
+    DT_THROW_IF(number_of_ctws_per_crate != my_geiger_ctw_data.get_geiger_ctws().size(), std::logic_error,
+		"Crate by crate process does not give the same number of geiger CTWs ! ");
+
     std::clog << "The end." << std::endl;
   }
 
@@ -0,0 +1,80 @@
+//test_handle_pool.cxx
+
+// Standard libraries :
+#include <iostream>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/handle_pool.h>
+#include <snemo/digitization/geiger_tp.h>
+#include <snemo/digitization/geiger_tp_data.h>
+
+int main( int  argc_ , char ** argv_ )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for class 'snemo::digitization::handle_pool' !" << std::endl;
+
+    snemo::digitization::handle_pool<snemo::digitization::geiger_tp> my_pool;
+    std::vector<datatools::handle<snemo::digitization::geiger_tp> > my_handles;
+
+    for (unsigned int i = 0; i < 3; i++)
+      {
+	my_handles.push_back(my_pool.acquire());
+	my_handles.back().grab().set_hit_id(i);
+	my_handles.back().grab().set_clocktick_800ns(100 + i);
+      }
+    datatools::handle<snemo::digitization::geiger_tp> kept_handle = my_handles[1];
+    std::clog << "Pool capacity : " << my_pool.get_capacity() << std::endl;
+
+    // New event : the pooled objects are reused in their default state
+    my_handles.clear();
+    my_pool.recycle();
+    for (unsigned int i = 0; i < 3; i++)
+      {
+	my_handles.push_back(my_pool.acquire());
+	DT_THROW_IF(my_handles.back().get().has_hit_id(), std::logic_error, "Recycled geiger TP #" << i << " is not in its default state ! ");
+      }
+    DT_THROW_IF(kept_handle.get().get_hit_id() != 1, std::logic_error, "A geiger TP still referenced has been recycled ! ");
+    std::clog << "Pool capacity after recycling : " << my_pool.get_capacity() << std::endl;
+    std::clog << "Number of acquired : " << my_pool.get_number_of_acquired() << std::endl;
+
+    // Same behaviour through a pooled data collection
+    snemo::digitization::geiger_tp_data my_geiger_tp_data;
+    for (unsigned int ievent = 0; ievent < 3; ievent++)
+      {
+	my_geiger_tp_data.reset();
+	for (unsigned int i = 0; i < 4; i++)
+	  {
+	    snemo::digitization::geiger_tp & gg_tp = my_geiger_tp_data.add();
+	    gg_tp.set_hit_id(i);
+	    gg_tp.set_clocktick_800ns(ievent * 10 + i);
+	  }
+	my_geiger_tp_data.tree_dump(std::clog, "Geiger TP data : ", "INFO : ");
+      }
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
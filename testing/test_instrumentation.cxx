@@ -0,0 +1,135 @@
+//test_instrumentation.cxx
+
+// Standard libraries :
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/instrumentation.h>
+#include <snemo/digitization/ctw_generator.h>
+#include <snemo/digitization/calo_ctw_data.h>
+#include <snemo/digitization/geiger_ctw_data.h>
+#include <snemo/digitization/calo_trigger_algorithm.h>
+
+namespace instr = snemo::digitization::instrumentation;
+
+/// Work of a thread : timed scopes and counters
+void thread_work(std::size_t number_of_calls_)
+{
+  for (std::size_t i = 0; i < number_of_calls_; i++)
+    {
+      instr::scoped_timer timer(instr::STAGE_TRACKER_TRIGGER);
+      instr::count(instr::COUNTER_LUT_FETCHES, 4);
+    }
+  return;
+}
+
+int main( int  argc_ , char ** argv_ )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for 'snemo::digitization::instrumentation' !" << std::endl;
+    std::clog << "Instrumentation compiled in : " << std::boolalpha << instr::is_enabled() << std::endl;
+
+    // Log2 histogram bins :
+    DT_THROW_IF(instr::stage_statistics::bin_index(0) != 0
+		|| instr::stage_statistics::bin_index(1) != 0
+		|| instr::stage_statistics::bin_index(3) != 1
+		|| instr::stage_statistics::bin_index(1024) != 10,
+		std::logic_error, "Wrong histogram bins ! ");
+
+    // Statistics of several threads are merged :
+    instr::registry & the_registry = instr::registry::instance();
+    the_registry.reset();
+    const std::size_t number_of_threads = 4;
+    const std::size_t number_of_calls = 1000;
+    std::vector<std::thread> threads;
+    for (std::size_t ithread = 0; ithread < number_of_threads; ithread++) threads.push_back(std::thread(thread_work, number_of_calls));
+    for (std::size_t ithread = 0; ithread < number_of_threads; ithread++) threads[ithread].join();
+
+    instr::thread_statistics total;
+    the_registry.merge(total);
+    DT_THROW_IF(the_registry.get_number_of_threads() < number_of_threads, std::logic_error, "Missing thread statistics ! ");
+    DT_THROW_IF(total.stages[instr::STAGE_TRACKER_TRIGGER].number_of_calls != number_of_threads * number_of_calls,
+		std::logic_error, "Wrong number of timed calls ! ");
+    DT_THROW_IF(total.counters[instr::COUNTER_LUT_FETCHES] != 4 * number_of_threads * number_of_calls,
+		std::logic_error, "Wrong merged counter ! ");
+    std::size_t histogram_entries = 0;
+    for (unsigned int ibin = 0; ibin < instr::stage_statistics::NUMBER_OF_BINS; ibin++) histogram_entries += total.stages[instr::STAGE_TRACKER_TRIGGER].histogram[ibin];
+    DT_THROW_IF(histogram_entries != number_of_threads * number_of_calls, std::logic_error, "Wrong number of histogram entries ! ");
+
+    // Reports are built while the workers run :
+    threads.clear();
+    for (std::size_t ithread = 0; ithread < number_of_threads; ithread++) threads.push_back(std::thread(thread_work, number_of_calls));
+    for (std::size_t ireport = 0; ireport < 100; ireport++)
+      {
+	instr::thread_statistics running_total;
+	the_registry.merge(running_total);
+	DT_THROW_IF(running_total.counters[instr::COUNTER_LUT_FETCHES] > 4 * 2 * number_of_threads * number_of_calls,
+		    std::logic_error, "Wrong running counter ! ");
+      }
+    for (std::size_t ithread = 0; ithread < number_of_threads; ithread++) threads[ithread].join();
+
+    // Instrumented trigger stage :
+    the_registry.reset();
+    snemo::digitization::ctw_generator my_generator;
+    my_generator.set_seed(314159);
+    my_generator.set_calo_multiplicity(2);
+    my_generator.initialize_simple();
+    snemo::digitization::calo_trigger_algorithm my_calo_algo;
+    my_calo_algo.initialize_simple();
+    for (std::size_t ievent = 0; ievent < 10; ievent++)
+      {
+	snemo::digitization::calo_ctw_data calo_ctws;
+	snemo::digitization::geiger_ctw_data geiger_ctws;
+	my_generator.generate(ievent, calo_ctws, geiger_ctws);
+	std::vector<snemo::digitization::trigger_structures::calo_summary_record> calo_records;
+	my_calo_algo.process(calo_ctws, calo_records);
+      }
+    instr::thread_statistics trigger_total;
+    the_registry.merge(trigger_total);
+    if (instr::is_enabled())
+      {
+	DT_THROW_IF(trigger_total.stages[instr::STAGE_CALO_TRIGGER].number_of_calls != 10, std::logic_error, "Calorimeter trigger stage not timed ! ");
+	DT_THROW_IF(trigger_total.counters[instr::COUNTER_CALO_CTWS_DECODED] == 0, std::logic_error, "No decoded calorimeter CTW counted ! ");
+      }
+    else
+      {
+	DT_THROW_IF(trigger_total.stages[instr::STAGE_CALO_TRIGGER].number_of_calls != 0, std::logic_error, "Instrumentation is not compiled out ! ");
+      }
+
+    the_registry.print_text(std::clog);
+    the_registry.store_report("test_instrumentation.json");
+    std::ifstream report("test_instrumentation.json");
+    std::string first_line;
+    std::getline(report, first_line);
+    DT_THROW_IF(first_line != "{", std::logic_error, "Wrong JSON report ! ");
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
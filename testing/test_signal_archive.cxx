@@ -0,0 +1,104 @@
+//test_signal_archive.cxx
+
+// Standard libraries :
+#include <iostream>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/signal_data.h>
+#include <snemo/digitization/signal_archive.h>
+
+int main( int  argc_ , char ** argv_ )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for class 'snemo::digitization::signal_archive_writer/reader' !" << std::endl;
+
+    const std::string filename = "test_signal_archive.sigarc";
+    const std::size_t number_of_events = 10;
+    std::vector<snemo::digitization::signal_columns> events(number_of_events);
+
+    {
+      snemo::digitization::signal_archive_writer writer;
+      writer.open(filename);
+      for (std::size_t ievent = 0; ievent < number_of_events; ievent++)
+	{
+	  snemo::digitization::signal_data signal_data;
+	  for (std::size_t i = 0; i < ievent % 4; i++)
+	    {
+	      snemo::digitization::geiger_signal & my_gg_signal = signal_data.add_geiger_signal();
+	      my_gg_signal.set_header(i, geomtools::geom_id(1204, 0, 0, i, 100 + ievent));
+	      my_gg_signal.set_data((1000 + 10 * ievent) * CLHEP::nanosecond);
+	    }
+	  for (std::size_t i = 0; i < ievent % 3; i++)
+	    {
+	      snemo::digitization::calo_signal & my_calo_signal = signal_data.add_calo_signal();
+	      my_calo_signal.set_header(i, geomtools::geom_id(1302, 0, 1, ievent, i));
+	      my_calo_signal.set_data((20 + ievent) * CLHEP::nanosecond, 0.1 * i * CLHEP::MeV);
+	    }
+	  events[ievent].import_signal_data(signal_data);
+	  writer.write(signal_data);
+	}
+      writer.close();
+    }
+
+    snemo::digitization::signal_archive_reader reader;
+    reader.open(filename);
+    DT_THROW_IF(reader.get_number_of_events() != number_of_events, std::logic_error, "Wrong number of archived events ! ");
+
+    // Random access, last event first :
+    snemo::digitization::signal_columns loaded_signals;
+    for (std::size_t ievent = number_of_events; ievent-- > 0;)
+      {
+	reader.load(ievent, loaded_signals);
+	const snemo::digitization::signal_columns & expected_signals = events[ievent];
+	DT_THROW_IF(loaded_signals.get_geiger_hit_ids() != expected_signals.get_geiger_hit_ids()
+		    || loaded_signals.get_geiger_packed_gids() != expected_signals.get_geiger_packed_gids()
+		    || loaded_signals.get_geiger_anode_avalanche_times() != expected_signals.get_geiger_anode_avalanche_times()
+		    || loaded_signals.get_calo_hit_ids() != expected_signals.get_calo_hit_ids()
+		    || loaded_signals.get_calo_packed_gids() != expected_signals.get_calo_packed_gids()
+		    || loaded_signals.get_calo_signal_times() != expected_signals.get_calo_signal_times()
+		    || loaded_signals.get_calo_amplitudes() != expected_signals.get_calo_amplitudes(),
+		    std::logic_error, "Event #" << ievent << " differs after the archive round trip ! ");
+      }
+
+    // Zero copy view :
+    snemo::digitization::signal_archive_event_view view;
+    reader.get_event_view(3, view);
+    std::clog << "Event #3 : " << view.number_of_geiger_signals << " geiger signals, "
+	      << view.number_of_calo_signals << " calo signals" << std::endl;
+    DT_THROW_IF(view.number_of_geiger_signals != 3 || view.geiger_anode_avalanche_times[2] != events[3].get_geiger_anode_avalanche_times()[2],
+		std::logic_error, "Wrong view of event #3 ! ");
+
+    snemo::digitization::signal_data loaded_signal_data;
+    reader.load(5, loaded_signal_data);
+    loaded_signal_data.tree_dump(std::clog, "Loaded signal data #5 : ", "INFO : ");
+
+    reader.close();
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
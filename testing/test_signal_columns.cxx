@@ -0,0 +1,225 @@
+//test_signal_columns.cxx
+
+// Standard libraries :
+#include <iostream>
+
+// GSL:
+#include <bayeux/mygsl/rng.h>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+// - Bayeux/geomtools:
+#include <geomtools/manager.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/signal_data.h>
+#include <snemo/digitization/signal_columns.h>
+#include <snemo/digitization/clock_utils.h>
+#include <snemo/digitization/electronic_mapping.h>
+#include <snemo/digitization/mapping.h>
+#include <snemo/digitization/signal_to_calo_tp_algo.h>
+#include <snemo/digitization/signal_to_geiger_tp_algo.h>
+
+int main( int  argc_ , char ** argv_ )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for class 'snemo::digitization::signal_columns' !" << std::endl;
+
+    snemo::digitization::signal_data signal_data;
+
+    const geomtools::geom_id GID1(1204, 0, 0, 3, 106);
+    const geomtools::geom_id GID2(1204, 0, 1, 6, 95);
+    snemo::digitization::geiger_signal & my_gg_signal = signal_data.add_geiger_signal();
+    my_gg_signal.set_header(0, GID1);
+    my_gg_signal.set_data(1200 * CLHEP::nanosecond);
+    snemo::digitization::geiger_signal & my_gg_signal2 = signal_data.add_geiger_signal();
+    my_gg_signal2.set_header(1, GID2);
+    my_gg_signal2.set_data(850 * CLHEP::nanosecond);
+
+    geomtools::geom_id GID3(1302, 0, 1, 12, 4);
+    GID3.set_depth(5);
+    GID3.set_any(4);
+    snemo::digitization::calo_signal & my_calo_signal = signal_data.add_calo_signal();
+    my_calo_signal.set_header(0, GID3);
+    my_calo_signal.set_data(20 * CLHEP::nanosecond, 0.3 * CLHEP::MeV);
+
+    signal_data.tree_dump(std::clog, "Signal data : ", "INFO : ");
+
+    snemo::digitization::signal_columns my_signal_columns;
+    my_signal_columns.import_signal_data(signal_data);
+    my_signal_columns.tree_dump(std::clog, "Signal columns : ", "INFO : ");
+
+    snemo::digitization::signal_data exported_signal_data;
+    my_signal_columns.export_signal_data(exported_signal_data);
+    exported_signal_data.tree_dump(std::clog, "Exported signal data : ", "INFO : ");
+
+    for (std::size_t i = 0; i < signal_data.get_number_of_geiger_signals(); i++)
+      {
+	const snemo::digitization::geiger_signal & a_signal = signal_data.get_geiger_signals()[i].get();
+	const snemo::digitization::geiger_signal & an_exported_signal = exported_signal_data.get_geiger_signals()[i].get();
+	std::clog << "Geiger signal #" << i << " : GID=" << an_exported_signal.get_geom_id()
+		  << " anode time=" << an_exported_signal.get_anode_avalanche_time() << std::endl;
+	DT_THROW_IF(a_signal.get_geom_id() != an_exported_signal.get_geom_id()
+		    || a_signal.get_hit_id() != an_exported_signal.get_hit_id()
+		    || a_signal.get_anode_avalanche_time() != an_exported_signal.get_anode_avalanche_time(),
+		    std::logic_error, "Geiger signal #" << i << " differs after the columns round trip ! ");
+      }
+
+    for (std::size_t i = 0; i < signal_data.get_number_of_calo_signals(); i++)
+      {
+	const snemo::digitization::calo_signal & a_signal = signal_data.get_calo_signals()[i].get();
+	const snemo::digitization::calo_signal & an_exported_signal = exported_signal_data.get_calo_signals()[i].get();
+	std::clog << "Calo signal #" << i << " : GID=" << an_exported_signal.get_geom_id()
+		  << " time=" << an_exported_signal.get_signal_time()
+		  << " amplitude=" << an_exported_signal.get_amplitude() << std::endl;
+	DT_THROW_IF(a_signal.get_geom_id() != an_exported_signal.get_geom_id()
+		    || a_signal.get_hit_id() != an_exported_signal.get_hit_id()
+		    || a_signal.get_signal_time() != an_exported_signal.get_signal_time()
+		    || a_signal.get_amplitude() != an_exported_signal.get_amplitude(),
+		    std::logic_error, "Calo signal #" << i << " differs after the columns round trip ! ");
+      }
+
+    // Columnar and handle based processing of the same generated signals :
+    int32_t seed = 314159;
+    mygsl::rng random_generator;
+    random_generator.initialize(seed);
+
+    std::string manager_config_file;
+    manager_config_file = "@falaise:config/snemo/demonstrator/geometry/4.0/manager.conf";
+    datatools::fetch_path_with_env(manager_config_file);
+    datatools::properties manager_config;
+    datatools::properties::read_config(manager_config_file,
+				       manager_config);
+    geomtools::manager my_manager;
+    manager_config.update("build_mapping", true);
+    if (manager_config.has_key("mapping.excluded_categories"))
+      {
+	manager_config.erase("mapping.excluded_categories");
+      }
+    my_manager.initialize(manager_config);
+
+    snemo::digitization::electronic_mapping my_e_mapping;
+    my_e_mapping.set_geo_manager(my_manager);
+    my_e_mapping.set_module_number(snemo::digitization::mapping::DEMONSTRATOR_MODULE_NUMBER);
+    my_e_mapping.add_preconstructed_type(snemo::digitization::mapping::GEIGER_CATEGORY_TYPE);
+    my_e_mapping.add_preconstructed_type(snemo::digitization::mapping::CALO_MAIN_WALL_CATEGORY_TYPE);
+    my_e_mapping.initialize();
+
+    snemo::digitization::clock_utils my_clock_manager;
+    my_clock_manager.initialize();
+
+    std::size_t number_of_geiger_tps = 0;
+    std::size_t number_of_calo_tps = 0;
+    for (std::size_t ievent = 0; ievent < 20; ievent++)
+      {
+	my_clock_manager.compute_clockticks_ref(random_generator);
+
+	snemo::digitization::signal_to_geiger_tp_algo signal_2_geiger_tp;
+	signal_2_geiger_tp.initialize(my_e_mapping);
+	signal_2_geiger_tp.set_clocktick_reference(my_clock_manager.get_clocktick_800_ref());
+	signal_2_geiger_tp.set_clocktick_shift(my_clock_manager.get_shift_800());
+
+	snemo::digitization::signal_to_calo_tp_algo signal_2_calo_tp;
+	signal_2_calo_tp.initialize(my_e_mapping);
+	signal_2_calo_tp.set_clocktick_reference(my_clock_manager.get_clocktick_25_ref());
+	signal_2_calo_tp.set_clocktick_shift(my_clock_manager.get_shift_25());
+
+	// Geiger cells hit during a few microseconds and calorimeter hits around the thresholds :
+	snemo::digitization::signal_data event_signal_data;
+	const std::size_t number_of_geiger_signals = 1 + static_cast<std::size_t>(random_generator.uniform() * 40);
+	for (std::size_t i = 0; i < number_of_geiger_signals; i++)
+	  {
+	    const geomtools::geom_id a_cell_gid(snemo::digitization::mapping::GEIGER_CATEGORY_TYPE,
+						snemo::digitization::mapping::DEMONSTRATOR_MODULE_NUMBER,
+						static_cast<uint32_t>(random_generator.uniform() * snemo::digitization::mapping::NUMBER_OF_SIDES),
+						static_cast<uint32_t>(random_generator.uniform() * snemo::digitization::mapping::NUMBER_OF_LAYERS),
+						static_cast<uint32_t>(random_generator.uniform() * snemo::digitization::mapping::NUMBER_OF_GEIGER_ROWS));
+	    snemo::digitization::geiger_signal & a_gg_signal = event_signal_data.add_geiger_signal();
+	    a_gg_signal.set_header(i, a_cell_gid);
+	    a_gg_signal.set_data(random_generator.flat(0.0, 5000.0) * CLHEP::nanosecond);
+	  }
+	const std::size_t number_of_calo_signals = static_cast<std::size_t>(random_generator.uniform() * 8);
+	for (std::size_t i = 0; i < number_of_calo_signals; i++)
+	  {
+	    geomtools::geom_id a_calo_gid(snemo::digitization::mapping::CALO_MAIN_WALL_CATEGORY_TYPE,
+					  snemo::digitization::mapping::DEMONSTRATOR_MODULE_NUMBER,
+					  static_cast<uint32_t>(random_generator.uniform() * snemo::digitization::mapping::NUMBER_OF_SIDES),
+					  static_cast<uint32_t>(random_generator.uniform() * snemo::digitization::mapping::NUMBER_OF_MAIN_CALO_COLUMNS),
+					  static_cast<uint32_t>(random_generator.uniform() * snemo::digitization::mapping::NUMBER_OF_MAIN_CALO_ROWS));
+	    a_calo_gid.set_depth(5);
+	    a_calo_gid.set_any(4);
+	    snemo::digitization::calo_signal & a_calo_signal = event_signal_data.add_calo_signal();
+	    a_calo_signal.set_header(i, a_calo_gid);
+	    a_calo_signal.set_data(random_generator.flat(0.0, 200.0) * CLHEP::nanosecond,
+				   random_generator.flat(0.0, 3 * snemo::digitization::calo_tp::HIGH_THRESHOLD));
+	  }
+
+	snemo::digitization::signal_columns event_signal_columns;
+	event_signal_columns.import_signal_data(event_signal_data);
+
+	snemo::digitization::geiger_tp_data handle_geiger_tp_data;
+	snemo::digitization::geiger_tp_data column_geiger_tp_data;
+	signal_2_geiger_tp.process(event_signal_data, handle_geiger_tp_data);
+	signal_2_geiger_tp.process(event_signal_columns, column_geiger_tp_data);
+	DT_THROW_IF(handle_geiger_tp_data.get_geiger_tps().size() != column_geiger_tp_data.get_geiger_tps().size(),
+		    std::logic_error, "Event #" << ievent << " : columnar path gives " << column_geiger_tp_data.get_geiger_tps().size()
+		    << " Geiger TPs instead of " << handle_geiger_tp_data.get_geiger_tps().size() << " ! ");
+	for (std::size_t i = 0; i < handle_geiger_tp_data.get_geiger_tps().size(); i++)
+	  {
+	    const snemo::digitization::geiger_tp & a_handle_tp = handle_geiger_tp_data.get_geiger_tps()[i].get();
+	    const snemo::digitization::geiger_tp & a_column_tp = column_geiger_tp_data.get_geiger_tps()[i].get();
+	    DT_THROW_IF(a_handle_tp.get_hit_id() != a_column_tp.get_hit_id()
+			|| a_handle_tp.get_geom_id() != a_column_tp.get_geom_id()
+			|| a_handle_tp.get_clocktick_800ns() != a_column_tp.get_clocktick_800ns()
+			|| a_handle_tp.get_gg_bitset() != a_column_tp.get_gg_bitset(),
+			std::logic_error, "Event #" << ievent << " : Geiger TP #" << i << " of the columnar path differs ! ");
+	  }
+	number_of_geiger_tps += handle_geiger_tp_data.get_geiger_tps().size();
+
+	snemo::digitization::calo_tp_data handle_calo_tp_data;
+	snemo::digitization::calo_tp_data column_calo_tp_data;
+	signal_2_calo_tp.process(event_signal_data, handle_calo_tp_data);
+	signal_2_calo_tp.process(event_signal_columns, column_calo_tp_data);
+	DT_THROW_IF(handle_calo_tp_data.get_calo_tps().size() != column_calo_tp_data.get_calo_tps().size(),
+		    std::logic_error, "Event #" << ievent << " : columnar path gives " << column_calo_tp_data.get_calo_tps().size()
+		    << " calorimeter TPs instead of " << handle_calo_tp_data.get_calo_tps().size() << " ! ");
+	for (std::size_t i = 0; i < handle_calo_tp_data.get_calo_tps().size(); i++)
+	  {
+	    const snemo::digitization::calo_tp & a_handle_tp = handle_calo_tp_data.get_calo_tps()[i].get();
+	    const snemo::digitization::calo_tp & a_column_tp = column_calo_tp_data.get_calo_tps()[i].get();
+	    DT_THROW_IF(a_handle_tp.get_hit_id() != a_column_tp.get_hit_id()
+			|| a_handle_tp.get_geom_id() != a_column_tp.get_geom_id()
+			|| a_handle_tp.get_clocktick_25ns() != a_column_tp.get_clocktick_25ns()
+			|| a_handle_tp.get_tp_bitset() != a_column_tp.get_tp_bitset(),
+			std::logic_error, "Event #" << ievent << " : calorimeter TP #" << i << " of the columnar path differs ! ");
+	  }
+	number_of_calo_tps += handle_calo_tp_data.get_calo_tps().size();
+      }
+    std::clog << "Same TPs on both paths : " << number_of_geiger_tps << " Geiger TPs, " << number_of_calo_tps << " calorimeter TPs" << std::endl;
+    DT_THROW_IF(number_of_geiger_tps == 0 || number_of_calo_tps == 0, std::logic_error, "No TP to compare ! ");
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
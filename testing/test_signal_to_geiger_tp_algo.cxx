@@ -69,8 +69,10 @@ int main( int  argc_ , char ** argv_ )
     my_e_mapping.add_preconstructed_type(snemo::digitization::mapping::GEIGER_CATEGORY_TYPE);
     my_e_mapping.initialize();
 
+    datatools::properties signal_2_geiger_tp_config;
+    signal_2_geiger_tp_config.store("propagate_auxiliaries", true);
     snemo::digitization::signal_to_geiger_tp_algo signal_2_geiger_tp;
-    signal_2_geiger_tp.initialize(my_e_mapping);
+    signal_2_geiger_tp.initialize(my_e_mapping, signal_2_geiger_tp_config);
     signal_2_geiger_tp.set_clocktick_reference(clocktick_800_reference);
     signal_2_geiger_tp.set_clocktick_shift(clocktick_800_shift);
 
@@ -102,6 +104,7 @@ int main( int  argc_ , char ** argv_ )
       {
 	signal_2_geiger_tp.process(signal_data, my_geiger_tp_data);
 	my_geiger_tp_data.tree_dump(std::clog, "Geiger TP(s) data : ", "INFO : ");
+	my_geiger_tp_data.get_geiger_tps()[0].get().tree_dump(std::clog, "First geiger TP (with auxiliaries) : ", "INFO : ");
       }
 
     std::clog << "The end." << std::endl;
@@ -0,0 +1,135 @@
+//test_small_bitset.cxx
+
+// Standard libraries :
+#include <iostream>
+#include <sstream>
+#include <bitset>
+#include <random>
+#include <cstring>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/small_bitset.h>
+#include <snemo/digitization/trigger_structures.h>
+
+/// Check a small bitset against a std::bitset
+template <std::size_t Size>
+void check_same_bits(const snemo::digitization::small_bitset<Size> & small_, const std::bitset<Size> & reference_, const std::string & operation_)
+{
+  std::ostringstream small_oss;
+  std::ostringstream reference_oss;
+  small_oss << small_;
+  reference_oss << reference_;
+  DT_THROW_IF(small_.to_ulong() != reference_.to_ulong() || small_.count() != reference_.count() || small_.any() != reference_.any()
+	      || small_oss.str() != reference_oss.str(), std::logic_error,
+	      "Small bitset " << small_ << " differs from the std::bitset " << reference_ << " after '" << operation_ << "' ! ");
+  for (std::size_t i = 0; i < Size; i++)
+    {
+      DT_THROW_IF(small_[i] != reference_[i] || small_.test(i) != reference_.test(i), std::logic_error, "Bit #" << i << " differs after '" << operation_ << "' ! ");
+    }
+  return;
+}
+
+/// Apply the same random operations to a small bitset and a std::bitset
+template <std::size_t Size>
+void check_operations(std::mt19937 & generator_)
+{
+  std::uniform_int_distribution<unsigned long long> value_distribution;
+  std::uniform_int_distribution<std::size_t> pos_distribution(0, Size - 1);
+  for (unsigned int i = 0; i < 10000; i++)
+    {
+      const unsigned long long value_a = value_distribution(generator_);
+      const unsigned long long value_b = value_distribution(generator_);
+      const std::size_t pos = pos_distribution(generator_);
+      const std::bitset<Size> reference_a(value_a);
+      const std::bitset<Size> reference_b(value_b);
+      const snemo::digitization::small_bitset<Size> small_a(value_a);
+      const snemo::digitization::small_bitset<Size> small_b = reference_b;
+      check_same_bits(small_a, reference_a, "construct");
+      check_same_bits(small_b, reference_b, "convert");
+      DT_THROW_IF((small_a == small_b) != (reference_a == reference_b), std::logic_error, "Wrong equality ! ");
+      check_same_bits(small_a & small_b, reference_a & reference_b, "and");
+      check_same_bits(small_a | small_b, reference_a | reference_b, "or");
+      check_same_bits(small_a ^ small_b, reference_a ^ reference_b, "xor");
+      check_same_bits(~small_a, ~reference_a, "not");
+      check_same_bits(small_a << pos, reference_a << pos, "shift left");
+      check_same_bits(small_a >> pos, reference_a >> pos, "shift right");
+      snemo::digitization::small_bitset<Size> small_c = small_a;
+      std::bitset<Size> reference_c = reference_a;
+      small_c[pos] = small_b[pos];
+      reference_c[pos] = reference_b[pos];
+      check_same_bits(small_c, reference_c, "bit reference");
+      small_c.flip(pos).set(0, false);
+      reference_c.flip(pos).set(0, false);
+      check_same_bits(small_c, reference_c, "flip and set");
+      const std::bitset<Size> converted = small_c;
+      DT_THROW_IF(converted != reference_c, std::logic_error, "Wrong conversion to std::bitset ! ");
+    }
+  snemo::digitization::small_bitset<Size> all_bits;
+  DT_THROW_IF(!all_bits.none() || !all_bits.set().all() || all_bits.count() != Size, std::logic_error, "Wrong set of all the bits ! ");
+  bool out_of_range = false;
+  try {
+    all_bits.test(Size);
+  } catch (std::out_of_range &) {
+    out_of_range = true;
+  }
+  DT_THROW_IF(!out_of_range, std::logic_error, "No out of range error for the bit #" << Size << " ! ");
+  return;
+}
+
+int main( int  argc_ , char ** argv_  )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+  try {
+    std::clog << "Test program for class 'snemo::digitization::small_bitset' !" << std::endl;
+
+    std::mt19937 generator(314159);
+    check_operations<2>(generator);
+    check_operations<3>(generator);
+    check_operations<7>(generator);
+    check_operations<8>(generator);
+    check_operations<10>(generator);
+    check_operations<16>(generator);
+    check_operations<31>(generator);
+    check_operations<64>(generator);
+
+    typedef snemo::digitization::trigger_structures trigger_structures;
+    std::clog << "Size of the tracker record : " << sizeof(trigger_structures::tracker_record) << " bytes" << std::endl;
+    std::clog << "Size of the coincidence event record : " << sizeof(trigger_structures::coincidence_event_record) << " bytes" << std::endl;
+    std::clog << "Size of the previous event record : " << sizeof(trigger_structures::previous_event_record) << " bytes" << std::endl;
+
+    // The records keep their values through a raw copy :
+    trigger_structures::previous_event_record a_record;
+    a_record.tracker_finale_data_per_zone[1][9].set(trigger_structures::tracker_record::FINALE_DATA_BIT_NSZ_LEFT);
+    a_record.update_tracker_zone_masks();
+    a_record.LTO_gveto = true;
+    a_record.trigger_mode = trigger_structures::APE;
+    trigger_structures::previous_event_record a_copy;
+    std::memcpy(&a_copy, &a_record, sizeof(a_record));
+    DT_THROW_IF(!a_copy.tracker_zone_masks[1][trigger_structures::tracker_record::FINALE_DATA_BIT_NSZ_LEFT].test(9)
+		|| !a_copy.LTO_gveto || a_copy.decision || a_copy.trigger_mode != trigger_structures::APE, std::logic_error, "Wrong copy of the previous event record ! ");
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
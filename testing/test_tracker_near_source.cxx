@@ -0,0 +1,159 @@
+// test_tracker_near_source.cxx
+// Standard libraries :
+#include <iostream>
+#include <vector>
+#include <random>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/mapping.h>
+#include <snemo/digitization/tracker_zone.h>
+#include <snemo/digitization/tracker_trigger_algorithm.h>
+
+typedef snemo::digitization::trigger_info trigger_info;
+
+/// Geiger matrix of a test case
+struct test_matrix
+{
+  bool cells[trigger_info::NSIDES][trigger_info::NLAYERS][trigger_info::NROWS];
+};
+
+/// Compare the near source bits of all the zones with the reference cell by cell implementation
+void check_near_source(snemo::digitization::tracker_trigger_algorithm & tracker_algo_,
+		       const test_matrix & matrix_,
+		       std::size_t & number_of_near_source_bits_)
+{
+  std::vector<geomtools::geom_id> hit_cells_gids;
+  for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+    for (unsigned int ilayer = 0; ilayer < trigger_info::NLAYERS; ilayer++)
+      for (unsigned int irow = 0; irow < trigger_info::NROWS; irow++)
+	{
+	  if (matrix_.cells[iside][ilayer][irow])
+	    {
+	      hit_cells_gids.push_back(geomtools::geom_id(snemo::digitization::mapping::GEIGER_CATEGORY_TYPE,
+							  snemo::digitization::mapping::DEMONSTRATOR_MODULE_NUMBER,
+							  iside, ilayer, irow));
+	    }
+	}
+
+  tracker_algo_.reset_matrix();
+  tracker_algo_.reset_zones_informations();
+  tracker_algo_.fill_matrix(hit_cells_gids);
+  tracker_algo_.build_near_source_patterns();
+  snemo::digitization::trigger_structures::tracker_record a_tracker_record;
+  tracker_algo_.build_tracker_record(a_tracker_record);
+
+  for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+    for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
+      {
+	snemo::digitization::tracker_zone reference_zone;
+	reference_zone.side = iside;
+	reference_zone.zone_id = izone;
+	const unsigned int start_row = snemo::digitization::tracker_zone::start_row(izone);
+	for (unsigned int ilayer = 0; ilayer < trigger_info::NLAYERS; ilayer++)
+	  for (unsigned int irow = 0; irow < snemo::digitization::tracker_zone::width(izone); irow++)
+	    {
+	      reference_zone.cells[ilayer][irow] = matrix_.cells[iside][ilayer][start_row + irow];
+	    }
+	tracker_algo_.build_near_source_pattern(reference_zone);
+
+	const bool left  = a_tracker_record.finale_data_per_zone[iside][izone][snemo::digitization::trigger_structures::tracker_record::FINALE_DATA_BIT_NSZ_LEFT];
+	const bool right = a_tracker_record.finale_data_per_zone[iside][izone][snemo::digitization::trigger_structures::tracker_record::FINALE_DATA_BIT_NSZ_RIGHT];
+	DT_THROW_IF(left != reference_zone.data_near_source.test(snemo::digitization::tracker_zone::DATA_NEAR_SOURCE_BIT_LEFT)
+		    || right != reference_zone.data_near_source.test(snemo::digitization::tracker_zone::DATA_NEAR_SOURCE_BIT_RIGHT),
+		    std::logic_error, "Near source bits of the zone [" << iside << "." << izone << "] differ from the reference ! ");
+	if (left) number_of_near_source_bits_++;
+	if (right) number_of_near_source_bits_++;
+      }
+  return;
+}
+
+int main( int  argc_ , char **argv_  )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for the near source patterns of class 'snemo::digitization::tracker_trigger_algorithm' !" << std::endl;
+
+    // The near source patterns do not use the memories, the algorithm is not initialized :
+    snemo::digitization::tracker_trigger_algorithm my_tracker_algo;
+    std::size_t number_of_matrices = 0;
+    std::size_t number_of_near_source_bits = 0;
+
+    // All the rows patterns of each zone, the near source layers being spread over layers 0 to 3.
+    // The complementary pattern is on the other side and far layers cells are added on the next zone :
+    for (unsigned int izone = 0; izone < trigger_info::NZONES; izone++)
+      {
+	const unsigned int start_row = snemo::digitization::tracker_zone::start_row(izone);
+	const unsigned int width = snemo::digitization::tracker_zone::width(izone);
+	const unsigned int next_start_row = snemo::digitization::tracker_zone::start_row((izone + 1) % trigger_info::NZONES);
+	const unsigned int next_width = snemo::digitization::tracker_zone::width((izone + 1) % trigger_info::NZONES);
+	for (uint32_t pattern = 0; pattern < ((uint32_t) 1 << width); pattern++)
+	  {
+	    test_matrix a_matrix = {};
+	    for (unsigned int irow = 0; irow < width; irow++)
+	      {
+		const unsigned int near_layer = (irow + pattern) % trigger_info::NUMBER_OF_LAYERS_HIT_FOR_NEAR_SOURCE_BIT;
+		const unsigned int far_layer = trigger_info::NUMBER_OF_LAYERS_HIT_FOR_NEAR_SOURCE_BIT + (irow + pattern) % (trigger_info::NLAYERS - trigger_info::NUMBER_OF_LAYERS_HIT_FOR_NEAR_SOURCE_BIT);
+		const bool hit = (pattern >> irow) & 1;
+		a_matrix.cells[0][hit ? near_layer : far_layer][start_row + irow] = true;
+		a_matrix.cells[1][hit ? far_layer : near_layer][start_row + irow] = true;
+	      }
+	    for (unsigned int irow = 0; irow < next_width; irow++)
+	      {
+		if ((pattern >> (irow % width)) & 1) a_matrix.cells[irow % trigger_info::NSIDES][trigger_info::NLAYERS - 1][next_start_row + irow] = true;
+	      }
+	    check_near_source(my_tracker_algo, a_matrix, number_of_near_source_bits);
+	    number_of_matrices++;
+	  }
+      }
+
+    // Random Geiger matrices with several cells densities :
+    std::mt19937 generator(314159);
+    const double densities[4] = {0.002, 0.01, 0.05, 0.2};
+    for (unsigned int idensity = 0; idensity < 4; idensity++)
+      {
+	std::bernoulli_distribution hit_distribution(densities[idensity]);
+	for (unsigned int imatrix = 0; imatrix < 2000; imatrix++)
+	  {
+	    test_matrix a_matrix = {};
+	    for (unsigned int iside = 0; iside < trigger_info::NSIDES; iside++)
+	      for (unsigned int ilayer = 0; ilayer < trigger_info::NLAYERS; ilayer++)
+		for (unsigned int irow = 0; irow < trigger_info::NROWS; irow++)
+		  {
+		    a_matrix.cells[iside][ilayer][irow] = hit_distribution(generator);
+		  }
+	    check_near_source(my_tracker_algo, a_matrix, number_of_near_source_bits);
+	    number_of_matrices++;
+	  }
+      }
+
+    std::clog << "Geiger matrices : " << number_of_matrices << ", near source bits : " << number_of_near_source_bits << std::endl;
+    DT_THROW_IF(number_of_near_source_bits == 0, std::logic_error, "No near source bit ! ");
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
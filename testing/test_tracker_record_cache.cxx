@@ -0,0 +1,177 @@
+// test_tracker_record_cache.cxx
+// Standard libraries :
+#include <iostream>
+#include <map>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+#include <datatools/properties.h>
+// - Bayeux/geomtools:
+#include <geomtools/manager.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/mapping.h>
+#include <snemo/digitization/electronic_mapping.h>
+#include <snemo/digitization/ctw_generator.h>
+#include <snemo/digitization/tracker_trigger_algorithm.h>
+
+/// Check that two tracker records are identical
+bool same_tracker_records(const snemo::digitization::trigger_structures::tracker_record & record_a_,
+			  const snemo::digitization::trigger_structures::tracker_record & record_b_)
+{
+  if (record_a_.clocktick_1600ns != record_b_.clocktick_1600ns
+      || record_a_.single_side_coinc != record_b_.single_side_coinc
+      || record_a_.finale_decision != record_b_.finale_decision) return false;
+  for (unsigned int iside = 0; iside < snemo::digitization::trigger_info::NSIDES; iside++)
+    {
+      if (record_a_.zoning_word_pattern[iside] != record_b_.zoning_word_pattern[iside]
+	  || record_a_.zoning_word_near_source[iside] != record_b_.zoning_word_near_source[iside]) return false;
+      for (unsigned int izone = 0; izone < snemo::digitization::trigger_info::NZONES; izone++)
+	{
+	  if (record_a_.finale_data_per_zone[iside][izone] != record_b_.finale_data_per_zone[iside][izone]) return false;
+	}
+      for (unsigned int ibit = 0; ibit < snemo::digitization::trigger_info::DATA_FULL_BITSET_SIZE; ibit++)
+	{
+	  if (record_a_.zone_masks[iside][ibit] != record_b_.zone_masks[iside][ibit]) return false;
+	}
+    }
+  return true;
+}
+
+int main( int  argc_ , char **argv_  )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for the tracker record cache of class 'snemo::digitization::tracker_trigger_algorithm' !" << std::endl;
+
+    std::string manager_config_file;
+    manager_config_file = "@falaise:config/snemo/demonstrator/geometry/4.0/manager.conf";
+    datatools::fetch_path_with_env(manager_config_file);
+    datatools::properties manager_config;
+    datatools::properties::read_config (manager_config_file,
+					manager_config);
+    geomtools::manager my_manager;
+    manager_config.update ("build_mapping", true);
+    if (manager_config.has_key ("mapping.excluded_categories"))
+      {
+	manager_config.erase ("mapping.excluded_categories");
+      }
+    my_manager.initialize (manager_config);
+
+    // Electronic mapping :
+    snemo::digitization::electronic_mapping my_e_mapping;
+    my_e_mapping.set_geo_manager(my_manager);
+    my_e_mapping.set_module_number(snemo::digitization::mapping::DEMONSTRATOR_MODULE_NUMBER);
+    my_e_mapping.add_preconstructed_type(snemo::digitization::mapping::GEIGER_CATEGORY_TYPE);
+    my_e_mapping.add_preconstructed_type(snemo::digitization::mapping::CALO_MAIN_WALL_CATEGORY_TYPE);
+    my_e_mapping.initialize();
+
+    // Tracker algorithms without cache, with the default cache and with a single entry cache :
+    datatools::properties tracker_config;
+    for (unsigned int imem = 1; imem <= 5; imem++)
+      {
+	std::string mem_file = "${FALAISE_DIGITIZATION_TESTING_DIR}/config/trigger/tracker/mem" + std::to_string(imem) + ".conf";
+	datatools::fetch_path_with_env(mem_file);
+	tracker_config.store("mem" + std::to_string(imem) + "_file", mem_file);
+      }
+    const unsigned int number_of_algos = 3;
+    const int cache_sizes[number_of_algos] = {0, -1, 1};
+    snemo::digitization::tracker_trigger_algorithm my_tracker_algos[number_of_algos];
+    for (unsigned int ialgo = 0; ialgo < number_of_algos; ialgo++)
+      {
+	datatools::properties algo_config = tracker_config;
+	if (cache_sizes[ialgo] >= 0) algo_config.store("tracker_record_cache_size", cache_sizes[ialgo]);
+	my_tracker_algos[ialgo].set_electronic_mapping(my_e_mapping);
+	my_tracker_algos[ialgo].initialize(algo_config);
+      }
+    DT_THROW_IF(my_tracker_algos[1].get_cache_size() != snemo::digitization::tracker_trigger_algorithm::DEFAULT_CACHE_SIZE,
+		std::logic_error, "Wrong default cache size ! ");
+
+    // Events with two tracks, delayed alphas and Geiger noise :
+    snemo::digitization::ctw_generator my_generator;
+    my_generator.set_seed(161803);
+    my_generator.set_number_of_tracks(2);
+    my_generator.set_delayed_alpha_probability(0.5);
+    my_generator.set_alpha_mean_delay(20 * CLHEP::microsecond);
+    my_generator.set_geiger_noise_rate(100 * CLHEP::hertz);
+    my_generator.initialize_simple();
+    std::size_t number_of_clockticks = 0;
+    for (std::size_t ievent = 0; ievent < 100; ievent++)
+      {
+	snemo::digitization::calo_ctw_data calo_ctws;
+	snemo::digitization::geiger_ctw_data geiger_ctws;
+	my_generator.generate(ievent, calo_ctws, geiger_ctws);
+	// Even clockticks 800 ns are transferred to the trigger board :
+	std::map<uint32_t, snemo::digitization::geiger_ctw_data::geiger_ctw_collection_type> geiger_ctw_lists;
+	for (std::size_t i = 0; i < geiger_ctws.get_geiger_ctws().size(); i++)
+	  {
+	    const snemo::digitization::geiger_ctw & a_gg_ctw = geiger_ctws.get_geiger_ctws()[i].get();
+	    if (a_gg_ctw.get_clocktick_800ns() % 2 == 0 && a_gg_ctw.has_trigger_primitive_values())
+	      {
+		geiger_ctw_lists[a_gg_ctw.get_clocktick_800ns()].push_back(geiger_ctws.get_geiger_ctws()[i]);
+	      }
+	  }
+	std::map<uint32_t, snemo::digitization::geiger_ctw_data::geiger_ctw_collection_type>::const_iterator it_list = geiger_ctw_lists.begin();
+	for (; it_list != geiger_ctw_lists.end(); it_list++)
+	  {
+	    snemo::digitization::trigger_structures::tracker_record tracker_records[number_of_algos];
+	    for (unsigned int ialgo = 0; ialgo < number_of_algos; ialgo++)
+	      {
+		tracker_records[ialgo].clocktick_1600ns = it_list->first / 2 + 1;
+		my_tracker_algos[ialgo].process(it_list->second, tracker_records[ialgo]);
+	      }
+	    for (unsigned int ialgo = 1; ialgo < number_of_algos; ialgo++)
+	      {
+		DT_THROW_IF(!same_tracker_records(tracker_records[0], tracker_records[ialgo]),
+			    std::logic_error, "Tracker record of clocktick " << it_list->first << " differs with the cache #" << ialgo << " ! ");
+	      }
+	    number_of_clockticks++;
+	  }
+      }
+
+    for (unsigned int ialgo = 0; ialgo < number_of_algos; ialgo++)
+      {
+	std::clog << "Cache size " << my_tracker_algos[ialgo].get_cache_size() << " : "
+		  << my_tracker_algos[ialgo].get_cache_hits() << " hit(s), "
+		  << my_tracker_algos[ialgo].get_cache_misses() << " miss(es)" << std::endl;
+      }
+    DT_THROW_IF(my_tracker_algos[0].get_cache_hits() != 0 || my_tracker_algos[0].get_cache_misses() != 0,
+		std::logic_error, "Disabled cache is used ! ");
+    for (unsigned int ialgo = 1; ialgo < number_of_algos; ialgo++)
+      {
+	DT_THROW_IF(my_tracker_algos[ialgo].get_cache_hits() + my_tracker_algos[ialgo].get_cache_misses() != number_of_clockticks,
+		    std::logic_error, "Wrong number of cache lookups for the cache #" << ialgo << " ! ");
+	DT_THROW_IF(my_tracker_algos[ialgo].get_cache_hits() == 0, std::logic_error, "No cache hit for the cache #" << ialgo << " ! ");
+      }
+    DT_THROW_IF(my_tracker_algos[1].get_cache_hits() < my_tracker_algos[2].get_cache_hits(),
+		std::logic_error, "Larger cache has less hits ! ");
+
+    my_tracker_algos[1].clear_cache();
+    DT_THROW_IF(my_tracker_algos[1].get_cache_hits() != 0 || my_tracker_algos[1].get_cache_misses() != 0,
+		std::logic_error, "Cache counters are not cleared ! ");
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
@@ -0,0 +1,253 @@
+// test_trigger_algorithm_stream.cxx
+// Standard libraries :
+#include <iostream>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+#include <datatools/multi_properties.h>
+// - Bayeux/geomtools:
+#include <geomtools/manager.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/clock_utils.h>
+#include <snemo/digitization/mapping.h>
+#include <snemo/digitization/electronic_mapping.h>
+#include <snemo/digitization/ctw_generator.h>
+#include <snemo/digitization/trigger_algorithm.h>
+
+/// Copy the CTWs of an event shifted by a number of clockticks 800 ns (32 bits arithmetic)
+void shift_event(const snemo::digitization::calo_ctw_data & calo_ctw_data_,
+		 const snemo::digitization::geiger_ctw_data & geiger_ctw_data_,
+		 uint32_t shift_800_,
+		 snemo::digitization::calo_ctw_data & shifted_calo_ctw_data_,
+		 snemo::digitization::geiger_ctw_data & shifted_geiger_ctw_data_)
+{
+  const uint32_t shift_25 = shift_800_ * (snemo::digitization::clock_utils::TRACKER_CLOCKTICK / snemo::digitization::clock_utils::MAIN_CLOCKTICK);
+  for (std::size_t i = 0; i < calo_ctw_data_.get_calo_ctws().size(); i++)
+    {
+      snemo::digitization::calo_ctw & a_calo_ctw = shifted_calo_ctw_data_.add();
+      a_calo_ctw = calo_ctw_data_.get_calo_ctws()[i].get();
+      a_calo_ctw.set_clocktick_25ns(a_calo_ctw.get_clocktick_25ns() + shift_25);
+    }
+  for (std::size_t i = 0; i < geiger_ctw_data_.get_geiger_ctws().size(); i++)
+    {
+      snemo::digitization::geiger_ctw & a_geiger_ctw = shifted_geiger_ctw_data_.add();
+      a_geiger_ctw = geiger_ctw_data_.get_geiger_ctws()[i].get();
+      a_geiger_ctw.set_clocktick_800ns(a_geiger_ctw.get_clocktick_800ns() + shift_800_);
+    }
+  return;
+}
+
+/// Run the trigger in stream mode on events spaced by a number of clockticks 800 ns
+void run_stream(snemo::digitization::trigger_algorithm & trigger_algo_,
+		snemo::digitization::ctw_generator & generator_,
+		std::size_t number_of_events_,
+		uint32_t first_800_,
+		uint32_t spacing_800_,
+		std::vector<snemo::digitization::trigger_structures::L1_calo_decision> & L1_decisions_,
+		std::vector<snemo::digitization::trigger_structures::L2_decision> & L2_decisions_,
+		std::size_t & max_backlog_size_)
+{
+  max_backlog_size_ = 0;
+  trigger_algo_.start_stream();
+  for (std::size_t ievent = 0; ievent < number_of_events_; ievent++)
+    {
+      snemo::digitization::calo_ctw_data calo_ctws, shifted_calo_ctws;
+      snemo::digitization::geiger_ctw_data geiger_ctws, shifted_geiger_ctws;
+      generator_.generate(ievent, calo_ctws, geiger_ctws);
+      const uint32_t event_800 = first_800_ + ievent * spacing_800_;
+      shift_event(calo_ctws, geiger_ctws, event_800, shifted_calo_ctws, shifted_geiger_ctws);
+      trigger_algo_.push_stream(shifted_calo_ctws, shifted_geiger_ctws);
+      // All the CTWs before the event are pushed :
+      trigger_algo_.advance_stream(event_800 / 2);
+      if (trigger_algo_.get_stream_backlog_size() > max_backlog_size_) max_backlog_size_ = trigger_algo_.get_stream_backlog_size();
+      while (trigger_algo_.has_stream_L1_calo_decision()) L1_decisions_.push_back(trigger_algo_.pop_stream_L1_calo_decision());
+      while (trigger_algo_.has_stream_L2_decision()) L2_decisions_.push_back(trigger_algo_.pop_stream_L2_decision());
+    }
+  trigger_algo_.flush_stream();
+  while (trigger_algo_.has_stream_L1_calo_decision()) L1_decisions_.push_back(trigger_algo_.pop_stream_L1_calo_decision());
+  while (trigger_algo_.has_stream_L2_decision()) L2_decisions_.push_back(trigger_algo_.pop_stream_L2_decision());
+  trigger_algo_.stop_stream();
+  return;
+}
+
+int main( int  argc_ , char **argv_  )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for the stream mode of class 'snemo::digitization::trigger_algorithm' !" << std::endl;
+
+    std::string manager_config_file;
+    manager_config_file = "@falaise:config/snemo/demonstrator/geometry/4.0/manager.conf";
+    datatools::fetch_path_with_env(manager_config_file);
+    datatools::properties manager_config;
+    datatools::properties::read_config (manager_config_file,
+					manager_config);
+    geomtools::manager my_manager;
+    manager_config.update ("build_mapping", true);
+    if (manager_config.has_key ("mapping.excluded_categories"))
+      {
+	manager_config.erase ("mapping.excluded_categories");
+      }
+    my_manager.initialize (manager_config);
+
+    // Electronic mapping :
+    snemo::digitization::electronic_mapping my_e_mapping;
+    my_e_mapping.set_geo_manager(my_manager);
+    my_e_mapping.set_module_number(snemo::digitization::mapping::DEMONSTRATOR_MODULE_NUMBER);
+    my_e_mapping.add_preconstructed_type(snemo::digitization::mapping::GEIGER_CATEGORY_TYPE);
+    my_e_mapping.add_preconstructed_type(snemo::digitization::mapping::CALO_MAIN_WALL_CATEGORY_TYPE);
+    my_e_mapping.initialize();
+    // Clock manager :
+    snemo::digitization::clock_utils my_clock_manager;
+    my_clock_manager.initialize();
+
+    // Properties to configure trigger algorithm :
+    datatools::multi_properties trigger_config;
+    trigger_config.add("general", "trigger_component");
+    datatools::multi_properties::entry & gen_entry = trigger_config.grab("general");
+    gen_entry.grab_properties().store("coincidence_calorimeter_gate_size", 5);
+    gen_entry.grab_properties().store("L2_decision_coincidence_gate_size", 5);
+    gen_entry.grab_properties().store("previous_event_buffer_depth", 10);
+    gen_entry.grab_properties().store("activate_any_coincidences", true);
+    trigger_config.add("calorimeter", "trigger_component");
+    datatools::multi_properties::entry & cal_entry = trigger_config.grab("calorimeter");
+    cal_entry.grab_properties().store("circular_buffer_depth", 4);
+    cal_entry.grab_properties().store("total_multiplicity_threshold", 1);
+    cal_entry.grab_properties().store("inhibit_both_side", false);
+    cal_entry.grab_properties().store("inhibit_single_side", false);
+    trigger_config.add("tracker", "trigger_component");
+    datatools::multi_properties::entry & tra_entry = trigger_config.grab("tracker");
+    for (unsigned int imem = 1; imem <= 5; imem++)
+      {
+	std::string mem_file = "${FALAISE_DIGITIZATION_TESTING_DIR}/config/trigger/tracker/mem" + std::to_string(imem) + ".conf";
+	datatools::fetch_path_with_env(mem_file);
+	tra_entry.grab_properties().store("mem" + std::to_string(imem) + "_file", mem_file);
+      }
+    trigger_config.add("coincidence", "trigger_component");
+
+    snemo::digitization::trigger_algorithm my_trigger_algo;
+    my_trigger_algo.set_electronic_mapping(my_e_mapping);
+    my_trigger_algo.set_clock_manager(my_clock_manager);
+    my_trigger_algo.initialize(trigger_config);
+
+    // Overlapping events with delayed alphas and Geiger noise :
+    snemo::digitization::ctw_generator my_generator;
+    my_generator.set_seed(314159);
+    my_generator.set_delayed_alpha_probability(0.5);
+    my_generator.set_geiger_noise_rate(50 * CLHEP::hertz);
+    my_generator.initialize_simple();
+    const std::size_t number_of_events = 50;
+    const uint32_t first_800 = 1000;
+    const uint32_t spacing_800 = 300;
+
+    // Reference : the concatenated events processed in event mode
+    snemo::digitization::calo_ctw_data all_calo_ctws;
+    snemo::digitization::geiger_ctw_data all_geiger_ctws;
+    for (std::size_t ievent = 0; ievent < number_of_events; ievent++)
+      {
+	snemo::digitization::calo_ctw_data calo_ctws;
+	snemo::digitization::geiger_ctw_data geiger_ctws;
+	my_generator.generate(ievent, calo_ctws, geiger_ctws);
+	shift_event(calo_ctws, geiger_ctws, first_800 + ievent * spacing_800, all_calo_ctws, all_geiger_ctws);
+      }
+    my_trigger_algo.process(all_calo_ctws, all_geiger_ctws);
+    const std::vector<snemo::digitization::trigger_structures::L1_calo_decision> event_L1_decisions = my_trigger_algo.get_L1_calo_decision_records_vector();
+    const std::vector<snemo::digitization::trigger_structures::L2_decision> event_L2_decisions = my_trigger_algo.get_L2_decision_records_vector();
+    std::clog << "Event mode : " << event_L1_decisions.size() << " L1 calo decision(s), " << event_L2_decisions.size() << " L2 decision(s)" << std::endl;
+    DT_THROW_IF(event_L1_decisions.empty() || event_L2_decisions.empty(), std::logic_error, "No trigger decision in event mode ! ");
+
+    // Stream mode, bit exact with the event mode :
+    std::vector<snemo::digitization::trigger_structures::L1_calo_decision> stream_L1_decisions;
+    std::vector<snemo::digitization::trigger_structures::L2_decision> stream_L2_decisions;
+    std::size_t max_backlog_size = 0;
+    run_stream(my_trigger_algo, my_generator, number_of_events, first_800, spacing_800, stream_L1_decisions, stream_L2_decisions, max_backlog_size);
+    std::clog << "Stream mode : " << stream_L1_decisions.size() << " L1 calo decision(s), " << stream_L2_decisions.size() << " L2 decision(s), maximum backlog = " << max_backlog_size << std::endl;
+    DT_THROW_IF(stream_L1_decisions.size() != event_L1_decisions.size(), std::logic_error, "Wrong number of L1 calo decisions in stream mode ! ");
+    DT_THROW_IF(stream_L2_decisions.size() != event_L2_decisions.size(), std::logic_error, "Wrong number of L2 decisions in stream mode ! ");
+    for (std::size_t i = 0; i < event_L1_decisions.size(); i++)
+      {
+	DT_THROW_IF(stream_L1_decisions[i].L1_calo_ct_decision != event_L1_decisions[i].L1_calo_ct_decision,
+		    std::logic_error, "L1 calo decision #" << i << " differs in stream mode ! ");
+      }
+    for (std::size_t i = 0; i < event_L2_decisions.size(); i++)
+      {
+	DT_THROW_IF(stream_L2_decisions[i].L2_ct_decision != event_L2_decisions[i].L2_ct_decision
+		    || stream_L2_decisions[i].L2_trigger_mode != event_L2_decisions[i].L2_trigger_mode,
+		    std::logic_error, "L2 decision #" << i << " differs in stream mode ! ");
+      }
+    // The stream only keeps the CTWs and records of a few events :
+    DT_THROW_IF(max_backlog_size > (all_calo_ctws.get_calo_ctws().size() + all_geiger_ctws.get_geiger_ctws().size()) / 10,
+		std::logic_error, "Stream backlog is not bounded ! ");
+
+    // Same events across the wrap of the 32 bits clockticks 25 ns :
+    const uint32_t wrap_first_800 = (1u << 27) - first_800;
+    std::vector<snemo::digitization::trigger_structures::L1_calo_decision> wrap_L1_decisions;
+    std::vector<snemo::digitization::trigger_structures::L2_decision> wrap_L2_decisions;
+    run_stream(my_trigger_algo, my_generator, number_of_events, wrap_first_800, spacing_800, wrap_L1_decisions, wrap_L2_decisions, max_backlog_size);
+    DT_THROW_IF(wrap_L1_decisions.size() != stream_L1_decisions.size() || wrap_L2_decisions.size() != stream_L2_decisions.size(),
+		std::logic_error, "Wrong number of decisions across the clocktick wrap ! ");
+    const uint32_t wrap_shift_25 = (wrap_first_800 - first_800) * (snemo::digitization::clock_utils::TRACKER_CLOCKTICK / snemo::digitization::clock_utils::MAIN_CLOCKTICK);
+    for (std::size_t i = 0; i < stream_L1_decisions.size(); i++)
+      {
+	DT_THROW_IF((uint32_t)(wrap_L1_decisions[i].L1_calo_ct_decision - stream_L1_decisions[i].L1_calo_ct_decision) != wrap_shift_25,
+		    std::logic_error, "L1 calo decision #" << i << " differs across the clocktick wrap ! ");
+      }
+    for (std::size_t i = 0; i < stream_L2_decisions.size(); i++)
+      {
+	DT_THROW_IF(wrap_L2_decisions[i].L2_ct_decision - stream_L2_decisions[i].L2_ct_decision != (wrap_first_800 - first_800) / 2
+		    || wrap_L2_decisions[i].L2_trigger_mode != stream_L2_decisions[i].L2_trigger_mode,
+		    std::logic_error, "L2 decision #" << i << " differs across the clocktick wrap ! ");
+      }
+
+    // Decisions only retention, in event and stream modes :
+    my_trigger_algo.set_retention_policy(snemo::digitization::trigger_algorithm::RETENTION_DECISIONS);
+    my_trigger_algo.reset_data();
+    my_trigger_algo.process(all_calo_ctws, all_geiger_ctws);
+    DT_THROW_IF(!my_trigger_algo.get_finale_decision(), std::logic_error, "Missing finale decision ! ");
+    DT_THROW_IF(my_trigger_algo.get_L1_calo_decision_records_vector().size() != event_L1_decisions.size()
+		|| my_trigger_algo.get_L2_decision_records_vector().size() != event_L2_decisions.size(),
+		std::logic_error, "Wrong number of decisions with the decisions only retention ! ");
+    DT_THROW_IF(!my_trigger_algo.get_calo_records_25ns_vector().empty()
+		|| !my_trigger_algo.get_coincidence_calo_records_1600ns_vector().empty()
+		|| !my_trigger_algo.get_tracker_records_vector().empty()
+		|| !my_trigger_algo.get_geiger_matrix_records_vector().empty()
+		|| !my_trigger_algo.get_pair_records_vector().empty(),
+		std::logic_error, "Records are kept with the decisions only retention ! ");
+    std::vector<snemo::digitization::trigger_structures::L1_calo_decision> decision_L1_decisions;
+    std::vector<snemo::digitization::trigger_structures::L2_decision> decision_L2_decisions;
+    run_stream(my_trigger_algo, my_generator, number_of_events, first_800, spacing_800, decision_L1_decisions, decision_L2_decisions, max_backlog_size);
+    DT_THROW_IF(decision_L1_decisions.size() != stream_L1_decisions.size() || decision_L2_decisions.size() != stream_L2_decisions.size(),
+		std::logic_error, "Wrong number of stream decisions with the decisions only retention ! ");
+    for (std::size_t i = 0; i < stream_L2_decisions.size(); i++)
+      {
+	DT_THROW_IF(decision_L2_decisions[i].L2_ct_decision != stream_L2_decisions[i].L2_ct_decision
+		    || decision_L2_decisions[i].L2_trigger_mode != stream_L2_decisions[i].L2_trigger_mode,
+		    std::logic_error, "L2 decision #" << i << " differs with the decisions only retention ! ");
+      }
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
@@ -0,0 +1,139 @@
+// test_trigger_display_manager.cxx
+// Standard libraries :
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+#include <datatools/properties.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/trigger_display_manager.h>
+#include <snemo/digitization/ctw_generator.h>
+#include <snemo/digitization/calo_ctw_data.h>
+#include <snemo/digitization/geiger_ctw_data.h>
+
+typedef snemo::digitization::trigger_display_manager trigger_display_manager;
+typedef snemo::digitization::trigger_info trigger_info;
+
+/// Compare a text FIFO dump with the pretty print of a binary FIFO dump
+void check_binary_fifo(const std::vector<char> & text_buffer_,
+		       const std::vector<char> & binary_buffer_,
+		       const std::string & label_)
+{
+  DT_THROW_IF(binary_buffer_.size() % trigger_display_manager::FIFO_BINARY_RECORD_SIZE != 0, std::logic_error,
+	      "Binary FIFO " << label_ << " is not made of whole records ! ");
+  std::istringstream binary_iss(std::string(binary_buffer_.begin(), binary_buffer_.end()));
+  std::ostringstream printed_oss;
+  trigger_display_manager::print_binary_fifo(binary_iss, printed_oss);
+  DT_THROW_IF(printed_oss.str() != std::string(text_buffer_.begin(), text_buffer_.end()), std::logic_error,
+	      "Printed binary FIFO " << label_ << " differs from the text FIFO ! ");
+  DT_THROW_IF(!text_buffer_.empty() && binary_buffer_.size() * 4 > text_buffer_.size(), std::logic_error,
+	      "Binary FIFO " << label_ << " is not compact (" << binary_buffer_.size() << " bytes for " << text_buffer_.size() << " text bytes) ! ");
+  return;
+}
+
+int main( int  argc_ , char **argv_  )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for class 'snemo::digitization::trigger_display_manager' !" << std::endl;
+
+    datatools::properties text_config;
+    trigger_display_manager text_display;
+    text_display.initialize(text_config);
+
+    datatools::properties binary_config;
+    binary_config.store("fifo_binary", true);
+    trigger_display_manager binary_display;
+    binary_display.initialize(binary_config);
+    DT_THROW_IF(text_display.is_fifo_binary() || !binary_display.is_fifo_binary(), std::logic_error, "Wrong FIFO binary configuration ! ");
+
+    // Display matrix : calorimeter zones and Geiger cells :
+    std::bitset<10> zoning_word[trigger_info::NSIDES];
+    zoning_word[0].set(0);
+    zoning_word[1].set(5);
+    bool geiger_matrix[trigger_info::NSIDES][trigger_info::NLAYERS][trigger_info::NROWS] = {};
+    geiger_matrix[0][0][0] = true;
+    geiger_matrix[1][8][112] = true;
+    text_display.fill_coincidence_trigger_matrix_1600ns(zoning_word, geiger_matrix);
+    std::ostringstream matrix_oss;
+    text_display.display_matrix(matrix_oss);
+    std::vector<std::string> lines;
+    std::istringstream matrix_iss(matrix_oss.str());
+    for (std::string line; std::getline(matrix_iss, line);) lines.push_back(line);
+    DT_THROW_IF(lines.size() != trigger_display_manager::NUMBER_OF_VERTICAL_CHAR + 3, std::logic_error, "Wrong number of display lines " << lines.size() << " ! ");
+    for (unsigned int i = 1; i <= trigger_display_manager::NUMBER_OF_VERTICAL_CHAR; i++)
+      {
+	DT_THROW_IF(lines[i].size() != trigger_display_manager::NUMBER_OF_HORIZONTAL_CHAR, std::logic_error, "Wrong size of the display line #" << i << " ! ");
+      }
+    DT_THROW_IF(lines[1].substr(3, 9) != "[*******]" || lines[21].substr(60, 11) != "[*********]", std::logic_error, "Wrong calorimeter zones display ! ");
+    DT_THROW_IF(lines[10][3] != '*' || lines[20][115] != '*' || lines[11][3] != '_', std::logic_error, "Wrong Geiger cells display ! ");
+    text_display.reset_calo_display();
+    text_display.reset_tracker_display();
+    std::ostringstream reset_oss;
+    text_display.display_matrix(reset_oss);
+    DT_THROW_IF(reset_oss.str().find('*') != std::string::npos, std::logic_error, "Display matrix is not reset ! ");
+
+    // CTW FIFO dumps in text and binary forms :
+    snemo::digitization::ctw_generator generator;
+    generator.set_seed(314159);
+    generator.initialize_simple();
+    std::size_t text_size = 0;
+    std::size_t binary_size = 0;
+    for (unsigned int ievent = 0; ievent < 5; ievent++)
+      {
+	// The FIFO dump changes the Geiger CTW clockticks, each dump uses its own copy :
+	snemo::digitization::calo_ctw_data calo_ctw_data[2];
+	snemo::digitization::geiger_ctw_data geiger_ctw_data[2];
+	generator.generate(ievent, calo_ctw_data[0], geiger_ctw_data[0]);
+	generator.generate(ievent, calo_ctw_data[1], geiger_ctw_data[1]);
+	text_display.build_ctw_fifo_trigger_implementation_1600ns(calo_ctw_data[0], geiger_ctw_data[0]);
+	binary_display.build_ctw_fifo_trigger_implementation_1600ns(calo_ctw_data[1], geiger_ctw_data[1]);
+	for (unsigned int icrate = 0; icrate < snemo::digitization::mapping::NUMBER_OF_CRATES; icrate++)
+	  {
+	    check_binary_fifo(text_display.get_calo_fifo_buffer(icrate), binary_display.get_calo_fifo_buffer(icrate), "calo");
+	    check_binary_fifo(text_display.get_tracker_fifo_buffer(icrate), binary_display.get_tracker_fifo_buffer(icrate), "tracker");
+	    text_size += text_display.get_calo_fifo_buffer(icrate).size() + text_display.get_tracker_fifo_buffer(icrate).size();
+	    binary_size += binary_display.get_calo_fifo_buffer(icrate).size() + binary_display.get_tracker_fifo_buffer(icrate).size();
+	  }
+      }
+    std::clog << "FIFO dumps : " << text_size << " text bytes, " << binary_size << " binary bytes" << std::endl;
+    DT_THROW_IF(text_size == 0, std::logic_error, "No FIFO dump ! ");
+
+    // A word record without header is rejected :
+    bool rejected = false;
+    try {
+      std::istringstream no_header_iss(std::string(trigger_display_manager::FIFO_BINARY_RECORD_SIZE, '\0'));
+      std::ostringstream no_header_oss;
+      trigger_display_manager::print_binary_fifo(no_header_iss, no_header_oss);
+    } catch (std::logic_error &) {
+      rejected = true;
+    }
+    DT_THROW_IF(!rejected, std::logic_error, "Binary FIFO without header is not rejected ! ");
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
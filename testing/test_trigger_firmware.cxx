@@ -0,0 +1,294 @@
+// test_trigger_firmware.cxx
+// Standard libraries :
+#include <iostream>
+#include <map>
+#include <vector>
+#include <thread>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+#include <datatools/properties.h>
+#include <datatools/multi_properties.h>
+// - Bayeux/geomtools:
+#include <geomtools/manager.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/mapping.h>
+#include <snemo/digitization/electronic_mapping.h>
+#include <snemo/digitization/ctw_generator.h>
+#include <snemo/digitization/tracker_trigger_algorithm.h>
+#include <snemo/digitization/trigger_firmware.h>
+
+typedef std::vector<snemo::digitization::geiger_ctw_data::geiger_ctw_collection_type> ctw_lists_type;
+
+/// Process the Geiger CTWs lists of the clockticks with a tracker algorithm
+void process_lists(snemo::digitization::tracker_trigger_algorithm & tracker_algo_,
+		   const ctw_lists_type & ctw_lists_,
+		   std::vector<snemo::digitization::trigger_structures::tracker_record> & tracker_records_)
+{
+  tracker_records_.assign(ctw_lists_.size(), snemo::digitization::trigger_structures::tracker_record());
+  for (std::size_t i = 0; i < ctw_lists_.size(); i++)
+    {
+      tracker_algo_.process(ctw_lists_[i], tracker_records_[i]);
+    }
+  return;
+}
+
+/// Check that two tracker records have the same decisions and zones
+bool same_tracker_records(const snemo::digitization::trigger_structures::tracker_record & record_a_,
+			  const snemo::digitization::trigger_structures::tracker_record & record_b_)
+{
+  if (record_a_.single_side_coinc != record_b_.single_side_coinc
+      || record_a_.finale_decision != record_b_.finale_decision) return false;
+  for (unsigned int iside = 0; iside < snemo::digitization::trigger_info::NSIDES; iside++)
+    {
+      if (record_a_.zoning_word_pattern[iside] != record_b_.zoning_word_pattern[iside]
+	  || record_a_.zoning_word_near_source[iside] != record_b_.zoning_word_near_source[iside]) return false;
+      for (unsigned int izone = 0; izone < snemo::digitization::trigger_info::NZONES; izone++)
+	{
+	  if (record_a_.finale_data_per_zone[iside][izone] != record_b_.finale_data_per_zone[iside][izone]) return false;
+	}
+    }
+  return true;
+}
+
+int main( int  argc_ , char **argv_  )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for class 'snemo::digitization::trigger_firmware' !" << std::endl;
+
+    std::string manager_config_file;
+    manager_config_file = "@falaise:config/snemo/demonstrator/geometry/4.0/manager.conf";
+    datatools::fetch_path_with_env(manager_config_file);
+    datatools::properties manager_config;
+    datatools::properties::read_config (manager_config_file,
+					manager_config);
+    geomtools::manager my_manager;
+    manager_config.update ("build_mapping", true);
+    if (manager_config.has_key ("mapping.excluded_categories"))
+      {
+	manager_config.erase ("mapping.excluded_categories");
+      }
+    my_manager.initialize (manager_config);
+
+    // Electronic mapping :
+    snemo::digitization::electronic_mapping my_e_mapping;
+    my_e_mapping.set_geo_manager(my_manager);
+    my_e_mapping.set_module_number(snemo::digitization::mapping::DEMONSTRATOR_MODULE_NUMBER);
+    my_e_mapping.add_preconstructed_type(snemo::digitization::mapping::GEIGER_CATEGORY_TYPE);
+    my_e_mapping.add_preconstructed_type(snemo::digitization::mapping::CALO_MAIN_WALL_CATEGORY_TYPE);
+    my_e_mapping.initialize();
+
+    // Trigger configuration with the tracker memories :
+    datatools::multi_properties trigger_config("name", "type", "Trigger parameters");
+    trigger_config.add("tracker", "trigger_component");
+    datatools::properties & tracker_config = trigger_config.grab("tracker").grab_properties();
+    for (unsigned int imem = 1; imem <= 5; imem++)
+      {
+	std::string mem_file = "${FALAISE_DIGITIZATION_TESTING_DIR}/config/trigger/tracker/mem" + std::to_string(imem) + ".conf";
+	datatools::fetch_path_with_env(mem_file);
+	tracker_config.store("mem" + std::to_string(imem) + "_file", mem_file);
+      }
+    tracker_config.store("tracker_record_cache_size", 0);
+
+    // Firmware image loaded once :
+    std::shared_ptr<const snemo::digitization::trigger_firmware> my_firmware = snemo::digitization::trigger_firmware::build(trigger_config, my_e_mapping);
+    DT_THROW_IF(!my_firmware->is_initialized(), std::logic_error, "Firmware is not initialized ! ");
+    std::size_t number_of_mapped_channels = 0;
+    for (unsigned int icrate = 0; icrate < snemo::digitization::mapping::NUMBER_OF_CRATES; icrate++)
+      for (unsigned int iboard = 0; iboard < snemo::digitization::trigger_firmware::NUMBER_OF_BOARD_IDS; iboard++)
+	for (unsigned int ichannel = 0; ichannel < snemo::digitization::trigger_firmware::NUMBER_OF_TP_CHANNELS; ichannel++)
+	  {
+	    if (my_firmware->get_cell_index(icrate, iboard, ichannel) != snemo::digitization::trigger_firmware::INVALID_CELL) number_of_mapped_channels++;
+	  }
+    std::clog << "Mapped Geiger channels : " << number_of_mapped_channels << std::endl;
+    DT_THROW_IF(number_of_mapped_channels != snemo::digitization::mapping::NUMBER_OF_SIDES * snemo::digitization::mapping::NUMBER_OF_LAYERS * snemo::digitization::mapping::NUMBER_OF_GEIGER_ROWS,
+		std::logic_error, "Wrong number of mapped Geiger channels ! ");
+
+    // Zone patterns LUT against the zone memories, for all the zone addresses :
+    for (unsigned int io_address = 0; io_address < (1u << snemo::digitization::trigger_info::ZONE_ADDR_IO_PATTERN_SIZE); io_address++)
+      for (unsigned int lr_address = 0; lr_address < (1u << snemo::digitization::trigger_info::ZONE_ADDR_LMR_PATTERN_SIZE); lr_address++)
+	{
+	  const std::bitset<snemo::digitization::trigger_info::DATA_IO_PATTERN_SIZE> io_data
+	    = my_firmware->get_zone_vertical_memory().fetch(snemo::digitization::tracker_trigger_mem_maker::mem3_type::address_type(io_address));
+	  const std::bitset<snemo::digitization::trigger_info::DATA_LMR_PATTERN_SIZE> lmr_data = lr_address != 0
+	    ? my_firmware->get_zone_horizontal_memory().fetch(snemo::digitization::tracker_trigger_mem_maker::mem4_type::address_type(lr_address))
+	    : my_firmware->get_zone_vertical_for_horizontal_memory().fetch(snemo::digitization::tracker_trigger_mem_maker::mem5_type::address_type(io_address));
+	  const uint8_t zone_pattern = my_firmware->get_zone_pattern(io_address, lr_address);
+	  DT_THROW_IF((zone_pattern & 0x3) != io_data.to_ulong() || (zone_pattern >> 2) != lmr_data.to_ulong(),
+		      std::logic_error, "Wrong zone pattern for the addresses IO [" << io_address << "] LR [" << lr_address << "] ! ");
+	}
+
+    // Reference algorithm loading its own memories and algorithms sharing the firmware :
+    snemo::digitization::tracker_trigger_algorithm my_reference_algo;
+    my_reference_algo.set_electronic_mapping(my_e_mapping);
+    my_reference_algo.initialize(tracker_config);
+    DT_THROW_IF(my_reference_algo.get_firmware() == my_firmware, std::logic_error, "Reference algorithm uses the shared firmware ! ");
+
+    // Geiger cells decoded by the algorithm against the legacy decoding through the electronic mapping, one CTW per crate and board :
+    for (unsigned int icrate = 0; icrate < snemo::digitization::mapping::NUMBER_OF_CRATES; icrate++)
+      for (unsigned int iblock = 0; iblock < snemo::digitization::mapping::NUMBER_OF_FEBS_BY_CRATE; iblock++)
+	{
+	  const unsigned int board_id = iblock < snemo::digitization::mapping::CONTROL_BOARD_ID ? iblock : iblock + 1;
+	  snemo::digitization::geiger_ctw_data a_ctw_data;
+	  snemo::digitization::geiger_ctw & a_geiger_ctw = a_ctw_data.add();
+	  geomtools::geom_id a_ctw_gid(snemo::digitization::mapping::TRACKER_CONTROL_BOARD_TYPE, snemo::digitization::mapping::GEIGER_RACK_ID, icrate, snemo::digitization::mapping::CONTROL_BOARD_ID);
+	  a_geiger_ctw.set_header(iblock, a_ctw_gid, 0);
+	  // All the channels of the board connected to a Geiger cell :
+	  std::bitset<snemo::digitization::geiger::tp::TP_SIZE> a_tp_word;
+	  for (unsigned int ichannel = snemo::digitization::geiger::tp::TP_BEGIN; ichannel <= snemo::digitization::geiger::tp::TP_THREE_WIRES_END; ichannel++)
+	    {
+	      geomtools::geom_id a_channel_eid;
+	      a_channel_eid.set_depth(snemo::digitization::mapping::CHANNEL_DEPTH);
+	      a_channel_eid.set_type(snemo::digitization::mapping::FEB_CATEGORY_TYPE);
+	      a_channel_eid.set(snemo::digitization::mapping::RACK_INDEX, snemo::digitization::mapping::GEIGER_RACK_ID);
+	      a_channel_eid.set(snemo::digitization::mapping::CRATE_INDEX, icrate);
+	      a_channel_eid.set(snemo::digitization::mapping::BOARD_INDEX, board_id);
+	      a_channel_eid.set(snemo::digitization::mapping::CHANNEL_INDEX, ichannel);
+	      geomtools::geom_id a_cell_gid;
+	      my_e_mapping.convert_EID_to_GID(snemo::digitization::mapping::THREE_WIRES_TRACKER_MODE, a_channel_eid, a_cell_gid);
+	      if (a_cell_gid.is_valid()) a_tp_word.set(ichannel);
+	    }
+	  DT_THROW_IF(a_tp_word.none(), std::logic_error, "No Geiger cell for the board [" << icrate << "." << board_id << "] ! ");
+	  a_geiger_ctw.set_55_bits_in_ctw_word(iblock, a_tp_word);
+
+	  my_reference_algo.reset_matrix();
+	  std::vector<geomtools::geom_id> hit_cells_gids;
+	  my_reference_algo.build_hit_cells_gids_from_ctw(a_geiger_ctw, hit_cells_gids);
+	  my_reference_algo.fill_matrix(hit_cells_gids);
+	  const snemo::digitization::trigger_structures::geiger_matrix legacy_matrix = my_reference_algo.get_geiger_matrix_for_a_clocktick();
+	  DT_THROW_IF(hit_cells_gids.size() != a_tp_word.count(), std::logic_error, "Wrong number of legacy Geiger cells for the board [" << icrate << "." << board_id << "] ! ");
+
+	  snemo::digitization::trigger_structures::tracker_record a_tracker_record;
+	  my_reference_algo.process(a_ctw_data.get_geiger_ctws(), a_tracker_record);
+	  const snemo::digitization::trigger_structures::geiger_matrix decoded_matrix = my_reference_algo.get_geiger_matrix_for_a_clocktick();
+	  for (unsigned int iside = 0; iside < snemo::digitization::trigger_info::NSIDES; iside++)
+	    for (unsigned int ilayer = 0; ilayer < snemo::digitization::trigger_info::NLAYERS; ilayer++)
+	      for (unsigned int irow = 0; irow < snemo::digitization::trigger_info::NROWS; irow++)
+		{
+		  DT_THROW_IF(decoded_matrix.matrix[iside][ilayer][irow] != legacy_matrix.matrix[iside][ilayer][irow], std::logic_error,
+			      "Geiger cell [" << iside << "." << ilayer << "." << irow << "] of the board [" << icrate << "." << board_id << "] differs from the legacy decoding ! ");
+		}
+	}
+
+    const unsigned int number_of_workers = 4;
+    snemo::digitization::tracker_trigger_algorithm my_worker_algos[number_of_workers];
+    for (unsigned int iworker = 0; iworker < number_of_workers; iworker++)
+      {
+	my_worker_algos[iworker].set_electronic_mapping(my_e_mapping);
+	my_worker_algos[iworker].set_firmware(my_firmware);
+	my_worker_algos[iworker].initialize(tracker_config);
+	DT_THROW_IF(my_worker_algos[iworker].get_firmware() != my_firmware, std::logic_error, "Worker #" << iworker << " does not use the shared firmware ! ");
+      }
+    DT_THROW_IF(my_firmware.use_count() != number_of_workers + 1, std::logic_error, "Wrong number of firmware users ! ");
+
+    // The memories of a shared firmware can't be filled :
+    snemo::digitization::tracker_trigger_algorithm my_locked_algo;
+    my_locked_algo.set_firmware(my_firmware);
+    bool filled = true;
+    try {
+      my_locked_algo.fill_mem1_all(tracker_config.fetch_string("mem1_file"));
+    } catch (std::logic_error &) {
+      filled = false;
+    }
+    DT_THROW_IF(filled, std::logic_error, "Memory of a shared firmware is filled ! ");
+
+    // Events with two tracks, delayed alphas and Geiger noise :
+    snemo::digitization::ctw_generator my_generator;
+    my_generator.set_seed(271828);
+    my_generator.set_number_of_tracks(2);
+    my_generator.set_delayed_alpha_probability(0.5);
+    my_generator.set_alpha_mean_delay(20 * CLHEP::microsecond);
+    my_generator.set_geiger_noise_rate(100 * CLHEP::hertz);
+    my_generator.initialize_simple();
+    ctw_lists_type ctw_lists;
+    for (std::size_t ievent = 0; ievent < 50; ievent++)
+      {
+	snemo::digitization::calo_ctw_data calo_ctws;
+	snemo::digitization::geiger_ctw_data geiger_ctws;
+	my_generator.generate(ievent, calo_ctws, geiger_ctws);
+	std::map<uint32_t, snemo::digitization::geiger_ctw_data::geiger_ctw_collection_type> geiger_ctw_lists;
+	for (std::size_t i = 0; i < geiger_ctws.get_geiger_ctws().size(); i++)
+	  {
+	    const snemo::digitization::geiger_ctw & a_gg_ctw = geiger_ctws.get_geiger_ctws()[i].get();
+	    if (a_gg_ctw.get_clocktick_800ns() % 2 == 0 && a_gg_ctw.has_trigger_primitive_values())
+	      {
+		geiger_ctw_lists[a_gg_ctw.get_clocktick_800ns()].push_back(geiger_ctws.get_geiger_ctws()[i]);
+	      }
+	  }
+	std::map<uint32_t, snemo::digitization::geiger_ctw_data::geiger_ctw_collection_type>::const_iterator it_list = geiger_ctw_lists.begin();
+	for (; it_list != geiger_ctw_lists.end(); it_list++) ctw_lists.push_back(it_list->second);
+      }
+
+    // Reference records then records of the workers processing concurrently :
+    std::vector<snemo::digitization::trigger_structures::tracker_record> reference_records;
+    process_lists(my_reference_algo, ctw_lists, reference_records);
+    std::vector<snemo::digitization::trigger_structures::tracker_record> worker_records[number_of_workers];
+    std::vector<std::thread> workers;
+    for (unsigned int iworker = 0; iworker < number_of_workers; iworker++)
+      {
+	workers.push_back(std::thread(process_lists, std::ref(my_worker_algos[iworker]), std::cref(ctw_lists), std::ref(worker_records[iworker])));
+      }
+    for (unsigned int iworker = 0; iworker < number_of_workers; iworker++) workers[iworker].join();
+
+    std::size_t number_of_decisions = 0;
+    for (std::size_t i = 0; i < reference_records.size(); i++)
+      {
+	if (reference_records[i].finale_decision) number_of_decisions++;
+	for (unsigned int iworker = 0; iworker < number_of_workers; iworker++)
+	  {
+	    DT_THROW_IF(!same_tracker_records(reference_records[i], worker_records[iworker][i]),
+			std::logic_error, "Tracker record #" << i << " of worker #" << iworker << " differs from the reference ! ");
+	  }
+      }
+    std::clog << "Clockticks : " << reference_records.size() << ", tracker decisions : " << number_of_decisions << std::endl;
+    DT_THROW_IF(number_of_decisions == 0, std::logic_error, "No tracker decision ! ");
+
+    // Zone data of the tracker records against the zone by zone reference implementation :
+    for (std::size_t i = 0; i < ctw_lists.size(); i++)
+      {
+	snemo::digitization::trigger_structures::tracker_record a_tracker_record;
+	my_reference_algo.process(ctw_lists[i], a_tracker_record);
+	for (unsigned int iside = 0; iside < snemo::digitization::trigger_info::NSIDES; iside++)
+	  for (unsigned int izone = 0; izone < snemo::digitization::trigger_info::NZONES; izone++)
+	    {
+	      snemo::digitization::tracker_zone reference_zone;
+	      reference_zone.side = iside;
+	      reference_zone.zone_id = izone;
+	      my_reference_algo.build_in_out_pattern(reference_zone, my_firmware->get_zone_vertical_memory());
+	      my_reference_algo.build_left_mid_right_pattern(reference_zone, my_firmware->get_zone_horizontal_memory(), my_firmware->get_zone_vertical_for_horizontal_memory());
+	      const std::bitset<snemo::digitization::trigger_info::DATA_FULL_BITSET_SIZE> & finale_data = a_tracker_record.finale_data_per_zone[iside][izone];
+	      DT_THROW_IF(finale_data[snemo::digitization::trigger_structures::tracker_record::FINALE_DATA_BIT_INNER] != reference_zone.data_in_out_pattern[0]
+			  || finale_data[snemo::digitization::trigger_structures::tracker_record::FINALE_DATA_BIT_OUTER] != reference_zone.data_in_out_pattern[1]
+			  || finale_data[snemo::digitization::trigger_structures::tracker_record::FINALE_DATA_BIT_RIGHT] != reference_zone.data_left_mid_right_pattern[0]
+			  || finale_data[snemo::digitization::trigger_structures::tracker_record::FINALE_DATA_BIT_MIDDLE] != reference_zone.data_left_mid_right_pattern[1]
+			  || finale_data[snemo::digitization::trigger_structures::tracker_record::FINALE_DATA_BIT_LEFT] != reference_zone.data_left_mid_right_pattern[2],
+			  std::logic_error, "Zone data [" << iside << "." << izone << "] of the tracker record #" << i << " differ from the reference ! ");
+	    }
+      }
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
@@ -0,0 +1,146 @@
+//test_trigger_records_io.cxx
+
+// Standard libraries :
+#include <iostream>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/trigger_record_writer.h>
+#include <snemo/digitization/trigger_record_reader.h>
+
+int main( int  argc_ , char ** argv_ )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for trigger records columnar writer and reader !" << std::endl;
+
+    std::vector<snemo::digitization::trigger_event_records> events;
+    const std::size_t number_of_events = 25;
+    for (std::size_t ievent = 0; ievent < number_of_events; ievent++)
+      {
+	snemo::digitization::trigger_event_records an_event;
+	an_event.event_id = ievent;
+	an_event.finale_decision = (ievent % 2 == 0);
+	for (unsigned int i = 0; i < ievent % 4; i++)
+	  {
+	    snemo::digitization::trigger_structures::calo_summary_record a_calo_record;
+	    a_calo_record.clocktick_25ns = 100 + i;
+	    a_calo_record.zoning_word[1].set(i);
+	    a_calo_record.total_multiplicity_side_1 = std::bitset<snemo::digitization::calo::ctw::HTM_BITSET_SIZE>(3);
+	    a_calo_record.LTO_gveto = true;
+	    a_calo_record.calo_finale_decision = true;
+	    an_event.calo_records_25ns.push_back(a_calo_record);
+
+	    snemo::digitization::trigger_structures::tracker_record a_tracker_record;
+	    a_tracker_record.clocktick_1600ns = i;
+	    a_tracker_record.finale_data_per_zone[1][i] = std::bitset<snemo::digitization::trigger_info::DATA_FULL_BITSET_SIZE>(0x55);
+	    a_tracker_record.zoning_word_near_source[0].set(9 - i);
+	    a_tracker_record.finale_decision = true;
+	    an_event.tracker_records.push_back(a_tracker_record);
+
+	    snemo::digitization::trigger_structures::geiger_matrix a_geiger_matrix;
+	    a_geiger_matrix.clocktick_1600ns = i;
+	    a_geiger_matrix.matrix[1][8][112] = true;
+	    a_geiger_matrix.matrix[0][i][ievent] = true;
+	    an_event.geiger_matrix_records.push_back(a_geiger_matrix);
+
+	    snemo::digitization::trigger_structures::L2_decision a_L2_decision;
+	    a_L2_decision.L2_ct_decision = i;
+	    a_L2_decision.L2_decision_bool = true;
+	    a_L2_decision.L2_trigger_mode = snemo::digitization::trigger_structures::CARACO;
+	    an_event.L2_decision_records.push_back(a_L2_decision);
+	  }
+	events.push_back(an_event);
+      }
+
+    const std::string filename = "test_trigger_records_io.trg";
+
+    {
+      snemo::digitization::trigger_record_writer writer;
+      writer.set_chunk_size(10);
+      writer.open(filename);
+      for (std::size_t ievent = 0; ievent < events.size(); ievent++) writer.write(events[ievent]);
+      writer.close();
+    }
+
+    snemo::digitization::trigger_record_reader reader;
+    reader.open(filename);
+    snemo::digitization::trigger_event_records a_read_event;
+    std::size_t event_counter = 0;
+    while (reader.read_next_event(a_read_event))
+      {
+	const snemo::digitization::trigger_event_records & an_event = events[event_counter];
+	DT_THROW_IF(a_read_event.event_id != an_event.event_id
+		    || a_read_event.finale_decision != an_event.finale_decision
+		    || a_read_event.calo_records_25ns.size() != an_event.calo_records_25ns.size()
+		    || a_read_event.tracker_records.size() != an_event.tracker_records.size()
+		    || a_read_event.geiger_matrix_records.size() != an_event.geiger_matrix_records.size()
+		    || a_read_event.L2_decision_records.size() != an_event.L2_decision_records.size(),
+		    std::logic_error, "Event #" << event_counter << " differs after the round trip ! ");
+	for (std::size_t i = 0; i < an_event.calo_records_25ns.size(); i++)
+	  {
+	    const snemo::digitization::trigger_structures::calo_summary_record & a = an_event.calo_records_25ns[i];
+	    const snemo::digitization::trigger_structures::calo_summary_record & b = a_read_event.calo_records_25ns[i];
+	    DT_THROW_IF(a.clocktick_25ns != b.clocktick_25ns
+			|| a.zoning_word[1] != b.zoning_word[1]
+			|| a.total_multiplicity_side_1 != b.total_multiplicity_side_1
+			|| a.LTO_gveto != b.LTO_gveto
+			|| a.calo_finale_decision != b.calo_finale_decision,
+			std::logic_error, "Calo record #" << i << " of event #" << event_counter << " differs ! ");
+	    const snemo::digitization::trigger_structures::tracker_record & c = an_event.tracker_records[i];
+	    const snemo::digitization::trigger_structures::tracker_record & d = a_read_event.tracker_records[i];
+	    DT_THROW_IF(c.clocktick_1600ns != d.clocktick_1600ns
+			|| c.finale_data_per_zone[1][i] != d.finale_data_per_zone[1][i]
+			|| c.zoning_word_near_source[0] != d.zoning_word_near_source[0]
+			|| c.finale_decision != d.finale_decision,
+			std::logic_error, "Tracker record #" << i << " of event #" << event_counter << " differs ! ");
+	    DT_THROW_IF(!d.finale_data_per_zone[1][i].any() || !a_read_event.geiger_matrix_records[i].matrix[1][8][112]
+			|| !a_read_event.geiger_matrix_records[i].matrix[0][i][event_counter],
+			std::logic_error, "Geiger matrix #" << i << " of event #" << event_counter << " differs ! ");
+	    DT_THROW_IF(a_read_event.L2_decision_records[i].L2_trigger_mode != snemo::digitization::trigger_structures::CARACO,
+			std::logic_error, "L2 decision #" << i << " of event #" << event_counter << " differs ! ");
+	  }
+	event_counter++;
+      }
+    DT_THROW_IF(event_counter != number_of_events, std::logic_error, "Read " << event_counter << " events instead of " << number_of_events << " ! ");
+    reader.close();
+
+    // Fast scan of a single column, chunk by chunk :
+    reader.open(filename);
+    std::size_t number_of_L2_decisions = 0;
+    while (reader.load_next_chunk())
+      {
+	const std::size_t number_of_values = reader.get_number_of_values(snemo::digitization::trigger_records_format::L2_DECISION);
+	for (std::size_t i = 0; i < number_of_values; i++)
+	  {
+	    if (reader.get_value<uint8_t>(snemo::digitization::trigger_records_format::L2_DECISION, i)) number_of_L2_decisions++;
+	  }
+      }
+    reader.close();
+    std::clog << "Number of L2 decisions : " << number_of_L2_decisions << std::endl;
+
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}
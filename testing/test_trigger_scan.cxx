@@ -0,0 +1,218 @@
+// test_trigger_scan.cxx
+// Standard libraries :
+#include <iostream>
+#include <vector>
+
+// - Bayeux/datatools:
+#include <datatools/utils.h>
+#include <datatools/exception.h>
+#include <datatools/clhep_units.h>
+#include <datatools/multi_properties.h>
+// - Bayeux/geomtools:
+#include <geomtools/manager.h>
+
+// Falaise:
+#include <falaise/falaise.h>
+
+// This project :
+#include <snemo/digitization/clock_utils.h>
+#include <snemo/digitization/mapping.h>
+#include <snemo/digitization/electronic_mapping.h>
+#include <snemo/digitization/ctw_generator.h>
+#include <snemo/digitization/trigger_algorithm.h>
+#include <snemo/digitization/trigger_scan.h>
+
+/// Check that the products of a scanned configuration are the ones of a trigger algorithm alone
+void compare_products(const snemo::digitization::trigger_algorithm & scan_algo_,
+		      const snemo::digitization::trigger_algorithm & reference_algo_,
+		      std::size_t iconfig_,
+		      std::size_t ievent_)
+{
+  DT_THROW_IF(scan_algo_.get_finale_decision() != reference_algo_.get_finale_decision(),
+	      std::logic_error, "Finale decision differs for configuration #" << iconfig_ << " event #" << ievent_ << " ! ");
+  const std::vector<snemo::digitization::trigger_structures::L1_calo_decision> & scan_L1 = scan_algo_.get_L1_calo_decision_records_vector();
+  const std::vector<snemo::digitization::trigger_structures::L1_calo_decision> & reference_L1 = reference_algo_.get_L1_calo_decision_records_vector();
+  DT_THROW_IF(scan_L1.size() != reference_L1.size(), std::logic_error, "Number of L1 calo decisions differs for configuration #" << iconfig_ << " event #" << ievent_ << " ! ");
+  for (std::size_t i = 0; i < scan_L1.size(); i++)
+    {
+      DT_THROW_IF(scan_L1[i].L1_calo_ct_decision != reference_L1[i].L1_calo_ct_decision,
+		  std::logic_error, "L1 calo decision #" << i << " differs for configuration #" << iconfig_ << " event #" << ievent_ << " ! ");
+    }
+  const std::vector<snemo::digitization::trigger_structures::L2_decision> & scan_L2 = scan_algo_.get_L2_decision_records_vector();
+  const std::vector<snemo::digitization::trigger_structures::L2_decision> & reference_L2 = reference_algo_.get_L2_decision_records_vector();
+  DT_THROW_IF(scan_L2.size() != reference_L2.size(), std::logic_error, "Number of L2 decisions differs for configuration #" << iconfig_ << " event #" << ievent_ << " ! ");
+  for (std::size_t i = 0; i < scan_L2.size(); i++)
+    {
+      DT_THROW_IF(scan_L2[i].L2_ct_decision != reference_L2[i].L2_ct_decision
+		  || scan_L2[i].L2_trigger_mode != reference_L2[i].L2_trigger_mode,
+		  std::logic_error, "L2 decision #" << i << " differs for configuration #" << iconfig_ << " event #" << ievent_ << " ! ");
+    }
+  DT_THROW_IF(scan_algo_.get_calo_records_25ns_vector().size() != reference_algo_.get_calo_records_25ns_vector().size()
+	      || scan_algo_.get_coincidence_calo_records_1600ns_vector().size() != reference_algo_.get_coincidence_calo_records_1600ns_vector().size()
+	      || scan_algo_.get_tracker_records_vector().size() != reference_algo_.get_tracker_records_vector().size()
+	      || scan_algo_.get_geiger_matrix_records_vector().size() != reference_algo_.get_geiger_matrix_records_vector().size()
+	      || scan_algo_.get_pair_records_vector().size() != reference_algo_.get_pair_records_vector().size()
+	      || scan_algo_.get_coincidence_records_vector().size() != reference_algo_.get_coincidence_records_vector().size(),
+	      std::logic_error, "Records differ for configuration #" << iconfig_ << " event #" << ievent_ << " ! ");
+  return;
+}
+
+int main( int  argc_ , char **argv_  )
+{
+  falaise::initialize(argc_, argv_);
+  int error_code = EXIT_SUCCESS;
+  datatools::logger::priority logging = datatools::logger::PRIO_FATAL;
+
+  try {
+    std::clog << "Test program for class 'snemo::digitization::trigger_scan' !" << std::endl;
+
+    std::string manager_config_file;
+    manager_config_file = "@falaise:config/snemo/demonstrator/geometry/4.0/manager.conf";
+    datatools::fetch_path_with_env(manager_config_file);
+    datatools::properties manager_config;
+    datatools::properties::read_config (manager_config_file,
+					manager_config);
+    geomtools::manager my_manager;
+    manager_config.update ("build_mapping", true);
+    if (manager_config.has_key ("mapping.excluded_categories"))
+      {
+	manager_config.erase ("mapping.excluded_categories");
+      }
+    my_manager.initialize (manager_config);
+
+    // Electronic mapping :
+    snemo::digitization::electronic_mapping my_e_mapping;
+    my_e_mapping.set_geo_manager(my_manager);
+    my_e_mapping.set_module_number(snemo::digitization::mapping::DEMONSTRATOR_MODULE_NUMBER);
+    my_e_mapping.add_preconstructed_type(snemo::digitization::mapping::GEIGER_CATEGORY_TYPE);
+    my_e_mapping.add_preconstructed_type(snemo::digitization::mapping::CALO_MAIN_WALL_CATEGORY_TYPE);
+    my_e_mapping.initialize();
+    // Clock manager :
+    snemo::digitization::clock_utils my_clock_manager;
+    my_clock_manager.initialize();
+
+    // Common trigger configuration :
+    datatools::multi_properties trigger_config;
+    trigger_config.add("general", "trigger_component");
+    datatools::multi_properties::entry & gen_entry = trigger_config.grab("general");
+    gen_entry.grab_properties().store("coincidence_calorimeter_gate_size", 5);
+    gen_entry.grab_properties().store("L2_decision_coincidence_gate_size", 5);
+    gen_entry.grab_properties().store("previous_event_buffer_depth", 10);
+    trigger_config.add("calorimeter", "trigger_component");
+    datatools::multi_properties::entry & cal_entry = trigger_config.grab("calorimeter");
+    cal_entry.grab_properties().store("circular_buffer_depth", 4);
+    cal_entry.grab_properties().store("total_multiplicity_threshold", 1);
+    cal_entry.grab_properties().store("inhibit_both_side", false);
+    cal_entry.grab_properties().store("inhibit_single_side", false);
+    trigger_config.add("tracker", "trigger_component");
+    datatools::multi_properties::entry & tra_entry = trigger_config.grab("tracker");
+    for (unsigned int imem = 1; imem <= 5; imem++)
+      {
+	std::string mem_file = "${FALAISE_DIGITIZATION_TESTING_DIR}/config/trigger/tracker/mem" + std::to_string(imem) + ".conf";
+	datatools::fetch_path_with_env(mem_file);
+	tra_entry.grab_properties().store("mem" + std::to_string(imem) + "_file", mem_file);
+      }
+    trigger_config.add("coincidence", "trigger_component");
+
+    // Scanned configurations :
+    std::vector<snemo::digitization::trigger_scan::configuration> configurations;
+    snemo::digitization::trigger_scan::configuration nominal;
+    nominal.label = "nominal";
+    configurations.push_back(nominal);
+    snemo::digitization::trigger_scan::configuration narrow;
+    narrow.label = "narrow_gates";
+    narrow.calorimeter_gate_size = 2;
+    narrow.L2_decision_coincidence_gate_size = 2;
+    narrow.previous_event_buffer_depth = 1;
+    configurations.push_back(narrow);
+    snemo::digitization::trigger_scan::configuration wide;
+    wide.label = "wide_gates";
+    wide.calorimeter_gate_size = 10;
+    wide.L2_decision_coincidence_gate_size = 20;
+    wide.previous_event_buffer_depth = 3;
+    configurations.push_back(wide);
+    snemo::digitization::trigger_scan::configuration calo_only;
+    calo_only.label = "calorimeter_only";
+    calo_only.activate_calorimeter_only = true;
+    calo_only.activate_any_coincidences = false;
+    configurations.push_back(calo_only);
+
+    snemo::digitization::trigger_scan my_scan;
+    my_scan.set_electronic_mapping(my_e_mapping);
+    my_scan.set_clock_manager(my_clock_manager);
+    for (std::size_t iconfig = 0; iconfig < configurations.size(); iconfig++) my_scan.add_configuration(configurations[iconfig]);
+    my_scan.initialize(trigger_config);
+    DT_THROW_IF(my_scan.get_number_of_configurations() != configurations.size(), std::logic_error, "Wrong number of configurations ! ");
+
+    // Reference : one trigger algorithm per configuration
+    std::vector<snemo::digitization::trigger_algorithm *> reference_algos;
+    for (std::size_t iconfig = 0; iconfig < configurations.size(); iconfig++)
+      {
+	datatools::multi_properties reference_config = trigger_config;
+	datatools::properties & general_config = reference_config.grab("general").grab_properties();
+	general_config.update("activate_calorimeter_only", configurations[iconfig].activate_calorimeter_only);
+	general_config.update("activate_any_coincidences", configurations[iconfig].activate_any_coincidences);
+	snemo::digitization::trigger_algorithm * a_trigger_algo = new snemo::digitization::trigger_algorithm;
+	a_trigger_algo->set_electronic_mapping(my_e_mapping);
+	a_trigger_algo->set_clock_manager(my_clock_manager);
+	if (configurations[iconfig].calorimeter_gate_size != 0) a_trigger_algo->set_calorimeter_gate_size(configurations[iconfig].calorimeter_gate_size);
+	if (configurations[iconfig].L2_decision_coincidence_gate_size != 0) a_trigger_algo->set_L2_decision_coincidence_gate_size(configurations[iconfig].L2_decision_coincidence_gate_size);
+	if (configurations[iconfig].previous_event_buffer_depth != 0) a_trigger_algo->set_previous_event_buffer_depth(configurations[iconfig].previous_event_buffer_depth);
+	a_trigger_algo->initialize(reference_config);
+	reference_algos.push_back(a_trigger_algo);
+      }
+
+    // Events with delayed alphas and Geiger noise :
+    snemo::digitization::ctw_generator my_generator;
+    my_generator.set_seed(271828);
+    my_generator.set_delayed_alpha_probability(0.5);
+    my_generator.set_alpha_mean_delay(20 * CLHEP::microsecond);
+    my_generator.set_geiger_noise_rate(50 * CLHEP::hertz);
+    my_generator.initialize_simple();
+    const std::size_t number_of_events = 200;
+    std::vector<std::size_t> reference_triggered_events(configurations.size(), 0);
+    std::size_t number_of_L2_decisions = 0;
+    for (std::size_t ievent = 0; ievent < number_of_events; ievent++)
+      {
+	snemo::digitization::calo_ctw_data calo_ctws;
+	snemo::digitization::geiger_ctw_data geiger_ctws;
+	my_generator.generate(ievent, calo_ctws, geiger_ctws);
+	my_scan.process(calo_ctws, geiger_ctws);
+	for (std::size_t iconfig = 0; iconfig < configurations.size(); iconfig++)
+	  {
+	    reference_algos[iconfig]->reset_data();
+	    reference_algos[iconfig]->process(calo_ctws, geiger_ctws);
+	    if (reference_algos[iconfig]->get_finale_decision()) reference_triggered_events[iconfig]++;
+	    compare_products(my_scan.get_trigger_algorithm(iconfig), *reference_algos[iconfig], iconfig, ievent);
+	    number_of_L2_decisions += reference_algos[iconfig]->get_L2_decision_records_vector().size();
+	  }
+      }
+    DT_THROW_IF(number_of_L2_decisions == 0, std::logic_error, "No L2 decision ! ");
+
+    DT_THROW_IF(my_scan.get_number_of_processed_events() != number_of_events, std::logic_error, "Wrong number of processed events ! ");
+    for (std::size_t iconfig = 0; iconfig < configurations.size(); iconfig++)
+      {
+	std::clog << "Configuration '" << my_scan.get_configuration(iconfig).label << "' : "
+		  << my_scan.get_number_of_triggered_events(iconfig) << " / " << my_scan.get_number_of_processed_events() << " triggered event(s)" << std::endl;
+	DT_THROW_IF(my_scan.get_number_of_triggered_events(iconfig) != reference_triggered_events[iconfig],
+		    std::logic_error, "Wrong number of triggered events for configuration #" << iconfig << " ! ");
+      }
+
+    for (std::size_t iconfig = 0; iconfig < reference_algos.size(); iconfig++) delete reference_algos[iconfig];
+    my_scan.reset();
+    std::clog << "The end." << std::endl;
+  }
+
+  catch (std::exception & error) {
+    DT_LOG_FATAL(logging, error.what());
+    error_code = EXIT_FAILURE;
+  }
+
+  catch (...) {
+    DT_LOG_FATAL(logging, "Unexpected error!");
+    error_code = EXIT_FAILURE;
+  }
+
+  falaise::terminate();
+  return error_code;
+}